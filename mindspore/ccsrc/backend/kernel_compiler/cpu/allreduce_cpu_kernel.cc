@@ -0,0 +1,94 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/allreduce_cpu_kernel.h"
+#include <functional>
+#include <numeric>
+#include <string>
+#include "runtime/device/cpu/cpu_device_address.h"
+#include "runtime/device/cpu/replica_collective.h"
+#include "runtime/device/cpu/mpi/mpi_interface.h"
+#include "utils/ms_context.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace kernel {
+std::string GetMPIGradCompression(size_t size) {
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  if (size < static_cast<size_t>(context_ptr->get_param<uint32_t>(MS_CTX_CPU_GRAD_COMPRESSION_THRESHOLD)) * 1024) {
+    return device::cpu::kGradCompressionNone;
+  }
+  return context_ptr->get_param<std::string>(MS_CTX_CPU_GRAD_COMPRESSION);
+}
+
+void AllReduceCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto op = AnfAlgo::GetNodeAttr<std::string>(kernel_node, kAttrOp);
+  auto group = AnfAlgo::GetNodeAttr<std::string>(kernel_node, kAttrGroup);
+  mpi_world_ = group == kValueCPUMPIWorldGroup;
+  if (op != "sum" || (group != kValueCPUReplicaGroup && !mpi_world_)) {
+    MS_LOG(EXCEPTION) << "AllReduce on CPU only supports the sum over the group " << kValueCPUReplicaGroup
+                      << " of the replicas of cpu_replica_num or over the group " << kValueCPUMPIWorldGroup
+                      << ", but got op " << op << " and group " << group;
+  }
+  mean_ = AnfAlgo::HasNodeAttr(kAttrMean, kernel_node) && AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrMean);
+  if (!mpi_world_) {
+    replica_id_ = LongToSize(AnfAlgo::GetNodeAttr<int64_t>(kernel_node, kAttrReplicaId));
+    return;
+  }
+#ifdef ENABLE_MPI
+  ranks_group_.resize(IntToSize(GetMPIRankSize()));
+  for (size_t i = 0; i < ranks_group_.size(); ++i) {
+    ranks_group_[i] = SizeToInt(i);
+  }
+  auto shape = AnfAlgo::GetOutputInferShape(kernel_node, 0);
+  size_t size = std::accumulate(shape.begin(), shape.end(), sizeof(float), std::multiplies<size_t>());
+  compression_ = GetMPIGradCompression(size);
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  compression_ratio_ = context_ptr->get_param<float>(MS_CTX_CPU_GRAD_COMPRESSION_RATIO);
+  compressor_key_ = kernel_node->fullname_with_scope();
+#else
+  MS_LOG(EXCEPTION) << "AllReduce over the group " << kValueCPUMPIWorldGroup << " requires MindSpore built with MPI.";
+#endif
+}
+
+bool AllReduceCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                const std::vector<kernel::AddressPtr> &outputs) {
+  auto input = reinterpret_cast<float *>(inputs[0]->addr);
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  size_t count = outputs[0]->size / sizeof(float);
+  if (!mpi_world_) {
+    device::cpu::ReplicaCollective::GetInstance().AllReduce(replica_id_, input, output, count, mean_);
+    return true;
+  }
+#ifdef ENABLE_MPI
+  if (!MPIAllReduce(input, output, ranks_group_, count, kMPIOpTypeSum, compression_, compression_ratio_,
+                    compressor_key_)) {
+    return false;
+  }
+  if (mean_) {
+    float scale = 1.0f / ranks_group_.size();
+    for (size_t i = 0; i < count; ++i) {
+      output[i] *= scale;
+    }
+  }
+#endif
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,57 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ALLREDUCE_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ALLREDUCE_CPU_KERNEL_H_
+#include <string>
+#include <vector>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+
+namespace mindspore {
+namespace kernel {
+// The sum of a tensor over the replicas of a data parallel graph running in one process, inserted in front of the
+// optimizers when cpu_replica_num is set. The attribute replica_id tells the replica of the graph of the node. With
+// the group cpu_mpi_world_group, the sum is over the processes of the MPI world instead, see enable_cpu_grad_allreduce.
+class AllReduceCPUKernel : public CPUKernel {
+ public:
+  AllReduceCPUKernel() = default;
+  ~AllReduceCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  size_t replica_id_{0};
+  bool mean_{false};
+  bool mpi_world_{false};
+  std::vector<int> ranks_group_;
+  std::string compression_;
+  float compression_ratio_{0};
+  std::string compressor_key_;
+};
+
+// The cpu_grad_compression of a gradient of size bytes summed over the MPI world, none under
+// cpu_grad_compression_threshold.
+std::string GetMPIGradCompression(size_t size);
+
+MS_REG_CPU_KERNEL(AllReduce, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  AllReduceCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ALLREDUCE_CPU_KERNEL_H_
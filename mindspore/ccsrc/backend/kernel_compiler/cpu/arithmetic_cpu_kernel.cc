@@ -13,14 +13,40 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <cmath>
 #include <string>
-#include <thread>
 #include "backend/kernel_compiler/cpu/arithmetic_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/arithmetic_simd.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 
 namespace mindspore {
 namespace kernel {
+namespace {
+// Apply op to [start, end) of the output one innermost run at a time. Within a run each input stride is 0 or 1, so
+// the same-shape, scalar broadcast and row broadcast cases all reduce to a few long vectorizable loops.
+template <typename T, typename Op>
+void BinaryRuns(const T *input1, const T *input2, T *out, const BroadcastIterator &base_iter, SimdBinaryOp simd_op,
+                Op op, size_t start, size_t end) {
+  auto iter = base_iter;
+  iter.SetPos(start);
+  size_t i = start;
+  while (i < end) {
+    size_t count = std::min(end - i, iter.GetInnerRemain());
+    const T *a = input1 + iter.GetInputPosA();
+    const T *b = input2 + iter.GetInputPosB();
+    size_t stride_a = iter.GetInnerStrideA();
+    size_t stride_b = iter.GetInnerStrideB();
+    T *o = out + i;
+    for (size_t j = SimdBinary<T>(simd_op, a, stride_a, b, stride_b, o, count); j < count; ++j) {
+      o[j] = op(a[j * stride_a], b[j * stride_b]);
+    }
+    i += count;
+    iter.GenNextPos(count);
+  }
+}
+}  // namespace
+
 template <typename T>
 void ArithmeticCPUKernel::AssignAdd(T *input1, const T *input2, T *out, size_t start, size_t end) {
   for (size_t i = start; i < end; i++) {
@@ -30,39 +56,31 @@ void ArithmeticCPUKernel::AssignAdd(T *input1, const T *input2, T *out, size_t s
 }
 
 template <typename T>
-void ArithmeticCPUKernel::Add(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] + input2[idx[1]];
-  }
+void ArithmeticCPUKernel::Add(const T *input1, const T *input2, T *out, const BroadcastIterator &base_iter,
+                              size_t start, size_t end) {
+  BinaryRuns(input1, input2, out, base_iter, SimdBinaryOp::kAdd, [](T x, T y) { return x + y; }, start, end);
 }
 
 template <typename T>
-void ArithmeticCPUKernel::Sub(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] - input2[idx[1]];
-  }
+void ArithmeticCPUKernel::Sub(const T *input1, const T *input2, T *out, const BroadcastIterator &base_iter,
+                              size_t start, size_t end) {
+  BinaryRuns(input1, input2, out, base_iter, SimdBinaryOp::kSub, [](T x, T y) { return x - y; }, start, end);
 }
 
 template <typename T>
-void ArithmeticCPUKernel::Mul(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] * input2[idx[1]];
-  }
+void ArithmeticCPUKernel::Mul(const T *input1, const T *input2, T *out, const BroadcastIterator &base_iter,
+                              size_t start, size_t end) {
+  BinaryRuns(input1, input2, out, base_iter, SimdBinaryOp::kMul, [](T x, T y) { return x * y; }, start, end);
 }
 
 template <typename T>
-void ArithmeticCPUKernel::RealDiv(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    auto dividend = input1[idx[0]];
-    auto divisor = input2[idx[1]];
+void ArithmeticCPUKernel::RealDiv(const T *input1, const T *input2, T *out, const BroadcastIterator &base_iter,
+                                  size_t start, size_t end) {
+  auto iter = base_iter;
+  iter.SetPos(start);
+  for (size_t i = start; i < end; i++, iter.GenNextPos()) {
+    auto dividend = input1[iter.GetInputPosA()];
+    auto divisor = input2[iter.GetInputPosB()];
     if (divisor == 0) {
       if (dividend == 0) {
         out[i] = std::numeric_limits<T>::quiet_NaN();
@@ -80,12 +98,13 @@ void ArithmeticCPUKernel::RealDiv(const T *input1, const T *input2, T *out, size
 }
 
 template <typename T>
-void ArithmeticCPUKernel::Div(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    auto dividend = input1[idx[0]];
-    auto divisor = input2[idx[1]];
+void ArithmeticCPUKernel::Div(const T *input1, const T *input2, T *out, const BroadcastIterator &base_iter,
+                              size_t start, size_t end) {
+  auto iter = base_iter;
+  iter.SetPos(start);
+  for (size_t i = start; i < end; i++, iter.GenNextPos()) {
+    auto dividend = input1[iter.GetInputPosA()];
+    auto divisor = input2[iter.GetInputPosB()];
     if (divisor == 0) {
       if (dividend == 0) {
         out[i] = std::numeric_limits<T>::quiet_NaN();
@@ -103,12 +122,13 @@ void ArithmeticCPUKernel::Div(const T *input1, const T *input2, T *out, size_t s
 }
 
 template <typename T>
-void ArithmeticCPUKernel::FloorDiv(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    auto dividend = input1[idx[0]];
-    auto divisor = input2[idx[1]];
+void ArithmeticCPUKernel::FloorDiv(const T *input1, const T *input2, T *out, const BroadcastIterator &base_iter,
+                                   size_t start, size_t end) {
+  auto iter = base_iter;
+  iter.SetPos(start);
+  for (size_t i = start; i < end; i++, iter.GenNextPos()) {
+    auto dividend = input1[iter.GetInputPosA()];
+    auto divisor = input2[iter.GetInputPosB()];
     if (divisor == 0) {
       if (dividend == 0) {
         out[i] = std::numeric_limits<T>::quiet_NaN();
@@ -126,12 +146,13 @@ void ArithmeticCPUKernel::FloorDiv(const T *input1, const T *input2, T *out, siz
 }
 
 template <typename T>
-void ArithmeticCPUKernel::Mod(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    auto x = static_cast<double>(input1[idx[0]]);
-    auto y = static_cast<double>(input2[idx[1]]);
+void ArithmeticCPUKernel::Mod(const T *input1, const T *input2, T *out, const BroadcastIterator &base_iter,
+                              size_t start, size_t end) {
+  auto iter = base_iter;
+  iter.SetPos(start);
+  for (size_t i = start; i < end; i++, iter.GenNextPos()) {
+    auto x = static_cast<double>(input1[iter.GetInputPosA()]);
+    auto y = static_cast<double>(input2[iter.GetInputPosB()]);
     auto data_div = x / y;
     auto data_div_min = data_div < 0.0 ? data_div : 0.0;
     auto data_div_max = data_div > 0.0 ? data_div : 0.0;
@@ -143,77 +164,84 @@ void ArithmeticCPUKernel::Mod(const T *input1, const T *input2, T *out, size_t s
 }
 
 template <typename T>
-void ArithmeticCPUKernel::Pow(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    auto x = static_cast<double>(input1[idx[0]]);
-    auto y = static_cast<double>(input2[idx[1]]);
+void ArithmeticCPUKernel::Pow(const T *input1, const T *input2, T *out, const BroadcastIterator &base_iter,
+                              size_t start, size_t end) {
+  auto iter = base_iter;
+  iter.SetPos(start);
+  for (size_t i = start; i < end; i++, iter.GenNextPos()) {
+    auto x = static_cast<double>(input1[iter.GetInputPosA()]);
+    auto y = static_cast<double>(input2[iter.GetInputPosB()]);
     out[i] = static_cast<T>(std::pow(x, y));
   }
 }
 
 template <typename T>
-void ArithmeticCPUKernel::Less(const T *input1, const T *input2, bool *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] < input2[idx[1]];
+void ArithmeticCPUKernel::Less(const T *input1, const T *input2, bool *out, const BroadcastIterator &base_iter,
+                               size_t start, size_t end) {
+  auto iter = base_iter;
+  iter.SetPos(start);
+  for (size_t i = start; i < end; i++, iter.GenNextPos()) {
+    out[i] = input1[iter.GetInputPosA()] < input2[iter.GetInputPosB()];
   }
 }
 
 template <typename T>
-void ArithmeticCPUKernel::Equal(const T *input1, const T *input2, bool *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] == input2[idx[1]];
+void ArithmeticCPUKernel::Equal(const T *input1, const T *input2, bool *out, const BroadcastIterator &base_iter,
+                                size_t start, size_t end) {
+  auto iter = base_iter;
+  iter.SetPos(start);
+  for (size_t i = start; i < end; i++, iter.GenNextPos()) {
+    out[i] = input1[iter.GetInputPosA()] == input2[iter.GetInputPosB()];
   }
 }
 
 template <typename T>
-void ArithmeticCPUKernel::NotEqual(const T *input1, const T *input2, bool *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] != input2[idx[1]];
+void ArithmeticCPUKernel::NotEqual(const T *input1, const T *input2, bool *out, const BroadcastIterator &base_iter,
+                                   size_t start, size_t end) {
+  auto iter = base_iter;
+  iter.SetPos(start);
+  for (size_t i = start; i < end; i++, iter.GenNextPos()) {
+    out[i] = input1[iter.GetInputPosA()] != input2[iter.GetInputPosB()];
   }
 }
 
 template <typename T>
-void ArithmeticCPUKernel::SquaredDifference(const T *input1, const T *input2, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    T diff = input1[idx[0]] - input2[idx[1]];
-    out[i] = diff * diff;
-  }
+void ArithmeticCPUKernel::SquaredDifference(const T *input1, const T *input2, T *out,
+                                            const BroadcastIterator &base_iter, size_t start, size_t end) {
+  auto op = [](T x, T y) {
+    T diff = x - y;
+    return diff * diff;
+  };
+  BinaryRuns(input1, input2, out, base_iter, SimdBinaryOp::kSquaredDifference, op, start, end);
 }
 
 template <typename T>
-void ArithmeticCPUKernel::Greater(const T *input1, const T *input2, bool *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] > input2[idx[1]];
+void ArithmeticCPUKernel::Greater(const T *input1, const T *input2, bool *out, const BroadcastIterator &base_iter,
+                                  size_t start, size_t end) {
+  auto iter = base_iter;
+  iter.SetPos(start);
+  for (size_t i = start; i < end; i++, iter.GenNextPos()) {
+    out[i] = input1[iter.GetInputPosA()] > input2[iter.GetInputPosB()];
   }
 }
 
 template <typename T>
-void ArithmeticCPUKernel::GreaterEqual(const T *input1, const T *input2, bool *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] >= input2[idx[1]];
+void ArithmeticCPUKernel::GreaterEqual(const T *input1, const T *input2, bool *out, const BroadcastIterator &base_iter,
+                                       size_t start, size_t end) {
+  auto iter = base_iter;
+  iter.SetPos(start);
+  for (size_t i = start; i < end; i++, iter.GenNextPos()) {
+    out[i] = input1[iter.GetInputPosA()] >= input2[iter.GetInputPosB()];
   }
 }
 
 template <typename T>
-void ArithmeticCPUKernel::LessEqual(const T *input1, const T *input2, bool *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    std::vector<size_t> idx;
-    GenIndex(i, &idx);
-    out[i] = input1[idx[0]] <= input2[idx[1]];
+void ArithmeticCPUKernel::LessEqual(const T *input1, const T *input2, bool *out, const BroadcastIterator &base_iter,
+                                    size_t start, size_t end) {
+  auto iter = base_iter;
+  iter.SetPos(start);
+  for (size_t i = start; i < end; i++, iter.GenNextPos()) {
+    out[i] = input1[iter.GetInputPosA()] <= input2[iter.GetInputPosB()];
   }
 }
 
@@ -262,33 +290,40 @@ void ArithmeticCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   if (output_shape_.size() == 0) {
     output_shape_.insert(output_shape_.begin(), 1);
   }
-  size_t l = input_shape0_.size();
-  for (size_t i = 0; i < output_shape_.size() - l; ++i) {
-    input_shape0_.insert(input_shape0_.begin(), 1);
-  }
-  l = input_shape1_.size();
-  for (size_t i = 0; i < output_shape_.size() - l; ++i) {
-    input_shape1_.insert(input_shape1_.begin(), 1);
+  if (operate_type_ == ASSIGNADD && input_shape0_ != input_shape1_) {
+    MS_LOG(EXCEPTION) << "AssignAdd does not support broadcast";
   }
-  CPUKernelUtils::GetElementNumEveryDim(input_shape0_, &input_element_num0_);
-  CPUKernelUtils::GetElementNumEveryDim(input_shape1_, &input_element_num1_);
-  CPUKernelUtils::GetElementNumEveryDim(output_shape_, &output_element_num_);
   dtype_ = AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 0);
   if (dtype_ != AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 1)) {
     MS_LOG(EXCEPTION) << "Input0 and input1 must has the same data type";
   }
   target_dtype_ = AnfAlgo::GetOutputInferDataType(kernel_node, 0);
+  base_iter_ = std::make_shared<BroadcastIterator>(input_shape0_, input_shape1_, output_shape_);
 }
 
 bool ArithmeticCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                                  const std::vector<kernel::AddressPtr> & /*workspace*/,
                                  const std::vector<kernel::AddressPtr> &outputs) {
-  if (dtype_ == kNumberTypeInt32 || dtype_ == kNumberTypeInt16 || dtype_ == kNumberTypeInt8) {
-    LaunchKernel<int>(inputs, outputs);
-  } else if (dtype_ == kNumberTypeFloat32 || dtype_ == kNumberTypeFloat16 || dtype_ == kNumberTypeFloat64) {
+  if (dtype_ == kNumberTypeInt32) {
+    LaunchKernel<int32_t>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeFloat32) {
     LaunchKernel<float>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeFloat16) {
+    LaunchKernel<float16>(inputs, outputs);
   } else if (dtype_ == kNumberTypeInt64) {
     LaunchKernel<int64_t>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeFloat64) {
+    LaunchKernelLogic<double>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeInt8) {
+    LaunchKernelLogic<int8_t>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeInt16) {
+    LaunchKernelLogic<int16_t>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeUInt8) {
+    LaunchKernelLogic<uint8_t>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeUInt16) {
+    LaunchKernelLogic<uint16_t>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeUInt32) {
+    LaunchKernelLogic<uint32_t>(inputs, outputs);
   } else if (dtype_ == kNumberTypeBool) {
     LaunchKernelLogic<bool>(inputs, outputs);
   } else {
@@ -297,83 +332,41 @@ bool ArithmeticCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   return true;
 }
 
-void ArithmeticCPUKernel::GenIndex(size_t num, std::vector<size_t> *idx) {
-  std::vector<size_t> tmp;
-  for (size_t i = 0; i < output_shape_.size() - 1; ++i) {
-    if (output_element_num_[i] > num) {
-      tmp.push_back(0);
-    } else {
-      tmp.push_back(num / output_element_num_[i]);
-      num %= output_element_num_[i];
-    }
-  }
-  tmp.push_back(num);
-  size_t idx0 = 0;
-  size_t idx1 = 0;
-  for (size_t k = 0; k < tmp.size() - 1; ++k) {
-    if (input_shape0_[k] > 1) {
-      idx0 += tmp[k] * input_element_num0_[k];
-    }
-    if (input_shape1_[k] > 1) {
-      idx1 += tmp[k] * input_element_num1_[k];
-    }
-  }
-  if (input_shape0_[tmp.size() - 1] > 1) {
-    idx0 += tmp[tmp.size() - 1];
-  }
-  if (input_shape1_[tmp.size() - 1] > 1) {
-    idx1 += tmp[tmp.size() - 1];
-  }
-  idx->push_back(idx0);
-  idx->push_back(idx1);
-}
-
 template <typename T>
 void ArithmeticCPUKernel::LaunchKernelLogic(const std::vector<AddressPtr> &inputs,
                                             const std::vector<AddressPtr> &outputs) {
-  T *input1 = reinterpret_cast<T *>(inputs[0]->addr);
-  T *input2 = reinterpret_cast<T *>(inputs[1]->addr);
-  bool *output = reinterpret_cast<bool *>(outputs[0]->addr);
-
+  LaunchAddresses<T, bool> addr{reinterpret_cast<T *>(inputs[0]->addr), reinterpret_cast<T *>(inputs[1]->addr),
+                                reinterpret_cast<bool *>(outputs[0]->addr)};
   size_t lens = outputs[0]->size > 0 ? static_cast<size_t>(outputs[0]->size / sizeof(bool)) : 1;
-  auto max_thread_num = std::thread::hardware_concurrency();
-  size_t thread_num = lens < 128 * max_thread_num ? std::ceil(lens / 128.0) : max_thread_num;
-  MS_LOG(INFO) << "Lens=" << lens << "; use thread_num=" << thread_num << "; max_thread_num: " << max_thread_num;
-  std::vector<std::thread> threads;
-  if (thread_num < 1) {
-    MS_LOG(ERROR) << "Invalid value: thread_num " << thread_num;
-    return;
-  }
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t once_compute_size = (lens + thread_num - 1) / thread_num;
-  if (once_compute_size < 1) {
-    MS_LOG(ERROR) << "Invalid value: once_compute_size " << once_compute_size;
-    return;
-  }
-  while (start < lens) {
-    size_t end = (start + once_compute_size) > lens ? lens : (start + once_compute_size);
-    if (operate_type_ == LESS) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Less<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == EQUAL) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Equal<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == NOTEQUAL) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::NotEqual<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == GREATER) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Greater<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == GREATEREQUAL) {
-      threads.emplace_back(
-        std::thread(&ArithmeticCPUKernel::GreaterEqual<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == LESSEQUAL) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::LessEqual<T>, this, input1, input2, output, start, end));
-    } else {
-      MS_LOG(EXCEPTION) << "Not support " << operate_type_;
-    }
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
+  CTask task;
+  if (operate_type_ == LESS) {
+    task = [this, &addr](size_t start, size_t end) {
+      Less<T>(addr.input1, addr.input2, addr.output, *base_iter_, start, end);
+    };
+  } else if (operate_type_ == EQUAL) {
+    task = [this, &addr](size_t start, size_t end) {
+      Equal<T>(addr.input1, addr.input2, addr.output, *base_iter_, start, end);
+    };
+  } else if (operate_type_ == NOTEQUAL) {
+    task = [this, &addr](size_t start, size_t end) {
+      NotEqual<T>(addr.input1, addr.input2, addr.output, *base_iter_, start, end);
+    };
+  } else if (operate_type_ == GREATER) {
+    task = [this, &addr](size_t start, size_t end) {
+      Greater<T>(addr.input1, addr.input2, addr.output, *base_iter_, start, end);
+    };
+  } else if (operate_type_ == GREATEREQUAL) {
+    task = [this, &addr](size_t start, size_t end) {
+      GreaterEqual<T>(addr.input1, addr.input2, addr.output, *base_iter_, start, end);
+    };
+  } else if (operate_type_ == LESSEQUAL) {
+    task = [this, &addr](size_t start, size_t end) {
+      LessEqual<T>(addr.input1, addr.input2, addr.output, *base_iter_, start, end);
+    };
+  } else {
+    MS_LOG(EXCEPTION) << "Not support " << operate_type_;
   }
+  CPUKernelUtils::ParallelFor(task, lens);
 }
 
 template <typename T>
@@ -382,57 +375,52 @@ void ArithmeticCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, co
     LaunchKernelLogic<T>(inputs, outputs);
     return;
   }
-  T *input1 = reinterpret_cast<T *>(inputs[0]->addr);
-  T *input2 = reinterpret_cast<T *>(inputs[1]->addr);
-  T *output = reinterpret_cast<T *>(outputs[0]->addr);
-
+  LaunchAddresses<T, T> addr{reinterpret_cast<T *>(inputs[0]->addr), reinterpret_cast<T *>(inputs[1]->addr),
+                             reinterpret_cast<T *>(outputs[0]->addr)};
   size_t lens = outputs[0]->size > 0 ? static_cast<size_t>(outputs[0]->size / sizeof(T)) : 1;
-  auto max_thread_num = std::thread::hardware_concurrency();
-  size_t thread_num = lens < 128 * max_thread_num ? std::ceil(lens / 128.0) : max_thread_num;
-  MS_LOG(INFO) << "Lens=" << lens << "; use thread_num=" << thread_num << "; max_thread_num: " << max_thread_num;
-  std::vector<std::thread> threads;
-  if (thread_num < 1) {
-    MS_LOG(ERROR) << "Invalid value: thread_num " << thread_num;
-    return;
-  }
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t once_compute_size = (lens + thread_num - 1) / thread_num;
-  if (once_compute_size < 1) {
-    MS_LOG(ERROR) << "Invalid value: once_compute_size " << once_compute_size;
-    return;
-  }
-  while (start < lens) {
-    size_t end = (start + once_compute_size) > lens ? lens : (start + once_compute_size);
-    if (operate_type_ == ADD) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Add<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == SUB) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Sub<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == MUL) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Mul<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == REALDIV) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::RealDiv<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == DIV) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Div<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == FLOORDIV) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::FloorDiv<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == MOD) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Mod<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == POW) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::Pow<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == ASSIGNADD) {
-      threads.emplace_back(std::thread(&ArithmeticCPUKernel::AssignAdd<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == SQUAREDDIFFERENCE) {
-      threads.emplace_back(
-        std::thread(&ArithmeticCPUKernel::SquaredDifference<T>, this, input1, input2, output, start, end));
-    } else {
-      MS_LOG(EXCEPTION) << "Not support " << operate_type_;
-    }
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
+  CTask task;
+  if (operate_type_ == ADD) {
+    task = [this, &addr](size_t start, size_t end) {
+      Add<T>(addr.input1, addr.input2, addr.output, *base_iter_, start, end);
+    };
+  } else if (operate_type_ == SUB) {
+    task = [this, &addr](size_t start, size_t end) {
+      Sub<T>(addr.input1, addr.input2, addr.output, *base_iter_, start, end);
+    };
+  } else if (operate_type_ == MUL) {
+    task = [this, &addr](size_t start, size_t end) {
+      Mul<T>(addr.input1, addr.input2, addr.output, *base_iter_, start, end);
+    };
+  } else if (operate_type_ == REALDIV) {
+    task = [this, &addr](size_t start, size_t end) {
+      RealDiv<T>(addr.input1, addr.input2, addr.output, *base_iter_, start, end);
+    };
+  } else if (operate_type_ == DIV) {
+    task = [this, &addr](size_t start, size_t end) {
+      Div<T>(addr.input1, addr.input2, addr.output, *base_iter_, start, end);
+    };
+  } else if (operate_type_ == FLOORDIV) {
+    task = [this, &addr](size_t start, size_t end) {
+      FloorDiv<T>(addr.input1, addr.input2, addr.output, *base_iter_, start, end);
+    };
+  } else if (operate_type_ == MOD) {
+    task = [this, &addr](size_t start, size_t end) {
+      Mod<T>(addr.input1, addr.input2, addr.output, *base_iter_, start, end);
+    };
+  } else if (operate_type_ == POW) {
+    task = [this, &addr](size_t start, size_t end) {
+      Pow<T>(addr.input1, addr.input2, addr.output, *base_iter_, start, end);
+    };
+  } else if (operate_type_ == ASSIGNADD) {
+    task = [this, &addr](size_t start, size_t end) { AssignAdd<T>(addr.input1, addr.input2, addr.output, start, end); };
+  } else if (operate_type_ == SQUAREDDIFFERENCE) {
+    task = [this, &addr](size_t start, size_t end) {
+      SquaredDifference<T>(addr.input1, addr.input2, addr.output, *base_iter_, start, end);
+    };
+  } else {
+    MS_LOG(EXCEPTION) << "Not support " << operate_type_;
   }
+  CPUKernelUtils::ParallelFor(task, lens);
 }
 }  // namespace kernel
 }  // namespace mindspore
@@ -38,45 +38,56 @@ class ArithmeticCPUKernel : public CPUKernel {
   void LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
 
  private:
-  void GenIndex(size_t num, std::vector<size_t> *tmp);
   template <typename T>
-  void Sub(const T *input1, const T *input2, T *out, size_t start, size_t end);
+  void Sub(const T *input1, const T *input2, T *out, const BroadcastIterator &base_iter, size_t start, size_t end);
   template <typename T>
-  void Add(const T *input1, const T *input2, T *out, size_t start, size_t end);
+  void Add(const T *input1, const T *input2, T *out, const BroadcastIterator &base_iter, size_t start, size_t end);
   template <typename T>
-  void Mul(const T *input1, const T *input2, T *out, size_t start, size_t end);
+  void Mul(const T *input1, const T *input2, T *out, const BroadcastIterator &base_iter, size_t start, size_t end);
   template <typename T>
-  void RealDiv(const T *input1, const T *input2, T *out, size_t start, size_t end);
+  void RealDiv(const T *input1, const T *input2, T *out, const BroadcastIterator &base_iter, size_t start, size_t end);
   template <typename T>
-  void Div(const T *input1, const T *input2, T *out, size_t start, size_t end);
+  void Div(const T *input1, const T *input2, T *out, const BroadcastIterator &base_iter, size_t start, size_t end);
   template <typename T>
-  void FloorDiv(const T *input1, const T *input2, T *out, size_t start, size_t end);
+  void FloorDiv(const T *input1, const T *input2, T *out, const BroadcastIterator &base_iter, size_t start, size_t end);
   template <typename T>
-  void Mod(const T *input1, const T *input2, T *out, size_t start, size_t end);
+  void Mod(const T *input1, const T *input2, T *out, const BroadcastIterator &base_iter, size_t start, size_t end);
   template <typename T>
-  void Pow(const T *input1, const T *input2, T *out, size_t start, size_t end);
+  void Pow(const T *input1, const T *input2, T *out, const BroadcastIterator &base_iter, size_t start, size_t end);
   template <typename T>
   void AssignAdd(T *input1, const T *input2, T *out, size_t start, size_t end);
   template <typename T>
-  void Less(const T *input1, const T *input2, bool *out, size_t start, size_t end);
+  void Less(const T *input1, const T *input2, bool *out, const BroadcastIterator &base_iter, size_t start, size_t end);
   template <typename T>
-  void Equal(const T *input1, const T *input2, bool *out, size_t start, size_t end);
+  void Equal(const T *input1, const T *input2, bool *out, const BroadcastIterator &base_iter, size_t start, size_t end);
   template <typename T>
-  void NotEqual(const T *input1, const T *input2, bool *out, size_t start, size_t end);
+  void NotEqual(const T *input1, const T *input2, bool *out, const BroadcastIterator &base_iter, size_t start,
+                size_t end);
   template <typename T>
-  void SquaredDifference(const T *input1, const T *input2, T *out, size_t start, size_t end);
+  void SquaredDifference(const T *input1, const T *input2, T *out, const BroadcastIterator &base_iter, size_t start,
+                         size_t end);
   template <typename T>
-  void Greater(const T *input1, const T *input2, bool *out, size_t start, size_t end);
+  void Greater(const T *input1, const T *input2, bool *out, const BroadcastIterator &base_iter, size_t start,
+               size_t end);
   template <typename T>
-  void GreaterEqual(const T *input1, const T *input2, bool *out, size_t start, size_t end);
+  void GreaterEqual(const T *input1, const T *input2, bool *out, const BroadcastIterator &base_iter, size_t start,
+                    size_t end);
   template <typename T>
-  void LessEqual(const T *input1, const T *input2, bool *out, size_t start, size_t end);
+  void LessEqual(const T *input1, const T *input2, bool *out, const BroadcastIterator &base_iter, size_t start,
+                 size_t end);
+  // The addresses of a launch, the parallel task captures them by a single reference so that the task function keeps
+  // it inline instead of allocating it.
+  template <typename T, typename O>
+  struct LaunchAddresses {
+    T *input1;
+    T *input2;
+    O *output;
+  };
   std::vector<size_t> input_shape0_;
   std::vector<size_t> input_shape1_;
-  std::vector<size_t> input_element_num0_;
-  std::vector<size_t> input_element_num1_;
   std::vector<size_t> output_shape_;
-  std::vector<size_t> output_element_num_;
+  // Built in InitKernel, each task of a launch walks a copy of it.
+  std::shared_ptr<BroadcastIterator> base_iter_;
   OperateType operate_type_{ADD};
   TypeId dtype_{kTypeUnknown};
   TypeId target_dtype_{kTypeUnknown};
@@ -91,6 +102,21 @@ MS_REG_CPU_KERNEL(
 MS_REG_CPU_KERNEL(
   Sub, KernelAttr().AddInputAttr(kNumberTypeInt64).AddInputAttr(kNumberTypeInt64).AddOutputAttr(kNumberTypeInt64),
   ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(
+  Sub, KernelAttr().AddInputAttr(kNumberTypeFloat16).AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+  ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(
+  TensorAdd,
+  KernelAttr().AddInputAttr(kNumberTypeInt32).AddInputAttr(kNumberTypeInt32).AddOutputAttr(kNumberTypeInt32),
+  ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(
+  TensorAdd,
+  KernelAttr().AddInputAttr(kNumberTypeInt64).AddInputAttr(kNumberTypeInt64).AddOutputAttr(kNumberTypeInt64),
+  ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(
+  TensorAdd,
+  KernelAttr().AddInputAttr(kNumberTypeFloat16).AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+  ArithmeticCPUKernel);
 MS_REG_CPU_KERNEL(
   Pow, KernelAttr().AddInputAttr(kNumberTypeInt32).AddInputAttr(kNumberTypeInt32).AddOutputAttr(kNumberTypeInt32),
   ArithmeticCPUKernel);
@@ -156,6 +182,12 @@ MS_REG_CPU_KERNEL(
 MS_REG_CPU_KERNEL(
   Mul, KernelAttr().AddInputAttr(kNumberTypeInt32).AddInputAttr(kNumberTypeInt32).AddOutputAttr(kNumberTypeInt32),
   ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(
+  Mul, KernelAttr().AddInputAttr(kNumberTypeInt64).AddInputAttr(kNumberTypeInt64).AddOutputAttr(kNumberTypeInt64),
+  ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(
+  Mul, KernelAttr().AddInputAttr(kNumberTypeFloat16).AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+  ArithmeticCPUKernel);
 MS_REG_CPU_KERNEL(
   Equal, KernelAttr().AddInputAttr(kNumberTypeBool).AddInputAttr(kNumberTypeBool).AddOutputAttr(kNumberTypeBool),
   ArithmeticCPUKernel);
@@ -15,7 +15,6 @@
  */
 #include <cmath>
 #include <string>
-#include <thread>
 #include "backend/kernel_compiler/cpu/arithmetic_self_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 
@@ -131,45 +130,27 @@ void ArithmeticSelfCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs
   T *output = reinterpret_cast<T *>(outputs[0]->addr);
   size_t lens = outputs[0]->size > 0 ? static_cast<size_t>(outputs[0]->size / sizeof(T)) : 1;
 
-  auto max_thread_num = std::thread::hardware_concurrency();
-  size_t thread_num = lens < 128 * max_thread_num ? std::ceil(lens / 128.0) : max_thread_num;
-  MS_LOG(INFO) << "Lens=" << lens << "; use thread_num=" << thread_num << "; max_thread_num: " << max_thread_num;
-  std::vector<std::thread> threads;
-  if (thread_num < 1) {
-    MS_LOG(ERROR) << "Invalid value: thread_num " << thread_num;
-    return;
-  }
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t once_compute_size = (lens + thread_num - 1) / thread_num;
-  if (once_compute_size < 1) {
-    MS_LOG(ERROR) << "Invalid value: once_compute_size " << once_compute_size;
+  CTask task;
+  if (operate_type_ == SQUARE) {
+    task = [&](size_t start, size_t end) { Square<T>(input, output, start, end); };
+  } else if (operate_type_ == NEG) {
+    task = [&](size_t start, size_t end) { Neg<T>(input, output, start, end); };
+  } else if (operate_type_ == ONESLIKE) {
+    task = [&](size_t start, size_t end) { OnesLike<T>(input, output, start, end); };
+  } else if (operate_type_ == ZEROSLIKE) {
+    task = [&](size_t start, size_t end) { ZerosLike<T>(input, output, start, end); };
+  } else if (operate_type_ == SIGN) {
+    task = [&](size_t start, size_t end) { Sign<T>(input, output, start, end); };
+  } else if (operate_type_ == FLOOR) {
+    task = [&](size_t start, size_t end) { Floor<T>(input, output, start, end); };
+  } else if (operate_type_ == RECIPROCAL) {
+    task = [&](size_t start, size_t end) { Reciprocal<T>(input, output, start, end); };
+  } else if (operate_type_ == GELU) {
+    task = [&](size_t start, size_t end) { Gelu<T>(input, output, start, end); };
+  } else {
     return;
   }
-  while (start < lens) {
-    size_t end = (start + once_compute_size) > lens ? lens : (start + once_compute_size);
-    if (operate_type_ == SQUARE) {
-      threads.emplace_back(std::thread(Square<T>, input, output, start, end));
-    } else if (operate_type_ == NEG) {
-      threads.emplace_back(std::thread(Neg<T>, input, output, start, end));
-    } else if (operate_type_ == ONESLIKE) {
-      threads.emplace_back(std::thread(OnesLike<T>, input, output, start, end));
-    } else if (operate_type_ == ZEROSLIKE) {
-      threads.emplace_back(std::thread(ZerosLike<T>, input, output, start, end));
-    } else if (operate_type_ == SIGN) {
-      threads.emplace_back(std::thread(Sign<T>, input, output, start, end));
-    } else if (operate_type_ == FLOOR) {
-      threads.emplace_back(std::thread(Floor<T>, input, output, start, end));
-    } else if (operate_type_ == RECIPROCAL) {
-      threads.emplace_back(std::thread(Reciprocal<T>, input, output, start, end));
-    } else if (operate_type_ == GELU) {
-      threads.emplace_back(std::thread(Gelu<T>, input, output, start, end));
-    }
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
-  }
+  CPUKernelUtils::ParallelFor(task, lens);
 }
 }  // namespace kernel
 }  // namespace mindspore
@@ -0,0 +1,363 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/arithmetic_simd.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ARITHMETIC_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace mindspore {
+namespace kernel {
+#ifdef ARITHMETIC_SIMD_X86
+namespace {
+// The library is built for the baseline x86-64 ISA, so the vector paths are compiled per function with target
+// attributes and selected once by cpuid. Every AVX2 capable CPU also supports FMA and F16C.
+#define TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+#define TARGET_AVX512 __attribute__((target("avx512f,avx2,fma,f16c")))
+
+enum class SimdLevel { kNone, kAvx2, kAvx512 };
+
+SimdLevel GetSimdLevel() {
+  static const SimdLevel level = []() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+      return SimdLevel::kAvx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+      return SimdLevel::kAvx2;
+    }
+    return SimdLevel::kNone;
+  }();
+  return level;
+}
+
+struct Avx2Float {
+  using Scalar = float;
+  using Vec = __m256;
+  static constexpr size_t kWidth = 8;
+  TARGET_AVX2 static inline Vec Set1(Scalar v) { return _mm256_set1_ps(v); }
+  TARGET_AVX2 static inline Vec Load(const Scalar *p) { return _mm256_loadu_ps(p); }
+  TARGET_AVX2 static inline void Store(Scalar *p, Vec v) { _mm256_storeu_ps(p, v); }
+  TARGET_AVX2 static inline Vec Add(Vec x, Vec y) { return _mm256_add_ps(x, y); }
+  TARGET_AVX2 static inline Vec Sub(Vec x, Vec y) { return _mm256_sub_ps(x, y); }
+  TARGET_AVX2 static inline Vec Mul(Vec x, Vec y) { return _mm256_mul_ps(x, y); }
+};
+
+struct Avx2Int32 {
+  using Scalar = int32_t;
+  using Vec = __m256i;
+  static constexpr size_t kWidth = 8;
+  TARGET_AVX2 static inline Vec Set1(Scalar v) { return _mm256_set1_epi32(v); }
+  TARGET_AVX2 static inline Vec Load(const Scalar *p) { return _mm256_loadu_si256(reinterpret_cast<const Vec *>(p)); }
+  TARGET_AVX2 static inline void Store(Scalar *p, Vec v) { _mm256_storeu_si256(reinterpret_cast<Vec *>(p), v); }
+  TARGET_AVX2 static inline Vec Add(Vec x, Vec y) { return _mm256_add_epi32(x, y); }
+  TARGET_AVX2 static inline Vec Sub(Vec x, Vec y) { return _mm256_sub_epi32(x, y); }
+  TARGET_AVX2 static inline Vec Mul(Vec x, Vec y) { return _mm256_mullo_epi32(x, y); }
+};
+
+// float16 is widened to float32 with F16C, computed in float32 and rounded back on store.
+struct Avx2Half : public Avx2Float {
+  using Scalar = float16;
+  TARGET_AVX2 static inline Vec Set1(Scalar v) { return _mm256_set1_ps(static_cast<float>(v)); }
+  TARGET_AVX2 static inline Vec Load(const Scalar *p) {
+    return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+  }
+  TARGET_AVX2 static inline void Store(Scalar *p, Vec v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+  }
+};
+
+struct Avx512Float {
+  using Scalar = float;
+  using Vec = __m512;
+  static constexpr size_t kWidth = 16;
+  TARGET_AVX512 static inline Vec Set1(Scalar v) { return _mm512_set1_ps(v); }
+  TARGET_AVX512 static inline Vec Load(const Scalar *p) { return _mm512_loadu_ps(p); }
+  TARGET_AVX512 static inline void Store(Scalar *p, Vec v) { _mm512_storeu_ps(p, v); }
+  TARGET_AVX512 static inline Vec Add(Vec x, Vec y) { return _mm512_add_ps(x, y); }
+  TARGET_AVX512 static inline Vec Sub(Vec x, Vec y) { return _mm512_sub_ps(x, y); }
+  TARGET_AVX512 static inline Vec Mul(Vec x, Vec y) { return _mm512_mul_ps(x, y); }
+};
+
+struct Avx512Int32 {
+  using Scalar = int32_t;
+  using Vec = __m512i;
+  static constexpr size_t kWidth = 16;
+  TARGET_AVX512 static inline Vec Set1(Scalar v) { return _mm512_set1_epi32(v); }
+  TARGET_AVX512 static inline Vec Load(const Scalar *p) { return _mm512_loadu_si512(p); }
+  TARGET_AVX512 static inline void Store(Scalar *p, Vec v) { _mm512_storeu_si512(p, v); }
+  TARGET_AVX512 static inline Vec Add(Vec x, Vec y) { return _mm512_add_epi32(x, y); }
+  TARGET_AVX512 static inline Vec Sub(Vec x, Vec y) { return _mm512_sub_epi32(x, y); }
+  TARGET_AVX512 static inline Vec Mul(Vec x, Vec y) { return _mm512_mullo_epi32(x, y); }
+};
+
+// The zero-masked conversions are used because the unmasked ones trip -Wmaybe-uninitialized inside gcc's headers.
+struct Avx512Half : public Avx512Float {
+  using Scalar = float16;
+  static constexpr __mmask16 kFullMask = 0xFFFF;
+  TARGET_AVX512 static inline Vec Set1(Scalar v) { return _mm512_set1_ps(static_cast<float>(v)); }
+  TARGET_AVX512 static inline Vec Load(const Scalar *p) {
+    return _mm512_maskz_cvtph_ps(kFullMask, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)));
+  }
+  TARGET_AVX512 static inline void Store(Scalar *p, Vec v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p),
+                        _mm512_maskz_cvtps_ph(kFullMask, v, _MM_FROUND_TO_NEAREST_INT));
+  }
+};
+
+// The loop body is shared by both instruction sets, only the target attribute of the enclosing function differs.
+#define SIMD_BINARY_LOOP_BODY                                     \
+  using Vec = typename Traits::Vec;                               \
+  Vec va = Traits::Set1(a[0]);                                    \
+  Vec vb = Traits::Set1(b[0]);                                    \
+  size_t i = 0;                                                   \
+  for (; i + Traits::kWidth <= count; i += Traits::kWidth) {      \
+    if (stride_a != 0) {                                          \
+      va = Traits::Load(a + i);                                   \
+    }                                                             \
+    if (stride_b != 0) {                                          \
+      vb = Traits::Load(b + i);                                   \
+    }                                                             \
+    Vec vo;                                                       \
+    if constexpr (op == SimdBinaryOp::kAdd) {                     \
+      vo = Traits::Add(va, vb);                                   \
+    } else if constexpr (op == SimdBinaryOp::kSub) {              \
+      vo = Traits::Sub(va, vb);                                   \
+    } else if constexpr (op == SimdBinaryOp::kMul) {              \
+      vo = Traits::Mul(va, vb);                                   \
+    } else {                                                      \
+      Vec diff = Traits::Sub(va, vb);                             \
+      vo = Traits::Mul(diff, diff);                               \
+    }                                                             \
+    Traits::Store(out + i, vo);                                   \
+  }                                                               \
+  return i;
+
+template <typename Traits, SimdBinaryOp op>
+TARGET_AVX2 size_t BinaryLoopAvx2(const typename Traits::Scalar *a, size_t stride_a,
+                                  const typename Traits::Scalar *b, size_t stride_b, typename Traits::Scalar *out,
+                                  size_t count) {
+  SIMD_BINARY_LOOP_BODY
+}
+
+template <typename Traits, SimdBinaryOp op>
+TARGET_AVX512 size_t BinaryLoopAvx512(const typename Traits::Scalar *a, size_t stride_a,
+                                      const typename Traits::Scalar *b, size_t stride_b,
+                                      typename Traits::Scalar *out, size_t count) {
+  SIMD_BINARY_LOOP_BODY
+}
+#undef SIMD_BINARY_LOOP_BODY
+
+template <typename Traits512, typename Traits256, typename T>
+size_t DispatchBinary(SimdBinaryOp op, const T *a, size_t stride_a, const T *b, size_t stride_b, T *out,
+                      size_t count) {
+  SimdLevel level = GetSimdLevel();
+  if (level == SimdLevel::kAvx512) {
+    switch (op) {
+      case SimdBinaryOp::kAdd:
+        return BinaryLoopAvx512<Traits512, SimdBinaryOp::kAdd>(a, stride_a, b, stride_b, out, count);
+      case SimdBinaryOp::kSub:
+        return BinaryLoopAvx512<Traits512, SimdBinaryOp::kSub>(a, stride_a, b, stride_b, out, count);
+      case SimdBinaryOp::kMul:
+        return BinaryLoopAvx512<Traits512, SimdBinaryOp::kMul>(a, stride_a, b, stride_b, out, count);
+      case SimdBinaryOp::kSquaredDifference:
+        return BinaryLoopAvx512<Traits512, SimdBinaryOp::kSquaredDifference>(a, stride_a, b, stride_b, out, count);
+    }
+  } else if (level == SimdLevel::kAvx2) {
+    switch (op) {
+      case SimdBinaryOp::kAdd:
+        return BinaryLoopAvx2<Traits256, SimdBinaryOp::kAdd>(a, stride_a, b, stride_b, out, count);
+      case SimdBinaryOp::kSub:
+        return BinaryLoopAvx2<Traits256, SimdBinaryOp::kSub>(a, stride_a, b, stride_b, out, count);
+      case SimdBinaryOp::kMul:
+        return BinaryLoopAvx2<Traits256, SimdBinaryOp::kMul>(a, stride_a, b, stride_b, out, count);
+      case SimdBinaryOp::kSquaredDifference:
+        return BinaryLoopAvx2<Traits256, SimdBinaryOp::kSquaredDifference>(a, stride_a, b, stride_b, out, count);
+    }
+  }
+  return 0;
+}
+
+// Transposes the 8x8 block of 32-bit elements at in into out within the registers: the rows are interleaved in pairs,
+// then in quads, and the 128-bit halves of the quads are swapped last.
+TARGET_AVX2 inline void Transpose8x8Avx2(const uint32_t *in, size_t in_stride, uint32_t *out, size_t out_stride) {
+  __m256 r[kSimdTransposeBlockSize];
+  for (size_t i = 0; i < kSimdTransposeBlockSize; ++i) {
+    r[i] = _mm256_loadu_ps(reinterpret_cast<const float *>(in + i * in_stride));
+  }
+  __m256 t[kSimdTransposeBlockSize];
+  for (size_t i = 0; i < kSimdTransposeBlockSize; i += 2) {
+    t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+    t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+  }
+  for (size_t i = 0; i < kSimdTransposeBlockSize; i += 4) {
+    r[i] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+    r[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+    r[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+    r[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+  }
+  for (size_t i = 0; i < kSimdTransposeBlockSize / 2; ++i) {
+    t[i] = _mm256_permute2f128_ps(r[i], r[i + 4], 0x20);
+    t[i + 4] = _mm256_permute2f128_ps(r[i], r[i + 4], 0x31);
+  }
+  for (size_t i = 0; i < kSimdTransposeBlockSize; ++i) {
+    _mm256_storeu_ps(reinterpret_cast<float *>(out + i * out_stride), t[i]);
+  }
+}
+
+TARGET_AVX2 void TransposeTileAvx2(const uint32_t *in, size_t in_stride, uint32_t *out, size_t out_stride,
+                                   size_t rows, size_t cols) {
+  for (size_t i = 0; i < rows; i += kSimdTransposeBlockSize) {
+    for (size_t j = 0; j < cols; j += kSimdTransposeBlockSize) {
+      Transpose8x8Avx2(in + i * in_stride + j, in_stride, out + j * out_stride + i, out_stride);
+    }
+  }
+}
+
+TARGET_AVX2 size_t AxpyAvx2(float alpha, const float *x, float *y, size_t count) {
+  __m256 va = _mm256_set1_ps(alpha);
+  size_t i = 0;
+  for (; i + Avx2Float::kWidth <= count; i += Avx2Float::kWidth) {
+    _mm256_storeu_ps(y + i, _mm256_fmadd_ps(va, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+  }
+  return i;
+}
+
+TARGET_AVX512 size_t AxpyAvx512(float alpha, const float *x, float *y, size_t count) {
+  __m512 va = _mm512_set1_ps(alpha);
+  size_t i = 0;
+  for (; i + Avx512Float::kWidth <= count; i += Avx512Float::kWidth) {
+    _mm512_storeu_ps(y + i, _mm512_fmadd_ps(va, _mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i)));
+  }
+  return i;
+}
+
+TARGET_AVX2 float ReduceAdd256(__m256 sum) {
+  __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+  half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+  half = _mm_add_ss(half, _mm_movehdup_ps(half));
+  return _mm_cvtss_f32(half);
+}
+
+// Two accumulators hide the latency of the FMA.
+TARGET_AVX2 size_t DotAvx2(const float *a, const float *b, size_t count, float *result) {
+  __m256 sum0 = _mm256_setzero_ps();
+  __m256 sum1 = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; i + 2 * Avx2Float::kWidth <= count; i += 2 * Avx2Float::kWidth) {
+    sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum0);
+    sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + Avx2Float::kWidth), _mm256_loadu_ps(b + i + Avx2Float::kWidth),
+                           sum1);
+  }
+  for (; i + Avx2Float::kWidth <= count; i += Avx2Float::kWidth) {
+    sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum0);
+  }
+  *result = ReduceAdd256(_mm256_add_ps(sum0, sum1));
+  return i;
+}
+
+TARGET_AVX512 size_t DotAvx512(const float *a, const float *b, size_t count, float *result) {
+  __m512 sum = _mm512_setzero_ps();
+  size_t i = 0;
+  for (; i + Avx512Float::kWidth <= count; i += Avx512Float::kWidth) {
+    sum = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), sum);
+  }
+  // _mm512_reduce_add_ps and the unmasked extracts start from _mm256_undefined_pd, which gcc 12 reports as used
+  // uninitialized. The masked extract takes an explicit source, in doubles since the float one needs AVX512DQ.
+  __m512d sum_pd = _mm512_castps_pd(sum);
+  __m256d zero = _mm256_setzero_pd();
+  __m256 low = _mm256_castpd_ps(_mm512_mask_extractf64x4_pd(zero, 0xFF, sum_pd, 0));
+  __m256 high = _mm256_castpd_ps(_mm512_mask_extractf64x4_pd(zero, 0xFF, sum_pd, 1));
+  *result = ReduceAdd256(_mm256_add_ps(low, high));
+  return i;
+}
+}  // namespace
+
+template <>
+size_t SimdAxpy<float>(float alpha, const float *x, float *y, size_t count) {
+  SimdLevel level = GetSimdLevel();
+  if (level == SimdLevel::kAvx512) {
+    return AxpyAvx512(alpha, x, y, count);
+  }
+  return level == SimdLevel::kAvx2 ? AxpyAvx2(alpha, x, y, count) : 0;
+}
+
+template <>
+size_t SimdDot<float>(const float *a, const float *b, size_t count, float *result) {
+  SimdLevel level = GetSimdLevel();
+  if (level == SimdLevel::kAvx512) {
+    return DotAvx512(a, b, count, result);
+  }
+  return level == SimdLevel::kAvx2 ? DotAvx2(a, b, count, result) : 0;
+}
+
+bool SimdTransposeTile32(const uint32_t *in, size_t in_stride, uint32_t *out, size_t out_stride, size_t rows,
+                         size_t cols) {
+  if (GetSimdLevel() == SimdLevel::kNone) {
+    return false;
+  }
+  TransposeTileAvx2(in, in_stride, out, out_stride, rows, cols);
+  return true;
+}
+
+template <>
+size_t SimdBinary<float>(SimdBinaryOp op, const float *a, size_t stride_a, const float *b, size_t stride_b,
+                         float *out, size_t count) {
+  return DispatchBinary<Avx512Float, Avx2Float>(op, a, stride_a, b, stride_b, out, count);
+}
+
+template <>
+size_t SimdBinary<int32_t>(SimdBinaryOp op, const int32_t *a, size_t stride_a, const int32_t *b, size_t stride_b,
+                           int32_t *out, size_t count) {
+  return DispatchBinary<Avx512Int32, Avx2Int32>(op, a, stride_a, b, stride_b, out, count);
+}
+
+template <>
+size_t SimdBinary<float16>(SimdBinaryOp op, const float16 *a, size_t stride_a, const float16 *b, size_t stride_b,
+                           float16 *out, size_t count) {
+  return DispatchBinary<Avx512Half, Avx2Half>(op, a, stride_a, b, stride_b, out, count);
+}
+#else
+template <>
+size_t SimdAxpy<float>(float, const float *, float *, size_t) {
+  return 0;
+}
+
+template <>
+size_t SimdDot<float>(const float *, const float *, size_t, float *) {
+  return 0;
+}
+
+bool SimdTransposeTile32(const uint32_t *, size_t, uint32_t *, size_t, size_t, size_t) { return false; }
+
+template <>
+size_t SimdBinary<float>(SimdBinaryOp, const float *, size_t, const float *, size_t, float *, size_t) {
+  return 0;
+}
+
+template <>
+size_t SimdBinary<int32_t>(SimdBinaryOp, const int32_t *, size_t, const int32_t *, size_t, int32_t *, size_t) {
+  return 0;
+}
+
+template <>
+size_t SimdBinary<float16>(SimdBinaryOp, const float16 *, size_t, const float16 *, size_t, float16 *, size_t) {
+  return 0;
+}
+#endif
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,70 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ARITHMETIC_SIMD_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ARITHMETIC_SIMD_H_
+#include <cstddef>
+#include <cstdint>
+#include "base/float16.h"
+
+namespace mindspore {
+namespace kernel {
+enum class SimdBinaryOp { kAdd, kSub, kMul, kSquaredDifference };
+
+// Vectorized inner loop of the binary arithmetic kernels: out[i] = a[i * stride_a] op b[i * stride_b], where each
+// stride is 0 (broadcast scalar) or 1 (contiguous). The instruction set (AVX-512 or AVX2) is picked at runtime.
+// Returns how many leading elements were written, the caller finishes the tail and any type without a SIMD path.
+template <typename T>
+size_t SimdBinary(SimdBinaryOp /*op*/, const T * /*a*/, size_t /*stride_a*/, const T * /*b*/, size_t /*stride_b*/,
+                  T * /*out*/, size_t /*count*/) {
+  return 0;
+}
+template <>
+size_t SimdBinary<float>(SimdBinaryOp op, const float *a, size_t stride_a, const float *b, size_t stride_b,
+                         float *out, size_t count);
+template <>
+size_t SimdBinary<int32_t>(SimdBinaryOp op, const int32_t *a, size_t stride_a, const int32_t *b, size_t stride_b,
+                           int32_t *out, size_t count);
+template <>
+size_t SimdBinary<float16>(SimdBinaryOp op, const float16 *a, size_t stride_a, const float16 *b, size_t stride_b,
+                           float16 *out, size_t count);
+
+// y[i] += alpha * x[i], the inner loop of the sparse matmul. Returns how many leading elements were updated.
+template <typename T>
+size_t SimdAxpy(T /*alpha*/, const T * /*x*/, T * /*y*/, size_t /*count*/) {
+  return 0;
+}
+template <>
+size_t SimdAxpy<float>(float alpha, const float *x, float *y, size_t count);
+
+// Sets *result to the sum of a[i] * b[i] over the returned number of leading elements.
+template <typename T>
+size_t SimdDot(const T * /*a*/, const T * /*b*/, size_t /*count*/, T * /*result*/) {
+  return 0;
+}
+template <>
+size_t SimdDot<float>(const float *a, const float *b, size_t count, float *result);
+
+// The edge of the blocks transposed in registers by SimdTransposeTile32.
+constexpr size_t kSimdTransposeBlockSize = 8;
+
+// Transposes a tile of 32-bit elements: out[j * out_stride + i] = in[i * in_stride + j] for i < rows and j < cols,
+// both multiples of kSimdTransposeBlockSize. Returns false without writing anything when the CPU has no AVX2.
+bool SimdTransposeTile32(const uint32_t *in, size_t in_stride, uint32_t *out, size_t out_stride, size_t rows,
+                         size_t cols);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ARITHMETIC_SIMD_H_
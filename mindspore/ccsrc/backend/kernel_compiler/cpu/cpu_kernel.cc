@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include <algorithm>
+#include <utility>
+#include "common/thread_pool.h"
 
 namespace mindspore {
 namespace kernel {
@@ -81,21 +84,9 @@ void CPUKernelUtils::GetElementNumEveryDim(const std::vector<size_t> &shape, std
 }
 
 void CPUKernelUtils::ParallelFor(const CTask &task, size_t count) {
-  auto max_thread_num = std::thread::hardware_concurrency();
-  const float block_size = 128.0;
-  size_t thread_num = count < block_size * max_thread_num ? std::ceil(count / block_size) : max_thread_num;
-  std::vector<std::thread> threads;
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t once_compute_size = (count + thread_num - 1) / thread_num;
-  while (start < count) {
-    size_t end = (start + once_compute_size) > count ? count : (start + once_compute_size);
-    threads.emplace_back(std::thread(task, start, end));
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
-  }
+  auto &thread_pool = common::ThreadPool::GetInstance();
+  size_t grain = std::max(count / (thread_pool.GetSyncRunThreadNum() * kParallelChunkNumPerThread), kParallelBlockSize);
+  thread_pool.ParallelFor(task, count, grain);
 }
 
 std::vector<size_t> CPUKernelUtils::FlatShapeByAxis(const std::vector<size_t> &shape, int axis) {
@@ -117,5 +108,108 @@ std::vector<size_t> CPUKernelUtils::FlatShapeByAxis(const std::vector<size_t> &s
   return flat_shape;
 }
 
+BroadcastIterator::BroadcastIterator(const std::vector<size_t> &input_shape_a,
+                                     const std::vector<size_t> &input_shape_b,
+                                     const std::vector<size_t> &output_shape) {
+  DimArray shape_a{};
+  DimArray shape_b{};
+  BroadcastShape(input_shape_a, input_shape_b, output_shape, &shape_a, &shape_b);
+  InitStrides(shape_a, shape_b);
+}
+
+void BroadcastIterator::BroadcastShape(const std::vector<size_t> &input_shape_a,
+                                       const std::vector<size_t> &input_shape_b,
+                                       const std::vector<size_t> &output_shape, DimArray *shape_a, DimArray *shape_b) {
+  size_t output_dim = output_shape.size();
+  if (input_shape_a.size() > output_dim || input_shape_b.size() > output_dim) {
+    MS_LOG(EXCEPTION) << "Input rank " << input_shape_a.size() << " and " << input_shape_b.size()
+                      << " should not be greater than output rank " << output_dim;
+  }
+  size_t offset_a = output_dim - input_shape_a.size();
+  size_t offset_b = output_dim - input_shape_b.size();
+
+  // Drop the size-1 output dims and merge each dim into the previous one when both inputs broadcast the same way,
+  // e.g. [2, 3, 4] + [1, 1, 4] becomes [6, 4] + [1, 4].
+  dim_num_ = 0;
+  for (size_t i = 0; i < output_dim; ++i) {
+    if (output_shape[i] == 1) {
+      continue;
+    }
+    size_t dim_a = i < offset_a ? 1 : input_shape_a[i - offset_a];
+    size_t dim_b = i < offset_b ? 1 : input_shape_b[i - offset_b];
+    if (dim_a != output_shape[i] && dim_a != 1) {
+      MS_LOG(EXCEPTION) << "Input shape a can not broadcast to output shape at dim " << i;
+    }
+    if (dim_b != output_shape[i] && dim_b != 1) {
+      MS_LOG(EXCEPTION) << "Input shape b can not broadcast to output shape at dim " << i;
+    }
+    if (dim_num_ > 0 && (dim_a == 1) == ((*shape_a)[dim_num_ - 1] == 1) &&
+        (dim_b == 1) == ((*shape_b)[dim_num_ - 1] == 1)) {
+      (*shape_a)[dim_num_ - 1] *= dim_a;
+      (*shape_b)[dim_num_ - 1] *= dim_b;
+      output_shape_[dim_num_ - 1] *= output_shape[i];
+      continue;
+    }
+    if (dim_num_ == kMaxBroadcastDims) {
+      MS_LOG(EXCEPTION) << "Broadcast supports at most " << kMaxBroadcastDims << " dims after merging, the output "
+                        << "shape has " << output_dim << " dims";
+    }
+    (*shape_a)[dim_num_] = dim_a;
+    (*shape_b)[dim_num_] = dim_b;
+    output_shape_[dim_num_] = output_shape[i];
+    ++dim_num_;
+  }
+  if (dim_num_ == 0) {
+    (*shape_a)[0] = 1;
+    (*shape_b)[0] = 1;
+    output_shape_[0] = 1;
+    dim_num_ = 1;
+  }
+}
+
+void BroadcastIterator::InitStrides(const DimArray &shape_a, const DimArray &shape_b) {
+  size_t stride_a = 1;
+  size_t stride_b = 1;
+  size_t stride_out = 1;
+  for (size_t i = dim_num_; i > 0; --i) {
+    size_t dim = i - 1;
+    input_strides_a_[dim] = shape_a[dim] == 1 ? 0 : stride_a;
+    input_strides_b_[dim] = shape_b[dim] == 1 ? 0 : stride_b;
+    input_back_strides_a_[dim] = input_strides_a_[dim] * (output_shape_[dim] - 1);
+    input_back_strides_b_[dim] = input_strides_b_[dim] * (output_shape_[dim] - 1);
+    output_strides_[dim] = stride_out;
+    stride_a *= shape_a[dim];
+    stride_b *= shape_b[dim];
+    stride_out *= output_shape_[dim];
+  }
+}
+
+void BroadcastIterator::SetPos(size_t pos) {
+  input_pos_[0] = 0;
+  input_pos_[1] = 0;
+  for (size_t i = 0; i < dim_num_; ++i) {
+    coordinates_[i] = pos / output_strides_[i];
+    pos %= output_strides_[i];
+    input_pos_[0] += coordinates_[i] * input_strides_a_[i];
+    input_pos_[1] += coordinates_[i] * input_strides_b_[i];
+  }
+}
+
+void BroadcastIterator::GenNextPos(size_t step) {
+  size_t dim = dim_num_ - 1;
+  coordinates_[dim] += step;
+  input_pos_[0] += step * input_strides_a_[dim];
+  input_pos_[1] += step * input_strides_b_[dim];
+  // Carry into the outer dims once the innermost run is exhausted.
+  while (coordinates_[dim] == output_shape_[dim] && dim > 0) {
+    input_pos_[0] -= input_back_strides_a_[dim] + input_strides_a_[dim];
+    input_pos_[1] -= input_back_strides_b_[dim] + input_strides_b_[dim];
+    coordinates_[dim] = 0;
+    --dim;
+    coordinates_[dim]++;
+    input_pos_[0] += input_strides_a_[dim];
+    input_pos_[1] += input_strides_b_[dim];
+  }
+}
 }  // namespace kernel
 }  // namespace mindspore
@@ -15,11 +15,11 @@
  */
 #ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_KERNEL_H_
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_KERNEL_H_
+#include <array>
 #include <functional>
 #include <memory>
 #include <numeric>
 #include <string>
-#include <thread>
 #include <vector>
 #include "backend/kernel_compiler/kernel.h"
 #include "backend/session/anf_runtime_algorithm.h"
@@ -56,6 +56,10 @@ const char GROUP[] = "group";
 const char START[] = "start";
 const char LIMIT[] = "limit";
 const char DELTA[] = "delta";
+// ParallelFor hands out at least kParallelBlockSize elements per chunk, and about kParallelChunkNumPerThread chunks
+// to every thread so that the work stealing can balance the load.
+const size_t kParallelBlockSize = 128;
+const size_t kParallelChunkNumPerThread = 4;
 
 enum OperateType {
   ADD = 0,
@@ -124,6 +128,47 @@ class CPUKernelUtils {
   static void ParallelFor(const CTask &task, size_t count);
   static std::vector<size_t> FlatShapeByAxis(const std::vector<size_t> &shape, int axis);
 };
+
+// The most dims a BroadcastIterator walks, once the dims with the same broadcast pattern are merged.
+constexpr size_t kMaxBroadcastDims = 8;
+
+// BroadcastIterator walks the output of a binary broadcast op in row-major order and tracks the matching offsets of
+// both inputs. Adjacent dims with the same broadcast pattern are merged on construction, and the offsets are advanced
+// by precomputed strides, so no division is needed after SetPos. Its state is held in fixed size arrays, so a kernel
+// builds the iterator once in InitKernel and each parallel task copies it without allocating memory.
+class BroadcastIterator {
+ public:
+  BroadcastIterator(const std::vector<size_t> &input_shape_a, const std::vector<size_t> &input_shape_b,
+                    const std::vector<size_t> &output_shape);
+  ~BroadcastIterator() = default;
+  inline size_t GetInputPosA() const { return input_pos_[0]; }
+  inline size_t GetInputPosB() const { return input_pos_[1]; }
+  // Stride of each input along the innermost merged dim, 0 when that input is broadcast there and 1 otherwise.
+  inline size_t GetInnerStrideA() const { return input_strides_a_[dim_num_ - 1]; }
+  inline size_t GetInnerStrideB() const { return input_strides_b_[dim_num_ - 1]; }
+  // Number of output elements left in the current innermost run, including the current one.
+  inline size_t GetInnerRemain() const { return output_shape_[dim_num_ - 1] - coordinates_[dim_num_ - 1]; }
+  void SetPos(size_t pos);
+  inline void GenNextPos() { GenNextPos(1); }
+  // Advance by step elements, step must not exceed GetInnerRemain().
+  void GenNextPos(size_t step);
+
+ private:
+  using DimArray = std::array<size_t, kMaxBroadcastDims>;
+  void BroadcastShape(const std::vector<size_t> &input_shape_a, const std::vector<size_t> &input_shape_b,
+                      const std::vector<size_t> &output_shape, DimArray *shape_a, DimArray *shape_b);
+  void InitStrides(const DimArray &shape_a, const DimArray &shape_b);
+
+  size_t dim_num_{0};
+  DimArray coordinates_{};
+  DimArray output_shape_{};
+  DimArray input_strides_a_{};
+  DimArray input_strides_b_{};
+  DimArray input_back_strides_a_{};
+  DimArray input_back_strides_b_{};
+  DimArray output_strides_{};
+  std::array<size_t, 2> input_pos_{0};
+};
 }  // namespace kernel
 }  // namespace mindspore
 
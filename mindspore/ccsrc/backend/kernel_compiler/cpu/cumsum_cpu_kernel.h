@@ -17,13 +17,13 @@
 #ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CUMSUM_CPU_KERNEL_H_
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CUMSUM_CPU_KERNEL_H_
 
-#include <memory>
 #include <vector>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 
 namespace mindspore {
 namespace kernel {
+// CumSum and CumProd, the scan of ParallelScan along the axis.
 class CumSumCPUKernel : public CPUKernel {
  public:
   CumSumCPUKernel() = default;
@@ -31,55 +31,23 @@ class CumSumCPUKernel : public CPUKernel {
 
   void InitKernel(const CNodePtr &kernel_node) override;
 
-  void InitInputOutputSize(const CNodePtr &kernel_node) override;
-
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
 
   template <typename T>
-  void InitWorkspaceSize();
-
-  template <typename T>
-  void LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
-                    const std::vector<AddressPtr> &outputs);
-
-  template <typename T>
-  void LaunchCumSum(const T *input_addr, T *output_addr, T *ws_addr, size_t start, size_t end);
+  void LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
 
  private:
   void CheckParam(const CNodePtr &kernel_node);
 
   void Reshape();
 
-  template <typename T>
-  void LeftMove(const T *input, T *output, size_t dim0, size_t dim1, size_t dim2, size_t stride, size_t stride2,
-                size_t start, size_t end);
-
-  template <typename T>
-  void RightMove(const T *input, T *output, size_t dim0, size_t dim1, size_t dim2, size_t stride, size_t stride2,
-                 size_t start, size_t end);
-
-  template <typename T>
-  void Copy(T *input, T *output, size_t dim0, size_t dim1, size_t dim2, size_t stride, size_t stride2, size_t start,
-            size_t end);
-
-  template <typename T>
-  void CumSumKernelReverse(const T *input, T *output, size_t dim0, size_t dim1, size_t dim2, size_t stride,
-                           size_t stride2, size_t start, size_t end);
-
-  template <typename T>
-  void CumSumKernel(const T *input, T *output, size_t dim0, size_t dim1, size_t dim2, size_t stride, size_t stride2,
-                    size_t start, size_t end);
-
   std::vector<size_t> shape_;
-  std::vector<size_t> dst_shape;
-  size_t input_size_0_;
-  size_t stride_;
-  size_t stride2_;
   size_t dims_[3] = {};
-  int exclusive_;
-  int reverse_;
-  int axis_;
+  bool exclusive_{false};
+  bool reverse_{false};
+  bool is_prod_{false};
+  int axis_{0};
   TypeId dtype_{kTypeUnknown};
 };
 
@@ -90,6 +58,15 @@ MS_REG_CPU_KERNEL(CumSum, KernelAttr().AddInputAttr(kNumberTypeFloat16).AddOutpu
 MS_REG_CPU_KERNEL(CumSum, KernelAttr().AddInputAttr(kNumberTypeInt32).AddOutputAttr(kNumberTypeInt32), CumSumCPUKernel);
 MS_REG_CPU_KERNEL(CumSum, KernelAttr().AddInputAttr(kNumberTypeInt8).AddOutputAttr(kNumberTypeInt8), CumSumCPUKernel);
 MS_REG_CPU_KERNEL(CumSum, KernelAttr().AddInputAttr(kNumberTypeUInt8).AddOutputAttr(kNumberTypeUInt8), CumSumCPUKernel);
+MS_REG_CPU_KERNEL(CumProd, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  CumSumCPUKernel);
+MS_REG_CPU_KERNEL(CumProd, KernelAttr().AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+                  CumSumCPUKernel);
+MS_REG_CPU_KERNEL(CumProd, KernelAttr().AddInputAttr(kNumberTypeInt32).AddOutputAttr(kNumberTypeInt32),
+                  CumSumCPUKernel);
+MS_REG_CPU_KERNEL(CumProd, KernelAttr().AddInputAttr(kNumberTypeInt8).AddOutputAttr(kNumberTypeInt8), CumSumCPUKernel);
+MS_REG_CPU_KERNEL(CumProd, KernelAttr().AddInputAttr(kNumberTypeUInt8).AddOutputAttr(kNumberTypeUInt8),
+                  CumSumCPUKernel);
 }  // namespace kernel
 }  // namespace mindspore
 #endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CUMSUM_CPU_KERNEL_H_
@@ -18,9 +18,15 @@
 #include <random>
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "backend/kernel_compiler/cpu/dropout_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/philox_random.h"
 
 namespace mindspore {
 namespace kernel {
+namespace {
+constexpr auto kSeed0 = "Seed0";
+constexpr auto kSeed1 = "Seed1";
+}  // namespace
+
 void DropoutCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   CheckParam(kernel_node);
   input_shape_ = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
@@ -37,6 +43,16 @@ void DropoutCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   for (const uint64_t &d : input_shape_) {
     tensor_size_ *= d;
   }
+  // The mask output is the PhiloxState of the launch when the DropoutGrad regenerates the mask.
+  regenerate_mask_ = AnfAlgo::GetOutputDeviceDataType(kernel_node, 1) == kNumberTypeUInt64;
+  int64_t seed0 = AnfAlgo::HasNodeAttr(kSeed0, kernel_node) ? AnfAlgo::GetNodeAttr<int64_t>(kernel_node, kSeed0) : 0;
+  int64_t seed1 = AnfAlgo::HasNodeAttr(kSeed1, kernel_node) ? AnfAlgo::GetNodeAttr<int64_t>(kernel_node, kSeed1) : 0;
+  if (seed0 == 0 && seed1 == 0) {
+    std::random_device rd;
+    seed_ = (static_cast<uint64_t>(rd()) << 32) | rd();
+  } else {
+    seed_ = (static_cast<uint64_t>(seed0) << 32) | static_cast<uint32_t>(seed1);
+  }
 }
 
 bool DropoutCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -54,15 +70,26 @@ template <typename T>
 void DropoutCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs) {
   auto input_addr = reinterpret_cast<T *>(inputs[0]->addr);
   auto output_addr = reinterpret_cast<T *>(outputs[0]->addr);
-  auto mask_addr = reinterpret_cast<T *>(outputs[1]->addr);
-  std::random_device rd;
-  std::mt19937 gen(rd());
-  std::bernoulli_distribution dis(keep_prob_);
-  T scale = (T)(1.f / keep_prob_);
-  for (uint64_t i = 0; i < tensor_size_; ++i) {
-    mask_addr[i] = (T)dis(gen);
-    output_addr[i] = mask_addr[i] * input_addr[i] * scale;
+  T scale = static_cast<T>(1.f / keep_prob_);
+  // Every launch draws new numbers, the counters of a launch are its elements divided by kPhiloxResultSize.
+  uint64_t counter = counter_;
+  counter_ += (tensor_size_ + kPhiloxResultSize - 1) / kPhiloxResultSize;
+  if (regenerate_mask_) {
+    auto state = reinterpret_cast<PhiloxState *>(outputs[1]->addr);
+    state->seed = seed_;
+    state->counter = counter;
+    PhiloxBernoulliParallelFor(seed_, counter, tensor_size_, keep_prob_,
+                               [input_addr, output_addr, scale](size_t i, bool keep) {
+                                 output_addr[i] = keep ? input_addr[i] * scale : static_cast<T>(0);
+                               });
+    return;
   }
+  auto mask_addr = reinterpret_cast<T *>(outputs[1]->addr);
+  PhiloxBernoulliParallelFor(seed_, counter, tensor_size_, keep_prob_,
+                             [input_addr, output_addr, mask_addr, scale](size_t i, bool keep) {
+                               mask_addr[i] = static_cast<T>(keep);
+                               output_addr[i] = mask_addr[i] * input_addr[i] * scale;
+                             });
 }
 
 void DropoutCPUKernel::CheckParam(const CNodePtr &kernel_node) {
@@ -44,6 +44,9 @@ class DropoutCPUKernel : public CPUKernel {
   TypeId dtype_{kTypeUnknown};
   float keep_prob_ = 0.0;
   uint64_t tensor_size_ = 1;
+  bool regenerate_mask_{false};
+  uint64_t seed_{0};
+  uint64_t counter_{0};
 };
 
 MS_REG_CPU_KERNEL(
@@ -54,6 +57,15 @@ MS_REG_CPU_KERNEL(
   Dropout,
   KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
   DropoutCPUKernel);
+// The mask is regenerated by the DropoutGrad from the seed and the counter of the launch, see DropoutMaskRegeneration.
+MS_REG_CPU_KERNEL(
+  Dropout,
+  KernelAttr().AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeUInt64),
+  DropoutCPUKernel);
+MS_REG_CPU_KERNEL(
+  Dropout,
+  KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeUInt64),
+  DropoutCPUKernel);
 
 }  // namespace kernel
 }  // namespace mindspore
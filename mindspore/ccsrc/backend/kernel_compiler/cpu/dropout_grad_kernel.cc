@@ -16,6 +16,7 @@
 #include <vector>
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "backend/kernel_compiler/cpu/dropout_grad_kernel.h"
+#include "backend/kernel_compiler/cpu/philox_random.h"
 
 namespace mindspore {
 namespace kernel {
@@ -24,7 +25,9 @@ void DropoutGradCpuBwdKernel::InitKernel(const CNodePtr &kernel_node) {
 
   auto input_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
   auto input_mask_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 1);
-  if (input_shape.size() != input_mask_shape.size()) {
+  // The mask input is the PhiloxState of the Dropout when the mask is regenerated.
+  regenerate_mask_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 1) == kNumberTypeUInt64;
+  if (!regenerate_mask_ && input_shape.size() != input_mask_shape.size()) {
     MS_LOG(EXCEPTION) << "Input size " << input_shape.size() << " and mask size " << input_mask_shape.size()
                       << " is not match";
   }
@@ -57,9 +60,19 @@ void DropoutGradCpuBwdKernel::DropoutBackwardKernel(const std::vector<AddressPtr
                                                     float keep_prob) {
   auto dx = reinterpret_cast<T *>(outputs[0]->addr);
   auto dy = reinterpret_cast<T *>(inputs[0]->addr);
-  auto mask = reinterpret_cast<T *>(inputs[1]->addr);
-
   const float scale = 1.f / keep_prob;
+  if (regenerate_mask_) {
+    if (inputs[1]->size < sizeof(PhiloxState)) {
+      MS_LOG(EXCEPTION) << "The mask state size " << inputs[1]->size << " is smaller than " << sizeof(PhiloxState);
+    }
+    auto state = reinterpret_cast<PhiloxState *>(inputs[1]->addr);
+    PhiloxBernoulliParallelFor(state->seed, state->counter, num_count, keep_prob,
+                               [dx, dy, scale](size_t i, bool keep) {
+                                 dx[i] = keep ? (T)(scale * static_cast<float>(dy[i])) : static_cast<T>(0);
+                               });
+    return;
+  }
+  auto mask = reinterpret_cast<T *>(inputs[1]->addr);
   for (size_t i = 0; i < num_count; i += 1) {
     dx[i] = (T)(scale * static_cast<float>(dy[i] * mask[i]));
   }
@@ -38,6 +38,7 @@ class DropoutGradCpuBwdKernel : public CPUKernel {
   float keep_prob_{1.0};
   size_t num_count_{1};
   TypeId dtype_{kTypeUnknown};
+  bool regenerate_mask_{false};
   template <typename T>
   void DropoutBackwardKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs,
                              size_t num_count, float keep_prob);
@@ -51,6 +52,14 @@ MS_REG_CPU_KERNEL(
   DropoutGrad,
   KernelAttr().AddInputAttr(kNumberTypeFloat16).AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
   DropoutGradCpuBwdKernel);
+MS_REG_CPU_KERNEL(
+  DropoutGrad,
+  KernelAttr().AddInputAttr(kNumberTypeFloat32).AddInputAttr(kNumberTypeUInt64).AddOutputAttr(kNumberTypeFloat32),
+  DropoutGradCpuBwdKernel);
+MS_REG_CPU_KERNEL(
+  DropoutGrad,
+  KernelAttr().AddInputAttr(kNumberTypeFloat16).AddInputAttr(kNumberTypeUInt64).AddOutputAttr(kNumberTypeFloat16),
+  DropoutGradCpuBwdKernel);
 }  // namespace kernel
 }  // namespace mindspore
 
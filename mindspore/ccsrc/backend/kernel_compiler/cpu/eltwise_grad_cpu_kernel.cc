@@ -15,7 +15,6 @@
  */
 #include <cmath>
 #include <string>
-#include <thread>
 #include "backend/kernel_compiler/cpu/eltwise_grad_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 
@@ -156,46 +155,25 @@ void EltWiseGradCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, c
   T *output = reinterpret_cast<T *>(outputs[0]->addr);
 
   size_t lens = outputs[0]->size > 0 ? static_cast<size_t>(outputs[0]->size / sizeof(T)) : 1;
-  auto max_thread_num = std::thread::hardware_concurrency();
-  size_t thread_num = lens < 128 * max_thread_num ? std::ceil(lens / 128.0) : max_thread_num;
-  MS_LOG(INFO) << "Lens=" << lens << "; use thread_num=" << thread_num << "; max_thread_num: " << max_thread_num;
-  std::vector<std::thread> threads;
-  if (thread_num < 1) {
-    MS_LOG(ERROR) << "Invalid value: thread_num " << thread_num;
-    return;
-  }
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t once_compute_size = (lens + thread_num - 1) / thread_num;
-  if (once_compute_size < 1) {
-    MS_LOG(ERROR) << "Invalid value: once_compute_size " << once_compute_size;
-    return;
-  }
-  while (start < lens) {
-    size_t end = (start + once_compute_size) > lens ? lens : (start + once_compute_size);
-    if (operate_type_ == RELUGRAD) {
-      threads.emplace_back(std::thread(&EltWiseGradCPUKernel::ReluGrad<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == RELU6GRAD) {
-      threads.emplace_back(std::thread(&EltWiseGradCPUKernel::ReLU6Grad<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == ABSGRAD) {
-      threads.emplace_back(std::thread(&EltWiseGradCPUKernel::AbsGrad<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == SIGMOIDGRAD) {
-      threads.emplace_back(
-        std::thread(&EltWiseGradCPUKernel::SigmoidGrad<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == TANHGRAD) {
-      threads.emplace_back(std::thread(&EltWiseGradCPUKernel::TanhGrad<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == SQRTGRAD) {
-      threads.emplace_back(std::thread(&EltWiseGradCPUKernel::SqrtGrad<T>, this, input1, input2, output, start, end));
-    } else if (operate_type_ == GELUGRAD) {
-      threads.emplace_back(std::thread(&EltWiseGradCPUKernel::GeluGrad<T>, this, input1, input2, output, start, end));
-    } else {
-      MS_LOG(EXCEPTION) << "Not support " << operate_type_;
-    }
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
+  CTask task;
+  if (operate_type_ == RELUGRAD) {
+    task = [&](size_t start, size_t end) { ReluGrad<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == RELU6GRAD) {
+    task = [&](size_t start, size_t end) { ReLU6Grad<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == ABSGRAD) {
+    task = [&](size_t start, size_t end) { AbsGrad<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == SIGMOIDGRAD) {
+    task = [&](size_t start, size_t end) { SigmoidGrad<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == TANHGRAD) {
+    task = [&](size_t start, size_t end) { TanhGrad<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == SQRTGRAD) {
+    task = [&](size_t start, size_t end) { SqrtGrad<T>(input1, input2, output, start, end); };
+  } else if (operate_type_ == GELUGRAD) {
+    task = [&](size_t start, size_t end) { GeluGrad<T>(input1, input2, output, start, end); };
+  } else {
+    MS_LOG(EXCEPTION) << "Not support " << operate_type_;
   }
+  CPUKernelUtils::ParallelFor(task, lens);
 }
 }  // namespace kernel
 }  // namespace mindspore
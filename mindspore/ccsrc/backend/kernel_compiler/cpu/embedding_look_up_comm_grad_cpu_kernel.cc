@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <thread>
 #include "backend/kernel_compiler/cpu/embedding_look_up_comm_grad_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
@@ -30,8 +31,16 @@ void EmbeddingLookUpCommGradCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   }
 }
 
+void EmbeddingLookUpCommGradCPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
+  CPUKernel::InitInputOutputSize(kernel_node);
+  if (split_num_ > 1) {
+    // The splits of all the ranks are gathered at once, then reordered into the output.
+    workspace_size_list_.emplace_back(output_size_list_[0]);
+  }
+}
+
 bool EmbeddingLookUpCommGradCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
-                                              const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                              const std::vector<kernel::AddressPtr> &workspace,
                                               const std::vector<kernel::AddressPtr> &outputs) {
 #if defined(_WIN32) || defined(_WIN64)
   auto start_time = std::chrono::steady_clock::now();
@@ -45,12 +54,30 @@ bool EmbeddingLookUpCommGradCPUKernel::Launch(const std::vector<kernel::AddressP
   size_t output_size = outputs[0]->size;
   MS_LOG(DEBUG) << "input addr: " << input_addr << "input size: " << input_size;
   MS_LOG(DEBUG) << "output addr: " << output_addr << "output size: " << output_size;
-  memset_s(output_addr, output_size, 0, output_size);
   const std::vector<int> &rank_group = {0, 1, 2, 3, 4, 5, 6, 7};
-  size_t input_split_lens = input_size / LongToSize(split_num_) / sizeof(float_t);
-  size_t output_split_lens = output_size / LongToSize(split_num_) / sizeof(float_t);
-  for (int64_t i = 0; i < split_num_; i++) {
-    MPIAllGather(input_addr + i * input_split_lens, output_addr + i * output_split_lens, rank_group, input_split_lens);
+  size_t split_num = LongToSize(split_num_);
+  size_t input_split_lens = input_size / split_num / sizeof(float_t);
+  size_t output_split_lens = output_size / split_num / sizeof(float_t);
+  if (split_num > 1 && input_split_lens > 0 && !workspace.empty() && workspace[0]->size >= output_size) {
+    // One gather lays the data out as [rank][split], the output is [split][rank].
+    auto gather_addr = reinterpret_cast<float *>(workspace[0]->addr);
+    MPIAllGather(input_addr, gather_addr, rank_group, input_split_lens * split_num);
+    size_t rank_num = output_split_lens / input_split_lens;
+    auto task = [&](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        size_t split = i / rank_num;
+        size_t rank = i % rank_num;
+        const float *src = gather_addr + (rank * split_num + split) * input_split_lens;
+        std::copy(src, src + input_split_lens, output_addr + i * input_split_lens);
+      }
+    };
+    CPUKernelUtils::ParallelFor(task, split_num * rank_num);
+  } else {
+    memset_s(output_addr, output_size, 0, output_size);
+    for (size_t i = 0; i < split_num; i++) {
+      MPIAllGather(input_addr + i * input_split_lens, output_addr + i * output_split_lens, rank_group,
+                   input_split_lens);
+    }
   }
 #if defined(_WIN32) || defined(_WIN64)
   auto end_time = std::chrono::steady_clock::now();
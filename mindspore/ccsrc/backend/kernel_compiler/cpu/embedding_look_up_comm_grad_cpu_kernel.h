@@ -28,6 +28,7 @@ class EmbeddingLookUpCommGradCPUKernel : public CPUKernel {
   ~EmbeddingLookUpCommGradCPUKernel() override{};
 
   void InitKernel(const CNodePtr &kernel_node) override;
+  void InitInputOutputSize(const CNodePtr &kernel_node) override;
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
@@ -13,9 +13,12 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <climits>
 #include <thread>
 #include <string>
 #include "backend/kernel_compiler/cpu/embedding_look_up_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/unique_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "ir/primitive.h"
 #include "common/thread_pool.h"
@@ -23,24 +26,70 @@
 namespace mindspore {
 namespace kernel {
 namespace {
+// The rows of the indices this far ahead are prefetched while the current row is copied.
+constexpr size_t kPrefetchDistance = 8;
+constexpr size_t kCacheLineSize = 64;
+constexpr size_t kMaxPrefetchLines = 8;
+// Below this number of indices the deduplication costs more than the copies it saves.
+constexpr size_t kDedupMinIndicesLens = 4096;
+constexpr size_t kDedupMinRowSize = 8;
+constexpr size_t kDedupWorkspaceNum = 6;
+
+using RowCopyFunc = void (*)(const float *src, float *dst, size_t row_size);
+
+// The width is known at compile time, so that the copy is unrolled into vector moves.
+template <size_t kRowSize>
+void CopyFixedRow(const float *src, float *dst, size_t /*row_size*/) {
+  for (size_t i = 0; i < kRowSize; ++i) {
+    dst[i] = src[i];
+  }
+}
+
+void CopyRow(const float *src, float *dst, size_t row_size) { std::copy(src, src + row_size, dst); }
+
+RowCopyFunc GetRowCopyFunc(size_t row_size) {
+  switch (row_size) {
+    case 8:
+      return CopyFixedRow<8>;
+    case 16:
+      return CopyFixedRow<16>;
+    case 32:
+      return CopyFixedRow<32>;
+    case 64:
+      return CopyFixedRow<64>;
+    case 128:
+      return CopyFixedRow<128>;
+    default:
+      return CopyRow;
+  }
+}
+
+inline void PrefetchRow(const float *row, size_t row_size) {
+#if defined(__GNUC__)
+  auto addr = reinterpret_cast<const char *>(row);
+  size_t row_bytes = std::min(row_size * sizeof(float), kMaxPrefetchLines * kCacheLineSize);
+  for (size_t offset = 0; offset < row_bytes; offset += kCacheLineSize) {
+    __builtin_prefetch(addr + offset, 0, 1);
+  }
+#endif
+}
+
 template <typename T>
 void LookUpTableTask(const float *input_addr, const T *indices_addr, float *output_addr, size_t indices_lens,
                      size_t outer_dim_size, T offset, size_t first_dim_size) {
-  auto type_size = sizeof(float);
-  size_t lens = outer_dim_size * type_size;
+  auto row_copy = GetRowCopyFunc(outer_dim_size);
   for (size_t i = 0; i < indices_lens; ++i) {
-    T index = indices_addr[i] - offset;
-    if (index >= 0 && index < SizeToInt(first_dim_size)) {
-      size_t pos = index * outer_dim_size;
-      auto ret = memcpy_s(output_addr, (indices_lens - i) * lens, input_addr + pos, lens);
-      if (ret != EOK) {
-        MS_LOG(EXCEPTION) << "LookUpTable task memcpy failed.";
+    if (i + kPrefetchDistance < indices_lens) {
+      T ahead = indices_addr[i + kPrefetchDistance] - offset;
+      if (ahead >= 0 && ahead < SizeToLong(first_dim_size)) {
+        PrefetchRow(input_addr + ahead * outer_dim_size, outer_dim_size);
       }
+    }
+    T index = indices_addr[i] - offset;
+    if (index >= 0 && index < SizeToLong(first_dim_size)) {
+      row_copy(input_addr + index * outer_dim_size, output_addr, outer_dim_size);
     } else {
-      auto ret = memset_s(output_addr, (indices_lens - i) * lens, 0, lens);
-      if (ret != EOK) {
-        MS_LOG(EXCEPTION) << "LookUpTable task memset failed.";
-      }
+      std::fill(output_addr, output_addr + outer_dim_size, 0.0f);
     }
     output_addr += outer_dim_size;
   }
@@ -68,10 +117,97 @@ void EmbeddingLookUpCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   if (AnfAlgo::HasNodeAttr(kAttrOffset, kernel_node)) {
     offset_ = AnfAlgo::GetNodeAttr<int64_t>(kernel_node, kAttrOffset);
   }
+  dedup_ = indices_lens_ >= kDedupMinIndicesLens && outer_dim_size_ >= kDedupMinRowSize;
+}
+
+void EmbeddingLookUpCPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
+  CPUKernel::InitInputOutputSize(kernel_node);
+  if (dedup_) {
+    // The index and the unique workspaces, the unique indices, the inverse and the first occurrence of each row.
+    for (size_t i = 0; i < kDedupWorkspaceNum; ++i) {
+      workspace_size_list_.emplace_back(indices_lens_ * sizeof(int64_t));
+    }
+  }
+}
+
+template <typename T>
+bool EmbeddingLookUpCPUKernel::DedupLookUp(const std::vector<kernel::AddressPtr> &inputs,
+                                           const std::vector<kernel::AddressPtr> &workspace,
+                                           const std::vector<kernel::AddressPtr> &outputs) {
+  if (workspace.size() < kDedupWorkspaceNum || indices_lens_ > INT_MAX ||
+      std::any_of(workspace.begin(), workspace.end(),
+                  [this](const AddressPtr &addr) { return addr->size < indices_lens_ * sizeof(int64_t); })) {
+    return false;
+  }
+  auto params = std::make_shared<UniqueParam<T, int>>();
+  params->input_ = reinterpret_cast<T *>(inputs[1]->addr);
+  params->input_idx_ = reinterpret_cast<int *>(workspace[0]->addr);
+  params->workspace_ = reinterpret_cast<T *>(workspace[1]->addr);
+  params->workspace_idx_ = reinterpret_cast<int *>(workspace[2]->addr);
+  params->output_ = reinterpret_cast<T *>(workspace[3]->addr);
+  params->inverse_idx_ = reinterpret_cast<int *>(workspace[4]->addr);
+  params->input_size_ = SizeToInt(indices_lens_);
+  params->thread_num_ = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
+  if (indices_lens_ < kUseBucketUniqueSize) {
+    // The unique ids come in the order of their first occurrence, no sort is needed.
+    params->need_sort_ = false;
+    UniqueCPUKernel::Unique(params);
+  } else {
+    UniqueCPUKernel::BucketUnique(params);
+  }
+  size_t unique_num = IntToSize(params->output_size_);
+  const T *unique_ids = params->output_;
+  const int *inverse_idx = params->inverse_idx_;
+  auto first_pos = reinterpret_cast<int *>(workspace[5]->addr);
+  std::fill(first_pos, first_pos + unique_num, -1);
+  for (size_t i = 0; i < indices_lens_; ++i) {
+    if (first_pos[inverse_idx[i]] < 0) {
+      first_pos[inverse_idx[i]] = SizeToInt(i);
+    }
+  }
+
+  auto input_addr = reinterpret_cast<float *>(inputs[0]->addr);
+  auto output_addr = reinterpret_cast<float *>(outputs[0]->addr);
+  auto row_copy = GetRowCopyFunc(outer_dim_size_);
+  T offset = static_cast<T>(offset_);
+  auto first_dim_size = SizeToLong(first_dim_size_);
+  auto gather_task = [&](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      if (i + kPrefetchDistance < end) {
+        T ahead = unique_ids[i + kPrefetchDistance] - offset;
+        if (ahead >= 0 && ahead < first_dim_size) {
+          PrefetchRow(input_addr + ahead * outer_dim_size_, outer_dim_size_);
+        }
+      }
+      T index = unique_ids[i] - offset;
+      float *dst = output_addr + IntToSize(first_pos[i]) * outer_dim_size_;
+      if (index >= 0 && index < first_dim_size) {
+        row_copy(input_addr + index * outer_dim_size_, dst, outer_dim_size_);
+      } else {
+        std::fill(dst, dst + outer_dim_size_, 0.0f);
+      }
+    }
+  };
+  CPUKernelUtils::ParallelFor(gather_task, unique_num);
+  if (unique_num == indices_lens_) {
+    return true;
+  }
+  // The repeated rows are copied from their first occurrence in the output, which the gather left in the cache.
+  auto repeat_task = [&](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      auto first = IntToSize(first_pos[inverse_idx[i]]);
+      if (first != i) {
+        row_copy(output_addr + first * outer_dim_size_, output_addr + i * outer_dim_size_, outer_dim_size_);
+      }
+    }
+  };
+  CPUKernelUtils::ParallelFor(repeat_task, indices_lens_);
+  return true;
 }
 
 template <typename T>
 void EmbeddingLookUpCPUKernel::LaunchKernel(const std::vector<kernel::AddressPtr> &inputs,
+                                            const std::vector<kernel::AddressPtr> &workspace,
                                             const std::vector<kernel::AddressPtr> &outputs) {
   if (node_ != nullptr) {
     std::vector<size_t> input_shape = AnfAlgo::GetPrevNodeOutputInferShape(node_, 0);
@@ -90,6 +226,9 @@ void EmbeddingLookUpCPUKernel::LaunchKernel(const std::vector<kernel::AddressPtr
       indices_lens_ *= shape;
     }
   }
+  if (dedup_ && DedupLookUp<T>(inputs, workspace, outputs)) {
+    return;
+  }
   auto input_addr = reinterpret_cast<float *>(inputs[0]->addr);
   auto indices_addr = reinterpret_cast<T *>(inputs[1]->addr);
   auto output_addr = reinterpret_cast<float *>(outputs[0]->addr);
@@ -121,12 +260,12 @@ void EmbeddingLookUpCPUKernel::LaunchKernel(const std::vector<kernel::AddressPtr
 }
 
 bool EmbeddingLookUpCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
-                                      const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                      const std::vector<kernel::AddressPtr> &workspace,
                                       const std::vector<kernel::AddressPtr> &outputs) {
   if (indices_data_type_ == kNumberTypeInt32) {
-    LaunchKernel<int>(inputs, outputs);
+    LaunchKernel<int>(inputs, workspace, outputs);
   } else {
-    LaunchKernel<int64_t>(inputs, outputs);
+    LaunchKernel<int64_t>(inputs, workspace, outputs);
   }
   return true;
 }
@@ -28,14 +28,22 @@ class EmbeddingLookUpCPUKernel : public CPUKernel {
   ~EmbeddingLookUpCPUKernel() override {}
 
   void InitKernel(const CNodePtr &kernel_node) override;
+  void InitInputOutputSize(const CNodePtr &kernel_node) override;
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
   template <typename T>
-  void LaunchKernel(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &outputs);
+  void LaunchKernel(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &workspace,
+                    const std::vector<kernel::AddressPtr> &outputs);
 
  protected:
   void CheckParam(const CNodePtr &kernel_node);
+  // Reads every distinct row of the table once, the repeated indices copy the row already gathered in the output.
+  // Returns false when the workspace can not hold the indices, the lookup is then done row by row.
+  template <typename T>
+  bool DedupLookUp(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &workspace,
+                   const std::vector<kernel::AddressPtr> &outputs);
+  bool dedup_{false};
   int64_t offset_{0};
   size_t indices_lens_{1};
   size_t first_dim_size_{1};
@@ -0,0 +1,140 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/fake_quant_cpu_kernel.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include "runtime/device/cpu/cpu_device_address.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace kernel {
+FakeQuantCPUKernel::NudgedRange FakeQuantCPUKernel::NudgeRange(float min, float max, float quant_min, float quant_max,
+                                                               bool symmetric) {
+  if (symmetric) {
+    float abs_max = std::max(std::abs(min), max);
+    min = -abs_max;
+    max = abs_max;
+  }
+  NudgedRange range{0, 0, 0};
+  float zero_point_from_min = 0;
+  if (quant_max != quant_min && max != min) {
+    range.scale = (max - min) / (quant_max - quant_min);
+    zero_point_from_min = quant_min - min / range.scale;
+  }
+  float zero_point = 0;
+  if (zero_point_from_min <= quant_min) {
+    zero_point = quant_min;
+  } else if (zero_point_from_min >= quant_max) {
+    zero_point = quant_max;
+  } else {
+    zero_point = std::round(zero_point_from_min);
+  }
+  range.min = (quant_min - zero_point) * range.scale;
+  range.max = (quant_max - zero_point) * range.scale;
+  return range;
+}
+
+void FakeQuantCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+  if (input_num != 3) {
+    MS_LOG(EXCEPTION) << "Input number is " << input_num << ", but FakeQuantCPUKernel needs 3 inputs.";
+  }
+  auto kernel_name = AnfAlgo::GetCNodeName(kernel_node);
+  auto input_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  auto min_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 1);
+  data_size_ = 1;
+  for (auto dim : input_shape) {
+    data_size_ *= dim;
+  }
+  channel_num_ = 1;
+  for (auto dim : min_shape) {
+    channel_num_ *= dim;
+  }
+
+  auto num_bits = AnfAlgo::GetNodeAttr<int64_t>(kernel_node, kAttrNumBits);
+  if (num_bits < 2 || num_bits > 16) {
+    MS_LOG(EXCEPTION) << "Attr num_bits " << num_bits << " of " << kernel_name << " is out of [2, 16].";
+  }
+  quant_min_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrNarrowRange) ? 1 : 0;
+  quant_max_ = static_cast<float>((1 << num_bits) - 1);
+  // FakeQuantWithMinMaxVars has neither symmetric nor training.
+  symmetric_ =
+    AnfAlgo::HasNodeAttr(kAttrSymmetric, kernel_node) && AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrSymmetric);
+  training_ =
+    AnfAlgo::HasNodeAttr(kAttrTraining, kernel_node) && AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrTraining);
+  if (AnfAlgo::HasNodeAttr(kAttrQuantDelay, kernel_node)) {
+    quant_delay_ = AnfAlgo::GetNodeAttr<int64_t>(kernel_node, kAttrQuantDelay);
+  }
+
+  // A per layer range of one value per element is FakeQuantWithMinMaxVars broadcasting its range.
+  if (channel_num_ == 1 || channel_num_ == data_size_) {
+    inner_size_ = data_size_ / channel_num_;
+    return;
+  }
+  size_t channel_axis = input_shape.size() - 1;
+  if (kernel_name == kFakeQuantPerChannelOpName && input_shape.size() > 1) {
+    channel_axis = LongToSize(AnfAlgo::GetNodeAttr<int64_t>(kernel_node, kAttrChannelAxis));
+  }
+  if (channel_axis >= input_shape.size() || input_shape[channel_axis] != channel_num_) {
+    MS_LOG(EXCEPTION) << "The range of " << kernel_name << " has " << channel_num_
+                      << " channels, which does not match the input of shape " << input_shape;
+  }
+  inner_size_ = 1;
+  for (size_t i = channel_axis + 1; i < input_shape.size(); ++i) {
+    inner_size_ *= input_shape[i];
+  }
+}
+
+bool FakeQuantCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() != 3 || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "FakeQuant error input output size!";
+  }
+  auto input = reinterpret_cast<float *>(inputs[0]->addr);
+  auto input_min = reinterpret_cast<float *>(inputs[1]->addr);
+  auto input_max = reinterpret_cast<float *>(inputs[2]->addr);
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  // The training quantizes after quant_delay steps, as on the other backends.
+  if (training_ && global_step_++ < quant_delay_) {
+    if (memcpy_s(output, outputs[0]->size, input, inputs[0]->size) != EOK) {
+      MS_LOG(EXCEPTION) << "FakeQuant memcpy failed.";
+    }
+    return true;
+  }
+
+  std::vector<NudgedRange> ranges(channel_num_);
+  for (size_t i = 0; i < channel_num_; ++i) {
+    ranges[i] = NudgeRange(input_min[i], input_max[i], quant_min_, quant_max_, symmetric_);
+  }
+  auto task = [this, &ranges, input, output](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      const auto &range = ranges[(i / inner_size_) % channel_num_];
+      if (range.scale == 0) {
+        output[i] = range.min;
+        continue;
+      }
+      float value = std::min(std::max(input[i], range.min), range.max);
+      output[i] = std::round((value - range.min) / range.scale) * range.scale + range.min;
+    }
+  };
+  CPUKernelUtils::ParallelFor(task, data_size_);
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
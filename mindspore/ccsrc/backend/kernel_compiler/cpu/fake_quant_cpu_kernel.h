@@ -0,0 +1,92 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FAKE_QUANT_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FAKE_QUANT_CPU_KERNEL_H_
+#include <memory>
+#include <vector>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+
+namespace mindspore {
+namespace kernel {
+// The forward of FakeQuantPerLayer, FakeQuantPerChannel, FakeQuantWithMinMaxVars and
+// FakeQuantWithMinMaxVarsPerChannel, the input is quantized by the nudged range of its layer or channel and
+// dequantized again.
+class FakeQuantCPUKernel : public CPUKernel {
+ public:
+  FakeQuantCPUKernel() = default;
+  ~FakeQuantCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+  struct NudgedRange {
+    float min;
+    float max;
+    float scale;
+  };
+  // Moves [min, max] so that the zero is exactly one of the quant_max - quant_min + 1 levels, as the FakeQuant kernels
+  // of the other backends do.
+  static NudgedRange NudgeRange(float min, float max, float quant_min, float quant_max, bool symmetric);
+
+ private:
+  float quant_min_{0};
+  float quant_max_{0};
+  bool symmetric_{false};
+  bool training_{false};
+  int64_t quant_delay_{0};
+  int64_t global_step_{0};
+  size_t data_size_{0};
+  size_t channel_num_{1};
+  size_t inner_size_{1};
+};
+
+MS_REG_CPU_KERNEL(FakeQuantPerLayer,
+                  KernelAttr()
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddOutputAttr(kNumberTypeFloat32),
+                  FakeQuantCPUKernel);
+
+MS_REG_CPU_KERNEL(FakeQuantPerChannel,
+                  KernelAttr()
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddOutputAttr(kNumberTypeFloat32),
+                  FakeQuantCPUKernel);
+
+MS_REG_CPU_KERNEL(FakeQuantWithMinMaxVars,
+                  KernelAttr()
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddOutputAttr(kNumberTypeFloat32),
+                  FakeQuantCPUKernel);
+
+MS_REG_CPU_KERNEL(FakeQuantWithMinMaxVarsPerChannel,
+                  KernelAttr()
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddOutputAttr(kNumberTypeFloat32),
+                  FakeQuantCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FAKE_QUANT_CPU_KERNEL_H_
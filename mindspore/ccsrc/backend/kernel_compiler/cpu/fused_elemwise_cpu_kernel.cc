@@ -0,0 +1,349 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/fused_elemwise_cpu_kernel.h"
+#include <algorithm>
+#include <cmath>
+#include "runtime/device/cpu/cpu_device_address.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// The elements processed per operator in one go, small enough for all the registers of a block to stay in L1.
+const size_t kFusedBlockSize = 256;
+
+template <typename Op>
+void UnaryLoop(const float *a, float *out, size_t count, Op op) {
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = op(a[i]);
+  }
+}
+
+template <typename Op>
+void BinaryLoop(const float *a, const float *b, float *out, size_t count, Op op) {
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = op(a[i], b[i]);
+  }
+}
+}  // namespace
+
+const std::map<std::string, FusedElemwiseCPUKernel::FusedOp> &FusedElemwiseCPUKernel::FusedOpMap() {
+  static const std::map<std::string, FusedOp> fused_op_map = {
+    {kTensorAddOpName, FusedOp::kAdd},   {kSubOpName, FusedOp::kSub},
+    {kMulOpName, FusedOp::kMul},         {kRealDivOpName, FusedOp::kRealDiv},
+    {kMaximumOpName, FusedOp::kMaximum}, {kMinimumOpName, FusedOp::kMinimum},
+    {kNegOpName, FusedOp::kNeg},         {"ReLU", FusedOp::kRelu},
+    {"Sigmoid", FusedOp::kSigmoid},      {"Tanh", FusedOp::kTanh},
+    {kExpOpName, FusedOp::kExp},         {kLogOpName, FusedOp::kLog},
+    {kSqrtOpName, FusedOp::kSqrt},       {kSquareOpName, FusedOp::kSquare},
+    {kReciprocalOpName, FusedOp::kReciprocal}, {kAbsOpName, FusedOp::kAbs},
+    {kReduceSumOpName, FusedOp::kReduceSum},   {kReduceMeanOpName, FusedOp::kReduceMean}};
+  return fused_op_map;
+}
+
+bool FusedElemwiseCPUKernel::IsElemwiseOp(const std::string &op_name) {
+  auto iter = FusedOpMap().find(op_name);
+  return iter != FusedOpMap().end() && iter->second < FusedOp::kReduceSum;
+}
+
+bool FusedElemwiseCPUKernel::IsReduceOp(const std::string &op_name) {
+  auto iter = FusedOpMap().find(op_name);
+  return iter != FusedOpMap().end() && iter->second >= FusedOp::kReduceSum;
+}
+
+void FusedElemwiseCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  input_num_ = AnfAlgo::GetInputTensorNum(kernel_node);
+  std::vector<std::vector<size_t>> input_shapes;
+  for (size_t i = 0; i < input_num_; ++i) {
+    input_shapes.push_back(AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, i));
+  }
+  InitProgram(AnfAlgo::GetNodeAttr<std::vector<std::string>>(kernel_node, kAttrFusedOps),
+              AnfAlgo::GetNodeAttr<std::vector<int64_t>>(kernel_node, kAttrFusedOpInputs));
+  for (auto reg : AnfAlgo::GetNodeAttr<std::vector<int64_t>>(kernel_node, kAttrFusedOutputs)) {
+    if (reg < 0 || LongToSize(reg) >= input_num_ + instrs_.size()) {
+      MS_LOG(EXCEPTION) << "Fused output register " << reg << " is out of range.";
+    }
+    output_regs_.push_back(LongToSize(reg));
+  }
+  if (output_regs_.size() != AnfAlgo::GetOutputTensorNum(kernel_node)) {
+    MS_LOG(EXCEPTION) << "Fused output number " << output_regs_.size() << " is not equal to the kernel output number "
+                      << AnfAlgo::GetOutputTensorNum(kernel_node);
+  }
+  InitInputStrides(input_shapes);
+  if (has_reduce_) {
+    auto axis_num = LongToSize(AnfAlgo::GetNodeAttr<int64_t>(kernel_node, kAttrReduceAxisNum));
+    if (axis_num > shape_.size()) {
+      MS_LOG(EXCEPTION) << "Reduce axis number " << axis_num << " is larger than the rank " << shape_.size();
+    }
+    for (size_t i = shape_.size() - axis_num; i < shape_.size(); ++i) {
+      reduce_inner_ *= shape_[i];
+    }
+    reduce_outer_ = reduce_inner_ == 0 ? 0 : element_num_ / reduce_inner_;
+  }
+}
+
+void FusedElemwiseCPUKernel::InitProgram(const std::vector<std::string> &op_names,
+                                         const std::vector<int64_t> &op_inputs) {
+  if (op_names.empty() || op_inputs.size() != op_names.size() * 2) {
+    MS_LOG(EXCEPTION) << "Fused op number " << op_names.size() << " does not match the operand number "
+                      << op_inputs.size();
+  }
+  for (size_t i = 0; i < op_names.size(); ++i) {
+    auto iter = FusedOpMap().find(op_names[i]);
+    if (iter == FusedOpMap().end()) {
+      MS_LOG(EXCEPTION) << "Fused op " << op_names[i] << " is not supported.";
+    }
+    bool is_reduce = iter->second >= FusedOp::kReduceSum;
+    if (is_reduce && i + 1 != op_names.size()) {
+      MS_LOG(EXCEPTION) << "Fused reduce op " << op_names[i] << " must be the last op.";
+    }
+    bool is_binary = iter->second < FusedOp::kNeg;
+    size_t reg = input_num_ + i;
+    auto a = op_inputs[2 * i];
+    auto b = op_inputs[2 * i + 1];
+    if (a < 0 || LongToSize(a) >= reg || (is_binary && (b < 0 || LongToSize(b) >= reg)) || (!is_binary && b >= 0)) {
+      MS_LOG(EXCEPTION) << "Fused op " << op_names[i] << " has invalid operands " << a << ", " << b;
+    }
+    instrs_.push_back({iter->second, LongToSize(a), is_binary ? LongToSize(b) : 0});
+    has_reduce_ = is_reduce;
+  }
+}
+
+void FusedElemwiseCPUKernel::InitInputStrides(const std::vector<std::vector<size_t>> &input_shapes) {
+  size_t rank = 1;
+  for (auto &input_shape : input_shapes) {
+    rank = std::max(rank, input_shape.size());
+  }
+  if (rank > kMaxRank) {
+    MS_LOG(EXCEPTION) << "Fused elemwise kernel supports rank up to " << kMaxRank << ", but got " << rank;
+  }
+  shape_.assign(rank, 1);
+  for (auto &input_shape : input_shapes) {
+    size_t offset = rank - input_shape.size();
+    for (size_t i = 0; i < input_shape.size(); ++i) {
+      if (input_shape[i] == shape_[offset + i] || input_shape[i] == 1) {
+        continue;
+      }
+      if (shape_[offset + i] != 1) {
+        MS_LOG(EXCEPTION) << "Fused input shapes can not broadcast at dim " << offset + i;
+      }
+      shape_[offset + i] = input_shape[i];
+    }
+  }
+  element_num_ = 1;
+  for (auto dim : shape_) {
+    element_num_ *= dim;
+  }
+  for (auto &input_shape : input_shapes) {
+    size_t offset = rank - input_shape.size();
+    std::vector<size_t> strides(rank, 0);
+    size_t stride = 1;
+    for (size_t i = input_shape.size(); i > 0; --i) {
+      if (input_shape[i - 1] != 1) {
+        strides[offset + i - 1] = stride;
+      }
+      stride *= input_shape[i - 1];
+    }
+    input_strides_.push_back(strides);
+    input_sizes_.push_back(stride);
+  }
+}
+
+void FusedElemwiseCPUKernel::LoadInput(size_t index, const float *input, size_t pos, size_t count,
+                                       float *dst) const {
+  if (input_sizes_[index] == 1) {
+    std::fill(dst, dst + count, input[0]);
+    return;
+  }
+  // Walk the output coordinates from pos, carrying into the outer dims like an odometer.
+  auto &strides = input_strides_[index];
+  size_t rank = shape_.size();
+  size_t coord[kMaxRank];
+  size_t offset = 0;
+  size_t rest = pos;
+  for (size_t i = rank; i > 0; --i) {
+    coord[i - 1] = rest % shape_[i - 1];
+    rest /= shape_[i - 1];
+    offset += coord[i - 1] * strides[i - 1];
+  }
+  for (size_t j = 0; j < count; ++j) {
+    dst[j] = input[offset];
+    for (size_t i = rank; i > 0; --i) {
+      offset += strides[i - 1];
+      if (++coord[i - 1] < shape_[i - 1]) {
+        break;
+      }
+      offset -= coord[i - 1] * strides[i - 1];
+      coord[i - 1] = 0;
+    }
+  }
+}
+
+void FusedElemwiseCPUKernel::RunBlock(const std::vector<AddressPtr> &inputs, size_t pos, size_t count, float *buffer,
+                                      std::vector<const float *> *regs) const {
+  for (size_t i = 0; i < input_num_; ++i) {
+    auto input = reinterpret_cast<const float *>(inputs[i]->addr);
+    if (input_sizes_[i] == element_num_) {
+      (*regs)[i] = input + pos;
+      continue;
+    }
+    float *dst = buffer + i * kFusedBlockSize;
+    LoadInput(i, input, pos, count, dst);
+    (*regs)[i] = dst;
+  }
+  for (size_t i = 0; i < instrs_.size(); ++i) {
+    auto &instr = instrs_[i];
+    const float *a = (*regs)[instr.a];
+    const float *b = (*regs)[instr.b];
+    float *out = buffer + (input_num_ + i) * kFusedBlockSize;
+    switch (instr.op) {
+      case FusedOp::kAdd:
+        BinaryLoop(a, b, out, count, [](float x, float y) { return x + y; });
+        break;
+      case FusedOp::kSub:
+        BinaryLoop(a, b, out, count, [](float x, float y) { return x - y; });
+        break;
+      case FusedOp::kMul:
+        BinaryLoop(a, b, out, count, [](float x, float y) { return x * y; });
+        break;
+      case FusedOp::kRealDiv:
+        BinaryLoop(a, b, out, count, [](float x, float y) { return x / y; });
+        break;
+      case FusedOp::kMaximum:
+        BinaryLoop(a, b, out, count, [](float x, float y) { return x > y ? x : y; });
+        break;
+      case FusedOp::kMinimum:
+        BinaryLoop(a, b, out, count, [](float x, float y) { return x < y ? x : y; });
+        break;
+      case FusedOp::kNeg:
+        UnaryLoop(a, out, count, [](float x) { return -x; });
+        break;
+      case FusedOp::kRelu:
+        UnaryLoop(a, out, count, [](float x) { return x > 0 ? x : 0; });
+        break;
+      case FusedOp::kSigmoid:
+        UnaryLoop(a, out, count, [](float x) { return 1 / (1 + std::exp(-x)); });
+        break;
+      case FusedOp::kTanh:
+        UnaryLoop(a, out, count, [](float x) { return std::tanh(x); });
+        break;
+      case FusedOp::kExp:
+        UnaryLoop(a, out, count, [](float x) { return std::exp(x); });
+        break;
+      case FusedOp::kLog:
+        UnaryLoop(a, out, count, [](float x) { return std::log(x); });
+        break;
+      case FusedOp::kSqrt:
+        UnaryLoop(a, out, count, [](float x) { return std::sqrt(x); });
+        break;
+      case FusedOp::kSquare:
+        UnaryLoop(a, out, count, [](float x) { return x * x; });
+        break;
+      case FusedOp::kReciprocal:
+        UnaryLoop(a, out, count, [](float x) { return 1 / x; });
+        break;
+      case FusedOp::kAbs:
+        UnaryLoop(a, out, count, [](float x) { return std::abs(x); });
+        break;
+      default:
+        // The reduce at the end of the program is accumulated by the caller.
+        continue;
+    }
+    (*regs)[input_num_ + i] = out;
+  }
+}
+
+void FusedElemwiseCPUKernel::StoreOutputs(const std::vector<AddressPtr> &outputs,
+                                          const std::vector<const float *> &regs, size_t pos, size_t count) const {
+  size_t reduce_reg = input_num_ + instrs_.size() - 1;
+  for (size_t i = 0; i < output_regs_.size(); ++i) {
+    if (has_reduce_ && output_regs_[i] == reduce_reg) {
+      continue;
+    }
+    auto output = reinterpret_cast<float *>(outputs[i]->addr);
+    auto src = regs[output_regs_[i]];
+    std::copy(src, src + count, output + pos);
+  }
+}
+
+bool FusedElemwiseCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                    const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                    const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() != input_num_ || outputs.size() != output_regs_.size()) {
+    MS_LOG(EXCEPTION) << "Fused elemwise kernel needs " << input_num_ << " inputs and " << output_regs_.size()
+                      << " outputs, but got " << inputs.size() << " and " << outputs.size();
+  }
+  for (size_t i = 0; i < input_num_; ++i) {
+    if (inputs[i]->size != input_sizes_[i] * sizeof(float)) {
+      MS_LOG(EXCEPTION) << "Fused input " << i << " size " << inputs[i]->size << " is invalid.";
+    }
+  }
+  size_t reg_num = input_num_ + instrs_.size();
+  size_t reduce_reg = reg_num - 1;
+  for (size_t i = 0; i < output_regs_.size(); ++i) {
+    size_t expect_num = has_reduce_ && output_regs_[i] == reduce_reg ? reduce_outer_ : element_num_;
+    if (outputs[i]->size != expect_num * sizeof(float)) {
+      MS_LOG(EXCEPTION) << "Fused output " << i << " size " << outputs[i]->size << " is invalid.";
+    }
+  }
+
+  if (!has_reduce_) {
+    auto task = [&](size_t start, size_t end) {
+      std::vector<float> buffer(reg_num * kFusedBlockSize);
+      std::vector<const float *> regs(reg_num, nullptr);
+      for (size_t pos = start; pos < end; pos += kFusedBlockSize) {
+        size_t count = std::min(kFusedBlockSize, end - pos);
+        RunBlock(inputs, pos, count, buffer.data(), &regs);
+        StoreOutputs(outputs, regs, pos, count);
+      }
+    };
+    CPUKernelUtils::ParallelFor(task, element_num_);
+    return true;
+  }
+
+  // Each row of the trailing reduced axes is computed block by block and summed up on the fly.
+  float *reduce_output = nullptr;
+  for (size_t i = 0; i < output_regs_.size(); ++i) {
+    if (output_regs_[i] == reduce_reg) {
+      reduce_output = reinterpret_cast<float *>(outputs[i]->addr);
+    }
+  }
+  MS_EXCEPTION_IF_NULL(reduce_output);
+  auto &reduce_instr = instrs_.back();
+  auto task = [&](size_t start, size_t end) {
+    std::vector<float> buffer(reg_num * kFusedBlockSize);
+    std::vector<const float *> regs(reg_num, nullptr);
+    for (size_t row = start; row < end; ++row) {
+      float sum = 0;
+      for (size_t offset = 0; offset < reduce_inner_; offset += kFusedBlockSize) {
+        size_t pos = row * reduce_inner_ + offset;
+        size_t count = std::min(kFusedBlockSize, reduce_inner_ - offset);
+        RunBlock(inputs, pos, count, buffer.data(), &regs);
+        StoreOutputs(outputs, regs, pos, count);
+        const float *src = regs[reduce_instr.a];
+        for (size_t j = 0; j < count; ++j) {
+          sum += src[j];
+        }
+      }
+      reduce_output[row] = reduce_instr.op == FusedOp::kReduceMean ? sum / reduce_inner_ : sum;
+    }
+  };
+  CPUKernelUtils::ParallelFor(task, reduce_outer_);
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
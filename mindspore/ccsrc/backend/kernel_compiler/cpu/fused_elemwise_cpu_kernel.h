@@ -0,0 +1,102 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FUSED_ELEMWISE_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FUSED_ELEMWISE_CPU_KERNEL_H_
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+
+namespace mindspore {
+namespace kernel {
+// Runs a chain of elementwise operators, optionally ended by a sum or mean over the trailing axes, in one pass over
+// the memory. The chain is a small program over registers: the inputs take the first registers, the i-th operator
+// reads the registers kAttrFusedOpInputs[2 * i] and kAttrFusedOpInputs[2 * i + 1] (-1 for unary operators) and
+// writes the register input_num + i. The program is interpreted block by block, each operator being a tight loop
+// over the block.
+class FusedElemwiseCPUKernel : public CPUKernel {
+ public:
+  FusedElemwiseCPUKernel() = default;
+  ~FusedElemwiseCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+  static bool IsElemwiseOp(const std::string &op_name);
+  static bool IsReduceOp(const std::string &op_name);
+  static const size_t kMaxRank = 8;
+
+ private:
+  // The binary operators come first, then the unary ones and the reduce ones last.
+  enum class FusedOp {
+    kAdd,
+    kSub,
+    kMul,
+    kRealDiv,
+    kMaximum,
+    kMinimum,
+    kNeg,
+    kRelu,
+    kSigmoid,
+    kTanh,
+    kExp,
+    kLog,
+    kSqrt,
+    kSquare,
+    kReciprocal,
+    kAbs,
+    kReduceSum,
+    kReduceMean
+  };
+  struct FusedInstr {
+    FusedOp op;
+    size_t a;
+    size_t b;
+  };
+
+  static const std::map<std::string, FusedOp> &FusedOpMap();
+  void InitProgram(const std::vector<std::string> &op_names, const std::vector<int64_t> &op_inputs);
+  void InitInputStrides(const std::vector<std::vector<size_t>> &input_shapes);
+  void LoadInput(size_t index, const float *input, size_t pos, size_t count, float *dst) const;
+  void RunBlock(const std::vector<AddressPtr> &inputs, size_t pos, size_t count, float *buffer,
+                std::vector<const float *> *regs) const;
+  void StoreOutputs(const std::vector<AddressPtr> &outputs, const std::vector<const float *> &regs, size_t pos,
+                    size_t count) const;
+
+  size_t input_num_{0};
+  std::vector<FusedInstr> instrs_;
+  std::vector<size_t> output_regs_;
+  std::vector<size_t> shape_;
+  size_t element_num_{1};
+  // The element strides of each input along the dims of shape_, 0 on broadcast dims.
+  std::vector<std::vector<size_t>> input_strides_;
+  std::vector<size_t> input_sizes_;
+  bool has_reduce_{false};
+  size_t reduce_inner_{1};
+  size_t reduce_outer_{1};
+};
+
+MS_REG_CPU_KERNEL(
+  FusedElemwise, KernelAttr().SetAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+  FusedElemwiseCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FUSED_ELEMWISE_CPU_KERNEL_H_
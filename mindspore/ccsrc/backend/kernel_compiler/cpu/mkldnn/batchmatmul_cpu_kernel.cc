@@ -31,6 +31,13 @@ bool BatchMatMulCPUKernel::Launch(const std::vector<AddressPtr> &inputs, const s
     MS_LOG(EXCEPTION) << "batchmatmul error batch size!";
   }
 
+  if (use_bf16_) {
+    SetArgumentHandle(DNNL_ARG_SRC, inputs[0]->addr);
+    SetArgumentHandle(DNNL_ARG_WEIGHTS, inputs[1]->addr);
+    SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
+    ExecutePrimitive();
+    return true;
+  }
   LaunchKernel<float>(inputs, outputs);
 
   return true;
@@ -87,6 +94,10 @@ void BatchMatMulCPUKernel::InitKernel(const CNodePtr &kernel_node) {
 
   trans_a_ = trans_a ? TRANSPOSE_YES : TRANSPOSE_NO;
   trans_b_ = trans_b ? TRANSPOSE_YES : TRANSPOSE_NO;
+  use_bf16_ = UseBf16(kernel_node);
+  if (use_bf16_) {
+    InitBf16MatMul(kernel_node, SizeToLong(batch_), dim_m_, dim_n_, dim_k_, trans_a, trans_b);
+  }
 }
 }  // namespace kernel
 }  // namespace mindspore
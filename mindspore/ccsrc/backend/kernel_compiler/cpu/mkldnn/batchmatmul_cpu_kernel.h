@@ -46,6 +46,7 @@ class BatchMatMulCPUKernel : public MKLCPUKernel {
   size_t size_mat_a_{0};
   size_t size_mat_b_{0};
   size_t size_mat_output_{0};
+  bool use_bf16_{false};
 };
 
 MS_REG_CPU_KERNEL(
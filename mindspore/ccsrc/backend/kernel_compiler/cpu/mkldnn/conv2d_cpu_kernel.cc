@@ -75,14 +75,26 @@ void Conv2dCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   }
   dnnl::memory::dims padding_l{int_padding_l[0], int_padding_l[1]};
   dnnl::memory::dims padding_r{int_padding_r[0], int_padding_r[1]};
-  dnnl::convolution_forward::desc desc =
-    dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
-                                    weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
+  // In bfloat16 the float32 input and weight are converted before each launch, the output stays float32.
+  bool use_bf16 = UseBf16(kernel_node);
+  auto compute_type = use_bf16 ? dnnl::memory::data_type::bf16 : dnnl::memory::data_type::f32;
+  dnnl::memory::desc src_compute_desc = GetDefaultMemDesc(src_shape, compute_type);
+  dnnl::memory::desc weights_compute_desc = GetDefaultMemDesc(weight_shape, compute_type);
+  dnnl::convolution_forward::desc desc = dnnl::convolution_forward::desc(
+    dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_compute_desc, weights_compute_desc,
+    dst_desc, strides, dilates, padding_l, padding_r);
 
-  auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::convolution_forward>(prim_desc);
-  AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
+  CreatePrimitive(kernel_node, [&desc]() {
+    auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
+    return std::make_shared<dnnl::convolution_forward>(prim_desc);
+  });
+  if (use_bf16) {
+    AddConvertedArgument(DNNL_ARG_SRC, src_desc, src_compute_desc);
+    AddConvertedArgument(DNNL_ARG_WEIGHTS, weights_desc, weights_compute_desc);
+  } else {
+    AddArgument(DNNL_ARG_SRC, src_desc);
+    AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
+  }
   AddArgument(DNNL_ARG_DST, dst_desc);
 }
 
@@ -73,22 +73,35 @@ void Conv2dGradInputCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   }
   dnnl::memory::dims padding_l{int_padding_l[0], int_padding_l[1]};
   dnnl::memory::dims padding_r{int_padding_r[0], int_padding_r[1]};
-  dnnl::convolution_forward::desc forward_desc =
-    dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
-                                    weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
+  // In bfloat16 the float32 dout and weight are converted before each launch, the dx stays float32.
+  bool use_bf16 = UseBf16(kernel_node);
+  auto compute_type = use_bf16 ? dnnl::memory::data_type::bf16 : dnnl::memory::data_type::f32;
+  dnnl::memory::desc src_compute_desc = GetDefaultMemDesc(src_shape, compute_type);
+  dnnl::memory::desc weights_compute_desc = GetDefaultMemDesc(weight_shape, compute_type);
+  dnnl::memory::desc dst_compute_desc = GetDefaultMemDesc(dst_shape, compute_type);
+  dnnl::convolution_forward::desc forward_desc = dnnl::convolution_forward::desc(
+    dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_compute_desc, weights_compute_desc,
+    dst_compute_desc, strides, dilates, padding_l, padding_r);
 
-  auto forward_prim_desc = dnnl::convolution_forward::primitive_desc(forward_desc, MKLKernelEngine::Get().engine());
+  dnnl::convolution_backward_data::desc backward_desc =
+    dnnl::convolution_backward_data::desc(dnnl::algorithm::convolution_auto, src_desc, weights_compute_desc,
+                                          dst_compute_desc, strides, dilates, padding_l, padding_r);
 
-  dnnl::convolution_backward_data::desc backward_desc = dnnl::convolution_backward_data::desc(
-    dnnl::algorithm::convolution_auto, src_desc, weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
-
-  auto backward_prim_desc =
-    dnnl::convolution_backward_data::primitive_desc(backward_desc, MKLKernelEngine::Get().engine(), forward_prim_desc);
-  primitive_ = std::make_shared<dnnl::convolution_backward_data>(backward_prim_desc);
+  CreatePrimitive(kernel_node, [&forward_desc, &backward_desc]() {
+    auto &engine = MKLKernelEngine::Get().engine();
+    auto forward_prim_desc = dnnl::convolution_forward::primitive_desc(forward_desc, engine);
+    auto backward_prim_desc = dnnl::convolution_backward_data::primitive_desc(backward_desc, engine, forward_prim_desc);
+    return std::make_shared<dnnl::convolution_backward_data>(backward_prim_desc);
+  });
 
   AddArgument(DNNL_ARG_DIFF_SRC, src_desc);
-  AddArgument(DNNL_ARG_DIFF_DST, dst_desc);
-  AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
+  if (use_bf16) {
+    AddConvertedArgument(DNNL_ARG_DIFF_DST, dst_desc, dst_compute_desc);
+    AddConvertedArgument(DNNL_ARG_WEIGHTS, weights_desc, weights_compute_desc);
+  } else {
+    AddArgument(DNNL_ARG_DIFF_DST, dst_desc);
+    AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
+  }
 }
 
 bool Conv2dGradInputCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -57,7 +57,8 @@ void FusedBatchNormCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   dnnl::batch_normalization_forward::desc desc =
     dnnl::batch_normalization_forward::desc(prop_kind, x_desc, epsilon, normalization_flags);
   auto prim_desc = dnnl::batch_normalization_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::batch_normalization_forward>(prim_desc);
+  CreatePrimitive(kernel_node,
+                  [&prim_desc]() { return std::make_shared<dnnl::batch_normalization_forward>(prim_desc); });
   AddArgument(DNNL_ARG_SRC, x_desc);
   AddArgument(DNNL_ARG_MEAN, prim_desc.mean_desc());
   AddArgument(DNNL_ARG_VARIANCE, prim_desc.variance_desc());
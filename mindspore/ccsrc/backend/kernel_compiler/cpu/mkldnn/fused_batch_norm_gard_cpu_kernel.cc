@@ -60,7 +60,9 @@ void FusedBatchNormGradCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     dnnl::batch_normalization_backward::desc(dnnl::prop_kind::backward, x_desc, x_desc, epsilon, normalization_flags);
   auto backward_prim_desc = dnnl::batch_normalization_backward::primitive_desc(
     backward_desc, MKLKernelEngine::Get().engine(), forward_prim_desc);
-  primitive_ = std::make_shared<dnnl::batch_normalization_backward>(backward_prim_desc);
+  CreatePrimitive(kernel_node, [&backward_prim_desc]() {
+    return std::make_shared<dnnl::batch_normalization_backward>(backward_prim_desc);
+  });
   AddArgument(DNNL_ARG_SRC, x_desc);
   AddArgument(DNNL_ARG_MEAN, forward_prim_desc.mean_desc());
   AddArgument(DNNL_ARG_VARIANCE, forward_prim_desc.variance_desc());
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/mkldnn/int8_conv2d_cpu_kernel.h"
+#include <string>
+#include <algorithm>
+#include "utils/ms_utils.h"
+#include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
+
+namespace mindspore {
+namespace kernel {
+void Int8Conv2dCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  std::vector<size_t> src_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  std::vector<size_t> weight_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 1);
+  std::vector<size_t> dst_shape = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
+  if (src_shape.size() != 4 || weight_shape.size() != 4) {
+    MS_LOG(EXCEPTION) << "int8 conv2d only support nchw input!";
+  }
+  std::vector<size_t> kernel_size({weight_shape[2], weight_shape[3]});
+  size_t group = LongToSize(AnfAlgo::GetNodeAttr<int64_t>(kernel_node, GROUP));
+  if (group != 1) {
+    if (src_shape[1] % group != 0) {
+      MS_LOG(EXCEPTION) << "int8 conv2d channels should be divided by group!";
+    }
+    weight_shape.insert(weight_shape.begin(), group);
+    weight_shape[1] = weight_shape[1] / group;
+  }
+  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
+  dnnl::memory::desc weights_desc = GetDefaultMemDesc(weight_shape);
+  dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
+  std::vector<int> stride_ori;
+  std::vector<int> dilation_ori;
+  auto stride_me = AnfAlgo::GetNodeAttr<std::vector<int64_t>>(kernel_node, STRIDE);
+  auto dilation_me = AnfAlgo::GetNodeAttr<std::vector<int64_t>>(kernel_node, DILATION);
+  (void)std::transform(stride_me.begin(), stride_me.end(), std::back_inserter(stride_ori),
+                       [](const int64_t &value) { return static_cast<int>(value); });
+  (void)std::transform(dilation_me.begin(), dilation_me.end(), std::back_inserter(dilation_ori),
+                       [](const int64_t &value) { return static_cast<int>(value); });
+  if (stride_ori.size() != 4 || stride_ori[2] != stride_ori[3]) {
+    MS_LOG(EXCEPTION) << "int8 conv2d only support equal stride, and stride must be 4d!";
+  }
+  if (stride_ori[0] != 1 || stride_ori[1] != 1) {
+    MS_LOG(EXCEPTION) << "int8 conv2d stride only support 1 in N axis and C axis!";
+  }
+  if (dilation_ori.size() != 4) {
+    MS_LOG(EXCEPTION) << "int8 conv2d dilation must be 4d!";
+  }
+  if (dilation_ori[0] != 1 || dilation_ori[1] != 1) {
+    MS_LOG(EXCEPTION) << "int8 conv2d dilation only support 1 in N axis and C axis!";
+  }
+  int stride = stride_ori[2];
+  int dilation = dilation_ori[2];
+  strides_ = {stride, stride};
+  dilates_ = {dilation - 1, dilation - 1};
+  std::vector<int> int_padding_l;
+  std::vector<int> int_padding_r;
+  const std::string pad_mode = AnfAlgo::GetNodeAttr<std::string>(kernel_node, PAD_MODE);
+  GetPadding(kernel_node, pad_mode, src_shape, kernel_size, stride, &int_padding_l, &int_padding_r);
+  if (int_padding_l.size() != 2 || int_padding_r.size() != 2) {
+    MS_LOG(EXCEPTION) << "get padding failed";
+  }
+  padding_l_ = {int_padding_l[0], int_padding_l[1]};
+  padding_r_ = {int_padding_r[0], int_padding_r[1]};
+  weights_dims_ = weights_desc.dims();
+  dst_desc_ = dst_desc;
+  size_t channel_num = dst_shape[1];
+  dnnl::memory::desc bias_desc = GetDefaultMemDesc({channel_num});
+  // The output channels are the dimension 0 of the weights, or the dimensions 0 and 1 of the grouped weights.
+  int weights_channel_mask = group == 1 ? 1 : (1 << 0) | (1 << 1);
+  InitInt8(kernel_node, src_desc, weights_desc, bias_desc, dst_desc, channel_num, weights_channel_mask);
+}
+
+dnnl::primitive_desc Int8Conv2dCPUKernel::CreateInt8PrimitiveDesc(const dnnl::memory::desc &src_desc,
+                                                                  const dnnl::memory::desc &bias_desc,
+                                                                  const dnnl::primitive_attr &attr) {
+  dnnl::memory::desc weights_desc(weights_dims_, dnnl::memory::data_type::s8, dnnl::memory::format_tag::any);
+  dnnl::convolution_forward::desc desc(dnnl::prop_kind::forward_inference, dnnl::algorithm::convolution_direct,
+                                       src_desc, weights_desc, bias_desc, dst_desc_, strides_, dilates_, padding_l_,
+                                       padding_r_);
+  return dnnl::convolution_forward::primitive_desc(desc, attr, MKLKernelEngine::Get().engine());
+}
+}  // namespace kernel
+}  // namespace mindspore
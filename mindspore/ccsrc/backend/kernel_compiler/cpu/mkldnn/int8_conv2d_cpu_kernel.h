@@ -0,0 +1,71 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_INT8_CONV2D_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_INT8_CONV2D_CPU_KERNEL_H_
+
+#include <vector>
+#include <memory>
+#include "backend/kernel_compiler/cpu/mkldnn/mkl_int8_cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+// Conv2D with the FakeQuant of its input and weight folded in, computed in int8.
+class Int8Conv2dCPUKernel : public MKLInt8CPUKernel {
+ public:
+  Int8Conv2dCPUKernel() = default;
+  ~Int8Conv2dCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+ protected:
+  dnnl::primitive_desc CreateInt8PrimitiveDesc(const dnnl::memory::desc &src_desc, const dnnl::memory::desc &bias_desc,
+                                               const dnnl::primitive_attr &attr) override;
+
+ private:
+  dnnl::memory::dims weights_dims_;
+  dnnl::memory::desc dst_desc_;
+  dnnl::memory::dims strides_;
+  dnnl::memory::dims dilates_;
+  dnnl::memory::dims padding_l_;
+  dnnl::memory::dims padding_r_;
+};
+
+MS_REG_CPU_KERNEL(Int8Conv2D,
+                  KernelAttr()
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddOutputAttr(kNumberTypeFloat32),
+                  Int8Conv2dCPUKernel);
+
+MS_REG_CPU_KERNEL(Int8Conv2D,
+                  KernelAttr()
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddOutputAttr(kNumberTypeFloat32),
+                  Int8Conv2dCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_INT8_CONV2D_CPU_KERNEL_H_
@@ -0,0 +1,55 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/mkldnn/int8_matmul_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace kernel {
+void Int8MatMulCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  std::vector<size_t> src_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  std::vector<size_t> weight_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 1);
+  std::vector<size_t> dst_shape = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
+  if (src_shape.size() != 2 || weight_shape.size() != 2 || dst_shape.size() != 2) {
+    MS_LOG(EXCEPTION) << "int8 matmul invalid input size";
+  }
+  bool trans_a = AnfAlgo::GetNodeAttr<bool>(kernel_node, TRANSPOSE_A);
+  bool trans_b = AnfAlgo::GetNodeAttr<bool>(kernel_node, TRANSPOSE_B);
+  auto dim_m = SizeToLong(dst_shape[0]);
+  auto dim_n = SizeToLong(dst_shape[1]);
+  auto dim_k = SizeToLong(trans_a ? src_shape[0] : src_shape[1]);
+  // A transposed input is the row major [k, m] or [n, k] tensor.
+  using format_tag = dnnl::memory::format_tag;
+  dnnl::memory::desc src_desc({dim_m, dim_k}, dnnl::memory::data_type::f32, trans_a ? format_tag::ba : format_tag::ab);
+  weights_dims_ = {dim_k, dim_n};
+  dnnl::memory::desc weights_desc(weights_dims_, dnnl::memory::data_type::f32,
+                                  trans_b ? format_tag::ba : format_tag::ab);
+  dnnl::memory::desc bias_desc = GetDefaultMemDesc({1, dst_shape[1]});
+  dst_desc_ = GetDefaultMemDesc(dst_shape);
+  // The output channels are the columns of the weights.
+  InitInt8(kernel_node, src_desc, weights_desc, bias_desc, dst_desc_, dst_shape[1], 1 << 1);
+}
+
+dnnl::primitive_desc Int8MatMulCPUKernel::CreateInt8PrimitiveDesc(const dnnl::memory::desc &src_desc,
+                                                                  const dnnl::memory::desc &bias_desc,
+                                                                  const dnnl::primitive_attr &attr) {
+  dnnl::memory::desc weights_desc(weights_dims_, dnnl::memory::data_type::s8, dnnl::memory::format_tag::any);
+  dnnl::matmul::desc desc(src_desc, weights_desc, bias_desc, dst_desc_);
+  return dnnl::matmul::primitive_desc(desc, attr, MKLKernelEngine::Get().engine());
+}
+}  // namespace kernel
+}  // namespace mindspore
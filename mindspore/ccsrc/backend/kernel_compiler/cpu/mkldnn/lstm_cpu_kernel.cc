@@ -58,7 +58,7 @@ void LstmCPUKernel::InitKernel(const CNodePtr &kernel_node) {
                                                          formatted_md(weights_h_dims_, tag::any), bias_desc, dst_desc,
                                                          dst_h_desc, dst_c_desc);
   prim_desc_ = dnnl::lstm_forward::primitive_desc(*desc, eng);
-  primitive_ = std::make_shared<dnnl::lstm_forward>(prim_desc_);
+  CreatePrimitive(kernel_node, [this]() { return std::make_shared<dnnl::lstm_forward>(prim_desc_); });
   AddArgument(DNNL_ARG_SRC_LAYER, src_desc);
   AddArgument(DNNL_ARG_SRC_ITER, src_h_desc);
   AddArgument(DNNL_ARG_SRC_ITER_C, src_c_desc);
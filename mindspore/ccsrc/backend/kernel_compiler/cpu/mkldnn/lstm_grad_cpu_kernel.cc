@@ -60,7 +60,7 @@ void LSTMGradCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     src_c_desc, formatted_md(weights_dims_, tag::any), formatted_md(weights_h_dims_, tag::any), bias_desc, dst_desc,
     dst_h_desc, dst_c_desc);
   prim_backward_desc_ = dnnl::lstm_backward::primitive_desc(*backward_desc, eng, prim_forward_desc);
-  primitive_ = std::make_shared<dnnl::lstm_backward>(prim_backward_desc_);
+  CreatePrimitive(kernel_node, [this]() { return std::make_shared<dnnl::lstm_backward>(prim_backward_desc_); });
   AddArgument(DNNL_ARG_WORKSPACE, prim_forward_desc.workspace_desc());
   AddArgumentOp(src_desc, src_h_desc, src_c_desc, bias_desc, dst_desc, dst_h_desc, dst_c_desc);
 }
@@ -44,6 +44,10 @@ void MatMulCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     trans_b_ = TRANSPOSE_YES;
   }
   dim_n_ = static_cast<dnnl_dim_t>(dst_shape[1]);
+  use_bf16_ = UseBf16(kernel_node);
+  if (use_bf16_) {
+    InitBf16MatMul(kernel_node, 1, dim_m_, dim_n_, dim_k_, trans_a, trans_b);
+  }
 }
 
 bool MatMulCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -52,6 +56,13 @@ bool MatMulCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   if (inputs.size() < 2 || outputs.empty()) {
     MS_LOG(EXCEPTION) << "matmul error input output size!";
   }
+  if (use_bf16_) {
+    SetArgumentHandle(DNNL_ARG_SRC, inputs[0]->addr);
+    SetArgumentHandle(DNNL_ARG_WEIGHTS, inputs[1]->addr);
+    SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
+    ExecutePrimitive();
+    return true;
+  }
   dnnl_dim_t lda = dim_m_;
   if (trans_a_ == TRANSPOSE_NO) {
     lda = dim_k_;
@@ -38,6 +38,7 @@ class MatMulCPUKernel : public MKLCPUKernel {
   dnnl_dim_t dim_m_{0};
   dnnl_dim_t dim_n_{0};
   dnnl_dim_t dim_k_{0};
+  bool use_bf16_{false};
 };
 
 MS_REG_CPU_KERNEL(
@@ -17,7 +17,14 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <map>
+#include <sstream>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
 #include "utils/ms_utils.h"
+#include "utils/overload.h"
+#include "utils/utils.h"
 #include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
 
 namespace mindspore {
@@ -131,26 +138,134 @@ dnnl::memory::format_tag MKLCPUKernel::GetDefaultFormatTag(const dnnl::memory::d
   return mem_tag;
 }
 
-dnnl::memory::desc MKLCPUKernel::GetDefaultMemDesc(const std::vector<size_t> &shape) {
+dnnl::memory::desc MKLCPUKernel::GetDefaultMemDesc(const std::vector<size_t> &shape,
+                                                   dnnl::memory::data_type data_type) {
   dnnl::memory::dims dims;
   dims.insert(dims.end(), shape.begin(), shape.end());
   dnnl::memory::format_tag mem_tag = GetDefaultFormatTag(dims);
-  dnnl::memory::desc mem_desc(dims, dnnl::memory::data_type::f32, mem_tag);
+  dnnl::memory::desc mem_desc(dims, data_type, mem_tag);
   return mem_desc;
 }
 
+bool MKLCPUKernel::IsBf16Supported() {
+  static const bool bf16_supported = []() {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    // AMX-BF16 is EDX bit 22 of leaf 7, AVX512_BF16 is EAX bit 5 of leaf 7 sub-leaf 1.
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) == 0) {
+      return false;
+    }
+    bool amx_bf16 = (edx & (1U << 22)) != 0;
+    // EAX of leaf 7 sub-leaf 0 is the last sub-leaf.
+    if (eax < 1 || __get_cpuid_count(7, 1, &eax, &ebx, &ecx, &edx) == 0) {
+      return amx_bf16;
+    }
+    return amx_bf16 || (eax & (1U << 5)) != 0;
+#else
+    return false;
+#endif
+  }();
+  return bf16_supported;
+}
+
+bool MKLCPUKernel::UseBf16(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  if (!AnfAlgo::HasNodeAttr(kAttrComputeDtype, kernel_node) ||
+      AnfAlgo::GetNodeAttr<std::string>(kernel_node, kAttrComputeDtype) != kValueBFloat16) {
+    return false;
+  }
+  if (!IsBf16Supported()) {
+    MS_LOG(WARNING) << kernel_node->fullname_with_scope() << " computes in float32, the processor has no bfloat16.";
+    return false;
+  }
+  return true;
+}
+
+void MKLCPUKernel::InitBf16MatMul(const CNodePtr &kernel_node, dnnl::memory::dim batch, dnnl::memory::dim dim_m,
+                                  dnnl::memory::dim dim_n, dnnl::memory::dim dim_k, bool trans_a, bool trans_b) {
+  using format_tag = dnnl::memory::format_tag;
+  using data_type = dnnl::memory::data_type;
+  dnnl::memory::dims src_dims{batch, dim_m, dim_k};
+  dnnl::memory::dims weights_dims{batch, dim_k, dim_n};
+  dnnl::memory::dims dst_dims{batch, dim_m, dim_n};
+  // A transposed input is the row major [batch, k, m] or [batch, n, k] tensor, the reorder also transposes it.
+  dnnl::memory::desc src_desc(src_dims, data_type::f32, trans_a ? format_tag::acb : format_tag::abc);
+  dnnl::memory::desc weights_desc(weights_dims, data_type::f32, trans_b ? format_tag::acb : format_tag::abc);
+  dnnl::memory::desc src_compute_desc(src_dims, data_type::bf16, format_tag::abc);
+  dnnl::memory::desc weights_compute_desc(weights_dims, data_type::bf16, format_tag::abc);
+  dnnl::memory::desc dst_desc(dst_dims, data_type::f32, format_tag::abc);
+  dnnl::matmul::desc desc(src_compute_desc, weights_compute_desc, dst_desc);
+  CreatePrimitive(kernel_node, [&desc]() {
+    auto prim_desc = dnnl::matmul::primitive_desc(desc, MKLKernelEngine::Get().engine());
+    return std::make_shared<dnnl::matmul>(prim_desc);
+  });
+  AddConvertedArgument(DNNL_ARG_SRC, src_desc, src_compute_desc);
+  AddConvertedArgument(DNNL_ARG_WEIGHTS, weights_desc, weights_compute_desc);
+  AddArgument(DNNL_ARG_DST, dst_desc);
+}
+
+std::string MKLCPUKernel::GetPrimitiveKey(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  std::ostringstream key;
+  key << AnfAlgo::GetCNodeName(kernel_node);
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+  for (size_t i = 0; i < input_num; ++i) {
+    key << ";i" << AnfAlgo::GetInputDeviceDataType(kernel_node, i) << AnfAlgo::GetInputDeviceShape(kernel_node, i);
+  }
+  size_t output_num = AnfAlgo::GetOutputTensorNum(kernel_node);
+  for (size_t i = 0; i < output_num; ++i) {
+    key << ";o" << AnfAlgo::GetOutputDeviceDataType(kernel_node, i) << AnfAlgo::GetOutputDeviceShape(kernel_node, i);
+  }
+  auto prim = AnfAlgo::GetCNodePrimitive(kernel_node);
+  MS_EXCEPTION_IF_NULL(prim);
+  // The attributes are sorted by name so that the same attributes always give the same key.
+  std::map<std::string, ValuePtr> attrs(prim->attrs().begin(), prim->attrs().end());
+  for (auto &attr : attrs) {
+    key << ";" << attr.first << "=" << (attr.second == nullptr ? "" : attr.second->ToString());
+  }
+  return key.str();
+}
+
+void MKLCPUKernel::CreatePrimitive(const CNodePtr &kernel_node,
+                                   const PrimitiveCache<dnnl::primitive>::Creator &creator) {
+  primitive_ = MKLKernelEngine::Get().primitive_cache().Get(GetPrimitiveKey(kernel_node), creator);
+}
+
 void MKLCPUKernel::AddArgument(int arg_key, const dnnl::memory::desc &mem_desc, bool alloc) {
   arguments_[arg_key] = MKLKernelEngine::Get().CreateMemory(mem_desc, alloc);
 }
 
+void MKLCPUKernel::AddConvertedArgument(int arg_key, const dnnl::memory::desc &user_desc,
+                                        const dnnl::memory::desc &compute_desc) {
+  auto compute_memory = MKLKernelEngine::Get().CreateMemory(compute_desc, true);
+  auto user_memory = MKLKernelEngine::Get().CreateMemory(user_desc);
+  arguments_[arg_key] = compute_memory;
+  converted_arguments_.push_back({arg_key, user_memory, std::make_shared<dnnl::reorder>(user_memory, compute_memory)});
+}
+
 void MKLCPUKernel::SetArgumentHandle(int arg_key, void *ptr) {
+  for (auto &converted : converted_arguments_) {
+    if (converted.arg_key == arg_key) {
+      converted.user_memory.set_data_handle(ptr);
+      return;
+    }
+  }
   auto arg_iter = arguments_.find(arg_key);
   if (arg_iter != arguments_.end()) {
     arg_iter->second.set_data_handle(ptr);
   }
 }
 
-void MKLCPUKernel::ExecutePrimitive() { MKLKernelEngine::Get().Execute(primitive_, arguments_); }
+void MKLCPUKernel::ExecutePrimitive() {
+  for (auto &converted : converted_arguments_) {
+    MKLKernelEngine::Get().Execute(converted.reorder, {{DNNL_ARG_FROM, converted.user_memory},
+                                                      {DNNL_ARG_TO, arguments_[converted.arg_key]}});
+  }
+  MKLKernelEngine::Get().Execute(primitive_, arguments_);
+}
 
 void MKLCPUKernel::Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem) {
   MKLKernelEngine::Get().Reorder(src_mem, dst_mem);
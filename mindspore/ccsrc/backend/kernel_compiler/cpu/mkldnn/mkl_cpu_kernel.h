@@ -23,6 +23,7 @@
 #include "dnnl.hpp"
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "backend/kernel_compiler/cpu/mkldnn/primitive_cache.h"
 
 namespace mindspore {
 namespace kernel {
@@ -30,6 +31,8 @@ class MKLCPUKernel : public CPUKernel {
  public:
   MKLCPUKernel() = default;
   ~MKLCPUKernel() override = default;
+  // Whether the processor has native bfloat16 instructions, AVX512_BF16 or AMX-BF16.
+  static bool IsBf16Supported();
 
  protected:
   bool BinaryBroadCast(std::vector<size_t> *src0_shape, std::vector<size_t> *src1_shape,
@@ -38,9 +41,24 @@ class MKLCPUKernel : public CPUKernel {
                   const std::vector<size_t> &kernel_size, int stride, std::vector<int> *padding_l,
                   std::vector<int> *padding_r);
   void AddArgument(int arg_key, const dnnl::memory::desc &mem_desc, bool alloc = false);
+  // The tensor of the argument keeps the user desc, it is reordered into a buffer of the compute desc before each
+  // execution of the primitive.
+  void AddConvertedArgument(int arg_key, const dnnl::memory::desc &user_desc, const dnnl::memory::desc &compute_desc);
   void SetArgumentHandle(int arg_key, void *ptr);
   dnnl::memory::format_tag GetDefaultFormatTag(const dnnl::memory::dims &dims) const;
-  dnnl::memory::desc GetDefaultMemDesc(const std::vector<size_t> &shape);
+  dnnl::memory::desc GetDefaultMemDesc(const std::vector<size_t> &shape,
+                                       dnnl::memory::data_type data_type = dnnl::memory::data_type::f32);
+  // Whether the mixed precision pass asked the kernel to compute in bfloat16 and the processor supports it natively.
+  static bool UseBf16(const CNodePtr &kernel_node);
+  // Builds a matmul of [batch, m, k] by [batch, k, n] in bfloat16, the float32 inputs are converted before each launch
+  // and the output stays float32.
+  void InitBf16MatMul(const CNodePtr &kernel_node, dnnl::memory::dim batch, dnnl::memory::dim dim_m,
+                      dnnl::memory::dim dim_n, dnnl::memory::dim dim_k, bool trans_a, bool trans_b);
+  // Identifies the primitive of the node by the op name, the shapes and data types of its inputs and outputs and the
+  // attributes, the nodes of the same key share one compiled primitive.
+  static std::string GetPrimitiveKey(const CNodePtr &kernel_node);
+  // Sets primitive_ from the primitive cache of the engine, the creator only runs on a miss.
+  void CreatePrimitive(const CNodePtr &kernel_node, const PrimitiveCache<dnnl::primitive>::Creator &creator);
   void ExecutePrimitive();
   std::unordered_map<int, dnnl::memory> arguments_;
   std::shared_ptr<dnnl::primitive> primitive_{nullptr};
@@ -48,6 +66,14 @@ class MKLCPUKernel : public CPUKernel {
     return dnnl::memory::desc{{dimensions}, dnnl::memory::data_type::f32, layout};
   }
   void Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem);
+
+ private:
+  struct ConvertedArgument {
+    int arg_key;
+    dnnl::memory user_memory;
+    std::shared_ptr<dnnl::primitive> reorder;
+  };
+  std::vector<ConvertedArgument> converted_arguments_;
 };
 }  // namespace kernel
 }  // namespace mindspore
@@ -0,0 +1,162 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/mkldnn/mkl_int8_cpu_kernel.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include "backend/kernel_compiler/cpu/fake_quant_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr float kUint8Max = 255.0f;
+constexpr float kInt8Max = 127.0f;
+constexpr float kInt8ZeroPoint = 128.0f;
+// The output channels are the dimension 1 of the dst of both the convolution and the matmul.
+constexpr int kDstChannelMask = 1 << 1;
+
+FakeQuantCPUKernel::NudgedRange GetInt8Range(float min, float max, bool narrow_range, bool symmetric) {
+  return FakeQuantCPUKernel::NudgeRange(min, max, narrow_range ? 1.0f : 0.0f, kUint8Max, symmetric);
+}
+
+// The multiplier taking the float32 values to the s8 levels. It keeps the grid of the FakeQuant when the zero point of
+// the range is the middle level, as for the symmetric ranges, otherwise the range is requantized around the zero.
+float GetSignedMultiplier(const FakeQuantCPUKernel::NudgedRange &range) {
+  if (range.scale <= 0) {
+    return 1.0f;
+  }
+  if (std::round(-range.min / range.scale) <= kInt8ZeroPoint && std::round(range.max / range.scale) <= kInt8Max) {
+    return 1.0f / range.scale;
+  }
+  return kInt8Max / std::max(-range.min, range.max);
+}
+}  // namespace
+
+void MKLInt8CPUKernel::InitInt8(const CNodePtr &kernel_node, const dnnl::memory::desc &src_desc,
+                                const dnnl::memory::desc &weights_desc, const dnnl::memory::desc &bias_desc,
+                                const dnnl::memory::desc &dst_desc, size_t channel_num, int weights_channel_mask) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  primitive_key_ = GetPrimitiveKey(kernel_node);
+  has_bias_ = AnfAlgo::GetInputTensorNum(kernel_node) > kBiasIndex;
+  src_narrow_range_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrSrcNarrowRange);
+  src_symmetric_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrSrcSymmetric);
+  weight_narrow_range_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrWeightNarrowRange);
+  weight_symmetric_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrWeightSymmetric);
+  channel_num_ = channel_num;
+  weights_channel_mask_ = weights_channel_mask;
+  src_user_memory_ = MKLKernelEngine::Get().CreateMemory(src_desc);
+  weights_user_memory_ = MKLKernelEngine::Get().CreateMemory(weights_desc);
+  if (has_bias_) {
+    AddArgument(DNNL_ARG_BIAS, bias_desc, true);
+  }
+  AddArgument(DNNL_ARG_DST, dst_desc);
+}
+
+void MKLInt8CPUKernel::Prepare(bool src_unsigned, float src_multiplier, const std::vector<float> &weight_multipliers) {
+  auto src_dims = src_user_memory_.get_desc().dims();
+  auto src_type = src_unsigned ? dnnl::memory::data_type::u8 : dnnl::memory::data_type::s8;
+  dnnl::memory::desc src_desc(src_dims, src_type, GetDefaultFormatTag(src_dims));
+  dnnl::memory::desc bias_desc = has_bias_ ? arguments_[DNNL_ARG_BIAS].get_desc() : dnnl::memory::desc();
+  std::vector<float> output_scales(channel_num_);
+  for (size_t i = 0; i < channel_num_; ++i) {
+    output_scales[i] = 1.0f / (src_multiplier * weight_multipliers[i]);
+  }
+  dnnl::primitive_attr attr;
+  attr.set_output_scales(kDstChannelMask, output_scales);
+  auto prim_desc = CreateInt8PrimitiveDesc(src_desc, bias_desc, attr);
+
+  // The output scales are part of the primitive.
+  std::ostringstream key;
+  key << primitive_key_ << ";int8" << (src_unsigned ? "u" : "s") << std::hexfloat;
+  for (auto scale : output_scales) {
+    key << "," << scale;
+  }
+  primitive_ = MKLKernelEngine::Get().primitive_cache().Get(
+    key.str(), [&prim_desc]() { return std::make_shared<dnnl::primitive>(prim_desc); });
+
+  arguments_[DNNL_ARG_SRC] = MKLKernelEngine::Get().CreateMemory(src_desc, true);
+  dnnl::primitive_attr src_attr;
+  src_attr.set_output_scales(0, {src_multiplier});
+  src_reorder_ = std::make_shared<dnnl::reorder>(
+    dnnl::reorder::primitive_desc(src_user_memory_, arguments_[DNNL_ARG_SRC], src_attr));
+
+  arguments_[DNNL_ARG_WEIGHTS] = MKLKernelEngine::Get().CreateMemory(prim_desc.weights_desc(0), true);
+  dnnl::primitive_attr weights_attr;
+  weights_attr.set_output_scales(weights_channel_mask_, weight_multipliers);
+  weights_reorder_ = std::make_shared<dnnl::reorder>(
+    dnnl::reorder::primitive_desc(weights_user_memory_, arguments_[DNNL_ARG_WEIGHTS], weights_attr));
+  quantized_weights_addr_ = nullptr;
+}
+
+bool MKLInt8CPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                              const std::vector<kernel::AddressPtr> & /*workspace*/,
+                              const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() < (has_bias_ ? kBiasIndex + 1 : kBiasIndex) || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "int8 kernel error input output size!";
+  }
+  auto src_min = reinterpret_cast<float *>(inputs[kSrcMinIndex]->addr);
+  auto src_max = reinterpret_cast<float *>(inputs[kSrcMaxIndex]->addr);
+  auto weight_min = reinterpret_cast<float *>(inputs[kWeightMinIndex]->addr);
+  auto weight_max = reinterpret_cast<float *>(inputs[kWeightMaxIndex]->addr);
+  size_t weight_range_num = inputs[kWeightMinIndex]->size / sizeof(float);
+  if (weight_range_num != 1 && weight_range_num != channel_num_) {
+    MS_LOG(EXCEPTION) << "The weight has " << weight_range_num << " ranges, but " << channel_num_ << " channels.";
+  }
+
+  // A src range without negative part is quantized to u8, which keeps all its levels.
+  auto src_range = GetInt8Range(src_min[0], src_max[0], src_narrow_range_, src_symmetric_);
+  bool src_unsigned = src_range.min >= 0 && src_range.scale > 0;
+  float src_multiplier = src_unsigned ? 1.0f / src_range.scale : GetSignedMultiplier(src_range);
+  std::vector<float> weight_multipliers(channel_num_);
+  for (size_t i = 0; i < channel_num_; ++i) {
+    size_t range_index = weight_range_num == 1 ? 0 : i;
+    auto weight_range =
+      GetInt8Range(weight_min[range_index], weight_max[range_index], weight_narrow_range_, weight_symmetric_);
+    weight_multipliers[i] = GetSignedMultiplier(weight_range);
+  }
+  if (primitive_ == nullptr || src_unsigned != src_unsigned_ || src_multiplier != src_multiplier_ ||
+      weight_multipliers != weight_multipliers_) {
+    Prepare(src_unsigned, src_multiplier, weight_multipliers);
+    src_unsigned_ = src_unsigned;
+    src_multiplier_ = src_multiplier;
+    weight_multipliers_ = weight_multipliers;
+  }
+
+  auto &engine = MKLKernelEngine::Get();
+  if (inputs[kWeightIndex]->addr != quantized_weights_addr_) {
+    weights_user_memory_.set_data_handle(inputs[kWeightIndex]->addr);
+    engine.Execute(weights_reorder_,
+                   {{DNNL_ARG_FROM, weights_user_memory_}, {DNNL_ARG_TO, arguments_[DNNL_ARG_WEIGHTS]}});
+    quantized_weights_addr_ = inputs[kWeightIndex]->addr;
+  }
+  // The bias is added to the int32 accumulator before the output scales.
+  if (has_bias_) {
+    auto bias = reinterpret_cast<float *>(inputs[kBiasIndex]->addr);
+    auto quantized_bias = reinterpret_cast<float *>(arguments_[DNNL_ARG_BIAS].get_data_handle());
+    for (size_t i = 0; i < channel_num_; ++i) {
+      quantized_bias[i] = bias[i] * src_multiplier * weight_multipliers[i];
+    }
+  }
+  src_user_memory_.set_data_handle(inputs[kSrcIndex]->addr);
+  engine.Execute(src_reorder_, {{DNNL_ARG_FROM, src_user_memory_}, {DNNL_ARG_TO, arguments_[DNNL_ARG_SRC]}});
+  SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
+  ExecutePrimitive();
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
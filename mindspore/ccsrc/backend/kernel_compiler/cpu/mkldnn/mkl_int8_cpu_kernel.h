@@ -0,0 +1,83 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MKL_INT8_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MKL_INT8_CPU_KERNEL_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "backend/kernel_compiler/cpu/mkldnn/mkl_cpu_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+// The base of the kernels computing a float32 op in int8 with the ranges of the FakeQuant nodes folded into them. The
+// inputs are the float32 src and weight, the per layer range of the src, the per layer or per channel range of the
+// weight and an optional bias. The src is quantized on each launch, the weight only when its range or its address
+// changes, so a folded weight is a constant of the inference graph. The output stays float32.
+class MKLInt8CPUKernel : public MKLCPUKernel {
+ public:
+  MKLInt8CPUKernel() = default;
+  ~MKLInt8CPUKernel() override = default;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+  enum InputIndex : size_t {
+    kSrcIndex = 0,
+    kWeightIndex,
+    kSrcMinIndex,
+    kSrcMaxIndex,
+    kWeightMinIndex,
+    kWeightMaxIndex,
+    kBiasIndex
+  };
+
+ protected:
+  // Called by InitKernel of the derived kernels with the float32 descs of the user tensors. The output channels are
+  // the dimension 1 of the dst, weights_channel_mask selects them in the weights.
+  void InitInt8(const CNodePtr &kernel_node, const dnnl::memory::desc &src_desc, const dnnl::memory::desc &weights_desc,
+                const dnnl::memory::desc &bias_desc, const dnnl::memory::desc &dst_desc, size_t channel_num,
+                int weights_channel_mask);
+  // Describes the op for the quantized src, the s8 weights can take any format. The output scales of attr turn the
+  // int32 accumulator back into float32.
+  virtual dnnl::primitive_desc CreateInt8PrimitiveDesc(const dnnl::memory::desc &src_desc,
+                                                       const dnnl::memory::desc &bias_desc,
+                                                       const dnnl::primitive_attr &attr) = 0;
+
+ private:
+  void Prepare(bool src_unsigned, float src_multiplier, const std::vector<float> &weight_multipliers);
+
+  std::string primitive_key_;
+  bool has_bias_{false};
+  bool src_narrow_range_{false};
+  bool src_symmetric_{false};
+  bool weight_narrow_range_{false};
+  bool weight_symmetric_{false};
+  size_t channel_num_{0};
+  int weights_channel_mask_{0};
+  dnnl::memory src_user_memory_;
+  dnnl::memory weights_user_memory_;
+  std::shared_ptr<dnnl::primitive> src_reorder_{nullptr};
+  std::shared_ptr<dnnl::primitive> weights_reorder_{nullptr};
+  bool src_unsigned_{false};
+  float src_multiplier_{0};
+  std::vector<float> weight_multipliers_;
+  void *quantized_weights_addr_{nullptr};
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MKL_INT8_CPU_KERNEL_H_
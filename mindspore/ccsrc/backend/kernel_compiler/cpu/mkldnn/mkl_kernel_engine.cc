@@ -14,16 +14,44 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
+#include <stdexcept>
+#include <string>
 #include "utils/log_adapter.h"
 #include "dnnl.hpp"
 
 namespace mindspore {
 namespace kernel {
+namespace {
+constexpr size_t kDefaultPrimitiveCacheCapacity = 1024;
+
+size_t GetPrimitiveCacheCapacity() {
+  auto capacity = common::GetEnv("MS_CPU_PRIMITIVE_CACHE_CAPACITY");
+  if (capacity.empty()) {
+    return kDefaultPrimitiveCacheCapacity;
+  }
+  try {
+    return std::stoul(capacity);
+  } catch (const std::logic_error &) {
+    MS_LOG(WARNING) << "Invalid MS_CPU_PRIMITIVE_CACHE_CAPACITY " << capacity << ", use the default capacity "
+                    << kDefaultPrimitiveCacheCapacity;
+    return kDefaultPrimitiveCacheCapacity;
+  }
+}
+}  // namespace
+
+MKLKernelEngine::MKLKernelEngine()
+    : engine_(dnnl::engine::kind::cpu, 0), primitive_cache_(GetPrimitiveCacheCapacity()) {}
+
+dnnl::stream &MKLKernelEngine::stream() {
+  thread_local dnnl::stream stream(engine_);
+  return stream;
+}
+
 void MKLKernelEngine::Execute(const std::shared_ptr<dnnl::primitive> &primitive,
                               const std::unordered_map<int, dnnl::memory> &arguments) {
   MS_EXCEPTION_IF_NULL(primitive);
-  primitive->execute(stream_, arguments);
-  (void)stream_.wait();
+  primitive->execute(stream(), arguments);
+  (void)stream().wait();
 }
 
 dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, bool alloc) {
@@ -34,7 +62,7 @@ dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, b
   }
 }
 void MKLKernelEngine::Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem) {
-  dnnl::reorder(*src_mem, *dst_mem).execute(stream_, *src_mem, *dst_mem);
+  dnnl::reorder(*src_mem, *dst_mem).execute(stream(), *src_mem, *dst_mem);
 }
 }  // namespace kernel
 }  // namespace mindspore
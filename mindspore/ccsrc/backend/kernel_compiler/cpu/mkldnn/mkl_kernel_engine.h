@@ -23,6 +23,7 @@
 #include <vector>
 #include <memory>
 #include "dnnl.hpp"
+#include "backend/kernel_compiler/cpu/mkldnn/primitive_cache.h"
 #include "utils/ms_utils.h"
 
 namespace mindspore {
@@ -42,12 +43,17 @@ class MKLKernelEngine {
   void Execute(const std::shared_ptr<dnnl::primitive> &primitive,
                const std::unordered_map<int, dnnl::memory> &arguments);
   void Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem);
+  // Shared by all the kernels of the process, so that a shape seen before does not compile its primitive again.
+  PrimitiveCache<dnnl::primitive> &primitive_cache() { return primitive_cache_; }
 
  private:
-  MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0), stream_(engine_) {}
+  MKLKernelEngine();
   ~MKLKernelEngine() = default;
+  // The stream of the calling thread. Kernels are launched from several threads at once by the inter-op parallel
+  // execution and the replicas, and a stream must not be used by two threads concurrently.
+  dnnl::stream &stream();
   dnnl::engine engine_;
-  dnnl::stream stream_;
+  PrimitiveCache<dnnl::primitive> primitive_cache_;
 };
 }  // namespace kernel
 }  // namespace mindspore
@@ -65,7 +65,8 @@ void AvgPoolingGradCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   auto backward_prim_desc =
     dnnl::pooling_backward::primitive_desc(backward_desc, MKLKernelEngine::Get().engine(), prim_desc);
 
-  primitive_ = std::make_shared<dnnl::pooling_backward>(backward_prim_desc);
+  CreatePrimitive(kernel_node,
+                  [&backward_prim_desc]() { return std::make_shared<dnnl::pooling_backward>(backward_prim_desc); });
   AddArgument(DNNL_ARG_SRC, src_desc);
   AddArgument(DNNL_ARG_DST, dst_desc);
   AddArgument(DNNL_ARG_DIFF_SRC, src_desc);
@@ -60,7 +60,7 @@ void PoolingCPUKernel::InitKernel(const CNodePtr &kernel_node) {
                                        dst_desc, strides_dims, kernels_dims, padding_l, padding_r);
   }
   auto prim_desc = dnnl::pooling_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::pooling_forward>(prim_desc);
+  CreatePrimitive(kernel_node, [&prim_desc]() { return std::make_shared<dnnl::pooling_forward>(prim_desc); });
   AddArgument(DNNL_ARG_SRC, src_desc);
   AddArgument(DNNL_ARG_DST, dst_desc);
   AddArgument(DNNL_ARG_WORKSPACE, prim_desc.workspace_desc());
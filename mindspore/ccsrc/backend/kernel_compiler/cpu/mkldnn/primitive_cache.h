@@ -0,0 +1,103 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MKLDNN_PRIMITIVE_CACHE_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MKLDNN_PRIMITIVE_CACHE_H_
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace mindspore {
+namespace kernel {
+// A least recently used cache of the compiled primitives, keyed by everything the primitive is built from. A capacity
+// of 0 disables the cache, every lookup then creates a new primitive.
+template <typename T>
+class PrimitiveCache {
+ public:
+  using Creator = std::function<std::shared_ptr<T>()>;
+  explicit PrimitiveCache(size_t capacity) : capacity_(capacity) {}
+  ~PrimitiveCache() = default;
+
+  // The creator runs outside of the lock, two kernels missing the same key at the same time both create it.
+  std::shared_ptr<T> Get(const std::string &key, const Creator &creator) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto iter = entries_.find(key);
+      if (iter != entries_.end()) {
+        lru_list_.splice(lru_list_.begin(), lru_list_, iter->second);
+        hit_num_.fetch_add(1, std::memory_order_relaxed);
+        return iter->second->second;
+      }
+    }
+    miss_num_.fetch_add(1, std::memory_order_relaxed);
+    auto value = creator();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (capacity_ == 0 || entries_.count(key) != 0) {
+      return value;
+    }
+    lru_list_.emplace_front(key, value);
+    entries_[key] = lru_list_.begin();
+    Evict();
+    return value;
+  }
+
+  void SetCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    Evict();
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_list_.clear();
+    entries_.clear();
+    hit_num_ = 0;
+    miss_num_ = 0;
+  }
+
+  size_t capacity() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+  }
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+  size_t hit_num() const { return hit_num_.load(std::memory_order_relaxed); }
+  size_t miss_num() const { return miss_num_.load(std::memory_order_relaxed); }
+
+ private:
+  void Evict() {
+    while (entries_.size() > capacity_) {
+      (void)entries_.erase(lru_list_.back().first);
+      lru_list_.pop_back();
+    }
+  }
+
+  mutable std::mutex mutex_;
+  size_t capacity_;
+  std::list<std::pair<std::string, std::shared_ptr<T>>> lru_list_;
+  std::unordered_map<std::string, typename std::list<std::pair<std::string, std::shared_ptr<T>>>::iterator> entries_;
+  std::atomic<size_t> hit_num_{0};
+  std::atomic<size_t> miss_num_{0};
+};
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MKLDNN_PRIMITIVE_CACHE_H_
@@ -37,8 +37,10 @@ void TensorAddCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   }
   dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
   dnnl::binary::desc desc = dnnl::binary::desc(dnnl::algorithm::binary_add, src0_desc, src1_desc, dst_desc);
-  auto prim_desc = dnnl::binary::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::binary>(prim_desc);
+  CreatePrimitive(kernel_node, [&desc]() {
+    auto prim_desc = dnnl::binary::primitive_desc(desc, MKLKernelEngine::Get().engine());
+    return std::make_shared<dnnl::binary>(prim_desc);
+  });
   AddArgument(DNNL_ARG_SRC_0, src0_desc);
   AddArgument(DNNL_ARG_SRC_1, src1_desc);
   AddArgument(DNNL_ARG_DST, dst_desc);
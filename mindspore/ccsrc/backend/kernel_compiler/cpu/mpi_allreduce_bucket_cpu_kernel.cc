@@ -0,0 +1,115 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/mpi_allreduce_bucket_cpu_kernel.h"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include "backend/kernel_compiler/cpu/allreduce_cpu_kernel.h"
+#include "runtime/device/cpu/cpu_device_address.h"
+#include "runtime/device/cpu/mpi/mpi_interface.h"
+#include "utils/ms_context.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// The element offset of each tensor in the bucket, the last one is the size of the bucket.
+std::vector<size_t> GetBucketOffsets(const std::vector<std::vector<size_t>> &shapes) {
+  std::vector<size_t> offsets = {0};
+  for (auto &shape : shapes) {
+    size_t size = std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+    offsets.push_back(offsets.back() + size);
+  }
+  return offsets;
+}
+
+// Calls func(tensor, start, end) for the parts of the tensors in the elements [start, end) of the bucket.
+template <typename Func>
+void ForEachTensorPart(const std::vector<size_t> &offsets, size_t start, size_t end, const Func &func) {
+  size_t tensor = static_cast<size_t>(std::upper_bound(offsets.begin(), offsets.end(), start) - offsets.begin()) - 1;
+  for (; tensor + 1 < offsets.size() && offsets[tensor] < end; ++tensor) {
+    func(tensor, std::max(start, offsets[tensor]), std::min(end, offsets[tensor + 1]));
+  }
+}
+}  // namespace
+
+void MPIAllReduceStartCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  std::vector<std::vector<size_t>> shapes;
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+  for (size_t i = 0; i < input_num; ++i) {
+    shapes.push_back(AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, i));
+  }
+  offsets_ = GetBucketOffsets(shapes);
+  ranks_group_.resize(IntToSize(GetMPIRankSize()));
+  for (size_t i = 0; i < ranks_group_.size(); ++i) {
+    ranks_group_[i] = SizeToInt(i);
+  }
+  compression_ = GetMPIGradCompression(offsets_.back() * sizeof(float));
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  compression_ratio_ = context_ptr->get_param<float>(MS_CTX_CPU_GRAD_COMPRESSION_RATIO);
+  compressor_key_ = kernel_node->fullname_with_scope();
+}
+
+bool MPIAllReduceStartCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                        const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                        const std::vector<kernel::AddressPtr> &outputs) {
+  auto buffer = reinterpret_cast<float *>(outputs[0]->addr);
+  auto task = [&](size_t start, size_t end) {
+    ForEachTensorPart(offsets_, start, end, [&](size_t tensor, size_t part_start, size_t part_end) {
+      auto input = reinterpret_cast<float *>(inputs[tensor]->addr);
+      std::copy(input + part_start - offsets_[tensor], input + part_end - offsets_[tensor], buffer + part_start);
+    });
+  };
+  CPUKernelUtils::ParallelFor(task, offsets_.back());
+  return MPIIAllReduce(buffer, ranks_group_, offsets_.back(), kMPIOpTypeSum, compression_, compression_ratio_,
+                       compressor_key_);
+}
+
+void MPIAllReduceWaitCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  std::vector<std::vector<size_t>> shapes;
+  size_t output_num = AnfAlgo::GetOutputTensorNum(kernel_node);
+  for (size_t i = 0; i < output_num; ++i) {
+    shapes.push_back(AnfAlgo::GetOutputInferShape(kernel_node, i));
+  }
+  offsets_ = GetBucketOffsets(shapes);
+  if (AnfAlgo::HasNodeAttr(kAttrMean, kernel_node) && AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrMean)) {
+    scale_ = 1.0f / GetMPIRankSize();
+  }
+}
+
+bool MPIAllReduceWaitCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                       const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                       const std::vector<kernel::AddressPtr> &outputs) {
+  auto buffer = reinterpret_cast<float *>(inputs[0]->addr);
+  if (!MPIWaitAllReduce(buffer)) {
+    return false;
+  }
+  auto task = [&](size_t start, size_t end) {
+    ForEachTensorPart(offsets_, start, end, [&](size_t tensor, size_t part_start, size_t part_end) {
+      auto output = reinterpret_cast<float *>(outputs[tensor]->addr);
+      for (size_t i = part_start; i < part_end; ++i) {
+        output[i - offsets_[tensor]] = buffer[i] * scale_;
+      }
+    });
+  };
+  CPUKernelUtils::ParallelFor(task, offsets_.back());
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,70 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MPI_ALLREDUCE_BUCKET_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MPI_ALLREDUCE_BUCKET_CPU_KERNEL_H_
+#include <string>
+#include <vector>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+
+namespace mindspore {
+namespace kernel {
+// The gradient buckets of enable_cpu_grad_allreduce, see AllReduceBucketing. MPIAllReduceStart packs its inputs one
+// after the other into its output, a flat buffer, and starts the non-blocking sum of the buffer over the processes of
+// the MPI world. MPIAllReduceWait takes that buffer, waits for the sum and unpacks it into its outputs, divided by the
+// process number when the attribute mean is set.
+class MPIAllReduceStartCPUKernel : public CPUKernel {
+ public:
+  MPIAllReduceStartCPUKernel() = default;
+  ~MPIAllReduceStartCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  std::vector<size_t> offsets_;
+  std::vector<int> ranks_group_;
+  std::string compression_;
+  float compression_ratio_{0};
+  std::string compressor_key_;
+};
+
+class MPIAllReduceWaitCPUKernel : public CPUKernel {
+ public:
+  MPIAllReduceWaitCPUKernel() = default;
+  ~MPIAllReduceWaitCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  std::vector<size_t> offsets_;
+  float scale_{1};
+};
+
+MS_REG_CPU_KERNEL(MPIAllReduceStart,
+                  KernelAttr().SetAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  MPIAllReduceStartCPUKernel);
+MS_REG_CPU_KERNEL(MPIAllReduceWait,
+                  KernelAttr().SetAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  MPIAllReduceWaitCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MPI_ALLREDUCE_BUCKET_CPU_KERNEL_H_
@@ -0,0 +1,250 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/multi_tensor_apply_cpu_kernel.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <numeric>
+#include "common/thread_pool.h"
+#include "runtime/device/cpu/cpu_device_address.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr size_t kAdamInputNum = 10;
+constexpr size_t kApplyMomentumInputNum = 5;
+constexpr size_t kFusedAdamInputNum = 10;
+constexpr size_t kFusedAdamWeightDecayInputNum = 11;
+// The index of the parameter among the inputs of one FusedAdam or FusedAdamWeightDecay.
+constexpr size_t kFusedAdamParamIndex = 6;
+
+// The loops below take the whole chunk without branches so that they are vectorized.
+void AdamUpdate(float *var, float *m, float *v, const float *grad, float lr, float beta1, float beta2, float epsilon,
+                size_t start, size_t end) {
+  for (size_t i = start; i < end; ++i) {
+    m[i] += (grad[i] - m[i]) * (1 - beta1);
+    v[i] += (grad[i] * grad[i] - v[i]) * (1 - beta2);
+    var[i] -= lr * m[i] / (std::sqrt(v[i]) + epsilon);
+  }
+}
+
+void AdamNesterovUpdate(float *var, float *m, float *v, const float *grad, float lr, float beta1, float beta2,
+                        float epsilon, size_t start, size_t end) {
+  for (size_t i = start; i < end; ++i) {
+    m[i] += (grad[i] - m[i]) * (1 - beta1);
+    v[i] += (grad[i] * grad[i] - v[i]) * (1 - beta2);
+    var[i] -= lr * (m[i] * beta1 + (1 - beta1) * grad[i]) / (std::sqrt(v[i]) + epsilon);
+  }
+}
+
+void MomentumUpdate(float *var, float *accum, const float *grad, float lr, float momentum, size_t start, size_t end) {
+  for (size_t i = start; i < end; ++i) {
+    accum[i] = accum[i] * momentum + grad[i];
+    var[i] -= accum[i] * lr;
+  }
+}
+
+// Same as the FusedAdamWeightDecay GPU kernel, FusedAdam takes a weight decay of 0.
+void AdamWeightDecayUpdate(float *var, float *m, float *v, const float *grad, float lr, float beta1,
+                           float one_sub_beta1, float beta2, float one_sub_beta2, float epsilon, float weight_decay,
+                           size_t start, size_t end) {
+  for (size_t i = start; i < end; ++i) {
+    float next_m = beta1 * m[i] + one_sub_beta1 * grad[i];
+    float next_v = beta2 * v[i] + one_sub_beta2 * grad[i] * grad[i];
+    float update = next_m / (std::sqrt(next_v) + epsilon) + weight_decay * var[i];
+    var[i] -= lr * update;
+    m[i] = next_m;
+    v[i] = next_v;
+  }
+}
+
+float GetScalar(const AddressPtr &address, const std::string &name) {
+  MS_EXCEPTION_IF_NULL(address);
+  if (address->size != sizeof(float)) {
+    MS_LOG(EXCEPTION) << "The " << name << " of MultiTensorApply must be a float scalar, but got " << address->size
+                      << " bytes.";
+  }
+  return reinterpret_cast<float *>(address->addr)[0];
+}
+}  // namespace
+
+size_t MultiTensorApplyCPUKernel::GetOptimizerInputNum(const std::string &optimizer_name) {
+  static const std::map<std::string, size_t> kOptimizerInputNum = {
+    {kApplyAdamOpName, kAdamInputNum},
+    {kApplyMomentumOpName, kApplyMomentumInputNum},
+    {kFusedAdamName, kFusedAdamInputNum},
+    {kFusedAdamWeightDecayName, kFusedAdamWeightDecayInputNum}};
+  auto iter = kOptimizerInputNum.find(optimizer_name);
+  return iter == kOptimizerInputNum.end() ? 0 : iter->second;
+}
+
+void MultiTensorApplyCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto optimizer_name = AnfAlgo::GetNodeAttr<std::string>(kernel_node, kAttrOptimizerName);
+  static const std::map<std::string, OptimizerType> kOptimizerTypes = {
+    {kApplyAdamOpName, kAdam},
+    {kApplyMomentumOpName, kApplyMomentum},
+    {kFusedAdamName, kFusedAdam},
+    {kFusedAdamWeightDecayName, kFusedAdamWeightDecay}};
+  auto iter = kOptimizerTypes.find(optimizer_name);
+  if (iter == kOptimizerTypes.end()) {
+    MS_LOG(EXCEPTION) << "MultiTensorApply does not support the optimizer " << optimizer_name;
+  }
+  optimizer_type_ = iter->second;
+  input_num_per_tensor_ = GetOptimizerInputNum(optimizer_name);
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+  size_t tensor_num = AnfAlgo::GetOutputTensorNum(kernel_node);
+  if (tensor_num == 0 || input_num != tensor_num * input_num_per_tensor_) {
+    MS_LOG(EXCEPTION) << "MultiTensorApply of " << optimizer_name << " has " << input_num << " inputs and "
+                      << tensor_num << " outputs, but needs " << input_num_per_tensor_ << " inputs per output.";
+  }
+  if (optimizer_type_ == kAdam && AnfAlgo::HasNodeAttr("use_nesterov", kernel_node)) {
+    use_nesterov_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, "use_nesterov");
+  }
+  if (AnfAlgo::HasNodeAttr(kAttrOutputUsed, kernel_node)) {
+    output_used_ = AnfAlgo::GetNodeAttr<std::vector<int64_t>>(kernel_node, kAttrOutputUsed);
+  } else {
+    output_used_.assign(tensor_num, 1);
+  }
+  if (output_used_.size() != tensor_num) {
+    MS_LOG(EXCEPTION) << "The size of attr " << kAttrOutputUsed << " is " << output_used_.size() << ", but expect "
+                      << tensor_num;
+  }
+  bool is_fused_adam = optimizer_type_ == kFusedAdam || optimizer_type_ == kFusedAdamWeightDecay;
+  size_t param_index = is_fused_adam ? kFusedAdamParamIndex : 0;
+  elem_nums_.clear();
+  for (size_t i = 0; i < tensor_num; ++i) {
+    auto shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, i * input_num_per_tensor_ + param_index);
+    elem_nums_.push_back(std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>()));
+  }
+  InitChunks();
+}
+
+void MultiTensorApplyCPUKernel::InitChunks() {
+  chunks_.clear();
+  for (size_t tensor = 0; tensor < elem_nums_.size(); ++tensor) {
+    for (size_t start = 0; start < elem_nums_[tensor]; start += kChunkSize) {
+      chunks_.push_back({tensor, start, std::min(start + kChunkSize, elem_nums_[tensor])});
+    }
+  }
+  args_.resize(elem_nums_.size());
+}
+
+void MultiTensorApplyCPUKernel::GetTensorArgs(const std::vector<AddressPtr> &inputs,
+                                              const std::vector<AddressPtr> &outputs) {
+  for (size_t tensor = 0; tensor < elem_nums_.size(); ++tensor) {
+    auto member_inputs = inputs.begin() + tensor * input_num_per_tensor_;
+    auto &args = args_[tensor];
+    size_t var_index = 0;
+    size_t m_index = 1;
+    size_t v_index = 2;
+    size_t grad_index = 3;
+    if (optimizer_type_ == kAdam) {
+      grad_index = 9;
+      float beta1_power = GetScalar(member_inputs[3], "beta1_power");
+      float beta2_power = GetScalar(member_inputs[4], "beta2_power");
+      if (beta1_power == 1) {
+        MS_LOG(EXCEPTION) << "The beta1_power can't be set 1.";
+      }
+      args.lr = GetScalar(member_inputs[5], "lr") * std::sqrt(1.0 - beta2_power) / (1 - beta1_power);
+      args.beta1 = GetScalar(member_inputs[6], "beta1");
+      args.beta2 = GetScalar(member_inputs[7], "beta2");
+      args.epsilon = GetScalar(member_inputs[8], "epsilon");
+    } else if (optimizer_type_ == kApplyMomentum) {
+      v_index = m_index;
+      args.lr = GetScalar(member_inputs[2], "lr");
+      args.beta1 = GetScalar(member_inputs[4], "momentum");
+    } else {
+      var_index = kFusedAdamParamIndex;
+      m_index = kFusedAdamParamIndex + 1;
+      v_index = kFusedAdamParamIndex + 2;
+      grad_index = kFusedAdamParamIndex + 3;
+      args.beta1 = GetScalar(member_inputs[0], "beta1");
+      args.one_sub_beta1 = GetScalar(member_inputs[1], "one_sub_beta1");
+      args.beta2 = GetScalar(member_inputs[2], "beta2");
+      args.one_sub_beta2 = GetScalar(member_inputs[3], "one_sub_beta2");
+      args.epsilon = GetScalar(member_inputs[4], "epsilon");
+      args.lr = GetScalar(member_inputs[5], "lr");
+      args.weight_decay =
+        optimizer_type_ == kFusedAdamWeightDecay ? GetScalar(member_inputs[10], "weight_decay") : 0.0f;
+    }
+    size_t tensor_size = elem_nums_[tensor] * sizeof(float);
+    if (member_inputs[var_index]->size != tensor_size || member_inputs[m_index]->size != tensor_size ||
+        member_inputs[v_index]->size != tensor_size || member_inputs[grad_index]->size != tensor_size) {
+      MS_LOG(EXCEPTION) << "The inputs of tensor " << tensor << " of MultiTensorApply do not have " << tensor_size
+                        << " bytes.";
+    }
+    args.var = reinterpret_cast<float *>(member_inputs[var_index]->addr);
+    args.m = reinterpret_cast<float *>(member_inputs[m_index]->addr);
+    args.v = reinterpret_cast<float *>(member_inputs[v_index]->addr);
+    args.grad = reinterpret_cast<float *>(member_inputs[grad_index]->addr);
+    args.output = nullptr;
+    if (output_used_[tensor] != 0) {
+      if (outputs[tensor]->size != tensor_size) {
+        MS_LOG(EXCEPTION) << "The output " << tensor << " of MultiTensorApply does not have " << tensor_size
+                          << " bytes.";
+      }
+      args.output = reinterpret_cast<float *>(outputs[tensor]->addr);
+    }
+  }
+}
+
+void MultiTensorApplyCPUKernel::ApplyChunk(const Chunk &chunk) const {
+  auto &args = args_[chunk.tensor];
+  switch (optimizer_type_) {
+    case kAdam:
+      if (use_nesterov_) {
+        AdamNesterovUpdate(args.var, args.m, args.v, args.grad, args.lr, args.beta1, args.beta2, args.epsilon,
+                           chunk.start, chunk.end);
+      } else {
+        AdamUpdate(args.var, args.m, args.v, args.grad, args.lr, args.beta1, args.beta2, args.epsilon, chunk.start,
+                   chunk.end);
+      }
+      break;
+    case kApplyMomentum:
+      MomentumUpdate(args.var, args.m, args.grad, args.lr, args.beta1, chunk.start, chunk.end);
+      break;
+    default:
+      AdamWeightDecayUpdate(args.var, args.m, args.v, args.grad, args.lr, args.beta1, args.one_sub_beta1, args.beta2,
+                            args.one_sub_beta2, args.epsilon, args.weight_decay, chunk.start, chunk.end);
+      break;
+  }
+  if (args.output != nullptr) {
+    std::copy(args.var + chunk.start, args.var + chunk.end, args.output + chunk.start);
+  }
+}
+
+bool MultiTensorApplyCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                       const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                       const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() != elem_nums_.size() * input_num_per_tensor_ || outputs.size() != elem_nums_.size()) {
+    MS_LOG(EXCEPTION) << "MultiTensorApply got " << inputs.size() << " inputs and " << outputs.size()
+                      << " outputs, but expect " << elem_nums_.size() * input_num_per_tensor_ << " inputs and "
+                      << elem_nums_.size() << " outputs.";
+  }
+  GetTensorArgs(inputs, outputs);
+  auto task = [this](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      ApplyChunk(chunks_[i]);
+    }
+  };
+  common::ThreadPool::GetInstance().ParallelFor(task, chunks_.size(), 1);
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,82 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MULTI_TENSOR_APPLY_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MULTI_TENSOR_APPLY_CPU_KERNEL_H_
+#include <memory>
+#include <string>
+#include <vector>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+
+namespace mindspore {
+namespace kernel {
+// Applies one optimizer to a group of float32 parameters in a single launch. The inputs are the inputs of the grouped
+// optimizer nodes one after the other, the output i is the updated parameter i and is only written when it is used.
+// The parameters are cut into chunks of about the same size, the chunks of all the parameters run in one parallel pass.
+class MultiTensorApplyCPUKernel : public CPUKernel {
+ public:
+  MultiTensorApplyCPUKernel() = default;
+  ~MultiTensorApplyCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+  // The number of inputs of one optimizer node, 0 when the optimizer can not be applied by this kernel.
+  static size_t GetOptimizerInputNum(const std::string &optimizer_name);
+  static constexpr size_t kChunkSize = 4096;
+
+ private:
+  enum OptimizerType { kAdam, kApplyMomentum, kFusedAdam, kFusedAdamWeightDecay };
+  struct TensorArgs {
+    float *var{nullptr};
+    float *m{nullptr};
+    float *v{nullptr};
+    const float *grad{nullptr};
+    float *output{nullptr};
+    float lr{0};
+    float beta1{0};
+    float beta2{0};
+    float one_sub_beta1{0};
+    float one_sub_beta2{0};
+    float epsilon{0};
+    float weight_decay{0};
+  };
+  struct Chunk {
+    size_t tensor;
+    size_t start;
+    size_t end;
+  };
+  void InitChunks();
+  void GetTensorArgs(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
+  void ApplyChunk(const Chunk &chunk) const;
+
+  OptimizerType optimizer_type_{kAdam};
+  size_t input_num_per_tensor_{0};
+  bool use_nesterov_{false};
+  std::vector<size_t> elem_nums_;
+  std::vector<int64_t> output_used_;
+  std::vector<Chunk> chunks_;
+  std::vector<TensorArgs> args_;
+};
+
+MS_REG_CPU_KERNEL(MultiTensorApply,
+                  KernelAttr().SetAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  MultiTensorApplyCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_MULTI_TENSOR_APPLY_CPU_KERNEL_H_
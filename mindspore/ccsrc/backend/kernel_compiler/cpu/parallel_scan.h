@@ -0,0 +1,184 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_PARALLEL_SCAN_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_PARALLEL_SCAN_H_
+#include <algorithm>
+#include <vector>
+#include "backend/kernel_compiler/cpu/arithmetic_simd.h"
+#include "common/thread_pool.h"
+
+namespace mindspore {
+namespace kernel {
+// Rows of at least this many elements go through the SIMD kernels of the arithmetic ops.
+constexpr size_t kScanSimdMinSize = 8;
+// The elements of a row scanned by one task, and the elements of a block of the two pass scan.
+constexpr size_t kScanColumnBlockSize = 256;
+constexpr size_t kScanBlockSize = 4096;
+// The independent accumulators reducing a contiguous block, so that the compiler can vectorize the reduction.
+constexpr size_t kScanReduceLanes = 8;
+
+template <typename T>
+struct ScanSumOp {
+  static constexpr SimdBinaryOp kSimdOp = SimdBinaryOp::kAdd;
+  static T Identity() { return static_cast<T>(0); }
+  static T Apply(T a, T b) { return a + b; }
+};
+
+template <typename T>
+struct ScanProdOp {
+  static constexpr SimdBinaryOp kSimdOp = SimdBinaryOp::kMul;
+  static T Identity() { return static_cast<T>(1); }
+  static T Apply(T a, T b) { return a * b; }
+};
+
+// out[k] = a[k] op b[k] for the count elements of a row.
+template <typename T, typename Op>
+void ScanRowApply(const T *a, const T *b, T *out, size_t count) {
+  size_t k = count >= kScanSimdMinSize ? SimdBinary<T>(Op::kSimdOp, a, 1, b, 1, out, count) : 0;
+  for (; k < count; ++k) {
+    out[k] = Op::Apply(a[k], b[k]);
+  }
+}
+
+// The scan of a tensor viewed as [outer, axis, inner] along its axis. The scan of each row of the axis is
+// out[j] = carry op in[0] op ... op in[j], or op in[j - 1] when exclusive, from the other end when reverse. The
+// inner elements of a row are contiguous and computed together by the SIMD kernels.
+template <typename T, typename Op>
+class ParallelScan {
+ public:
+  ParallelScan(size_t outer, size_t axis, size_t inner, bool exclusive, bool reverse)
+      : outer_(outer), axis_(axis), inner_(inner), exclusive_(exclusive), reverse_(reverse) {}
+  ~ParallelScan() = default;
+
+  // The scan runs in one pass over tasks of inner columns when there are enough of them for the threads, a long axis
+  // of few rows is split into blocks: the first pass reduces every block, the carry of every block is the scan of
+  // the blocks before it, and the second pass scans every block from its carry.
+  void Run(const T *input, T *output) const {
+    if (outer_ == 0 || axis_ == 0 || inner_ == 0) {
+      return;
+    }
+    auto &pool = common::ThreadPool::GetInstance();
+    size_t column_block_num = (inner_ + kScanColumnBlockSize - 1) / kScanColumnBlockSize;
+    size_t rows_per_block = std::max<size_t>(1, kScanBlockSize / inner_);
+    size_t block_num = (axis_ + rows_per_block - 1) / rows_per_block;
+    if (outer_ * column_block_num >= pool.GetSyncRunThreadNum() || block_num == 1) {
+      pool.ParallelFor(
+        [&](size_t start, size_t end) {
+          std::vector<T> carry(std::min(inner_, kScanColumnBlockSize), Op::Identity());
+          for (size_t task = start; task < end; ++task) {
+            size_t column_start = task % column_block_num * kScanColumnBlockSize;
+            size_t column_num = std::min(kScanColumnBlockSize, inner_ - column_start);
+            size_t offset = task / column_block_num * axis_ * inner_ + column_start;
+            std::fill(carry.begin(), carry.end(), Op::Identity());
+            ScanRows(input + offset, output + offset, 0, axis_, column_num, carry.data());
+          }
+        },
+        outer_ * column_block_num, 1);
+      return;
+    }
+
+    // The carries of the blocks of an outer index, each a row of inner elements.
+    std::vector<T> carries(outer_ * block_num * inner_);
+    pool.ParallelFor(
+      [&](size_t start, size_t end) {
+        for (size_t task = start; task < end; ++task) {
+          size_t begin_row = task % block_num * rows_per_block;
+          size_t end_row = std::min(axis_, begin_row + rows_per_block);
+          size_t offset = task / block_num * axis_ * inner_;
+          ReduceRows(input + offset, begin_row, end_row, carries.data() + task * inner_);
+        }
+      },
+      outer_ * block_num, 1);
+    std::vector<T> block_total(inner_);
+    for (size_t i = 0; i < outer_; ++i) {
+      T *outer_carries = carries.data() + i * block_num * inner_;
+      std::fill(block_total.begin(), block_total.end(), Op::Identity());
+      for (size_t b = 0; b < block_num; ++b) {
+        T *carry = outer_carries + (reverse_ ? block_num - 1 - b : b) * inner_;
+        for (size_t k = 0; k < inner_; ++k) {
+          T total = Op::Apply(block_total[k], carry[k]);
+          carry[k] = block_total[k];
+          block_total[k] = total;
+        }
+      }
+    }
+    pool.ParallelFor(
+      [&](size_t start, size_t end) {
+        for (size_t task = start; task < end; ++task) {
+          size_t begin_row = task % block_num * rows_per_block;
+          size_t end_row = std::min(axis_, begin_row + rows_per_block);
+          size_t offset = task / block_num * axis_ * inner_;
+          ScanRows(input + offset, output + offset, begin_row, end_row, inner_, carries.data() + task * inner_);
+        }
+      },
+      outer_ * block_num, 1);
+  }
+
+ private:
+  // Scans the rows [begin, end) of an outer index, count elements of each, starting from carry. The exclusive scan
+  // reads the row before, so no temporary is needed even for the reverse one.
+  void ScanRows(const T *input, T *output, size_t begin, size_t end, size_t count, const T *carry) const {
+    size_t row_num = end - begin;
+    auto row = [this, begin, end](size_t j) { return (reverse_ ? end - 1 - j : begin + j) * inner_; };
+    if (exclusive_) {
+      std::copy(carry, carry + count, output + row(0));
+      for (size_t j = 1; j < row_num; ++j) {
+        ScanRowApply<T, Op>(output + row(j - 1), input + row(j - 1), output + row(j), count);
+      }
+      return;
+    }
+    ScanRowApply<T, Op>(carry, input + row(0), output + row(0), count);
+    for (size_t j = 1; j < row_num; ++j) {
+      ScanRowApply<T, Op>(output + row(j - 1), input + row(j), output + row(j), count);
+    }
+  }
+
+  // total = in[begin] op ... op in[end - 1] for the inner_ elements of the rows.
+  void ReduceRows(const T *input, size_t begin, size_t end, T *total) const {
+    if (inner_ == 1) {
+      T lanes[kScanReduceLanes];
+      std::fill(lanes, lanes + kScanReduceLanes, Op::Identity());
+      size_t j = begin;
+      for (; j + kScanReduceLanes <= end; j += kScanReduceLanes) {
+        for (size_t l = 0; l < kScanReduceLanes; ++l) {
+          lanes[l] = Op::Apply(lanes[l], input[j + l]);
+        }
+      }
+      T result = Op::Identity();
+      for (size_t l = 0; l < kScanReduceLanes; ++l) {
+        result = Op::Apply(result, lanes[l]);
+      }
+      for (; j < end; ++j) {
+        result = Op::Apply(result, input[j]);
+      }
+      *total = result;
+      return;
+    }
+    std::copy(input + begin * inner_, input + (begin + 1) * inner_, total);
+    for (size_t j = begin + 1; j < end; ++j) {
+      ScanRowApply<T, Op>(total, input + j * inner_, total, inner_);
+    }
+  }
+
+  size_t outer_;
+  size_t axis_;
+  size_t inner_;
+  bool exclusive_;
+  bool reverse_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_PARALLEL_SCAN_H_
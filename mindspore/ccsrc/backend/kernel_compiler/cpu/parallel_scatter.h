@@ -0,0 +1,150 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_PARALLEL_SCATTER_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_PARALLEL_SCATTER_H_
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "backend/kernel_compiler/cpu/arithmetic_simd.h"
+#include "common/thread_pool.h"
+
+namespace mindspore {
+namespace kernel {
+// A scatter smaller than this many elements runs on the caller thread.
+constexpr size_t kScatterParallelMinSize = 16 * 1024;
+// The wide rows are split into blocks of at least this many columns.
+constexpr size_t kScatterColumnBlockSize = 128;
+// More buckets than threads let the work stealing even out the targets of different sizes.
+constexpr size_t kScatterBucketNumPerThread = 4;
+
+enum class ScatterStrategy { kSerial, kDirect, kBucketed };
+
+// The direct strategy gives every thread a block of columns of all the rows, which needs rows of several blocks per
+// thread. The bucketed one gives every thread the rows of some targets, which needs at least a target per thread.
+inline ScatterStrategy GetScatterStrategy(size_t row_num, size_t row_size, size_t target_num, size_t thread_num) {
+  if (thread_num <= 1 || row_num * row_size < kScatterParallelMinSize) {
+    return ScatterStrategy::kSerial;
+  }
+  if (row_size >= kScatterColumnBlockSize * thread_num || target_num < thread_num) {
+    return ScatterStrategy::kDirect;
+  }
+  return ScatterStrategy::kBucketed;
+}
+
+// dst[i] += src[i] for the count elements of a row.
+template <typename T>
+void ScatterAddRow(const T *src, T *dst, size_t count) {
+  for (size_t i = SimdBinary<T>(SimdBinaryOp::kAdd, dst, 1, src, 1, dst, count); i < count; ++i) {
+    dst[i] += src[i];
+  }
+}
+
+// Groups the rows by target % bucket_num the way SparseOptimizerCPUKernel::BucketReduceSparseGradient does: every
+// segment of rows counts its rows of each bucket, then copies their ids to its own slice of the bucket, so the rows
+// of a bucket keep their order. Every bucket is then updated by one thread.
+template <typename GetTarget, typename UpdateRow>
+void BucketedScatterRows(size_t row_num, size_t row_size, size_t bucket_num, size_t segment_num,
+                         const GetTarget &get_target, const UpdateRow &update_row) {
+  auto &pool = common::ThreadPool::GetInstance();
+  size_t segment_size = (row_num + segment_num - 1) / segment_num;
+  std::vector<size_t> bucket_offsets(segment_num * bucket_num, 0);
+  pool.ParallelFor(
+    [&](size_t start, size_t end) {
+      for (size_t segment = start; segment < end; ++segment) {
+        size_t *counts = bucket_offsets.data() + segment * bucket_num;
+        for (size_t row = segment * segment_size; row < std::min(row_num, (segment + 1) * segment_size); ++row) {
+          int64_t target = get_target(row);
+          if (target >= 0) {
+            counts[static_cast<size_t>(target) % bucket_num]++;
+          }
+        }
+      }
+    },
+    segment_num, 1);
+
+  std::vector<size_t> bucket_begins(bucket_num + 1, 0);
+  size_t total = 0;
+  for (size_t bucket = 0; bucket < bucket_num; ++bucket) {
+    bucket_begins[bucket] = total;
+    for (size_t segment = 0; segment < segment_num; ++segment) {
+      size_t count = bucket_offsets[segment * bucket_num + bucket];
+      bucket_offsets[segment * bucket_num + bucket] = total;
+      total += count;
+    }
+  }
+  bucket_begins[bucket_num] = total;
+
+  std::vector<size_t> bucket_rows(total);
+  pool.ParallelFor(
+    [&](size_t start, size_t end) {
+      for (size_t segment = start; segment < end; ++segment) {
+        size_t *offsets = bucket_offsets.data() + segment * bucket_num;
+        for (size_t row = segment * segment_size; row < std::min(row_num, (segment + 1) * segment_size); ++row) {
+          int64_t target = get_target(row);
+          if (target >= 0) {
+            bucket_rows[offsets[static_cast<size_t>(target) % bucket_num]++] = row;
+          }
+        }
+      }
+    },
+    segment_num, 1);
+
+  pool.ParallelFor(
+    [&](size_t start, size_t end) {
+      for (size_t bucket = start; bucket < end; ++bucket) {
+        for (size_t i = bucket_begins[bucket]; i < bucket_begins[bucket + 1]; ++i) {
+          size_t row = bucket_rows[i];
+          update_row(row, get_target(row), 0, row_size);
+        }
+      }
+    },
+    bucket_num, 1);
+}
+
+// Applies row_num rows of row_size elements to the target_num rows of an output without atomics: for every row with
+// a target in [0, target_num), update_row(row, target, start, end) updates the columns [start, end) of the target,
+// get_target returns -1 for the rows to skip. The rows of one target are applied in their order, so the result is
+// the same as the serial loop whatever the strategy.
+template <typename GetTarget, typename UpdateRow>
+void ParallelScatterRows(size_t row_num, size_t row_size, size_t target_num, const GetTarget &get_target,
+                         const UpdateRow &update_row) {
+  if (row_num == 0 || row_size == 0) {
+    return;
+  }
+  size_t thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
+  auto strategy = GetScatterStrategy(row_num, row_size, target_num, thread_num);
+  if (strategy == ScatterStrategy::kBucketed) {
+    size_t bucket_num = std::min(target_num, thread_num * kScatterBucketNumPerThread);
+    BucketedScatterRows(row_num, row_size, bucket_num, thread_num, get_target, update_row);
+    return;
+  }
+  auto task = [&](size_t start, size_t end) {
+    for (size_t row = 0; row < row_num; ++row) {
+      int64_t target = get_target(row);
+      if (target >= 0) {
+        update_row(row, target, start, end);
+      }
+    }
+  };
+  if (strategy == ScatterStrategy::kSerial) {
+    task(0, row_size);
+    return;
+  }
+  common::ThreadPool::GetInstance().ParallelFor(task, row_size, kScatterColumnBlockSize);
+}
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_PARALLEL_SCATTER_H_
@@ -0,0 +1,227 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_PARALLEL_TRANSPOSE_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_PARALLEL_TRANSPOSE_H_
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "backend/kernel_compiler/cpu/arithmetic_simd.h"
+#include "common/thread_pool.h"
+
+namespace mindspore {
+namespace kernel {
+// A transpose smaller than this many elements runs on the caller thread.
+constexpr size_t kTransposeParallelMinSize = 16 * 1024;
+// The edge of the tiles of the 2-D transposes, a tile of the input and of the output both stay in the L1 cache.
+constexpr size_t kTransposeTileSize = 32;
+// The elements copied by one task when the innermost axis is not moved.
+constexpr size_t kTransposeCopyBlockSize = 4096;
+
+// Drops the axes of size 1 and merges the runs of input axes that stay next to each other in the output, so that
+// NCHW to NHWC becomes [N, C, HW] with perm [0, 2, 1] and a transpose that moves nothing becomes a copy of rank 1.
+inline void CollapseTransposeDims(const std::vector<size_t> &shape, const std::vector<size_t> &perm,
+                                  std::vector<size_t> *new_shape, std::vector<size_t> *new_perm) {
+  std::vector<size_t> kept_index(shape.size(), 0);
+  size_t kept_num = 0;
+  for (size_t i = 0; i < shape.size(); ++i) {
+    if (shape[i] != 1) {
+      kept_index[i] = kept_num++;
+    }
+  }
+  // The output order of the kept axes, and the input axes of each of them.
+  std::vector<size_t> kept_perm;
+  std::vector<size_t> kept_axes;
+  for (auto axis : perm) {
+    if (shape[axis] != 1) {
+      kept_perm.push_back(kept_index[axis]);
+      kept_axes.push_back(axis);
+    }
+  }
+  // The groups in output order, each the first input axis of a run and its number of elements.
+  std::vector<size_t> group_first;
+  std::vector<size_t> group_size;
+  for (size_t i = 0; i < kept_perm.size(); ++i) {
+    if (i > 0 && kept_perm[i] == kept_perm[i - 1] + 1) {
+      group_size.back() *= shape[kept_axes[i]];
+      continue;
+    }
+    group_first.push_back(kept_perm[i]);
+    group_size.push_back(shape[kept_axes[i]]);
+  }
+  // The new input axes are the groups in input order.
+  std::vector<size_t> input_order(group_first.size());
+  for (size_t i = 0; i < input_order.size(); ++i) {
+    input_order[i] = i;
+  }
+  std::sort(input_order.begin(), input_order.end(),
+            [&group_first](size_t a, size_t b) { return group_first[a] < group_first[b]; });
+  new_shape->assign(group_first.size(), 1);
+  new_perm->assign(group_first.size(), 0);
+  for (size_t i = 0; i < input_order.size(); ++i) {
+    (*new_shape)[i] = group_size[input_order[i]];
+    (*new_perm)[input_order[i]] = i;
+  }
+}
+
+// out[j * out_stride + i] = in[i * in_stride + j] for a tile of rows x cols elements. The 32-bit elements go through
+// the register transpose of the SIMD kernels, the edges and the other types through the scalar loop.
+template <typename T>
+void TransposeTile(const T *in, size_t in_stride, T *out, size_t out_stride, size_t rows, size_t cols) {
+  size_t simd_rows = 0;
+  size_t simd_cols = 0;
+  if (sizeof(T) == sizeof(uint32_t)) {
+    simd_rows = rows / kSimdTransposeBlockSize * kSimdTransposeBlockSize;
+    simd_cols = cols / kSimdTransposeBlockSize * kSimdTransposeBlockSize;
+    if (simd_rows == 0 || simd_cols == 0 ||
+        !SimdTransposeTile32(reinterpret_cast<const uint32_t *>(in), in_stride, reinterpret_cast<uint32_t *>(out),
+                             out_stride, simd_rows, simd_cols)) {
+      simd_rows = 0;
+      simd_cols = 0;
+    }
+  }
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t j = i < simd_rows ? simd_cols : 0; j < cols; ++j) {
+      out[j * out_stride + i] = in[i * in_stride + j];
+    }
+  }
+}
+
+// A transpose of a fixed shape and perm, planned once by the kernel. After CollapseTransposeDims the innermost input
+// axis either stays the innermost output axis, then the rows along it are copied, or it does not, then the two axes
+// that are innermost in the input and in the output are transposed in tiles, for every index of the other axes.
+class TransposePlan {
+ public:
+  TransposePlan() = default;
+  TransposePlan(const std::vector<size_t> &shape, const std::vector<size_t> &perm) {
+    CollapseTransposeDims(shape, perm, &shape_, &perm_);
+    size_t rank = shape_.size();
+    in_strides_.assign(rank, 1);
+    out_strides_.assign(rank, 1);
+    for (size_t i = rank; i > 1; --i) {
+      in_strides_[i - 2] = in_strides_[i - 1] * shape_[i - 1];
+    }
+    size_t out_stride = 1;
+    for (size_t i = rank; i > 0; --i) {
+      out_strides_[perm_[i - 1]] = out_stride;
+      out_stride *= shape_[perm_[i - 1]];
+    }
+    size_ = out_stride;
+    if (rank == 0) {
+      return;
+    }
+    tiled_ = perm_[rank - 1] != rank - 1;
+    row_axis_ = perm_[rank - 1];
+    col_axis_ = rank - 1;
+    // The other axes in output order, the innermost last.
+    for (auto axis : perm_) {
+      if (axis != col_axis_ && axis != row_axis_) {
+        outer_axes_.push_back(axis);
+      }
+    }
+  }
+  ~TransposePlan() = default;
+
+  template <typename T>
+  void Run(const T *input, T *output) const {
+    if (size_ == 0) {
+      return;
+    }
+    if (!tiled_) {
+      CopyRows(input, output);
+      return;
+    }
+    size_t rows = shape_[row_axis_];
+    size_t cols = shape_[col_axis_];
+    size_t row_tiles = (rows + kTransposeTileSize - 1) / kTransposeTileSize;
+    size_t col_tiles = (cols + kTransposeTileSize - 1) / kTransposeTileSize;
+    size_t tile_num = row_tiles * col_tiles;
+    auto task = [&](size_t start, size_t end) {
+      for (size_t task_id = start; task_id < end; ++task_id) {
+        size_t in_offset = 0;
+        size_t out_offset = 0;
+        GetOuterOffsets(task_id / tile_num, &in_offset, &out_offset);
+        size_t row = task_id % tile_num / col_tiles * kTransposeTileSize;
+        size_t col = task_id % col_tiles * kTransposeTileSize;
+        TransposeTile(input + in_offset + row * in_strides_[row_axis_] + col, in_strides_[row_axis_],
+                      output + out_offset + col * out_strides_[col_axis_] + row, out_strides_[col_axis_],
+                      std::min(kTransposeTileSize, rows - row), std::min(kTransposeTileSize, cols - col));
+      }
+    };
+    size_t task_num = size_ / (rows * cols) * tile_num;
+    if (size_ < kTransposeParallelMinSize) {
+      task(0, task_num);
+      return;
+    }
+    common::ThreadPool::GetInstance().ParallelFor(task, task_num, 1);
+  }
+
+  const std::vector<size_t> &shape() const { return shape_; }
+  const std::vector<size_t> &perm() const { return perm_; }
+
+ private:
+  // The output is a sequence of rows of the innermost input axis, or a plain copy of the input.
+  template <typename T>
+  void CopyRows(const T *input, T *output) const {
+    size_t row_size = shape_.empty() ? size_ : shape_.back();
+    size_t row_num = size_ / row_size;
+    if (row_num == 1) {
+      common::ThreadPool::GetInstance().ParallelFor(
+        [&](size_t start, size_t end) { std::copy(input + start, input + end, output + start); }, size_,
+        kTransposeCopyBlockSize);
+      return;
+    }
+    auto task = [&](size_t start, size_t end) {
+      for (size_t row = start; row < end; ++row) {
+        size_t in_offset = 0;
+        size_t out_offset = 0;
+        GetOuterOffsets(row, &in_offset, &out_offset);
+        std::copy(input + in_offset, input + in_offset + row_size, output + out_offset);
+      }
+    };
+    if (size_ < kTransposeParallelMinSize) {
+      task(0, row_num);
+      return;
+    }
+    size_t grain = std::max<size_t>(1, kTransposeCopyBlockSize / row_size);
+    common::ThreadPool::GetInstance().ParallelFor(task, row_num, grain);
+  }
+
+  // The offsets in the input and in the output of the index-th combination of the outer axes.
+  void GetOuterOffsets(size_t index, size_t *in_offset, size_t *out_offset) const {
+    for (size_t i = outer_axes_.size(); i > 0; --i) {
+      size_t axis = outer_axes_[i - 1];
+      size_t position = index % shape_[axis];
+      index /= shape_[axis];
+      *in_offset += position * in_strides_[axis];
+      *out_offset += position * out_strides_[axis];
+    }
+  }
+
+  std::vector<size_t> shape_;
+  std::vector<size_t> perm_;
+  std::vector<size_t> in_strides_;
+  // The stride in the output of each input axis.
+  std::vector<size_t> out_strides_;
+  std::vector<size_t> outer_axes_;
+  // The input axes transposed in tiles, when the innermost axis moves, or both the innermost axis.
+  bool tiled_{false};
+  size_t row_axis_{0};
+  size_t col_axis_{0};
+  size_t size_{0};
+};
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_PARALLEL_TRANSPOSE_H_
@@ -0,0 +1,153 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_PHILOX_RANDOM_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_PHILOX_RANDOM_H_
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include "common/thread_pool.h"
+
+namespace mindspore {
+namespace kernel {
+// The numbers of one counter of the generator.
+constexpr size_t kPhiloxResultSize = 4;
+// The counters generated together, the rounds of a batch are independent so the compiler can vectorize them.
+constexpr size_t kPhiloxBatchSize = 8;
+// The counters of one parallel task of PhiloxParallelFor.
+constexpr size_t kPhiloxParallelBlockSize = 256;
+
+// The counter-based Philox4x32-10 generator of Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3". The
+// numbers of a counter only depend on the seed and the counter, so any part of a stream can be generated on any
+// thread, or generated again later, without running the generator up to it.
+class PhiloxRandom {
+ public:
+  // The counter is 128 bits, counter_high is only set by the known answer tests of the reference implementation.
+  PhiloxRandom(uint64_t seed, uint64_t counter, uint64_t counter_high = 0)
+      : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+        counter_(counter),
+        counter_high_(counter_high) {}
+  ~PhiloxRandom() = default;
+
+  // Writes the kPhiloxResultSize numbers of each of the next count counters to out.
+  void Generate(uint32_t *out, size_t count) {
+    for (size_t start = 0; start < count; start += kPhiloxBatchSize) {
+      size_t batch = std::min(kPhiloxBatchSize, count - start);
+      uint32_t c0[kPhiloxBatchSize];
+      uint32_t c1[kPhiloxBatchSize];
+      uint32_t c2[kPhiloxBatchSize];
+      uint32_t c3[kPhiloxBatchSize];
+      for (size_t i = 0; i < kPhiloxBatchSize; ++i) {
+        uint64_t counter = counter_ + start + i;
+        c0[i] = static_cast<uint32_t>(counter);
+        c1[i] = static_cast<uint32_t>(counter >> 32);
+        c2[i] = static_cast<uint32_t>(counter_high_);
+        c3[i] = static_cast<uint32_t>(counter_high_ >> 32);
+      }
+      uint32_t k0 = key_[0];
+      uint32_t k1 = key_[1];
+      for (int round = 0; round < kRoundNum; ++round) {
+        for (size_t i = 0; i < kPhiloxBatchSize; ++i) {
+          uint64_t product0 = static_cast<uint64_t>(kMultiplier0) * c0[i];
+          uint64_t product1 = static_cast<uint64_t>(kMultiplier1) * c2[i];
+          uint32_t next0 = static_cast<uint32_t>(product1 >> 32) ^ c1[i] ^ k0;
+          uint32_t next2 = static_cast<uint32_t>(product0 >> 32) ^ c3[i] ^ k1;
+          c1[i] = static_cast<uint32_t>(product1);
+          c3[i] = static_cast<uint32_t>(product0);
+          c0[i] = next0;
+          c2[i] = next2;
+        }
+        k0 += kWeyl0;
+        k1 += kWeyl1;
+      }
+      for (size_t i = 0; i < batch; ++i) {
+        uint32_t *result = out + (start + i) * kPhiloxResultSize;
+        result[0] = c0[i];
+        result[1] = c1[i];
+        result[2] = c2[i];
+        result[3] = c3[i];
+      }
+    }
+    counter_ += count;
+  }
+
+ private:
+  static constexpr int kRoundNum = 10;
+  static constexpr uint32_t kMultiplier0 = 0xD2511F53;
+  static constexpr uint32_t kMultiplier1 = 0xCD9E8D57;
+  static constexpr uint32_t kWeyl0 = 0x9E3779B9;
+  static constexpr uint32_t kWeyl1 = 0xBB67AE85;
+
+  uint32_t key_[2];
+  uint64_t counter_;
+  uint64_t counter_high_;
+};
+
+// What a random kernel passes on to regenerate its numbers: the seed and the first counter of its launch.
+struct PhiloxState {
+  uint64_t seed;
+  uint64_t counter;
+};
+constexpr size_t kPhiloxStateSize = sizeof(PhiloxState) / sizeof(uint64_t);
+
+// A float in [0, 1) from the 24 high bits of x.
+inline float PhiloxUniform(uint32_t x) { return static_cast<float>(x >> 8) * (1.0f / (1 << 24)); }
+
+// Two standard normal floats from two numbers, by the Box-Muller transform.
+inline void PhiloxNormal(uint32_t x0, uint32_t x1, float *out0, float *out1) {
+  constexpr float kTwoPi = 6.283185307179586f;
+  // 1 - u is in (0, 1], the log is finite.
+  float radius = std::sqrt(-2.0f * std::log(1.0f - PhiloxUniform(x0)));
+  float theta = kTwoPi * PhiloxUniform(x1);
+  *out0 = radius * std::cos(theta);
+  *out1 = radius * std::sin(theta);
+}
+
+// Runs func(index, numbers) in parallel for the counters counter + index, index in [0, count), numbers being the
+// kPhiloxResultSize numbers of the counter. Every counter gets the same numbers whatever the number of threads.
+template <typename Func>
+void PhiloxParallelFor(uint64_t seed, uint64_t counter, size_t count, const Func &func) {
+  auto task = [seed, counter, &func](size_t start, size_t end) {
+    PhiloxRandom random(seed, counter + start);
+    uint32_t numbers[kPhiloxBatchSize * kPhiloxResultSize];
+    for (size_t i = start; i < end; i += kPhiloxBatchSize) {
+      size_t batch = std::min(kPhiloxBatchSize, end - i);
+      random.Generate(numbers, batch);
+      for (size_t j = 0; j < batch; ++j) {
+        func(i + j, numbers + j * kPhiloxResultSize);
+      }
+    }
+  };
+  common::ThreadPool::GetInstance().ParallelFor(task, count, kPhiloxParallelBlockSize);
+}
+
+// Runs func(index, keep) in parallel for the index in [0, count), keep being true with probability keep_prob. The
+// element index uses the number index % kPhiloxResultSize of the counter counter + index / kPhiloxResultSize.
+template <typename Func>
+void PhiloxBernoulliParallelFor(uint64_t seed, uint64_t counter, size_t count, float keep_prob, const Func &func) {
+  // x < threshold with the probability threshold / 2^32, a keep_prob of 1 keeps everything.
+  auto threshold = static_cast<uint64_t>(static_cast<double>(keep_prob) * 4294967296.0);
+  size_t counter_num = (count + kPhiloxResultSize - 1) / kPhiloxResultSize;
+  PhiloxParallelFor(seed, counter, counter_num, [count, threshold, &func](size_t index, const uint32_t *numbers) {
+    size_t start = index * kPhiloxResultSize;
+    size_t end = std::min(start + kPhiloxResultSize, count);
+    for (size_t i = start; i < end; ++i) {
+      func(i, numbers[i - start] < threshold);
+    }
+  });
+}
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_PHILOX_RANDOM_H_
@@ -13,21 +13,16 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <random>
-#include <thread>
+#include "backend/kernel_compiler/cpu/philox_random.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "backend/kernel_compiler/cpu/random_cpu_kernel.h"
 
 namespace mindspore {
 namespace kernel {
-void StandardNormal(float *output, std::normal_distribution<float> distribution,
-                    std::default_random_engine random_generator, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    output[i] = distribution(random_generator);
-  }
-}
 void LaunchStandardNormal(int seed, int seed2, const std::vector<AddressPtr> &outputs) {
-  unsigned int RNG_seed;
+  uint64_t RNG_seed;
   std::random_device rd;
   if (seed2 != 0) {
     RNG_seed = IntToUint(seed2);
@@ -38,33 +33,19 @@ void LaunchStandardNormal(int seed, int seed2, const std::vector<AddressPtr> &ou
   }
 
   auto output = reinterpret_cast<float *>(outputs[0]->addr);
-  // multithreading
   size_t lens = outputs[0]->size / sizeof(float);
-  auto max_thread_num = std::thread::hardware_concurrency();
-  size_t thread_num = lens < 128 * max_thread_num ? std::ceil(lens / 128.0) : max_thread_num;
-  if (thread_num < 1) {
-    MS_LOG(ERROR) << "Invalid value: thread_num " << thread_num;
-    return;
-  }
-  std::vector<std::thread> threads;
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t once_compute_size = (lens + thread_num - 1) / thread_num;
-  if (once_compute_size < 1) {
-    MS_LOG(ERROR) << "Invalid value: once_compute_size " << once_compute_size;
-    return;
-  }
-  std::normal_distribution<float> distribution;
-  while (start < lens) {
-    // avoid different threads using the same seed to generate the same random number
-    std::default_random_engine random_generator(++RNG_seed);
-    size_t end = (start + once_compute_size) > lens ? lens : (start + once_compute_size);
-    threads.emplace_back(std::thread(StandardNormal, output, distribution, random_generator, start, end));
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
-  }
+  // Every counter gives the 4 normal numbers of its elements, so the output does not depend on the thread number.
+  size_t counter_num = (lens + kPhiloxResultSize - 1) / kPhiloxResultSize;
+  PhiloxParallelFor(RNG_seed, 0, counter_num, [output, lens](size_t index, const uint32_t *numbers) {
+    float normal[kPhiloxResultSize];
+    PhiloxNormal(numbers[0], numbers[1], &normal[0], &normal[1]);
+    PhiloxNormal(numbers[2], numbers[3], &normal[2], &normal[3]);
+    size_t start = index * kPhiloxResultSize;
+    size_t end = std::min(start + kPhiloxResultSize, lens);
+    for (size_t i = start; i < end; ++i) {
+      output[i] = normal[i - start];
+    }
+  });
 }
 
 void RandomCPUKernel::InitKernel(const CNodePtr &kernel_node) {
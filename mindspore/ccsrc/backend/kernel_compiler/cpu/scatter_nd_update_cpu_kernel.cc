@@ -17,38 +17,10 @@
 #include "backend/kernel_compiler/cpu/scatter_nd_update_cpu_kernel.h"
 #include <string>
 #include "runtime/device/cpu/cpu_device_address.h"
-#include "common/thread_pool.h"
+#include "backend/kernel_compiler/cpu/parallel_scatter.h"
 
 namespace mindspore {
 namespace kernel {
-namespace {
-template <typename T>
-void Compute(const ComputeParams<T> *params, const size_t start, const size_t end) {
-  MS_EXCEPTION_IF_NULL(params);
-  T *x = params->x_;
-  int *indices = params->indices_;
-  T *updates = params->updates_;
-  std::vector<int> *out_strides = params->out_strides_;
-  MS_EXCEPTION_IF_NULL(out_strides);
-
-  for (size_t i = start; i < end; ++i) {
-    int offset = 0;
-    for (int j = 0; j < params->indices_unit_rank_; ++j) {
-      auto index = indices[i * params->indices_unit_rank_ + j];
-      if (index < 0) {
-        MS_LOG(EXCEPTION) << "Error, Indices exist element which less than 0. element=" << index;
-      }
-      offset += index * out_strides->at(j) * params->unit_size_;
-    }
-    auto ret =
-      memcpy_s(x + offset, params->x_mem_size_, updates + params->unit_size_ * i, params->unit_size_ * sizeof(T));
-    if (ret != 0) {
-      MS_LOG(EXCEPTION) << "memcpy_s error, errorno" << ret;
-    }
-  }
-}
-}  // namespace
-
 void ScatterNdUpdateCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   Check(kernel_node);
   auto shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
@@ -79,12 +51,13 @@ void ScatterNdUpdateCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   for (int i = SizeToInt(indices_shape.size()) - 3; i >= 0; i--) {
     num_units_ *= updates_shape[i];
   }
-  int out_stride = 1;
-  out_strides_.push_back(out_stride);
+  // out_strides_[i] is the number of units between two consecutive values of the index i.
+  out_strides_.assign(indices_unit_rank, 1);
+  out_shape_.assign(shape.begin(), shape.begin() + indices_unit_rank);
   for (int i = indices_unit_rank_ - 2; i >= 0; i--) {
-    out_stride *= shape[i + 1];
-    out_strides_.push_back(out_stride);
+    out_strides_[i] = out_strides_[i + 1] * shape[i + 1];
   }
+  num_out_units_ = indices_unit_rank == 0 ? 1 : out_strides_[0] * shape[0];
   dtype_ = AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 0);
 }
 
@@ -106,29 +79,32 @@ template <typename T>
 void ScatterNdUpdateCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs,
                                             const std::vector<kernel::AddressPtr> &outputs) {
   auto x = reinterpret_cast<T *>(inputs[0]->addr);
-  ComputeParams<T> params;
-  params.x_ = x;
-  params.indices_ = reinterpret_cast<int *>(inputs[1]->addr);
-  params.updates_ = reinterpret_cast<T *>(inputs[2]->addr);
-  params.x_mem_size_ = inputs[0]->size;
-  params.unit_size_ = unit_size_;
-  params.indices_unit_rank_ = indices_unit_rank_;
-  params.out_strides_ = &out_strides_;
-
-  std::vector<common::Task> tasks;
-  size_t start = 0;
-  auto max_thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
-  size_t once_compute_size = (num_units_ + max_thread_num - 1) / max_thread_num;
-  while (start < num_units_) {
-    size_t end = (start + once_compute_size) > num_units_ ? num_units_ : (start + once_compute_size);
-    auto task = [&params, start, end]() -> int {
-      Compute<T>(&params, start, end);
-      return common::SUCCESS;
-    };
-    tasks.emplace_back(task);
-    start += once_compute_size;
-  }
-  common::ThreadPool::GetInstance().SyncRun(tasks);
+  auto indices = reinterpret_cast<int *>(inputs[1]->addr);
+  auto updates = reinterpret_cast<T *>(inputs[2]->addr);
+  size_t unit_size = IntToSize(unit_size_);
+  size_t x_size = inputs[0]->size / sizeof(T);
+  auto get_out_unit = [this, indices](size_t unit) -> int64_t {
+    size_t offset = 0;
+    for (int j = 0; j < indices_unit_rank_; ++j) {
+      auto index = indices[unit * indices_unit_rank_ + j];
+      if (index < 0 || IntToSize(index) >= out_shape_[j]) {
+        MS_LOG(EXCEPTION) << "Error, Indices exist element which is out of range [0, " << out_shape_[j]
+                          << "). element=" << index;
+      }
+      offset += IntToSize(index) * out_strides_[j];
+    }
+    return SizeToLong(offset);
+  };
+  // The duplicated indices are written in their order, the last update wins as in the serial loop.
+  auto update_unit = [x, updates, x_size, unit_size](size_t unit, int64_t out_unit, size_t start, size_t end) {
+    size_t offset = LongToSize(out_unit) * unit_size + start;
+    auto ret = memcpy_s(x + offset, (x_size - offset) * sizeof(T), updates + unit * unit_size + start,
+                        (end - start) * sizeof(T));
+    if (ret != 0) {
+      MS_LOG(EXCEPTION) << "memcpy_s error, errorno" << ret;
+    }
+  };
+  ParallelScatterRows(num_units_, unit_size, num_out_units_, get_out_unit, update_unit);
 
   auto ret = memcpy_s(outputs[0]->addr, outputs[0]->size, x, inputs[0]->size);
   if (ret != 0) {
@@ -24,17 +24,6 @@
 
 namespace mindspore {
 namespace kernel {
-template <typename T>
-struct ComputeParams {
-  T *x_{nullptr};
-  int *indices_{nullptr};
-  T *updates_{nullptr};
-  int unit_size_{0};
-  int indices_unit_rank_{0};
-  std::vector<int> *out_strides_{nullptr};
-  size_t x_mem_size_{0};
-};
-
 class ScatterNdUpdateCPUKernel : public CPUKernel {
  public:
   ScatterNdUpdateCPUKernel() = default;
@@ -54,7 +43,9 @@ class ScatterNdUpdateCPUKernel : public CPUKernel {
   int unit_size_{0};
   size_t num_units_{0};
   int indices_unit_rank_{0};
-  std::vector<int> out_strides_;
+  std::vector<size_t> out_shape_;
+  std::vector<size_t> out_strides_;
+  size_t num_out_units_{0};
 };
 
 MS_REG_CPU_KERNEL(ScatterNdUpdate,
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/sparse_dense_matmul_cpu_kernel.h"
+#include <string>
+#include "backend/kernel_compiler/cpu/sparse_matmul.h"
+#include "runtime/device/cpu/cpu_device_address.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr size_t kCOOIndicesRank = 2;
+constexpr size_t kMatrixRank = 2;
+}  // namespace
+
+void SparseDenseMatmulCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
+  is_csr_ = kernel_name == prim::kPrimCSRSparseDenseMatmul->name() ||
+            kernel_name == prim::kPrimCSRSparseDenseMatmulGrad->name();
+  is_grad_ = kernel_name == prim::kPrimSparseTensorDenseMatmulGrad->name() ||
+             kernel_name == prim::kPrimCSRSparseDenseMatmulGrad->name();
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+  size_t values_index = is_csr_ ? 2 : 1;
+  if (input_num != values_index + 2) {
+    MS_LOG(EXCEPTION) << "Input number is " << input_num << ", but " << kernel_name << " needs " << values_index + 2
+                      << " inputs.";
+  }
+  adjoint_st_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, "adjoint_st");
+  index_type_ = AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 0);
+
+  auto indices_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, is_csr_ ? 1 : 0);
+  if (indices_shape.empty() || (!is_csr_ && (indices_shape.size() != kCOOIndicesRank || indices_shape[1] != 2))) {
+    MS_LOG(EXCEPTION) << kernel_name << " needs indices of shape [nnz, 2] for COO or [nnz] for CSR.";
+  }
+  nnz_ = indices_shape[0];
+  auto dense_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, values_index + 1);
+  auto out_shape = is_grad_ ? AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, values_index)
+                            : AnfAlgo::GetOutputInferShape(kernel_node, 0);
+  if (dense_shape.size() != kMatrixRank || out_shape.size() != kMatrixRank || dense_shape[1] != out_shape[1]) {
+    MS_LOG(EXCEPTION) << kernel_name << " needs a 2-D dense matrix with the columns of the output.";
+  }
+  in_row_num_ = dense_shape[0];
+  out_row_num_ = out_shape[0];
+  col_num_ = dense_shape[1];
+  if (is_csr_) {
+    auto indptr_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+    if (indptr_shape.size() != 1 || indptr_shape[0] == 0) {
+      MS_LOG(EXCEPTION) << kernel_name << " needs an indptr of shape [rows + 1].";
+    }
+    csr_row_num_ = indptr_shape[0] - 1;
+    size_t expect_row_num = adjoint_st_ ? in_row_num_ : out_row_num_;
+    if (csr_row_num_ != expect_row_num) {
+      MS_LOG(EXCEPTION) << "The sparse matrix of " << kernel_name << " has " << csr_row_num_ << " rows, but "
+                        << expect_row_num << " are expected.";
+    }
+  }
+}
+
+template <typename I>
+void SparseDenseMatmulCPUKernel::GetEntryPositions(const std::vector<AddressPtr> &inputs, std::vector<size_t> *rows,
+                                                   std::vector<size_t> *cols) const {
+  size_t row_num = adjoint_st_ ? in_row_num_ : out_row_num_;
+  size_t col_num = adjoint_st_ ? out_row_num_ : in_row_num_;
+  rows->resize(nnz_);
+  cols->resize(nnz_);
+  if (is_csr_) {
+    auto indptr = reinterpret_cast<I *>(inputs[0]->addr);
+    auto indices = reinterpret_cast<I *>(inputs[1]->addr);
+    if (indptr[0] != 0 || static_cast<size_t>(indptr[csr_row_num_]) != nnz_) {
+      MS_LOG(EXCEPTION) << "The indptr of the CSR matrix must start at 0 and end at " << nnz_ << ".";
+    }
+    for (size_t r = 0; r < csr_row_num_; ++r) {
+      if (indptr[r + 1] < indptr[r]) {
+        MS_LOG(EXCEPTION) << "The indptr of the CSR matrix must not decrease.";
+      }
+      for (auto e = static_cast<size_t>(indptr[r]); e < static_cast<size_t>(indptr[r + 1]); ++e) {
+        (*rows)[e] = r;
+      }
+    }
+    for (size_t e = 0; e < nnz_; ++e) {
+      if (indices[e] < 0 || static_cast<size_t>(indices[e]) >= col_num) {
+        MS_LOG(EXCEPTION) << "The column " << indices[e] << " of the CSR matrix is out of range [0, " << col_num
+                          << ").";
+      }
+      (*cols)[e] = static_cast<size_t>(indices[e]);
+    }
+    return;
+  }
+  auto indices = reinterpret_cast<I *>(inputs[0]->addr);
+  for (size_t e = 0; e < nnz_; ++e) {
+    I row = indices[e * 2];
+    I col = indices[e * 2 + 1];
+    if (row < 0 || static_cast<size_t>(row) >= row_num || col < 0 || static_cast<size_t>(col) >= col_num) {
+      MS_LOG(EXCEPTION) << "The index [" << row << ", " << col << "] of the sparse matrix is out of range [" << row_num
+                        << ", " << col_num << "].";
+    }
+    (*rows)[e] = static_cast<size_t>(row);
+    (*cols)[e] = static_cast<size_t>(col);
+  }
+}
+
+template <typename I>
+void SparseDenseMatmulCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs,
+                                              const std::vector<AddressPtr> &outputs) {
+  std::vector<size_t> rows;
+  std::vector<size_t> cols;
+  GetEntryPositions<I>(inputs, &rows, &cols);
+  // The entries are accumulated into the rows of the output along the rows of A, or along its columns for A^T.
+  const auto &out_rows = adjoint_st_ ? cols : rows;
+  const auto &in_rows = adjoint_st_ ? rows : cols;
+  size_t values_index = is_csr_ ? 2 : 1;
+  auto values = reinterpret_cast<float *>(inputs[values_index]->addr);
+  auto dense = reinterpret_cast<float *>(inputs[values_index + 1]->addr);
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  if (is_grad_) {
+    SparseValuesGrad(out_rows, in_rows, values, dense, col_num_, output);
+    return;
+  }
+  SparseRowIndex index;
+  if (is_csr_ && !adjoint_st_) {
+    // The entries of a CSR matrix are already grouped by row.
+    auto indptr = reinterpret_cast<I *>(inputs[0]->addr);
+    index.indptr.assign(indptr, indptr + csr_row_num_ + 1);
+  } else {
+    GroupSparseRows(out_rows, out_row_num_, &index);
+  }
+  SparseRowsMatmul(index, in_rows, values, dense, col_num_, output);
+}
+
+bool SparseDenseMatmulCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                        const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                        const std::vector<kernel::AddressPtr> &outputs) {
+  if (index_type_ == kNumberTypeInt32) {
+    LaunchKernel<int32_t>(inputs, outputs);
+  } else if (index_type_ == kNumberTypeInt64) {
+    LaunchKernel<int64_t>(inputs, outputs);
+  } else {
+    MS_LOG(EXCEPTION) << "The indices of the sparse matrix must be int32 or int64, but got "
+                      << TypeIdLabel(index_type_);
+  }
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
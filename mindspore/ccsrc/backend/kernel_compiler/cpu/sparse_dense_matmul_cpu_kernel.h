@@ -0,0 +1,122 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_SPARSE_DENSE_MATMUL_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_SPARSE_DENSE_MATMUL_CPU_KERNEL_H_
+#include <vector>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+
+namespace mindspore {
+namespace kernel {
+// The product of a sparse matrix A in COO or CSR format and a dense matrix B, A * B or A^T * B when adjoint_st, and
+// the gradient of the values of A. The gradient of B is the product with the other adjoint_st. The inputs are
+//   SparseTensorDenseMatmul: indices [nnz, 2], values [nnz], dense
+//   SparseTensorDenseMatmulGrad: indices [nnz, 2], dout, dense
+//   CSRSparseDenseMatmul: indptr [rows + 1], indices [nnz], values [nnz], dense
+//   CSRSparseDenseMatmulGrad: indptr [rows + 1], indices [nnz], dout, dense
+class SparseDenseMatmulCPUKernel : public CPUKernel {
+ public:
+  SparseDenseMatmulCPUKernel() = default;
+  ~SparseDenseMatmulCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  template <typename I>
+  void LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
+  // The row of A and the column of A of every entry, checked against the shapes.
+  template <typename I>
+  void GetEntryPositions(const std::vector<AddressPtr> &inputs, std::vector<size_t> *rows,
+                         std::vector<size_t> *cols) const;
+
+  bool is_csr_{false};
+  bool is_grad_{false};
+  bool adjoint_st_{false};
+  TypeId index_type_{kTypeUnknown};
+  size_t nnz_{0};
+  size_t csr_row_num_{0};
+  // The rows of the output or of dout, the rows of dense, and the columns of both.
+  size_t out_row_num_{0};
+  size_t in_row_num_{0};
+  size_t col_num_{0};
+};
+
+MS_REG_CPU_KERNEL(SparseTensorDenseMatmul,
+                  KernelAttr()
+                    .AddInputAttr(kNumberTypeInt32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddOutputAttr(kNumberTypeFloat32),
+                  SparseDenseMatmulCPUKernel);
+MS_REG_CPU_KERNEL(SparseTensorDenseMatmul,
+                  KernelAttr()
+                    .AddInputAttr(kNumberTypeInt64)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddOutputAttr(kNumberTypeFloat32),
+                  SparseDenseMatmulCPUKernel);
+MS_REG_CPU_KERNEL(SparseTensorDenseMatmulGrad,
+                  KernelAttr()
+                    .AddInputAttr(kNumberTypeInt32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddOutputAttr(kNumberTypeFloat32),
+                  SparseDenseMatmulCPUKernel);
+MS_REG_CPU_KERNEL(SparseTensorDenseMatmulGrad,
+                  KernelAttr()
+                    .AddInputAttr(kNumberTypeInt64)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddOutputAttr(kNumberTypeFloat32),
+                  SparseDenseMatmulCPUKernel);
+MS_REG_CPU_KERNEL(CSRSparseDenseMatmul,
+                  KernelAttr()
+                    .AddInputAttr(kNumberTypeInt32)
+                    .AddInputAttr(kNumberTypeInt32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddOutputAttr(kNumberTypeFloat32),
+                  SparseDenseMatmulCPUKernel);
+MS_REG_CPU_KERNEL(CSRSparseDenseMatmul,
+                  KernelAttr()
+                    .AddInputAttr(kNumberTypeInt64)
+                    .AddInputAttr(kNumberTypeInt64)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddOutputAttr(kNumberTypeFloat32),
+                  SparseDenseMatmulCPUKernel);
+MS_REG_CPU_KERNEL(CSRSparseDenseMatmulGrad,
+                  KernelAttr()
+                    .AddInputAttr(kNumberTypeInt32)
+                    .AddInputAttr(kNumberTypeInt32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddOutputAttr(kNumberTypeFloat32),
+                  SparseDenseMatmulCPUKernel);
+MS_REG_CPU_KERNEL(CSRSparseDenseMatmulGrad,
+                  KernelAttr()
+                    .AddInputAttr(kNumberTypeInt64)
+                    .AddInputAttr(kNumberTypeInt64)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddInputAttr(kNumberTypeFloat32)
+                    .AddOutputAttr(kNumberTypeFloat32),
+                  SparseDenseMatmulCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_SPARSE_DENSE_MATMUL_CPU_KERNEL_H_
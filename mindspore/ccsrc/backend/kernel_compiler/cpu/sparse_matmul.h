@@ -0,0 +1,110 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_SPARSE_MATMUL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_SPARSE_MATMUL_H_
+#include <algorithm>
+#include <vector>
+#include "backend/kernel_compiler/cpu/arithmetic_simd.h"
+#include "common/thread_pool.h"
+
+namespace mindspore {
+namespace kernel {
+// The multiply-adds of one task of the sparse matmul and of the gradient of its values.
+constexpr size_t kSparseMatmulBlockSize = 16 * 1024;
+
+// The entries of a sparse matrix grouped by the output row they are accumulated into. The entries of the row r are
+// order[indptr[r]], ..., order[indptr[r + 1] - 1], in the order of the input, or indptr[r], ... when order is empty.
+struct SparseRowIndex {
+  std::vector<size_t> indptr;
+  std::vector<size_t> order;
+};
+
+// Groups the entries by row with a counting sort, every row is below row_num.
+inline void GroupSparseRows(const std::vector<size_t> &rows, size_t row_num, SparseRowIndex *index) {
+  index->indptr.assign(row_num + 1, 0);
+  for (auto row : rows) {
+    index->indptr[row + 1]++;
+  }
+  for (size_t r = 0; r < row_num; ++r) {
+    index->indptr[r + 1] += index->indptr[r];
+  }
+  std::vector<size_t> next(index->indptr.begin(), index->indptr.end() - 1);
+  index->order.resize(rows.size());
+  for (size_t e = 0; e < rows.size(); ++e) {
+    index->order[next[rows[e]]++] = e;
+  }
+}
+
+// y[i] += alpha * x[i].
+template <typename T>
+void SparseAxpy(T alpha, const T *x, T *y, size_t count) {
+  for (size_t i = SimdAxpy<T>(alpha, x, y, count); i < count; ++i) {
+    y[i] += alpha * x[i];
+  }
+}
+
+// The sum of a[i] * b[i].
+template <typename T>
+T SparseDot(const T *a, const T *b, size_t count) {
+  T result = static_cast<T>(0);
+  for (size_t i = SimdDot<T>(a, b, count, &result); i < count; ++i) {
+    result += a[i] * b[i];
+  }
+  return result;
+}
+
+// output[r] = sum of values[e] * dense[in_rows[e]] over the entries e of the row r, for rows of col_num elements. The
+// rows are split over the threads, every row is written by one thread so no atomics are needed.
+template <typename T>
+void SparseRowsMatmul(const SparseRowIndex &index, const std::vector<size_t> &in_rows, const T *values,
+                      const T *dense, size_t col_num, T *output) {
+  size_t row_num = index.indptr.size() - 1;
+  if (row_num == 0 || col_num == 0) {
+    return;
+  }
+  auto task = [&](size_t start, size_t end) {
+    for (size_t r = start; r < end; ++r) {
+      T *out_row = output + r * col_num;
+      std::fill(out_row, out_row + col_num, static_cast<T>(0));
+      for (size_t i = index.indptr[r]; i < index.indptr[r + 1]; ++i) {
+        size_t e = index.order.empty() ? i : index.order[i];
+        SparseAxpy(values[e], dense + in_rows[e] * col_num, out_row, col_num);
+      }
+    }
+  };
+  // The rows of a task have about kSparseMatmulBlockSize multiply-adds on average, the work stealing of the pool
+  // evens out the rows of the graphs with a skewed degree.
+  size_t row_work = (in_rows.size() / row_num + 1) * col_num;
+  size_t grain = std::max<size_t>(1, kSparseMatmulBlockSize / row_work);
+  common::ThreadPool::GetInstance().ParallelFor(task, row_num, grain);
+}
+
+// values_grad[e] = dout[out_rows[e]] . dense[in_rows[e]], the gradient of the values of SparseRowsMatmul: the inner
+// product of the rows of the two dense matrices at the positions of the entries.
+template <typename T>
+void SparseValuesGrad(const std::vector<size_t> &out_rows, const std::vector<size_t> &in_rows, const T *dout,
+                      const T *dense, size_t col_num, T *values_grad) {
+  auto task = [&](size_t start, size_t end) {
+    for (size_t e = start; e < end; ++e) {
+      values_grad[e] = SparseDot(dout + out_rows[e] * col_num, dense + in_rows[e] * col_num, col_num);
+    }
+  };
+  size_t grain = std::max<size_t>(1, kSparseMatmulBlockSize / std::max<size_t>(1, col_num));
+  common::ThreadPool::GetInstance().ParallelFor(task, out_rows.size(), grain);
+}
+}  // namespace kernel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_SPARSE_MATMUL_H_
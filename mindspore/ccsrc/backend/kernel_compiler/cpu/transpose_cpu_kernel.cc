@@ -19,16 +19,27 @@
 #include "runtime/device/cpu/cpu_device_address.h"
 namespace mindspore {
 namespace kernel {
-const size_t kMaxDim = 100;
 void TransposeCPUFwdKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   shape_ = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
   std::vector<int64_t> axis_me = AnfAlgo::GetNodeAttr<std::vector<int64_t>>(kernel_node, "perm");
-  (void)std::transform(axis_me.begin(), axis_me.end(), std::back_inserter(axis_),
-                       [](const int64_t &value) { return static_cast<int>(value); });
-  if (shape_.size() != axis_.size()) {
+  if (shape_.size() != axis_me.size()) {
     MS_LOG(EXCEPTION) << "The size of input shape and transpose axis shape must be equal.";
   }
+  auto rank = SizeToLong(shape_.size());
+  std::vector<bool> seen(shape_.size(), false);
+  for (auto axis : axis_me) {
+    if (axis < -rank || axis >= rank) {
+      MS_LOG(EXCEPTION) << "The transpose axis " << axis << " is out of range for a " << rank << "-D input.";
+    }
+    size_t index = LongToSize(axis < 0 ? axis + rank : axis);
+    if (seen[index]) {
+      MS_LOG(EXCEPTION) << "The transpose axis " << axis << " appears more than once in perm.";
+    }
+    seen[index] = true;
+    axis_.push_back(index);
+  }
+  plan_ = TransposePlan(shape_, axis_);
   dtype_ = AnfAlgo ::GetPrevNodeOutputDeviceDataType(kernel_node, 0);
   if (dtype_ == kTypeUnknown) {
     dtype_ = AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 0);
@@ -58,32 +69,7 @@ void TransposeCPUFwdKernel::LaunchKernel(const std::vector<AddressPtr> &inputs,
                                          const std::vector<AddressPtr> &outputs) {
   auto input = reinterpret_cast<T *>(inputs[0]->addr);
   auto output = reinterpret_cast<T *>(outputs[0]->addr);
-  size_t size = IntToSize(inputs[0]->size / sizeof(T));
-  size_t shape_size = IntToSize(shape_.size());
-  if (shape_size > kMaxDim) {
-    MS_LOG(EXCEPTION) << "Input is " << shape_size << "-D, but transpose supports max " << kMaxDim << "-D inputs.";
-  }
-  size_t pos_array[kMaxDim];
-  size_t size_offset[kMaxDim];
-  size_offset[0] = size / shape_[0];
-  for (size_t i = 1; i < shape_size; i++) {
-    size_offset[i] = size_offset[SizeToInt(i) - 1] / shape_[i];
-  }
-  for (size_t position = 0; position < size; position += 1) {
-    size_t temp_position = position;
-    pos_array[0] = temp_position / size_offset[0];
-    for (size_t i = 1; i < shape_size; i++) {
-      temp_position -= pos_array[SizeToInt(i) - 1] * size_offset[i - 1];
-      pos_array[i] = temp_position / size_offset[i];
-    }
-    size_t new_position = pos_array[axis_[SizeToInt(shape_size) - 1]];
-    size_t new_position_size = 1;
-    for (int j = shape_size - 2; j >= 0; j--) {
-      new_position_size *= shape_[axis_[j + 1]];
-      new_position += pos_array[axis_[j]] * new_position_size;
-    }
-    output[new_position] = input[position];
-  }
+  plan_.Run(input, output);
 }
 
 bool TransposeCPUFwdKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -21,6 +21,7 @@
 #include <string>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "backend/kernel_compiler/cpu/parallel_transpose.h"
 namespace mindspore {
 namespace kernel {
 class TransposeCPUFwdKernel : public CPUKernel {
@@ -38,7 +39,8 @@ class TransposeCPUFwdKernel : public CPUKernel {
 
  private:
   std::vector<size_t> shape_;
-  std::vector<int> axis_;
+  std::vector<size_t> axis_;
+  TransposePlan plan_;
   TypeId dtype_{kTypeUnknown};
   using TypeKernel =
     std::function<void(TransposeCPUFwdKernel *, const std::vector<AddressPtr> &, const std::vector<AddressPtr> &)>;
@@ -19,7 +19,6 @@
 
 namespace mindspore {
 namespace kernel {
-const size_t kUseBucketUniqueSize = 100000;
 void UniqueCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   node_ = kernel_node;
   CheckParam(kernel_node);
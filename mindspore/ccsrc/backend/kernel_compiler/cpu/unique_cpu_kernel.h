@@ -27,6 +27,9 @@
 
 namespace mindspore {
 namespace kernel {
+// Above this input size the unique runs on buckets of the input in parallel.
+const size_t kUseBucketUniqueSize = 100000;
+
 template <typename DataType, typename IndexType>
 struct UniqueParam {
   DataType *input_{nullptr};
@@ -232,6 +235,8 @@ class UniqueCPUKernel : public CPUKernel {
     MS_LOG(DEBUG) << "End";
   }
 
+ public:
+  // The unique routines are also used by the kernels deduplicating their indices.
   template <typename DataType, typename IndexType>
   static void Unique(const std::shared_ptr<UniqueParam<DataType, IndexType>> &params) {
     MS_LOG(DEBUG) << "Start";
@@ -18,7 +18,6 @@
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_UNPACK_CPU_KERNEL_H_
 #include <algorithm>
 #include <memory>
-#include <thread>
 #include <unordered_map>
 #include <vector>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
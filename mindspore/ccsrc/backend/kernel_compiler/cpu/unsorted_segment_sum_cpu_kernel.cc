@@ -17,7 +17,7 @@
 #include "backend/kernel_compiler/cpu/unsorted_segment_sum_cpu_kernel.h"
 #include <string>
 #include "runtime/device/cpu/cpu_device_address.h"
-#include "common/thread_pool.h"
+#include "backend/kernel_compiler/cpu/parallel_scatter.h"
 
 namespace mindspore {
 namespace kernel {
@@ -78,17 +78,20 @@ bool UnsortedSegmentSumCPUKernel::LaunchKernel(const std::vector<AddressPtr> &in
     MS_LOG(ERROR) << "Output buff memset fail. ret:" << ret;
     return false;
   }
-  for (size_t i = 0; i < unit_num_; ++i) {
-    size_t j = i / input_dim1_;
-    size_t k = i % input_dim1_;
-
-    T index = indices_addr[j];
-    if (index < 0 || index >= SizeToInt(output_dim0_)) {
-      continue;
+  // Every row of the input is added to the output row of its segment id, the rows with an id out of range are
+  // dropped.
+  size_t row_num = input_dim1_ == 0 ? 0 : unit_num_ / input_dim1_;
+  auto get_segment = [this, indices_addr](size_t row) -> int64_t {
+    T index = indices_addr[row];
+    if (index < 0 || static_cast<size_t>(index) >= output_dim0_) {
+      return -1;
     }
-    size_t output_index = index * output_dim1_ + k;
-    output_addr[output_index] += input_addr[i];
-  }
+    return static_cast<int64_t>(index);
+  };
+  auto add_row = [this, input_addr, output_addr](size_t row, int64_t segment, size_t start, size_t end) {
+    ScatterAddRow(input_addr + row * input_dim1_ + start, output_addr + segment * output_dim1_ + start, end - start);
+  };
+  ParallelScatterRows(row_num, input_dim1_, output_dim0_, get_segment, add_row);
   return true;
 }
 }  // namespace kernel
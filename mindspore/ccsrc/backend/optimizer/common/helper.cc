@@ -820,5 +820,28 @@ void TransferDepend(const CNodePtr &old_node, const FuncGraphPtr &graph, const C
     }
   }
 }
+
+bool DependsOnCluster(const AnfNodePtr &node, const std::set<AnfNodePtr> &members, size_t first_index,
+                      const std::map<AnfNodePtr, size_t> &topo_index) {
+  std::vector<AnfNodePtr> stack = {node};
+  std::set<AnfNodePtr> visited;
+  while (!stack.empty()) {
+    auto cur = stack.back();
+    stack.pop_back();
+    if (members.count(cur) != 0) {
+      return true;
+    }
+    if (!cur->isa<CNode>() || !visited.insert(cur).second) {
+      continue;
+    }
+    auto iter = topo_index.find(cur);
+    if (iter != topo_index.end() && iter->second < first_index) {
+      continue;
+    }
+    auto &inputs = cur->cast<CNodePtr>()->inputs();
+    stack.insert(stack.end(), inputs.begin(), inputs.end());
+  }
+  return false;
+}
 }  // namespace opt
 }  // namespace mindspore
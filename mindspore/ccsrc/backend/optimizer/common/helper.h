@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_COMMON_HELPER_H_
 
 #include <vector>
+#include <map>
 #include <memory>
 #include <utility>
 #include <string>
@@ -212,6 +213,11 @@ ValueNodePtr MakeValueNode(const ValueNodePtr &value_node);
 
 // Transfer depend or control_depend to the new node
 void TransferDepend(const CNodePtr &old_node, const FuncGraphPtr &graph, const CNodePtr &new_node);
+
+// Whether node reaches a member of the cluster through its inputs. The nodes before the first member in topological
+// order can not depend on the cluster and are not visited.
+bool DependsOnCluster(const AnfNodePtr &node, const std::set<AnfNodePtr> &members, size_t first_index,
+                      const std::map<AnfNodePtr, size_t> &topo_index);
 }  // namespace opt
 }  // namespace mindspore
 #endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_COMMON_HELPER_H_
@@ -0,0 +1,190 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/cpu/allreduce_bucketing.h"
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <string>
+#include "backend/optimizer/common/helper.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "backend/session/kernel_graph.h"
+#include "ir/manager.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+size_t GetElementNum(const CNodePtr &node) {
+  auto shape = AnfAlgo::GetOutputInferShape(node, 0);
+  return std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+}
+
+bool IsMean(const CNodePtr &all_reduce) {
+  return AnfAlgo::HasNodeAttr(kAttrMean, all_reduce) && AnfAlgo::GetNodeAttr<bool>(all_reduce, kAttrMean);
+}
+
+bool IsMPIWorldAllReduce(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  if (!node->isa<CNode>() || AnfAlgo::GetCNodeName(node) != kAllReduceOpName) {
+    return false;
+  }
+  auto cnode = node->cast<CNodePtr>();
+  return AnfAlgo::HasNodeAttr(kAttrGroup, cnode) &&
+         AnfAlgo::GetNodeAttr<std::string>(cnode, kAttrGroup) == kValueCPUMPIWorldGroup &&
+         AnfAlgo::GetOutputDeviceDataType(cnode, 0) == kNumberTypeFloat32;
+}
+}  // namespace
+
+std::vector<std::vector<CNodePtr>> AllReduceBucketing::GetBuckets(const std::vector<CNodePtr> &all_reduces) const {
+  size_t total_size = 0;
+  for (auto &all_reduce : all_reduces) {
+    total_size += GetElementNum(all_reduce) * sizeof(float);
+  }
+  size_t bucket_size = bucket_size_;
+  if (bucket_num_ > 0) {
+    bucket_size = std::max(bucket_size, (total_size + bucket_num_ - 1) / bucket_num_);
+  }
+  std::vector<std::vector<CNodePtr>> buckets;
+  std::vector<size_t> bucket_sizes;
+  for (auto &all_reduce : all_reduces) {
+    size_t size = GetElementNum(all_reduce) * sizeof(float);
+    if (buckets.empty() || bucket_sizes.back() + size > bucket_size ||
+        IsMean(buckets.back().front()) != IsMean(all_reduce)) {
+      buckets.emplace_back();
+      bucket_sizes.push_back(0);
+    }
+    buckets.back().push_back(all_reduce);
+    bucket_sizes.back() += size;
+  }
+  // The greedy filling can leave more buckets than bucket_num, the smallest neighbours are merged.
+  while (bucket_num_ > 0 && buckets.size() > bucket_num_) {
+    size_t merged = 0;
+    for (size_t i = 1; i + 1 < buckets.size(); ++i) {
+      if (bucket_sizes[i] + bucket_sizes[i + 1] < bucket_sizes[merged] + bucket_sizes[merged + 1]) {
+        merged = i;
+      }
+    }
+    if (IsMean(buckets[merged].front()) != IsMean(buckets[merged + 1].front())) {
+      break;
+    }
+    buckets[merged].insert(buckets[merged].end(), buckets[merged + 1].begin(), buckets[merged + 1].end());
+    bucket_sizes[merged] += bucket_sizes[merged + 1];
+    (void)buckets.erase(buckets.begin() + merged + 1);
+    (void)bucket_sizes.erase(bucket_sizes.begin() + merged + 1);
+  }
+  return buckets;
+}
+
+CNodePtr AllReduceBucketing::CreateStart(const FuncGraphPtr &graph, const std::vector<CNodePtr> &bucket) const {
+  std::vector<AnfNodePtr> start_inputs = {NewValueNode(std::make_shared<Primitive>(kMPIAllReduceStartOpName))};
+  std::vector<std::string> input_formats;
+  size_t element_num = 0;
+  for (auto &all_reduce : bucket) {
+    start_inputs.push_back(all_reduce->input(1));
+    input_formats.push_back(AnfAlgo::GetInputFormat(all_reduce, 0));
+    element_num += GetElementNum(all_reduce);
+  }
+  auto start = graph->NewCNode(start_inputs);
+  MS_EXCEPTION_IF_NULL(start);
+  start->set_scope(bucket.back()->scope());
+  AnfAlgo::SetOutputInferTypeAndShape({kNumberTypeFloat32}, {{element_num}}, start.get());
+  auto builder = std::make_shared<kernel::KernelBuildInfo::KernelBuildInfoBuilder>();
+  builder->SetInputsFormat(input_formats);
+  builder->SetInputsDeviceType(std::vector<TypeId>(input_formats.size(), kNumberTypeFloat32));
+  builder->SetOutputsFormat({kOpFormat_DEFAULT});
+  builder->SetOutputsDeviceType({kNumberTypeFloat32});
+  AnfAlgo::SetSelectKernelBuildInfo(builder->Build(), start.get());
+  return start;
+}
+
+CNodePtr AllReduceBucketing::CreateWait(const FuncGraphPtr &graph, const std::vector<CNodePtr> &bucket,
+                                        const AnfNodePtr &buffer) const {
+  auto wait = graph->NewCNode({NewValueNode(std::make_shared<Primitive>(kMPIAllReduceWaitOpName)), buffer});
+  MS_EXCEPTION_IF_NULL(wait);
+  wait->set_scope(bucket.back()->scope());
+  std::vector<TypeId> output_types;
+  std::vector<std::vector<size_t>> output_shapes;
+  std::vector<std::string> output_formats;
+  for (auto &all_reduce : bucket) {
+    output_types.push_back(AnfAlgo::GetOutputInferDataType(all_reduce, 0));
+    output_shapes.push_back(AnfAlgo::GetOutputInferShape(all_reduce, 0));
+    output_formats.push_back(AnfAlgo::GetOutputFormat(all_reduce, 0));
+  }
+  AnfAlgo::SetOutputInferTypeAndShape(output_types, output_shapes, wait.get());
+  AnfAlgo::SetNodeAttr(kAttrMean, MakeValue(IsMean(bucket.front())), wait);
+  auto builder = std::make_shared<kernel::KernelBuildInfo::KernelBuildInfoBuilder>();
+  builder->SetInputsFormat({kOpFormat_DEFAULT});
+  builder->SetInputsDeviceType({kNumberTypeFloat32});
+  builder->SetOutputsFormat(output_formats);
+  builder->SetOutputsDeviceType(std::vector<TypeId>(output_formats.size(), kNumberTypeFloat32));
+  AnfAlgo::SetSelectKernelBuildInfo(builder->Build(), wait.get());
+  return wait;
+}
+
+bool AllReduceBucketing::Run(const FuncGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto kernel_graph = graph->cast<KernelGraphPtr>();
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto manager = graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  std::vector<CNodePtr> all_reduces;
+  for (auto &node : TopoSort(graph->get_return())) {
+    if (IsMPIWorldAllReduce(node)) {
+      all_reduces.push_back(node->cast<CNodePtr>());
+    }
+  }
+  if (all_reduces.empty()) {
+    return false;
+  }
+  // The gradients are ready in the execution order of the kernels producing them.
+  std::map<AnfNodePtr, size_t> exec_index;
+  auto &execution_order = kernel_graph->execution_order();
+  for (size_t i = 0; i < execution_order.size(); ++i) {
+    exec_index[execution_order[i]] = i;
+  }
+  auto ready_index = [&exec_index](const CNodePtr &all_reduce) {
+    auto iter = exec_index.find(AnfAlgo::VisitKernel(all_reduce->input(1), 0).first);
+    return iter == exec_index.end() ? 0 : iter->second;
+  };
+  std::stable_sort(all_reduces.begin(), all_reduces.end(), [&ready_index](const CNodePtr &a, const CNodePtr &b) {
+    return ready_index(a) < ready_index(b);
+  });
+
+  auto buckets = GetBuckets(all_reduces);
+  std::vector<CNodePtr> starts;
+  for (auto &bucket : buckets) {
+    starts.push_back(CreateStart(graph, bucket));
+  }
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    AnfNodePtr buffer = starts[i];
+    if (i + 1 < starts.size()) {
+      auto depend = graph->NewCNode({NewValueNode(prim::kPrimDepend), starts[i], starts.back()});
+      MS_EXCEPTION_IF_NULL(depend);
+      depend->set_abstract(starts[i]->abstract());
+      buffer = depend;
+    }
+    auto wait = CreateWait(graph, buckets[i], buffer);
+    for (size_t j = 0; j < buckets[i].size(); ++j) {
+      (void)manager->Replace(buckets[i][j], CreatTupleGetItemNode(graph, wait, j));
+    }
+  }
+  MS_LOG(INFO) << "Pack " << all_reduces.size() << " gradient AllReduce into " << buckets.size() << " buckets";
+  return true;
+}
+}  // namespace opt
+}  // namespace mindspore
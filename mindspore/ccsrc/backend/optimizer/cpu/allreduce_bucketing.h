@@ -0,0 +1,49 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_ALLREDUCE_BUCKETING_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_ALLREDUCE_BUCKETING_H_
+#include <vector>
+#include "backend/optimizer/common/pass.h"
+#include "ir/func_graph.h"
+#include "ir/anf.h"
+
+namespace mindspore {
+namespace opt {
+// Packs the AllReduce over the processes of the MPI world, see enable_cpu_grad_allreduce, into buckets of up to
+// bucket_size bytes, made bigger to get at most bucket_num buckets when it is not 0. The gradients fill the buckets
+// in the order the backward produces them, which is the reverse of the forward order of the weights. A bucket is an
+// MPIAllReduceStart of its gradients, issued as soon as they are all ready, and an MPIAllReduceWait giving the
+// reduced gradients. The waits follow the start of the last bucket, so the buckets are in flight while the rest of
+// the backward runs and are only waited for before the optimizers.
+// Must run after ReplicaGradAllReduce, on a kernel graph whose execution order is set.
+class AllReduceBucketing : public Pass {
+ public:
+  AllReduceBucketing(size_t bucket_size, size_t bucket_num)
+      : Pass("allreduce_bucketing"), bucket_size_(bucket_size), bucket_num_(bucket_num) {}
+  ~AllReduceBucketing() override = default;
+  bool Run(const FuncGraphPtr &graph) override;
+
+ private:
+  std::vector<std::vector<CNodePtr>> GetBuckets(const std::vector<CNodePtr> &all_reduces) const;
+  CNodePtr CreateStart(const FuncGraphPtr &graph, const std::vector<CNodePtr> &bucket) const;
+  CNodePtr CreateWait(const FuncGraphPtr &graph, const std::vector<CNodePtr> &bucket, const AnfNodePtr &buffer) const;
+
+  size_t bucket_size_;
+  size_t bucket_num_;
+};
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_ALLREDUCE_BUCKETING_H_
@@ -0,0 +1,61 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/cpu/bf16_mixed_precision.h"
+#include <set>
+#include <string>
+#include "backend/kernel_compiler/cpu/mkldnn/mkl_cpu_kernel.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+const std::set<std::string> kBf16WhiteList = {kMatMulOpName, kBatchMatMulOpName, kConv2DOpName,
+                                              kConv2DBackpropInputOpName, kConv2DBackpropFilterOpName};
+
+bool IsBf16Candidate(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  if (!node->isa<CNode>() || !AnfAlgo::IsRealKernel(node)) {
+    return false;
+  }
+  auto cnode = node->cast<CNodePtr>();
+  if (kBf16WhiteList.count(AnfAlgo::GetCNodeName(cnode)) == 0 || AnfAlgo::GetInputTensorNum(cnode) < 2 ||
+      AnfAlgo::GetOutputDeviceDataType(cnode, 0) != kNumberTypeFloat32) {
+    return false;
+  }
+  return AnfAlgo::GetInputDeviceDataType(cnode, 0) == kNumberTypeFloat32 &&
+         AnfAlgo::GetInputDeviceDataType(cnode, 1) == kNumberTypeFloat32;
+}
+}  // namespace
+
+bool Bf16MixedPrecision::Run(const FuncGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  if (!kernel::MKLCPUKernel::IsBf16Supported()) {
+    MS_LOG(INFO) << "The processor has no bfloat16 instructions, the mixed precision keeps float32.";
+    return false;
+  }
+  bool changed = false;
+  for (auto &node : TopoSort(graph->get_return())) {
+    if (!IsBf16Candidate(node)) {
+      continue;
+    }
+    AnfAlgo::SetNodeAttr(kAttrComputeDtype, MakeValue(std::string(kValueBFloat16)), node);
+    changed = true;
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,34 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_BF16_MIXED_PRECISION_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_BF16_MIXED_PRECISION_H_
+#include "backend/optimizer/common/pass.h"
+#include "ir/func_graph.h"
+
+namespace mindspore {
+namespace opt {
+// Marks the float32 MatMul, BatchMatMul and Conv2D forward and backward kernels to compute in bfloat16 when the
+// processor supports it. The tensors of the graph, the weights included, stay float32: the mkldnn kernels convert
+// their inputs to bfloat16 before computing and accumulate into a float32 output.
+class Bf16MixedPrecision : public Pass {
+ public:
+  Bf16MixedPrecision() : Pass("bf16_mixed_precision") {}
+  ~Bf16MixedPrecision() override = default;
+  bool Run(const FuncGraphPtr &graph) override;
+};
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_BF16_MIXED_PRECISION_H_
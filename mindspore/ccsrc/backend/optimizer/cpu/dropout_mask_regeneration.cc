@@ -0,0 +1,102 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/cpu/dropout_mask_regeneration.h"
+#include <memory>
+#include <vector>
+#include "backend/kernel_compiler/cpu/philox_random.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "ir/manager.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr size_t kDropoutMaskIndex = 1;
+constexpr size_t kDropoutGradMaskInputIndex = 2;
+
+// The TupleGetItem nodes of the mask of a Dropout whose mask is only used by DropoutGrad nodes.
+bool GetRegenerableMasks(const FuncGraphManagerPtr &manager, const CNodePtr &dropout, std::vector<CNodePtr> *masks) {
+  MS_EXCEPTION_IF_NULL(masks);
+  auto dtype = AnfAlgo::GetOutputDeviceDataType(dropout, kDropoutMaskIndex);
+  if (!AnfAlgo::IsRealKernel(dropout) || AnfAlgo::IsDynamicShape(dropout) ||
+      (dtype != kNumberTypeFloat32 && dtype != kNumberTypeFloat16)) {
+    return false;
+  }
+  auto &node_users = manager->node_users();
+  for (auto &user : node_users[dropout]) {
+    if (!AnfAlgo::CheckPrimitiveType(user.first, prim::kPrimTupleGetItem)) {
+      return false;
+    }
+    auto getitem = user.first->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(getitem);
+    if (AnfAlgo::GetTupleGetItemOutIndex(getitem) != kDropoutMaskIndex) {
+      continue;
+    }
+    for (auto &mask_user : node_users[getitem]) {
+      if (!AnfAlgo::CheckPrimitiveType(mask_user.first, prim::kPrimDropoutGrad) ||
+          IntToSize(mask_user.second) != kDropoutGradMaskInputIndex) {
+        return false;
+      }
+    }
+    masks->push_back(getitem);
+  }
+  return true;
+}
+
+void SetDeviceType(const AnfNodePtr &node, size_t index, bool is_output) {
+  auto builder =
+    std::make_shared<kernel::KernelBuildInfo::KernelBuildInfoBuilder>(AnfAlgo::GetSelectKernelBuildInfo(node));
+  if (is_output) {
+    builder->SetOutputDeviceType(kNumberTypeUInt64, index);
+  } else {
+    builder->SetInputDeviceType(kNumberTypeUInt64, index);
+  }
+  AnfAlgo::SetSelectKernelBuildInfo(builder->Build(), node.get());
+}
+}  // namespace
+
+bool DropoutMaskRegeneration::Run(const FuncGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto manager = graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  bool changed = false;
+  for (auto &node : TopoSort(graph->get_return())) {
+    if (!AnfAlgo::CheckPrimitiveType(node, prim::kPrimDropout)) {
+      continue;
+    }
+    auto dropout = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(dropout);
+    std::vector<CNodePtr> masks;
+    if (!GetRegenerableMasks(manager, dropout, &masks)) {
+      continue;
+    }
+    std::vector<size_t> state_shape = {kernel::kPhiloxStateSize};
+    AnfAlgo::SetOutputInferTypeAndShape(
+      {AnfAlgo::GetOutputInferDataType(dropout, 0), kNumberTypeUInt64},
+      {AnfAlgo::GetOutputInferShape(dropout, 0), state_shape}, dropout.get());
+    SetDeviceType(dropout, kDropoutMaskIndex, true);
+    for (auto &mask : masks) {
+      AnfAlgo::SetOutputInferTypeAndShape({kNumberTypeUInt64}, {state_shape}, mask.get());
+      for (auto &user : manager->node_users()[mask]) {
+        SetDeviceType(user.first, kDropoutGradMaskInputIndex - 1, false);
+      }
+    }
+    changed = true;
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,35 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_DROPOUT_MASK_REGENERATION_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_DROPOUT_MASK_REGENERATION_H_
+#include "backend/optimizer/common/pass.h"
+#include "ir/func_graph.h"
+#include "ir/anf.h"
+
+namespace mindspore {
+namespace opt {
+// Replaces the mask a Dropout passes to its DropoutGrad by the seed and the counter of its Philox launch, the grad
+// then regenerates the mask instead of reading a buffer as large as the input. Only applies when every user of the
+// mask is a DropoutGrad. Must run after the CPU kernel selection.
+class DropoutMaskRegeneration : public Pass {
+ public:
+  DropoutMaskRegeneration() : Pass("dropout_mask_regeneration") {}
+  ~DropoutMaskRegeneration() override = default;
+  bool Run(const FuncGraphPtr &graph) override;
+};
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_DROPOUT_MASK_REGENERATION_H_
@@ -0,0 +1,250 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/cpu/elemwise_fusion.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "backend/kernel_compiler/cpu/fused_elemwise_cpu_kernel.h"
+#include "backend/optimizer/common/helper.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "ir/manager.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+using kernel::FusedElemwiseCPUKernel;
+
+bool IsFloat32Kernel(const CNodePtr &node) {
+  if (AnfAlgo::GetOutputTensorNum(node) != 1 || AnfAlgo::GetOutputDeviceDataType(node, 0) != kNumberTypeFloat32) {
+    return false;
+  }
+  size_t input_num = AnfAlgo::GetInputTensorNum(node);
+  for (size_t i = 0; i < input_num; ++i) {
+    if (AnfAlgo::GetInputDeviceDataType(node, i) != kNumberTypeFloat32 ||
+        AnfAlgo::GetPrevNodeOutputInferShape(node, i).size() > FusedElemwiseCPUKernel::kMaxRank) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsFusibleNode(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  if (!node->isa<CNode>() || !AnfAlgo::IsRealKernel(node)) {
+    return false;
+  }
+  auto cnode = node->cast<CNodePtr>();
+  auto op_name = AnfAlgo::GetCNodeName(cnode);
+  if (!FusedElemwiseCPUKernel::IsElemwiseOp(op_name) && !FusedElemwiseCPUKernel::IsReduceOp(op_name)) {
+    return false;
+  }
+  return !AnfAlgo::IsDynamicShape(cnode) && IsFloat32Kernel(cnode);
+}
+
+// Returns whether the reduce only reduces the trailing axes of its input, and how many of them.
+bool GetTrailingReduceAxisNum(const CNodePtr &node, size_t *axis_num) {
+  MS_EXCEPTION_IF_NULL(axis_num);
+  if (AnfAlgo::GetInputTensorNum(node) != 1 || !AnfAlgo::HasNodeAttr(kAttrAxis, node)) {
+    return false;
+  }
+  auto rank = SizeToLong(AnfAlgo::GetPrevNodeOutputInferShape(node, 0).size());
+  auto axis_value = AnfAlgo::GetCNodePrimitive(node)->GetAttr(kAttrAxis);
+  MS_EXCEPTION_IF_NULL(axis_value);
+  std::vector<int64_t> axes;
+  if (axis_value->isa<ValueTuple>() || axis_value->isa<ValueList>()) {
+    axes = AnfAlgo::GetNodeAttr<std::vector<int64_t>>(node, kAttrAxis);
+  } else if (axis_value->isa<Int64Imm>()) {
+    axes.push_back(AnfAlgo::GetNodeAttr<int64_t>(node, kAttrAxis));
+  } else {
+    return false;
+  }
+  if (axes.empty()) {
+    *axis_num = LongToSize(rank);
+    return true;
+  }
+  for (auto &axis : axes) {
+    axis = axis < 0 ? axis + rank : axis;
+    if (axis < 0 || axis >= rank) {
+      return false;
+    }
+  }
+  std::sort(axes.begin(), axes.end());
+  axes.erase(std::unique(axes.begin(), axes.end()), axes.end());
+  if (axes.front() != rank - SizeToLong(axes.size())) {
+    return false;
+  }
+  *axis_num = axes.size();
+  return true;
+}
+}  // namespace
+
+bool ElemwiseFusion::CanJoin(const FusionCluster &cluster, const CNodePtr &node,
+                             const std::map<AnfNodePtr, size_t> &topo_index) const {
+  if (cluster.closed) {
+    return false;
+  }
+  // Fusing the node must not make the cluster both a producer and a consumer of another node.
+  auto &inputs = node->inputs();
+  return std::none_of(inputs.begin() + 1, inputs.end(), [&](const AnfNodePtr &input) {
+    return cluster.members.count(input) == 0 &&
+           DependsOnCluster(input, cluster.members, cluster.first_index, topo_index);
+  });
+}
+
+bool ElemwiseFusion::FuseCluster(const FuncGraphPtr &graph, const FusionCluster &cluster) const {
+  auto manager = graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  // The tensors coming from outside take the first registers of the fused program.
+  std::vector<AnfNodePtr> fused_inputs = {NewValueNode(std::make_shared<Primitive>(kFusedElemwiseOpName))};
+  std::vector<std::string> input_formats;
+  std::map<AnfNodePtr, int64_t> regs;
+  for (auto &node : cluster.nodes) {
+    size_t input_num = AnfAlgo::GetInputTensorNum(node);
+    for (size_t i = 0; i < input_num; ++i) {
+      auto input = node->input(i + 1);
+      if (cluster.members.count(input) != 0 || regs.count(input) != 0) {
+        continue;
+      }
+      regs[input] = SizeToLong(fused_inputs.size() - 1);
+      fused_inputs.push_back(input);
+      input_formats.push_back(AnfAlgo::GetInputFormat(node, i));
+    }
+  }
+  std::vector<std::string> op_names;
+  std::vector<int64_t> op_inputs;
+  for (auto &node : cluster.nodes) {
+    regs[node] = SizeToLong(fused_inputs.size() - 1 + op_names.size());
+    op_names.push_back(AnfAlgo::GetCNodeName(node));
+    size_t input_num = AnfAlgo::GetInputTensorNum(node);
+    op_inputs.push_back(regs[node->input(1)]);
+    op_inputs.push_back(input_num > 1 ? regs[node->input(2)] : -1);
+  }
+  // The members used outside of the cluster become the outputs.
+  std::vector<CNodePtr> outputs;
+  std::vector<int64_t> output_regs;
+  auto &node_users = manager->node_users();
+  for (auto &node : cluster.nodes) {
+    auto &users = node_users[node];
+    if (std::any_of(users.begin(), users.end(),
+                    [&cluster](const auto &user) { return cluster.members.count(user.first) == 0; })) {
+      outputs.push_back(node);
+      output_regs.push_back(regs[node]);
+    }
+  }
+  if (outputs.empty()) {
+    return false;
+  }
+
+  auto fused_node = graph->NewCNode(fused_inputs);
+  MS_EXCEPTION_IF_NULL(fused_node);
+  fused_node->set_scope(cluster.nodes.back()->scope());
+  std::vector<TypeId> output_types;
+  std::vector<std::vector<size_t>> output_shapes;
+  std::vector<std::string> output_formats;
+  for (auto &output : outputs) {
+    output_types.push_back(AnfAlgo::GetOutputInferDataType(output, 0));
+    output_shapes.push_back(AnfAlgo::GetOutputInferShape(output, 0));
+    output_formats.push_back(AnfAlgo::GetOutputFormat(output, 0));
+  }
+  AnfAlgo::SetOutputInferTypeAndShape(output_types, output_shapes, fused_node.get());
+  AnfAlgo::SetNodeAttr(kAttrFusedOps, MakeValue(op_names), fused_node);
+  AnfAlgo::SetNodeAttr(kAttrFusedOpInputs, MakeValue(op_inputs), fused_node);
+  AnfAlgo::SetNodeAttr(kAttrFusedOutputs, MakeValue(output_regs), fused_node);
+  AnfAlgo::SetNodeAttr(kAttrReduceAxisNum, MakeValue(SizeToLong(cluster.reduce_axis_num)), fused_node);
+  auto builder = std::make_shared<kernel::KernelBuildInfo::KernelBuildInfoBuilder>();
+  builder->SetInputsFormat(input_formats);
+  builder->SetInputsDeviceType(std::vector<TypeId>(input_formats.size(), kNumberTypeFloat32));
+  builder->SetOutputsFormat(output_formats);
+  builder->SetOutputsDeviceType(std::vector<TypeId>(output_formats.size(), kNumberTypeFloat32));
+  AnfAlgo::SetSelectKernelBuildInfo(builder->Build(), fused_node.get());
+
+  if (outputs.size() == 1) {
+    (void)manager->Replace(outputs[0], fused_node);
+    return true;
+  }
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    (void)manager->Replace(outputs[i], CreatTupleGetItemNode(graph, fused_node, i));
+  }
+  return true;
+}
+
+bool ElemwiseFusion::Run(const FuncGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto node_list = TopoSort(graph->get_return());
+  std::map<AnfNodePtr, size_t> topo_index;
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    topo_index[node_list[i]] = i;
+  }
+  std::vector<FusionCluster> clusters;
+  std::map<AnfNodePtr, size_t> node_cluster;
+  for (auto &node : node_list) {
+    if (!IsFusibleNode(node)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    bool is_reduce = FusedElemwiseCPUKernel::IsReduceOp(AnfAlgo::GetCNodeName(cnode));
+    auto shape = is_reduce ? AnfAlgo::GetPrevNodeOutputInferShape(cnode, 0) : AnfAlgo::GetOutputInferShape(cnode, 0);
+    size_t reduce_axis_num = 0;
+    if (is_reduce && !GetTrailingReduceAxisNum(cnode, &reduce_axis_num)) {
+      continue;
+    }
+    // Join the cluster of a producer computing on the same shape, the reduce only takes its own input.
+    size_t input_num = is_reduce ? 1 : AnfAlgo::GetInputTensorNum(cnode);
+    bool joined = false;
+    for (size_t i = 0; i < input_num && !joined; ++i) {
+      auto iter = node_cluster.find(cnode->input(i + 1));
+      if (iter == node_cluster.end()) {
+        continue;
+      }
+      auto &cluster = clusters[iter->second];
+      if (cluster.shape != shape || !CanJoin(cluster, cnode, topo_index)) {
+        continue;
+      }
+      cluster.nodes.push_back(cnode);
+      (void)cluster.members.insert(cnode);
+      node_cluster[cnode] = iter->second;
+      cluster.closed = is_reduce;
+      cluster.reduce_axis_num = reduce_axis_num;
+      joined = true;
+    }
+    if (!joined && !is_reduce) {
+      FusionCluster cluster;
+      cluster.nodes.push_back(cnode);
+      (void)cluster.members.insert(cnode);
+      cluster.shape = shape;
+      cluster.first_index = topo_index[cnode];
+      node_cluster[cnode] = clusters.size();
+      clusters.push_back(cluster);
+    }
+  }
+
+  bool changed = false;
+  for (auto &cluster : clusters) {
+    if (cluster.nodes.size() < 2) {
+      continue;
+    }
+    if (FuseCluster(graph, cluster)) {
+      MS_LOG(INFO) << "Fuse " << cluster.nodes.size() << " elementwise nodes ending with "
+                   << cluster.nodes.back()->fullname_with_scope();
+      changed = true;
+    }
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,53 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_ELEMWISE_FUSION_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_ELEMWISE_FUSION_H_
+#include <map>
+#include <set>
+#include <vector>
+#include "backend/optimizer/common/pass.h"
+#include "ir/func_graph.h"
+#include "ir/anf.h"
+
+namespace mindspore {
+namespace opt {
+// Groups the float32 elementwise operators computing on the same shape, together with a sum or mean over the trailing
+// axes of their result, into FusedElemwise kernels, so that a chain runs in one pass over the memory without the
+// intermediate tensors. Must run after the CPU kernel selection, the fused kernels get their build info here.
+class ElemwiseFusion : public Pass {
+ public:
+  ElemwiseFusion() : Pass("elemwise_fusion") {}
+  ~ElemwiseFusion() override = default;
+  bool Run(const FuncGraphPtr &graph) override;
+
+ private:
+  struct FusionCluster {
+    std::vector<CNodePtr> nodes;
+    std::set<AnfNodePtr> members;
+    std::vector<size_t> shape;
+    size_t first_index{0};
+    // A cluster ended by a reduce takes no more nodes.
+    bool closed{false};
+    size_t reduce_axis_num{0};
+  };
+  bool CanJoin(const FusionCluster &cluster, const CNodePtr &node,
+               const std::map<AnfNodePtr, size_t> &topo_index) const;
+  // Returns whether the cluster was replaced by a fused node.
+  bool FuseCluster(const FuncGraphPtr &graph, const FusionCluster &cluster) const;
+};
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_ELEMWISE_FUSION_H_
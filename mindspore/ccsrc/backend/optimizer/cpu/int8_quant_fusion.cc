@@ -0,0 +1,178 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/cpu/int8_quant_fusion.h"
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <set>
+#include <utility>
+#include <vector>
+#include "backend/session/anf_runtime_algorithm.h"
+#include "base/core_ops.h"
+#include "ir/manager.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr int64_t kInt8NumBits = 8;
+constexpr size_t kFakeQuantInputIndex = 1;
+constexpr size_t kFakeQuantMinIndex = 2;
+constexpr size_t kFakeQuantMaxIndex = 3;
+constexpr size_t kBiasAddBiasIndex = 2;
+
+bool GetBoolAttr(const CNodePtr &node, const std::string &name) {
+  return AnfAlgo::HasNodeAttr(name, node) && AnfAlgo::GetNodeAttr<bool>(node, name);
+}
+
+size_t GetRangeSize(const CNodePtr &fake_quant) {
+  auto shape = AnfAlgo::GetPrevNodeOutputInferShape(fake_quant, kFakeQuantMinIndex - 1);
+  return std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+}
+
+CNodePtr GetFoldableFakeQuant(const FuncGraphManagerPtr &manager, const CNodePtr &node, size_t input_index) {
+  static const std::set<std::string> kFakeQuantOps = {kFakeQuantPerLayerOpName, kFakeQuantPerChannelOpName,
+                                                      kFakeQuantWithMinMaxVarsOpName,
+                                                      kFakeQuantWithMinMaxVarsPerChannelOpName};
+  auto input = AnfAlgo::GetInputNode(node, input_index);
+  MS_EXCEPTION_IF_NULL(input);
+  if (!input->isa<CNode>() || kFakeQuantOps.count(AnfAlgo::GetCNodeName(input)) == 0) {
+    return nullptr;
+  }
+  auto fake_quant = input->cast<CNodePtr>();
+  if (manager->node_users()[fake_quant].size() != 1 || GetBoolAttr(fake_quant, kAttrTraining) ||
+      AnfAlgo::GetNodeAttr<int64_t>(fake_quant, kAttrNumBits) != kInt8NumBits ||
+      AnfAlgo::GetOutputDeviceDataType(fake_quant, 0) != kNumberTypeFloat32) {
+    return nullptr;
+  }
+  return fake_quant;
+}
+
+// The weight is quantized per layer, or per channel along the output channels of the op.
+bool IsWeightRangeFoldable(const CNodePtr &weight_fake_quant, size_t out_channel_axis) {
+  if (GetRangeSize(weight_fake_quant) == 1) {
+    return true;
+  }
+  auto name = AnfAlgo::GetCNodeName(weight_fake_quant);
+  size_t rank = AnfAlgo::GetOutputInferShape(weight_fake_quant, 0).size();
+  if (name == kFakeQuantPerChannelOpName) {
+    return LongToSize(AnfAlgo::GetNodeAttr<int64_t>(weight_fake_quant, kAttrChannelAxis)) == out_channel_axis;
+  }
+  return name == kFakeQuantWithMinMaxVarsPerChannelOpName && rank - 1 == out_channel_axis;
+}
+
+CNodePtr GetFoldableBiasAdd(const FuncGraphManagerPtr &manager, const CNodePtr &node) {
+  auto &users = manager->node_users()[node];
+  if (users.size() != 1) {
+    return nullptr;
+  }
+  auto &user = *users.begin();
+  if (!AnfAlgo::CheckPrimitiveType(user.first, prim::kPrimBiasAdd) || user.second != 1) {
+    return nullptr;
+  }
+  auto bias_add = user.first->cast<CNodePtr>();
+  if (AnfAlgo::GetPrevNodeOutputInferShape(bias_add, 1).size() != 1 ||
+      AnfAlgo::GetInputDeviceDataType(bias_add, 1) != kNumberTypeFloat32) {
+    return nullptr;
+  }
+  return bias_add;
+}
+}  // namespace
+
+void Int8QuantFusion::FoldFakeQuant(const FuncGraphPtr &graph, const CNodePtr &node, const std::string &int8_name,
+                                    const CNodePtr &src_fake_quant, const CNodePtr &weight_fake_quant) const {
+  auto manager = graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  auto prim = std::make_shared<Primitive>(int8_name);
+  prim->SetAttrs(AnfAlgo::GetCNodePrimitive(node)->attrs());
+  // The inputs of the int8 kernels are the input, the weight, their ranges and the bias.
+  std::vector<std::pair<CNodePtr, size_t>> real_inputs = {
+    {src_fake_quant, kFakeQuantInputIndex}, {weight_fake_quant, kFakeQuantInputIndex},
+    {src_fake_quant, kFakeQuantMinIndex},   {src_fake_quant, kFakeQuantMaxIndex},
+    {weight_fake_quant, kFakeQuantMinIndex}, {weight_fake_quant, kFakeQuantMaxIndex}};
+  std::vector<std::string> input_names = {"x", "w", "x_min", "x_max", "w_min", "w_max"};
+  CNodePtr replaced = node;
+  auto bias_add = GetFoldableBiasAdd(manager, node);
+  if (bias_add != nullptr) {
+    real_inputs.emplace_back(bias_add, kBiasAddBiasIndex);
+    input_names.emplace_back("b");
+    replaced = bias_add;
+  }
+
+  std::vector<AnfNodePtr> int8_inputs = {NewValueNode(prim)};
+  std::vector<std::string> input_formats;
+  for (auto &real_input : real_inputs) {
+    int8_inputs.push_back(real_input.first->input(real_input.second));
+    input_formats.push_back(AnfAlgo::GetInputFormat(real_input.first, real_input.second - 1));
+  }
+  auto int8_node = graph->NewCNode(int8_inputs);
+  MS_EXCEPTION_IF_NULL(int8_node);
+  int8_node->set_scope(node->scope());
+  int8_node->set_abstract(replaced->abstract());
+  AnfAlgo::SetNodeAttr(kAttrInputNames, MakeValue(input_names), int8_node);
+  AnfAlgo::SetNodeAttr(kAttrSrcNarrowRange, MakeValue(GetBoolAttr(src_fake_quant, kAttrNarrowRange)), int8_node);
+  AnfAlgo::SetNodeAttr(kAttrSrcSymmetric, MakeValue(GetBoolAttr(src_fake_quant, kAttrSymmetric)), int8_node);
+  AnfAlgo::SetNodeAttr(kAttrWeightNarrowRange, MakeValue(GetBoolAttr(weight_fake_quant, kAttrNarrowRange)),
+                       int8_node);
+  AnfAlgo::SetNodeAttr(kAttrWeightSymmetric, MakeValue(GetBoolAttr(weight_fake_quant, kAttrSymmetric)), int8_node);
+  auto builder = std::make_shared<kernel::KernelBuildInfo::KernelBuildInfoBuilder>();
+  builder->SetInputsFormat(input_formats);
+  builder->SetInputsDeviceType(std::vector<TypeId>(input_formats.size(), kNumberTypeFloat32));
+  builder->SetOutputsFormat({AnfAlgo::GetOutputFormat(replaced, 0)});
+  builder->SetOutputsDeviceType({kNumberTypeFloat32});
+  AnfAlgo::SetSelectKernelBuildInfo(builder->Build(), int8_node.get());
+  (void)manager->Replace(replaced, int8_node);
+}
+
+bool Int8QuantFusion::Run(const FuncGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto manager = graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  bool changed = false;
+  auto node_list = TopoSort(graph->get_return());
+  for (auto &node : node_list) {
+    if (!node->isa<CNode>() || !AnfAlgo::IsRealKernel(node)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    auto name = AnfAlgo::GetCNodeName(cnode);
+    std::string int8_name;
+    size_t out_channel_axis = 0;
+    if (name == kConv2DOpName) {
+      int8_name = kInt8Conv2DOpName;
+    } else if (name == kMatMulOpName) {
+      int8_name = kInt8MatMulOpName;
+      out_channel_axis = AnfAlgo::GetNodeAttr<bool>(cnode, "transpose_b") ? 0 : 1;
+    } else {
+      continue;
+    }
+    if (AnfAlgo::GetOutputDeviceDataType(cnode, 0) != kNumberTypeFloat32) {
+      continue;
+    }
+    auto src_fake_quant = GetFoldableFakeQuant(manager, cnode, 0);
+    auto weight_fake_quant = GetFoldableFakeQuant(manager, cnode, 1);
+    if (src_fake_quant == nullptr || weight_fake_quant == nullptr || GetRangeSize(src_fake_quant) != 1 ||
+        !IsWeightRangeFoldable(weight_fake_quant, out_channel_axis)) {
+      continue;
+    }
+    MS_LOG(INFO) << "Fold the FakeQuant of " << cnode->fullname_with_scope() << " into " << int8_name;
+    FoldFakeQuant(graph, cnode, int8_name, src_fake_quant, weight_fake_quant);
+    changed = true;
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,41 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_INT8_QUANT_FUSION_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_INT8_QUANT_FUSION_H_
+#include <string>
+#include "backend/optimizer/common/pass.h"
+#include "ir/func_graph.h"
+#include "ir/anf.h"
+
+namespace mindspore {
+namespace opt {
+// Folds the 8 bits FakeQuant of the input and of the weight of a Conv2D or MatMul from a quantization aware trained
+// inference graph into an Int8Conv2D or Int8MatMul, together with the BiasAdd following it. The input needs a per
+// layer range and the weight a per layer or output channel range. A FakeQuant also used by other nodes, as the
+// backward of a training graph does, is kept. Must run after the CPU kernel selection.
+class Int8QuantFusion : public Pass {
+ public:
+  Int8QuantFusion() : Pass("int8_quant_fusion") {}
+  ~Int8QuantFusion() override = default;
+  bool Run(const FuncGraphPtr &graph) override;
+
+ private:
+  void FoldFakeQuant(const FuncGraphPtr &graph, const CNodePtr &node, const std::string &int8_name,
+                     const CNodePtr &src_fake_quant, const CNodePtr &weight_fake_quant) const;
+};
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_INT8_QUANT_FUSION_H_
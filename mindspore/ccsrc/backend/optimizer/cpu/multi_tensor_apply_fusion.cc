@@ -0,0 +1,169 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/cpu/multi_tensor_apply_fusion.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "backend/kernel_compiler/cpu/multi_tensor_apply_cpu_kernel.h"
+#include "backend/optimizer/common/helper.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "ir/manager.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+using kernel::MultiTensorApplyCPUKernel;
+
+bool IsAttachedByDepend(const std::pair<AnfNodePtr, int> &user) {
+  return AnfAlgo::CheckPrimitiveType(user.first, prim::kPrimDepend) && user.second == kDependAttachNodeIndex;
+}
+
+bool IsGroupableNode(const FuncGraphManagerPtr &manager, const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  if (!node->isa<CNode>() || !AnfAlgo::IsRealKernel(node)) {
+    return false;
+  }
+  auto cnode = node->cast<CNodePtr>();
+  if (!MultiTensorApplyFusion::IsFloat32Optimizer(cnode)) {
+    return false;
+  }
+  // The fused node keeps one output per member, the other outputs of a member can only be used for the ordering.
+  if (AnfAlgo::GetOutputTensorNum(cnode) == 1) {
+    return true;
+  }
+  auto &users = manager->node_users()[cnode];
+  return std::all_of(users.begin(), users.end(), IsAttachedByDepend);
+}
+}  // namespace
+
+bool MultiTensorApplyFusion::IsFloat32Optimizer(const CNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  size_t input_num = MultiTensorApplyCPUKernel::GetOptimizerInputNum(AnfAlgo::GetCNodeName(node));
+  if (input_num == 0 || AnfAlgo::GetInputTensorNum(node) != input_num || AnfAlgo::IsDynamicShape(node) ||
+      AnfAlgo::IsNodeDynamicShape(node) || AnfAlgo::GetOutputDeviceDataType(node, 0) != kNumberTypeFloat32) {
+    return false;
+  }
+  for (size_t i = 0; i < input_num; ++i) {
+    if (AnfAlgo::GetInputDeviceDataType(node, i) != kNumberTypeFloat32) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void MultiTensorApplyFusion::FuseGroup(const FuncGraphPtr &graph, const ApplyGroup &group) const {
+  auto manager = graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  std::vector<AnfNodePtr> fused_inputs = {NewValueNode(std::make_shared<Primitive>(kMultiTensorApplyOpName))};
+  std::vector<std::string> input_formats;
+  std::vector<TypeId> output_types;
+  std::vector<std::vector<size_t>> output_shapes;
+  std::vector<std::string> output_formats;
+  std::vector<int64_t> output_used;
+  auto &node_users = manager->node_users();
+  for (auto &node : group.nodes) {
+    size_t input_num = AnfAlgo::GetInputTensorNum(node);
+    for (size_t i = 0; i < input_num; ++i) {
+      fused_inputs.push_back(node->input(i + 1));
+      input_formats.push_back(AnfAlgo::GetInputFormat(node, i));
+    }
+    output_types.push_back(AnfAlgo::GetOutputInferDataType(node, 0));
+    output_shapes.push_back(AnfAlgo::GetOutputInferShape(node, 0));
+    output_formats.push_back(AnfAlgo::GetOutputFormat(node, 0));
+    auto &users = node_users[node];
+    output_used.push_back(std::all_of(users.begin(), users.end(), IsAttachedByDepend) ? 0 : 1);
+  }
+
+  auto fused_node = graph->NewCNode(fused_inputs);
+  MS_EXCEPTION_IF_NULL(fused_node);
+  fused_node->set_scope(group.nodes.back()->scope());
+  AnfAlgo::SetOutputInferTypeAndShape(output_types, output_shapes, fused_node.get());
+  AnfAlgo::SetNodeAttr(kAttrOptimizerName, MakeValue(group.optimizer_name), fused_node);
+  AnfAlgo::SetNodeAttr(kAttrOutputUsed, MakeValue(output_used), fused_node);
+  AnfAlgo::SetNodeAttr("use_nesterov", MakeValue(group.use_nesterov), fused_node);
+  auto builder = std::make_shared<kernel::KernelBuildInfo::KernelBuildInfoBuilder>();
+  builder->SetInputsFormat(input_formats);
+  builder->SetInputsDeviceType(std::vector<TypeId>(input_formats.size(), kNumberTypeFloat32));
+  builder->SetOutputsFormat(output_formats);
+  builder->SetOutputsDeviceType(std::vector<TypeId>(output_formats.size(), kNumberTypeFloat32));
+  AnfAlgo::SetSelectKernelBuildInfo(builder->Build(), fused_node.get());
+
+  for (size_t i = 0; i < group.nodes.size(); ++i) {
+    (void)manager->Replace(group.nodes[i], CreatTupleGetItemNode(graph, fused_node, i));
+  }
+}
+
+bool MultiTensorApplyFusion::Run(const FuncGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto manager = graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  auto node_list = TopoSort(graph->get_return());
+  std::map<AnfNodePtr, size_t> topo_index;
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    topo_index[node_list[i]] = i;
+  }
+  // The nodes of a group must not depend on each other, a node reaching the last group of its kind starts a new one.
+  std::vector<ApplyGroup> groups;
+  std::map<std::pair<std::string, bool>, size_t> last_group;
+  for (auto &node : node_list) {
+    if (!IsGroupableNode(manager, node)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    auto optimizer_name = AnfAlgo::GetCNodeName(cnode);
+    bool use_nesterov =
+      AnfAlgo::HasNodeAttr("use_nesterov", cnode) && AnfAlgo::GetNodeAttr<bool>(cnode, "use_nesterov");
+    auto key = std::make_pair(optimizer_name, use_nesterov);
+    auto iter = last_group.find(key);
+    if (iter != last_group.end()) {
+      auto &group = groups[iter->second];
+      auto &inputs = cnode->inputs();
+      if (std::none_of(inputs.begin() + 1, inputs.end(), [&group, &topo_index](const AnfNodePtr &input) {
+            return DependsOnCluster(input, group.members, group.first_index, topo_index);
+          })) {
+        group.nodes.push_back(cnode);
+        (void)group.members.insert(cnode);
+        continue;
+      }
+    }
+    ApplyGroup group;
+    group.optimizer_name = optimizer_name;
+    group.use_nesterov = use_nesterov;
+    group.nodes.push_back(cnode);
+    (void)group.members.insert(cnode);
+    group.first_index = topo_index[cnode];
+    last_group[key] = groups.size();
+    groups.push_back(group);
+  }
+
+  bool changed = false;
+  for (auto &group : groups) {
+    bool has_kernel = group.optimizer_name != kFusedAdamName && group.optimizer_name != kFusedAdamWeightDecayName;
+    if (group.nodes.size() < 2 && has_kernel) {
+      continue;
+    }
+    MS_LOG(INFO) << "Apply " << group.optimizer_name << " to " << group.nodes.size() << " parameters in one kernel";
+    FuseGroup(graph, group);
+    changed = true;
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,68 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_MULTI_TENSOR_APPLY_FUSION_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_MULTI_TENSOR_APPLY_FUSION_H_
+#include <set>
+#include <string>
+#include <vector>
+#include "backend/optimizer/common/optimizer.h"
+#include "backend/optimizer/common/pass.h"
+#include "ir/func_graph.h"
+#include "ir/anf.h"
+
+namespace mindspore {
+namespace opt {
+// Groups the Adam, ApplyMomentum, FusedAdam and FusedAdamWeightDecay nodes of the float32 parameters into
+// MultiTensorApply kernels, one per optimizer and attributes, so that the parameters are updated by a single launch.
+// FusedAdam and FusedAdamWeightDecay only have a kernel on CPU this way and are converted even when alone.
+// Must run after the CPU kernel selection and after MultiTensorApplyAdamFusion.
+class MultiTensorApplyFusion : public Pass {
+ public:
+  MultiTensorApplyFusion() : Pass("multi_tensor_apply_fusion") {}
+  ~MultiTensorApplyFusion() override = default;
+  bool Run(const FuncGraphPtr &graph) override;
+  // Whether the node is an optimizer the MultiTensorApply kernel computes, on float32 tensors of static shapes.
+  static bool IsFloat32Optimizer(const CNodePtr &node);
+
+ private:
+  struct ApplyGroup {
+    std::string optimizer_name;
+    bool use_nesterov{false};
+    std::vector<CNodePtr> nodes;
+    std::set<AnfNodePtr> members;
+    size_t first_index{0};
+  };
+  void FuseGroup(const FuncGraphPtr &graph, const ApplyGroup &group) const;
+};
+
+// Runs AdamFusion or AdamWeightDecayFusion only where MultiTensorApplyFusion takes the fused node afterwards, the
+// FusedAdam and FusedAdamWeightDecay nodes left alone would have no CPU kernel.
+template <typename AdamFusionPass>
+class MultiTensorApplyAdamFusion : public AdamFusionPass {
+ public:
+  MultiTensorApplyAdamFusion() = default;
+  ~MultiTensorApplyAdamFusion() override = default;
+  const AnfNodePtr Process(const FuncGraphPtr &graph, const AnfNodePtr &node, const EquivPtr &equiv) const override {
+    auto fused_node = AdamFusionPass::Process(graph, node, equiv);
+    if (fused_node == nullptr || !MultiTensorApplyFusion::IsFloat32Optimizer(fused_node->template cast<CNodePtr>())) {
+      return nullptr;
+    }
+    return fused_node;
+  }
+};
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_MULTI_TENSOR_APPLY_FUSION_H_
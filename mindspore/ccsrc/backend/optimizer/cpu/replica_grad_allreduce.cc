@@ -0,0 +1,132 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/cpu/replica_grad_allreduce.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "backend/session/anf_runtime_algorithm.h"
+#include "ir/manager.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+// The index of the gradient among the inputs of FusedAdam and FusedAdamWeightDecay, which have no input names.
+constexpr size_t kFusedAdamGradientIndex = 9;
+
+bool UpdatesWeight(const CNodePtr &node) {
+  size_t input_num = AnfAlgo::GetInputTensorNum(node);
+  for (size_t i = 0; i < input_num; ++i) {
+    auto input = AnfAlgo::VisitKernel(node->input(i + 1), 0).first;
+    MS_EXCEPTION_IF_NULL(input);
+    if (input->isa<Parameter>() && AnfAlgo::IsParameterWeight(input->cast<ParameterPtr>())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The index of the gradient input of an optimizer node, false when the node is not an optimizer.
+bool GetGradientIndex(const CNodePtr &node, size_t *index) {
+  MS_EXCEPTION_IF_NULL(index);
+  if (!AnfAlgo::IsRealKernel(node) || !UpdatesWeight(node)) {
+    return false;
+  }
+  auto name = AnfAlgo::GetCNodeName(node);
+  if (name == kFusedAdamName || name == kFusedAdamWeightDecayName) {
+    *index = kFusedAdamGradientIndex;
+    return true;
+  }
+  auto primitive = AnfAlgo::GetCNodePrimitive(node);
+  MS_EXCEPTION_IF_NULL(primitive);
+  auto input_names_value = primitive->GetAttr(kAttrInputNames);
+  if (input_names_value == nullptr) {
+    return false;
+  }
+  auto input_names = GetValue<std::vector<std::string>>(input_names_value);
+  auto iter = std::find(input_names.begin(), input_names.end(), "gradient");
+  if (iter == input_names.end()) {
+    iter = std::find(input_names.begin(), input_names.end(), "grad");
+  }
+  if (iter == input_names.end()) {
+    return false;
+  }
+  if (std::find(input_names.begin(), input_names.end(), "indices") != input_names.end()) {
+    MS_LOG(EXCEPTION) << "The sparse optimizer " << name << " does not support averaging its gradient on CPU.";
+  }
+  *index = static_cast<size_t>(iter - input_names.begin());
+  return *index < AnfAlgo::GetInputTensorNum(node);
+}
+}  // namespace
+
+CNodePtr ReplicaGradAllReduce::CreateAllReduce(const FuncGraphPtr &graph, const CNodePtr &optimizer,
+                                               size_t gradient_index) const {
+  auto dtype = AnfAlgo::GetInputDeviceDataType(optimizer, gradient_index);
+  if (dtype != kNumberTypeFloat32) {
+    MS_LOG(EXCEPTION) << "The gradient of " << AnfAlgo::GetCNodeName(optimizer) << " is " << TypeIdLabel(dtype)
+                      << ", but only the float32 gradients can be averaged on CPU.";
+  }
+  auto prim = std::make_shared<Primitive>(kAllReduceOpName);
+  auto all_reduce = graph->NewCNode({NewValueNode(prim), optimizer->input(gradient_index + 1)});
+  MS_EXCEPTION_IF_NULL(all_reduce);
+  all_reduce->set_scope(optimizer->scope());
+  AnfAlgo::SetOutputInferTypeAndShape({AnfAlgo::GetPrevNodeOutputInferDataType(optimizer, gradient_index)},
+                                      {AnfAlgo::GetPrevNodeOutputInferShape(optimizer, gradient_index)},
+                                      all_reduce.get());
+  AnfAlgo::SetNodeAttr(kAttrOp, MakeValue(std::string("sum")), all_reduce);
+  AnfAlgo::SetNodeAttr(kAttrGroup, MakeValue(group_), all_reduce);
+  AnfAlgo::SetNodeAttr(kAttrReplicaId, MakeValue(SizeToLong(replica_id_)), all_reduce);
+  AnfAlgo::SetNodeAttr(kAttrMean, MakeValue(true), all_reduce);
+  auto format = AnfAlgo::GetInputFormat(optimizer, gradient_index);
+  auto builder = std::make_shared<kernel::KernelBuildInfo::KernelBuildInfoBuilder>();
+  builder->SetInputsFormat({format});
+  builder->SetInputsDeviceType({kNumberTypeFloat32});
+  builder->SetOutputsFormat({format});
+  builder->SetOutputsDeviceType({kNumberTypeFloat32});
+  AnfAlgo::SetSelectKernelBuildInfo(builder->Build(), all_reduce.get());
+  return all_reduce;
+}
+
+bool ReplicaGradAllReduce::Run(const FuncGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto manager = graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  // A gradient used by several optimizers is reduced once.
+  std::map<AnfNodePtr, CNodePtr> reduced_gradients;
+  for (auto &node : TopoSort(graph->get_return())) {
+    if (!node->isa<CNode>()) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    size_t gradient_index = 0;
+    if (!GetGradientIndex(cnode, &gradient_index)) {
+      continue;
+    }
+    auto gradient = cnode->input(gradient_index + 1);
+    auto iter = reduced_gradients.find(gradient);
+    if (iter == reduced_gradients.end()) {
+      iter = reduced_gradients.emplace(gradient, CreateAllReduce(graph, cnode, gradient_index)).first;
+    }
+    manager->SetEdge(cnode, SizeToInt(gradient_index + 1), iter->second);
+  }
+  MS_LOG(INFO) << "Insert " << reduced_gradients.size() << " gradient AllReduce over " << group_ << " for replica "
+               << replica_id_;
+  return !reduced_gradients.empty();
+}
+}  // namespace opt
+}  // namespace mindspore
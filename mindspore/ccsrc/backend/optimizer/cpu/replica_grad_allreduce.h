@@ -0,0 +1,48 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_REPLICA_GRAD_ALLREDUCE_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_REPLICA_GRAD_ALLREDUCE_H_
+#include <string>
+#include "backend/optimizer/common/pass.h"
+#include "ir/func_graph.h"
+#include "ir/anf.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+// Inserts a mean AllReduce over the replicas of cpu_replica_num in front of the gradient of every optimizer node of
+// the replica replica_id, so that the replicas apply the same gradient and keep the same weights. With the group
+// cpu_mpi_world_group, the mean is over the processes of the MPI world instead, see enable_cpu_grad_allreduce. An
+// optimizer node updates a weight parameter and has an input named gradient or grad, the sparse ones are not
+// supported. The AllReduce of a gradient is ready as soon as the gradient is, it can run while the rest of the
+// backward does.
+// Must run after the CPU kernel selection and after AdamFusion, and before MultiTensorApplyFusion.
+class ReplicaGradAllReduce : public Pass {
+ public:
+  explicit ReplicaGradAllReduce(size_t replica_id, const std::string &group = kValueCPUReplicaGroup)
+      : Pass("replica_grad_allreduce"), replica_id_(replica_id), group_(group) {}
+  ~ReplicaGradAllReduce() override = default;
+  bool Run(const FuncGraphPtr &graph) override;
+
+ private:
+  CNodePtr CreateAllReduce(const FuncGraphPtr &graph, const CNodePtr &optimizer, size_t gradient_index) const;
+
+  size_t replica_id_;
+  std::string group_;
+};
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_REPLICA_GRAD_ALLREDUCE_H_
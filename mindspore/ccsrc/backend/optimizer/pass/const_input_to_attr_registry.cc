@@ -53,6 +53,8 @@ ConstInputToAttrInfoRegistry::ConstInputToAttrInfoRegistry() {
   Register(prim::kPrimReduceAny->name(), {1});
   Register(prim::kPrimUnsortedSegmentMin->name(), {2});
   Register(prim::kPrimUnsortedSegmentMax->name(), {2});
+  Register(prim::kPrimSparseTensorDenseMatmul->name(), {2});
+  Register(prim::kPrimCSRSparseDenseMatmul->name(), {3});
   Register(kSparseGatherV2, {2});
   Register(kUnsortedSegmentProdOpName, {2});
   Register(kSimpleMeanGradOpName, {1});
@@ -23,6 +23,7 @@
 #include "backend/session/kernel_graph.h"
 #include "runtime/device/cpu/cpu_kernel_runtime.h"
 #include "backend/session/session_factory.h"
+#include "common/thread_pool.h"
 namespace mindspore {
 namespace session {
 class CPUSession : public SessionBasic {
@@ -30,6 +31,8 @@ class CPUSession : public SessionBasic {
   CPUSession() = default;
   ~CPUSession() override = default;
   void Init(uint32_t device_id) override { InitExecutor(kCPUDevice, device_id); }
+  // Also releases the runtime resource of the graphs, their replicas, the replica runtimes and the weight copies.
+  void ClearGraph() override;
 
  protected:
   void UnifyMindIR(const KernelGraphPtr &graph) override { return; }
@@ -39,6 +42,7 @@ class CPUSession : public SessionBasic {
   void RunGraphImpl(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs) override;
   ParameterPtr CreateNewParameterFromParameter(const AnfNodePtr &anf, KernelGraph *graph) override;
   void Optimize(const std::shared_ptr<KernelGraph> &kernel_graph);
+  void FusionOptimize(const std::shared_ptr<KernelGraph> &kernel_graph, size_t replica_id = 0);
   void BuildOpImpl(const OpRunInfo &op_run_info, const GraphInfo &graph_info,
                    const std::vector<tensor::TensorPtr> &input_tensors,
                    const std::vector<int64_t> &tensors_mask) override;
@@ -50,7 +54,27 @@ class CPUSession : public SessionBasic {
   void BuildKernel(const KernelGraph *kernel_graph);
   void SetOutputFlags(const VectorRef &base_ref, std::vector<tensor::TensorPtr> *outputs_tensors);
   void SyncValueNodeDeviceAddr(const std::shared_ptr<KernelGraph> &kernel_graph);
+  void CompileKernelGraph(const KernelGraphPtr &graph, size_t replica_id, device::cpu::CPUKernelRuntime *runtime);
+  // Runs the replicas of a graph on their own threads, each one on its slice of the inputs, see cpu_replica_num.
+  void RunReplicas(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs);
+  tensor::TensorPtr GetReplicaInput(const GraphId &graph_id, const AnfNodePtr &input_node,
+                                    const tensor::TensorPtr &tensor, size_t replica_id, size_t replica_num);
   device::cpu::CPUKernelRuntime runtime_;
+  // The replica i > 0 of a graph is compiled into replica_graphs_[graph_id][i - 1] and run by replica_runtimes_[i - 1]
+  // with its own memory, the replica 0 is the graph itself.
+  std::map<GraphId, std::vector<KernelGraphPtr>> replica_graphs_;
+  std::vector<std::shared_ptr<device::cpu::CPUKernelRuntime>> replica_runtimes_;
+  // The thread pool of each replica, bound to the cores of the replica, see GetReplicaCores. The kernels and the
+  // collective chunks of a replica run on its pool rather than on the process-wide one.
+  std::vector<std::shared_ptr<common::ThreadPool>> replica_pools_;
+  // The private copies of the weights of the replicas i > 0, and the data of the weight each one was copied from,
+  // keyed by the graph id then the name of the weight parameter so that the weight tensors themselves are not kept
+  // alive, and the graphs sharing a parameter name keep their own copies.
+  struct ReplicaWeight {
+    std::vector<tensor::TensorPtr> copies_;
+    std::vector<void *> synced_data_;
+  };
+  std::map<GraphId, std::map<std::string, ReplicaWeight>> replica_weights_;
 };
 MS_REG_SESSION(kCPUDevice, CPUSession);
 }  // namespace session
@@ -17,273 +17,380 @@
 #include "common/thread_pool.h"
 #include <algorithm>
 #include <exception>
+#if defined(__linux__)
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
 #include "utils/log_adapter.h"
 #include "utils/convert_utils_base.h"
 #include "utils/ms_exception.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace common {
 #ifdef ENABLE_D
-const int kDeviceNum = 8;
+const size_t kDeviceNum = 8;
 #endif
-const int kMaxThreadNum = 23;
-bool Queue::Enqueue(Task *task) {
-  const int tail_index = tail_.load(std::memory_order_relaxed);
-  // queue full
-  auto next = (tail_index + 1) % 2;
-  if (next == head_.load(std::memory_order_acquire)) {
-    return false;
-  }
-  buffer_[tail_index] = task;
-  tail_.store(next, std::memory_order_release);
-  ++task_size_;
-  return true;
-}
+const size_t kMaxThreadNum = 23;
+// Idle workers yield for a while before sleeping, so back-to-back kernels do not pay a wakeup.
+const size_t kWorkerSpinCount = 2000;
+const size_t kChunkNumPerThread = 4;
 
-bool Queue::Dequeue(Task **out) {
-  if (task_size_ == 0) {
-    return false;
+namespace {
+// The pool GetInstance returns on this thread, nullptr for the process-wide pool.
+thread_local ThreadPool *current_thread_pool = nullptr;
+
+int GetNumaNode(int core) {
+#if defined(__linux__)
+  std::string cpu_path = "/sys/devices/system/cpu/cpu" + std::to_string(core);
+  DIR *dir = opendir(cpu_path.c_str());
+  if (dir == nullptr) {
+    return 0;
   }
-  // queue empty
-  const int head_index = head_.load(std::memory_order_relaxed);
-  if (head_index == tail_.load(std::memory_order_acquire)) {
-    return false;
+  int numa_node = 0;
+  struct dirent *entry = nullptr;
+  while ((entry = readdir(dir)) != nullptr) {
+    std::string name = entry->d_name;
+    const std::string prefix = "node";
+    if (name.size() > prefix.size() && name.compare(0, prefix.size(), prefix) == 0 &&
+        std::all_of(name.begin() + prefix.size(), name.end(), ::isdigit)) {
+      numa_node = std::stoi(name.substr(prefix.size()));
+      break;
+    }
   }
-  *out = buffer_[head_index];
-  head_.store((head_index + 1) % 2, std::memory_order_release);
-  return true;
+  (void)closedir(dir);
+  return numa_node;
+#else
+  return 0;
+#endif
 }
+}  // namespace
 
 ThreadPool::ThreadPool() {
-  int process_core_num = std::thread::hardware_concurrency() - 1;
-  if (process_core_num < 1) {
-    process_core_num = 1;
-  }
+  size_t process_core_num = std::max(std::thread::hardware_concurrency(), 1U);
 #ifdef ENABLE_D
   max_thread_num_ = process_core_num / kDeviceNum;
 #else
   max_thread_num_ = process_core_num;
 #endif
+  if (max_thread_num_ > kMaxThreadNum) {
+    max_thread_num_ = kMaxThreadNum;
+  }
+  auto thread_num_env = GetEnv(kThreadNumEnv);
+  if (!thread_num_env.empty()) {
+    // stoul wraps a negative value around to a huge one, parse it signed and reject the non positive values.
+    int thread_num = 0;
+    try {
+      thread_num = std::stoi(thread_num_env);
+    } catch (std::exception &e) {
+      thread_num = 0;
+    }
+    if (thread_num > 0) {
+      max_thread_num_ = static_cast<size_t>(thread_num);
+    } else {
+      MS_LOG(WARNING) << "Invalid " << kThreadNumEnv << " [" << thread_num_env << "], use " << max_thread_num_;
+    }
+  }
   if (max_thread_num_ < 1) {
     max_thread_num_ = 1;
   }
-  if (max_thread_num_ > kMaxThreadNum) {
-    max_thread_num_ = kMaxThreadNum;
+  bind_core_ = GetEnv(kBindCoreEnv) == "1";
+  // The caller thread takes part in the work, leave the first core to it.
+  for (size_t i = 0; i + 1 < max_thread_num_; ++i) {
+    int core = SizeToInt((i + 1) % process_core_num);
+    worker_cores_.push_back(core);
+    worker_numa_nodes_.push_back(GetNumaNode(core));
   }
+  MS_LOG(INFO) << "Thread pool max thread num " << max_thread_num_ << ", bind core " << bind_core_;
 }
 
-bool ThreadPool::SetThreadPool(int config_thread_num) {
-  if (config_thread_num > max_thread_num_) {
-    MS_LOG(EXCEPTION) << "Expected thread num is greater than the max thread num, expected thread num="
-                      << config_thread_num << ", allowed max thread num=" << max_thread_num_;
-  }
-  if (config_thread_num > cur_thread_nums_) {
-    AddNewThread(config_thread_num - cur_thread_nums_);
+ThreadPool::ThreadPool(const std::vector<int> &cores) {
+  max_thread_num_ = std::max(cores.size(), static_cast<size_t>(1));
+  bind_core_ = true;
+  for (size_t i = 1; i < cores.size(); ++i) {
+    worker_cores_.push_back(cores[i]);
+    worker_numa_nodes_.push_back(GetNumaNode(cores[i]));
   }
-  MS_LOG(DEBUG) << "cur_thread_nums_=" << cur_thread_nums_ << ", cur_thread_run_nums_=" << cur_thread_run_nums_;
-  return true;
+  MS_LOG(INFO) << "Thread pool of " << max_thread_num_ << " threads bound to " << cores.size() << " cores";
 }
 
-void ThreadPool::AddNewThread(int add_num) {
-  for (int i = cur_thread_nums_, j = 0; j < add_num; ++i, ++j) {
-    auto active = new std::atomic_bool{true};
-    auto queue = std::make_shared<Queue>();
-    std::thread thread([this, i, active, queue]() {
-      Task *task = nullptr;
-      while (!exit_run_) {
-        while (*active) {
-          if (queue->Dequeue(&task)) {
-            int ret;
-            try {
-              ret = (*task)();
-            } catch (std::exception &e) {
-              ret = FAIL;
-              MsException::Instance().SetException();
-            }
-            if (ret != SUCCESS) {
-              error_info_.emplace_back(std::make_pair(i, std::make_pair(false, ret)));
-            }
-            queue->task_size_--;
-          }
-          std::this_thread::yield();
-        }
-        std::unique_lock<std::mutex> queue_lock(thread_mtx_);
-        queue_ready_.wait(queue_lock, [active, this] { return exit_run_ || *active; });
-      }
-    });
-    thread_list_.emplace_back(std::move(thread));
-    activate_list_.emplace_back(active);
-    queue_list_.emplace_back(queue);
-  }
-  cur_thread_nums_ += add_num;
-  cur_thread_run_nums_ += add_num;
-  MS_LOG(INFO) << "add " << add_num << " thread";
+void ThreadPool::BindCore(size_t worker_id) {
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(worker_cores_[worker_id], &cpu_set);
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) != 0) {
+    MS_LOG(WARNING) << "Bind thread pool worker " << worker_id << " to core " << worker_cores_[worker_id] << " failed";
+  }
+#endif
 }
 
-void ThreadPool::AddRunThread(int num) {
-  MS_LOG(DEBUG) << "num=" << num << ", cur_thread_run_nums_=" << cur_thread_run_nums_;
-  int active_nums = num - cur_thread_run_nums_;
-  if (active_nums <= 0 || static_cast<int>(activate_list_.size()) < active_nums) {
+void ThreadPool::StartWorkers() {
+  if (started_) {
     return;
   }
-  for (int i = cur_thread_run_nums_ - 1, j = 0; j < active_nums; ++i, ++j) {
-    *activate_list_[i] = true;
+  std::lock_guard<std::mutex> pool_lock(pool_mtx_);
+  if (started_) {
+    return;
+  }
+  exit_run_ = false;
+  for (size_t i = 0; i < worker_cores_.size(); ++i) {
+    workers_.emplace_back(std::thread(&ThreadPool::WorkerLoop, this, i));
   }
-  std::lock_guard<std::mutex> queueLock(thread_mtx_);
-  queue_ready_.notify_all();
-  cur_thread_run_nums_ = num;
+  started_ = true;
+  MS_LOG(INFO) << "Start " << workers_.size() << " thread pool workers";
 }
 
-void ThreadPool::SubRunThread(int num) {
-  MS_LOG(DEBUG) << "sub num=" << num << ", cur_thread_run_nums_=" << cur_thread_run_nums_;
-  int deactive_nums = cur_thread_run_nums_ - num;
-  if (deactive_nums <= 0) {
-    return;
+void ThreadPool::WorkerLoop(size_t worker_id) {
+  if (bind_core_) {
+    BindCore(worker_id);
   }
-  for (int i = num, j = 0; j < deactive_nums; ++i, ++j) {
-    *activate_list_[i] = false;
+  current_thread_pool = this;
+  int numa_node = worker_numa_nodes_[worker_id];
+  while (!exit_run_) {
+    size_t slot = 0;
+    auto job = AcquireJob(&slot);
+    if (job != nullptr) {
+      RunJob(job, slot, numa_node);
+      // The last access of the worker to the job, the caller reuses the job once all the joined workers left.
+      ++job->left_;
+    }
   }
-  cur_thread_run_nums_ = num;
 }
 
-void ThreadPool::SyncRunLoop() {
-  while (true) {
-    Task task;
-    {
-      std::unique_lock<std::mutex> lock(task_mutex_);
-      task_cond_var_.wait(lock, [this] { return !task_queue_.empty() || exit_run_; });
-      if (exit_run_) {
-        return;
+ParallelJobPtr ThreadPool::AcquireJob(size_t *slot) {
+  for (size_t i = 0; i < kWorkerSpinCount && pending_job_num_ == 0 && !exit_run_; ++i) {
+    std::this_thread::yield();
+  }
+  std::unique_lock<std::mutex> job_lock(job_mtx_);
+  job_cond_var_.wait(job_lock, [this] { return exit_run_ || pending_job_num_ > 0; });
+  while (!exit_run_ && !jobs_.empty()) {
+    auto job = jobs_.front();
+    if (job->exhausted_ || job->joined_ >= job->slot_num_) {
+      (void)jobs_.erase(jobs_.begin());
+      --pending_job_num_;
+      continue;
+    }
+    *slot = job->joined_++;
+    return job;
+  }
+  return nullptr;
+}
+
+bool ThreadPool::TakeChunk(const ParallelJobPtr &job, size_t slot, size_t *start, size_t *end) {
+  auto &range = job->ranges_[slot];
+  std::lock_guard<std::mutex> range_lock(range.mutex_);
+  if (range.begin_ >= range.end_) {
+    return false;
+  }
+  *start = range.begin_;
+  *end = std::min(range.begin_ + job->grain_, range.end_);
+  range.begin_ = *end;
+  return true;
+}
+
+bool ThreadPool::StealChunk(const ParallelJobPtr &job, size_t slot, int numa_node) {
+  // Steal half of the remaining work of a victim, the victims on the same numa node first.
+  for (int pass = 0; pass < 2; ++pass) {
+    for (size_t i = 1; i < job->slot_num_; ++i) {
+      auto &victim = job->ranges_[(slot + i) % job->slot_num_];
+      bool same_node = numa_node < 0 || victim.numa_node_ < 0 || victim.numa_node_ == numa_node;
+      if (pass == 0 && !same_node) {
+        continue;
+      }
+      size_t steal_begin = 0;
+      size_t steal_end = 0;
+      {
+        std::lock_guard<std::mutex> victim_lock(victim.mutex_);
+        if (victim.begin_ >= victim.end_) {
+          continue;
+        }
+        size_t remain = victim.end_ - victim.begin_;
+        size_t steal_num = remain <= job->grain_ ? remain : remain / 2;
+        steal_end = victim.end_;
+        steal_begin = steal_end - steal_num;
+        victim.end_ = steal_begin;
       }
-      task = task_queue_.front();
-      task_queue_.pop();
+      auto &own = job->ranges_[slot];
+      std::lock_guard<std::mutex> own_lock(own.mutex_);
+      own.begin_ = steal_begin;
+      own.end_ = steal_end;
+      return true;
     }
+  }
+  return false;
+}
+
+void ThreadPool::RunJob(const ParallelJobPtr &job, size_t slot, int numa_node) {
+  job->ranges_[slot].numa_node_ = numa_node;
+  size_t start = 0;
+  size_t end = 0;
+  while (TakeChunk(job, slot, &start, &end) ||
+         (StealChunk(job, slot, numa_node) && TakeChunk(job, slot, &start, &end))) {
     try {
-      task();
-    } catch (std::exception &e) {
-      MsException::Instance().SetException();
+      (*job->task_)(start, end);
+    } catch (...) {
+      std::lock_guard<std::mutex> job_lock(job->mutex_);
+      if (job->exception_ == nullptr) {
+        job->exception_ = std::current_exception();
+      }
     }
-    {
-      std::unique_lock<std::mutex> task_lock(task_mutex_);
-      task_finished_count_ = task_finished_count_ + 1;
+    size_t finished = job->finished_.fetch_add(end - start) + (end - start);
+    if (finished == job->count_) {
+      std::lock_guard<std::mutex> job_lock(job->mutex_);
+      job->finished_cond_var_.notify_all();
     }
-    finished_cond_var_.notify_one();
   }
+  job->exhausted_ = true;
 }
 
-bool ThreadPool::SyncRun(const std::vector<Task> &tasks) {
-  if (tasks.size() == 1) {
-    auto ret = tasks[0]();
-    return ret == SUCCESS;
-  }
-  std::unique_lock<std::mutex> lock(pool_mtx_);
-  exit_run_ = false;
-  int task_num = tasks.size();
-  int thread_num = sync_run_threads_.size();
-  if (thread_num < max_thread_num_ && thread_num < task_num) {
-    auto new_thread_num = max_thread_num_;
-    if (task_num < max_thread_num_) {
-      new_thread_num = task_num;
-    }
-    for (int i = thread_num; i < new_thread_num; ++i) {
-      sync_run_threads_.emplace_back(std::thread(&ThreadPool::SyncRunLoop, this));
+ParallelJobPtr ThreadPool::NewJob(size_t slot_num) {
+  ParallelJobPtr job = nullptr;
+  {
+    std::lock_guard<std::mutex> job_lock(job_mtx_);
+    if (!free_jobs_.empty()) {
+      job = free_jobs_.back();
+      free_jobs_.pop_back();
     }
   }
-
-  for (auto &task : tasks) {
-    std::lock_guard<std::mutex> task_lock(task_mutex_);
-    task_queue_.push(task);
-    task_cond_var_.notify_one();
+  if (job == nullptr) {
+    job = std::make_shared<ParallelJob>(max_thread_num_);
+    ++job_num_;
   }
-  {
-    std::unique_lock<std::mutex> task_lock(task_mutex_);
-    finished_cond_var_.wait(task_lock, [this, task_num] { return task_num == task_finished_count_; });
-    task_finished_count_ = 0;
+  job->slot_num_ = slot_num;
+  for (size_t i = 0; i < slot_num; ++i) {
+    job->ranges_[i].numa_node_ = -1;
   }
-  return true;
+  // The caller takes the first slot.
+  job->joined_ = 1;
+  job->left_ = 0;
+  job->finished_ = 0;
+  job->exhausted_ = false;
+  job->exception_ = nullptr;
+  return job;
 }
 
-bool ThreadPool::InnerSyncRun(const std::vector<Task> &tasks) {
-  std::lock_guard<std::mutex> sync_run_lock(pool_mtx_);
-  int thread_num = tasks.size();
-  if (thread_num > max_thread_num_) {
-    thread_num = max_thread_num_;
+void ThreadPool::ReleaseJob(const ParallelJobPtr &job) {
+  job->task_ = nullptr;
+  std::lock_guard<std::mutex> job_lock(job_mtx_);
+  free_jobs_.push_back(job);
+}
+
+void ThreadPool::ParallelFor(const ParallelTask &task, size_t count, size_t grain, size_t max_thread_num) {
+  if (count == 0) {
+    return;
   }
-  if (!SetThreadPool(thread_num)) {
-    return false;
+  size_t thread_num = max_thread_num == 0 ? max_thread_num_ : std::min(max_thread_num, max_thread_num_);
+  if (grain == 0) {
+    grain = std::max(count / (thread_num * kChunkNumPerThread), static_cast<size_t>(1));
   }
-  error_info_.clear();
-  bool succ_flag;
-  for (int task_id = 0, queue_index = 0; task_id < SizeToInt(tasks.size()); ++task_id) {
-    do {
-      succ_flag = true;
-      if (!queue_list_[queue_index]->Enqueue(const_cast<Task *>(&tasks[task_id]))) {
-        std::this_thread::yield();
-        succ_flag = false;
-      }
-    } while (!succ_flag);
-    queue_index++;
-    if (queue_index >= cur_thread_run_nums_) {
-      queue_index = queue_index - cur_thread_run_nums_;
+  size_t slot_num = std::min(thread_num, (count + grain - 1) / grain);
+  if (slot_num <= 1) {
+    task(0, count);
+    return;
+  }
+  StartWorkers();
+  auto job = NewJob(slot_num);
+  job->task_ = &task;
+  job->count_ = count;
+  job->grain_ = grain;
+  size_t range_size = count / slot_num;
+  size_t range_remain = count % slot_num;
+  size_t range_begin = 0;
+  for (size_t i = 0; i < slot_num; ++i) {
+    job->ranges_[i].begin_ = range_begin;
+    range_begin += range_size + (i < range_remain ? 1 : 0);
+    job->ranges_[i].end_ = range_begin;
+  }
+  {
+    std::lock_guard<std::mutex> job_lock(job_mtx_);
+    jobs_.push_back(job);
+    ++pending_job_num_;
+  }
+  if (slot_num - 1 >= workers_.size()) {
+    job_cond_var_.notify_all();
+  } else {
+    for (size_t i = 1; i < slot_num; ++i) {
+      job_cond_var_.notify_one();
     }
   }
-  succ_flag = false;
-  while (!succ_flag) {
-    std::this_thread::yield();
-    succ_flag = true;
-    for (int i = 0; i < cur_thread_run_nums_; ++i) {
-      if (queue_list_[i]->task_size_ != 0) {
-        succ_flag = false;
-        break;
-      }
+  RunJob(job, 0, -1);
+  {
+    std::unique_lock<std::mutex> job_lock(job->mutex_);
+    job->finished_cond_var_.wait(job_lock, [&job] { return job->finished_ == job->count_; });
+  }
+  {
+    std::lock_guard<std::mutex> job_lock(job_mtx_);
+    auto iter = std::find(jobs_.begin(), jobs_.end(), job);
+    if (iter != jobs_.end()) {
+      (void)jobs_.erase(iter);
+      --pending_job_num_;
     }
   }
-  MS_LOG(INFO) << "Finish " << tasks.size() << " task successful";
-  return CheckResult();
+  // No worker joins the job any more, wait for the joined ones to leave it before it is reused.
+  while (job->left_ + 1 < job->joined_) {
+    std::this_thread::yield();
+  }
+  auto exception = job->exception_;
+  ReleaseJob(job);
+  if (exception != nullptr) {
+    std::rethrow_exception(exception);
+  }
 }
 
-bool ThreadPool::CheckResult() {
-  bool succ_flag = true;
-  for (auto result : error_info_) {
-    if (result.second.first) {
-      MS_LOG(ERROR) << "task " << result.first << " failed, error code is " << result.second.second;
-      succ_flag = false;
-    }
+bool ThreadPool::SyncRun(const std::vector<Task> &tasks) {
+  if (tasks.empty()) {
+    return true;
   }
+  if (tasks.size() == 1) {
+    auto ret = tasks[0]();
+    return ret == SUCCESS;
+  }
+  std::atomic_bool succ_flag{true};
+  auto task = [&tasks, &succ_flag](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      try {
+        if (tasks[i]() != SUCCESS) {
+          succ_flag = false;
+        }
+      } catch (std::exception &e) {
+        succ_flag = false;
+        MsException::Instance().SetException();
+      }
+    }
+  };
+  ParallelFor(task, tasks.size(), 1);
   return succ_flag;
 }
 
 ThreadPool &ThreadPool::GetInstance() {
+  if (current_thread_pool != nullptr) {
+    return *current_thread_pool;
+  }
   static ThreadPool instance;
   return instance;
 }
 
+void ThreadPool::SetCurrentThreadPool(ThreadPool *pool) { current_thread_pool = pool; }
+
 void ThreadPool::ClearThreadPool() {
-  std::lock_guard<std::mutex> sync_run_lock(pool_mtx_);
-  if (exit_run_) {
+  std::lock_guard<std::mutex> pool_lock(pool_mtx_);
+  if (!started_) {
     return;
   }
-  exit_run_ = true;
-  cur_thread_run_nums_ = static_cast<int>(thread_list_.size());
-  SubRunThread(0);
-  queue_ready_.notify_all();
-  task_cond_var_.notify_all();
-  for (auto &it : sync_run_threads_) {
-    if (it.joinable()) {
-      it.join();
-    }
+  {
+    std::lock_guard<std::mutex> job_lock(job_mtx_);
+    exit_run_ = true;
   }
-  sync_run_threads_.clear();
-  for (auto &it : thread_list_) {
+  job_cond_var_.notify_all();
+  for (auto &it : workers_) {
     if (it.joinable()) {
       it.join();
     }
   }
-  thread_list_.clear();
-  for (const auto &it : activate_list_) {
-    delete it;
-  }
-  activate_list_.clear();
+  workers_.clear();
+  started_ = false;
 }
 
 ThreadPool::~ThreadPool() { ClearThreadPool(); }
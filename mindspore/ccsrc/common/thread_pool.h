@@ -21,74 +21,104 @@
 #include <condition_variable>
 #include <thread>
 #include <vector>
-#include <queue>
 #include <string>
 #include <atomic>
 #include <memory>
 #include <utility>
 #include <functional>
-#include <iostream>
+#include <exception>
 #include "utils/log_adapter.h"
 
 namespace mindspore {
 namespace common {
-const int kCoreThreadNum = 3;
-const int kDefaultMaxThreadNum = 8;
 enum Status { FAIL = -1, SUCCESS = 0 };
 using Task = std::function<int()>;
+// A parallel task processes the elements in [start, end).
+using ParallelTask = std::function<void(size_t, size_t)>;
 
-class Queue {
- public:
-  Queue() = default;
-  ~Queue() = default;
-  bool Enqueue(Task *task);
-  bool Dequeue(Task **out);
-  std::atomic_int task_size_ = {0};
+// Environment variables to configure the process-wide thread pool.
+constexpr char kThreadNumEnv[] = "MS_CPU_THREAD_NUM";
+constexpr char kBindCoreEnv[] = "MS_CPU_BIND_CORE";
 
- private:
-  std::atomic_int head_ = {0};
-  std::atomic_int tail_ = {0};
-  Task *buffer_[2]{};
+// A contiguous range of elements owned by one participant of a job, other participants steal from its tail.
+struct WorkRange {
+  std::mutex mutex_;
+  size_t begin_{0};
+  size_t end_{0};
+  std::atomic_int numa_node_{-1};
+};
+
+// A job is reused by the following ParallelFor calls once it finishes, ranges_ holds the most slots a job can have and
+// only the first slot_num_ of them are used.
+struct ParallelJob {
+  explicit ParallelJob(size_t max_slot_num) : ranges_(max_slot_num) {}
+  const ParallelTask *task_{nullptr};
+  size_t count_{0};
+  size_t grain_{1};
+  size_t slot_num_{0};
+  std::vector<WorkRange> ranges_;
+  std::atomic<size_t> joined_{0};
+  // The number of joined workers that are done with the job.
+  std::atomic<size_t> left_{0};
+  std::atomic<size_t> finished_{0};
+  std::atomic_bool exhausted_{false};
+  std::mutex mutex_;
+  std::condition_variable finished_cond_var_;
+  std::exception_ptr exception_{nullptr};
 };
+using ParallelJobPtr = std::shared_ptr<ParallelJob>;
 
+// A persistent work-stealing thread pool shared by all CPU kernels. The caller thread always takes part in the
+// work, so nested parallel calls from inside a task never deadlock.
 class ThreadPool {
  public:
+  // A pool of cores.size() threads including the caller, its workers are bound to the cores after the first one,
+  // which is left to the caller. Used to run a part of the work, e.g. a CPU replica, apart from the process pool.
+  explicit ThreadPool(const std::vector<int> &cores);
   ~ThreadPool();
   ThreadPool(const ThreadPool &) = delete;
   ThreadPool &operator=(const ThreadPool &) = delete;
+  // The current pool of the calling thread, the process-wide pool unless another one is set.
   static ThreadPool &GetInstance();
+  // Makes pool the current pool of the calling thread, nullptr goes back to the process-wide pool. The workers of a
+  // pool have it as their current pool, so the nested parallel calls of its tasks stay on it.
+  static void SetCurrentThreadPool(ThreadPool *pool);
   bool SyncRun(const std::vector<Task> &tasks);
+  // Split [0, count) into chunks of at least grain elements and run them in parallel, at most max_thread_num
+  // threads (including the caller) take part, 0 means all the threads of the pool.
+  void ParallelFor(const ParallelTask &task, size_t count, size_t grain = 0, size_t max_thread_num = 0);
   size_t GetSyncRunThreadNum() { return max_thread_num_; }
+  // The number of job objects created so far, it stops growing once the nesting depth of the parallel calls is reached.
+  size_t GetJobNum() const { return job_num_; }
   void ClearThreadPool();
 
  private:
   ThreadPool();
-  bool SetThreadPool(int config_thread_num);
-  void AddNewThread(int add_num);
-  void AddRunThread(int num);
-  void SubRunThread(int num);
-  bool CheckResult();
-  bool InnerSyncRun(const std::vector<Task> &tasks);
-  void SyncRunLoop();
+  void StartWorkers();
+  void WorkerLoop(size_t worker_id);
+  ParallelJobPtr NewJob(size_t slot_num);
+  void ReleaseJob(const ParallelJobPtr &job);
+  ParallelJobPtr AcquireJob(size_t *slot);
+  void RunJob(const ParallelJobPtr &job, size_t slot, int numa_node);
+  bool TakeChunk(const ParallelJobPtr &job, size_t slot, size_t *start, size_t *end);
+  bool StealChunk(const ParallelJobPtr &job, size_t slot, int numa_node);
+  void BindCore(size_t worker_id);
 
-  int cur_thread_nums_{0};
-  int cur_thread_run_nums_{0};
-  int core_thread_num_{kCoreThreadNum};
-  int max_thread_num_{kDefaultMaxThreadNum};
+  size_t max_thread_num_{1};
+  bool bind_core_{false};
+  std::vector<int> worker_cores_;
+  std::vector<int> worker_numa_nodes_;
   std::mutex pool_mtx_;
-  std::mutex thread_mtx_;
-  std::condition_variable queue_ready_;
-  std::atomic_bool exit_run_ = {false};
-  std::vector<std::atomic_bool *> activate_list_{};
-  std::vector<std::thread> thread_list_{};
-  std::vector<std::shared_ptr<Queue>> queue_list_{};
-  std::vector<std::pair<int, std::pair<bool, int>>> error_info_{};
-  std::queue<Task> task_queue_;
-  std::mutex task_mutex_;
-  std::condition_variable task_cond_var_;
-  int task_finished_count_{0};
-  std::condition_variable finished_cond_var_;
-  std::vector<std::thread> sync_run_threads_{};
+  std::mutex job_mtx_;
+  std::condition_variable job_cond_var_;
+  // Vectors rather than deques, so that no memory is allocated once they reach their working size.
+  std::vector<ParallelJobPtr> jobs_;
+  std::vector<ParallelJobPtr> free_jobs_;
+  std::atomic<size_t> job_num_{0};
+  std::atomic<size_t> pending_job_num_{0};
+  std::atomic_bool exit_run_{false};
+  std::atomic_bool started_{false};
+  std::vector<std::thread> workers_;
 };
 }  // namespace common
 }  // namespace mindspore
@@ -0,0 +1,417 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "profiler/device/cpu/cpu_profiling.h"
+#include <sys/stat.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <utility>
+#include "backend/session/anf_runtime_algorithm.h"
+#include "base/core_ops.h"
+#include "pybind_api/api_register.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_context.h"
+#include "utils/ms_utils.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace profiler {
+namespace cpu {
+namespace {
+// Events of one thread between two collections, the collection happens at the end of each step.
+constexpr size_t kRingCapacity = 1 << 16;
+// Bound of the events kept for the timeline, the op summary keeps counting after it is reached.
+constexpr size_t kMaxTimelineEvents = 1 << 22;
+constexpr float kTimeUnit = 1000;
+constexpr auto kAttrTransposeA = "transpose_a";
+
+uint64_t ElementNum(const std::vector<size_t> &shape) {
+  return std::accumulate(shape.begin(), shape.end(), uint64_t(1), std::multiplies<uint64_t>());
+}
+
+std::string ShapesToString(const std::vector<std::vector<size_t>> &shapes) {
+  std::string str;
+  for (size_t i = 0; i < shapes.size(); ++i) {
+    if (i != 0) {
+      str += ";";
+    }
+    for (size_t j = 0; j < shapes[i].size(); ++j) {
+      if (j != 0) {
+        str += ",";
+      }
+      str += std::to_string(shapes[i][j]);
+    }
+  }
+  return str;
+}
+
+std::string EscapeJson(const std::string &str) {
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (auto c : str) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+// Gives the ring of a thread back to the profiler when the thread exits.
+struct ThreadRingOwner {
+  ~ThreadRingOwner() {
+    if (ring != nullptr) {
+      CPUProfiler::GetInstance()->ReleaseRing(ring);
+    }
+  }
+  KernelEventRing *ring{nullptr};
+};
+
+void ChangeFileMode(const std::string &file_path) {
+  if (chmod(common::SafeCStr(file_path), S_IRUSR) == -1) {
+    MS_LOG(WARNING) << "Modify file:" << file_path << " to rw fail.";
+  }
+}
+}  // namespace
+
+KernelEventRing::KernelEventRing(uint32_t thread_index, size_t capacity) : thread_index_(thread_index) {
+  size_t size = 1;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  mask_ = size - 1;
+  events_.resize(size);
+}
+
+bool KernelEventRing::Push(const KernelEvent &event) {
+  size_t head = head_.load(std::memory_order_relaxed);
+  if (head - tail_.load(std::memory_order_acquire) > mask_) {
+    (void)dropped_num_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  events_[head & mask_] = event;
+  head_.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+size_t KernelEventRing::Drain(std::vector<KernelEvent> *events) {
+  MS_EXCEPTION_IF_NULL(events);
+  size_t tail = tail_.load(std::memory_order_relaxed);
+  size_t head = head_.load(std::memory_order_acquire);
+  for (size_t i = tail; i != head; ++i) {
+    events->push_back(events_[i & mask_]);
+  }
+  tail_.store(head, std::memory_order_release);
+  return head - tail;
+}
+
+std::shared_ptr<CPUProfiler> &CPUProfiler::GetInstance() {
+  static std::shared_ptr<CPUProfiler> profiler_inst(new CPUProfiler());
+  return profiler_inst;
+}
+
+uint64_t CPUProfiler::GetHostTimeStamp() {
+  auto cur_sys_clock = std::chrono::system_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(cur_sys_clock.time_since_epoch()).count();
+}
+
+void CPUProfiler::Init(const std::string &profile_data_path) {
+  MS_LOG(INFO) << "Initialize CPU Profiling";
+  std::lock_guard<std::mutex> lock(collect_mutex_);
+  profile_data_path_ = profile_data_path;
+  base_time_ = GetHostTimeStamp();
+  MS_LOG(INFO) << "Host start time(ns):" << base_time_ << " profile data path: " << profile_data_path_;
+}
+
+void CPUProfiler::StepProfilingEnable(const bool enable_flag) {
+  MS_LOG(INFO) << "CPU profiler enable flag:" << enable_flag;
+  enable_flag_.store(enable_flag, std::memory_order_relaxed);
+}
+
+KernelEventRing *CPUProfiler::GetThreadRing() {
+  thread_local ThreadRingOwner owner;
+  if (owner.ring == nullptr) {
+    std::lock_guard<std::mutex> lock(ring_mutex_);
+    if (free_rings_.empty()) {
+      rings_.push_back(std::make_unique<KernelEventRing>(rings_.size(), kRingCapacity));
+      owner.ring = rings_.back().get();
+    } else {
+      owner.ring = free_rings_.back();
+      free_rings_.pop_back();
+    }
+  }
+  return owner.ring;
+}
+
+void CPUProfiler::ReleaseRing(KernelEventRing *ring) {
+  std::lock_guard<std::mutex> lock(ring_mutex_);
+  free_rings_.push_back(ring);
+}
+
+void CPUProfiler::RecordKernel(const CNode *kernel, uint64_t start_time_stamp, uint64_t bytes) {
+  KernelEvent event;
+  event.kernel = kernel;
+  event.start_time_stamp = start_time_stamp;
+  event.end_time_stamp = GetHostTimeStamp();
+  event.bytes = bytes;
+  (void)GetThreadRing()->Push(event);
+}
+
+uint64_t CPUProfiler::EstimateFlops(const std::string &op_type, const std::vector<std::vector<size_t>> &input_shapes,
+                                    const std::vector<std::vector<size_t>> &output_shapes, bool transpose_a) {
+  uint64_t output_num = 0;
+  for (auto &shape : output_shapes) {
+    output_num += ElementNum(shape);
+  }
+  if ((op_type == prim::kPrimMatMul->name() || op_type == prim::kPrimBatchMatMul->name()) &&
+      !input_shapes.empty() && input_shapes[0].size() >= 2) {
+    auto &shape_a = input_shapes[0];
+    size_t k = transpose_a ? shape_a[shape_a.size() - 2] : shape_a.back();
+    return 2 * output_num * k;
+  }
+  // The weight is in the layout [out_channel, in_channel / group, kernel_h, kernel_w].
+  if (op_type == kConv2DOpName && input_shapes.size() >= 2 && !input_shapes[1].empty() && input_shapes[1][0] != 0) {
+    return 2 * output_num * (ElementNum(input_shapes[1]) / input_shapes[1][0]);
+  }
+  // The other kernels are taken as one operation per element they read or write, whichever is more.
+  uint64_t input_num = 0;
+  for (auto &shape : input_shapes) {
+    input_num = std::max(input_num, ElementNum(shape));
+  }
+  return std::max(input_num, output_num);
+}
+
+uint32_t CPUProfiler::GetOpIndex(const CNode *kernel, std::unordered_map<const CNode *, uint32_t> *resolved) {
+  auto iter = resolved->find(kernel);
+  if (iter != resolved->end()) {
+    return iter->second;
+  }
+  auto cnode = std::static_pointer_cast<CNode>(const_cast<CNode *>(kernel)->shared_from_this());
+  CPUTimelineOp op;
+  op.op_full_name = cnode->fullname_with_scope();
+  op.op_type = AnfAlgo::GetCNodeName(cnode);
+  std::vector<std::vector<size_t>> input_shapes;
+  std::vector<std::vector<size_t>> output_shapes;
+  size_t input_num = AnfAlgo::GetInputTensorNum(cnode);
+  for (size_t i = 0; i < input_num; ++i) {
+    input_shapes.push_back(AnfAlgo::GetInputDeviceShape(cnode, i));
+  }
+  size_t output_num = AnfAlgo::GetOutputTensorNum(cnode);
+  for (size_t i = 0; i < output_num; ++i) {
+    output_shapes.push_back(AnfAlgo::GetOutputDeviceShape(cnode, i));
+  }
+  bool transpose_a = AnfAlgo::HasNodeAttr(kAttrTransposeA, cnode) && AnfAlgo::GetNodeAttr<bool>(cnode, kAttrTransposeA);
+  op.input_shapes = ShapesToString(input_shapes);
+  op.flops = EstimateFlops(op.op_type, input_shapes, output_shapes, transpose_a);
+
+  // The ops are keyed by their shapes too, the shapes of dynamic shape kernels change between the steps.
+  std::string key = op.op_full_name + "|" + op.input_shapes;
+  auto index_iter = op_indexes_.find(key);
+  uint32_t index;
+  if (index_iter == op_indexes_.end()) {
+    index = timeline_ops_.size();
+    op_indexes_[key] = index;
+    timeline_ops_.push_back(op);
+  } else {
+    index = index_iter->second;
+  }
+  (*resolved)[kernel] = index;
+  return index;
+}
+
+void CPUProfiler::CollectEvents() {
+  std::lock_guard<std::mutex> lock(collect_mutex_);
+  drained_events_.clear();
+  std::vector<std::pair<uint32_t, size_t>> thread_events;
+  {
+    std::lock_guard<std::mutex> ring_lock(ring_mutex_);
+    for (auto &ring : rings_) {
+      thread_events.emplace_back(ring->thread_index(), ring->Drain(&drained_events_));
+      dropped_num_ += ring->dropped_num();
+      ring->ResetDroppedNum();
+    }
+  }
+  // A kernel is resolved once per collection, its shapes may change in the next step.
+  std::unordered_map<const CNode *, uint32_t> resolved;
+  size_t event_index = 0;
+  for (auto &thread_event : thread_events) {
+    for (size_t i = 0; i < thread_event.second; ++i, ++event_index) {
+      auto &event = drained_events_[event_index];
+      uint32_t op_index = GetOpIndex(event.kernel, &resolved);
+      auto &op = timeline_ops_[op_index];
+      uint64_t duration = event.end_time_stamp - event.start_time_stamp;
+      auto &op_info = op_info_map_[op.op_full_name];
+      op_info.op_type = op.op_type;
+      op_info.input_shapes = op.input_shapes;
+      op_info.op_count += 1;
+      op_info.op_cost_time += duration / kTimeUnit;
+      op_info.bytes += event.bytes;
+      op_info.flops += op.flops;
+      if (timeline_events_.size() < kMaxTimelineEvents) {
+        timeline_events_.push_back({op_index, thread_event.first, event.start_time_stamp, duration, event.bytes});
+      }
+    }
+  }
+}
+
+void CPUProfiler::Stop() {
+  MS_LOG(INFO) << "Stop CPU Profiling";
+  StepProfilingEnable(false);
+  CollectEvents();
+  if (dropped_num_ > 0) {
+    MS_LOG(WARNING) << "The kernels launched by a thread in one step exceeded the profiler's capacity, " << dropped_num_
+                    << " events were discarded.";
+  }
+  if (timeline_events_.size() >= kMaxTimelineEvents) {
+    MS_LOG(WARNING) << "The timeline only keeps the first " << kMaxTimelineEvents << " kernel events.";
+  }
+  SaveProfileData();
+  ClearInst();
+}
+
+void CPUProfiler::SaveProfileData() {
+  if (profile_data_path_.empty()) {
+    MS_LOG(WARNING) << "Profile data path is empty, skip save profile data.";
+    return;
+  }
+  if (op_info_map_.empty()) {
+    MS_LOG(WARNING) << "No operation detail infos to write.";
+    return;
+  }
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  auto device_id = std::to_string(context_ptr->get_param<uint32_t>(MS_CTX_DEVICE_ID));
+  WriteOpDetail(device_id);
+  WriteOpType(device_id);
+  WriteTimeline(device_id);
+}
+
+void CPUProfiler::WriteOpDetail(const std::string &device_id) {
+  std::string file_path = profile_data_path_ + "/cpu_op_detail_info_" + device_id + ".csv";
+  std::ofstream ofs(file_path);
+  if (!ofs.is_open()) {
+    MS_LOG(WARNING) << "Open file '" << file_path << "' failed!";
+    return;
+  }
+  float total_time = 0;
+  for (auto &item : op_info_map_) {
+    total_time += item.second.op_cost_time;
+  }
+  std::vector<std::pair<std::string, CPUOpInfo>> order_vec(op_info_map_.begin(), op_info_map_.end());
+  std::sort(order_vec.begin(), order_vec.end(),
+            [](const auto &a, const auto &b) { return a.second.op_cost_time > b.second.op_cost_time; });
+  // The leading columns are the ones of the GPU op detail file.
+  ofs << "op_side,op_type,op_name,op_full_name,op_occurrences,op_total_time(us),op_avg_time(us),total_proportion,"
+         "input_shapes,avg_bytes,avg_flops,gflops_per_second"
+      << std::endl;
+  for (auto &item : order_vec) {
+    auto &op_info = item.second;
+    auto op_name = item.first.substr(item.first.rfind('/') + 1);
+    float proportion = total_time > 0 ? op_info.op_cost_time / total_time : 0;
+    float gflops = op_info.op_cost_time > 0 ? op_info.flops / (op_info.op_cost_time * kTimeUnit) : 0;
+    ofs << "Host," << op_info.op_type << ',' << op_name << ',' << item.first << ',' << op_info.op_count << ','
+        << op_info.op_cost_time << ',' << op_info.op_cost_time / op_info.op_count << ',' << proportion << ",\""
+        << op_info.input_shapes << "\"," << op_info.bytes / op_info.op_count << ','
+        << op_info.flops / op_info.op_count << ',' << gflops << std::endl;
+  }
+  ofs.close();
+  ChangeFileMode(file_path);
+  MS_LOG(INFO) << "Write " << order_vec.size() << " op detail infos into file: " << file_path;
+}
+
+void CPUProfiler::WriteOpType(const std::string &device_id) {
+  std::string file_path = profile_data_path_ + "/cpu_op_type_info_" + device_id + ".csv";
+  std::ofstream ofs(file_path);
+  if (!ofs.is_open()) {
+    MS_LOG(WARNING) << "Open file '" << file_path << "' failed!";
+    return;
+  }
+  std::map<std::string, std::pair<int, float>> op_types;
+  float total_time = 0;
+  for (auto &item : op_info_map_) {
+    auto &op_type = op_types[item.second.op_type];
+    op_type.first += item.second.op_count;
+    op_type.second += item.second.op_cost_time;
+    total_time += item.second.op_cost_time;
+  }
+  ofs << "op_type,type_occurrences,total_time(us),total_proportion,avg_time(us)" << std::endl;
+  for (auto &op_type : op_types) {
+    auto &info = op_type.second;
+    ofs << op_type.first << ',' << info.first << ',' << info.second << ','
+        << (total_time > 0 ? info.second / total_time : 0) << ',' << info.second / info.first << std::endl;
+  }
+  ofs.close();
+  ChangeFileMode(file_path);
+  MS_LOG(INFO) << "Write " << op_types.size() << " op type infos into file: " << file_path;
+}
+
+void CPUProfiler::WriteTimeline(const std::string &device_id) {
+  std::string file_path = profile_data_path_ + "/cpu_timeline_display_" + device_id + ".json";
+  std::ofstream ofs(file_path);
+  if (!ofs.is_open()) {
+    MS_LOG(WARNING) << "Open file '" << file_path << "' failed!";
+    return;
+  }
+  // Chrome trace format, the time stamps are in microseconds from the initialization of the profiler.
+  ofs << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  uint32_t thread_num = 0;
+  for (auto &event : timeline_events_) {
+    thread_num = std::max(thread_num, event.thread_index + 1);
+  }
+  for (uint32_t i = 0; i < thread_num; ++i) {
+    ofs << (i == 0 ? "" : ",") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << device_id << ",\"tid\":" << i
+        << ",\"args\":{\"name\":\"CPU thread " << i << "\"}}";
+  }
+  bool first = thread_num == 0;
+  for (auto &event : timeline_events_) {
+    auto &op = timeline_ops_[event.op_index];
+    double ts = event.start_time_stamp >= base_time_ ? (event.start_time_stamp - base_time_) / kTimeUnit : 0;
+    ofs << (first ? "" : ",") << "{\"name\":\"" << EscapeJson(op.op_full_name) << "\",\"cat\":\"" << op.op_type
+        << "\",\"ph\":\"X\",\"ts\":" << std::fixed << ts << ",\"dur\":" << event.duration / kTimeUnit
+        << ",\"pid\":" << device_id << ",\"tid\":" << event.thread_index << ",\"args\":{\"input_shapes\":\""
+        << op.input_shapes << "\",\"bytes\":" << event.bytes << ",\"flops\":" << op.flops << "}}";
+    first = false;
+  }
+  ofs << "]}" << std::endl;
+  ofs.close();
+  ChangeFileMode(file_path);
+  MS_LOG(INFO) << "Write " << timeline_events_.size() << " timeline events into file: " << file_path;
+}
+
+void CPUProfiler::ClearInst() {
+  std::lock_guard<std::mutex> lock(collect_mutex_);
+  drained_events_.clear();
+  timeline_ops_.clear();
+  op_indexes_.clear();
+  op_info_map_.clear();
+  timeline_events_.clear();
+  dropped_num_ = 0;
+}
+
+REGISTER_PYBIND_DEFINE(CPUProfiler_, ([](const py::module *m) {
+                         (void)py::class_<CPUProfiler, std::shared_ptr<CPUProfiler>>(*m, "CPUProfiler")
+                           .def_static("get_instance", &CPUProfiler::GetInstance, "CPUProfiler get_instance.")
+                           .def("init", &CPUProfiler::Init, py::arg("profile_data_path"), "init")
+                           .def("stop", &CPUProfiler::Stop, "stop")
+                           .def("step_profiling_enable", &CPUProfiler::StepProfilingEnable,
+                                py::arg("enable_flag"), "enable or disable step profiling");
+                       }));
+}  // namespace cpu
+}  // namespace profiler
+}  // namespace mindspore
@@ -0,0 +1,138 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PROFILER_DEVICE_CPU_CPU_PROFILING_H
+#define MINDSPORE_CCSRC_PROFILER_DEVICE_CPU_CPU_PROFILING_H
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ir/anf.h"
+
+namespace mindspore {
+namespace profiler {
+namespace cpu {
+struct KernelEvent {
+  // The kernel is only resolved to its name and shapes when the events are collected, at the end of the step.
+  const CNode *kernel{nullptr};
+  uint64_t start_time_stamp{0};
+  uint64_t end_time_stamp{0};
+  uint64_t bytes{0};
+};
+
+// A fixed size single producer ring of kernel events. The owner thread pushes without locking, the collector drains
+// the events published so far. The events pushed when the ring is full are dropped and counted.
+class KernelEventRing {
+ public:
+  KernelEventRing(uint32_t thread_index, size_t capacity);
+  ~KernelEventRing() = default;
+
+  bool Push(const KernelEvent &event);
+  size_t Drain(std::vector<KernelEvent> *events);
+  uint32_t thread_index() const { return thread_index_; }
+  size_t dropped_num() const { return dropped_num_.load(std::memory_order_relaxed); }
+  void ResetDroppedNum() { dropped_num_.store(0, std::memory_order_relaxed); }
+
+ private:
+  uint32_t thread_index_;
+  size_t mask_;
+  std::vector<KernelEvent> events_;
+  std::atomic<size_t> head_{0};
+  std::atomic<size_t> tail_{0};
+  std::atomic<size_t> dropped_num_{0};
+};
+
+struct CPUOpInfo {
+  std::string op_type;
+  std::string input_shapes;
+  int op_count{0};
+  // microsecond
+  float op_cost_time{0};
+  uint64_t bytes{0};
+  uint64_t flops{0};
+};
+
+// A kernel with the input shapes of one of its launches.
+struct CPUTimelineOp {
+  std::string op_full_name;
+  std::string op_type;
+  std::string input_shapes;
+  uint64_t flops{0};
+};
+
+struct CPUTimelineEvent {
+  uint32_t op_index;
+  uint32_t thread_index;
+  uint64_t start_time_stamp;
+  uint64_t duration;
+  uint64_t bytes;
+};
+
+class CPUProfiler {
+ public:
+  static std::shared_ptr<CPUProfiler> &GetInstance();
+  ~CPUProfiler() = default;
+  CPUProfiler(const CPUProfiler &) = delete;
+  CPUProfiler &operator=(const CPUProfiler &) = delete;
+
+  void Init(const std::string &profile_data_path);
+  void Stop();
+  void StepProfilingEnable(const bool enable_flag);
+  bool GetEnableFlag() const { return enable_flag_.load(std::memory_order_relaxed); }
+  static uint64_t GetHostTimeStamp();
+  // Called by the thread which launched the kernel, lock free once the thread got its ring.
+  void RecordKernel(const CNode *kernel, uint64_t start_time_stamp, uint64_t bytes);
+  // Resolves the recorded events, the kernels they point to must be alive.
+  void CollectEvents();
+  // Called when the thread owning the ring exits, its events are left for the next collection.
+  void ReleaseRing(KernelEventRing *ring);
+  static uint64_t EstimateFlops(const std::string &op_type, const std::vector<std::vector<size_t>> &input_shapes,
+                                const std::vector<std::vector<size_t>> &output_shapes, bool transpose_a);
+
+ private:
+  CPUProfiler() = default;
+  // The ring of the calling thread, taken from the free rings or created on the first record of the thread.
+  KernelEventRing *GetThreadRing();
+  uint32_t GetOpIndex(const CNode *kernel, std::unordered_map<const CNode *, uint32_t> *resolved);
+  void SaveProfileData();
+  void WriteOpDetail(const std::string &device_id);
+  void WriteOpType(const std::string &device_id);
+  void WriteTimeline(const std::string &device_id);
+  void ClearInst();
+
+  std::atomic<bool> enable_flag_{false};
+  std::string profile_data_path_;
+  uint64_t base_time_{0};
+  // The rings live as long as the process, as many as the threads recording at the same time. The ring of an exited
+  // thread is reused by the next new thread, which then shows on the timeline under the same thread index.
+  std::mutex ring_mutex_;
+  std::vector<std::unique_ptr<KernelEventRing>> rings_;
+  std::vector<KernelEventRing *> free_rings_;
+  std::mutex collect_mutex_;
+  std::vector<KernelEvent> drained_events_;
+  std::vector<CPUTimelineOp> timeline_ops_;
+  std::map<std::string, uint32_t> op_indexes_;
+  std::unordered_map<std::string, CPUOpInfo> op_info_map_;
+  std::vector<CPUTimelineEvent> timeline_events_;
+  size_t dropped_num_{0};
+};
+}  // namespace cpu
+}  // namespace profiler
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PROFILER_DEVICE_CPU_CPU_PROFILING_H
@@ -84,7 +84,11 @@ REGISTER_PYBIND_DEFINE(MsContextPy, ([](const py::module *m) {
                            .value("enable_profiling", MsCtxParam::MS_CTX_ENABLE_PROFILING)
                            .value("save_graphs", MsCtxParam::MS_CTX_SAVE_GRAPHS_FLAG)
                            .value("enable_parallel_split", MsCtxParam::MS_CTX_ENABLE_PARALLEL_SPLIT)
+                           .value("enable_inter_op_parallel", MsCtxParam::MS_CTX_ENABLE_INTER_OP_PARALLEL)
+                           .value("enable_cpu_fusion", MsCtxParam::MS_CTX_ENABLE_CPU_FUSION)
+                           .value("enable_cpu_grad_allreduce", MsCtxParam::MS_CTX_ENABLE_CPU_GRAD_ALLREDUCE)
                            .value("max_device_memory", MsCtxParam::MS_CTX_MAX_DEVICE_MEMORY)
+                           .value("cpu_grad_compression_ratio", MsCtxParam::MS_CTX_CPU_GRAD_COMPRESSION_RATIO)
                            .value("mode", MsCtxParam::MS_CTX_EXECUTION_MODE)
                            .value("device_target", MsCtxParam::MS_CTX_DEVICE_TARGET)
                            .value("_graph_memory_max_size", MsCtxParam::MS_CTX_GRAPH_MEMORY_MAX_SIZE)
@@ -95,6 +99,12 @@ REGISTER_PYBIND_DEFINE(MsContextPy, ([](const py::module *m) {
                            .value("variable_memory_max_size", MsCtxParam::MS_CTX_VARIABLE_MEMORY_MAX_SIZE)
                            .value("device_id", MsCtxParam::MS_CTX_DEVICE_ID)
                            .value("max_call_depth", MsCtxParam::MS_CTX_MAX_CALL_DEPTH)
+                           .value("cpu_replica_num", MsCtxParam::MS_CTX_CPU_REPLICA_NUM)
+                           .value("cpu_allreduce_bucket_size", MsCtxParam::MS_CTX_CPU_ALLREDUCE_BUCKET_SIZE)
+                           .value("cpu_allreduce_bucket_num", MsCtxParam::MS_CTX_CPU_ALLREDUCE_BUCKET_NUM)
+                           .value("cpu_grad_compression_threshold",
+                                  MsCtxParam::MS_CTX_CPU_GRAD_COMPRESSION_THRESHOLD)
+                           .value("cpu_grad_compression", MsCtxParam::MS_CTX_CPU_GRAD_COMPRESSION)
                            .value("profiling_dir_path", MsCtxParam::MS_CTX_PROFILING_DIR_PATH);
                          (void)py::class_<mindspore::MsContext, std::shared_ptr<mindspore::MsContext>>(*m, "MSContext")
                            .def_static("get_instance", &mindspore::MsContext::GetInstance, "Get ms context instance.")
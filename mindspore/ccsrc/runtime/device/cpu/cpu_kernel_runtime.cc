@@ -22,6 +22,11 @@
 #include <algorithm>
 #include <functional>
 #include <exception>
+#include <map>
+#include <set>
+#include <queue>
+#include <mutex>
+#include <condition_variable>
 #include "backend/kernel_compiler/kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "runtime/device/cpu/cpu_memory_manager.h"
@@ -30,8 +35,9 @@
 #include "backend/session/session_basic.h"
 #include "frontend/operator/ops.h"
 #include "utils/shape_utils.h"
-#include "utils/profile.h"
 #include "utils/trace_base.h"
+#include "common/thread_pool.h"
+#include "profiler/device/cpu/cpu_profiling.h"
 #ifdef MEM_REUSE_DEBUG
 #include "backend/optimizer/mem_reuse/mem_reuse_checker.h"
 #endif
@@ -50,8 +56,21 @@ bool CPUKernelRuntime::Init() {
   return true;
 }
 
+void CPUKernelRuntime::ClearGraphRuntimeResource(uint32_t graph_id, const std::vector<AnfNodePtr> &,
+                                                 const std::unordered_set<ValueNodePtr> &,
+                                                 const std::vector<CNodePtr> &) {
+  MS_LOG(INFO) << "Clear graph:" << graph_id << " CPU runtime resource";
+  (void)launch_tapes_.erase(graph_id);
+  (void)kernel_dags_.erase(graph_id);
+}
+
 const size_t INIT_NODE_REF = 1;
+// The inter-op parallel execution runs one kernel launcher per kInterOpThreadRatio pool threads.
+const size_t kInterOpThreadRatio = 2;
 void CPUKernelRuntime::AssignKernelAddress(session::KernelGraph *kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  (void)launch_tapes_.erase(kernel_graph->graph_id());
+  (void)kernel_dags_.erase(kernel_graph->graph_id());
   AssignValueNodeAddress(kernel_graph);
   AssignInputNodeAddress(kernel_graph);
   auto context_ptr = MsContext::GetInstance();
@@ -361,6 +380,7 @@ void CPUKernelRuntime::AddRuntimeAddress(DeviceAddress *address, std::vector<ker
   input->addr = address->ptr_;
   input->size = address->size_;
   input_list->push_back(input);
+  ++step_address_alloc_num_;
 }
 
 void CPUKernelRuntime::IncreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs) {
@@ -371,57 +391,445 @@ void CPUKernelRuntime::DecreaseSummaryRefCount(const session::NamedSummaryOutput
   static_cast<CPUMemoryManager *>(mem_manager_.get())->DecreaseSummaryRefCount(summary_outputs);
 }
 
-bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph, bool is_task_sink) {
-  MS_EXCEPTION_IF_NULL(kernel_graph);
-  static_cast<CPUMemoryManager *>(mem_manager_.get())->IncreaseAddressRefCount(kernel_graph);
+void CPUKernelRuntime::GetKernelLaunchArgs(const CNodePtr &kernel, KernelLaunchArgs *launch_args) {
+  MS_EXCEPTION_IF_NULL(launch_args);
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
+  for (size_t i = 0; i < input_num; ++i) {
+    auto device_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i).get();
+    MS_EXCEPTION_IF_NULL(device_address);
+    AddRuntimeAddress(device_address, &launch_args->inputs_);
+  }
+  size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+  for (size_t i = 0; i < output_num; ++i) {
+    auto device_address = AnfAlgo::GetMutableOutputAddr(kernel, i).get();
+    MS_EXCEPTION_IF_NULL(device_address);
+    AddRuntimeAddress(device_address, &launch_args->outputs_);
+  }
+  auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+  MS_EXCEPTION_IF_NULL(kernel_mod);
+  for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
+    auto device_address = AnfAlgo::GetWorkspaceAddr(kernel, i);
+    MS_EXCEPTION_IF_NULL(device_address);
+    AddRuntimeAddress(device_address, &launch_args->workspaces_);
+  }
+}
 
-  auto kernels = kernel_graph->execution_order();
-  for (const auto &kernel : kernels) {
-#ifdef ENABLE_PROFILE
-    double start_time = GetTime();
-#endif
-    if (AnfAlgo::IsDynamicShape(kernel)) {
-      AnfAlgo::InferShape(kernel);
+void CPUKernelRuntime::LaunchKernel(const CNodePtr &kernel, kernel::KernelMod *kernel_mod,
+                                    const KernelLaunchArgs &launch_args) {
+  MS_EXCEPTION_IF_NULL(kernel_mod);
+  auto &profiler_inst = profiler::cpu::CPUProfiler::GetInstance();
+  bool profiling = profiler_inst->GetEnableFlag();
+  uint64_t start_time = profiling ? profiler::cpu::CPUProfiler::GetHostTimeStamp() : 0;
+  bool ret = true;
+  try {
+    ret = kernel_mod->Launch(launch_args.inputs_, launch_args.workspaces_, launch_args.outputs_, 0);
+  } catch (std::exception &e) {
+    MS_LOG(EXCEPTION) << e.what() << "\nTrace:" << trace::DumpSourceLines(kernel);
+  }
+  if (!ret) {
+    MS_LOG(EXCEPTION) << "Launch kernel failed. Trace:" << trace::DumpSourceLines(kernel);
+  }
+  if (profiling) {
+    uint64_t bytes = 0;
+    for (auto args : {&launch_args.inputs_, &launch_args.workspaces_, &launch_args.outputs_}) {
+      for (auto &arg : *args) {
+        bytes += arg->size;
+      }
     }
-    std::vector<kernel::AddressPtr> kernel_inputs;
-    std::vector<kernel::AddressPtr> kernel_workspaces;
-    std::vector<kernel::AddressPtr> kernel_outputs;
-    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
-    for (size_t i = 0; i < input_num; ++i) {
-      auto device_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i).get();
-      MS_EXCEPTION_IF_NULL(device_address);
-      AddRuntimeAddress(device_address, &kernel_inputs);
+    profiler_inst->RecordKernel(kernel.get(), start_time, bytes);
+  }
+}
+
+void CPUKernelRuntime::BuildLaunchTape(const session::KernelGraph *kernel_graph, LaunchTape *tape) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  MS_EXCEPTION_IF_NULL(tape);
+  auto &kernels = kernel_graph->execution_order();
+  *tape = LaunchTape();
+  tape->built_ = true;
+  tape->dynamic_shape_ = std::any_of(kernels.begin(), kernels.end(),
+                                     [](const CNodePtr &kernel) { return AnfAlgo::IsDynamicShape(kernel); });
+  if (tape->dynamic_shape_) {
+    return;
+  }
+  tape->overlap_collectives_ = std::any_of(kernels.begin(), kernels.end(), [](const CNodePtr &kernel) {
+    if (AnfAlgo::GetCNodeName(kernel) == kMPIAllReduceStartOpName) {
+      return true;
     }
-    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
-    for (size_t i = 0; i < output_num; ++i) {
-      auto device_address = AnfAlgo::GetMutableOutputAddr(kernel, i).get();
+    return AnfAlgo::GetCNodeName(kernel) == kAllReduceOpName && AnfAlgo::HasNodeAttr(kAttrGroup, kernel) &&
+           AnfAlgo::GetNodeAttr<std::string>(kernel, kAttrGroup) == kValueCPUReplicaGroup;
+  });
+  tape->kernels_ = kernels;
+  tape->kernel_mods_.reserve(kernels.size());
+  tape->launch_args_.resize(kernels.size());
+  auto add_slots = [tape](const CNodePtr &kernel, size_t num, bool is_input, bool is_workspace,
+                          std::vector<kernel::AddressPtr> *args) {
+    args->reserve(num);
+    for (size_t i = 0; i < num; ++i) {
+      DeviceAddress *device_address = nullptr;
+      if (is_input) {
+        device_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i).get();
+      } else if (is_workspace) {
+        device_address = AnfAlgo::GetWorkspaceAddr(kernel, i);
+      } else {
+        device_address = AnfAlgo::GetMutableOutputAddr(kernel, i).get();
+      }
       MS_EXCEPTION_IF_NULL(device_address);
-      AddRuntimeAddress(device_address, &kernel_outputs);
+      args->push_back(std::make_shared<kernel::Address>());
+      tape->slot_device_addresses_.push_back(device_address);
+      tape->slots_.push_back(args->back().get());
     }
+  };
+  for (size_t k = 0; k < kernels.size(); ++k) {
+    auto &kernel = kernels[k];
     auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
     MS_EXCEPTION_IF_NULL(kernel_mod);
-    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto device_address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(device_address);
-      AddRuntimeAddress(device_address, &kernel_workspaces);
+    tape->kernel_mods_.push_back(kernel_mod);
+    auto &launch_args = tape->launch_args_[k];
+    add_slots(kernel, AnfAlgo::GetInputTensorNum(kernel), true, false, &launch_args.inputs_);
+    add_slots(kernel, kernel_mod->GetWorkspaceSizeList().size(), false, true, &launch_args.workspaces_);
+    add_slots(kernel, AnfAlgo::GetOutputTensorNum(kernel), false, false, &launch_args.outputs_);
+  }
+  step_address_alloc_num_ += tape->slots_.size();
+  MS_LOG(INFO) << "Build launch tape of graph " << kernel_graph->graph_id() << " with " << kernels.size()
+               << " kernels and " << tape->slots_.size() << " addresses";
+}
+
+bool CPUKernelRuntime::UpdateLaunchTape(LaunchTape *tape) {
+  MS_EXCEPTION_IF_NULL(tape);
+  auto mem_manager = static_cast<CPUMemoryManager *>(mem_manager_.get());
+  bool changed = false;
+  for (size_t i = 0; i < tape->slots_.size(); ++i) {
+    auto device_address = tape->slot_device_addresses_[i];
+    auto slot = tape->slots_[i];
+    if (slot->addr != device_address->ptr_ || slot->size != device_address->size_) {
+      if (device_address->ptr_ == nullptr) {
+        device_address->ptr_ = mem_manager->StaticMemMalloc(device_address->size_);
+      }
+      MS_EXCEPTION_IF_NULL(device_address->ptr_);
+      slot->addr = device_address->ptr_;
+      slot->size = device_address->size_;
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+namespace {
+const size_t kNoKernel = SIZE_MAX;
+
+// Records which kernels accessed which bytes, in execution order, to find the conflicting accesses.
+class MemAccessTracker {
+ public:
+  // Add the kernels that an access of kernel to [start, end) has to wait for into deps.
+  void Access(uintptr_t start, uintptr_t end, size_t kernel, bool is_write, std::set<size_t> *deps) {
+    if (start >= end) {
+      return;
+    }
+    Split(start);
+    Split(end);
+    uintptr_t cur = start;
+    auto iter = segments_.lower_bound(start);
+    while (cur < end) {
+      if (iter == segments_.end() || iter->first > cur) {
+        uintptr_t gap_end = iter == segments_.end() ? end : std::min(end, iter->first);
+        iter = segments_.emplace_hint(iter, cur, MemSegment{gap_end, kNoKernel, {}});
+      }
+      auto &segment = iter->second;
+      if (segment.writer_ != kNoKernel && segment.writer_ != kernel) {
+        (void)deps->insert(segment.writer_);
+      }
+      if (is_write) {
+        for (auto reader : segment.readers_) {
+          if (reader != kernel) {
+            (void)deps->insert(reader);
+          }
+        }
+        segment.readers_.clear();
+        segment.writer_ = kernel;
+      } else if (segment.readers_.empty() || segment.readers_.back() != kernel) {
+        segment.readers_.push_back(kernel);
+      }
+      cur = segment.end_;
+      ++iter;
+    }
+  }
+
+ private:
+  struct MemSegment {
+    uintptr_t end_;
+    size_t writer_;
+    std::vector<size_t> readers_;
+  };
+
+  void Split(uintptr_t addr) {
+    auto iter = segments_.upper_bound(addr);
+    if (iter == segments_.begin()) {
+      return;
     }
-    bool ret = true;
-    try {
-      ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
-    } catch (std::exception &e) {
-      MS_LOG(EXCEPTION) << e.what() << "\nTrace:" << trace::DumpSourceLines(kernel);
+    --iter;
+    if (iter->first < addr && addr < iter->second.end_) {
+      MemSegment tail = iter->second;
+      iter->second.end_ = addr;
+      (void)segments_.emplace(addr, std::move(tail));
     }
-    if (!ret) {
-      MS_LOG(EXCEPTION) << "Launch kernel failed. Trace:" << trace::DumpSourceLines(kernel);
+  }
+
+  std::map<uintptr_t, MemSegment> segments_;
+};
+}  // namespace
+
+void CPUKernelRuntime::BuildKernelDag(const session::KernelGraph *kernel_graph,
+                                      const std::vector<KernelLaunchArgs> &launch_args, KernelDag *dag) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  MS_EXCEPTION_IF_NULL(dag);
+  auto &kernels = kernel_graph->execution_order();
+  size_t kernel_num = kernels.size();
+  dag->mem_signature_.clear();
+  dag->in_signature_.clear();
+  dag->successors_.assign(kernel_num, {});
+  dag->dependency_num_.assign(kernel_num, 0);
+
+  // Graph outputs and parameters are bound to tensor memory at every step and never share memory with other
+  // addresses, so they are tracked by address object instead of by the bytes they point to.
+  std::set<const DeviceAddress *> identity_addresses;
+  for (auto &output : AnfAlgo::GetAllOutput(kernel_graph->output(), {prim::kPrimTupleGetItem})) {
+    auto real_output = AnfAlgo::VisitKernelWithReturnType(output, 0);
+    if (AnfAlgo::OutputAddrExist(real_output.first, real_output.second)) {
+      (void)identity_addresses.insert(AnfAlgo::GetOutputAddr(real_output.first, real_output.second));
     }
+  }
+  std::map<AnfNodePtr, size_t> kernel_index;
+  for (size_t i = 0; i < kernel_num; ++i) {
+    kernel_index[kernels[i]] = i;
+  }
+
+  MemAccessTracker mem_tracker;
+  MemAccessTracker identity_tracker;
+  size_t last_communication_kernel = kNoKernel;
+  for (size_t k = 0; k < kernel_num; ++k) {
+    auto &kernel = kernels[k];
+    auto &args = launch_args[k];
+    std::set<size_t> deps;
+    auto access = [&](const DeviceAddress *address, const kernel::AddressPtr &arg, bool is_write) {
+      if (identity_addresses.count(address) != 0) {
+        auto key = reinterpret_cast<uintptr_t>(address);
+        identity_tracker.Access(key, key + 1, k, is_write, &deps);
+        dag->in_signature_.push_back(false);
+        return;
+      }
+      auto start = reinterpret_cast<uintptr_t>(arg->addr);
+      mem_tracker.Access(start, start + arg->size, k, is_write, &deps);
+      dag->mem_signature_.emplace_back(arg->addr, arg->size);
+      dag->in_signature_.push_back(true);
+    };
+    for (size_t i = 0; i < args.inputs_.size(); ++i) {
+      auto input = AnfAlgo::GetPrevNodeOutput(kernel, i);
+      auto iter = kernel_index.find(input.first);
+      if (iter != kernel_index.end()) {
+        (void)deps.insert(iter->second);
+      }
+      auto address = AnfAlgo::GetPrevNodeOutputAddr(kernel, i);
+      if (input.first->isa<Parameter>()) {
+        // Optimizers update the weights in place, so an access to a weight is taken as a write.
+        auto parameter = input.first->cast<ParameterPtr>();
+        (void)identity_addresses.insert(address);
+        access(address, args.inputs_[i], AnfAlgo::IsParameterWeight(parameter));
+        continue;
+      }
+      access(address, args.inputs_[i], false);
+    }
+    for (size_t i = 0; i < args.workspaces_.size(); ++i) {
+      access(AnfAlgo::GetWorkspaceAddr(kernel, i), args.workspaces_[i], true);
+    }
+    for (size_t i = 0; i < args.outputs_.size(); ++i) {
+      access(AnfAlgo::GetOutputAddr(kernel, i), args.outputs_[i], true);
+    }
+    // The collectives must be issued in the same order on every rank, and the MPI calls of the starts and the waits
+    // must not overlap, the adapter keeps its requests unguarded.
+    auto kernel_name = AnfAlgo::GetCNodeName(kernel);
+    if (AnfAlgo::IsCommunicationOp(kernel) || kernel_name == kMPIAllReduceStartOpName ||
+        kernel_name == kMPIAllReduceWaitOpName) {
+      if (last_communication_kernel != kNoKernel) {
+        (void)deps.insert(last_communication_kernel);
+      }
+      last_communication_kernel = k;
+    }
+    for (auto dep : deps) {
+      dag->successors_[dep].push_back(k);
+    }
+    dag->dependency_num_[k] = deps.size();
+  }
+}
+
+bool CPUKernelRuntime::RunSerial(session::KernelGraph *kernel_graph) {
+  auto &kernels = kernel_graph->execution_order();
+  for (const auto &kernel : kernels) {
+    if (AnfAlgo::IsDynamicShape(kernel)) {
+      AnfAlgo::InferShape(kernel);
+    }
+    KernelLaunchArgs launch_args;
+    GetKernelLaunchArgs(kernel, &launch_args);
+    LaunchKernel(kernel, AnfAlgo::GetKernelMod(kernel), launch_args);
     static_cast<CPUMemoryManager *>(mem_manager_.get())->DecreaseAddressRefCount(kernel);
-#ifdef ENABLE_PROFILE
-    double cost_time = GetTime() - start_time;
-    MS_LOG(INFO) << "cpu kernel: " << kernel->fullname_with_scope() << "  costs " << cost_time * 1e6 << " us";
-#endif
   }
   return true;
 }
+
+bool CPUKernelRuntime::RunTape(const LaunchTape &tape) {
+  size_t kernel_num = tape.kernels_.size();
+  for (size_t i = 0; i < kernel_num; ++i) {
+    LaunchKernel(tape.kernels_[i], tape.kernel_mods_[i], tape.launch_args_[i]);
+  }
+  return true;
+}
+
+bool CPUKernelRuntime::RunParallel(session::KernelGraph *kernel_graph, const LaunchTape &tape, bool tape_changed) {
+  auto &kernels = tape.kernels_;
+  auto &launch_args = tape.launch_args_;
+  size_t kernel_num = kernels.size();
+
+  // The dag is rebuilt only when the memory plan binds the kernels to other addresses than the last step.
+  auto &dag = kernel_dags_[kernel_graph->graph_id()];
+  bool dag_valid = dag.dependency_num_.size() == kernel_num;
+  if (dag_valid && tape_changed) {
+    size_t flat_index = 0;
+    auto signature_iter = dag.mem_signature_.begin();
+    auto match_signature = [&](const std::vector<kernel::AddressPtr> &args) {
+      for (auto &arg : args) {
+        if (flat_index >= dag.in_signature_.size()) {
+          return false;
+        }
+        if (!dag.in_signature_[flat_index++]) {
+          continue;
+        }
+        if (signature_iter == dag.mem_signature_.end() || signature_iter->first != arg->addr ||
+            signature_iter->second != arg->size) {
+          return false;
+        }
+        ++signature_iter;
+      }
+      return true;
+    };
+    for (size_t i = 0; i < kernel_num && dag_valid; ++i) {
+      dag_valid = match_signature(launch_args[i].inputs_) && match_signature(launch_args[i].workspaces_) &&
+                  match_signature(launch_args[i].outputs_);
+    }
+    dag_valid = dag_valid && flat_index == dag.in_signature_.size();
+  }
+  if (!dag_valid) {
+    BuildKernelDag(kernel_graph, launch_args, &dag);
+    dag.pending_num_.resize(kernel_num);
+    dag.ready_kernels_.reserve(kernel_num);
+    MS_LOG(INFO) << "Build kernel dag of graph " << kernel_graph->graph_id() << " with " << kernel_num << " kernels";
+  }
+
+  // Ready kernels are taken in execution order, so that the memory footprint stays close to the serial one. The
+  // ready kernels are kept in a min-heap.
+  auto &ready_kernels = dag.ready_kernels_;
+  auto &pending_num = dag.pending_num_;
+  ready_kernels.clear();
+  for (size_t i = 0; i < kernel_num; ++i) {
+    pending_num[i] = dag.dependency_num_[i];
+    if (pending_num[i] == 0) {
+      ready_kernels.push_back(i);
+    }
+  }
+  std::make_heap(ready_kernels.begin(), ready_kernels.end(), std::greater<size_t>());
+  size_t unfinished_num = kernel_num;
+  bool failed = false;
+  std::mutex ready_mutex;
+  std::condition_variable ready_cond_var;
+  // Every runner takes one pool thread and keeps launching ready kernels until the graph finishes. The pool threads
+  // not taken by runners serve the intra-op parallelism of the kernels, so the total thread budget is kept.
+  auto runner = [&](size_t, size_t) {
+    while (true) {
+      size_t k = kNoKernel;
+      {
+        std::unique_lock<std::mutex> lock(ready_mutex);
+        ready_cond_var.wait(lock, [&] { return !ready_kernels.empty() || unfinished_num == 0 || failed; });
+        if (ready_kernels.empty() || failed) {
+          return;
+        }
+        std::pop_heap(ready_kernels.begin(), ready_kernels.end(), std::greater<size_t>());
+        k = ready_kernels.back();
+        ready_kernels.pop_back();
+      }
+      try {
+        LaunchKernel(kernels[k], tape.kernel_mods_[k], launch_args[k]);
+      } catch (...) {
+        {
+          std::lock_guard<std::mutex> lock(ready_mutex);
+          failed = true;
+        }
+        ready_cond_var.notify_all();
+        throw;
+      }
+      std::lock_guard<std::mutex> lock(ready_mutex);
+      for (auto successor : dag.successors_[k]) {
+        if (--pending_num[successor] == 0) {
+          ready_kernels.push_back(successor);
+          std::push_heap(ready_kernels.begin(), ready_kernels.end(), std::greater<size_t>());
+          ready_cond_var.notify_one();
+        }
+      }
+      if (--unfinished_num == 0) {
+        ready_cond_var.notify_all();
+      }
+    }
+  };
+  auto &thread_pool = common::ThreadPool::GetInstance();
+  size_t runner_num = std::max(thread_pool.GetSyncRunThreadNum() / kInterOpThreadRatio, static_cast<size_t>(1));
+  // Passed by reference, the task function wraps it without allocating memory.
+  thread_pool.ParallelFor(std::ref(runner), runner_num, 1, runner_num);
+  return true;
+}
+
+bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph, bool is_task_sink) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto &profiler_inst = profiler::cpu::CPUProfiler::GetInstance();
+  if (!profiler_inst->GetEnableFlag()) {
+    return LaunchGraph(kernel_graph);
+  }
+  // The recorded events point to the kernels of the graph, they are collected while the graph is alive.
+  bool ret = false;
+  try {
+    ret = LaunchGraph(kernel_graph);
+  } catch (...) {
+    profiler_inst->CollectEvents();
+    throw;
+  }
+  profiler_inst->CollectEvents();
+  return ret;
+}
+
+bool CPUKernelRuntime::LaunchGraph(session::KernelGraph *kernel_graph) {
+  step_address_alloc_num_ = 0;
+  auto mem_manager = static_cast<CPUMemoryManager *>(mem_manager_.get());
+  // Memory allocated on the fly and shapes changing at runtime need the launch arguments to be gathered per step.
+  if (mem_manager->dynamic_malloc()) {
+    mem_manager->IncreaseAddressRefCount(kernel_graph);
+    return RunSerial(kernel_graph);
+  }
+  auto &tape = launch_tapes_[kernel_graph->graph_id()];
+  if (!tape.built_) {
+    BuildLaunchTape(kernel_graph, &tape);
+  }
+  if (tape.dynamic_shape_) {
+    return RunSerial(kernel_graph);
+  }
+  bool tape_changed = UpdateLaunchTape(&tape);
+
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  // The gradient AllReduce of the replicas, or the buckets of the MPI ones, run as soon as their gradients are ready,
+  // overlapping the rest of backward. The other graphs of the session keep the serial launch.
+  bool inter_op_parallel =
+    context_ptr->get_param<bool>(MS_CTX_ENABLE_INTER_OP_PARALLEL) || tape.overlap_collectives_;
+  if (inter_op_parallel && tape.kernels_.size() > 1) {
+    return RunParallel(kernel_graph, tape, tape_changed);
+  }
+  return RunTape(tape);
+}
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
@@ -21,6 +21,8 @@
 #include <string>
 #include <map>
 #include <set>
+#include <unordered_set>
+#include <utility>
 #include "runtime/device/kernel_runtime.h"
 #include "backend/session/kernel_graph.h"
 #include "backend/session/session_basic.h"
@@ -45,6 +47,11 @@ class CPUKernelRuntime : public KernelRuntime {
   void DecreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
   bool GenDynamicKernel(const session::KernelGraph *graph) override { return true; }
   bool RunDynamicKernelAsync(const session::KernelGraph *graph) override { return true; }
+  // Drops the kernel dag and the launch tape of the graph, they point to its kernels and device addresses.
+  void ClearGraphRuntimeResource(uint32_t graph_id, const std::vector<AnfNodePtr> &inputs,
+                                 const std::unordered_set<ValueNodePtr> &value_nodes,
+                                 const std::vector<CNodePtr> &execution_order) override;
+  size_t step_address_alloc_num() const { return step_address_alloc_num_; }
 
  protected:
   bool SyncStream() override { return true; };
@@ -62,6 +69,55 @@ class CPUKernelRuntime : public KernelRuntime {
   void AssignInputNodeAddress(const session::KernelGraph *kernel_graph);
   void AssignKernelOutputAddress(const session::KernelGraph *kernel_graph);
   void AddRuntimeAddress(DeviceAddress *address, std::vector<kernel::AddressPtr> *input_list);
+
+  struct KernelLaunchArgs {
+    std::vector<kernel::AddressPtr> inputs_;
+    std::vector<kernel::AddressPtr> workspaces_;
+    std::vector<kernel::AddressPtr> outputs_;
+  };
+  // The kernel dependencies of a graph used by the inter-op parallel execution. A kernel depends on the kernels that
+  // produce its inputs and on every earlier kernel whose memory accesses conflict with its own, so running the ready
+  // kernels concurrently gives the same result as running them in execution order.
+  struct KernelDag {
+    // The planned memory the dag was built for, the dag is rebuilt when the memory is reassigned.
+    std::vector<std::pair<void *, size_t>> mem_signature_;
+    // Whether each launch address, flattened as inputs, workspaces then outputs of every kernel, is in mem_signature_.
+    std::vector<bool> in_signature_;
+    std::vector<std::vector<size_t>> successors_;
+    std::vector<size_t> dependency_num_;
+    // Scratch space of a step, kept to avoid reallocating it.
+    std::vector<size_t> pending_num_;
+    std::vector<size_t> ready_kernels_;
+  };
+  // The launch arguments of a graph with static shapes, built once into flat arrays. Each address slot remembers the
+  // device address it was filled from and is refreshed in place when the bound pointer changes, so the steady steps
+  // gather no launch arguments.
+  struct LaunchTape {
+    bool built_{false};
+    bool dynamic_shape_{false};
+    // Whether the graph has replica or MPI gradient AllReduce kernels to overlap with the rest of backward.
+    bool overlap_collectives_{false};
+    std::vector<CNodePtr> kernels_;
+    std::vector<kernel::KernelMod *> kernel_mods_;
+    std::vector<KernelLaunchArgs> launch_args_;
+    std::vector<DeviceAddress *> slot_device_addresses_;
+    std::vector<kernel::Address *> slots_;
+  };
+  void GetKernelLaunchArgs(const CNodePtr &kernel, KernelLaunchArgs *launch_args);
+  void LaunchKernel(const CNodePtr &kernel, kernel::KernelMod *kernel_mod, const KernelLaunchArgs &launch_args);
+  void BuildLaunchTape(const session::KernelGraph *kernel_graph, LaunchTape *tape);
+  bool UpdateLaunchTape(LaunchTape *tape);
+  bool LaunchGraph(session::KernelGraph *kernel_graph);
+  bool RunSerial(session::KernelGraph *kernel_graph);
+  bool RunTape(const LaunchTape &tape);
+  bool RunParallel(session::KernelGraph *kernel_graph, const LaunchTape &tape, bool tape_changed);
+  void BuildKernelDag(const session::KernelGraph *kernel_graph, const std::vector<KernelLaunchArgs> &launch_args,
+                      KernelDag *dag);
+  std::map<uint32_t, KernelDag> kernel_dags_;
+  std::map<uint32_t, LaunchTape> launch_tapes_;
+  // The number of kernel::Address objects created for the launch arguments by the last Run, 0 once the launch tape of
+  // the graph is built. It does not cover what the kernels allocate themselves.
+  size_t step_address_alloc_num_{0};
   std::set<DeviceAddressPtr> bound_addresses_;
   std::map<AnfNodePtr, tensor::TensorPtr> input_param_tensor_map_;
   bool initialized_{false};
@@ -40,6 +40,7 @@ class CPUMemoryManager : public MemoryManager {
   void DecreaseAddressRefCount(const AnfNodePtr &kernel);
   void *StaticMemMalloc(size_t mem_size);
   void MemFree(void *ptr);
+  bool dynamic_malloc() const { return dynamic_malloc_; }
   void IncreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
   void DecreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
 
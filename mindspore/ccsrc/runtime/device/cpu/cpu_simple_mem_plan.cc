@@ -14,16 +14,54 @@
  * limitations under the License.
  */
 #include "runtime/device/cpu/cpu_simple_mem_plan.h"
+#include <algorithm>
+#include <limits>
 #include "backend/session/anf_runtime_algorithm.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
-size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
+namespace {
+constexpr size_t kCPUMemAlignSize = 64;
+constexpr size_t kCPUMemReservedSize = kCPUMemAlignSize;
+
+size_t AlignMemSize(size_t size) { return (size + kCPUMemAlignSize - 1) / kCPUMemAlignSize * kCPUMemAlignSize; }
+
+bool IsLifetimeOverlap(const CPUMemBlock &lhs, const CPUMemBlock &rhs) {
+  return lhs.first_use_ <= rhs.last_use_ && rhs.first_use_ <= lhs.last_use_;
+}
+}  // namespace
+
+void CPUSimpleMemPlan::UpdateMemBlock(DeviceAddress *address, size_t kernel_index,
+                                      std::vector<CPUMemBlock> *mem_blocks,
+                                      std::unordered_map<DeviceAddress *, size_t> *block_index) {
+  MS_EXCEPTION_IF_NULL(address);
+  if (address->ptr_ != nullptr) {
+    return;
+  }
+  auto iter = block_index->find(address);
+  if (iter == block_index->end()) {
+    CPUMemBlock mem_block;
+    mem_block.address_ = address;
+    mem_block.size_ = address->size_;
+    mem_block.first_use_ = kernel_index;
+    mem_block.last_use_ = kernel_index;
+    (*block_index)[address] = mem_blocks->size();
+    mem_blocks->push_back(mem_block);
+    return;
+  }
+  auto &mem_block = (*mem_blocks)[iter->second];
+  mem_block.first_use_ = std::min(mem_block.first_use_, kernel_index);
+  mem_block.last_use_ = std::max(mem_block.last_use_, kernel_index);
+}
+
+void CPUSimpleMemPlan::CollectMemBlocks(const session::KernelGraph *graph, std::vector<CPUMemBlock> *mem_blocks) {
   MS_EXCEPTION_IF_NULL(graph);
-  size_t total_mem_size = 32;
+  MS_EXCEPTION_IF_NULL(mem_blocks);
+  std::unordered_map<DeviceAddress *, size_t> block_index;
   auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
+  for (size_t kernel_index = 0; kernel_index < kernels.size(); ++kernel_index) {
+    const auto &kernel = kernels[kernel_index];
     MS_EXCEPTION_IF_NULL(kernel);
     size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
     for (size_t i = 0; i < input_num; ++i) {
@@ -32,20 +70,16 @@ size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
       if (kernel_with_index.first->isa<Parameter>()) {
         continue;
       }
-      auto address = AnfAlgo::GetOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
+      auto address = AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
       MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
+      UpdateMemBlock(address.get(), kernel_index, mem_blocks, &block_index);
     }
 
     size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
     for (size_t i = 0; i < output_num; ++i) {
-      auto address = AnfAlgo::GetOutputAddr(kernel, i);
+      auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
       MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
+      UpdateMemBlock(address.get(), kernel_index, mem_blocks, &block_index);
     }
 
     auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
@@ -53,58 +87,110 @@ size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
     for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
       auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
       MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
+      UpdateMemBlock(address, kernel_index, mem_blocks, &block_index);
     }
   }
 
-  return total_mem_size;
+  // The graph outputs and summary nodes are read after the graph finishes, keep them alive to the end.
+  std::vector<session::KernelWithIndex> keep_alive_outputs;
+  auto output_nodes = AnfAlgo::GetAllOutput(graph->output(), {prim::kPrimTupleGetItem});
+  for (const auto &node : output_nodes) {
+    keep_alive_outputs.push_back(AnfAlgo::VisitKernelWithReturnType(node, 0, true));
+  }
+  for (const auto &summary_node : graph->summary_nodes()) {
+    keep_alive_outputs.push_back(
+      AnfAlgo::VisitKernelWithReturnType(summary_node.second.first, summary_node.second.second, true));
+  }
+  for (const auto &kernel_with_index : keep_alive_outputs) {
+    if (kernel_with_index.first == nullptr || !kernel_with_index.first->isa<CNode>() ||
+        !AnfAlgo::OutputAddrExist(kernel_with_index.first, kernel_with_index.second)) {
+      continue;
+    }
+    auto address = AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
+    auto iter = block_index.find(address.get());
+    if (iter != block_index.end()) {
+      (*mem_blocks)[iter->second].last_use_ = std::numeric_limits<size_t>::max();
+    }
+  }
 }
 
-void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
-  MS_EXCEPTION_IF_NULL(graph);
-  MS_EXCEPTION_IF_NULL(base_ptr);
-  uint8_t *mem_ptr = base_ptr;
-  auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
-    MS_EXCEPTION_IF_NULL(kernel);
-    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
-    for (size_t i = 0; i < input_num; ++i) {
-      auto kernel_with_index = AnfAlgo::GetPrevNodeOutput(kernel, i);
-      MS_EXCEPTION_IF_NULL(kernel_with_index.first);
-      if (kernel_with_index.first->isa<Parameter>()) {
-        continue;
-      }
-      auto address = AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
-    }
+size_t CPUSimpleMemPlan::PackMemBlocks(std::vector<CPUMemBlock> *mem_blocks) {
+  MS_EXCEPTION_IF_NULL(mem_blocks);
+  // Place the big blocks first, the small ones then fill the gaps between them.
+  std::vector<size_t> order(mem_blocks->size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [mem_blocks](size_t lhs, size_t rhs) {
+    return (*mem_blocks)[lhs].size_ > (*mem_blocks)[rhs].size_;
+  });
 
-    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
-    for (size_t i = 0; i < output_num; ++i) {
-      auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
+  size_t total_mem_size = 0;
+  std::vector<size_t> placed;
+  std::vector<const CPUMemBlock *> overlapped;
+  for (auto index : order) {
+    auto &mem_block = (*mem_blocks)[index];
+    size_t aligned_size = AlignMemSize(mem_block.size_);
+    overlapped.clear();
+    for (auto placed_index : placed) {
+      const auto &placed_block = (*mem_blocks)[placed_index];
+      if (IsLifetimeOverlap(mem_block, placed_block)) {
+        overlapped.push_back(&placed_block);
       }
     }
-
-    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-    MS_EXCEPTION_IF_NULL(kernel_mod);
-    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
+    std::sort(overlapped.begin(), overlapped.end(),
+              [](const CPUMemBlock *lhs, const CPUMemBlock *rhs) { return lhs->offset_ < rhs->offset_; });
+    // Best fit: take the smallest gap which can hold the block, or append it after all overlapped blocks.
+    size_t best_offset = 0;
+    size_t best_gap = std::numeric_limits<size_t>::max();
+    size_t gap_begin = 0;
+    for (auto block : overlapped) {
+      if (block->offset_ > gap_begin) {
+        size_t gap = block->offset_ - gap_begin;
+        if (gap >= aligned_size && gap < best_gap) {
+          best_gap = gap;
+          best_offset = gap_begin;
+        }
       }
+      gap_begin = std::max(gap_begin, block->offset_ + AlignMemSize(block->size_));
     }
+    mem_block.offset_ = best_gap == std::numeric_limits<size_t>::max() ? gap_begin : best_offset;
+    total_mem_size = std::max(total_mem_size, mem_block.offset_ + aligned_size);
+    placed.push_back(index);
+  }
+  return total_mem_size;
+}
+
+size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  planned_blocks_.clear();
+  CollectMemBlocks(graph, &planned_blocks_);
+  naive_mem_size_ = kCPUMemReservedSize;
+  for (const auto &mem_block : planned_blocks_) {
+    naive_mem_size_ += mem_block.size_;
+  }
+  size_t total_mem_size = PackMemBlocks(&planned_blocks_) + kCPUMemReservedSize;
+  planned_graph_ = graph;
+  MS_LOG(INFO) << "Graph " << graph->graph_id() << " planned mem size [" << total_mem_size
+               << "], mem size without reuse [" << naive_mem_size_ << "]";
+  return total_mem_size;
+}
+
+void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(base_ptr);
+  if (planned_graph_ != graph) {
+    (void)MemPlan(graph);
+  }
+  // malloc only guarantees the fundamental alignment, align the base so that every block is aligned.
+  auto base_addr = reinterpret_cast<uintptr_t>(base_ptr);
+  uint8_t *mem_ptr = base_ptr + (AlignMemSize(base_addr) - base_addr);
+  for (const auto &mem_block : planned_blocks_) {
+    MS_EXCEPTION_IF_NULL(mem_block.address_);
+    mem_block.address_->ptr_ = mem_ptr + mem_block.offset_;
   }
+  planned_graph_ = nullptr;
+  planned_blocks_.clear();
 }
 }  // namespace cpu
 }  // namespace device
@@ -17,19 +17,41 @@
 #define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_SIMPLE_MEM_PLAN_H_
 
 #include <vector>
+#include <unordered_map>
 #include "backend/session/kernel_graph.h"
 #include "runtime/device/device_address.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
+// A memory block which is live from the kernel first_use_ to the kernel last_use_ in the execution order.
+struct CPUMemBlock {
+  DeviceAddress *address_{nullptr};
+  size_t size_{0};
+  size_t first_use_{0};
+  size_t last_use_{0};
+  size_t offset_{0};
+};
+
 class CPUSimpleMemPlan {
  public:
   CPUSimpleMemPlan() = default;
   ~CPUSimpleMemPlan() = default;
 
+  // Plan the blocks of the graph and keep the packing for the following MemAssign of the same graph.
   size_t MemPlan(const session::KernelGraph *graph);
   void MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
+  // Pack the blocks whose lifetimes do not overlap into shared offsets, return the total size.
+  static size_t PackMemBlocks(std::vector<CPUMemBlock> *mem_blocks);
+  size_t naive_mem_size() const { return naive_mem_size_; }
+
+ private:
+  void CollectMemBlocks(const session::KernelGraph *graph, std::vector<CPUMemBlock> *mem_blocks);
+  void UpdateMemBlock(DeviceAddress *address, size_t kernel_index, std::vector<CPUMemBlock> *mem_blocks,
+                      std::unordered_map<DeviceAddress *, size_t> *block_index);
+  size_t naive_mem_size_{0};
+  const session::KernelGraph *planned_graph_{nullptr};
+  std::vector<CPUMemBlock> planned_blocks_;
 };
 }  // namespace cpu
 }  // namespace device
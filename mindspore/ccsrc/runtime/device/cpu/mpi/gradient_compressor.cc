@@ -0,0 +1,193 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "runtime/device/cpu/mpi/gradient_compressor.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include "base/float16.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+// The decay of the local momentum of SignCompressor.
+constexpr float kSignMomentum = 0.9f;
+
+uint16_t FloatToHalfBits(float value, bool bf16) {
+  uint16_t bits = 0;
+  if (bf16) {
+    uint32_t value_bits = 0;
+    (void)memcpy(&value_bits, &value, sizeof(value_bits));
+    if (std::isnan(value)) {
+      return static_cast<uint16_t>((value_bits >> 16) | 0x40);
+    }
+    // Rounds to the nearest, ties to even.
+    value_bits += 0x7FFF + ((value_bits >> 16) & 1);
+    return static_cast<uint16_t>(value_bits >> 16);
+  }
+  float16 half(value);
+  (void)memcpy(&bits, &half, sizeof(bits));
+  return bits;
+}
+
+float HalfBitsToFloat(uint16_t bits, bool bf16) {
+  if (bf16) {
+    uint32_t value_bits = static_cast<uint32_t>(bits) << 16;
+    float value = 0;
+    (void)memcpy(&value, &value_bits, sizeof(value));
+    return value;
+  }
+  float16 half;
+  (void)memcpy(static_cast<void *>(&half), &bits, sizeof(bits));
+  return static_cast<float>(half);
+}
+}  // namespace
+
+std::unique_ptr<GradientCompressor> GradientCompressor::Create(const std::string &type, size_t count, float ratio) {
+  if (type == kGradCompressionNone) {
+    return nullptr;
+  } else if (type == kGradCompressionFp16 || type == kGradCompressionBf16) {
+    return std::make_unique<HalfCompressor>(count, type == kGradCompressionBf16);
+  } else if (type == kGradCompressionTopK) {
+    return std::make_unique<TopKCompressor>(count, ratio);
+  } else if (type == kGradCompressionSign) {
+    return std::make_unique<SignCompressor>(count);
+  }
+  throw std::invalid_argument("Unsupported gradient compression: " + type);
+}
+
+void HalfCompressor::Compress(const float *grad, uint8_t *compressed) {
+  auto half = reinterpret_cast<uint16_t *>(compressed);
+  for (size_t i = 0; i < count_; ++i) {
+    half[i] = FloatToHalfBits(grad[i], bf16_);
+  }
+}
+
+void HalfCompressor::Decompress(const uint8_t *compressed, size_t rank_num, float *output) const {
+  auto half = reinterpret_cast<const uint16_t *>(compressed);
+  std::fill(output, output + count_, 0.0f);
+  for (size_t r = 0; r < rank_num; ++r) {
+    for (size_t i = 0; i < count_; ++i) {
+      output[i] += HalfBitsToFloat(half[r * count_ + i], bf16_);
+    }
+  }
+}
+
+size_t HalfCompressor::ChunkCount(size_t rank_num) const {
+  rank_num = std::max<size_t>(rank_num, 1);
+  return (count_ + rank_num - 1) / rank_num;
+}
+
+void HalfCompressor::CompressChunks(const float *grad, size_t rank_num, uint16_t *chunks) const {
+  size_t padded_count = ChunkCount(rank_num) * std::max<size_t>(rank_num, 1);
+  for (size_t i = 0; i < count_; ++i) {
+    chunks[i] = FloatToHalfBits(grad[i], bf16_);
+  }
+  std::fill(chunks + count_, chunks + padded_count, 0);
+}
+
+void HalfCompressor::ReduceChunk(const uint16_t *chunks, size_t rank_num, uint16_t *reduced) const {
+  size_t chunk_count = ChunkCount(rank_num);
+  for (size_t i = 0; i < chunk_count; ++i) {
+    float sum = 0;
+    for (size_t r = 0; r < rank_num; ++r) {
+      sum += HalfBitsToFloat(chunks[r * chunk_count + i], bf16_);
+    }
+    reduced[i] = FloatToHalfBits(sum, bf16_);
+  }
+}
+
+void HalfCompressor::DecompressReduced(const uint16_t *reduced_chunks, float *output) const {
+  for (size_t i = 0; i < count_; ++i) {
+    output[i] = HalfBitsToFloat(reduced_chunks[i], bf16_);
+  }
+}
+
+TopKCompressor::TopKCompressor(size_t count, float ratio)
+    : GradientCompressor(count), residual_(count, 0), indices_(count) {
+  k_ = std::min(count, std::max<size_t>(1, static_cast<size_t>(std::ceil(count * ratio))));
+}
+
+void TopKCompressor::Compress(const float *grad, uint8_t *compressed) {
+  for (size_t i = 0; i < count_; ++i) {
+    residual_[i] += grad[i];
+  }
+  std::iota(indices_.begin(), indices_.end(), 0);
+  std::nth_element(indices_.begin(), indices_.begin() + k_, indices_.end(), [this](uint32_t a, uint32_t b) {
+    return std::fabs(residual_[a]) > std::fabs(residual_[b]);
+  });
+  // The indices are sent in order so the ranks scatter them into the output in order.
+  std::sort(indices_.begin(), indices_.begin() + k_);
+  auto sent_indices = reinterpret_cast<uint32_t *>(compressed);
+  auto sent_values = reinterpret_cast<float *>(compressed + k_ * sizeof(uint32_t));
+  for (size_t i = 0; i < k_; ++i) {
+    auto index = indices_[i];
+    sent_indices[i] = index;
+    sent_values[i] = residual_[index];
+    residual_[index] = 0;
+  }
+}
+
+void TopKCompressor::Decompress(const uint8_t *compressed, size_t rank_num, float *output) const {
+  std::fill(output, output + count_, 0.0f);
+  for (size_t rank = 0; rank < rank_num; ++rank) {
+    auto rank_compressed = compressed + rank * CompressedSize();
+    auto sent_indices = reinterpret_cast<const uint32_t *>(rank_compressed);
+    auto sent_values = reinterpret_cast<const float *>(rank_compressed + k_ * sizeof(uint32_t));
+    for (size_t i = 0; i < k_; ++i) {
+      output[sent_indices[i]] += sent_values[i];
+    }
+  }
+}
+
+void SignCompressor::Compress(const float *grad, uint8_t *compressed) {
+  float sum = 0;
+  for (size_t i = 0; i < count_; ++i) {
+    momentum_[i] = kSignMomentum * momentum_[i] + grad[i];
+    residual_[i] += momentum_[i];
+    sum += std::fabs(residual_[i]);
+  }
+  float scale = count_ > 0 ? sum / count_ : 0;
+  (void)memcpy(compressed, &scale, sizeof(scale));
+  auto signs = compressed + sizeof(scale);
+  std::fill(signs, signs + (count_ + 7) / 8, 0);
+  for (size_t i = 0; i < count_; ++i) {
+    if (residual_[i] >= 0) {
+      signs[i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+      residual_[i] -= scale;
+    } else {
+      residual_[i] += scale;
+    }
+  }
+}
+
+void SignCompressor::Decompress(const uint8_t *compressed, size_t rank_num, float *output) const {
+  std::fill(output, output + count_, 0.0f);
+  for (size_t rank = 0; rank < rank_num; ++rank) {
+    auto rank_compressed = compressed + rank * CompressedSize();
+    float scale = 0;
+    (void)memcpy(&scale, rank_compressed, sizeof(scale));
+    auto signs = rank_compressed + sizeof(scale);
+    for (size_t i = 0; i < count_; ++i) {
+      output[i] += (signs[i / 8] >> (i % 8)) & 1 ? scale : -scale;
+    }
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
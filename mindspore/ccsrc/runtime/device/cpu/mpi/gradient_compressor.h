@@ -0,0 +1,115 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_MPI_GRADIENT_COMPRESSOR_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_MPI_GRADIENT_COMPRESSOR_H_
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+constexpr auto kGradCompressionNone = "none";
+constexpr auto kGradCompressionFp16 = "fp16";
+constexpr auto kGradCompressionBf16 = "bf16";
+constexpr auto kGradCompressionTopK = "topk";
+constexpr auto kGradCompressionSign = "sign";
+
+// Compresses the float32 gradient of one rank before the collectives of the CPU MPI backend, see
+// cpu_grad_compression. A compressor belongs to one gradient and keeps its state from step to step. The compressed
+// gradients of the ranks are gathered and summed by Decompress, always in float32.
+class GradientCompressor {
+ public:
+  // Returns nullptr for kGradCompressionNone, throws std::invalid_argument for an unknown type.
+  static std::unique_ptr<GradientCompressor> Create(const std::string &type, size_t count, float ratio);
+  explicit GradientCompressor(size_t count) : count_(count) {}
+  virtual ~GradientCompressor() = default;
+
+  size_t count() const { return count_; }
+  // The bytes of the compressed gradient of one rank.
+  virtual size_t CompressedSize() const = 0;
+  virtual void Compress(const float *grad, uint8_t *compressed) = 0;
+  // output = the sum of the compressed gradients of rank_num ranks, one after another.
+  virtual void Decompress(const uint8_t *compressed, size_t rank_num, float *output) const = 0;
+
+ protected:
+  size_t count_;
+};
+
+// Casts to float16 or bfloat16. The 16 bits values of the ranks are summed in float32, only the casts lose precision,
+// not the accumulation.
+//
+// Besides the gather of the whole gradients, it supports a reduce-scatter then all-gather, which sends half the bytes
+// of a float32 allreduce whatever the number of ranks: the gradient is cut into one chunk per rank, the rank r sums
+// the chunks r of all the ranks in float32 and casts the sum back to 16 bits, then the reduced chunks are gathered.
+class HalfCompressor : public GradientCompressor {
+ public:
+  HalfCompressor(size_t count, bool bf16) : GradientCompressor(count), bf16_(bf16) {}
+  ~HalfCompressor() override = default;
+  size_t CompressedSize() const override { return count_ * sizeof(uint16_t); }
+  bool bf16() const { return bf16_; }
+  void Compress(const float *grad, uint8_t *compressed) override;
+  void Decompress(const uint8_t *compressed, size_t rank_num, float *output) const override;
+
+  // The elements of a chunk when the gradient is cut into rank_num chunks, the last ones are padded with zeros.
+  size_t ChunkCount(size_t rank_num) const;
+  // Casts the gradient into rank_num chunks of ChunkCount(rank_num) elements, one after another.
+  void CompressChunks(const float *grad, size_t rank_num, uint16_t *chunks) const;
+  // reduced = the float32 sum of the rank_num chunks received from the ranks, one after another, cast to 16 bits.
+  void ReduceChunk(const uint16_t *chunks, size_t rank_num, uint16_t *reduced) const;
+  // output = the reduced chunks of the ranks, one after another, cast to float32.
+  void DecompressReduced(const uint16_t *reduced_chunks, float *output) const;
+
+ private:
+  bool bf16_;
+};
+
+// Sends the k = ratio * count largest magnitudes of the gradient plus the residual, as index and value pairs. What is
+// not sent stays in the residual and is sent in a later step, the error feedback.
+class TopKCompressor : public GradientCompressor {
+ public:
+  TopKCompressor(size_t count, float ratio);
+  ~TopKCompressor() override = default;
+  size_t CompressedSize() const override { return k_ * (sizeof(uint32_t) + sizeof(float)); }
+  void Compress(const float *grad, uint8_t *compressed) override;
+  void Decompress(const uint8_t *compressed, size_t rank_num, float *output) const override;
+
+ private:
+  size_t k_;
+  std::vector<float> residual_;
+  std::vector<uint32_t> indices_;
+};
+
+// Sends the sign of each element as one bit and the mean magnitude as their scale. The gradient is accumulated into
+// a local momentum first, the momentum correction, and the error of the signs is fed back into the next step. As
+// the momentum is applied before the collective, the optimizer should run without momentum.
+class SignCompressor : public GradientCompressor {
+ public:
+  explicit SignCompressor(size_t count) : GradientCompressor(count), momentum_(count, 0), residual_(count, 0) {}
+  ~SignCompressor() override = default;
+  size_t CompressedSize() const override { return sizeof(float) + (count_ + 7) / 8; }
+  void Compress(const float *grad, uint8_t *compressed) override;
+  void Decompress(const uint8_t *compressed, size_t rank_num, float *output) const override;
+
+ private:
+  std::vector<float> momentum_;
+  std::vector<float> residual_;
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_MPI_GRADIENT_COMPRESSOR_H_
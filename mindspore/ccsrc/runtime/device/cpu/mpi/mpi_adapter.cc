@@ -15,6 +15,9 @@
  */
 #include "runtime/device/cpu/mpi/mpi_adapter.h"
 #include <algorithm>
+#include <climits>
+#include <stdexcept>
+#include <utility>
 #include <sstream>
 #include <vector>
 #include <string>
@@ -63,6 +66,15 @@ MPI_Op GetMpiOp(const std::string &op_type) {
   return MPI_SUM;
 }
 
+double ElapsedMs(const std::chrono::steady_clock::time_point &start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// The bytes each of rank_num ranks sends plus receives in a ring allreduce of data_size bytes.
+size_t RingAllReduceTraffic(size_t data_size, size_t rank_num) {
+  return rank_num > 1 ? 4 * data_size * (rank_num - 1) / rank_num : 0;
+}
+
 int GetScatterIndex(int rankid, const std::vector<int> &ranks_group) {
   int scatter_index = -1;
   for (size_t i = 0; i < ranks_group.size(); ++i) {
@@ -87,6 +99,10 @@ MPIAdapter::~MPIAdapter() {
     return;
   }
 
+  for (auto iter = ranks_comm_.begin(); iter != ranks_comm_.end(); ++iter) {
+    MPI_Comm_free(&iter->second);
+  }
+  ranks_comm_.clear();
   for (auto iter = ranks_group_.begin(); iter != ranks_group_.end(); ++iter) {
     MPI_Group_free(&iter->second);
   }
@@ -108,11 +124,18 @@ void MPIAdapter::Init() {
   if (MPI_Initialized(&init_flag) != MPI_SUCCESS) {
     RAISE_EXCEPTION("Check mpi initialized fail!");
   }
+  // The inter-op parallel launch issues the collectives from the threads of the pool, one at a time.
   if (init_flag == 0) {
-    auto ret = MPI_Init(nullptr, nullptr);
+    auto ret = MPI_Init_thread(nullptr, nullptr, MPI_THREAD_SERIALIZED, &thread_level_);
     if (ret != MPI_SUCCESS) {
       RAISE_EXCEPTION("Failed to init mpi!");
     }
+  } else if (MPI_Query_thread(&thread_level_) != MPI_SUCCESS) {
+    RAISE_EXCEPTION("Query mpi thread level fail!");
+  }
+  if (thread_level_ < MPI_THREAD_SERIALIZED) {
+    MS_LOG(WARNING) << "The mpi thread level " << thread_level_
+                    << " is below MPI_THREAD_SERIALIZED, the allreduce can not be bucketed.";
   }
 
   MPI_Comm_group(MPI_COMM_WORLD, &comm_group_world_);
@@ -160,6 +183,22 @@ MPI_Group MPIAdapter::AddGroup(const std::vector<int> &ranks) {
   return group;
 }
 
+MPI_Comm MPIAdapter::GetComm(const std::vector<int> &ranks) {
+  auto group = AddGroup(ranks);
+  std::lock_guard<std::mutex> lock(group_mutex_);
+  auto iter = ranks_comm_.find(ranks);
+  if (iter != ranks_comm_.end()) {
+    return iter->second;
+  }
+  MPI_Comm comm = MPI_COMM_NULL;
+  MPI_Comm_create_group(MPI_COMM_WORLD, group, 0, &comm);
+  if (comm == MPI_COMM_NULL) {
+    RAISE_EXCEPTION_WITH_PARAM("create mpi comm fail!rankid:", rank_id_);
+  }
+  ranks_comm_[ranks] = comm;
+  return comm;
+}
+
 bool MPIAdapter::ReduceScatter(const float *input, float *output, const std::vector<int> &ranks_group, size_t data_num,
                                const std::string &op_type) {
   if (ranks_group.empty()) {
@@ -269,6 +308,254 @@ bool MPIAdapter::AllGather(const float *input, float *output, const std::vector<
   }
   return true;
 }
+
+GradientCompressor *MPIAdapter::GetCompressor(const std::string &key, size_t data_num, const std::string &compression,
+                                              float ratio) {
+  if (compression == kGradCompressionNone) {
+    return nullptr;
+  }
+  if (key.empty()) {
+    RAISE_EXCEPTION("mpi compressed allreduce needs the name of the gradient to keep the compressor state!");
+  }
+  std::lock_guard<std::mutex> lock(compressor_mutex_);
+  auto &info = compressors_[key];
+  if (info.compressor == nullptr || info.compressor->count() != data_num || info.type != compression ||
+      info.ratio != ratio) {
+    try {
+      info.compressor = GradientCompressor::Create(compression, data_num, ratio);
+    } catch (std::invalid_argument &e) {
+      RAISE_EXCEPTION(e.what());
+    }
+    info.type = compression;
+    info.ratio = ratio;
+  }
+  return info.compressor.get();
+}
+
+void MPIAdapter::StartCompressed(const float *data, AllReduceRequest *request) {
+  size_t rank_num = request->rank_num;
+  request->half_compressor = dynamic_cast<HalfCompressor *>(request->compressor);
+  request->stage = 0;
+  int ret = MPI_SUCCESS;
+  if (request->half_compressor != nullptr) {
+    // Reduce-scatter: the chunk r of every rank goes to the rank r.
+    size_t chunk_size = request->half_compressor->ChunkCount(rank_num) * sizeof(uint16_t);
+    if (chunk_size * rank_num > static_cast<size_t>(INT_MAX)) {
+      RAISE_EXCEPTION_WITH_PARAM("mpi compressed collective size exceeds INT_MAX: ", chunk_size * rank_num);
+    }
+    request->send.resize(chunk_size * rank_num);
+    request->recv.resize(chunk_size * rank_num);
+    request->reduced.resize(chunk_size);
+    request->half_compressor->CompressChunks(data, rank_num, reinterpret_cast<uint16_t *>(request->send.data()));
+    int size = static_cast<int>(chunk_size);
+    ret = MPI_Ialltoall(request->send.data(), size, MPI_BYTE, request->recv.data(), size, MPI_BYTE, request->comm,
+                        &request->request);
+    request->sent_size += chunk_size * (rank_num - 1);
+    request->recv_size += chunk_size * (rank_num - 1);
+  } else {
+    size_t compressed_size = request->compressor->CompressedSize();
+    if (compressed_size * rank_num > static_cast<size_t>(INT_MAX)) {
+      RAISE_EXCEPTION_WITH_PARAM("mpi compressed collective size exceeds INT_MAX: ", compressed_size * rank_num);
+    }
+    request->send.resize(compressed_size);
+    request->compressor->Compress(data, request->send.data());
+    request->recv.resize(compressed_size * rank_num);
+    int size = static_cast<int>(compressed_size);
+    ret = MPI_Iallgather(request->send.data(), size, MPI_BYTE, request->recv.data(), size, MPI_BYTE, request->comm,
+                         &request->request);
+    request->sent_size += compressed_size * (rank_num - 1);
+    request->recv_size += compressed_size * (rank_num - 1);
+  }
+  if (ret != MPI_SUCCESS) {
+    RAISE_EXCEPTION_WITH_PARAM("mpi compressed allreduce fail!ret = ", ret);
+  }
+}
+
+bool MPIAdapter::AdvanceCompressed(AllReduceRequest *request) {
+  if (request->half_compressor == nullptr || request->stage != 0) {
+    return false;
+  }
+  // All-gather: the reduced chunks of the ranks are gathered into send, which the reduce-scatter is done with.
+  request->half_compressor->ReduceChunk(reinterpret_cast<const uint16_t *>(request->recv.data()), request->rank_num,
+                                        reinterpret_cast<uint16_t *>(request->reduced.data()));
+  int size = static_cast<int>(request->reduced.size());
+  auto ret = MPI_Iallgather(request->reduced.data(), size, MPI_BYTE, request->send.data(), size, MPI_BYTE,
+                            request->comm, &request->request);
+  if (ret != MPI_SUCCESS) {
+    RAISE_EXCEPTION_WITH_PARAM("mpi compressed allreduce fail!ret = ", ret);
+  }
+  request->sent_size += request->reduced.size() * (request->rank_num - 1);
+  request->recv_size += request->reduced.size() * (request->rank_num - 1);
+  request->stage = 1;
+  return true;
+}
+
+void MPIAdapter::FinishCompressed(const AllReduceRequest &request, float *output) const {
+  if (request.half_compressor != nullptr) {
+    request.half_compressor->DecompressReduced(reinterpret_cast<const uint16_t *>(request.send.data()), output);
+    return;
+  }
+  request.compressor->Decompress(request.recv.data(), request.rank_num, output);
+}
+
+bool MPIAdapter::AllReduce(const float *input, float *output, const std::vector<int> &ranks_group, size_t data_num,
+                           const std::string &op_type, const std::string &compression, float compression_ratio,
+                           const std::string &compressor_key) {
+  if (ranks_group.empty()) {
+    RAISE_EXCEPTION("input rank group is empty!");
+    return false;
+  }
+  if (data_num > static_cast<size_t>(INT_MAX)) {
+    RAISE_EXCEPTION_WITH_PARAM("mpi allreduce data num exceeds INT_MAX: ", data_num);
+  }
+  auto comm = GetComm(ranks_group);
+  auto op = GetMpiOp(op_type);
+  auto compressor =
+    op == MPI_SUM ? GetCompressor(compressor_key, data_num, compression, compression_ratio) : nullptr;
+  if (compressor != nullptr) {
+    auto start_time = std::chrono::steady_clock::now();
+    AllReduceRequest request;
+    request.comm = comm;
+    request.compressor = compressor;
+    request.rank_num = ranks_group.size();
+    StartCompressed(input, &request);
+    do {
+      auto ret = MPI_Wait(&request.request, MPI_STATUS_IGNORE);
+      if (ret != MPI_SUCCESS) {
+        RAISE_EXCEPTION_WITH_PARAM("mpi wait fail!ret = ", ret);
+      }
+    } while (AdvanceCompressed(&request));
+    FinishCompressed(request, output);
+    size_t traffic = request.sent_size + request.recv_size;
+    size_t uncompressed_traffic = RingAllReduceTraffic(data_num * sizeof(float), request.rank_num);
+    MS_LOG(DEBUG) << "Rank " << rank_id_ << " allreduced " << data_num * sizeof(float) << " bytes compressed by "
+                  << compression << ", sent " << request.sent_size << " bytes and received " << request.recv_size
+                  << " bytes, " << (traffic > 0 ? static_cast<double>(uncompressed_traffic) / traffic : 1)
+                  << " times less than a float32 allreduce, in " << ElapsedMs(start_time) << " ms";
+    return true;
+  }
+  const void *send_buffer = input == output ? MPI_IN_PLACE : input;
+  auto ret = MPI_Allreduce(send_buffer, output, static_cast<int>(data_num), MPI_FLOAT, op, comm);
+  if (ret != MPI_SUCCESS) {
+    RAISE_EXCEPTION_WITH_PARAM("mpi allreduce fail!ret = ", ret);
+  }
+  return true;
+}
+
+bool MPIAdapter::IAllReduce(float *buffer, const std::vector<int> &ranks_group, size_t data_num,
+                            const std::string &op_type, const std::string &compression, float compression_ratio,
+                            const std::string &compressor_key) {
+  if (ranks_group.empty()) {
+    RAISE_EXCEPTION("input rank group is empty!");
+    return false;
+  }
+  if (data_num > static_cast<size_t>(INT_MAX)) {
+    RAISE_EXCEPTION_WITH_PARAM("mpi iallreduce data num exceeds INT_MAX: ", data_num);
+  }
+  if (thread_level_ < MPI_THREAD_SERIALIZED) {
+    RAISE_EXCEPTION_WITH_PARAM("mpi iallreduce needs the thread level MPI_THREAD_SERIALIZED, the level is ",
+                               thread_level_);
+  }
+  auto comm = GetComm(ranks_group);
+  auto op = GetMpiOp(op_type);
+  auto compressor =
+    op == MPI_SUM ? GetCompressor(compressor_key, data_num, compression, compression_ratio) : nullptr;
+  std::lock_guard<std::mutex> lock(request_mutex_);
+  if (all_reduce_requests_.count(buffer) != 0) {
+    RAISE_EXCEPTION("mpi iallreduce on a buffer which is still in flight!");
+  }
+  // MPI progresses the requests in flight inside its calls only, they are pushed on whenever a new one starts.
+  auto now = std::chrono::steady_clock::now();
+  for (auto &item : all_reduce_requests_) {
+    auto &request = item.second;
+    int flag = 0;
+    if (!request.done && MPI_Test(&request.request, &flag, MPI_STATUS_IGNORE) == MPI_SUCCESS && flag != 0 &&
+        !AdvanceCompressed(&request)) {
+      request.done = true;
+      request.done_time = now;
+    }
+  }
+  AllReduceRequest request;
+  request.data_size = data_num * sizeof(float);
+  request.start_time = now;
+  request.comm = comm;
+  request.compressor = compressor;
+  request.rank_num = ranks_group.size();
+  if (request.compressor != nullptr) {
+    // The staging buffers keep their memory when the request is moved into the map.
+    StartCompressed(buffer, &request);
+    compress_time_ += ElapsedMs(now);
+  } else {
+    auto ret =
+      MPI_Iallreduce(MPI_IN_PLACE, buffer, static_cast<int>(data_num), MPI_FLOAT, op, comm, &request.request);
+    if (ret != MPI_SUCCESS) {
+      RAISE_EXCEPTION_WITH_PARAM("mpi iallreduce fail!ret = ", ret);
+    }
+  }
+  all_reduce_requests_[buffer] = std::move(request);
+  return true;
+}
+
+bool MPIAdapter::WaitAllReduce(float *buffer) {
+  AllReduceRequest request;
+  {
+    std::lock_guard<std::mutex> lock(request_mutex_);
+    auto iter = all_reduce_requests_.find(buffer);
+    if (iter == all_reduce_requests_.end()) {
+      RAISE_EXCEPTION("mpi wait on a buffer which has no allreduce in flight!");
+    }
+    request = std::move(iter->second);
+    all_reduce_requests_.erase(iter);
+  }
+  // The wait and the decompression run outside of the lock, the other requests are left to progress.
+  auto wait_start = std::chrono::steady_clock::now();
+  if (!request.done) {
+    do {
+      auto ret = MPI_Wait(&request.request, MPI_STATUS_IGNORE);
+      if (ret != MPI_SUCCESS) {
+        RAISE_EXCEPTION_WITH_PARAM("mpi wait fail!ret = ", ret);
+      }
+    } while (AdvanceCompressed(&request));
+    request.done_time = std::chrono::steady_clock::now();
+  }
+  double decompress_time = 0;
+  size_t uncompressed_traffic = RingAllReduceTraffic(request.data_size, request.rank_num);
+  if (request.compressor != nullptr) {
+    auto decompress_start = std::chrono::steady_clock::now();
+    FinishCompressed(request, buffer);
+    decompress_time = ElapsedMs(decompress_start);
+  } else {
+    request.sent_size = uncompressed_traffic / 2;
+    request.recv_size = uncompressed_traffic - request.sent_size;
+  }
+  std::lock_guard<std::mutex> lock(request_mutex_);
+  ++finished_num_;
+  finished_size_ += request.data_size;
+  in_flight_time_ += std::chrono::duration<double, std::milli>(request.done_time - request.start_time).count();
+  if (request.done_time > wait_start) {
+    exposed_time_ += std::chrono::duration<double, std::milli>(request.done_time - wait_start).count();
+  }
+  compress_time_ += decompress_time;
+  uncompressed_traffic_ += uncompressed_traffic;
+  traffic_ += request.sent_size + request.recv_size;
+  if (all_reduce_requests_.empty()) {
+    double overlap = in_flight_time_ > 0 ? 100 * (1 - exposed_time_ / in_flight_time_) : 100;
+    double compression_ratio = traffic_ > 0 ? static_cast<double>(uncompressed_traffic_) / traffic_ : 1;
+    MS_LOG(INFO) << "Rank " << rank_id_ << " allreduced " << finished_num_ << " buckets of " << finished_size_
+                 << " bytes in total, in flight " << in_flight_time_ << " ms, exposed " << exposed_time_
+                 << " ms, overlapped with the computation " << overlap << "%, sent and received " << traffic_
+                 << " bytes, " << compression_ratio << " times less than float32 allreduces, compressed in "
+                 << compress_time_ << " ms";
+    finished_num_ = 0;
+    finished_size_ = 0;
+    uncompressed_traffic_ = 0;
+    traffic_ = 0;
+    in_flight_time_ = 0;
+    exposed_time_ = 0;
+    compress_time_ = 0;
+  }
+  return true;
+}
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
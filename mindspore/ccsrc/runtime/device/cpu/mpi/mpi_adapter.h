@@ -17,11 +17,13 @@
 #ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_MPI_MPI_ADAPTER_H_
 #define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_MPI_MPI_ADAPTER_H_
 #include <mpi.h>
+#include <chrono>
 #include <vector>
 #include <map>
 #include <string>
 #include <mutex>
 #include <memory>
+#include "runtime/device/cpu/mpi/gradient_compressor.h"
 
 namespace mindspore {
 namespace device {
@@ -40,18 +42,90 @@ class MPIAdapter {
   FUNC_EXPORT bool ReduceScatterOverwriteInput(float *input, const std::vector<int> &ranks_group, size_t in_data_num,
                                                size_t output_size, const std::string &op_type, float *output);
   FUNC_EXPORT bool AllGather(const float *input, float *output, const std::vector<int> &ranks_group, size_t data_num);
+  // A sum can send the data compressed, see GradientCompressor. The compressor keeps its state for the later
+  // allreduces of the same compressor_key, the name of the kernel reducing the gradient.
+  FUNC_EXPORT bool AllReduce(const float *input, float *output, const std::vector<int> &ranks_group, size_t data_num,
+                             const std::string &op_type, const std::string &compression = kGradCompressionNone,
+                             float compression_ratio = 0, const std::string &compressor_key = "");
+  // Starts reducing the buffer in place over the ranks, the buffer must not be touched until WaitAllReduce(buffer).
+  // The allreduces are started in the same order on every rank.
+  FUNC_EXPORT bool IAllReduce(float *buffer, const std::vector<int> &ranks_group, size_t data_num,
+                              const std::string &op_type, const std::string &compression = kGradCompressionNone,
+                              float compression_ratio = 0, const std::string &compressor_key = "");
+  FUNC_EXPORT bool WaitAllReduce(float *buffer);
 
  private:
   MPIAdapter();
   void Init();
   MPI_Group AddGroup(const std::vector<int> &ranks);
+  // The communicator of a ranks group, kept for the later collectives so the non-blocking ones can stay in flight.
+  MPI_Comm GetComm(const std::vector<int> &ranks);
+  // The compressor of a gradient, by name rather than by buffer since the memory plan may move the buffer, created
+  // again when the compression or the size of the gradient changes.
+  GradientCompressor *GetCompressor(const std::string &key, size_t data_num, const std::string &compression,
+                                    float ratio);
+
+  struct AllReduceRequest {
+    MPI_Request request{MPI_REQUEST_NULL};
+    MPI_Comm comm{MPI_COMM_NULL};
+    size_t data_size{0};
+    bool done{false};
+    std::chrono::steady_clock::time_point start_time;
+    std::chrono::steady_clock::time_point done_time;
+    GradientCompressor *compressor{nullptr};
+    // Set for fp16 and bf16, which reduce-scatter then all-gather, see HalfCompressor.
+    HalfCompressor *half_compressor{nullptr};
+    // 0 for the reduce-scatter of a half compressed request, 1 once the all-gather of the reduced chunks started.
+    size_t stage{0};
+    size_t rank_num{0};
+    // The bytes of the MPI buffers sent to and received from the other ranks.
+    size_t sent_size{0};
+    size_t recv_size{0};
+    std::vector<uint8_t> send;
+    std::vector<uint8_t> recv;
+    std::vector<uint8_t> reduced;
+  };
+  // Compresses the data and starts the collective of the request. The half compressed data is exchanged chunk by
+  // chunk and each rank reduces its own chunk, the other compressed data is gathered whole and summed in float32 by
+  // FinishCompressed.
+  void StartCompressed(const float *data, AllReduceRequest *request);
+  // Once the collective of a half compressed request finished its reduce-scatter, reduces the chunk of this rank
+  // and starts gathering the reduced chunks. Returns false when the request has no stage left to start.
+  bool AdvanceCompressed(AllReduceRequest *request);
+  void FinishCompressed(const AllReduceRequest &request, float *output) const;
+
+  struct CompressorInfo {
+    std::string type;
+    float ratio{0};
+    std::unique_ptr<GradientCompressor> compressor;
+  };
+  std::map<std::string, CompressorInfo> compressors_;
+  std::mutex compressor_mutex_;
+  // The allreduces in flight, by buffer.
+  std::map<float *, AllReduceRequest> all_reduce_requests_;
+  // The statistics of the non-blocking allreduces since they all last completed, logged as the overlap of the
+  // communication with the computation. request_mutex_ guards them and the requests.
+  size_t finished_num_{0};
+  size_t finished_size_{0};
+  // The bytes an uncompressed ring allreduce of the finished buffers would have sent and received, and the ones
+  // they actually did.
+  size_t uncompressed_traffic_{0};
+  size_t traffic_{0};
+  double compress_time_{0};
+  double in_flight_time_{0};
+  double exposed_time_{0};
+  std::mutex request_mutex_;
 
   MPI_Group comm_group_world_;
   // key:ranks group, value: mpi group
   std::map<std::vector<int>, MPI_Group> ranks_group_;
+  std::map<std::vector<int>, MPI_Comm> ranks_comm_;
   std::mutex group_mutex_;
   int rank_id_{-1};
   int rank_size_{0};
+  // The thread support MPI provides, the buckets are started and waited for from the threads of the inter-op
+  // parallel launch.
+  int thread_level_{MPI_THREAD_SINGLE};
 
   static std::shared_ptr<MPIAdapter> instance_;
 };
@@ -59,3 +59,31 @@ bool MPIAllGather(const float *input, float *output, const std::vector<int> &ran
   }
   return inst->AllGather(input, output, ranks_group, data_num);
 }
+
+bool MPIAllReduce(const float *input, float *output, const std::vector<int> &ranks_group, size_t data_num,
+                  const std::string &op_type, const std::string &compression, float compression_ratio,
+                  const std::string &compressor_key) {
+  auto inst = mindspore::device::cpu::MPIAdapter::Instance();
+  if (inst == nullptr) {
+    return false;
+  }
+  return inst->AllReduce(input, output, ranks_group, data_num, op_type, compression, compression_ratio,
+                         compressor_key);
+}
+
+bool MPIIAllReduce(float *buffer, const std::vector<int> &ranks_group, size_t data_num, const std::string &op_type,
+                   const std::string &compression, float compression_ratio, const std::string &compressor_key) {
+  auto inst = mindspore::device::cpu::MPIAdapter::Instance();
+  if (inst == nullptr) {
+    return false;
+  }
+  return inst->IAllReduce(buffer, ranks_group, data_num, op_type, compression, compression_ratio, compressor_key);
+}
+
+bool MPIWaitAllReduce(float *buffer) {
+  auto inst = mindspore::device::cpu::MPIAdapter::Instance();
+  if (inst == nullptr) {
+    return false;
+  }
+  return inst->WaitAllReduce(buffer);
+}
@@ -31,5 +31,12 @@ extern "C" FUNC_EXPORT bool MPIReduceScatterOverwriteInput(float *input, const s
                                                            const std::string &op_type, float *output);
 extern "C" FUNC_EXPORT bool MPIAllGather(const float *input, float *output, const std::vector<int> &ranks_group,
                                          size_t data_num);
+extern "C" FUNC_EXPORT bool MPIAllReduce(const float *input, float *output, const std::vector<int> &ranks_group,
+                                         size_t data_num, const std::string &op_type, const std::string &compression,
+                                         float compression_ratio, const std::string &compressor_key);
+extern "C" FUNC_EXPORT bool MPIIAllReduce(float *buffer, const std::vector<int> &ranks_group, size_t data_num,
+                                          const std::string &op_type, const std::string &compression,
+                                          float compression_ratio, const std::string &compressor_key);
+extern "C" FUNC_EXPORT bool MPIWaitAllReduce(float *buffer);
 
 #endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_MPI_MPI_EXPORT_H_
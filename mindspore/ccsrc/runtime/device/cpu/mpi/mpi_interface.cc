@@ -54,6 +54,13 @@ typedef bool (*MPIReduceScatterOverwriteInputFunc)(float *input, const std::vect
                                                    float *output);
 typedef bool (*MPIAllGatherFunc)(const float *input, float *output, const std::vector<int> &ranks_group,
                                  size_t data_num);
+typedef bool (*MPIAllReduceFunc)(const float *input, float *output, const std::vector<int> &ranks_group,
+                                 size_t data_num, const std::string &op_type, const std::string &compression,
+                                 float compression_ratio, const std::string &compressor_key);
+typedef bool (*MPIIAllReduceFunc)(float *buffer, const std::vector<int> &ranks_group, size_t data_num,
+                                  const std::string &op_type, const std::string &compression,
+                                  float compression_ratio, const std::string &compressor_key);
+typedef bool (*MPIWaitAllReduceFunc)(float *buffer);
 
 int GetMPIRankId() {
   static GetMPIRankIdFunc func = reinterpret_cast<GetMPIRankIdFunc>(GetMPIAdapterFunc("GetMPIRankId"));
@@ -82,4 +89,22 @@ bool MPIAllGather(const float *input, float *output, const std::vector<int> &ran
   static MPIAllGatherFunc func = reinterpret_cast<MPIAllGatherFunc>(GetMPIAdapterFunc("MPIAllGather"));
   return func(input, output, ranks_group, data_num);
 }
+
+bool MPIAllReduce(const float *input, float *output, const std::vector<int> &ranks_group, size_t data_num,
+                  const std::string &op_type, const std::string &compression, float compression_ratio,
+                  const std::string &compressor_key) {
+  static MPIAllReduceFunc func = reinterpret_cast<MPIAllReduceFunc>(GetMPIAdapterFunc("MPIAllReduce"));
+  return func(input, output, ranks_group, data_num, op_type, compression, compression_ratio, compressor_key);
+}
+
+bool MPIIAllReduce(float *buffer, const std::vector<int> &ranks_group, size_t data_num, const std::string &op_type,
+                   const std::string &compression, float compression_ratio, const std::string &compressor_key) {
+  static MPIIAllReduceFunc func = reinterpret_cast<MPIIAllReduceFunc>(GetMPIAdapterFunc("MPIIAllReduce"));
+  return func(buffer, ranks_group, data_num, op_type, compression, compression_ratio, compressor_key);
+}
+
+bool MPIWaitAllReduce(float *buffer) {
+  static MPIWaitAllReduceFunc func = reinterpret_cast<MPIWaitAllReduceFunc>(GetMPIAdapterFunc("MPIWaitAllReduce"));
+  return func(buffer);
+}
 #endif  // ENABLE_MPI
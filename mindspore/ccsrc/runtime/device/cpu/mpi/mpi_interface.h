@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_MPI_MPI_INTERFACE_H_
 #include <vector>
 #include <string>
+#include "runtime/device/cpu/mpi/gradient_compressor.h"
 #ifndef FUNC_EXPORT
 #define FUNC_EXPORT __attribute__((visibility("default")))
 #endif
@@ -30,5 +31,17 @@ bool MPIReduceScatterOverwriteInput(float *input, const std::vector<int> &ranks_
                                     size_t output_size, const std::string &op_type = kMPIOpTypeSum,
                                     float *output = nullptr);
 bool MPIAllGather(const float *input, float *output, const std::vector<int> &ranks_group, size_t data_num);
+// A sum can send the data compressed, see GradientCompressor, the compressor_key names the gradient whose compressor
+// state is kept from call to call.
+bool MPIAllReduce(const float *input, float *output, const std::vector<int> &ranks_group, size_t data_num,
+                  const std::string &op_type = kMPIOpTypeSum,
+                  const std::string &compression = mindspore::device::cpu::kGradCompressionNone,
+                  float compression_ratio = 0, const std::string &compressor_key = "");
+// The non-blocking allreduce of a buffer in place, finished by MPIWaitAllReduce(buffer).
+bool MPIIAllReduce(float *buffer, const std::vector<int> &ranks_group, size_t data_num,
+                   const std::string &op_type = kMPIOpTypeSum,
+                   const std::string &compression = mindspore::device::cpu::kGradCompressionNone,
+                   float compression_ratio = 0, const std::string &compressor_key = "");
+bool MPIWaitAllReduce(float *buffer);
 #endif  // ENABLE_MPI
 #endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_MPI_MPI_INTERFACE_H_
@@ -0,0 +1,229 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "runtime/device/cpu/replica_collective.h"
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "common/thread_pool.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+// The replicas arrive at a collective about together, they yield for a while before sleeping.
+constexpr size_t kBarrierSpinCount = 2000;
+// The elements reduced or copied by one task, and the alignment of the slices to keep them on separate cache lines.
+constexpr size_t kCollectiveBlockSize = 16 * 1024;
+constexpr size_t kSliceAlignment = 16;
+
+// The cores of each NUMA node, as listed by /sys/devices/system/node/node*/cpulist, e.g. "0-3,8-11".
+std::vector<std::vector<int>> GetNumaNodeCores() {
+  std::vector<std::vector<int>> node_cores;
+#if defined(__linux__)
+  for (size_t node = 0;; ++node) {
+    std::ifstream cpu_list("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    if (!cpu_list.is_open()) {
+      break;
+    }
+    std::vector<int> cores;
+    std::string range;
+    while (std::getline(cpu_list, range, ',')) {
+      int first = -1;
+      int last = -1;
+      char dash = 0;
+      std::istringstream range_stream(range);
+      range_stream >> first;
+      if (range_stream >> dash >> last && dash == '-') {
+        for (int core = first; core <= last; ++core) {
+          cores.push_back(core);
+        }
+      } else if (first >= 0) {
+        cores.push_back(first);
+      }
+    }
+    node_cores.push_back(cores);
+  }
+#endif
+  return node_cores;
+}
+}  // namespace
+
+ReplicaCollective &ReplicaCollective::GetInstance() {
+  static ReplicaCollective instance;
+  return instance;
+}
+
+void ReplicaCollective::Reset(size_t replica_num) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  replica_num_ = std::max<size_t>(replica_num, 1);
+  buffers_.assign(replica_num_, ReplicaBuffer());
+  arrived_num_ = 0;
+  aborted_ = false;
+}
+
+void ReplicaCollective::Abort() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  aborted_ = true;
+  cond_var_.notify_all();
+}
+
+void ReplicaCollective::Barrier() {
+  size_t generation = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (aborted_) {
+      MS_LOG(EXCEPTION) << "The collective of the replicas is aborted by a failed replica.";
+    }
+    generation = generation_;
+    if (++arrived_num_ == replica_num_) {
+      arrived_num_ = 0;
+      ++generation_;
+      cond_var_.notify_all();
+      return;
+    }
+  }
+  for (size_t i = 0; i < kBarrierSpinCount && generation_ == generation && !aborted_; ++i) {
+    std::this_thread::yield();
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  cond_var_.wait(lock, [this, generation] { return generation_ != generation || aborted_; });
+  if (generation_ == generation) {
+    MS_LOG(EXCEPTION) << "The collective of the replicas is aborted by a failed replica.";
+  }
+}
+
+void ReplicaCollective::GetSlice(size_t count, size_t slice_id, size_t *start, size_t *end) const {
+  size_t slice_size = (count + replica_num_ - 1) / replica_num_;
+  slice_size = (slice_size + kSliceAlignment - 1) / kSliceAlignment * kSliceAlignment;
+  *start = std::min(slice_id * slice_size, count);
+  *end = std::min(*start + slice_size, count);
+}
+
+void ReplicaCollective::AllReduce(size_t replica_id, const float *input, float *output, size_t count, bool mean) {
+  if (replica_id >= replica_num_) {
+    MS_LOG(EXCEPTION) << "The replica id " << replica_id << " is out of the " << replica_num_ << " replicas.";
+  }
+  buffers_[replica_id] = {input, output, count};
+  Barrier();
+  for (auto &buffer : buffers_) {
+    if (buffer.count != count) {
+      MS_LOG(EXCEPTION) << "The replica " << replica_id << " all reduces " << count << " elements, but another one "
+                        << buffer.count << ". The replicas must issue the same collectives in the same order.";
+    }
+  }
+
+  // Reduce-scatter: the slice of this replica is reduced from the inputs of all the replicas.
+  auto &thread_pool = common::ThreadPool::GetInstance();
+  size_t slice_start = 0;
+  size_t slice_end = 0;
+  GetSlice(count, replica_id, &slice_start, &slice_end);
+  float scale = mean ? 1.0f / replica_num_ : 1.0f;
+  auto reduce_task = [&](size_t start, size_t end) {
+    start += slice_start;
+    end += slice_start;
+    const float *first = buffers_[0].input;
+    for (size_t i = start; i < end; ++i) {
+      output[i] = first[i];
+    }
+    for (size_t r = 1; r < replica_num_; ++r) {
+      const float *other = buffers_[r].input;
+      for (size_t i = start; i < end; ++i) {
+        output[i] += other[i];
+      }
+    }
+    if (mean) {
+      for (size_t i = start; i < end; ++i) {
+        output[i] *= scale;
+      }
+    }
+  };
+  thread_pool.ParallelFor(reduce_task, slice_end - slice_start, kCollectiveBlockSize);
+  Barrier();
+
+  // All-gather: the slices reduced by the other replicas are copied from their outputs.
+  auto gather_task = [&](size_t start, size_t end) {
+    for (size_t r = 0; r < replica_num_; ++r) {
+      size_t other_start = 0;
+      size_t other_end = 0;
+      GetSlice(count, r, &other_start, &other_end);
+      other_start = std::max(other_start, start);
+      other_end = std::min(other_end, end);
+      if (r != replica_id && other_start < other_end) {
+        std::copy(buffers_[r].output + other_start, buffers_[r].output + other_end, output + other_start);
+      }
+    }
+  };
+  thread_pool.ParallelFor(gather_task, count, kCollectiveBlockSize);
+  // The output of this replica is read by the others until they all finish gathering.
+  Barrier();
+}
+
+std::vector<int> GetReplicaCores(size_t replica_id, size_t replica_num) {
+  if (replica_id >= replica_num) {
+    MS_LOG(EXCEPTION) << "The replica id " << replica_id << " is out of the " << replica_num << " replicas.";
+  }
+  static const std::vector<std::vector<int>> node_cores = [] {
+    auto cores = GetNumaNodeCores();
+    cores.erase(std::remove_if(cores.begin(), cores.end(), [](const std::vector<int> &node) { return node.empty(); }),
+                cores.end());
+    if (cores.empty()) {
+      cores.emplace_back(std::max(std::thread::hardware_concurrency(), 1U));
+      std::iota(cores[0].begin(), cores[0].end(), 0);
+    }
+    return cores;
+  }();
+  size_t node_num = node_cores.size();
+  size_t node = replica_id % node_num;
+  const auto &cores = node_cores[node];
+  // The replicas node, node + node_num, ... share the node, this one is the rank-th of them.
+  size_t node_replica_num = replica_num / node_num + (node < replica_num % node_num ? 1 : 0);
+  size_t rank = replica_id / node_num;
+  if (cores.size() <= node_replica_num) {
+    return {cores[rank % cores.size()]};
+  }
+  size_t share = cores.size() / node_replica_num;
+  size_t share_remain = cores.size() % node_replica_num;
+  size_t begin = rank * share + std::min(rank, share_remain);
+  size_t end = begin + share + (rank < share_remain ? 1 : 0);
+  return std::vector<int>(cores.begin() + begin, cores.begin() + end);
+}
+
+void BindReplicaThread(const std::vector<int> &cores) {
+#if defined(__linux__)
+  if (cores.empty()) {
+    return;
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (auto core : cores) {
+    CPU_SET(core, &cpu_set);
+  }
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) != 0) {
+    MS_LOG(WARNING) << "Bind a replica thread to " << cores.size() << " cores from core " << cores[0] << " failed";
+  }
+#endif
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,77 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_REPLICA_COLLECTIVE_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_REPLICA_COLLECTIVE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The collectives between the replicas of a data parallel graph running in one process, see cpu_replica_num. The
+// replicas publish the addresses of their buffers and read the buffers of each other directly, so the data goes
+// through no intermediate buffer. Every replica issues the same collectives in the same order.
+class ReplicaCollective {
+ public:
+  ~ReplicaCollective() = default;
+  ReplicaCollective(const ReplicaCollective &) = delete;
+  ReplicaCollective &operator=(const ReplicaCollective &) = delete;
+  static ReplicaCollective &GetInstance();
+
+  // Starts a step of replica_num replicas, the state left by an aborted step is dropped.
+  void Reset(size_t replica_num);
+  // Wakes up the replicas waiting in a collective, they throw. Called when a replica fails.
+  void Abort();
+  size_t replica_num() const { return replica_num_; }
+  // Waits until all the replicas arrive, throws when the step is aborted.
+  void Barrier();
+
+  // output = the sum of the inputs of the replicas, divided by the replica number when mean. The elements are cut
+  // into one slice per replica: the replica i reduces the slice i into its own output, which is local to its NUMA
+  // node, then copies the reduced slices of the others, like a reduce-scatter followed by an all-gather.
+  void AllReduce(size_t replica_id, const float *input, float *output, size_t count, bool mean);
+
+ private:
+  ReplicaCollective() = default;
+  void GetSlice(size_t count, size_t slice_id, size_t *start, size_t *end) const;
+
+  struct ReplicaBuffer {
+    const float *input{nullptr};
+    float *output{nullptr};
+    size_t count{0};
+  };
+  std::vector<ReplicaBuffer> buffers_;
+  size_t replica_num_{1};
+  std::mutex mutex_;
+  std::condition_variable cond_var_;
+  size_t arrived_num_{0};
+  std::atomic<size_t> generation_{0};
+  std::atomic_bool aborted_{false};
+};
+
+// The cores a replica of replica_num runs its thread and its thread pool on. The replicas are spread over the NUMA
+// nodes in turn and the replicas on the same node split its cores, a machine whose nodes are unknown is one node.
+std::vector<int> GetReplicaCores(size_t replica_id, size_t replica_num);
+// Binds the calling thread to the cores.
+void BindReplicaThread(const std::vector<int> &cores);
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_REPLICA_COLLECTIVE_H_
@@ -37,6 +37,8 @@ constexpr auto kCTCGreedyDecoderOpName = "CTCGreedyDecoder";
 constexpr auto kFour2FiveOpName = "Four2Five";
 constexpr auto kFive2FourOpName = "Five2Four";
 constexpr auto kConv2DOpName = "Conv2D";
+constexpr auto kMatMulOpName = "MatMul";
+constexpr auto kBatchMatMulOpName = "BatchMatMul";
 constexpr auto kConvBN1OpName = "ConvBN1";
 constexpr auto kBN2AddReluOpName = "BN2AddRelu";
 constexpr auto kBN2ReLUOpName = "BN2Relu";
@@ -242,6 +244,16 @@ constexpr auto kReduceAllOpName = "ReduceAll";
 constexpr auto kFusedWeightScaleApplyMomentum = "FusedWeightScaleApplyMomentum";
 constexpr auto kFusedWeightApplyMomentum = "FusedWeightApplyMomentum";
 constexpr auto kFusedScaleApplyMomentum = "FusedScaleApplyMomentum";
+constexpr auto kFusedElemwiseOpName = "FusedElemwise";
+constexpr auto kMultiTensorApplyOpName = "MultiTensorApply";
+constexpr auto kMPIAllReduceStartOpName = "MPIAllReduceStart";
+constexpr auto kMPIAllReduceWaitOpName = "MPIAllReduceWait";
+constexpr auto kFakeQuantPerLayerOpName = "FakeQuantPerLayer";
+constexpr auto kFakeQuantPerChannelOpName = "FakeQuantPerChannel";
+constexpr auto kFakeQuantWithMinMaxVarsOpName = "FakeQuantWithMinMaxVars";
+constexpr auto kFakeQuantWithMinMaxVarsPerChannelOpName = "FakeQuantWithMinMaxVarsPerChannel";
+constexpr auto kInt8Conv2DOpName = "Int8Conv2D";
+constexpr auto kInt8MatMulOpName = "Int8MatMul";
 constexpr auto kBasicLSTMCellWeightGradOpName = "BasicLSTMCellWeightGrad";
 constexpr auto kBasicLSTMCellInputGradOpName = "BasicLSTMCellInputGrad";
 constexpr auto kBasicLSTMCellOpName = "BasicLSTMCell";
@@ -380,10 +392,32 @@ constexpr auto kAttrPadMode = "pad_mode";
 constexpr auto kAttrPad = "pad";
 constexpr auto kAttrPadding = "padding";
 constexpr auto kAttrIsGrad = "is_grad";
+constexpr auto kAttrFusedOps = "fused_ops";
+constexpr auto kAttrFusedOpInputs = "fused_op_inputs";
+constexpr auto kAttrFusedOutputs = "fused_outputs";
+constexpr auto kAttrReduceAxisNum = "reduce_axis_num";
+constexpr auto kAttrOptimizerName = "optimizer_name";
+constexpr auto kAttrOutputUsed = "output_used";
+constexpr auto kAttrComputeDtype = "compute_dtype";
+constexpr auto kAttrNumBits = "num_bits";
+constexpr auto kAttrNarrowRange = "narrow_range";
+constexpr auto kAttrSymmetric = "symmetric";
+constexpr auto kAttrChannelAxis = "channel_axis";
+constexpr auto kAttrTraining = "training";
+constexpr auto kAttrQuantDelay = "quant_delay";
+constexpr auto kAttrSrcNarrowRange = "src_narrow_range";
+constexpr auto kAttrSrcSymmetric = "src_symmetric";
+constexpr auto kAttrWeightNarrowRange = "weight_narrow_range";
+constexpr auto kAttrWeightSymmetric = "weight_symmetric";
+constexpr auto kAttrReplicaId = "replica_id";
+constexpr auto kAttrMean = "mean";
 
 // attr value
+constexpr auto kValueBFloat16 = "bfloat16";
 constexpr auto kValueTargetSwitch = "target_switch";
 constexpr auto kValueTargetOther = "target_other";
+constexpr auto kValueCPUReplicaGroup = "cpu_replica_group";
+constexpr auto kValueCPUMPIWorldGroup = "cpu_mpi_world_group";
 
 // some size
 const size_t kShape4dDims = 4;
@@ -467,6 +501,7 @@ const std::set<std::string> kOptOperatorSet = {kMomentumOpName,
                                                kApplyRMSPropOpName,
                                                kFusedAdamWeightDecayName,
                                                kFusedAdamName,
+                                               kMultiTensorApplyOpName,
                                                kFusedSparseAdamName,
                                                kFusedWeightScaleApplyMomentum,
                                                kFusedScaleApplyMomentum,
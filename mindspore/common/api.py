@@ -27,7 +27,7 @@ from .._c_expression import generate_key, Executor_, Tensor, MetaTensor, Pynativ
 from .._c_expression import verify_inputs_signature, init_exec_dataset, _set_dataset_mode_config, init_pipeline
 from ..parallel._ps_context import _is_role_pserver
 from ..parallel._utils import _get_device_num, _get_global_rank, _need_to_full, _check_full_batch, _to_full_tensor, \
-    _get_parameter_broadcast, _get_pipeline_stages
+    _get_parameter_broadcast, _get_pipeline_stages, _get_cpu_replica_num, _has_optimizer, _to_replica_tensor
 
 # store ms_function class compiled pipeline cache
 ms_compile_cache = {}
@@ -484,6 +484,10 @@ class _Executor:
         if auto_parallel_mode and _need_to_full() and not is_sink_mode and obj.auto_parallel_compile_and_run():
             args_full = _to_full_tensor(args, _get_device_num(), _get_global_rank())
             _, args_list = _generate_pip_args(obj, *args_full)
+        # The replicas of a training graph on CPU are compiled for their slice of the inputs.
+        replica_num = _get_cpu_replica_num()
+        if replica_num > 1 and not is_sink_mode and _has_optimizer(obj):
+            _, args_list = _generate_pip_args(obj, *_to_replica_tensor(args_list, replica_num))
 
         enable_debug_runtime = context.get_context("enable_debug_runtime")
         enable_ge = context.get_context("enable_ge")
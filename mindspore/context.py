@@ -213,6 +213,22 @@ class _Context:
             raise ValueError(f"Max call depth must be greater than 0, but got {max_call_depth}")
         self.set_param(ms_ctx_param.max_call_depth, max_call_depth)
 
+    def set_cpu_replica_num(self, cpu_replica_num):
+        if cpu_replica_num <= 0:
+            raise ValueError(f"CPU replica num must be greater than 0, but got {cpu_replica_num}")
+        self.set_param(ms_ctx_param.cpu_replica_num, cpu_replica_num)
+
+    def set_cpu_grad_compression(self, compression):
+        if compression not in ('none', 'fp16', 'bf16', 'topk', 'sign'):
+            raise ValueError(f"CPU grad compression must be one of 'none', 'fp16', 'bf16', 'topk' and 'sign', "
+                             f"but got {compression}")
+        self.set_param(ms_ctx_param.cpu_grad_compression, compression)
+
+    def set_cpu_grad_compression_ratio(self, ratio):
+        if ratio <= 0 or ratio > 1:
+            raise ValueError(f"CPU grad compression ratio must be in (0, 1], but got {ratio}")
+        self.set_param(ms_ctx_param.cpu_grad_compression_ratio, float(ratio))
+
     def set_profiling_options(self, option):
         if not isinstance(option, str):
             raise TypeError("The parameter option must be str.")
@@ -260,6 +276,9 @@ class _Context:
         'device_target': set_device_target,
         'device_id': set_device_id,
         'max_call_depth': set_max_call_depth,
+        'cpu_replica_num': set_cpu_replica_num,
+        'cpu_grad_compression': set_cpu_grad_compression,
+        'cpu_grad_compression_ratio': set_cpu_grad_compression_ratio,
         'profiling_options': set_profiling_options,
         'variable_memory_max_size': set_variable_memory_max_size,
         'max_device_memory': set_max_device_memory,
@@ -453,7 +472,7 @@ def reset_auto_parallel_context():
 def _check_target_specific_cfgs(device, arg_key):
     """Checking whether a config is suitable for a specified device"""
     device_cfgs = {
-        'enable_auto_mixed_precision': ['Ascend'],
+        'enable_auto_mixed_precision': ['Ascend', 'CPU'],
         'enable_dump': ['Ascend'],
         'save_dump_path': ['Ascend'],
         'enable_graph_kernel': ['Ascend', 'GPU'],
@@ -462,7 +481,16 @@ def _check_target_specific_cfgs(device, arg_key):
         'profiling_options': ['Ascend'],
         'print_file_path': ['Ascend'],
         'variable_memory_max_size': ['Ascend'],
-        'max_device_memory': ['GPU']
+        'max_device_memory': ['GPU'],
+        'enable_inter_op_parallel': ['CPU'],
+        'enable_cpu_fusion': ['CPU'],
+        'cpu_replica_num': ['CPU'],
+        'enable_cpu_grad_allreduce': ['CPU'],
+        'cpu_allreduce_bucket_size': ['CPU'],
+        'cpu_allreduce_bucket_num': ['CPU'],
+        'cpu_grad_compression': ['CPU'],
+        'cpu_grad_compression_threshold': ['CPU'],
+        'cpu_grad_compression_ratio': ['CPU']
     }
     # configs not in map device_cfgs are supposed to be suitable for all devices
     if not arg_key in device_cfgs:
@@ -480,7 +508,10 @@ def _check_target_specific_cfgs(device, arg_key):
                  save_dump_path=str, enable_reduce_precision=bool, variable_memory_max_size=str,
                  enable_profiling=bool, profiling_options=str, enable_auto_mixed_precision=bool,
                  enable_graph_kernel=bool, check_bprop=bool, max_device_memory=str, print_file_path=str,
-                 enable_sparse=bool, max_call_depth=int)
+                 enable_sparse=bool, max_call_depth=int, enable_inter_op_parallel=bool,
+                 enable_cpu_fusion=bool, cpu_replica_num=int, enable_cpu_grad_allreduce=bool,
+                 cpu_allreduce_bucket_size=int, cpu_allreduce_bucket_num=int, cpu_grad_compression=str,
+                 cpu_grad_compression_threshold=int, cpu_grad_compression_ratio=(int, float))
 def set_context(**kwargs):
     """
     Sets context for running environment.
@@ -502,19 +533,21 @@ def set_context(**kwargs):
 
     Some configurations are device specific, see the bellow table for details:
 
-    ===========================  ===========================  =================
-    Common(CPU/GPU/Ascend)       Ascend                       GPU
-    ===========================  ===========================  =================
-    check_bprop                  print_file_path              max_device_memory
+    ===========================  ===========================  =================  ==============================
+    Common(CPU/GPU/Ascend)       Ascend                       GPU                CPU
+    ===========================  ===========================  =================  ==============================
+    check_bprop                  print_file_path              max_device_memory  enable_inter_op_parallel
     device_id                    enable_dump                  enable_graph_kernel
-    device_target                save_dump_path
-    enable_sparse                enable_graph_kernel
-    max_call_depth               enable_reduce_precision
-    mode                         enable_profiling
-    reserve_class_name_in_scope  profiling_options
-    save_graphs                  variable_memory_max_size
-    save_graphs_path
-    ===========================  ===========================  =================
+    device_target                save_dump_path                                  enable_cpu_fusion
+    enable_sparse                enable_graph_kernel                             enable_auto_mixed_precision
+    max_call_depth               enable_reduce_precision                         cpu_replica_num
+    mode                         enable_profiling                                enable_cpu_grad_allreduce
+    reserve_class_name_in_scope  profiling_options                               cpu_allreduce_bucket_size
+    save_graphs                  variable_memory_max_size                        cpu_allreduce_bucket_num
+    save_graphs_path                                                             cpu_grad_compression
+                                                                                 cpu_grad_compression_threshold
+                                                                                 cpu_grad_compression_ratio
+    ===========================  ===========================  =================  ==============================
 
     Args:
         mode (int): Running in GRAPH_MODE(0) or PYNATIVE_MODE(1). Default: PYNATIVE_MODE(1).
@@ -555,6 +588,38 @@ def set_context(**kwargs):
             suffix to the file. Default: ''.
         enable_sparse (bool): Whether to enable sparsity feature. Default: False.
         max_call_depth(int): Specify the maximum depth of function call. Default: 1000.
+        enable_inter_op_parallel (bool): Whether to launch the independent kernels of a graph concurrently. If False,
+            the kernels run one by one in execution order. Only takes effect for graphs running on CPU. Default: False.
+        enable_cpu_fusion (bool): Whether to fuse the chains of elementwise operators, optionally ending with a reduce
+            over the last axes, into one CPU kernel that passes over the memory once. Default: False.
+        enable_auto_mixed_precision (bool): Whether to enable the automatic mixed precision. On CPU, MatMul,
+            BatchMatMul and the Conv2D operators and gradients compute in bfloat16 when the processor supports
+            AVX512_BF16 or AMX, the tensors and the weights stay float32. Default: False.
+        cpu_replica_num (int): The number of replicas of a training graph running data parallel on CPU in one
+            process. Each replica runs in a thread bound to a NUMA node, on its slice of the inputs whose first
+            dimension is cpu_replica_num times the compiled one, and the gradients are averaged over the replicas
+            before the optimizers. The outputs are those of the first replica. Only takes effect for graphs
+            running on CPU in GRAPH_MODE. Default: 1.
+        enable_cpu_grad_allreduce (bool): Whether to average the gradients of a training graph on CPU over the
+            processes of the MPI world before the optimizers, for data parallel training launched by mpirun, each
+            process feeding its own shard of the data. Requires MindSpore built with MPI, and can not be combined
+            with cpu_replica_num. Default: False.
+        cpu_allreduce_bucket_size (int): The size in MB of the buckets of the gradients averaged by
+            enable_cpu_grad_allreduce. The gradients are packed into buckets in the order backward produces them, and
+            the allreduce of a bucket starts as soon as its gradients are ready while the backward goes on. 0 runs
+            one blocking allreduce per gradient instead. Default: 25.
+        cpu_allreduce_bucket_num (int): The maximum number of buckets of enable_cpu_grad_allreduce, the buckets are
+            made bigger than cpu_allreduce_bucket_size if needed. 0 means no limit. Default: 0.
+        cpu_grad_compression (str): How the gradients of enable_cpu_grad_allreduce are compressed on the network.
+            "fp16" and "bf16" reduce-scatter then all-gather them in 16 bits and add them in float32, half the
+            traffic of float32 whatever the number of ranks. "topk" sends the largest cpu_grad_compression_ratio of
+            the elements, the others are accumulated and sent in the later steps.
+            "sign" sends one bit per element, after accumulating the gradient into a local momentum of 0.9, so the
+            optimizer should then run without momentum. "none" sends them as they are. Default: "none".
+        cpu_grad_compression_threshold (int): The gradients, or the buckets of gradients, smaller than this size in KB
+            are sent uncompressed. Default: 64.
+        cpu_grad_compression_ratio (float): The fraction of the elements sent by the "topk" compression, in (0, 1].
+            Default: 0.01.
 
     Raises:
         ValueError: If input key is not an attribute in context.
@@ -576,6 +641,11 @@ def set_context(**kwargs):
         >>> context.set_context(max_device_memory="3.5GB")
         >>> context.set_context(print_file_path="print.pb")
         >>> context.set_context(max_call_depth=80)
+        >>> context.set_context(enable_inter_op_parallel=True)
+        >>> context.set_context(enable_cpu_fusion=True)
+        >>> context.set_context(cpu_replica_num=2)
+        >>> context.set_context(enable_cpu_grad_allreduce=True, cpu_allreduce_bucket_size=25)
+        >>> context.set_context(cpu_grad_compression="topk", cpu_grad_compression_ratio=0.01)
     """
     ctx = _context()
     # set device target first
@@ -231,6 +231,10 @@ inline const PrimitivePtr kPrimMakeSparseTensor = std::make_shared<Primitive>("M
 inline const PrimitivePtr kPrimSparseTensorGetValues = std::make_shared<Primitive>("SparseTensorGetValues");
 inline const PrimitivePtr kPrimSparseTensorGetIndices = std::make_shared<Primitive>("SparseTensorGetIndices");
 inline const PrimitivePtr kPrimSparseTensorGetDenseShape = std::make_shared<Primitive>("SparseTensorGetDenseShape");
+inline const PrimitivePtr kPrimSparseTensorDenseMatmul = std::make_shared<Primitive>("SparseTensorDenseMatmul");
+inline const PrimitivePtr kPrimSparseTensorDenseMatmulGrad = std::make_shared<Primitive>("SparseTensorDenseMatmulGrad");
+inline const PrimitivePtr kPrimCSRSparseDenseMatmul = std::make_shared<Primitive>("CSRSparseDenseMatmul");
+inline const PrimitivePtr kPrimCSRSparseDenseMatmulGrad = std::make_shared<Primitive>("CSRSparseDenseMatmulGrad");
 
 // Maths
 inline const PrimitivePtr kPrimTensorAdd = std::make_shared<Primitive>("TensorAdd");
@@ -50,6 +50,10 @@ MsContext::MsContext(const std::string &policy, const std::string &target) {
     set_param<uint32_t>(MS_CTX_DEVICE_ID, 0);
   }
   set_param<uint32_t>(MS_CTX_MAX_CALL_DEPTH, MAX_CALL_DEPTH_DEFAULT);
+  set_param<uint32_t>(MS_CTX_CPU_REPLICA_NUM, 1);
+  set_param<uint32_t>(MS_CTX_CPU_ALLREDUCE_BUCKET_SIZE, 25);
+  set_param<uint32_t>(MS_CTX_CPU_ALLREDUCE_BUCKET_NUM, 0);
+  set_param<uint32_t>(MS_CTX_CPU_GRAD_COMPRESSION_THRESHOLD, 64);
   set_param<std::string>(MS_CTX_DEVICE_TARGET, target);
   set_param<int>(MS_CTX_EXECUTION_MODE, kPynativeMode);
   set_param<bool>(MS_CTX_ENABLE_TASK_SINK, true);
@@ -69,11 +73,16 @@ MsContext::MsContext(const std::string &policy, const std::string &target) {
   set_param<std::string>(MS_CTX_PROFILING_OPTIONS, "training_trace");
   set_param<bool>(MS_CTX_CHECK_BPROP_FLAG, false);
   set_param<float>(MS_CTX_MAX_DEVICE_MEMORY, kDefaultMaxDeviceMemory);
+  set_param<float>(MS_CTX_CPU_GRAD_COMPRESSION_RATIO, 0.01f);
   set_param<std::string>(MS_CTX_PRINT_FILE_PATH, "");
   set_param<bool>(MS_CTX_ENABLE_GRAPH_KERNEL, false);
   set_param<bool>(MS_CTX_ENABLE_SPARSE, false);
   set_param<bool>(MS_CTX_ENABLE_PARALLEL_SPLIT, false);
+  set_param<bool>(MS_CTX_ENABLE_INTER_OP_PARALLEL, false);
+  set_param<bool>(MS_CTX_ENABLE_CPU_FUSION, false);
+  set_param<bool>(MS_CTX_ENABLE_CPU_GRAD_ALLREDUCE, false);
   set_param<std::string>(MS_CTX_PROFILING_DIR_PATH, "");
+  set_param<std::string>(MS_CTX_CPU_GRAD_COMPRESSION, "none");
 
   backend_policy_ = policy_map_[policy];
 }
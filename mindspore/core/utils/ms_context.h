@@ -74,6 +74,9 @@ enum MsCtxParam : unsigned {
   MS_CTX_ENABLE_PROFILING,
   MS_CTX_SAVE_GRAPHS_FLAG,
   MS_CTX_ENABLE_PARALLEL_SPLIT,
+  MS_CTX_ENABLE_INTER_OP_PARALLEL,
+  MS_CTX_ENABLE_CPU_FUSION,
+  MS_CTX_ENABLE_CPU_GRAD_ALLREDUCE,
   MS_CTX_TYPE_BOOL_END,
 
   // paramater of type int
@@ -87,11 +90,16 @@ enum MsCtxParam : unsigned {
   MS_CTX_GE_REF,
   MS_CTX_MAX_CALL_DEPTH,
   MS_CTX_TSD_REF,
+  MS_CTX_CPU_REPLICA_NUM,
+  MS_CTX_CPU_ALLREDUCE_BUCKET_SIZE,
+  MS_CTX_CPU_ALLREDUCE_BUCKET_NUM,
+  MS_CTX_CPU_GRAD_COMPRESSION_THRESHOLD,
   MS_CTX_TYPE_UINT32_END,
 
   // paramater of type float
   MS_CTX_TYPE_FLOAT_BEGIN = MS_CTX_TYPE_UINT32_END,
   MS_CTX_MAX_DEVICE_MEMORY = MS_CTX_TYPE_FLOAT_BEGIN,
+  MS_CTX_CPU_GRAD_COMPRESSION_RATIO,
   MS_CTX_TYPE_FLOAT_END,
 
   // paramater of type string
@@ -105,6 +113,7 @@ enum MsCtxParam : unsigned {
   MS_CTX_VARIABLE_MEMORY_MAX_SIZE,
   MS_CTX_PYTHON_EXE_PATH,
   MS_CTX_PROFILING_DIR_PATH,
+  MS_CTX_CPU_GRAD_COMPRESSION,
   MS_CTX_TYPE_STRING_END,
 
   // parameter numbers of each type
@@ -30,6 +30,12 @@ typedef enum {
   MID_CPU = 2     /**< bind middle cpu first */
 } CpuBindMode;
 
+/// \brief ThreadPoolType defined for holding the task scheduling strategy of the thread pool.
+typedef enum {
+  DEFAULT_THREAD_POOL = 0,      /**< one task per thread */
+  WORK_STEALING_THREAD_POOL = 1 /**< the idle threads steal the tasks of the late ones, with adaptive spin and park */
+} ThreadPoolType;
+
 /// \brief DeviceType defined for holding user's preferred backend.
 typedef enum {
   DT_CPU, /**< CPU device type */
@@ -70,6 +76,8 @@ struct DeviceContext {
 struct Context {
   std::string vendor_name_;
   int thread_num_ = 2; /**< thread number config for thread pool */
+  ThreadPoolType thread_pool_type_ = DEFAULT_THREAD_POOL; /**< task scheduling strategy of the thread pool */
+  bool enable_parallel_ = false; /**< run the independent branches of the graph on the CPU in parallel */
   AllocatorPtr allocator = nullptr;
   DeviceContextVector device_list_ = {{DT_CPU, {false, MID_CPU}}};
 };
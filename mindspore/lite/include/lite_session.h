@@ -56,7 +56,9 @@ class MS_API LiteSession {
 
   /// \brief Compile MindSpore Lite model.
   ///
-  /// \note CompileGraph should be called before RunGraph.
+  /// \note CompileGraph should be called before RunGraph. The sessions compiling the same model share the weights
+  /// copied, unpacked or dequantized out of the model buffer and the weights packed by the convolution and matmul
+  /// kernels, each of them is prepared once by the first session compiling the model.
   ///
   /// \param[in] model Define the model to be compiled.
   ///
@@ -118,6 +120,14 @@ class MS_API LiteSession {
   ///
   /// \return STATUS as an error code of resize inputs, STATUS is defined in errorcode.h.
   virtual int Resize(const std::vector<tensor::MSTensor *> &inputs, const std::vector<std::vector<int>> &dims) = 0;
+
+  /// \brief Get the size of the memory planned for the intermediate tensors of model.
+  ///
+  /// \note The intermediate tensors of each CPU subgraph are placed into one arena at offsets planned from their
+  /// lifetimes when compiling graph, and planned again by the first RunGraph after Resize.
+  ///
+  /// \return The total size of the arenas in bytes.
+  virtual size_t GetArenaSize() const { return 0; }
 };
 }  // namespace session
 }  // namespace mindspore
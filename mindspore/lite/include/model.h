@@ -52,6 +52,16 @@ struct MS_API Model {
   /// \return Pointer of MindSpore Lite Model.
   static Model *Import(const char *model_buf, size_t size);
 
+  /// \brief Static method to create a Model pointer from a model file.
+  ///
+  /// \note The model file is mapped into memory instead of being read into a copy, its pages are loaded on demand
+  /// and shared with the other processes mapping the same file.
+  ///
+  /// \param[in] model_path Define the path of the model file.
+  ///
+  /// \return Pointer of MindSpore Lite Model.
+  static Model *ImportFromFile(const char *model_path);
+
   /// \brief Free meta graph temporary buffer
   virtual void Free() = 0;
 
@@ -17,6 +17,7 @@
 #include "nnacl/fp32/activation_fp32.h"
 #include <float.h>
 #include "nnacl/errorcode.h"
+#include "nnacl/x86_64_avx/fp32_simd.h"
 
 int Fp32Relu(const float *src, int length, float *dst) {
   int i = 0;
@@ -72,6 +73,13 @@ int LRelu(const float *src, int length, float *dst, float alpha) {
 }
 
 int Sigmoid(const float *src, int length, float *dst) {
+#ifdef ENABLE_X86_SIMD_DISPATCH
+  const Fp32SimdFuncs *simd = GetFp32SimdFuncs();
+  if (simd != NULL) {
+    simd->sigmoid(src, dst, length);
+    return NNACL_OK;
+  }
+#endif
   const float upper_bound = 16.619047164916992188f;
   const float lower_bound = -9.0f;
   for (int i = 0; i < length; ++i) {
@@ -103,6 +111,13 @@ float TanhOpt(float src) {
 }
 
 int Tanh(const float *src, int length, float *dst) {
+#ifdef ENABLE_X86_SIMD_DISPATCH
+  const Fp32SimdFuncs *simd = GetFp32SimdFuncs();
+  if (simd != NULL) {
+    simd->tanh(src, dst, length);
+    return NNACL_OK;
+  }
+#endif
   for (int i = 0; i < length; ++i) {
     dst[i] = TanhOpt(src[i]);
   }
@@ -18,6 +18,7 @@
 #include <math.h>
 #include <string.h>
 #include "nnacl/errorcode.h"
+#include "nnacl/x86_64_avx/fp32_simd.h"
 
 int Exp(const float *input_data, float *output_data, const ExpParameter *parameter, int task_id) {
   if (parameter->scale_ == 1) {
@@ -38,6 +39,13 @@ int Exp(const float *input_data, float *output_data, const ExpParameter *paramet
 }
 
 void ExpFp32(const float *src, float *dst, int num) {
+#ifdef ENABLE_X86_SIMD_DISPATCH
+  const Fp32SimdFuncs *simd = GetFp32SimdFuncs();
+  if (simd != NULL) {
+    simd->exp(src, dst, num);
+    return;
+  }
+#endif
   int i = 0;
   const float param[] = {log(2.0f), 1.0f / 120, 1.0f / 24, 1.0f / 6, 1.0f / 2, 1.0f};
 #ifdef ENABLE_ARM64
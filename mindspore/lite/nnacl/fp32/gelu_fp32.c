@@ -19,12 +19,20 @@
 #include <string.h>
 #include <math.h>
 #include "nnacl/errorcode.h"
+#include "nnacl/x86_64_avx/fp32_simd.h"
 
 int DoGeLU(const float *src, float *out, int64_t real_dst_count, const GeLUParameter *param) {
   if (src == NULL || out == NULL) {
     return NNACL_ERR;
   }
 
+#ifdef ENABLE_X86_SIMD_DISPATCH
+  const Fp32SimdFuncs *simd = GetFp32SimdFuncs();
+  if (simd != NULL) {
+    simd->gelu(src, out, real_dst_count, param->approximate_);
+    return NNACL_OK;
+  }
+#endif
   if (param->approximate_) {
     for (int i = 0; i < real_dst_count; i++) {
       out[i] = 0.5 * src[i] * (1.0 + tanh(0.7978845608028654 * (src[i] + 0.044715 * pow(src[i], 3))));
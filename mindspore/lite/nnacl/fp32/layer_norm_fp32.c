@@ -17,8 +17,16 @@
 #include <math.h>
 #include "nnacl/errorcode.h"
 #include "nnacl/op_base.h"
+#include "nnacl/x86_64_avx/fp32_simd.h"
 
 void LayerNormMeanAndSquare(const float *src, int num, float *mean, float *square_mean) {
+#ifdef ENABLE_X86_SIMD_DISPATCH
+  const Fp32SimdFuncs *simd = GetFp32SimdFuncs();
+  if (simd != NULL) {
+    simd->layer_norm_mean_and_square(src, num, mean, square_mean);
+    return;
+  }
+#endif
   int index = 0;
 #ifdef ENABLE_NEON
   float32x4_t sum = vdupq_n_f32(0);
@@ -43,6 +51,13 @@ void LayerNormMeanAndSquare(const float *src, int num, float *mean, float *squar
 
 void LayerNormGammaAndBeta(float *dst, const float *src, const float *gamma_data, const float *beta_data, int num,
                            const float mean, const float deno) {
+#ifdef ENABLE_X86_SIMD_DISPATCH
+  const Fp32SimdFuncs *simd = GetFp32SimdFuncs();
+  if (simd != NULL) {
+    simd->layer_norm_gamma_and_beta(dst, src, gamma_data, beta_data, num, mean, deno);
+    return;
+  }
+#endif
   int index = 0;
 #ifdef ENABLE_NEON
   float32x4_t meanv = vdupq_n_f32(mean);
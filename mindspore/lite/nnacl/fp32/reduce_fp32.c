@@ -18,16 +18,37 @@
 #include <float.h>
 #include "nnacl/errorcode.h"
 #include "nnacl/common_func.h"
+#include "nnacl/x86_64_avx/fp32_simd.h"
 
 #ifdef ENABLE_NNACL_INFER_SHAPE
 #include "nnacl/reduce_parameter.h"
 #endif
 
+#ifdef ENABLE_X86_SIMD_DISPATCH
+// reduces with the AVX2/FMA or AVX-512 kernels, false when the CPU supports neither
+static bool ReduceFp32Simd(int outer_size, int inner_size, int axis_size, const float *src_data, float *dst_data,
+                           int tid, int thread_num, SimdReduceMode mode) {
+  const Fp32SimdFuncs *simd = GetFp32SimdFuncs();
+  if (simd == NULL) {
+    return false;
+  }
+  for (int j = tid; j < outer_size; j += thread_num) {
+    simd->reduce(src_data + j * axis_size * inner_size, dst_data + j * inner_size, inner_size, axis_size, mode);
+  }
+  return true;
+}
+#endif
+
 int ReduceMean(int outer_size, int inner_size, int axis_size, const float *src_data, float *dst_data, int tid,
                int thread_num) {
   if (src_data == NULL || dst_data == NULL) {
     return NNACL_NULL_PTR;
   }
+#ifdef ENABLE_X86_SIMD_DISPATCH
+  if (ReduceFp32Simd(outer_size, inner_size, axis_size, src_data, dst_data, tid, thread_num, SIMD_REDUCE_MEAN)) {
+    return NNACL_OK;
+  }
+#endif
   int i, j, k;
   for (j = tid; j < outer_size; j += thread_num) {
     const float *outer_src = src_data + j * axis_size * inner_size;
@@ -49,6 +70,11 @@ int ReduceSum(int outer_size, int inner_size, int axis_size, const float *src_da
   if (src_data == NULL || dst_data == NULL) {
     return NNACL_NULL_PTR;
   }
+#ifdef ENABLE_X86_SIMD_DISPATCH
+  if (ReduceFp32Simd(outer_size, inner_size, axis_size, src_data, dst_data, tid, thread_num, SIMD_REDUCE_SUM)) {
+    return NNACL_OK;
+  }
+#endif
   int i, j;
 #ifdef ENABLE_NEON
   int block_mod = inner_size % C4NUM;
@@ -86,6 +112,11 @@ int ReduceMax(int outer_size, int inner_size, int axis_size, const float *src_da
   if (src_data == NULL || dst_data == NULL) {
     return NNACL_NULL_PTR;
   }
+#ifdef ENABLE_X86_SIMD_DISPATCH
+  if (ReduceFp32Simd(outer_size, inner_size, axis_size, src_data, dst_data, tid, thread_num, SIMD_REDUCE_MAX)) {
+    return NNACL_OK;
+  }
+#endif
   int i, j, k;
   for (j = tid; j < outer_size; j += thread_num) {
     const float *outer_src = src_data + j * axis_size * inner_size;
@@ -128,6 +159,11 @@ int ReduceMin(int outer_size, int inner_size, int axis_size, const float *src_da
   if (src_data == NULL || dst_data == NULL) {
     return NNACL_NULL_PTR;
   }
+#ifdef ENABLE_X86_SIMD_DISPATCH
+  if (ReduceFp32Simd(outer_size, inner_size, axis_size, src_data, dst_data, tid, thread_num, SIMD_REDUCE_MIN)) {
+    return NNACL_OK;
+  }
+#endif
   int i, j, k;
   for (j = tid; j < outer_size; j += thread_num) {
     const float *outer_src = src_data + j * axis_size * inner_size;
@@ -17,6 +17,7 @@
 #include <math.h>
 #include <float.h>
 #include "nnacl/fp32/exp_fp32.h"
+#include "nnacl/x86_64_avx/fp32_simd.h"
 
 void SoftmaxNorm(const float *src, float *dst, int batch, int channel) {
   int cur_batch_offset = 0;
@@ -85,6 +86,13 @@ void SumAndDiv(const float *src, float *dst, int batch, int channel) {
 }
 
 void SoftmaxLastAxis(const float *src, float *dst, int batch, int channel) {
+#ifdef ENABLE_X86_SIMD_DISPATCH
+  const Fp32SimdFuncs *simd = GetFp32SimdFuncs();
+  if (simd != NULL) {
+    simd->softmax_last_axis(src, dst, batch, channel);
+    return;
+  }
+#endif
   SoftmaxNorm(src, dst, batch, channel);
   ExpFp32(dst, dst, batch * channel);
   SumAndDiv(dst, dst, batch, channel);
@@ -0,0 +1,82 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/x86_64_avx/fp32_simd.h"
+
+#ifdef ENABLE_X86_SIMD_DISPATCH
+#ifdef __clang__
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+#include <immintrin.h>
+
+static inline float ReduceAdd256(__m256 value) {
+  __m128 sum = _mm_add_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+  return _mm_cvtss_f32(sum);
+}
+
+static inline float ReduceMax256(__m256 value) {
+  __m128 max = _mm_max_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+  max = _mm_max_ps(max, _mm_movehl_ps(max, max));
+  max = _mm_max_ss(max, _mm_movehdup_ps(max));
+  return _mm_cvtss_f32(max);
+}
+
+static inline float ReduceMin256(__m256 value) {
+  __m128 min = _mm_min_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+  min = _mm_min_ps(min, _mm_movehl_ps(min, min));
+  min = _mm_min_ss(min, _mm_movehdup_ps(min));
+  return _mm_cvtss_f32(min);
+}
+
+#define MS_SIMD_NUM 8
+#define MS_FLOAT_SIMD __m256
+#define MS_INT_SIMD __m256i
+#define MS_LD_F32(src) _mm256_loadu_ps(src)
+#define MS_ST_F32(dst, value) _mm256_storeu_ps(dst, value)
+#define MS_MOV_F32(value) _mm256_set1_ps(value)
+#define MS_ADD_F32(a, b) _mm256_add_ps(a, b)
+#define MS_SUB_F32(a, b) _mm256_sub_ps(a, b)
+#define MS_MUL_F32(a, b) _mm256_mul_ps(a, b)
+#define MS_DIV_F32(a, b) _mm256_div_ps(a, b)
+#define MS_MAX_F32(a, b) _mm256_max_ps(a, b)
+#define MS_MIN_F32(a, b) _mm256_min_ps(a, b)
+#define MS_FMADD_F32(a, b, c) _mm256_fmadd_ps(a, b, c)
+#define MS_FNMADD_F32(a, b, c) _mm256_fnmadd_ps(a, b, c)
+#define MS_CVT_F32_EPI32(value) _mm256_cvtps_epi32(value)
+#define MS_CVT_EPI32_F32(value) _mm256_cvtepi32_ps(value)
+#define MS_CAST_EPI32_F32(value) _mm256_castsi256_ps(value)
+#define MS_MOV_EPI32(value) _mm256_set1_epi32(value)
+#define MS_ADD_EPI32(a, b) _mm256_add_epi32(a, b)
+#define MS_SLLI_EPI32(value, shift) _mm256_slli_epi32(value, shift)
+#define MS_SELECT_NEG_F32(cond, pos, neg) \
+  _mm256_blendv_ps(pos, neg, _mm256_cmp_ps(cond, _mm256_setzero_ps(), _CMP_LT_OQ))
+#define MS_REDUCE_ADD_F32(value) ReduceAdd256(value)
+#define MS_REDUCE_MAX_F32(value) ReduceMax256(value)
+#define MS_REDUCE_MIN_F32(value) ReduceMin256(value)
+#define MS_SIMD_GET_FUNCS GetFp32Avx2Funcs
+
+#include "nnacl/x86_64_avx/fp32_simd_impl.h"
+
+#ifdef __clang__
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+#endif
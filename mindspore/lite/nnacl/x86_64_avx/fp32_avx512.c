@@ -0,0 +1,61 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/x86_64_avx/fp32_simd.h"
+
+#ifdef ENABLE_X86_SIMD_DISPATCH
+#ifdef __clang__
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+#include <immintrin.h>
+
+#define MS_SIMD_NUM 16
+#define MS_FLOAT_SIMD __m512
+#define MS_INT_SIMD __m512i
+#define MS_LD_F32(src) _mm512_loadu_ps(src)
+#define MS_ST_F32(dst, value) _mm512_storeu_ps(dst, value)
+#define MS_MOV_F32(value) _mm512_set1_ps(value)
+#define MS_ADD_F32(a, b) _mm512_add_ps(a, b)
+#define MS_SUB_F32(a, b) _mm512_sub_ps(a, b)
+#define MS_MUL_F32(a, b) _mm512_mul_ps(a, b)
+#define MS_DIV_F32(a, b) _mm512_div_ps(a, b)
+#define MS_MAX_F32(a, b) _mm512_max_ps(a, b)
+#define MS_MIN_F32(a, b) _mm512_min_ps(a, b)
+#define MS_FMADD_F32(a, b, c) _mm512_fmadd_ps(a, b, c)
+#define MS_FNMADD_F32(a, b, c) _mm512_fnmadd_ps(a, b, c)
+#define MS_CVT_F32_EPI32(value) _mm512_cvtps_epi32(value)
+#define MS_CVT_EPI32_F32(value) _mm512_cvtepi32_ps(value)
+#define MS_CAST_EPI32_F32(value) _mm512_castsi512_ps(value)
+#define MS_MOV_EPI32(value) _mm512_set1_epi32(value)
+#define MS_ADD_EPI32(a, b) _mm512_add_epi32(a, b)
+#define MS_SLLI_EPI32(value, shift) _mm512_slli_epi32(value, shift)
+#define MS_SELECT_NEG_F32(cond, pos, neg) \
+  _mm512_mask_blend_ps(_mm512_cmp_ps_mask(cond, _mm512_setzero_ps(), _CMP_LT_OQ), pos, neg)
+#define MS_REDUCE_ADD_F32(value) _mm512_reduce_add_ps(value)
+#define MS_REDUCE_MAX_F32(value) _mm512_reduce_max_ps(value)
+#define MS_REDUCE_MIN_F32(value) _mm512_reduce_min_ps(value)
+#define MS_SIMD_GET_FUNCS GetFp32Avx512Funcs
+
+#include "nnacl/x86_64_avx/fp32_simd_impl.h"
+
+#ifdef __clang__
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+#endif
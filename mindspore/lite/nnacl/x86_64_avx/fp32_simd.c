@@ -0,0 +1,50 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/x86_64_avx/fp32_simd.h"
+#include <stddef.h>
+
+#ifdef ENABLE_X86_SIMD_DISPATCH
+typedef enum X86SimdLevel { X86_SIMD_UNKNOWN = -1, X86_SIMD_NONE, X86_SIMD_AVX2, X86_SIMD_AVX512 } X86SimdLevel;
+
+static X86SimdLevel GetX86SimdLevel(void) {
+  static int simd_level = X86_SIMD_UNKNOWN;
+  int level = __atomic_load_n(&simd_level, __ATOMIC_RELAXED);
+  if (level == X86_SIMD_UNKNOWN) {
+    // cpu_supports also checks that the OS saves the wide registers, the result is the same for every thread
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+      level = X86_SIMD_AVX512;
+    } else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+      level = X86_SIMD_AVX2;
+    } else {
+      level = X86_SIMD_NONE;
+    }
+    __atomic_store_n(&simd_level, level, __ATOMIC_RELAXED);
+  }
+  return (X86SimdLevel)level;
+}
+
+const Fp32SimdFuncs *GetFp32SimdFuncs(void) {
+  switch (GetX86SimdLevel()) {
+    case X86_SIMD_AVX512:
+      return GetFp32Avx512Funcs();
+    case X86_SIMD_AVX2:
+      return GetFp32Avx2Funcs();
+    default:
+      return NULL;
+  }
+}
+#endif
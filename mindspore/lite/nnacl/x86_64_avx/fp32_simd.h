@@ -0,0 +1,60 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_LITE_NNACL_X86_64_AVX_FP32_SIMD_H_
+#define MINDSPORE_LITE_NNACL_X86_64_AVX_FP32_SIMD_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// The AVX2/FMA and AVX-512 kernels are compiled with target attributes rather than global -mavx flags, and are picked
+// from CPUID at runtime, so one x86_64 binary uses the widest instructions of each machine it runs on.
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(_WIN32)
+#define ENABLE_X86_SIMD_DISPATCH
+#endif
+
+typedef enum SimdReduceMode { SIMD_REDUCE_SUM, SIMD_REDUCE_MEAN, SIMD_REDUCE_MAX, SIMD_REDUCE_MIN } SimdReduceMode;
+
+typedef struct Fp32SimdFuncs {
+  void (*exp)(const float *src, float *dst, int num);
+  void (*sigmoid)(const float *src, float *dst, int num);
+  // the same rational approximation as TanhOpt
+  void (*tanh)(const float *src, float *dst, int num);
+  void (*gelu)(const float *src, float *dst, int64_t num, bool approximate);
+  // softmax of each of the batch rows of channel elements
+  void (*softmax_last_axis)(const float *src, float *dst, int batch, int channel);
+  void (*layer_norm_mean_and_square)(const float *src, int num, float *mean, float *square_mean);
+  void (*layer_norm_gamma_and_beta)(float *dst, const float *src, const float *gamma, const float *beta, int num,
+                                    float mean, float deno);
+  // reduce one outer slice of axis_size x inner_size elements along the axis into inner_size elements
+  void (*reduce)(const float *src, float *dst, int inner_size, int axis_size, SimdReduceMode mode);
+} Fp32SimdFuncs;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#ifdef ENABLE_X86_SIMD_DISPATCH
+// the kernels of the widest instruction set the CPU supports, NULL when it supports neither AVX2/FMA nor AVX-512
+const Fp32SimdFuncs *GetFp32SimdFuncs(void);
+
+// call these only when the CPU supports the instruction set
+const Fp32SimdFuncs *GetFp32Avx2Funcs(void);
+const Fp32SimdFuncs *GetFp32Avx512Funcs(void);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_LITE_NNACL_X86_64_AVX_FP32_SIMD_H_
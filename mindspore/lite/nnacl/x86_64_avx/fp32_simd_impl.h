@@ -0,0 +1,303 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_LITE_NNACL_X86_64_AVX_FP32_SIMD_IMPL_H_
+#define MINDSPORE_LITE_NNACL_X86_64_AVX_FP32_SIMD_IMPL_H_
+
+// The kernels written once for any vector width. fp32_avx2.c and fp32_avx512.c each define the MS_* vector macros
+// and the name of the getter of the kernel table for their instruction set, then include this file.
+#include <float.h>
+#include <string.h>
+#include "nnacl/x86_64_avx/fp32_simd.h"
+
+// the tail shorter than a vector goes through the same vector code, so it gets the same results
+static inline MS_FLOAT_SIMD LoadTail(const float *src, int num) {
+  float buf[MS_SIMD_NUM] = {0};
+  memcpy(buf, src, num * sizeof(float));
+  return MS_LD_F32(buf);
+}
+
+static inline void StoreTail(float *dst, MS_FLOAT_SIMD value, int num) {
+  float buf[MS_SIMD_NUM];
+  MS_ST_F32(buf, value);
+  memcpy(dst, buf, num * sizeof(float));
+}
+
+// exp(x) = 2^n * exp(r), where n = round(x / ln2) and r = x - n * ln2 is in [-ln2 / 2, ln2 / 2]. exp(r) is a degree 6
+// polynomial accurate to the float precision, 2^n is written to the exponent bits. Below -87.68 the biased exponent
+// is 0, so the result is 0 instead of a denormal.
+static inline MS_FLOAT_SIMD SimdExp(MS_FLOAT_SIMD x) {
+  x = MS_MAX_F32(MS_MOV_F32(-88.0f), MS_MIN_F32(MS_MOV_F32(88.0f), x));
+  MS_INT_SIMD n = MS_CVT_F32_EPI32(MS_MUL_F32(x, MS_MOV_F32(1.44269504088896341f)));
+  MS_FLOAT_SIMD nf = MS_CVT_EPI32_F32(n);
+  // ln2 is split in two, the high part has few bits so n * ln2_high is exact
+  MS_FLOAT_SIMD r = MS_FNMADD_F32(nf, MS_MOV_F32(0.693359375f), x);
+  r = MS_FNMADD_F32(nf, MS_MOV_F32(-2.12194440e-4f), r);
+  MS_FLOAT_SIMD poly = MS_FMADD_F32(MS_MOV_F32(1.0f / 720), r, MS_MOV_F32(1.0f / 120));
+  poly = MS_FMADD_F32(poly, r, MS_MOV_F32(1.0f / 24));
+  poly = MS_FMADD_F32(poly, r, MS_MOV_F32(1.0f / 6));
+  poly = MS_FMADD_F32(poly, r, MS_MOV_F32(0.5f));
+  poly = MS_FMADD_F32(poly, r, MS_MOV_F32(1.0f));
+  poly = MS_FMADD_F32(poly, r, MS_MOV_F32(1.0f));
+  MS_FLOAT_SIMD pow2n = MS_CAST_EPI32_F32(MS_SLLI_EPI32(MS_ADD_EPI32(n, MS_MOV_EPI32(127)), 23));
+  return MS_MUL_F32(poly, pow2n);
+}
+
+// exp(x) / (1 + exp(x)) is 0 for large negative x and 1 for large positive x, without denormals in between
+static inline MS_FLOAT_SIMD SimdSigmoid(MS_FLOAT_SIMD x) {
+  MS_FLOAT_SIMD exp_x = SimdExp(x);
+  return MS_DIV_F32(exp_x, MS_ADD_F32(MS_MOV_F32(1.0f), exp_x));
+}
+
+static inline MS_FLOAT_SIMD SimdTanh(MS_FLOAT_SIMD x) {
+  x = MS_MAX_F32(MS_MOV_F32(-5.0f), MS_MIN_F32(MS_MOV_F32(5.0f), x));
+  MS_FLOAT_SIMD square = MS_MUL_F32(x, x);
+  MS_FLOAT_SIMD a = MS_ADD_F32(square, MS_MOV_F32(378.0f));
+  a = MS_FMADD_F32(a, square, MS_MOV_F32(17325.0f));
+  a = MS_FMADD_F32(a, square, MS_MOV_F32(135135.0f));
+  a = MS_MUL_F32(a, x);
+  MS_FLOAT_SIMD b = MS_FMADD_F32(MS_MOV_F32(28.0f), square, MS_MOV_F32(3150.0f));
+  b = MS_FMADD_F32(b, square, MS_MOV_F32(62370.0f));
+  b = MS_FMADD_F32(b, square, MS_MOV_F32(135135.0f));
+  // the approximation slightly exceeds 1 close to 5, where TanhOpt switches to 1
+  MS_FLOAT_SIMD one = MS_MOV_F32(1.0f);
+  return MS_MAX_F32(MS_SUB_F32(MS_MOV_F32(0.0f), one), MS_MIN_F32(one, MS_DIV_F32(a, b)));
+}
+
+// 0.5 * x * (1 + tanh(y)) = x * sigmoid(2 * y), with y = sqrt(2 / pi) * (x + 0.044715 * x^3)
+static inline MS_FLOAT_SIMD SimdGeluApproximate(MS_FLOAT_SIMD x) {
+  MS_FLOAT_SIMD cube_coeff = MS_MUL_F32(MS_MUL_F32(x, x), MS_MOV_F32(0.044715f * 1.5957691216057308f));
+  MS_FLOAT_SIMD y2 = MS_FMADD_F32(cube_coeff, x, MS_MUL_F32(x, MS_MOV_F32(1.5957691216057308f)));
+  return MS_MUL_F32(x, SimdSigmoid(y2));
+}
+
+// 0.5 * x * (1 + erf(x / sqrt(2))), erf(z) = 1 - q for z >= 0 where q = poly(t) * exp(-z^2) and t = 1 / (1 + p * z),
+// the approximation 7.1.26 of Abramowitz and Stegun, whose absolute error is below 1.5e-7
+static inline MS_FLOAT_SIMD SimdGeluErf(MS_FLOAT_SIMD x) {
+  MS_FLOAT_SIMD zero = MS_MOV_F32(0.0f);
+  MS_FLOAT_SIMD one = MS_MOV_F32(1.0f);
+  MS_FLOAT_SIMD z = MS_MUL_F32(x, MS_MOV_F32(0.7071067811865476f));
+  MS_FLOAT_SIMD abs_z = MS_MAX_F32(z, MS_SUB_F32(zero, z));
+  MS_FLOAT_SIMD t = MS_DIV_F32(one, MS_FMADD_F32(abs_z, MS_MOV_F32(0.3275911f), one));
+  MS_FLOAT_SIMD poly = MS_FMADD_F32(MS_MOV_F32(1.061405429f), t, MS_MOV_F32(-1.453152027f));
+  poly = MS_FMADD_F32(poly, t, MS_MOV_F32(1.421413741f));
+  poly = MS_FMADD_F32(poly, t, MS_MOV_F32(-0.284496736f));
+  poly = MS_FMADD_F32(poly, t, MS_MOV_F32(0.254829592f));
+  poly = MS_MUL_F32(poly, t);
+  MS_FLOAT_SIMD q = MS_MUL_F32(poly, SimdExp(MS_MUL_F32(MS_SUB_F32(zero, z), z)));
+  // 1 + erf(z) is 2 - q for z >= 0, and q for z < 0 as erf is odd
+  MS_FLOAT_SIMD one_plus_erf = MS_SELECT_NEG_F32(z, MS_SUB_F32(MS_MOV_F32(2.0f), q), q);
+  return MS_MUL_F32(MS_MUL_F32(x, MS_MOV_F32(0.5f)), one_plus_erf);
+}
+
+static void ExpSimd(const float *src, float *dst, int num) {
+  int i = 0;
+  for (; i <= num - MS_SIMD_NUM; i += MS_SIMD_NUM) {
+    MS_ST_F32(dst + i, SimdExp(MS_LD_F32(src + i)));
+  }
+  if (i < num) {
+    StoreTail(dst + i, SimdExp(LoadTail(src + i, num - i)), num - i);
+  }
+}
+
+static void SigmoidSimd(const float *src, float *dst, int num) {
+  int i = 0;
+  for (; i <= num - MS_SIMD_NUM; i += MS_SIMD_NUM) {
+    MS_ST_F32(dst + i, SimdSigmoid(MS_LD_F32(src + i)));
+  }
+  if (i < num) {
+    StoreTail(dst + i, SimdSigmoid(LoadTail(src + i, num - i)), num - i);
+  }
+}
+
+static void TanhSimd(const float *src, float *dst, int num) {
+  int i = 0;
+  for (; i <= num - MS_SIMD_NUM; i += MS_SIMD_NUM) {
+    MS_ST_F32(dst + i, SimdTanh(MS_LD_F32(src + i)));
+  }
+  if (i < num) {
+    StoreTail(dst + i, SimdTanh(LoadTail(src + i, num - i)), num - i);
+  }
+}
+
+static void GeluSimd(const float *src, float *dst, int64_t num, bool approximate) {
+  int64_t i = 0;
+  if (approximate) {
+    for (; i <= num - MS_SIMD_NUM; i += MS_SIMD_NUM) {
+      MS_ST_F32(dst + i, SimdGeluApproximate(MS_LD_F32(src + i)));
+    }
+    if (i < num) {
+      StoreTail(dst + i, SimdGeluApproximate(LoadTail(src + i, num - i)), num - i);
+    }
+  } else {
+    for (; i <= num - MS_SIMD_NUM; i += MS_SIMD_NUM) {
+      MS_ST_F32(dst + i, SimdGeluErf(MS_LD_F32(src + i)));
+    }
+    if (i < num) {
+      StoreTail(dst + i, SimdGeluErf(LoadTail(src + i, num - i)), num - i);
+    }
+  }
+}
+
+// one pass for the max, one for exp(x - max) and its sum, one for the division
+static void SoftmaxLastAxisSimd(const float *src, float *dst, int batch, int channel) {
+  for (int b = 0; b < batch; b++) {
+    const float *src_row = src + b * channel;
+    float *dst_row = dst + b * channel;
+    int j = 0;
+    MS_FLOAT_SIMD max_v = MS_MOV_F32(-FLT_MAX);
+    for (; j <= channel - MS_SIMD_NUM; j += MS_SIMD_NUM) {
+      max_v = MS_MAX_F32(max_v, MS_LD_F32(src_row + j));
+    }
+    float max = MS_REDUCE_MAX_F32(max_v);
+    for (; j < channel; j++) {
+      max = src_row[j] > max ? src_row[j] : max;
+    }
+
+    MS_FLOAT_SIMD max_broadcast = MS_MOV_F32(max);
+    MS_FLOAT_SIMD sum_v = MS_MOV_F32(0.0f);
+    j = 0;
+    for (; j <= channel - MS_SIMD_NUM; j += MS_SIMD_NUM) {
+      MS_FLOAT_SIMD exp_v = SimdExp(MS_SUB_F32(MS_LD_F32(src_row + j), max_broadcast));
+      MS_ST_F32(dst_row + j, exp_v);
+      sum_v = MS_ADD_F32(sum_v, exp_v);
+    }
+    float sum = MS_REDUCE_ADD_F32(sum_v);
+    if (j < channel) {
+      StoreTail(dst_row + j, SimdExp(MS_SUB_F32(LoadTail(src_row + j, channel - j), max_broadcast)), channel - j);
+      for (; j < channel; j++) {
+        sum += dst_row[j];
+      }
+    }
+
+    float scale = 1.0f / sum;
+    MS_FLOAT_SIMD scale_v = MS_MOV_F32(scale);
+    j = 0;
+    for (; j <= channel - MS_SIMD_NUM; j += MS_SIMD_NUM) {
+      MS_ST_F32(dst_row + j, MS_MUL_F32(MS_LD_F32(dst_row + j), scale_v));
+    }
+    for (; j < channel; j++) {
+      dst_row[j] *= scale;
+    }
+  }
+}
+
+static void LayerNormMeanAndSquareSimd(const float *src, int num, float *mean, float *square_mean) {
+  int i = 0;
+  MS_FLOAT_SIMD sum_v = MS_MOV_F32(0.0f);
+  MS_FLOAT_SIMD square_sum_v = MS_MOV_F32(0.0f);
+  for (; i <= num - MS_SIMD_NUM; i += MS_SIMD_NUM) {
+    MS_FLOAT_SIMD src_v = MS_LD_F32(src + i);
+    sum_v = MS_ADD_F32(sum_v, src_v);
+    square_sum_v = MS_FMADD_F32(src_v, src_v, square_sum_v);
+  }
+  float sum = MS_REDUCE_ADD_F32(sum_v);
+  float square_sum = MS_REDUCE_ADD_F32(square_sum_v);
+  for (; i < num; i++) {
+    sum += src[i];
+    square_sum += src[i] * src[i];
+  }
+  *mean = sum / (float)num;
+  *square_mean = square_sum / (float)num;
+}
+
+static void LayerNormGammaAndBetaSimd(float *dst, const float *src, const float *gamma, const float *beta, int num,
+                                      float mean, float deno) {
+  int i = 0;
+  MS_FLOAT_SIMD mean_v = MS_MOV_F32(mean);
+  MS_FLOAT_SIMD deno_v = MS_MOV_F32(deno);
+  for (; i <= num - MS_SIMD_NUM; i += MS_SIMD_NUM) {
+    MS_FLOAT_SIMD norm_v = MS_MUL_F32(MS_SUB_F32(MS_LD_F32(src + i), mean_v), deno_v);
+    MS_ST_F32(dst + i, MS_FMADD_F32(norm_v, MS_LD_F32(gamma + i), MS_LD_F32(beta + i)));
+  }
+  for (; i < num; i++) {
+    dst[i] = (src[i] - mean) * deno * gamma[i] + beta[i];
+  }
+}
+
+static inline float ReduceInitValue(SimdReduceMode mode) {
+  return mode == SIMD_REDUCE_MAX ? -FLT_MAX : (mode == SIMD_REDUCE_MIN ? FLT_MAX : 0.0f);
+}
+
+static inline MS_FLOAT_SIMD ReduceAccumulate(MS_FLOAT_SIMD acc, MS_FLOAT_SIMD value, SimdReduceMode mode) {
+  return mode == SIMD_REDUCE_MAX ? MS_MAX_F32(acc, value)
+                                 : (mode == SIMD_REDUCE_MIN ? MS_MIN_F32(acc, value) : MS_ADD_F32(acc, value));
+}
+
+static inline float ReduceAccumulateScalar(float acc, float value, SimdReduceMode mode) {
+  if (mode == SIMD_REDUCE_MAX) {
+    return acc > value ? acc : value;
+  }
+  if (mode == SIMD_REDUCE_MIN) {
+    return acc < value ? acc : value;
+  }
+  return acc + value;
+}
+
+// the axis is contiguous: the lanes cover the axis and are reduced horizontally at the end
+static float ReduceContiguousAxis(const float *src, int axis_size, SimdReduceMode mode) {
+  int i = 0;
+  MS_FLOAT_SIMD acc = MS_MOV_F32(ReduceInitValue(mode));
+  for (; i <= axis_size - MS_SIMD_NUM; i += MS_SIMD_NUM) {
+    acc = ReduceAccumulate(acc, MS_LD_F32(src + i), mode);
+  }
+  float result = mode == SIMD_REDUCE_MAX
+                   ? MS_REDUCE_MAX_F32(acc)
+                   : (mode == SIMD_REDUCE_MIN ? MS_REDUCE_MIN_F32(acc) : MS_REDUCE_ADD_F32(acc));
+  for (; i < axis_size; i++) {
+    result = ReduceAccumulateScalar(result, src[i], mode);
+  }
+  return mode == SIMD_REDUCE_MEAN ? result / (float)axis_size : result;
+}
+
+// the lanes cover the inner elements, each one accumulates its column along the axis
+static void ReduceSimd(const float *src, float *dst, int inner_size, int axis_size, SimdReduceMode mode) {
+  if (inner_size == 1) {
+    dst[0] = ReduceContiguousAxis(src, axis_size, mode);
+    return;
+  }
+  float init = ReduceInitValue(mode);
+  int k = 0;
+  for (; k <= inner_size - MS_SIMD_NUM; k += MS_SIMD_NUM) {
+    MS_FLOAT_SIMD acc = MS_MOV_F32(init);
+    for (int i = 0; i < axis_size; i++) {
+      acc = ReduceAccumulate(acc, MS_LD_F32(src + i * inner_size + k), mode);
+    }
+    if (mode == SIMD_REDUCE_MEAN) {
+      acc = MS_DIV_F32(acc, MS_MOV_F32((float)axis_size));
+    }
+    MS_ST_F32(dst + k, acc);
+  }
+  for (; k < inner_size; k++) {
+    float acc = init;
+    for (int i = 0; i < axis_size; i++) {
+      acc = ReduceAccumulateScalar(acc, src[i * inner_size + k], mode);
+    }
+    dst[k] = mode == SIMD_REDUCE_MEAN ? acc / (float)axis_size : acc;
+  }
+}
+
+static const Fp32SimdFuncs kFp32SimdFuncs = {ExpSimd,
+                                             SigmoidSimd,
+                                             TanhSimd,
+                                             GeluSimd,
+                                             SoftmaxLastAxisSimd,
+                                             LayerNormMeanAndSquareSimd,
+                                             LayerNormGammaAndBetaSimd,
+                                             ReduceSimd};
+
+const Fp32SimdFuncs *MS_SIMD_GET_FUNCS(void) { return &kFp32SimdFuncs; }
+
+#endif  // MINDSPORE_LITE_NNACL_X86_64_AVX_FP32_SIMD_IMPL_H_
@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 #include <cmath>
+#include <cstring>
 #include "src/dequant.h"
+#include "src/prepared_weights.h"
 
 namespace mindspore::lite {
 float *DequantUtil::DequantWeight(lite::Tensor *input_tensor) {
@@ -50,6 +52,21 @@ void DequantUtil::UnPackToInt(const schema::Tensor *input_tensor, void *unpack_i
   }
 }
 
+void *DequantUtil::DequantSharedWeight(lite::Tensor *input_tensor) {
+  MS_ASSERT(input_tensor != nullptr && input_tensor->prepared_weights() != nullptr);
+  auto size = input_tensor->ElementsNum() * sizeof(float);
+  return input_tensor->prepared_weights()->GetOrPack(
+    input_tensor->tensor_index(), "dequant_fp32", size, [input_tensor, size](void *dst) {
+      auto *dequant_weight = DequantUtil::DequantWeight(input_tensor);
+      if (dequant_weight == nullptr) {
+        return RET_ERROR;
+      }
+      memcpy(dst, dequant_weight, size);
+      free(dequant_weight);
+      return RET_OK;
+    });
+}
+
 std::map<Tensor *, std::pair<TypeId, void *>> DequantUtil::DequantTensor(const std::vector<Tensor *> &in_tensors,
                                                                          TypeId data_type, bool need_restore) {
   std::map<Tensor *, std::pair<TypeId, void *>> tensor_origin_data;
@@ -61,7 +78,17 @@ std::map<Tensor *, std::pair<TypeId, void *>> DequantUtil::DequantTensor(const s
       bool dequant_flag = !weight_tensor->quant_params().empty() && weight_tensor->quant_params().front().inited &&
                           restore_data != nullptr &&
                           (restore_type == kNumberTypeInt8 || restore_type == kNumberTypeInt16);
-      if (dequant_flag) {
+      if (dequant_flag && !need_restore && weight_tensor->prepared_weights() != nullptr) {
+        // kept for the kernel which is not packed, dequantize it once for all the sessions of the model
+        auto *dequant_weight = DequantSharedWeight(weight_tensor);
+        if (dequant_weight == nullptr) {
+          MS_LOG(ERROR) << "dequant data is nullptr.";
+          return tensor_origin_data;
+        }
+        weight_tensor->FreeData();
+        weight_tensor->set_data(dequant_weight);
+        weight_tensor->set_data_type(kNumberTypeFloat32);
+      } else if (dequant_flag) {
         auto *dequant_weight = DequantUtil::DequantWeight(weight_tensor);
         if (dequant_weight == nullptr) {
           MS_LOG(ERROR) << "dequant data is nullptr.";
@@ -31,6 +31,9 @@ class DequantUtil {
  public:
   static float *DequantWeight(lite::Tensor *input_tensor);
 
+  // dequantize the weight into the prepared weights of the model it is read from
+  static void *DequantSharedWeight(lite::Tensor *input_tensor);
+
   static void UnPackToInt(const schema::Tensor *input_tensor, void *weight_unpack_data);
 
   static std::map<Tensor *, std::pair<TypeId, void *>> DequantTensor(const std::vector<Tensor *> &in_tensors,
@@ -25,6 +25,8 @@ namespace mindspore::lite {
 InnerContext::InnerContext(const Context *context) {
   this->allocator = context->allocator;
   this->thread_num_ = context->thread_num_;
+  this->thread_pool_type_ = context->thread_pool_type_;
+  this->enable_parallel_ = context->enable_parallel_;
   this->device_list_.clear();
   for (auto &device_ctx : context->device_list_) {
     this->device_list_.push_back(device_ctx);
@@ -37,8 +39,8 @@ int InnerContext::Init() {
     return RET_NOT_SUPPORT;
   }
   if (this->thread_pool_ == nullptr && this->IsCpuEnabled()) {
-    this->thread_pool_ =
-      CreateLiteThreadPool(this->thread_num_, this->device_list_[0].device_info_.cpu_device_info_.cpu_bind_mode_);
+    this->thread_pool_ = CreateLiteThreadPool(
+      this->thread_num_, this->device_list_[0].device_info_.cpu_device_info_.cpu_bind_mode_, this->thread_pool_type_);
     if (this->thread_pool_ == nullptr) {
       MS_LOG(ERROR) << "Create ThreadPool failed";
       return RET_NULL_PTR;
@@ -51,6 +53,10 @@ int InnerContext::Init() {
       return RET_NULL_PTR;
     }
   }
+  if (this->enable_parallel_) {
+    // the kernels running on parallel branches allocate their buffers concurrently
+    this->allocator->SetContext({kDefaultShiftFactor, true});
+  }
   if (IsNpuEnabled()) {
     MS_LOG(DEBUG) << "NPU enabled.";
   }
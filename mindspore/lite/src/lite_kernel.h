@@ -175,6 +175,8 @@ class LiteKernel {
 
   virtual std::string ToString() const;
 
+  bool InferShapeDone() const { return !(primitive_ != nullptr && !primitive_->infer_flag()); }
+
 #ifdef SUPPORT_TRAIN
   void set_workspace_size(size_t value) { workspace_size_ = value; }
   size_t workspace_size() { return workspace_size_; }
@@ -184,8 +186,6 @@ class LiteKernel {
 #endif
 
  protected:
-  bool InferShapeDone() { return !(primitive_ != nullptr && !primitive_->infer_flag()); }
-
   KernelKey desc_{};
   std::string name_;
   OpParameter *op_parameter_ = nullptr;
@@ -15,9 +15,17 @@
  */
 
 #include "src/lite_model.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <fstream>
 #include <vector>
 #include <set>
 #include <unordered_map>
+#include "src/common/file_utils.h"
 #include "src/ops/while.h"
 #ifdef ENABLE_V0
 #include "src/ops/compat/compat_register.h"
@@ -93,8 +101,17 @@ int LiteModel::ConvertAttrToTensors(const void *meta_graph) {
 
 void LiteModel::Free() {
   if (this->buf != nullptr) {
+#ifndef _WIN32
+    if (this->buf_mapped_) {
+      munmap(this->buf, this->buf_size_);
+    } else {
+      free(this->buf);
+    }
+#else
     free(this->buf);
+#endif
     this->buf = nullptr;
+    this->buf_mapped_ = false;
   }
   for (auto &tensor_buf : attr_tensor_bufs_) {
     free(tensor_buf);
@@ -345,5 +362,79 @@ Model *ImportFromBuffer(const char *model_buf, size_t size, bool take_buf) {
   return model;
 }
 
+Model *ImportFromFile(const char *model_path) {
+  if (model_path == nullptr) {
+    MS_LOG(ERROR) << "The model path is nullptr";
+    return nullptr;
+  }
+  auto real_path = RealPath(model_path);
+  if (real_path.empty()) {
+    return nullptr;
+  }
+#ifndef _WIN32
+  int fd = open(real_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Open model file " << real_path << " failed";
+    return nullptr;
+  }
+  struct stat file_stat {};
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    MS_LOG(ERROR) << "The model file " << real_path << " is empty or can not be read";
+    close(fd);
+    return nullptr;
+  }
+  auto size = static_cast<size_t>(file_stat.st_size);
+  // the pages are copied on write, the file is never modified
+  auto buf = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (buf == MAP_FAILED) {
+    MS_LOG(ERROR) << "Map model file " << real_path << " failed";
+    return nullptr;
+  }
+  auto *model = new (std::nothrow) LiteModel();
+  if (model == nullptr) {
+    MS_LOG(ERROR) << "new model fail!";
+    munmap(buf, size);
+    return nullptr;
+  }
+  model->buf = static_cast<char *>(buf);
+  model->buf_size_ = size;
+  model->buf_mapped_ = true;
+  auto status = model->ConstructModel();
+  if (status != RET_OK) {
+    MS_LOG(ERROR) << "construct model failed.";
+    delete model;
+    return nullptr;
+  }
+  return model;
+#else
+  std::ifstream ifs(real_path, std::ios::binary | std::ios::ate);
+  if (!ifs.is_open()) {
+    MS_LOG(ERROR) << "Open model file " << real_path << " failed";
+    return nullptr;
+  }
+  auto size = static_cast<size_t>(ifs.tellg());
+  if (size == 0) {
+    MS_LOG(ERROR) << "The model file " << real_path << " is empty";
+    return nullptr;
+  }
+  auto buf = reinterpret_cast<char *>(malloc(size));
+  if (buf == nullptr) {
+    MS_LOG(ERROR) << "malloc model buf failed, size=" << size;
+    return nullptr;
+  }
+  ifs.seekg(0, std::ios::beg);
+  ifs.read(buf, size);
+  if (!ifs || static_cast<size_t>(ifs.gcount()) != size) {
+    MS_LOG(ERROR) << "Only read " << ifs.gcount() << " of " << size << " bytes in model file " << real_path;
+    free(buf);
+    return nullptr;
+  }
+  return ImportFromBuffer(buf, size, true);
+#endif
+}
+
 Model *Model::Import(const char *model_buf, size_t size) { return ImportFromBuffer(model_buf, size, false); }
+
+Model *Model::ImportFromFile(const char *model_path) { return lite::ImportFromFile(model_path); }
 }  // namespace mindspore::lite
@@ -17,9 +17,11 @@
 #ifndef MINDSPORE_LITE_SRC_LITE_MODEL_H_
 #define MINDSPORE_LITE_SRC_LITE_MODEL_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 #include "include/model.h"
+#include "src/prepared_weights.h"
 #include "src/ops/primitive_c.h"
 #include "include/version.h"
 #include "schema/model_generated.h"
@@ -46,6 +48,8 @@ class LiteModel : public Model {
 
   ~LiteModel() override { Destroy(); }
 
+  std::shared_ptr<PreparedWeights> prepared_weights() const { return this->prepared_weights_; }
+
  private:
 #ifdef ENABLE_V0
   int ConvertAttrs(Model::Node *node, const schema::v0::Primitive *prim, std::vector<schema::Tensor *> *dst_tensor);
@@ -217,12 +221,17 @@ class LiteModel : public Model {
 
  public:
   size_t buf_size_ = 0;
+  // buf is mapped from the model file instead of malloced
+  bool buf_mapped_ = false;
 
  protected:
   std::vector<char *> attr_tensor_bufs_;
+  std::shared_ptr<PreparedWeights> prepared_weights_ = std::make_shared<PreparedWeights>();
 };
 
 Model *ImportFromBuffer(const char *model_buf, size_t size, bool take_buf);
+
+Model *ImportFromFile(const char *model_path);
 }  // namespace lite
 }  // namespace mindspore
 
@@ -94,6 +94,13 @@ int LiteSession::ConvertTensorsData(const lite::Model *model, size_t tensor_inde
     int org_size = dst_tensor->Size();
     return (pack_size != org_size) && (data_type == kNumberTypeInt8 || data_type == kNumberTypeInt16);
   };
+  // the scheduler replaces the data of the weights it dequantizes for the kernels, see DequantUtil::DequantTensor
+  auto NeedDequant = [&src_tensor]() -> bool {
+    auto data_type = src_tensor->dataType();
+    auto quant_params = src_tensor->quantParams();
+    return quant_params != nullptr && quant_params->size() > 0 && quant_params->Get(0)->inited() &&
+           (data_type == kNumberTypeInt8 || data_type == kNumberTypeInt16);
+  };
   auto src_category = TensorCategory(src_tensor);
   if ((src_category == Tensor::Category::CONST_TENSOR || src_category == Tensor::Category::CONST_SCALAR) &&
       src_tensor->data() != nullptr && src_tensor->data()->size() > 0) {
@@ -107,7 +114,16 @@ int LiteSession::ConvertTensorsData(const lite::Model *model, size_t tensor_inde
         return RET_ERROR;
       }
     } else {
-      if (WeightTensorNeedCopy(model, tensor_index)) {
+      bool need_copy = WeightTensorNeedCopy(model, tensor_index);
+      if (need_copy && !NeedDequant()) {
+        // the copy is shared by the sessions compiling the model, it is never freed by the session
+        auto dst_data = prepared_weights_->GetOrPrepare(tensor_index, src_tensor, dst_tensor->Size(), NeedUnPack());
+        if (dst_data == nullptr) {
+          MS_LOG(ERROR) << "Prepare weight of tensor " << tensor_index << " failed";
+          return RET_NULL_PTR;
+        }
+        dst_tensor->set_data(dst_data);
+      } else if (need_copy) {
         auto dst_data = dst_tensor->MutableData();
         if (dst_data == nullptr) {
           MS_LOG(ERROR) << "Data from tensor is nullptr";
@@ -164,6 +180,8 @@ lite::Tensor *LiteSession::ConvertTensor(const schema::Tensor &src_tensor) {
 int LiteSession::ConvertTensors(const lite::Model *model) {
   MS_ASSERT(model != nullptr);
   copyed_tensor_idxes_.clear();
+  this->prepared_weights_ = static_cast<const LiteModel *>(model)->prepared_weights();
+  MS_ASSERT(this->prepared_weights_ != nullptr);
   uint32_t tensor_count = model->all_tensors_.size();
   MS_ASSERT(!model->sub_graphs_.empty());
   auto model_input_indices = model->sub_graphs_.front()->input_indices_;
@@ -188,6 +206,12 @@ int LiteSession::ConvertTensors(const lite::Model *model) {
     if (IsContain(model_input_indices, i)) {
       dst_tensor->set_category(Tensor::GRAPH_INPUT);
     }
+#ifndef SUPPORT_TRAIN
+    // the kernels pack this weight once for all the sessions of the model
+    if (dst_tensor->IsConst()) {
+      dst_tensor->set_prepared_weights(prepared_weights_.get(), i);
+    }
+#endif
     if (src_tensor->name() != nullptr) {
       dst_tensor->set_tensor_name(src_tensor->name()->str());
     }
@@ -536,6 +560,10 @@ LiteSession::~LiteSession() {
     if (tensor->IsConst() && !IsContain(this->inputs_, tensor) && !IsContain(copyed_tensor_idxes_, i)) {
       tensor->set_data(nullptr);
     }
+    // weight dequantized by the scheduler into the prepared weights
+    if (prepared_weights_ != nullptr && prepared_weights_->Contains(tensor->data_c())) {
+      tensor->set_data(nullptr);
+    }
     delete tensor;
   }
   // Tensor * in input_map output_map are freed in tensors
@@ -560,6 +588,16 @@ LiteSession::~LiteSession() {
   is_running_.store(false);
 }
 
+size_t LiteSession::GetArenaSize() const {
+  size_t arena_size = 0;
+  for (auto kernel : this->kernels_) {
+    if (kernel->subgraph_type() == kernel::kCpuFP32SubGraph || kernel->subgraph_type() == kernel::kCpuFP16SubGraph) {
+      arena_size += static_cast<kernel::CpuSubGraph *>(kernel)->arena_size();
+    }
+  }
+  return arena_size;
+}
+
 mindspore::tensor::MSTensor *LiteSession::GetInputsByTensorName(const std::string &name) const {
   auto ret = input_map_.find(name);
   if (ret == input_map_.end()) {
@@ -31,6 +31,7 @@
 #include "src/executor.h"
 #include "src/tensor.h"
 #include "src/tensorlist.h"
+#include "src/prepared_weights.h"
 #if SUPPORT_GPU
 #include "src/runtime/opencl/opencl_runtime.h"
 #endif
@@ -66,6 +67,8 @@ class LiteSession : public session::LiteSession {
   int Resize(const std::vector<mindspore::tensor::MSTensor *> &inputs,
              const std::vector<std::vector<int>> &dims) override;
 
+  size_t GetArenaSize() const override;
+
   void set_model(Model *model) { this->model_ = model; }
 
  protected:
@@ -126,6 +129,8 @@ class LiteSession : public session::LiteSession {
   std::unordered_map<std::string, mindspore::tensor::MSTensor *> output_tensor_map_;
   Executor *executor_ = nullptr;
   Model *model_ = nullptr;
+  // weights shared with the other sessions compiling the same model
+  std::shared_ptr<PreparedWeights> prepared_weights_;
   std::atomic<bool> is_running_ = false;
 #if SUPPORT_GPU && !SUPPORT_TRAIN
   opencl::OpenCLRuntimeWrapper *opencl_runtime_wrapper_{nullptr};
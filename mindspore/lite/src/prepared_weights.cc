@@ -0,0 +1,127 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/prepared_weights.h"
+#include <cstring>
+#include "src/dequant.h"
+#include "src/tensor.h"
+#include "include/errorcode.h"
+#include "src/common/log_adapter.h"
+
+namespace mindspore::lite {
+PreparedWeights::~PreparedWeights() {
+  for (auto &weight : weights_) {
+    free(weight.second);
+  }
+  weights_.clear();
+  for (auto &weight : packed_weights_) {
+    free(weight.second);
+  }
+  packed_weights_.clear();
+}
+
+void *PreparedWeights::GetOrPrepare(size_t tensor_index, const schema::Tensor *src_tensor, size_t size, bool unpack) {
+  MS_ASSERT(src_tensor != nullptr && src_tensor->data() != nullptr);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = weights_.find(tensor_index);
+  if (iter != weights_.end()) {
+    return iter->second;
+  }
+  auto data = malloc(size);
+  if (data == nullptr) {
+    MS_LOG(ERROR) << "Malloc prepared weight failed, size=" << size;
+    return nullptr;
+  }
+  if (unpack) {
+    DequantUtil::UnPackToInt(src_tensor, data);
+  } else {
+    memcpy(data, src_tensor->data()->data(), size);
+  }
+  weights_[tensor_index] = data;
+  total_size_ += size;
+  return data;
+}
+
+void *PreparedWeights::GetOrPack(size_t tensor_index, const std::string &pack_format, size_t size,
+                                 const PackFunc &pack) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto key = std::make_pair(tensor_index, pack_format);
+  auto iter = packed_weights_.find(key);
+  if (iter != packed_weights_.end()) {
+    return iter->second;
+  }
+  auto data = malloc(size);
+  if (data == nullptr) {
+    MS_LOG(ERROR) << "Malloc packed weight failed, size=" << size;
+    return nullptr;
+  }
+  memset(data, 0, size);
+  if (pack(data) != RET_OK) {
+    MS_LOG(ERROR) << "Pack weight of tensor " << tensor_index << " in " << pack_format << " failed";
+    free(data);
+    return nullptr;
+  }
+  packed_weights_[key] = data;
+  total_size_ += size;
+  return data;
+}
+
+bool PreparedWeights::Contains(const void *data) {
+  if (data == nullptr) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &weight : weights_) {
+    if (weight.second == data) {
+      return true;
+    }
+  }
+  for (auto &weight : packed_weights_) {
+    if (weight.second == data) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void *PreparedWeights::PackWeight(const Tensor *weight, const std::string &pack_format, size_t size,
+                                  const PackFunc &pack, bool *shared) {
+  MS_ASSERT(weight != nullptr);
+  MS_ASSERT(shared != nullptr);
+  auto prepared_weights = weight->prepared_weights();
+  *shared = prepared_weights != nullptr;
+  if (*shared) {
+    return prepared_weights->GetOrPack(weight->tensor_index(), pack_format, size, pack);
+  }
+  auto data = malloc(size);
+  if (data == nullptr) {
+    MS_LOG(ERROR) << "Malloc packed weight failed, size=" << size;
+    return nullptr;
+  }
+  memset(data, 0, size);
+  if (pack(data) != RET_OK) {
+    MS_LOG(ERROR) << "Pack weight in " << pack_format << " failed";
+    free(data);
+    return nullptr;
+  }
+  return data;
+}
+
+size_t PreparedWeights::total_size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return total_size_;
+}
+}  // namespace mindspore::lite
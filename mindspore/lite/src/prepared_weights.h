@@ -0,0 +1,72 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_PREPARED_WEIGHTS_H_
+#define MINDSPORE_LITE_SRC_PREPARED_WEIGHTS_H_
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "schema/model_generated.h"
+
+namespace mindspore::lite {
+// The weights of a model which the sessions can not read from the model buffer directly: weights copied out of the
+// buffer for the kernels which are not packed, weights unpacked from low bits, weights dequantized to fp32 for the
+// kernels which are not packed, and the weights packed by the convolution and matmul kernels. Each weight is prepared
+// once by the first session compiling the model, keyed by its tensor index and, for a packed weight, by the pack format
+// of the kernel, the other sessions attach to it instead of keeping their own copy. The model and the sessions hold the
+// prepared weights by shared_ptr, so they live until the last of them is released, even after Model::Free. A prepared
+// weight is never written again, the sessions may compile and run concurrently. Training sessions pack again in Eval,
+// so they do not attach their tensors and every kernel keeps its own packed copy.
+class Tensor;
+
+class PreparedWeights {
+ public:
+  // fill the zeroed buffer of a packed weight, returns RET_OK on success
+  using PackFunc = std::function<int(void *dst)>;
+
+  PreparedWeights() = default;
+  ~PreparedWeights();
+  PreparedWeights(const PreparedWeights &) = delete;
+  PreparedWeights &operator=(const PreparedWeights &) = delete;
+
+  // get the data of the weight tensor_index, it is copied or unpacked from src_tensor into size bytes the first time
+  void *GetOrPrepare(size_t tensor_index, const schema::Tensor *src_tensor, size_t size, bool unpack);
+  // get the weight tensor_index packed in pack_format, it is packed by pack into size bytes the first time
+  void *GetOrPack(size_t tensor_index, const std::string &pack_format, size_t size, const PackFunc &pack);
+  // whether data is one of the prepared weights, which must not be freed by a session or kernel
+  bool Contains(const void *data);
+  // the bytes of all the prepared weights
+  size_t total_size();
+
+  // pack the weight tensor in pack_format into size bytes. The packed weight is shared by the sessions of the model if
+  // the weight is attached to its prepared weights, *shared is set then and the caller must not free it, otherwise it
+  // is packed into a malloc'd buffer owned by the caller.
+  static void *PackWeight(const Tensor *weight, const std::string &pack_format, size_t size, const PackFunc &pack,
+                          bool *shared);
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<size_t, void *> weights_;
+  std::map<std::pair<size_t, std::string>, void *> packed_weights_;
+  size_t total_size_ = 0;
+};
+}  // namespace mindspore::lite
+
+#endif  // MINDSPORE_LITE_SRC_PREPARED_WEIGHTS_H_
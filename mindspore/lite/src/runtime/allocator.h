@@ -26,6 +26,9 @@
 #include <unordered_set>
 
 namespace mindspore::lite {
+// 6 is empirical value
+constexpr int kDefaultShiftFactor = 6;
+
 struct AllocatorContext {
   int shiftFactor;
   bool lockFlag;
@@ -67,8 +70,7 @@ class DefaultAllocator : public Allocator {
   // <membuf->buf, membuf>
   std::unordered_map<void *, MemBuf *> allocatedList_;
   std::multimap<size_t, MemBuf *> freeList_;
-  // 6 is empirical value
-  int shiftFactor_ = 6;
+  int shiftFactor_ = kDefaultShiftFactor;
   bool lockFlag_ = false;
 };
 
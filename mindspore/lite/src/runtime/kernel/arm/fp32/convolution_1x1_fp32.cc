@@ -15,6 +15,7 @@
  */
 
 #include "src/runtime/kernel/arm/fp32/convolution_1x1_fp32.h"
+#include <string>
 #include "src/runtime/runtime_api.h"
 
 using mindspore::lite::RET_ERROR;
@@ -24,7 +25,7 @@ using mindspore::lite::RET_OK;
 namespace mindspore::kernel {
 Convolution1x1CPUKernel::~Convolution1x1CPUKernel() {
   FreeTmpBuffer();
-  if (weight_ptr_ != nullptr) {
+  if (weight_ptr_ != nullptr && !shared_weight_) {
     free(weight_ptr_);
     weight_ptr_ = nullptr;
   }
@@ -102,21 +103,27 @@ int Convolution1x1CPUKernel::InitConv1x1BiasWeight() {
     memset(reinterpret_cast<char *>(bias_data_) + weight_size, 0, size - weight_size);
   }
 
+  // the same layout as the im2col convolution with a 1x1 kernel, so they share the packed weight
   int size = input_channel * UP_ROUND(output_channel, col_tile_) * sizeof(float);
-  int down_size = input_channel * DOWN_DIV(output_channel, col_tile_) * col_tile_ * sizeof(float);
-  weight_ptr_ = reinterpret_cast<float *>(malloc(size));
-  if (weight_ptr_ == nullptr) {
-    MS_LOG(ERROR) << "Conv1x1 Malloc weight_ptr_ error!";
-    return RET_ERROR;
-  }
-  memset(reinterpret_cast<char *>(weight_ptr_) + down_size, 0, size - down_size);
+  auto origin_weight = origin_weight_;
+  weight_ptr_ = reinterpret_cast<float *>(lite::PreparedWeights::PackWeight(
+    filter_tensor, "conv_col" + std::to_string(col_tile_), size,
+    [origin_weight, output_channel, input_channel](void *dst) {
+      auto weight_ptr = reinterpret_cast<float *>(dst);
 #ifdef ENABLE_AVX
-  RowMajor2Col16Major(origin_weight_, weight_ptr_, output_channel, input_channel);
+      RowMajor2Col16Major(origin_weight, weight_ptr, output_channel, input_channel);
 #elif defined(ENABLE_ARM32)
-  RowMajor2Col4Major(origin_weight_, weight_ptr_, output_channel, input_channel);
+      RowMajor2Col4Major(origin_weight, weight_ptr, output_channel, input_channel);
 #else
-  RowMajor2Col8Major(origin_weight_, weight_ptr_, output_channel, input_channel);
+      RowMajor2Col8Major(origin_weight, weight_ptr, output_channel, input_channel);
 #endif
+      return RET_OK;
+    },
+    &shared_weight_));
+  if (weight_ptr_ == nullptr) {
+    MS_LOG(ERROR) << "Conv1x1 Malloc weight_ptr_ error!";
+    return RET_ERROR;
+  }
   return RET_OK;
 }
 
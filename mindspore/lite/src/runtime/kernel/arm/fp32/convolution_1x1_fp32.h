@@ -20,6 +20,7 @@
 #include <float.h>
 #include <vector>
 #include "src/lite_kernel.h"
+#include "src/prepared_weights.h"
 #include "include/errorcode.h"
 #include "nnacl/op_base.h"
 #include "src/runtime/kernel/arm/base/convolution_base.h"
@@ -65,6 +66,7 @@ class Convolution1x1CPUKernel : public ConvolutionBaseCPUKernel {
   float *origin_weight_;  // do not free
   float *origin_bias_;    // do not free
   float *weight_ptr_ = nullptr;
+  bool shared_weight_ = false;  // weight_ptr_ is in the prepared weights of the model, do not free
   float *pack_input_ = nullptr;
   float *input_ptr_ = nullptr;
   float *output_ptr_ = nullptr;
@@ -32,7 +32,7 @@ using mindspore::schema::PrimitiveType_DepthwiseConv2D;
 
 namespace mindspore::kernel {
 ConvolutionDepthwiseCPUKernel::~ConvolutionDepthwiseCPUKernel() {
-  if (packed_weight_ != nullptr) {
+  if (packed_weight_ != nullptr && !shared_weight_) {
     free(packed_weight_);
     packed_weight_ = nullptr;
   }
@@ -48,12 +48,18 @@ int ConvolutionDepthwiseCPUKernel::InitWeightBias() {
     MS_LOG(ERROR) << "pack_weight_size is invalid, pack_weight_size: " << pack_weight_size;
     return RET_ERROR;
   }
-  packed_weight_ = reinterpret_cast<float *>(malloc(pack_weight_size * sizeof(float)));
+  int plane = weight_tensor->Height() * weight_tensor->Width();
+  packed_weight_ = reinterpret_cast<float *>(lite::PreparedWeights::PackWeight(
+    weight_tensor, "dw_hwk", pack_weight_size * sizeof(float),
+    [origin_weight, plane, channel](void *dst) {
+      PackWeightKHWToHWKFp32(origin_weight, reinterpret_cast<float *>(dst), plane, channel);
+      return RET_OK;
+    },
+    &shared_weight_));
   if (packed_weight_ == nullptr) {
     MS_LOG(ERROR) << "Malloc buffer failed.";
     return RET_ERROR;
   }
-  PackWeightKHWToHWKFp32(origin_weight, packed_weight_, weight_tensor->Height() * weight_tensor->Width(), channel);
 
   bias_data_ = reinterpret_cast<float *>(malloc(channel * sizeof(float)));
   if (bias_data_ == nullptr) {
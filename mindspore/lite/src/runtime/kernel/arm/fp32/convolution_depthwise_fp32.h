@@ -19,6 +19,7 @@
 
 #include <vector>
 #include "src/lite_kernel.h"
+#include "src/prepared_weights.h"
 #include "src/runtime/kernel/arm/base/convolution_base.h"
 #include "nnacl/fp32/conv_depthwise_fp32.h"
 
@@ -42,6 +43,7 @@ class ConvolutionDepthwiseCPUKernel : public ConvolutionBaseCPUKernel {
  private:
   void PackWeight();
   float *packed_weight_ = nullptr;
+  bool shared_weight_ = false;  // packed_weight_ is in the prepared weights of the model, do not free
   float *input_ptr_ = nullptr;
   float *output_ptr_ = nullptr;
 };
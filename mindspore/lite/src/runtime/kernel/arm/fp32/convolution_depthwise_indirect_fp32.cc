@@ -15,6 +15,7 @@
  */
 
 #include "src/runtime/kernel/arm/fp32/convolution_depthwise_indirect_fp32.h"
+#include <string>
 #include "schema/model_generated.h"
 #include "src/kernel_registry.h"
 #include "include/errorcode.h"
@@ -29,7 +30,7 @@ using mindspore::schema::PrimitiveType_DepthwiseConv2D;
 
 namespace mindspore::kernel {
 ConvolutionDepthwiseIndirectCPUKernel::~ConvolutionDepthwiseIndirectCPUKernel() {
-  if (packed_weight_ != nullptr) {
+  if (packed_weight_ != nullptr && !shared_weight_) {
     free(packed_weight_);
     packed_weight_ = nullptr;
   }
@@ -55,18 +56,24 @@ int ConvolutionDepthwiseIndirectCPUKernel::InitWeightBias() {
   int batch_flag = UP_DIV(weight_tensor->Batch(), div_flag);
   int pack_weight_size = div_flag * batch_flag * weight_tensor->Height() * weight_tensor->Width();
 
-  packed_weight_ = reinterpret_cast<float *>(malloc(pack_weight_size * sizeof(float)));
+  int height = weight_tensor->Height();
+  int width = weight_tensor->Width();
+  int batch = weight_tensor->Batch();
+  packed_weight_ = reinterpret_cast<float *>(lite::PreparedWeights::PackWeight(
+    weight_tensor, "dw_indirect_c" + std::to_string(div_flag), pack_weight_size * sizeof(float),
+    [origin_weight, height, width, batch](void *dst) {
+#ifdef ENABLE_AVX
+      PackDepthwiseIndirectWeightC8Fp32(origin_weight, reinterpret_cast<float *>(dst), height, width, batch);
+#else
+      PackDepthwiseIndirectWeightC4Fp32(origin_weight, reinterpret_cast<float *>(dst), height, width, batch);
+#endif
+      return RET_OK;
+    },
+    &shared_weight_));
   if (packed_weight_ == nullptr) {
     MS_LOG(ERROR) << "Malloc buffer failed.";
     return RET_ERROR;
   }
-#ifdef ENABLE_AVX
-  PackDepthwiseIndirectWeightC8Fp32(origin_weight, packed_weight_, weight_tensor->Height(), weight_tensor->Width(),
-                                    weight_tensor->Batch());
-#else
-  PackDepthwiseIndirectWeightC4Fp32(origin_weight, packed_weight_, weight_tensor->Height(), weight_tensor->Width(),
-                                    weight_tensor->Batch());
-#endif
 
   bias_data_ = reinterpret_cast<float *>(malloc(batch_flag * div_flag * sizeof(float)));
   if (bias_data_ == nullptr) {
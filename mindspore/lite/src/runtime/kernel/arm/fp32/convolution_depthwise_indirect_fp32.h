@@ -19,6 +19,7 @@
 
 #include <vector>
 #include "src/lite_kernel.h"
+#include "src/prepared_weights.h"
 #include "src/runtime/kernel/arm/base/convolution_base.h"
 #include "nnacl/fp32/conv_depthwise_fp32.h"
 
@@ -48,6 +49,7 @@ class ConvolutionDepthwiseIndirectCPUKernel : public ConvolutionBaseCPUKernel {
   float **indirect_buffer_ = nullptr;
   float *zero_ptr_ = nullptr;
   float *packed_weight_ = nullptr;
+  bool shared_weight_ = false;  // packed_weight_ is in the prepared weights of the model, do not free
   float *output_ptr_ = nullptr;
   float *packed_input_ = nullptr;
 };
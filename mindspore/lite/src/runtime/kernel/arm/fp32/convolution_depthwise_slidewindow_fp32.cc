@@ -32,7 +32,7 @@ ConvolutionDepthwiseSWCPUKernel::~ConvolutionDepthwiseSWCPUKernel() {
     delete sliding_;
     sliding_ = nullptr;
   }
-  if (packed_weight_ != nullptr) {
+  if (packed_weight_ != nullptr && !shared_weight_) {
     free(packed_weight_);
     packed_weight_ = nullptr;
   }
@@ -45,13 +45,19 @@ int ConvolutionDepthwiseSWCPUKernel::InitWeightBias() {
   int OC4 = UP_DIV(weight_tensor->Batch(), C4NUM);
   int pack_weight_size = C4NUM * OC4 * weight_tensor->Height() * weight_tensor->Width();
 
-  packed_weight_ = reinterpret_cast<float *>(malloc(pack_weight_size * sizeof(float)));
+  int plane = weight_tensor->Height() * weight_tensor->Width();
+  int batch = weight_tensor->Batch();
+  packed_weight_ = reinterpret_cast<float *>(lite::PreparedWeights::PackWeight(
+    weight_tensor, "dw_nc4hw4", pack_weight_size * sizeof(float),
+    [origin_weight, plane, batch](void *dst) {
+      PackNCHWToNC4HW4Fp32(origin_weight, reinterpret_cast<float *>(dst), 1, plane, batch);
+      return RET_OK;
+    },
+    &shared_weight_));
   if (packed_weight_ == nullptr) {
     MS_LOG(ERROR) << "Malloc buffer failed.";
     return RET_ERROR;
   }
-  PackNCHWToNC4HW4Fp32(origin_weight, packed_weight_, 1, weight_tensor->Height() * weight_tensor->Width(),
-                       weight_tensor->Batch());
 
   int malloc_size = MSMAX(conv_param_->output_channel_, C4NUM * OC4);
   if (malloc_size <= 0) {
@@ -19,6 +19,7 @@
 
 #include <vector>
 #include "src/lite_kernel.h"
+#include "src/prepared_weights.h"
 #include "src/runtime/kernel/arm/base/convolution_base.h"
 #include "nnacl/fp32/conv_depthwise_fp32.h"
 
@@ -45,6 +46,7 @@ class ConvolutionDepthwiseSWCPUKernel : public ConvolutionBaseCPUKernel {
   void PackWeight();
   SlidingWindowParam *sliding_ = nullptr;
   float *packed_weight_ = nullptr;
+  bool shared_weight_ = false;  // packed_weight_ is in the prepared weights of the model, do not free
   float *packed_input_ = nullptr;
   float *packed_output_ = nullptr;
   bool need_align_ = false;
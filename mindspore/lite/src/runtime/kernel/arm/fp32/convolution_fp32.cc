@@ -15,6 +15,7 @@
  */
 
 #include "src/runtime/kernel/arm/fp32/convolution_fp32.h"
+#include <string>
 #include "include/errorcode.h"
 #include "schema/model_generated.h"
 #include "src/kernel_registry.h"
@@ -48,19 +49,25 @@ int ConvolutionCPUKernel::InitWeightBias() {
   int oc_block_num = UP_ROUND(out_channel, oc_block);
   int pack_weight_size = oc_block_num * in_channel * kernel_plane;
 
-  packed_weight_ = reinterpret_cast<float *>(malloc(pack_weight_size * sizeof(float)));
-  if (packed_weight_ == nullptr) {
-    MS_LOG(ERROR) << "malloc packed weight failed.";
-    return RET_ERROR;
-  }
-  memset(packed_weight_, 0, pack_weight_size * sizeof(float));
+  auto origin_weight = origin_weight_;
+  packed_weight_ = reinterpret_cast<float *>(lite::PreparedWeights::PackWeight(
+    filter_tensor, "conv_col" + std::to_string(oc_block), pack_weight_size * sizeof(float),
+    [origin_weight, out_channel, in_channel, kernel_plane](void *dst) {
+      auto packed_weight = reinterpret_cast<float *>(dst);
 #ifdef ENABLE_AVX
-  RowMajor2Col16Major(origin_weight_, packed_weight_, out_channel, in_channel * kernel_plane);
+      RowMajor2Col16Major(origin_weight, packed_weight, out_channel, in_channel * kernel_plane);
 #elif ENABLE_ARM32
-  RowMajor2Col4Major(origin_weight_, packed_weight_, out_channel, in_channel * kernel_plane);
+      RowMajor2Col4Major(origin_weight, packed_weight, out_channel, in_channel * kernel_plane);
 #else
-  RowMajor2Col8Major(origin_weight_, packed_weight_, out_channel, in_channel * kernel_plane);
+      RowMajor2Col8Major(origin_weight, packed_weight, out_channel, in_channel * kernel_plane);
 #endif
+      return RET_OK;
+    },
+    &shared_weight_));
+  if (packed_weight_ == nullptr) {
+    MS_LOG(ERROR) << "malloc packed weight failed.";
+    return RET_ERROR;
+  }
 
   bias_data_ = reinterpret_cast<float *>(malloc(oc_block_num * sizeof(float)));
   if (bias_data_ == nullptr) {
@@ -19,6 +19,7 @@
 
 #include <vector>
 #include "src/lite_kernel.h"
+#include "src/prepared_weights.h"
 #include "nnacl/op_base.h"
 #include "src/runtime/kernel/arm/base/convolution_base.h"
 #include "nnacl/fp32/conv_fp32.h"
@@ -33,7 +34,7 @@ class ConvolutionCPUKernel : public ConvolutionBaseCPUKernel {
         origin_weight_(origin_weight),
         origin_bias_(origin_bias) {}
   ~ConvolutionCPUKernel() override {
-    if (packed_weight_ != nullptr) {
+    if (packed_weight_ != nullptr && !shared_weight_) {
       free(packed_weight_);
       packed_weight_ = nullptr;
     }
@@ -65,6 +66,7 @@ class ConvolutionCPUKernel : public ConvolutionBaseCPUKernel {
   float *origin_weight_;  // do not free
   float *origin_bias_;    // do not free
   float *packed_weight_ = nullptr;
+  bool shared_weight_ = false;  // packed_weight_ is in the prepared weights of the model, do not free
   float *packed_input_ = nullptr;
   float *col_major_input_ = nullptr;
 };
@@ -15,6 +15,7 @@
  */
 
 #include "src/runtime/kernel/arm/fp32/convolution_winograd_fp32.h"
+#include <string>
 #include "nnacl/fp32/conv_fp32.h"
 #include "nnacl/pack.h"
 #include "schema/model_generated.h"
@@ -31,13 +32,13 @@ using mindspore::schema::PrimitiveType_Conv2D;
 
 namespace mindspore::kernel {
 int ConvolutionWinogradCPUKernel::WinogradFilterTransform(const float *weight_data, float *matrix_g, float *matrix_gt,
-                                                          int oc_block) {
+                                                          int oc_block, float *trans_weight) {
   if (oc_block == 0) {
     MS_LOG(ERROR) << "Divide by zero";
     return RET_ERROR;
   }
 
-  return WinogradWeightTransform(weight_data, trans_weight_, matrix_g, matrix_gt, oc_block, input_unit_, kernel_unit_,
+  return WinogradWeightTransform(weight_data, trans_weight, matrix_g, matrix_gt, oc_block, input_unit_, kernel_unit_,
                                  conv_param_->input_channel_, conv_param_->output_channel_, true);
 }
 
@@ -56,17 +57,6 @@ int ConvolutionWinogradCPUKernel::InitWeightBias() {
 #endif
   int oc_block_num = UP_DIV(out_channel, oc_block);
 
-  // set data
-  auto trans_matrix_data_size = input_unit_ * input_unit_ * in_channel * oc_block_num * oc_block * sizeof(float);
-  if (trans_weight_ == nullptr) {
-    trans_weight_ = reinterpret_cast<float *>(malloc(trans_matrix_data_size));
-    if (trans_weight_ == nullptr) {
-      MS_LOG(ERROR) << "malloc matrix_buffer failed.";
-      return RET_MEMORY_FAILED;
-    }
-  }
-  memset(trans_weight_, 0, trans_matrix_data_size);
-
   float matrix_g[64];
   float matrix_gt[64];
   float matrix_a[64];
@@ -83,10 +73,30 @@ int ConvolutionWinogradCPUKernel::InitWeightBias() {
     MS_LOG(ERROR) << "get matrix g from CookToomFilter failed.";
     return ret;
   }
-  ret = WinogradFilterTransform(origin_weight_, matrix_g, matrix_gt, oc_block);
-  if (ret != RET_OK) {
-    MS_LOG(ERROR) << "winograd filter transfrom failed.";
-    return ret;
+
+  // set data
+  auto trans_matrix_data_size = input_unit_ * input_unit_ * in_channel * oc_block_num * oc_block * sizeof(float);
+  if (trans_weight_ == nullptr) {
+    auto pack_format = "winograd" + std::to_string(input_unit_) + "x" + std::to_string(output_unit_) + "_col" +
+                       std::to_string(oc_block);
+    trans_weight_ = reinterpret_cast<float *>(lite::PreparedWeights::PackWeight(
+      filter_tensor, pack_format, trans_matrix_data_size,
+      [this, &matrix_g, &matrix_gt, oc_block](void *dst) {
+        return WinogradFilterTransform(origin_weight_, matrix_g, matrix_gt, oc_block, reinterpret_cast<float *>(dst));
+      },
+      &shared_weight_));
+    if (trans_weight_ == nullptr) {
+      MS_LOG(ERROR) << "winograd filter transfrom failed.";
+      return RET_MEMORY_FAILED;
+    }
+  } else {
+    // transformed again after training, never shared then
+    memset(trans_weight_, 0, trans_matrix_data_size);
+    ret = WinogradFilterTransform(origin_weight_, matrix_g, matrix_gt, oc_block, trans_weight_);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "winograd filter transfrom failed.";
+      return ret;
+    }
   }
 
   // init bias
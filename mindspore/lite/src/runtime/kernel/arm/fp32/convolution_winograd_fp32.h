@@ -19,6 +19,7 @@
 
 #include <vector>
 #include "src/lite_kernel.h"
+#include "src/prepared_weights.h"
 #include "nnacl/winograd_transform.h"
 #include "nnacl/minimal_filtering_generator.h"
 #include "src/runtime/kernel/arm/base/convolution_base.h"
@@ -35,7 +36,7 @@ class ConvolutionWinogradCPUKernel : public ConvolutionBaseCPUKernel {
         origin_weight_(origin_weight),
         origin_bias_(origin_bias) {}
   ~ConvolutionWinogradCPUKernel() override {
-    if (trans_weight_ != nullptr) {
+    if (trans_weight_ != nullptr && !shared_weight_) {
       free(trans_weight_);
       trans_weight_ = nullptr;
     }
@@ -48,7 +49,8 @@ class ConvolutionWinogradCPUKernel : public ConvolutionBaseCPUKernel {
   int InitWeightBias();
   int InitTmpBuffer();
   int ConfigInputOutput();
-  int WinogradFilterTransform(const float *weight_data, float *matrix_g, float *matrix_gt, int oc_block);
+  int WinogradFilterTransform(const float *weight_data, float *matrix_g, float *matrix_gt, int oc_block,
+                              float *trans_weight);
 
  private:
   void FreeTmpBuffer() {
@@ -79,6 +81,7 @@ class ConvolutionWinogradCPUKernel : public ConvolutionBaseCPUKernel {
   float *gemm_out_ = nullptr;
   float *col_buffer_ = nullptr;
   float *trans_weight_ = nullptr;
+  bool shared_weight_ = false;  // trans_weight_ is in the prepared weights of the model, do not free
   TmpBufferAddress tmp_buffer_address_list_[4];
   InputTransFunc in_func_;
   OutputTransFunc out_func_;
@@ -15,6 +15,7 @@
  */
 
 #include "src/runtime/kernel/arm/fp32/fullconnection_fp32.h"
+#include <string>
 #include "src/kernel_registry.h"
 #include "src/runtime/runtime_api.h"
 
@@ -39,7 +40,9 @@ void FullconnectionCPUKernel::FreeBuf() {
     a_pack_ptr_ = nullptr;
   }
   if (b_pack_ptr_ != nullptr) {
-    free(b_pack_ptr_);
+    if (!shared_b_pack_) {
+      free(b_pack_ptr_);
+    }
     b_pack_ptr_ = nullptr;
   }
   if (bias_ptr_ != nullptr) {
@@ -103,22 +106,36 @@ int FullconnectionCPUKernel::ReSize() {
   }
   memset(a_pack_ptr_, 0, row_tmp * fc_param_->deep_ * sizeof(float));
 
+  fc_param_->a_const_ = (in_tensors_.at(0)->data_c() != nullptr);
+  fc_param_->b_const_ = (in_tensors_.at(1)->data_c() != nullptr);
   int col_tmp = is_vector_input_ ? fc_param_->col_ : fc_param_->col_align_;
-  b_pack_ptr_ = reinterpret_cast<float *>(malloc(col_tmp * fc_param_->deep_ * sizeof(float)));
+  if (fc_param_->b_const_) {
+    auto b_src = reinterpret_cast<float *>(in_tensors_.at(1)->MutableData());
+    auto pack_format = is_vector_input_ ? std::string("fc_vec") : "fc_col" + std::to_string(col_tile);
+    b_pack_ptr_ = reinterpret_cast<float *>(lite::PreparedWeights::PackWeight(
+      in_tensors_.at(1), pack_format, col_tmp * fc_param_->deep_ * sizeof(float),
+      [this, b_src](void *dst) {
+        InitMatrixB(b_src, reinterpret_cast<float *>(dst));
+        return RET_OK;
+      },
+      &shared_b_pack_));
+  } else {
+    shared_b_pack_ = false;
+    b_pack_ptr_ = reinterpret_cast<float *>(malloc(col_tmp * fc_param_->deep_ * sizeof(float)));
+    if (b_pack_ptr_ != nullptr) {
+      memset(b_pack_ptr_, 0, col_tmp * fc_param_->deep_ * sizeof(float));
+    }
+  }
   if (b_pack_ptr_ == nullptr) {
     FreeBuf();
     return RET_MEMORY_FAILED;
   }
-  memset(b_pack_ptr_, 0, col_tmp * fc_param_->deep_ * sizeof(float));
 
-  fc_param_->a_const_ = (in_tensors_.at(0)->data_c() != nullptr);
-  fc_param_->b_const_ = (in_tensors_.at(1)->data_c() != nullptr);
   if (fc_param_->a_const_) {
     InitMatrixA(reinterpret_cast<float *>(in_tensors_.at(0)->MutableData()), a_pack_ptr_);
     a_ptr_ = a_pack_ptr_;
   }
   if (fc_param_->b_const_) {
-    InitMatrixB(reinterpret_cast<float *>(in_tensors_.at(1)->MutableData()), b_pack_ptr_);
     b_ptr_ = b_pack_ptr_;
   }
   return RET_OK;
@@ -22,6 +22,7 @@
 #include "include/errorcode.h"
 #include "nnacl/fp32/matmul_fp32.h"
 #include "src/lite_kernel.h"
+#include "src/prepared_weights.h"
 
 using mindspore::lite::InnerContext;
 namespace mindspore::kernel {
@@ -51,6 +52,7 @@ class FullconnectionCPUKernel : public LiteKernel {
   MatMulParameter *fc_param_ = nullptr;
   float *a_pack_ptr_ = nullptr;
   float *b_pack_ptr_ = nullptr;
+  bool shared_b_pack_ = false;  // b_pack_ptr_ is in the prepared weights of the model, do not free
   float *c_ptr_ = nullptr;
   float *bias_ptr_ = nullptr;
   float *a_ptr_ = nullptr;
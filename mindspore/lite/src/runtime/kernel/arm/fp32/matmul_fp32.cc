@@ -15,6 +15,7 @@
  */
 
 #include "src/runtime/kernel/arm/fp32/matmul_fp32.h"
+#include <string>
 #include "include/errorcode.h"
 #include "nnacl/fp32/matmul_fp32.h"
 #include "src/runtime/runtime_api.h"
@@ -35,7 +36,7 @@ MatmulCPUKernel::~MatmulCPUKernel() {
     free(a_pack_ptr_);
     a_pack_ptr_ = nullptr;
   }
-  if (b_pack_ptr_ != nullptr) {
+  if (b_pack_ptr_ != nullptr && !shared_b_pack_) {
     free(b_pack_ptr_);
     b_pack_ptr_ = nullptr;
   }
@@ -51,7 +52,9 @@ void MatmulCPUKernel::FreeTmpBuffer() {
     a_pack_ptr_ = nullptr;
   }
   if (b_pack_ptr_ != nullptr) {
-    params_->b_const_ ? free(b_pack_ptr_) : context_->allocator->Free(b_pack_ptr_);
+    if (!shared_b_pack_) {
+      params_->b_const_ ? free(b_pack_ptr_) : context_->allocator->Free(b_pack_ptr_);
+    }
     b_pack_ptr_ = nullptr;
   }
 }
@@ -96,11 +99,8 @@ int MatmulCPUKernel::MallocMatrixABuffer() {
   return RET_OK;
 }
 
-int MatmulCPUKernel::MallocMatrixBBuffer() {
+void MatmulCPUKernel::InitMatrixBParam() {
   auto b_shape = in_tensors_.at(1)->shape();
-  if (b_shape.empty()) {
-    return RET_OK;
-  }
   int batch = 1;
   MS_ASSERT(b_shape.size() >= 2);
   for (size_t i = 0; i < b_shape.size() - 2; ++i) {
@@ -110,6 +110,16 @@ int MatmulCPUKernel::MallocMatrixBBuffer() {
   params_->col_ = params_->b_transpose_ ? b_shape[b_shape.size() - 2] : b_shape[b_shape.size() - 1];
   params_->col_align_ = UP_ROUND(params_->col_, col_tile_);
   params_->deep_ = params_->b_transpose_ ? b_shape[b_shape.size() - 1] : b_shape[b_shape.size() - 2];
+  thread_count_ = MSMIN(op_parameter_->thread_num_, UP_DIV(params_->col_align_, col_tile_));
+  thread_stride_ = UP_DIV(UP_DIV(params_->col_align_, col_tile_), thread_count_);
+}
+
+int MatmulCPUKernel::MallocMatrixBBuffer() {
+  auto b_shape = in_tensors_.at(1)->shape();
+  if (b_shape.empty()) {
+    return RET_OK;
+  }
+  InitMatrixBParam();
 
   int col_tmp = is_vector_a_ ? params_->col_ : params_->col_align_;
   if (params_->b_const_) {
@@ -122,9 +132,28 @@ int MatmulCPUKernel::MallocMatrixBBuffer() {
     FreeTmpBuffer();
     return RET_MEMORY_FAILED;
   }
+  shared_b_pack_ = false;
+  return RET_OK;
+}
 
-  thread_count_ = MSMIN(op_parameter_->thread_num_, UP_DIV(params_->col_align_, col_tile_));
-  thread_stride_ = UP_DIV(UP_DIV(params_->col_align_, col_tile_), thread_count_);
+int MatmulCPUKernel::PackConstMatrixB() {
+  auto b_tensor = in_tensors_.at(1);
+  InitMatrixBParam();
+  auto b_src = reinterpret_cast<float *>(b_tensor->data_c());
+  int col_tmp = is_vector_a_ ? params_->col_ : params_->col_align_;
+  auto pack_format = std::string(params_->b_transpose_ ? "matmul_bt" : "matmul_b") +
+                     (is_vector_a_ ? "_vec" : "_col" + std::to_string(col_tile_));
+  b_pack_ptr_ = reinterpret_cast<float *>(lite::PreparedWeights::PackWeight(
+    b_tensor, pack_format, params_->batch * col_tmp * params_->deep_ * sizeof(float),
+    [this, b_src](void *dst) {
+      InitMatrixB(b_src, reinterpret_cast<float *>(dst));
+      return RET_OK;
+    },
+    &shared_b_pack_));
+  if (b_pack_ptr_ == nullptr) {
+    FreeTmpBuffer();
+    return RET_MEMORY_FAILED;
+  }
   return RET_OK;
 }
 
@@ -255,12 +284,11 @@ int MatmulCPUKernel::Init() {
     a_ptr_ = a_pack_ptr_;
   }
   if (params_->b_const_) {
-    auto ret = MallocMatrixBBuffer();
+    auto ret = PackConstMatrixB();
     if (ret != RET_OK) {
-      MS_LOG(ERROR) << "Matmul fp32 malloc matrix B buffer failed";
+      MS_LOG(ERROR) << "Matmul fp32 pack matrix B failed";
       return RET_ERROR;
     }
-    InitMatrixB(reinterpret_cast<float *>(in_tensors_.at(1)->data_c()), b_pack_ptr_);
     b_ptr_ = b_pack_ptr_;
     // init bias
     ret = InitBias();
@@ -20,6 +20,7 @@
 #include <vector>
 #include "nnacl/matmul_parameter.h"
 #include "src/lite_kernel.h"
+#include "src/prepared_weights.h"
 
 namespace mindspore::kernel {
 class MatmulCPUKernel : public LiteKernel {
@@ -40,6 +41,8 @@ class MatmulCPUKernel : public LiteKernel {
  private:
   int MallocMatrixABuffer();
   int MallocMatrixBBuffer();
+  void InitMatrixBParam();
+  int PackConstMatrixB();
   int InitBias();
   void InitMatrixA(const float *src_ptr, float *dst_ptr);
   void InitMatrixB(const float *src_ptr, float *dst_ptr);
@@ -49,6 +52,7 @@ class MatmulCPUKernel : public LiteKernel {
   MatMulParameter *params_ = nullptr;
   float *a_pack_ptr_ = nullptr;
   float *b_pack_ptr_ = nullptr;
+  bool shared_b_pack_ = false;  // b_pack_ptr_ is in the prepared weights of the model, do not free
   float *bias_ptr_ = nullptr;
   float *a_ptr_ = nullptr;
   float *b_ptr_ = nullptr;
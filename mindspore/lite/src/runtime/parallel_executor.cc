@@ -14,99 +14,222 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <unordered_map>
 #include <utility>
 #include "src/runtime/parallel_executor.h"
 #include "src/runtime/runtime_api.h"
 
 #define MAX_THREAD_NUM 8
 namespace mindspore::lite {
-ParallelExecutor::~ParallelExecutor() { DestroyThreadPool(thread_pool_); }
-int ParallelExecutor::Prepare(const std::vector<mindspore::kernel::LiteKernel *> &kernels) {
-  thread_pool_ = CreateLiteThreadPool(MAX_THREAD_NUM, NO_BIND);
-  if (thread_pool_ == nullptr) {
-    MS_LOG(ERROR) << "Memory error: fail to new ThreadPool";
+namespace {
+size_t ElementsNum(const std::vector<Tensor *> &tensors) {
+  size_t elements_num = 0;
+  for (auto tensor : tensors) {
+    MS_ASSERT(tensor != nullptr);
+    elements_num += static_cast<size_t>(std::max(tensor->ElementsNum(), 0));
+  }
+  return elements_num;
+}
+
+// the multiply-accumulate count of the kernels bound by compute, the element count of the tensors of the others
+size_t EstimateCost(const kernel::LiteKernel *kernel) {
+  auto out_elements_num = ElementsNum(kernel->out_tensors());
+  switch (kernel->Type()) {
+    case schema::PrimitiveType_Conv2D:
+    case schema::PrimitiveType_DepthwiseConv2D:
+    case schema::PrimitiveType_DeConv2D:
+    case schema::PrimitiveType_DeDepthwiseConv2D:
+    case schema::PrimitiveType_MatMul:
+    case schema::PrimitiveType_FullConnection: {
+      // each output element accumulates the weights of its output channel
+      auto &out_tensors = kernel->out_tensors();
+      if (kernel->in_tensors().size() < 2 || out_tensors.empty() || out_tensors.front()->shape().empty()) {
+        break;
+      }
+      auto out_channel = out_tensors.front()->shape().back();
+      auto weight_elements_num = kernel->in_tensors()[1]->ElementsNum();
+      if (out_channel > 0 && weight_elements_num > out_channel) {
+        return out_elements_num * static_cast<size_t>(weight_elements_num / out_channel);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  return ElementsNum(kernel->in_tensors()) + out_elements_num;
+}
+
+int RunBinTask(void *cdata, int task_id) {
+  auto executor = reinterpret_cast<ParallelExecutor *>(cdata);
+  return executor->RunBin(task_id);
+}
+}  // namespace
+
+int SplitWaves(const std::vector<kernel::LiteKernel *> &kernels,
+               std::vector<std::vector<kernel::LiteKernel *>> *waves) {
+  MS_ASSERT(waves != nullptr);
+  waves->clear();
+  std::unordered_map<kernel::LiteKernel *, size_t> ref_count;
+  for (auto kernel : kernels) {
+    ref_count[kernel] = 0;
+  }
+  for (auto kernel : kernels) {
+    for (auto out_kernel : kernel->out_kernels()) {
+      auto iter = ref_count.find(out_kernel);
+      if (iter != ref_count.end()) {
+        iter->second++;
+      }
+    }
+  }
+  std::vector<kernel::LiteKernel *> ready_kernels;
+  for (auto kernel : kernels) {
+    if (ref_count[kernel] == 0) {
+      ready_kernels.emplace_back(kernel);
+    }
+  }
+  size_t split_num = 0;
+  while (!ready_kernels.empty()) {
+    split_num += ready_kernels.size();
+    waves->emplace_back(std::move(ready_kernels));
+    ready_kernels.clear();
+    for (auto completed : waves->back()) {
+      for (auto out_kernel : completed->out_kernels()) {
+        auto iter = ref_count.find(out_kernel);
+        if (iter != ref_count.end() && --(iter->second) == 0) {
+          ready_kernels.emplace_back(out_kernel);
+        }
+      }
+    }
+  }
+  if (split_num != kernels.size()) {
+    MS_LOG(ERROR) << "The kernels have a cycle, only " << split_num << " of " << kernels.size() << " can run";
     return RET_ERROR;
   }
   return RET_OK;
 }
 
-static int RunKernel(void *data, int index) {
-  auto *executor = reinterpret_cast<ParallelExecutor *>(data);
-  auto kernel = executor->GetReadyKernel(index);
-  auto ret = kernel->Run();
-  executor->SetResult(index, ret);
-  if (0 != ret) {
-    MS_LOG(ERROR) << "run kernel failed, name: " << kernel->name();
-    return 0;
+ParallelExecutor::~ParallelExecutor() {
+  if (this->own_thread_pool_) {
+    DestroyThreadPool(this->thread_pool_);
+    free(this->thread_pool_);
+    this->thread_pool_ = nullptr;
   }
+}
 
-  ret = kernel->FreeInWorkTensor();
-  if (RET_OK != ret) {
-    MS_LOG(ERROR) << "FreeInWorkTensor failed, name: " << kernel->name();
-    return ret;
+int ParallelExecutor::Prepare(const std::vector<mindspore::kernel::LiteKernel *> &kernels) {
+  if (this->thread_pool_ == nullptr) {
+    this->thread_pool_ = CreateLiteThreadPool(MAX_THREAD_NUM, NO_BIND, DEFAULT_POOL);
+    if (this->thread_pool_ == nullptr) {
+      MS_LOG(ERROR) << "Memory error: fail to new ThreadPool";
+      return RET_ERROR;
+    }
+    this->own_thread_pool_ = true;
   }
-  return 0;
+  return SplitWaves(kernels, &this->waves_);
+}
+
+int ParallelExecutor::RunBin(int bin_id) {
+  for (auto kernel : this->bins_.at(bin_id)) {
+    auto ret = kernel->Run(nullptr, nullptr);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "run kernel failed, name: " << kernel->name();
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
+int ParallelExecutor::RunWave(const std::vector<kernel::LiteKernel *> &wave) {
+  auto thread_num = static_cast<size_t>(GetCurrentThreadNum(this->thread_pool_));
+  std::vector<std::pair<size_t, kernel::LiteKernel *>> costs;
+  size_t total_cost = 0;
+  for (auto kernel : wave) {
+    auto cost = EstimateCost(kernel);
+    costs.emplace_back(cost, kernel);
+    total_cost += cost;
+  }
+  std::stable_sort(costs.begin(), costs.end(),
+                   [](const std::pair<size_t, kernel::LiteKernel *> &a,
+                      const std::pair<size_t, kernel::LiteKernel *> &b) { return a.first > b.first; });
+  // a kernel above the fair share of a thread keeps all the threads for its intra-op tasks
+  size_t heavy_num = 0;
+  for (; heavy_num < costs.size() && costs[heavy_num].first * thread_num > total_cost; ++heavy_num) {
+    auto kernel = costs[heavy_num].second;
+    auto ret = kernel->Run(nullptr, nullptr);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "run kernel failed, name: " << kernel->name();
+      return ret;
+    }
+  }
+  // longest processing time first: each of the other kernels goes into the least loaded bin
+  auto bin_num = std::min(costs.size() - heavy_num, thread_num);
+  if (bin_num == 0) {
+    return RET_OK;
+  }
+  this->bins_.assign(bin_num, {});
+  std::vector<size_t> bin_costs(bin_num, 0);
+  for (auto i = heavy_num; i < costs.size(); ++i) {
+    auto bin_id = std::min_element(bin_costs.begin(), bin_costs.end()) - bin_costs.begin();
+    this->bins_[bin_id].emplace_back(costs[i].second);
+    bin_costs[bin_id] += costs[i].first;
+  }
+  return ParallelLaunch(this->thread_pool_, RunBinTask, this, static_cast<int>(bin_num));
 }
 
 int ParallelExecutor::Run(std::vector<Tensor *> &in_tensors, std::vector<Tensor *> &out_tensors,
                           std::vector<kernel::LiteKernel *> &kernels, Allocator *allocator,
                           const KernelCallBack &before, const KernelCallBack &after) {
   MS_ASSERT(nullptr != allocator);
-  for (auto &inTensor : in_tensors) {
-    if (inTensor == nullptr) {
-      MS_LOG(ERROR) << "Graph input tensor is nullptr";
-      return RET_ERROR;
-    }
-    if (inTensor->format() != schema::Format::Format_NHWC) {
-      MS_LOG(ERROR) << "Model input tensor should be NHWC";
-      return RET_ERROR;
-    }
+  auto ret = this->CheckInputs(in_tensors);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "CheckInputs failed";
+    return ret;
   }
-  kernel::LiteKernelUtil::InitTensorInitRefCount(kernels);
-
-  for (auto kernel : kernels) {
-    if (kernel->in_kernels().empty()) {
-      readyKernels.emplace_back(kernel);
-      continue;
-    }
-    refCount[kernel] = kernel->in_kernels().size();
+#ifdef SUPPORT_TRAIN
+  for (auto out_tensor : out_tensors) {  // increase RefCount of output tensors, such that Run will not free them
+    out_tensor->set_ref_count(out_tensor->ref_count() + 1);
   }
-  std::vector<kernel::LiteKernel *> newReadyKernels;
-  while (!readyKernels.empty()) {
-    results.resize(readyKernels.size(), RET_OK);
-    if (0 != ParallelLaunch(thread_pool_, RunKernel, this, readyKernels.size())) {
-      MS_LOG(ERROR) << "ParallelLaunch failed ";
-      return RET_ERROR;
+#endif
+  if (this->waves_.empty() && !kernels.empty()) {
+    ret = SplitWaves(kernels, &this->waves_);
+    if (ret != RET_OK) {
+      return ret;
     }
-
-    if (std::find_if(results.begin(), results.end(), [](const int &ret) { return (ret != 0); }) != results.end()) {
-      return RET_ERROR;
+  }
+  // the outputs are allocated and the references are counted on this thread, only running the kernels is parallel
+  for (auto &wave : this->waves_) {
+    for (auto kernel : wave) {
+      ret = kernel->PreProcess();
+      if (ret != RET_OK) {
+        MS_LOG(ERROR) << "PreProcess kernel failed, name: " << kernel->name();
+        return ret;
+      }
     }
-    newReadyKernels.clear();
-    for (auto completed : readyKernels) {
-      for (auto out : completed->out_kernels()) {
-        auto iter = refCount.find(out);
-        if (iter == refCount.end()) {
-          continue;
-        }
-        (iter->second)--;
-        if (iter->second <= 0) {
-          newReadyKernels.emplace_back(iter->first);
-          refCount.erase(iter);
+    if (wave.size() == 1 || before != nullptr || after != nullptr) {
+      // the callbacks, e.g. the profiling ones, are not thread safe
+      for (auto kernel : wave) {
+        ret = kernel->Run(before, after);
+        if (ret != RET_OK) {
+          MS_LOG(ERROR) << "run kernel failed, name: " << kernel->name();
+          return ret;
         }
       }
-
-      auto ret = completed->FreeInWorkTensor();
-      if (RET_OK != ret) {
-        MS_LOG(ERROR) << "FreeInWorkTensor failed, name: " << completed->name();
+    } else {
+      ret = RunWave(wave);
+      if (ret != RET_OK) {
+        MS_LOG(ERROR) << "Run wave of " << wave.size() << " kernels failed: " << ret;
+        return ret;
+      }
+    }
+    for (auto kernel : wave) {
+      ret = kernel->PostProcess();
+      if (ret != RET_OK) {
+        MS_LOG(ERROR) << "PostProcess kernel failed, name: " << kernel->name();
         return ret;
       }
     }
-    readyKernels.clear();
-    readyKernels = std::move(newReadyKernels);
   }
-
   return RET_OK;
 }
-
 }  // namespace mindspore::lite
@@ -18,16 +18,26 @@
 #define MINDSPORE_LITE_SRC_RUNTIME_PARALLEL_EXECUTOR_H_
 
 #include <vector>
-#include <unordered_map>
 #include "src/runtime/allocator.h"
 #include "src/lite_kernel.h"
 #include "include/lite_session.h"
 #include "src/executor.h"
 
 namespace mindspore::lite {
+// Splits the kernels into waves: a kernel is in the wave after the last wave of the kernels it depends on, so the
+// kernels of one wave are independent of each other and each wave only reads tensors written by the earlier ones.
+int SplitWaves(const std::vector<kernel::LiteKernel *> &kernels, std::vector<std::vector<kernel::LiteKernel *>> *waves);
+
+// Runs the independent branches of a graph in parallel, wave by wave. In each wave the kernels whose estimated cost
+// is above the fair share of a thread run one by one on the whole thread pool, the cheaper ones are packed into one
+// bin per thread and the bins run concurrently, each kernel on a single thread since nested ParallelLaunch calls run
+// inline. Allocating the outputs and counting the references of the tensors stay on the calling thread.
 class ParallelExecutor : public Executor {
  public:
+  // runs the waves on its own thread pool
   ParallelExecutor() = default;
+  // runs the waves on the thread pool of the context, which the kernels launch their intra-op tasks on
+  explicit ParallelExecutor(struct ThreadPool *thread_pool) : thread_pool_(thread_pool) {}
   ~ParallelExecutor() override;
 
   int Prepare(const std::vector<kernel::LiteKernel *> &kernels) override;
@@ -35,14 +45,15 @@ class ParallelExecutor : public Executor {
   int Run(std::vector<Tensor *> &in_tensors, std::vector<Tensor *> &out_tensors,
           std::vector<kernel::LiteKernel *> &kernels, Allocator *allocator = nullptr,
           const KernelCallBack &before = nullptr, const KernelCallBack &after = nullptr) override;
-  inline kernel::LiteKernel *GetReadyKernel(const int index) const { return readyKernels.at(index); }
-  inline void SetResult(const int index, const int result) { results.at(index) = result; }
+  int RunBin(int bin_id);
 
  private:
-  std::unordered_map<kernel::LiteKernel *, size_t> refCount;
-  std::vector<kernel::LiteKernel *> readyKernels;
-  std::vector<int> results;
+  int RunWave(const std::vector<kernel::LiteKernel *> &wave);
+
+  std::vector<std::vector<kernel::LiteKernel *>> waves_;
+  std::vector<std::vector<kernel::LiteKernel *>> bins_;
   struct ThreadPool *thread_pool_ = nullptr;
+  bool own_thread_pool_ = false;
 };
 
 }  // namespace mindspore::lite
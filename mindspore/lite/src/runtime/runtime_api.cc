@@ -23,7 +23,9 @@ static std::mutex gWorkspaceMutex;
 extern "C" {
 #endif
 
-ThreadPool *CreateLiteThreadPool(int thread_num, int mode) { return CreateThreadPool(thread_num, mode); }
+ThreadPool *CreateLiteThreadPool(int thread_num, int mode, int type) {
+  return CreateThreadPool(thread_num, mode, type);
+}
 
 void LiteAPISetLastError(const char *msg) { MS_LOG(ERROR) << "The lite api set last error is " << msg; }
 #ifdef __cplusplus
@@ -34,7 +34,7 @@ extern "C" {
 #include "src/runtime/thread_pool.h"
 struct ThreadPool;
 #endif
-INTERNAL_API_DLL ThreadPool *CreateLiteThreadPool(int thread_num, int mode);
+INTERNAL_API_DLL ThreadPool *CreateLiteThreadPool(int thread_num, int mode, int type);
 INTERNAL_API_DLL void LiteAPISetLastError(const char *msg);
 INTERNAL_API_DLL int LiteBackendRegisterSystemLibSymbol(const char *name, void *ptr);
 #ifdef __cplusplus
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/static_allocator.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include "src/common/log_adapter.h"
+#include "include/errorcode.h"
+
+namespace mindspore::lite {
+namespace {
+// every tensor starts on its own cache line
+constexpr size_t kArenaAlignment = 64;
+
+size_t AlignSize(size_t size) { return (size + kArenaAlignment - 1) / kArenaAlignment * kArenaAlignment; }
+}  // namespace
+
+StaticAllocator::StaticAllocator(Allocator *fallback) : fallback_(fallback) { this->name = "static"; }
+
+StaticAllocator::~StaticAllocator() {
+  // the tensors are released before the kernels, only the arena is left
+  free(this->arena_buf_);
+  this->arena_buf_ = nullptr;
+  this->arena_ = nullptr;
+}
+
+void *StaticAllocator::Malloc(size_t size) {
+  if (this->fallback_ != nullptr) {
+    return this->fallback_->Malloc(size);
+  }
+  return malloc(size);
+}
+
+void StaticAllocator::Free(void *ptr) {
+  if (ptr == nullptr || InArena(ptr)) {
+    return;
+  }
+  if (this->fallback_ != nullptr) {
+    this->fallback_->Free(ptr);
+  } else {
+    free(ptr);
+  }
+}
+
+bool StaticAllocator::InArena(const void *ptr) const {
+  auto addr = static_cast<const char *>(ptr);
+  return this->arena_ != nullptr && addr >= this->arena_ && addr < this->arena_ + this->arena_size_;
+}
+
+int StaticAllocator::Plan(const std::vector<TensorLifetime> &lifetimes) {
+  Reset();
+  // greedy by size: the biggest tensors are placed first, each one in the smallest gap left between the tensors
+  // alive at the same time which fits it, or after all of them
+  std::vector<size_t> order(lifetimes.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::vector<size_t> sizes(lifetimes.size());
+  for (size_t i = 0; i < lifetimes.size(); ++i) {
+    MS_ASSERT(lifetimes[i].tensor != nullptr);
+    sizes[i] = lifetimes[i].tensor->Size();
+  }
+  std::stable_sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+  std::vector<size_t> offsets(lifetimes.size(), 0);
+  std::vector<size_t> placed;
+  for (auto i : order) {
+    auto &lifetime = lifetimes[i];
+    size_t size = AlignSize(sizes[i]);
+    std::vector<size_t> alive;
+    for (auto j : placed) {
+      if (lifetimes[j].first <= lifetime.last && lifetime.first <= lifetimes[j].last) {
+        alive.push_back(j);
+      }
+    }
+    std::sort(alive.begin(), alive.end(), [&offsets](size_t a, size_t b) { return offsets[a] < offsets[b]; });
+    size_t best_offset = std::numeric_limits<size_t>::max();
+    size_t best_gap = std::numeric_limits<size_t>::max();
+    size_t gap_start = 0;
+    for (auto j : alive) {
+      if (offsets[j] >= gap_start + size && offsets[j] - gap_start < best_gap) {
+        best_gap = offsets[j] - gap_start;
+        best_offset = gap_start;
+      }
+      gap_start = std::max(gap_start, offsets[j] + AlignSize(sizes[j]));
+    }
+    offsets[i] = best_offset == std::numeric_limits<size_t>::max() ? gap_start : best_offset;
+    this->arena_size_ = std::max(this->arena_size_, offsets[i] + size);
+    placed.push_back(i);
+  }
+  if (this->arena_size_ == 0) {
+    return RET_OK;
+  }
+  this->arena_buf_ = malloc(this->arena_size_ + kArenaAlignment);
+  if (this->arena_buf_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc arena failed, size=" << this->arena_size_;
+    this->arena_size_ = 0;
+    return RET_MEMORY_FAILED;
+  }
+  auto addr = reinterpret_cast<uintptr_t>(this->arena_buf_);
+  this->arena_ = static_cast<char *>(this->arena_buf_) + (AlignSize(addr) - addr);
+  for (size_t i = 0; i < lifetimes.size(); ++i) {
+    auto tensor = lifetimes[i].tensor;
+    tensor->FreeData();
+    tensor->set_allocator(this);
+    this->planned_tensors_.push_back({tensor, sizes[i], offsets[i]});
+  }
+  MS_LOG(DEBUG) << "Plan " << lifetimes.size() << " tensors into an arena of " << this->arena_size_ << " bytes";
+  return RET_OK;
+}
+
+void StaticAllocator::Reset() {
+  for (auto &planned : this->planned_tensors_) {
+    auto tensor = planned.tensor;
+    if (InArena(tensor->data_c())) {
+      tensor->set_data(nullptr);
+    } else {
+      tensor->FreeData();
+    }
+    tensor->set_allocator(this->fallback_);
+  }
+  this->planned_tensors_.clear();
+  free(this->arena_buf_);
+  this->arena_buf_ = nullptr;
+  this->arena_ = nullptr;
+  this->arena_size_ = 0;
+}
+
+bool StaticAllocator::IsValid() const {
+  return std::all_of(this->planned_tensors_.begin(), this->planned_tensors_.end(),
+                     [](const PlannedTensor &planned) { return planned.tensor->Size() == planned.size; });
+}
+
+void StaticAllocator::Bind() {
+  for (auto &planned : this->planned_tensors_) {
+    auto tensor = planned.tensor;
+    auto data = tensor->data_c();
+    if (data != nullptr && !InArena(data)) {
+      tensor->FreeData();
+    }
+    tensor->set_data(this->arena_ + planned.offset);
+  }
+}
+}  // namespace mindspore::lite
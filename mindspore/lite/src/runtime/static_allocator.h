@@ -0,0 +1,70 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_STATIC_ALLOCATOR_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_STATIC_ALLOCATOR_H_
+
+#include <vector>
+#include "src/runtime/allocator.h"
+#include "src/tensor.h"
+
+namespace mindspore::lite {
+// the lifetime of a tensor: it is written by the kernel first and read by the kernel last, in execution order
+struct TensorLifetime {
+  Tensor *tensor;
+  size_t first;
+  size_t last;
+};
+
+// Places tensors at offsets of one arena planned from their lifetimes, so tensors which are never alive at the same
+// time share memory, and running the kernels does not go through the allocator. Memory which is not planned, e.g. an
+// output reallocated by a kernel whose output shape depends on the input data, comes from the fallback allocator.
+class StaticAllocator : public Allocator {
+ public:
+  explicit StaticAllocator(Allocator *fallback);
+  ~StaticAllocator() override;
+  void *Malloc(size_t size) override;
+  // memory inside the arena is kept for the planned tensors, only memory from the fallback allocator is freed
+  void Free(void *ptr) override;
+  size_t total_size() override { return this->arena_size_; }
+
+  // plan an offset for each tensor, the tensors whose lifetimes overlap get disjoint ranges of the arena
+  int Plan(const std::vector<TensorLifetime> &lifetimes);
+  // drop the plan and hand the tensors back to the fallback allocator
+  void Reset();
+  // whether every planned tensor still has the size it is planned with
+  bool IsValid() const;
+  // point the data of the planned tensors to their ranges of the arena, called before each run
+  void Bind();
+  size_t arena_size() const { return this->arena_size_; }
+
+ private:
+  bool InArena(const void *ptr) const;
+
+  struct PlannedTensor {
+    Tensor *tensor;
+    size_t size;
+    size_t offset;
+  };
+  Allocator *fallback_ = nullptr;
+  std::vector<PlannedTensor> planned_tensors_;
+  void *arena_buf_ = nullptr;
+  char *arena_ = nullptr;
+  size_t arena_size_ = 0;
+};
+}  // namespace mindspore::lite
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_STATIC_ALLOCATOR_H_
@@ -21,6 +21,22 @@
 #include <semaphore.h>
 #include <string.h>
 #include <stdlib.h>
+#include <limits.h>
+
+#if defined(__linux__) || defined(__ANDROID__)
+#define USE_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define CPU_RELAX() __asm__ __volatile__("yield")
+#else
+#define CPU_RELAX()
+#endif
 
 #ifdef __ANDROID__
 #define BIND_CORE
@@ -45,6 +61,14 @@
 
 #define MAX_THREAD_NUM (8)
 #define DEFAULT_SPIN_COUNT (30000)
+// bounds of the adaptive spin of the work stealing pool, in CPU_RELAX rounds
+#define MIN_STEALING_SPIN_COUNT (1000)
+#define MAX_STEALING_SPIN_COUNT (100000)
+// a range of task ids is packed in 64 bits: the job tag in the high 24 bits, then the begin and the end in 20 bits each
+#define RANGE_BITS (20)
+#define RANGE_MASK ((1ULL << RANGE_BITS) - 1)
+#define RANGE_TAG_MASK ((1U << 24) - 1)
+#define MAX_STEALING_TASK_NUM ((int)RANGE_MASK)
 
 typedef struct {
   int (*func)(void *arg, int);
@@ -66,6 +90,7 @@ typedef struct Thread {
   atomic_bool is_running;
   sem_t sem;
   sem_t sem_inited;
+  int spin_count;
 } Thread;
 
 typedef struct {
@@ -79,9 +104,27 @@ typedef struct ThreadPool {
   ThreadList *thread_list;
   int thread_num;
   BindMode mode;
+  PoolType type;
   atomic_bool is_alive;
+  // the state of the work stealing pool: each thread owns a range of the task ids of the current job, the master
+  // thread owns the last one. Bumping the epoch publishes a job, the workers park on it when they are idle.
+  _Atomic(Task *) job;
+  atomic_ullong *task_ranges;
+  atomic_uint epoch;
+  atomic_uint remain_task_num;
+  atomic_int parked_num;
+  atomic_bool master_parked;
+  int master_spin_count;
+#ifndef USE_FUTEX
+  pthread_mutex_t park_lock;
+  pthread_cond_t park_cond;
+#endif
 } ThreadPool;
 
+// the workers and the master thread in ParallelLaunch run tasks of a pool, a ParallelLaunch called from a task, e.g.
+// by a kernel run on a branch of a graph in parallel, runs its tasks inline instead of waiting for the busy threads
+static _Thread_local bool in_pool_task = false;
+
 Thread *GetThread(struct ThreadPool *thread_pool, int thread_id) {
   if (thread_pool == NULL) {
     LOG_ERROR("get thread pool instane failed, thread_id: %d", thread_id);
@@ -703,13 +746,156 @@ int DistributeTask(struct ThreadPool *thread_pool, Task *task, int task_num) {
   return RET_TP_OK;
 }
 
+// wait until *addr is not value any more, may return spuriously
+void Park(struct ThreadPool *thread_pool, atomic_uint *addr, unsigned int value) {
+#ifdef USE_FUTEX
+  syscall(SYS_futex, (void *)addr, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+#else
+  pthread_mutex_lock(&thread_pool->park_lock);
+  while (atomic_load(addr) == value) {
+    pthread_cond_wait(&thread_pool->park_cond, &thread_pool->park_lock);
+  }
+  pthread_mutex_unlock(&thread_pool->park_lock);
+#endif
+}
+
+// wake up the threads parked on addr, called after *addr is changed
+void UnparkAll(struct ThreadPool *thread_pool, atomic_uint *addr) {
+#ifdef USE_FUTEX
+  syscall(SYS_futex, (void *)addr, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+#else
+  pthread_mutex_lock(&thread_pool->park_lock);
+  pthread_cond_broadcast(&thread_pool->park_cond);
+  pthread_mutex_unlock(&thread_pool->park_lock);
+#endif
+}
+
+static inline unsigned long long PackRange(unsigned int tag, unsigned int begin, unsigned int end) {
+  return ((unsigned long long)tag << (2 * RANGE_BITS)) | ((unsigned long long)begin << RANGE_BITS) | end;
+}
+
+static inline unsigned int RangeTag(unsigned long long range) { return (unsigned int)(range >> (2 * RANGE_BITS)); }
+
+static inline unsigned int RangeBegin(unsigned long long range) {
+  return (unsigned int)((range >> RANGE_BITS) & RANGE_MASK);
+}
+
+static inline unsigned int RangeEnd(unsigned long long range) { return (unsigned int)(range & RANGE_MASK); }
+
+// take the first task id of the own range of a thread, the ranges tagged by an older job are empty for this one
+int PopTaskId(struct ThreadPool *thread_pool, unsigned int tag, int slot) {
+  atomic_ullong *range = &thread_pool->task_ranges[slot];
+  unsigned long long old = atomic_load(range);
+  while (RangeTag(old) == tag && RangeBegin(old) < RangeEnd(old)) {
+    unsigned int begin = RangeBegin(old);
+    if (atomic_compare_exchange_weak(range, &old, PackRange(tag, begin + 1, RangeEnd(old)))) {
+      return (int)begin;
+    }
+  }
+  return -1;
+}
+
+// take the back half of the range of another thread, run its first task id and keep the rest as the own range, so
+// the tasks of a late thread spread over the threads which are done
+int StealTaskId(struct ThreadPool *thread_pool, unsigned int tag, int slot) {
+  int slot_num = thread_pool->thread_num;
+  for (int i = 1; i < slot_num; ++i) {
+    atomic_ullong *range = &thread_pool->task_ranges[(slot + i) % slot_num];
+    unsigned long long old = atomic_load(range);
+    while (RangeTag(old) == tag && RangeBegin(old) < RangeEnd(old)) {
+      unsigned int begin = RangeBegin(old);
+      unsigned int end = RangeEnd(old);
+      unsigned int steal_num = (end - begin + 1) / 2;
+      if (atomic_compare_exchange_weak(range, &old, PackRange(tag, begin, end - steal_num))) {
+        // the own range is empty, no other thread takes from it until it is stored
+        atomic_store(&thread_pool->task_ranges[slot], PackRange(tag, end - steal_num + 1, end));
+        return (int)(end - steal_num);
+      }
+    }
+  }
+  return -1;
+}
+
+void RunStealingTasks(struct ThreadPool *thread_pool, Task *task, unsigned int tag, int slot) {
+  int task_id = PopTaskId(thread_pool, tag, slot);
+  while (task_id >= 0 || (task_id = StealTaskId(thread_pool, tag, slot)) >= 0) {
+    task->return_code[task_id] = task->func(task->content, task_id);
+    if (atomic_fetch_sub(&thread_pool->remain_task_num, 1) == 1 && atomic_load(&thread_pool->master_parked)) {
+      UnparkAll(thread_pool, &thread_pool->remain_task_num);
+    }
+    task_id = PopTaskId(thread_pool, tag, slot);
+  }
+}
+
+// spin until the job is done, then park until the last task wakes the master up
+void WaitStealingTasks(struct ThreadPool *thread_pool) {
+  int spin_count = 0;
+  unsigned int remain = atomic_load(&thread_pool->remain_task_num);
+  while (remain != 0 && spin_count < thread_pool->master_spin_count) {
+    CPU_RELAX();
+    spin_count++;
+    remain = atomic_load(&thread_pool->remain_task_num);
+  }
+  if (remain == 0) {
+    int spin_limit = thread_pool->master_spin_count * 2;
+    thread_pool->master_spin_count = spin_limit < MAX_STEALING_SPIN_COUNT ? spin_limit : MAX_STEALING_SPIN_COUNT;
+    return;
+  }
+  atomic_store(&thread_pool->master_parked, true);
+  while ((remain = atomic_load(&thread_pool->remain_task_num)) != 0) {
+    Park(thread_pool, &thread_pool->remain_task_num, remain);
+  }
+  atomic_store(&thread_pool->master_parked, false);
+  int spin_limit = thread_pool->master_spin_count / 2;
+  thread_pool->master_spin_count = spin_limit > MIN_STEALING_SPIN_COUNT ? spin_limit : MIN_STEALING_SPIN_COUNT;
+}
+
+int DistributeStealingTask(struct ThreadPool *thread_pool, Task *task, int task_num) {
+  if (thread_pool == NULL) {
+    LOG_ERROR("get thread pool instane failed");
+    return RET_TP_ERROR;
+  }
+  if (task_num > MAX_STEALING_TASK_NUM || task_num <= 1) {
+    LOG_ERROR("invalid task num: %d", task_num);
+    return RET_TP_ERROR;
+  }
+  if (task->func == NULL) {
+    LOG_ERROR("task->func is nullptr");
+    return RET_TP_ERROR;
+  }
+  // the ranges are stored before the epoch, a worker which sees the new epoch sees the new ranges
+  int slot_num = thread_pool->thread_num;
+  unsigned int epoch = atomic_load(&thread_pool->epoch) + 1;
+  unsigned int tag = epoch & RANGE_TAG_MASK;
+  atomic_store(&thread_pool->remain_task_num, (unsigned int)task_num);
+  for (int i = 0; i < slot_num; ++i) {
+    unsigned int begin = (unsigned int)((long long)task_num * i / slot_num);
+    unsigned int end = (unsigned int)((long long)task_num * (i + 1) / slot_num);
+    atomic_store(&thread_pool->task_ranges[i], PackRange(tag, begin, end));
+  }
+  atomic_store(&thread_pool->job, task);
+  atomic_store(&thread_pool->epoch, epoch);
+  if (atomic_load(&thread_pool->parked_num) > 0) {
+    UnparkAll(thread_pool, &thread_pool->epoch);
+  }
+  // master thread
+  RunStealingTasks(thread_pool, task, tag, slot_num - 1);
+  WaitStealingTasks(thread_pool);
+  for (int i = 0; i < task->task_num; i++) {
+    if (task->return_code[i] != 0) {
+      return task->return_code[i];
+    }
+  }
+  return RET_TP_OK;
+}
+
 int AddTask(struct ThreadPool *thread_pool, int func(void *, int), void *content, int task_num) {
   if (thread_pool == NULL) {
     LOG_ERROR("get thread pool instane failed");
     return RET_TP_ERROR;
   }
-  // if single thread, run master thread
-  if (thread_pool->thread_num <= 1 || task_num <= 1) {
+  // if single thread or nested in a task, run master thread
+  if (thread_pool->thread_num <= 1 || task_num <= 1 || in_pool_task) {
     for (int i = 0; i < task_num; ++i) {
       int ret = func(content, i);
       if (ret != 0) {
@@ -728,7 +914,10 @@ int AddTask(struct ThreadPool *thread_pool, int func(void *, int), void *content
     return RET_TP_ERROR;
   }
   memset(task.return_code, 0, sizeof(int) * task_num);
-  int ret = DistributeTask(thread_pool, &task, task_num);
+  in_pool_task = true;
+  int ret = thread_pool->type == WORK_STEALING_POOL ? DistributeStealingTask(thread_pool, &task, task_num)
+                                                    : DistributeTask(thread_pool, &task, task_num);
+  in_pool_task = false;
   free(task.return_code);
   return ret;
 }
@@ -748,6 +937,7 @@ void ThreadRun(Thread *thread) {
   Task *task = NULL;
   int thread_id = thread->thread_id;
   int spin_count = 0;
+  in_pool_task = true;
   sem_post(&thread->sem_inited);
   while (thread_pool->is_alive) {
     while (thread->activate) {
@@ -777,6 +967,55 @@ void ThreadRun(Thread *thread) {
   thread->is_running = false;
 }
 
+// spin while jobs keep coming, park when the thread is idle for long: the spin limit doubles when a job comes during
+// the spin and halves after parking
+void WaitStealingJob(Thread *thread, unsigned int seen_epoch) {
+  ThreadPool *thread_pool = (ThreadPool *)(thread->thread_pool);
+  int spin_limit = thread->activate ? thread->spin_count : 0;
+  for (int i = 0; i < spin_limit; ++i) {
+    if (atomic_load_explicit(&thread_pool->epoch, memory_order_relaxed) != seen_epoch || !thread_pool->is_alive) {
+      spin_limit *= 2;
+      thread->spin_count = spin_limit < MAX_STEALING_SPIN_COUNT ? spin_limit : MAX_STEALING_SPIN_COUNT;
+      return;
+    }
+    CPU_RELAX();
+  }
+  atomic_fetch_add(&thread_pool->parked_num, 1);
+  if (thread_pool->is_alive) {
+    Park(thread_pool, &thread_pool->epoch, seen_epoch);
+  }
+  atomic_fetch_sub(&thread_pool->parked_num, 1);
+  spin_limit = thread->spin_count / 2;
+  thread->spin_count = spin_limit > MIN_STEALING_SPIN_COUNT ? spin_limit : MIN_STEALING_SPIN_COUNT;
+}
+
+void StealingThreadRun(Thread *thread) {
+  thread->is_running = true;
+  ThreadPool *thread_pool = (ThreadPool *)(thread->thread_pool);
+  if (thread_pool == NULL) {
+    LOG_ERROR("get thread pool instane failed");
+    thread->is_running = false;
+    return;
+  }
+  unsigned int seen_epoch = atomic_load(&thread_pool->epoch);
+  in_pool_task = true;
+  sem_post(&thread->sem_inited);
+  while (thread_pool->is_alive) {
+    unsigned int epoch = atomic_load(&thread_pool->epoch);
+    if (epoch == seen_epoch) {
+      WaitStealingJob(thread, seen_epoch);
+      continue;
+    }
+    seen_epoch = epoch;
+    // the job may be a newer one than the epoch, then no range carries the tag and nothing runs
+    Task *task = atomic_load(&thread_pool->job);
+    if (task != NULL) {
+      RunStealingTasks(thread_pool, task, epoch & RANGE_TAG_MASK, thread->thread_id);
+    }
+  }
+  thread->is_running = false;
+}
+
 void PushThreadToList(struct ThreadPool *thread_pool, Thread *thread) {
   if (thread_pool == NULL) {
     LOG_ERROR("get thread pool instane failed");
@@ -816,17 +1055,19 @@ int CreateNewThread(struct ThreadPool *thread_pool, int thread_id) {
   thread->activate = ATOMIC_VAR_INIT(true);
   thread->is_running = ATOMIC_VAR_INIT(true);
   thread->next = NULL;
+  thread->spin_count = MAX_STEALING_SPIN_COUNT;
   sem_init(&thread->sem, 0, 0);
   sem_init(&thread->sem_inited, 0, 0);
   PushThreadToList(thread_pool, thread);
-  pthread_create(&thread->pthread, NULL, (void *)ThreadRun, thread);
+  void *thread_run = thread_pool->type == WORK_STEALING_POOL ? (void *)StealingThreadRun : (void *)ThreadRun;
+  pthread_create(&thread->pthread, NULL, thread_run, thread);
   sem_wait(&thread->sem_inited);
   pthread_detach(thread->pthread);
   return RET_TP_OK;
 }
 
-ThreadPool *CreateThreadPool(int thread_num, int mode) {
-  LOG_INFO("create thread pool, thread_num: %d, mode: %d", thread_num, mode);
+ThreadPool *CreateThreadPool(int thread_num, int mode, int type) {
+  LOG_INFO("create thread pool, thread_num: %d, mode: %d, type: %d", thread_num, mode, type);
   if (thread_num <= 0 || thread_num > MAX_THREAD_NUM) {
     LOG_ERROR("invalid thread num: %d", thread_num);
     return NULL;
@@ -849,7 +1090,30 @@ ThreadPool *CreateThreadPool(int thread_num, int mode) {
   thread_pool->thread_num = thread_num > MAX_THREAD_NUM ? MAX_THREAD_NUM : thread_num;
   thread_pool->is_alive = ATOMIC_VAR_INIT(true);
   thread_pool->mode = mode;
+  thread_pool->type = type;
   thread_pool->thread_list = NULL;
+  thread_pool->job = ATOMIC_VAR_INIT(NULL);
+  thread_pool->task_ranges = NULL;
+  thread_pool->epoch = ATOMIC_VAR_INIT(0);
+  thread_pool->remain_task_num = ATOMIC_VAR_INIT(0);
+  thread_pool->parked_num = ATOMIC_VAR_INIT(0);
+  thread_pool->master_parked = ATOMIC_VAR_INIT(false);
+  thread_pool->master_spin_count = MAX_STEALING_SPIN_COUNT;
+#ifndef USE_FUTEX
+  pthread_mutex_init(&thread_pool->park_lock, NULL);
+  pthread_cond_init(&thread_pool->park_cond, NULL);
+#endif
+  if (thread_num > 1 && type == WORK_STEALING_POOL) {
+    thread_pool->task_ranges = (atomic_ullong *)malloc(sizeof(atomic_ullong) * thread_num);
+    if (thread_pool->task_ranges == NULL) {
+      LOG_ERROR("create task ranges failed");
+      free(thread_pool);
+      return NULL;
+    }
+    for (int i = 0; i < thread_num; ++i) {
+      thread_pool->task_ranges[i] = ATOMIC_VAR_INIT(0);
+    }
+  }
   if (thread_num > 1) {
     thread_pool->thread_list = (ThreadList *)malloc(sizeof(ThreadList));
     if (thread_pool->thread_list == NULL) {
@@ -926,6 +1190,11 @@ void DestroyThreadPool(struct ThreadPool *thread_pool) {
   }
   DeactivateThreadPool(thread_pool);
   thread_pool->is_alive = false;
+  if (thread_pool->type == WORK_STEALING_POOL) {
+    // wake up the parked workers, they see the pool is not alive and exit
+    atomic_fetch_add(&thread_pool->epoch, 1);
+    UnparkAll(thread_pool, &thread_pool->epoch);
+  }
   LOG_ERROR("DestroyThreadPool thread num : %d", thread_pool->thread_num);
   for (int i = 0; i < thread_pool->thread_num - 1; ++i) {
     Thread *thread = GetThread(thread_pool, i);
@@ -935,6 +1204,12 @@ void DestroyThreadPool(struct ThreadPool *thread_pool) {
   }
   free(thread_pool->thread_list);
   thread_pool->thread_list = NULL;
+  free(thread_pool->task_ranges);
+  thread_pool->task_ranges = NULL;
+#ifndef USE_FUTEX
+  pthread_mutex_destroy(&thread_pool->park_lock);
+  pthread_cond_destroy(&thread_pool->park_cond);
+#endif
   LOG_INFO("destroy thread pool success");
 }
 
@@ -28,16 +28,29 @@ typedef enum {
   MID_MODE = 2      /**< bind middle cpu first */
 } BindMode;
 
+/// \brief PoolType defined for holding the scheduling of the tasks of a thread pool.
+typedef enum {
+  DEFAULT_POOL = 0,       /**< one task per thread, the master polls the workers */
+  WORK_STEALING_POOL = 1  /**< the idle threads steal the tasks left to the late ones, the master parks till done */
+} PoolType;
+
 struct ThreadPool;
 
-struct ThreadPool *CreateThreadPool(int thread_num, int mode);
+/**
+ * create a thread pool
+ * @param thread_num
+ * @param mode the BindMode
+ * @param type the PoolType
+ */
+struct ThreadPool *CreateThreadPool(int thread_num, int mode, int type);
 
 /**
  *
  * @param session_index, support multi session
  * @param job
  * @param content
- * @param task_num
+ * @param task_num, no more than the thread num unless the pool is a WORK_STEALING_POOL
+ * a call from inside a task of a pool runs all its tasks on the calling thread
  */
 int ParallelLaunch(struct ThreadPool *thread_pool, int (*job)(void *, int), void *content, int task_num);
 
@@ -15,7 +15,11 @@
  */
 
 #include "src/sub_graph_kernel.h"
+#include <algorithm>
+#include <unordered_map>
 #include "src/tensor.h"
+#include "src/common/utils.h"
+#include "src/runtime/parallel_executor.h"
 #if defined(ENABLE_ARM64) && defined(ENABLE_FP16)
 #include "src/runtime/kernel/arm/fp16/fp16_op_handler.h"
 #endif
@@ -26,6 +30,17 @@ using mindspore::lite::RET_INFER_ERR;
 using mindspore::lite::RET_INFER_INVALID;
 using mindspore::lite::RET_OK;
 
+#ifndef SUPPORT_TRAIN
+namespace {
+// merge, switch and select move data between tensors, the nodes after them depend on the data
+bool IsControlFlowNode(const LiteKernel *node) {
+  auto type = node->Type();
+  return type == schema::PrimitiveType_Merge || type == schema::PrimitiveType_Switch ||
+         type == schema::PrimitiveType_Select;
+}
+}  // namespace
+#endif
+
 int SubGraphKernel::Prepare() {
   for (auto node : this->nodes_) {
     if (node == nullptr) {
@@ -161,19 +176,129 @@ int CpuSubGraph::Prepare() {
       tensor->set_allocator(this->context_->allocator.get());
     }
   }
-  this->executor_ = new (std::nothrow) mindspore::lite::CpuExecutor;
+#ifndef SUPPORT_TRAIN
+  this->run_in_parallel_ = this->context_->enable_parallel_ && this->context_->thread_num_ > 1 &&
+                           std::none_of(this->nodes_.begin(), this->nodes_.end(), IsControlFlowNode);
+#endif
+  if (this->run_in_parallel_) {
+    this->executor_ = new (std::nothrow) mindspore::lite::ParallelExecutor(this->context_->thread_pool_);
+  } else {
+    this->executor_ = new (std::nothrow) mindspore::lite::CpuExecutor;
+  }
   if (this->executor_ == nullptr) {
-    MS_LOG(ERROR) << "new CpuExecutor failed";
+    MS_LOG(ERROR) << "new executor failed";
     return RET_ERROR;
   }
   ret = this->executor_->Prepare(this->nodes_);
   if (ret != RET_OK) {
-    MS_LOG(ERROR) << "Prepare CpuExecutor failed";
+    MS_LOG(ERROR) << "Prepare executor failed";
+    return ret;
+  }
+  this->static_allocator_ = new (std::nothrow) mindspore::lite::StaticAllocator(this->context_->allocator.get());
+  if (this->static_allocator_ == nullptr) {
+    MS_LOG(ERROR) << "new StaticAllocator failed";
+    return RET_ERROR;
+  }
+  return PlanStaticMemory();
+}
+
+int CpuSubGraph::PlanStaticMemory() {
+  MS_ASSERT(this->static_allocator_ != nullptr);
+  this->static_allocator_->Reset();
+  this->static_memory_planned_ = true;
+#ifndef SUPPORT_TRAIN
+  for (auto node : this->nodes_) {
+    if (IsControlFlowNode(node)) {
+      return RET_OK;
+    }
+    // the shapes are inferred while running, try again on the next run
+    if (!node->InferShapeDone()) {
+      this->static_memory_planned_ = false;
+      return RET_OK;
+    }
+  }
+  // the nodes run one by one, or wave by wave when the branches run in parallel, the tensors read or written in the
+  // same step are alive at the same time
+  std::vector<std::vector<LiteKernel *>> steps;
+  if (this->run_in_parallel_) {
+    auto ret = lite::SplitWaves(this->nodes_, &steps);
+    if (ret != RET_OK) {
+      return ret;
+    }
+  } else {
+    for (auto node : this->nodes_) {
+      steps.push_back({node});
+    }
+  }
+  // only the tensors which are written and read by the nodes inside are planned, the outputs of the output nodes may
+  // be read by other subgraphs or by the user
+  std::vector<mindspore::lite::TensorLifetime> lifetimes;
+  std::unordered_map<lite::Tensor *, size_t> lifetime_indexes;
+  for (size_t i = 0; i < steps.size(); ++i) {
+    for (auto node : steps[i]) {
+      for (auto tensor : node->in_tensors()) {
+        auto iter = lifetime_indexes.find(tensor);
+        if (iter != lifetime_indexes.end()) {
+          lifetimes[iter->second].last = i;
+        }
+      }
+    }
+    for (auto node : steps[i]) {
+      if (lite::IsContain(this->out_nodes_, node)) {
+        continue;
+      }
+      for (auto tensor : node->out_tensors()) {
+        MS_ASSERT(tensor != nullptr);
+        if (tensor->category() != lite::Tensor::VAR || tensor->root_tensor() != nullptr ||
+            tensor->data_type() == kObjectTypeTensorType || tensor->Size() == 0 ||
+            lite::IsContain(this->out_tensors_, tensor) || lifetime_indexes.count(tensor) != 0) {
+          continue;
+        }
+        lifetime_indexes[tensor] = lifetimes.size();
+        lifetimes.push_back({tensor, i, i});
+      }
+    }
+  }
+  auto ret = this->static_allocator_->Plan(lifetimes);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Plan static memory of " << this->name_ << " failed";
     return ret;
   }
+#endif
+  return RET_OK;
+}
+
+int CpuSubGraph::BindStaticMemory() {
+  MS_ASSERT(this->static_allocator_ != nullptr);
+  bool valid = this->static_memory_planned_ && this->static_allocator_->IsValid() &&
+               std::all_of(this->nodes_.begin(), this->nodes_.end(),
+                           [](LiteKernel *node) { return node->InferShapeDone(); });
+  if (!valid) {
+    auto ret = PlanStaticMemory();
+    if (ret != RET_OK) {
+      return ret;
+    }
+  }
+  this->static_allocator_->Bind();
   return RET_OK;
 }
 
+int CpuSubGraph::Run() {
+  auto ret = BindStaticMemory();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  return SubGraphKernel::Run();
+}
+
+int CpuSubGraph::Run(const KernelCallBack &before, const KernelCallBack &after) {
+  auto ret = BindStaticMemory();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  return SubGraphKernel::Run(before, after);
+}
+
 #ifdef ENABLE_FP16
 void CpuFp16SubGraph::FreeOriginInputData() {
   for (auto *data_store : this->origin_input_data_) {
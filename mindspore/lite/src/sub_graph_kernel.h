@@ -23,6 +23,7 @@
 #include "src/lite_kernel.h"
 #include "src/executor.h"
 #include "src/common/log_adapter.h"
+#include "src/runtime/static_allocator.h"
 #ifdef ENABLE_ARM64
 #include "src/common/utils.h"
 #endif
@@ -126,15 +127,30 @@ class CpuSubGraph : public SubGraphKernel {
     subgraph_type_ = kCpuFP32SubGraph;
   }
 
-  ~CpuSubGraph() override { delete this->executor_; }
+  ~CpuSubGraph() override {
+    delete this->executor_;
+    delete this->static_allocator_;
+  }
   int Prepare() override;
   int Init() override { return SubGraphKernel::Init(); }
   int PreProcess() override { return SubGraphKernel::PreProcess(); }
-  int Run() override { return SubGraphKernel::Run(); }
-  int Run(const KernelCallBack &before, const KernelCallBack &after) override {
-    return SubGraphKernel::Run(before, after);
-  };
+  int Run() override;
+  int Run(const KernelCallBack &before, const KernelCallBack &after) override;
   int PostProcess() override { return SubGraphKernel::PostProcess(); }
+  // size of the arena the tensors produced and consumed inside the subgraph are planned into
+  size_t arena_size() const { return static_allocator_ == nullptr ? 0 : static_allocator_->arena_size(); }
+
+ private:
+  // plan the tensors by their lifetimes in the execution order of nodes_, which CpuExecutor runs sequentially and
+  // ParallelExecutor runs in waves
+  int PlanStaticMemory();
+  // replan when the planned sizes are stale, e.g. after a resize, then bind the tensors into the arena
+  int BindStaticMemory();
+
+  lite::StaticAllocator *static_allocator_ = nullptr;
+  bool static_memory_planned_ = false;
+  // the independent branches run in parallel, see Context::enable_parallel_
+  bool run_in_parallel_ = false;
 };
 
 class CpuFp32SubGraph : public CpuSubGraph {
@@ -30,6 +30,8 @@
 
 namespace mindspore {
 namespace lite {
+class PreparedWeights;
+
 struct QuantArg {
   double scale;
   int32_t zeroPoint;
@@ -149,6 +151,16 @@ class Tensor : public mindspore::tensor::MSTensor {
 
   void set_quant_clusters(const std::vector<float> &clusters);
 
+  // the prepared weights of the model this weight tensor is read from, the kernels share their packed weight there
+  PreparedWeights *prepared_weights() const { return this->prepared_weights_; }
+
+  size_t tensor_index() const { return this->tensor_index_; }
+
+  void set_prepared_weights(PreparedWeights *prepared_weights, size_t tensor_index) {
+    this->prepared_weights_ = prepared_weights;
+    this->tensor_index_ = tensor_index;
+  }
+
   virtual bool IsConst() const {
     return (this->category_ == CONST_TENSOR || this->category_ == CONST_SCALAR) && this->data_ != nullptr;
   }
@@ -198,6 +210,8 @@ class Tensor : public mindspore::tensor::MSTensor {
   std::vector<float> quant_clusters_;
   mindspore::lite::Allocator *allocator_ = nullptr;
   Tensor *root_tensor_ = nullptr;
+  PreparedWeights *prepared_weights_ = nullptr;
+  size_t tensor_index_ = 0;
 };
 
 inline size_t DataTypeSize(const TypeId type) {
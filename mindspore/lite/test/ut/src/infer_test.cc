@@ -15,7 +15,11 @@
  */
 
 #include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <memory>
+#include <string>
+#include <vector>
 #include "schema/inner/model_generated.h"
 #include "mindspore/lite/include/model.h"
 #include "common/common_test.h"
@@ -24,6 +28,7 @@
 #include "include/errorcode.h"
 #include "src/common/log_adapter.h"
 #include "src/lite_session.h"
+#include "src/lite_model.h"
 #include "src/runtime/parallel_executor.h"
 
 namespace mindspore {
@@ -236,6 +241,263 @@ TEST_F(InferTest, TestAddNode) {
   MS_LOG(INFO) << "Passed";
 }
 
+TEST_F(InferTest, TestStaticMemoryPlan) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+
+  // out = (x + y) + y + y, the two intermediate tensors are alive at the same time between the adds
+  for (uint32_t i = 0; i < 3; i++) {
+    auto node = std::make_unique<schema::CNodeT>();
+    node->inputIndex = {i == 0 ? 0 : i + 1, 1};
+    node->outputIndex = {i + 2};
+    node->primitive = std::make_unique<schema::PrimitiveT>();
+    node->primitive->value.type = schema::PrimitiveType_Add;
+    node->primitive->value.value = new schema::AddT;
+    node->name = "Add" + std::to_string(i);
+    meta_graph->nodes.emplace_back(std::move(node));
+  }
+  meta_graph->inputIndex = {0, 1};
+  meta_graph->outputIndex = {4};
+
+  for (int i = 0; i < 5; i++) {
+    auto tensor = std::make_unique<schema::TensorT>();
+    tensor->nodeType = i < 2 ? schema::NodeType::NodeType_ValueNode : schema::NodeType::NodeType_Parameter;
+    tensor->format = schema::Format_NHWC;
+    tensor->dataType = TypeId::kNumberTypeFloat32;
+    if (i < 2) {
+      tensor->dims = {1, 28, 28, 3};
+    }
+    tensor->offset = -1;
+    meta_graph->allTensors.emplace_back(std::move(tensor));
+  }
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  size_t size = builder.GetSize();
+  const char *content = reinterpret_cast<char *>(builder.GetBufferPointer());
+
+  auto model = lite::Model::Import(content, size);
+  ASSERT_NE(nullptr, model);
+  meta_graph.reset();
+  content = nullptr;
+  auto context = new lite::InnerContext;
+  auto &device_list = context->device_list_;
+  lite::DeviceContext device_ctx = {lite::DT_CPU, {false, lite::NO_BIND}};
+  device_list.push_back(device_ctx);
+  context->thread_num_ = 2;
+  ASSERT_EQ(lite::RET_OK, context->Init());
+  auto session = session::LiteSession::CreateSession(context);
+  ASSERT_NE(nullptr, session);
+  auto ret = session->CompileGraph(model);
+  ASSERT_EQ(lite::RET_OK, ret);
+  ASSERT_EQ(2 * 28 * 28 * 3 * sizeof(float), session->GetArenaSize());
+
+  auto inputs = session->GetInputs();
+  ASSERT_EQ(inputs.size(), 2);
+  for (std::vector<int> shape : {std::vector<int>{1, 28, 28, 3}, std::vector<int>{1, 4, 4, 3}}) {
+    if (shape != inputs.front()->shape()) {
+      ASSERT_EQ(lite::RET_OK, session->Resize(inputs, {shape, shape}));
+    }
+    for (int run = 0; run < 2; run++) {
+      auto x = reinterpret_cast<float *>(inputs.front()->MutableData());
+      auto y = reinterpret_cast<float *>(inputs.back()->MutableData());
+      ASSERT_NE(nullptr, x);
+      ASSERT_NE(nullptr, y);
+      for (int i = 0; i < inputs.front()->ElementsNum(); i++) {
+        x[i] = i + run;
+        y[i] = 2;
+      }
+      ret = session->RunGraph();
+      ASSERT_EQ(lite::RET_OK, ret);
+      auto outTensor = session->GetOutputs().begin()->second;
+      ASSERT_EQ(inputs.front()->ElementsNum(), outTensor->ElementsNum());
+      auto *outData = reinterpret_cast<float *>(outTensor->MutableData());
+      ASSERT_NE(nullptr, outData);
+      for (int i = 0; i < outTensor->ElementsNum(); i++) {
+        ASSERT_EQ(i + run + 6, outData[i]);
+      }
+    }
+  }
+  // the first run after resizing plans the tensors again for the new shape
+  ASSERT_EQ(2 * 4 * 4 * 3 * sizeof(float), session->GetArenaSize());
+  delete session;
+  MS_LOG(INFO) << "Passed";
+}
+
+TEST_F(InferTest, TestImportFromFileSharedWeights) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Add;
+  node->primitive->value.value = new schema::AddT;
+  node->name = "Add";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {2};
+
+  const int element_num = 4 * 4 * 3;
+  std::vector<float> weight_data(element_num);
+  for (int i = 0; i < element_num; i++) {
+    weight_data[i] = i * 0.5f;
+  }
+  for (int i = 0; i < 3; i++) {
+    auto tensor = std::make_unique<schema::TensorT>();
+    tensor->nodeType = i < 2 ? schema::NodeType::NodeType_ValueNode : schema::NodeType::NodeType_Parameter;
+    tensor->format = schema::Format_NHWC;
+    tensor->dataType = TypeId::kNumberTypeFloat32;
+    if (i < 2) {
+      tensor->dims = {1, 4, 4, 3};
+    }
+    if (i == 1) {
+      auto bytes = reinterpret_cast<uint8_t *>(weight_data.data());
+      tensor->data.assign(bytes, bytes + element_num * sizeof(float));
+    }
+    tensor->offset = -1;
+    meta_graph->allTensors.emplace_back(std::move(tensor));
+  }
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  std::string model_path = "./test_shared_weights.ms";
+  std::ofstream model_file(model_path, std::ios::binary);
+  model_file.write(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+  model_file.close();
+
+  auto model = lite::Model::ImportFromFile(model_path.c_str());
+  ASSERT_NE(nullptr, model);
+  std::vector<session::LiteSession *> sessions;
+  for (int i = 0; i < 2; i++) {
+    auto context = new lite::InnerContext;
+    lite::DeviceContext device_ctx = {lite::DT_CPU, {false, lite::NO_BIND}};
+    context->device_list_.push_back(device_ctx);
+    context->thread_num_ = 1;
+    ASSERT_EQ(lite::RET_OK, context->Init());
+    auto session = session::LiteSession::CreateSession(context);
+    ASSERT_NE(nullptr, session);
+    ASSERT_EQ(lite::RET_OK, session->CompileGraph(model));
+    sessions.push_back(session);
+  }
+  // the weight of Add is prepared once for both sessions, and outlives the mapped model file
+  model->Free();
+  for (size_t i = 0; i < sessions.size(); i++) {
+    auto input = sessions[i]->GetInputs().front();
+    auto input_data = reinterpret_cast<float *>(input->MutableData());
+    ASSERT_NE(nullptr, input_data);
+    for (int j = 0; j < element_num; j++) {
+      input_data[j] = i;
+    }
+    ASSERT_EQ(lite::RET_OK, sessions[i]->RunGraph());
+    auto output = sessions[i]->GetOutputs().begin()->second;
+    auto output_data = reinterpret_cast<float *>(output->MutableData());
+    ASSERT_NE(nullptr, output_data);
+    for (int j = 0; j < element_num; j++) {
+      ASSERT_EQ(weight_data[j] + i, output_data[j]);
+    }
+  }
+  for (auto session : sessions) {
+    delete session;
+  }
+  delete model;
+  remove(model_path.c_str());
+  MS_LOG(INFO) << "Passed";
+}
+
+TEST_F(InferTest, TestSharedPackedWeights) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_MatMul;
+  node->primitive->value.value = new schema::MatMulT;
+  node->name = "MatMul";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {2};
+
+  const int row = 2;
+  const int deep = 3;
+  const int col = 4;
+  std::vector<float> weight_data(deep * col);
+  for (int i = 0; i < deep * col; i++) {
+    weight_data[i] = i * 0.5f;
+  }
+  std::vector<std::vector<int>> dims = {{row, deep}, {deep, col}, {row, col}};
+  for (int i = 0; i < 3; i++) {
+    auto tensor = std::make_unique<schema::TensorT>();
+    tensor->nodeType = i < 2 ? schema::NodeType::NodeType_ValueNode : schema::NodeType::NodeType_Parameter;
+    tensor->format = schema::Format_NHWC;
+    tensor->dataType = TypeId::kNumberTypeFloat32;
+    tensor->dims = dims[i];
+    if (i == 1) {
+      auto bytes = reinterpret_cast<uint8_t *>(weight_data.data());
+      tensor->data.assign(bytes, bytes + weight_data.size() * sizeof(float));
+    }
+    tensor->offset = -1;
+    meta_graph->allTensors.emplace_back(std::move(tensor));
+  }
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  auto model = lite::Model::Import(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+  ASSERT_NE(nullptr, model);
+  auto prepared_weights = static_cast<lite::LiteModel *>(model)->prepared_weights();
+  std::vector<session::LiteSession *> sessions;
+  std::vector<size_t> prepared_sizes;
+  for (int i = 0; i < 2; i++) {
+    auto context = new lite::InnerContext;
+    lite::DeviceContext device_ctx = {lite::DT_CPU, {false, lite::NO_BIND}};
+    context->device_list_.push_back(device_ctx);
+    context->thread_num_ = 1;
+    ASSERT_EQ(lite::RET_OK, context->Init());
+    auto session = session::LiteSession::CreateSession(context);
+    ASSERT_NE(nullptr, session);
+    ASSERT_EQ(lite::RET_OK, session->CompileGraph(model));
+    sessions.push_back(session);
+    prepared_sizes.push_back(prepared_weights->total_size());
+  }
+  // the weight of MatMul is packed by the first session only, the second one attaches to it
+  ASSERT_GE(prepared_sizes[0], weight_data.size() * sizeof(float));
+  ASSERT_EQ(prepared_sizes[0], prepared_sizes[1]);
+  // and the packed weight outlives the model buffer
+  model->Free();
+  for (size_t i = 0; i < sessions.size(); i++) {
+    auto input = sessions[i]->GetInputs().front();
+    auto input_data = reinterpret_cast<float *>(input->MutableData());
+    ASSERT_NE(nullptr, input_data);
+    for (int j = 0; j < row * deep; j++) {
+      input_data[j] = j + i;
+    }
+    ASSERT_EQ(lite::RET_OK, sessions[i]->RunGraph());
+    auto output = sessions[i]->GetOutputs().begin()->second;
+    auto output_data = reinterpret_cast<float *>(output->MutableData());
+    ASSERT_NE(nullptr, output_data);
+    for (int r = 0; r < row; r++) {
+      for (int c = 0; c < col; c++) {
+        float expect = 0;
+        for (int d = 0; d < deep; d++) {
+          expect += input_data[r * deep + d] * weight_data[d * col + c];
+        }
+        ASSERT_NEAR(expect, output_data[r * col + c], 1e-4);
+      }
+    }
+  }
+  for (auto session : sessions) {
+    delete session;
+  }
+  delete model;
+  MS_LOG(INFO) << "Passed";
+}
+
 class SessionWithParallelExecutor : public lite::LiteSession {
  public:
   int Init(lite::InnerContext *context) {
@@ -328,6 +590,96 @@ TEST_F(InferTest, TestParallelExecutor) {
   MS_LOG(INFO) << "Passed";
 }
 
+TEST_F(InferTest, TestParallelBranches) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+
+  // four branches, then two adds joining them in pairs and the last one: out = 4 * x + 4 * y
+  std::vector<std::vector<uint32_t>> input_indexes = {{0, 1}, {0, 0}, {1, 1}, {0, 1}, {2, 3}, {4, 5}, {6, 7}};
+  for (uint32_t i = 0; i < input_indexes.size(); i++) {
+    auto node = std::make_unique<schema::CNodeT>();
+    node->inputIndex = input_indexes[i];
+    node->outputIndex = {i + 2};
+    node->primitive = std::make_unique<schema::PrimitiveT>();
+    node->primitive->value.type = schema::PrimitiveType_Add;
+    node->primitive->value.value = new schema::AddT;
+    node->name = "Add" + std::to_string(i);
+    meta_graph->nodes.emplace_back(std::move(node));
+  }
+  meta_graph->inputIndex = {0, 1};
+  meta_graph->outputIndex = {8};
+
+  for (int i = 0; i < 9; i++) {
+    auto tensor = std::make_unique<schema::TensorT>();
+    tensor->nodeType = i < 2 ? schema::NodeType::NodeType_ValueNode : schema::NodeType::NodeType_Parameter;
+    tensor->format = schema::Format_NHWC;
+    tensor->dataType = TypeId::kNumberTypeFloat32;
+    if (i < 2) {
+      tensor->dims = {1, 28, 28, 3};
+    }
+    tensor->offset = -1;
+    meta_graph->allTensors.emplace_back(std::move(tensor));
+  }
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  size_t size = builder.GetSize();
+  const char *content = reinterpret_cast<char *>(builder.GetBufferPointer());
+
+  auto model = lite::Model::Import(content, size);
+  ASSERT_NE(nullptr, model);
+  meta_graph.reset();
+  content = nullptr;
+  auto context = new lite::InnerContext;
+  auto &device_list = context->device_list_;
+  lite::DeviceContext device_ctx = {lite::DT_CPU, {false, lite::NO_BIND}};
+  device_list.push_back(device_ctx);
+  context->thread_num_ = 4;
+  context->enable_parallel_ = true;
+  ASSERT_EQ(lite::RET_OK, context->Init());
+  auto session = session::LiteSession::CreateSession(context);
+  ASSERT_NE(nullptr, session);
+  auto ret = session->CompileGraph(model);
+  ASSERT_EQ(lite::RET_OK, ret);
+  // the waves are [Add0, Add1, Add2, Add3], [Add4, Add5], [Add6]: the six intermediate tensors are alive together
+  // while the second wave runs
+  ASSERT_EQ(6 * 28 * 28 * 3 * sizeof(float), session->GetArenaSize());
+
+  auto inputs = session->GetInputs();
+  ASSERT_EQ(inputs.size(), 2);
+  int kernel_num = 0;
+  KernelCallBack count_kernel = [&kernel_num](const std::vector<tensor::MSTensor *> &in_tensors,
+                                              const std::vector<tensor::MSTensor *> &out_tensors,
+                                              const CallBackParam &call_param) {
+    kernel_num++;
+    return true;
+  };
+  for (int run = 0; run < 3; run++) {
+    auto x = reinterpret_cast<float *>(inputs.front()->MutableData());
+    auto y = reinterpret_cast<float *>(inputs.back()->MutableData());
+    ASSERT_NE(nullptr, x);
+    ASSERT_NE(nullptr, y);
+    for (int i = 0; i < inputs.front()->ElementsNum(); i++) {
+      x[i] = i + run;
+      y[i] = 2;
+    }
+    // the kernels run one by one when there are callbacks
+    ret = run < 2 ? session->RunGraph() : session->RunGraph(count_kernel, nullptr);
+    ASSERT_EQ(lite::RET_OK, ret);
+    auto outTensor = session->GetOutputs().begin()->second;
+    ASSERT_EQ(inputs.front()->ElementsNum(), outTensor->ElementsNum());
+    auto *outData = reinterpret_cast<float *>(outTensor->MutableData());
+    ASSERT_NE(nullptr, outData);
+    for (int i = 0; i < outTensor->ElementsNum(); i++) {
+      ASSERT_EQ(4 * (i + run) + 8, outData[i]);
+    }
+  }
+  ASSERT_EQ(7, kernel_num);
+  delete session;
+  MS_LOG(INFO) << "Passed";
+}
+
 TEST_F(InferTest, TestModel) {
   auto buf = new char *[1];
   size_t model_size;
@@ -0,0 +1,176 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+#include "common/common_test.h"
+#include "nnacl/x86_64_avx/fp32_simd.h"
+
+#ifdef ENABLE_X86_SIMD_DISPATCH
+namespace mindspore {
+class TestSimdDispatchFp32 : public mindspore::CommonTest {
+ public:
+  TestSimdDispatchFp32() {}
+
+  // the kernel tables of the instruction sets this CPU supports, each one is checked against the reference
+  static std::vector<const Fp32SimdFuncs *> SupportedFuncs() {
+    std::vector<const Fp32SimdFuncs *> funcs;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+      funcs.push_back(GetFp32Avx2Funcs());
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+      funcs.push_back(GetFp32Avx512Funcs());
+    }
+    return funcs;
+  }
+
+  // lengths around the vector widths, so the tails are covered
+  static std::vector<float> MakeInput(int num) {
+    std::vector<float> input(num);
+    for (int i = 0; i < num; ++i) {
+      input[i] = static_cast<float>(i * 37 % 101 - 50) * 0.37f;
+    }
+    return input;
+  }
+};
+
+TEST_F(TestSimdDispatchFp32, Activations) {
+  for (auto funcs : SupportedFuncs()) {
+    for (int num = 1; num <= 40; ++num) {
+      auto input = MakeInput(num);
+      std::vector<float> output(num);
+      funcs->exp(input.data(), output.data(), num);
+      for (int i = 0; i < num; ++i) {
+        double expect = std::exp(static_cast<double>(input[i]));
+        ASSERT_NEAR(output[i], expect, expect * 3e-7);
+      }
+      funcs->sigmoid(input.data(), output.data(), num);
+      for (int i = 0; i < num; ++i) {
+        ASSERT_NEAR(output[i], 1 / (1 + std::exp(-static_cast<double>(input[i]))), 2e-7);
+      }
+      funcs->tanh(input.data(), output.data(), num);
+      for (int i = 0; i < num; ++i) {
+        ASSERT_NEAR(output[i], std::tanh(static_cast<double>(input[i])), 1e-4);
+      }
+    }
+  }
+}
+
+TEST_F(TestSimdDispatchFp32, GeLU) {
+  for (auto funcs : SupportedFuncs()) {
+    for (int num = 1; num <= 40; ++num) {
+      auto input = MakeInput(num);
+      std::vector<float> output(num);
+      funcs->gelu(input.data(), output.data(), num, true);
+      for (int i = 0; i < num; ++i) {
+        double x = input[i];
+        double expect = 0.5 * x * (1 + std::tanh(0.7978845608028654 * (x + 0.044715 * x * x * x)));
+        ASSERT_NEAR(output[i], expect, 2e-6 * (1 + std::fabs(x)));
+      }
+      funcs->gelu(input.data(), output.data(), num, false);
+      for (int i = 0; i < num; ++i) {
+        double x = input[i];
+        ASSERT_NEAR(output[i], 0.5 * x * (1 + std::erf(x / std::sqrt(2.0))), 1e-6 * (1 + std::fabs(x)));
+      }
+    }
+  }
+}
+
+TEST_F(TestSimdDispatchFp32, SoftmaxLastAxis) {
+  const int batch = 3;
+  for (auto funcs : SupportedFuncs()) {
+    for (int channel = 1; channel <= 40; ++channel) {
+      auto input = MakeInput(batch * channel);
+      std::vector<float> output(batch * channel);
+      funcs->softmax_last_axis(input.data(), output.data(), batch, channel);
+      for (int b = 0; b < batch; ++b) {
+        const float *row = input.data() + b * channel;
+        double max = -DBL_MAX;
+        double sum = 0;
+        for (int j = 0; j < channel; ++j) {
+          max = std::max(max, static_cast<double>(row[j]));
+        }
+        for (int j = 0; j < channel; ++j) {
+          sum += std::exp(row[j] - max);
+        }
+        for (int j = 0; j < channel; ++j) {
+          ASSERT_NEAR(output[b * channel + j], std::exp(row[j] - max) / sum, 1e-6);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(TestSimdDispatchFp32, LayerNorm) {
+  for (auto funcs : SupportedFuncs()) {
+    for (int num = 1; num <= 40; ++num) {
+      auto input = MakeInput(num);
+      float mean = 0;
+      float square_mean = 0;
+      funcs->layer_norm_mean_and_square(input.data(), num, &mean, &square_mean);
+      double expect_mean = 0;
+      double expect_square_mean = 0;
+      for (int i = 0; i < num; ++i) {
+        expect_mean += input[i];
+        expect_square_mean += static_cast<double>(input[i]) * input[i];
+      }
+      ASSERT_NEAR(mean, expect_mean / num, 1e-4);
+      ASSERT_NEAR(square_mean, expect_square_mean / num, 1e-3);
+
+      std::vector<float> gamma(num);
+      std::vector<float> beta(num);
+      std::vector<float> output(num);
+      for (int i = 0; i < num; ++i) {
+        gamma[i] = 0.5f + i * 0.01f;
+        beta[i] = i * 0.1f;
+      }
+      funcs->layer_norm_gamma_and_beta(output.data(), input.data(), gamma.data(), beta.data(), num, 0.3f, 1.7f);
+      for (int i = 0; i < num; ++i) {
+        ASSERT_NEAR(output[i], (input[i] - 0.3f) * 1.7f * gamma[i] + beta[i], 1e-4);
+      }
+    }
+  }
+}
+
+TEST_F(TestSimdDispatchFp32, Reduce) {
+  const SimdReduceMode modes[] = {SIMD_REDUCE_SUM, SIMD_REDUCE_MEAN, SIMD_REDUCE_MAX, SIMD_REDUCE_MIN};
+  for (auto funcs : SupportedFuncs()) {
+    for (int inner_size : {1, 3, 8, 16, 21}) {
+      for (int axis_size = 1; axis_size <= 35; ++axis_size) {
+        auto input = MakeInput(axis_size * inner_size);
+        std::vector<float> output(inner_size);
+        for (auto mode : modes) {
+          funcs->reduce(input.data(), output.data(), inner_size, axis_size, mode);
+          for (int k = 0; k < inner_size; ++k) {
+            double expect = mode == SIMD_REDUCE_MAX ? -FLT_MAX : (mode == SIMD_REDUCE_MIN ? FLT_MAX : 0);
+            for (int i = 0; i < axis_size; ++i) {
+              double value = input[i * inner_size + k];
+              expect = mode == SIMD_REDUCE_MAX ? std::max(expect, value)
+                                               : (mode == SIMD_REDUCE_MIN ? std::min(expect, value) : expect + value);
+            }
+            if (mode == SIMD_REDUCE_MEAN) {
+              expect /= axis_size;
+            }
+            ASSERT_NEAR(output[k], expect, 1e-4);
+          }
+        }
+      }
+    }
+  }
+}
+}  // namespace mindspore
+#endif
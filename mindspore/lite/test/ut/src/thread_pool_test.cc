@@ -0,0 +1,148 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+#include <atomic>
+#include <vector>
+#include "common/common_test.h"
+#include "src/runtime/runtime_api.h"
+
+namespace mindspore {
+class ThreadPoolTest : public mindspore::CommonTest {
+ public:
+  ThreadPoolTest() {}
+};
+
+namespace {
+struct CountContent {
+  std::vector<std::atomic_int> counts;
+  int slow_task_id = -1;
+  int failed_task_id = -1;
+  explicit CountContent(int task_num) : counts(task_num) {}
+};
+
+int CountTask(void *content, int task_id) {
+  auto count_content = reinterpret_cast<CountContent *>(content);
+  if (task_id == count_content->slow_task_id) {
+    usleep(20000);
+  }
+  count_content->counts[task_id]++;
+  return task_id == count_content->failed_task_id ? -1 : 0;
+}
+
+struct NestedContent {
+  ThreadPool *thread_pool;
+  std::vector<CountContent> contents;
+  NestedContent(ThreadPool *pool, int task_num) : thread_pool(pool) {
+    for (int i = 0; i < task_num; ++i) {
+      contents.emplace_back(task_num);
+    }
+  }
+};
+
+int NestedTask(void *content, int task_id) {
+  auto nested_content = reinterpret_cast<NestedContent *>(content);
+  auto &count_content = nested_content->contents[task_id];
+  auto task_num = static_cast<int>(count_content.counts.size());
+  return ParallelLaunch(nested_content->thread_pool, CountTask, &count_content, task_num);
+}
+
+void ReleaseThreadPool(ThreadPool *thread_pool) {
+  DestroyThreadPool(thread_pool);
+  free(thread_pool);
+}
+}  // namespace
+
+TEST_F(ThreadPoolTest, TestDefaultPool) {
+  auto thread_pool = CreateLiteThreadPool(4, NO_BIND_MODE, DEFAULT_POOL);
+  ASSERT_NE(thread_pool, nullptr);
+  for (int task_num = 1; task_num <= 4; ++task_num) {
+    CountContent content(task_num);
+    for (int i = 0; i < 100; ++i) {
+      ASSERT_EQ(ParallelLaunch(thread_pool, CountTask, &content, task_num), 0);
+    }
+    for (auto &count : content.counts) {
+      ASSERT_EQ(count, 100);
+    }
+  }
+  CountContent content(8);
+  ASSERT_NE(ParallelLaunch(thread_pool, CountTask, &content, 8), 0);
+  ReleaseThreadPool(thread_pool);
+}
+
+TEST_F(ThreadPoolTest, TestWorkStealingPool) {
+  auto thread_pool = CreateLiteThreadPool(4, NO_BIND_MODE, WORK_STEALING_POOL);
+  ASSERT_NE(thread_pool, nullptr);
+  // more tasks than threads are allowed, each task runs once per launch
+  for (int task_num : {1, 2, 3, 4, 7, 64, 1000}) {
+    CountContent content(task_num);
+    for (int i = 0; i < 100; ++i) {
+      ASSERT_EQ(ParallelLaunch(thread_pool, CountTask, &content, task_num), 0);
+    }
+    for (auto &count : content.counts) {
+      ASSERT_EQ(count, 100);
+    }
+  }
+  // the pool parks when it is idle and wakes up for the next launch
+  usleep(100000);
+  CountContent content(16);
+  ASSERT_EQ(ParallelLaunch(thread_pool, CountTask, &content, 16), 0);
+  for (auto &count : content.counts) {
+    ASSERT_EQ(count, 1);
+  }
+  ReleaseThreadPool(thread_pool);
+}
+
+TEST_F(ThreadPoolTest, TestNestedLaunch) {
+  for (int type : {DEFAULT_POOL, WORK_STEALING_POOL}) {
+    auto thread_pool = CreateLiteThreadPool(4, NO_BIND_MODE, type);
+    ASSERT_NE(thread_pool, nullptr);
+    // a launch from a task runs its tasks inline on the thread of the task
+    NestedContent content(thread_pool, 4);
+    for (int i = 0; i < 10; ++i) {
+      ASSERT_EQ(ParallelLaunch(thread_pool, NestedTask, &content, 4), 0);
+    }
+    for (auto &count_content : content.contents) {
+      for (auto &count : count_content.counts) {
+        ASSERT_EQ(count, 10);
+      }
+    }
+    ReleaseThreadPool(thread_pool);
+  }
+}
+
+TEST_F(ThreadPoolTest, TestWorkStealingImbalance) {
+  auto thread_pool = CreateLiteThreadPool(4, NO_BIND_MODE, WORK_STEALING_POOL);
+  ASSERT_NE(thread_pool, nullptr);
+  // the range of the slow task's thread is stolen by the others
+  CountContent content(32);
+  content.slow_task_id = 0;
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(ParallelLaunch(thread_pool, CountTask, &content, 32), 0);
+  }
+  for (auto &count : content.counts) {
+    ASSERT_EQ(count, 10);
+  }
+  // the error of any task is returned, the other tasks still run
+  CountContent failed_content(32);
+  failed_content.failed_task_id = 17;
+  ASSERT_EQ(ParallelLaunch(thread_pool, CountTask, &failed_content, 32), -1);
+  for (auto &count : failed_content.counts) {
+    ASSERT_EQ(count, 1);
+  }
+  ReleaseThreadPool(thread_pool);
+}
+}  // namespace mindspore
@@ -590,6 +590,8 @@ int Benchmark::RunBenchmark() {
   }
 
   context->thread_num_ = flags_->num_threads_;
+  context->thread_pool_type_ = flags_->enable_work_stealing_ ? WORK_STEALING_THREAD_POOL : DEFAULT_THREAD_POOL;
+  context->enable_parallel_ = flags_->enable_parallel_;
 
   session_ = session::LiteSession::CreateSession(context.get());
   if (session_ == nullptr) {
@@ -837,6 +839,8 @@ int Benchmark::Init() {
   MS_LOG(INFO) << "WarmUpLoopCount = " << this->flags_->warm_up_loop_count_;
   MS_LOG(INFO) << "NumThreads = " << this->flags_->num_threads_;
   MS_LOG(INFO) << "Fp16Priority = " << this->flags_->enable_fp16_;
+  MS_LOG(INFO) << "WorkStealing = " << this->flags_->enable_work_stealing_;
+  MS_LOG(INFO) << "Parallel = " << this->flags_->enable_parallel_;
   MS_LOG(INFO) << "calibDataPath = " << this->flags_->benchmark_data_file_;
   std::cout << "ModelPath = " << this->flags_->model_file_ << std::endl;
   std::cout << "InDataPath = " << this->flags_->in_data_file_ << std::endl;
@@ -847,6 +851,8 @@ int Benchmark::Init() {
   std::cout << "WarmUpLoopCount = " << this->flags_->warm_up_loop_count_ << std::endl;
   std::cout << "NumThreads = " << this->flags_->num_threads_ << std::endl;
   std::cout << "Fp16Priority = " << this->flags_->enable_fp16_ << std::endl;
+  std::cout << "WorkStealing = " << this->flags_->enable_work_stealing_ << std::endl;
+  std::cout << "Parallel = " << this->flags_->enable_parallel_ << std::endl;
   std::cout << "calibDataPath = " << this->flags_->benchmark_data_file_ << std::endl;
   if (this->flags_->loop_count_ < 1) {
     MS_LOG(ERROR) << "LoopCount:" << this->flags_->loop_count_ << " must be greater than 0";
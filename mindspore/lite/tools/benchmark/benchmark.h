@@ -80,6 +80,9 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
     AddFlag(&BenchmarkFlags::loop_count_, "loopCount", "Run loop count", 10);
     AddFlag(&BenchmarkFlags::num_threads_, "numThreads", "Run threads number", 2);
     AddFlag(&BenchmarkFlags::enable_fp16_, "enableFp16", "Enable float16", false);
+    AddFlag(&BenchmarkFlags::enable_work_stealing_, "enableWorkStealing", "Run with the work stealing thread pool",
+            false);
+    AddFlag(&BenchmarkFlags::enable_parallel_, "enableParallel", "Run the independent branches in parallel", false);
     AddFlag(&BenchmarkFlags::warm_up_loop_count_, "warmUpLoopCount", "Run warm up loop", 3);
     AddFlag(&BenchmarkFlags::time_profiling_, "timeProfiling", "Run time profiling", false);
     AddFlag(&BenchmarkFlags::perf_profiling_, "perfProfiling",
@@ -112,6 +115,8 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
   int loop_count_ = 10;
   int num_threads_ = 2;
   bool enable_fp16_ = false;
+  bool enable_work_stealing_ = false;
+  bool enable_parallel_ = false;
   int warm_up_loop_count_ = 3;
   bool time_profiling_ = false;
   bool perf_profiling_ = false;
@@ -16,6 +16,7 @@
 """bprop primitives"""
 from .. import functional as F
 from .. import operations as P
+from ..operations import _grad_ops as G
 from ..composite.multitype_ops.zeros_like_impl import zeros_like
 from .grad_base import bprops, bprop_getters
 
@@ -56,3 +57,29 @@ def get_bprop_sparse_to_dense(self):
         return zeros_like(indices), dout, zeros_like(dense_shape)
 
     return bprop
+
+
+@bprop_getters.register(P.SparseTensorDenseMatmul)
+def get_bprop_sparse_tensor_dense_matmul(self):
+    """Generate bprop for SparseTensorDenseMatmul"""
+    values_grad = G.SparseTensorDenseMatmulGrad(self.adjoint_st)
+    dense_grad = P.SparseTensorDenseMatmul(not self.adjoint_st)
+
+    def bprop(indices, values, sparse_shape, dense, out, dout):
+        return (zeros_like(indices), values_grad(indices, dout, dense), zeros_like(sparse_shape),
+                dense_grad(indices, values, sparse_shape, dout))
+
+    return bprop
+
+
+@bprop_getters.register(P.CSRSparseDenseMatmul)
+def get_bprop_csr_sparse_dense_matmul(self):
+    """Generate bprop for CSRSparseDenseMatmul"""
+    values_grad = G.CSRSparseDenseMatmulGrad(self.adjoint_st)
+    dense_grad = P.CSRSparseDenseMatmul(not self.adjoint_st)
+
+    def bprop(indptr, indices, values, sparse_shape, dense, out, dout):
+        return (zeros_like(indptr), zeros_like(indices), values_grad(indptr, indices, dout, dense),
+                zeros_like(sparse_shape), dense_grad(indptr, indices, values, sparse_shape, dout))
+
+    return bprop
@@ -2170,3 +2170,52 @@ class LRNGrad(PrimitiveWithInfer):
 
     def infer_shape(self, grads, x, y):
         return x
+
+
+class SparseTensorDenseMatmulGrad(PrimitiveWithInfer):
+    """
+    Computes the gradient of the values of SparseTensorDenseMatmul, the inner product of the rows of dout and dense
+    at the position of every entry. The gradient of dense is SparseTensorDenseMatmul with the other `adjoint_st`.
+    """
+
+    @prim_attr_register
+    def __init__(self, adjoint_st=False):
+        """Initialize SparseTensorDenseMatmulGrad"""
+        validator.check_value_type("adjoint_st", adjoint_st, [bool], self.name)
+        self.init_prim_io_names(inputs=['indices', 'dout', 'dense'], outputs=['values_grad'])
+
+    def infer_shape(self, indices, dout, dense):
+        validator.check_equal_int(len(indices), 2, "rank of indices", self.name)
+        validator.check("dout columns", dout[-1], "dense columns", dense[-1], Rel.EQ, self.name)
+        return [indices[0]]
+
+    def infer_dtype(self, indices, dout, dense):
+        validator.check_tensor_dtype_valid("indices", indices, (mstype.int32, mstype.int64), self.name)
+        args = {"dout": dout, "dense": dense}
+        validator.check_tensors_dtypes_same_and_valid(args, (mstype.float32,), self.name)
+        return dout
+
+
+class CSRSparseDenseMatmulGrad(PrimitiveWithInfer):
+    """
+    Computes the gradient of the values of CSRSparseDenseMatmul, the inner product of the rows of dout and dense
+    at the position of every entry. The gradient of dense is CSRSparseDenseMatmul with the other `adjoint_st`.
+    """
+
+    @prim_attr_register
+    def __init__(self, adjoint_st=False):
+        """Initialize CSRSparseDenseMatmulGrad"""
+        validator.check_value_type("adjoint_st", adjoint_st, [bool], self.name)
+        self.init_prim_io_names(inputs=['indptr', 'indices', 'dout', 'dense'], outputs=['values_grad'])
+
+    def infer_shape(self, indptr, indices, dout, dense):
+        validator.check_equal_int(len(indices), 1, "rank of indices", self.name)
+        validator.check("dout columns", dout[-1], "dense columns", dense[-1], Rel.EQ, self.name)
+        return indices
+
+    def infer_dtype(self, indptr, indices, dout, dense):
+        validator.check_tensors_dtypes_same_and_valid({"indptr": indptr, "indices": indices},
+                                                      (mstype.int32, mstype.int64), self.name)
+        args = {"dout": dout, "dense": dense}
+        validator.check_tensors_dtypes_same_and_valid(args, (mstype.float32,), self.name)
+        return dout
@@ -18,7 +18,7 @@
 
 """Operators for sparse operators."""
 
-from ..._checkparam import Validator as validator
+from ..._checkparam import Validator as validator, Rel
 from ...common import dtype as mstype
 from ..primitive import PrimitiveWithInfer, prim_attr_register
 
@@ -53,3 +53,114 @@ class SparseToDense(PrimitiveWithInfer):
                'dtype': values['dtype'],
                'value': None}
         return out
+
+
+def _check_sparse_dense_matmul(prim_name, sparse_shape, values, dense, adjoint_st):
+    """Checks the sparse matrix and the dense matrix of a sparse dense matmul, returns the shape of the output."""
+    validator.check_value_type("sparse_shape", sparse_shape, [tuple], prim_name)
+    validator.check_equal_int(len(sparse_shape), 2, "rank of sparse_shape", prim_name)
+    validator.check_equal_int(len(dense['shape']), 2, "rank of dense", prim_name)
+    validator.check_tensors_dtypes_same_and_valid({"values": values['dtype'], "dense": dense['dtype']},
+                                                  (mstype.float32,), prim_name)
+    rows, cols = (sparse_shape[1], sparse_shape[0]) if adjoint_st else sparse_shape
+    validator.check("dense rows", dense['shape'][0], "sparse columns", cols, Rel.EQ, prim_name)
+    return [rows, dense['shape'][1]]
+
+
+class SparseTensorDenseMatmul(PrimitiveWithInfer):
+    """
+    Multiplies a sparse matrix in COO format by a dense matrix, as the aggregation of the graph neural networks.
+
+    Args:
+        adjoint_st (bool): Whether the sparse matrix is transposed before the product. Default: False.
+
+    Inputs:
+        - **indices** (Tensor) - The row and the column of every nonzero entry, of shape :math:`(nnz, 2)`, int32 or
+          int64. The entries can be in any order.
+        - **values** (Tensor) - The values of the entries, of shape :math:`(nnz,)`, float32.
+        - **sparse_shape** (tuple) - The shape :math:`(M, K)` of the sparse matrix.
+        - **dense** (Tensor) - The dense matrix of shape :math:`(K, N)`, or :math:`(M, N)` when `adjoint_st`, float32.
+
+    Outputs:
+        Tensor of shape :math:`(M, N)`, or :math:`(K, N)` when `adjoint_st`.
+
+    Supported Platforms:
+        ``CPU``
+
+    Examples:
+        >>> indices = Tensor([[0, 1], [1, 2]], mindspore.int32)
+        >>> values = Tensor([1, 2], mindspore.float32)
+        >>> dense = Tensor(np.ones((3, 2)), mindspore.float32)
+        >>> output = ops.SparseTensorDenseMatmul()(indices, values, (2, 3), dense)
+        >>> print(output)
+        [[1. 1.]
+         [2. 2.]]
+    """
+
+    @prim_attr_register
+    def __init__(self, adjoint_st=False):
+        """Initialize SparseTensorDenseMatmul"""
+        validator.check_value_type("adjoint_st", adjoint_st, [bool], self.name)
+        self.init_prim_io_names(inputs=['indices', 'values', 'sparse_shape', 'dense'], outputs=['output'])
+
+    def __infer__(self, indices, values, sparse_shape, dense):
+        validator.check_tensor_dtype_valid("indices", indices['dtype'], (mstype.int32, mstype.int64), self.name)
+        validator.check_equal_int(len(indices['shape']), 2, "rank of indices", self.name)
+        validator.check_equal_int(indices['shape'][1], 2, "columns of indices", self.name)
+        validator.check("values length", values['shape'], "indices length", indices['shape'][:1], Rel.EQ, self.name)
+        out_shape = _check_sparse_dense_matmul(self.name, sparse_shape['value'], values, dense, self.adjoint_st)
+        return {'shape': out_shape,
+                'dtype': values['dtype'],
+                'value': None}
+
+
+class CSRSparseDenseMatmul(PrimitiveWithInfer):
+    """
+    Multiplies a sparse matrix in CSR format by a dense matrix, as the aggregation of the graph neural networks.
+
+    Args:
+        adjoint_st (bool): Whether the sparse matrix is transposed before the product. Default: False.
+
+    Inputs:
+        - **indptr** (Tensor) - The entries of the row i are the entries indptr[i] to indptr[i + 1] - 1, of shape
+          :math:`(M + 1,)`, int32 or int64.
+        - **indices** (Tensor) - The column of every entry, of shape :math:`(nnz,)`, with the type of `indptr`.
+        - **values** (Tensor) - The values of the entries, of shape :math:`(nnz,)`, float32.
+        - **sparse_shape** (tuple) - The shape :math:`(M, K)` of the sparse matrix.
+        - **dense** (Tensor) - The dense matrix of shape :math:`(K, N)`, or :math:`(M, N)` when `adjoint_st`, float32.
+
+    Outputs:
+        Tensor of shape :math:`(M, N)`, or :math:`(K, N)` when `adjoint_st`.
+
+    Supported Platforms:
+        ``CPU``
+
+    Examples:
+        >>> indptr = Tensor([0, 1, 2], mindspore.int32)
+        >>> indices = Tensor([1, 2], mindspore.int32)
+        >>> values = Tensor([1, 2], mindspore.float32)
+        >>> dense = Tensor(np.ones((3, 2)), mindspore.float32)
+        >>> output = ops.CSRSparseDenseMatmul()(indptr, indices, values, (2, 3), dense)
+        >>> print(output)
+        [[1. 1.]
+         [2. 2.]]
+    """
+
+    @prim_attr_register
+    def __init__(self, adjoint_st=False):
+        """Initialize CSRSparseDenseMatmul"""
+        validator.check_value_type("adjoint_st", adjoint_st, [bool], self.name)
+        self.init_prim_io_names(inputs=['indptr', 'indices', 'values', 'sparse_shape', 'dense'], outputs=['output'])
+
+    def __infer__(self, indptr, indices, values, sparse_shape, dense):
+        validator.check_tensors_dtypes_same_and_valid({"indptr": indptr['dtype'], "indices": indices['dtype']},
+                                                      (mstype.int32, mstype.int64), self.name)
+        validator.check_equal_int(len(indptr['shape']), 1, "rank of indptr", self.name)
+        validator.check_equal_int(len(indices['shape']), 1, "rank of indices", self.name)
+        validator.check("values shape", values['shape'], "indices shape", indices['shape'], Rel.EQ, self.name)
+        shape = sparse_shape['value']
+        out_shape = _check_sparse_dense_matmul(self.name, shape, values, dense, self.adjoint_st)
+        validator.check("indptr length", indptr['shape'][0], "sparse rows + 1", shape[0] + 1, Rel.EQ, self.name)
+        return {'shape': out_shape,
+                'dtype': values['dtype'],
+                'value': None}
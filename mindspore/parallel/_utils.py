@@ -107,6 +107,32 @@ def _to_full_tensor(elem, device_num, global_rank, scaling_sens=None):
         lst.append(Tensor(scaling_sens, mstype.float32))
     return tuple(lst)
 
+
+def _get_cpu_replica_num():
+    """Get the number of the CPU replicas of a training graph, 1 when the replica mode is off."""
+    if context.get_context("device_target") != "CPU" or context.get_context("mode") != context.GRAPH_MODE:
+        return 1
+    return context.get_context("cpu_replica_num")
+
+
+def _has_optimizer(cell):
+    """Whether a cell updates its weights with an optimizer, only such graphs are split into CPU replicas."""
+    from mindspore.nn.optim.optimizer import Optimizer
+    return any(isinstance(sub_cell, Optimizer) for _, sub_cell in cell.cells_and_names())
+
+
+def _to_replica_tensor(elem, replica_num):
+    """Convert the inputs to the inputs of one CPU replica, the tensors whose first dimension is a multiple of
+       replica_num are split along it and the others are fed to every replica."""
+    lst = []
+    for data in elem:
+        if isinstance(data, Tensor) and data.shape and data.shape[0] % replica_num == 0:
+            shape_ = (data.shape[0] // replica_num,) + tuple(data.shape[1:])
+            data = Tensor(np.zeros(shape_, dtype_to_nptype(data.dtype)))
+        lst.append(data)
+    return tuple(lst)
+
+
 def _get_gradients_mean():
     """Get if using gradients_mean."""
     return auto_parallel_context().get_gradients_mean()
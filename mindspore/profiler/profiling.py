@@ -52,8 +52,10 @@ class Profiler:
     Performance profiling API.
 
     This API enables MindSpore users to profile the performance of neural network.
-    Profiler supports Ascend and GPU, both of them are used in the same way,
-    but only output_path in args works on GPU.
+    Profiler supports Ascend, GPU and CPU, all of them are used in the same way,
+    but only output_path in args works on GPU and CPU. On CPU, the time, input shapes, bytes and
+    estimated FLOPs of each kernel are recorded, and written as an op summary and a Chrome trace
+    timeline.
 
     Args:
         output_path (str): Output data path.
@@ -105,6 +107,15 @@ class Profiler:
 
             if kwargs:
                 logger.warning("Params not be supported yet on GPU.")
+        elif self._device_target and self._device_target == "CPU":
+            from mindspore._c_expression import CPUProfiler
+            self._cpu_profiler = CPUProfiler.get_instance()
+            self._cpu_profiler.init(self._output_path)
+            self._cpu_profiler.step_profiling_enable(True)
+            os.environ['DEVICE_ID'] = str(self._dev_id)
+
+            if kwargs:
+                logger.warning("Params not be supported yet on CPU.")
         elif self._device_target and self._device_target == "Ascend":
             optypes_not_deal = kwargs.pop("optypes_not_deal", "Variable")
             if not isinstance(optypes_not_deal, str):
@@ -193,6 +204,11 @@ class Profiler:
 
             os.environ['PROFILING_MODE'] = str("false")
 
+        elif self._device_target and self._device_target == "CPU":
+            # write the op summary and the timeline of the kernels
+            self._cpu_profiler.stop()
+            os.environ['PROFILING_MODE'] = str("false")
+
         elif self._device_target and self._device_target == "Ascend":
             release()
 
@@ -521,7 +537,7 @@ class Profiler:
             dev_id = "0"
             logger.error("Fail to get DEVICE_ID, use 0 instead.")
 
-        if device_target and device_target not in ["Ascend", "GPU"]:
+        if device_target and device_target not in ["Ascend", "GPU", "CPU"]:
             msg = "Profiling: unsupported backend: %s" % device_target
             raise RuntimeError(msg)
 
@@ -0,0 +1,91 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import os
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.nn import TrainOneStepCell, WithLossCell
+from mindspore.nn.optim import Momentum
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+rank_id = int(os.getenv("OMPI_COMM_WORLD_RANK", "0"))
+rank_size = int(os.getenv("OMPI_COMM_WORLD_SIZE", "1"))
+
+
+class Net(nn.Cell):
+    def __init__(self):
+        super(Net, self).__init__()
+        self.fc1 = nn.Dense(16, 32, weight_init=Tensor(np.ones([32, 16]).astype(np.float32) * 0.01))
+        self.relu = nn.ReLU()
+        self.fc2 = nn.Dense(32, 10, weight_init=Tensor(np.arange(320).reshape(10, 32).astype(np.float32) * 0.001))
+
+    def construct(self, x):
+        return self.fc2(self.relu(self.fc1(x)))
+
+
+def train(data, label, steps):
+    net = Net()
+    optimizer = Momentum(net.trainable_params(), learning_rate=0.1, momentum=0.9)
+    criterion = nn.SoftmaxCrossEntropyWithLogits(sparse=True, reduction='mean')
+    train_network = TrainOneStepCell(WithLossCell(net, criterion), optimizer)
+    train_network.set_train()
+    for _ in range(steps):
+        train_network(Tensor(data), Tensor(label))
+    return [param.asnumpy() for param in net.trainable_params()]
+
+
+@pytest.mark.parametrize('bucket_size, bucket_num', [(0, 0), (25, 0), (1, 2)])
+def test_cpu_grad_allreduce(bucket_size, bucket_num):
+    """
+    Every rank trains on its slice of the batch, with the averaged gradients they all train the same weights as a
+    single process on the whole batch, whether the gradients are bucketed or not.
+    """
+    np.random.seed(1)
+    data = np.random.randn(8 * rank_size, 16).astype(np.float32)
+    label = np.random.randint(0, 10, 8 * rank_size).astype(np.int32)
+    context.set_context(enable_cpu_grad_allreduce=False)
+    expect = train(data, label, 5)
+    context.set_context(enable_cpu_grad_allreduce=True, cpu_allreduce_bucket_size=bucket_size,
+                        cpu_allreduce_bucket_num=bucket_num)
+    batch = slice(8 * rank_id, 8 * (rank_id + 1))
+    output = train(data[batch], label[batch], 5)
+    context.set_context(enable_cpu_grad_allreduce=False)
+    for expect_param, output_param in zip(expect, output):
+        assert np.allclose(output_param, expect_param, rtol=1e-4, atol=1e-5)
+
+
+@pytest.mark.parametrize('compression', ['fp16', 'bf16'])
+def test_cpu_grad_compression(compression):
+    """
+    The gradients sent in 16 bits and summed in float32 train about the same weights as the uncompressed ones.
+    """
+    np.random.seed(1)
+    data = np.random.randn(8 * rank_size, 16).astype(np.float32)
+    label = np.random.randint(0, 10, 8 * rank_size).astype(np.int32)
+    context.set_context(enable_cpu_grad_allreduce=False)
+    expect = train(data, label, 5)
+    context.set_context(enable_cpu_grad_allreduce=True, cpu_grad_compression=compression,
+                        cpu_grad_compression_threshold=0)
+    batch = slice(8 * rank_id, 8 * (rank_id + 1))
+    output = train(data[batch], label[batch], 5)
+    context.set_context(enable_cpu_grad_allreduce=False, cpu_grad_compression='none')
+    for expect_param, output_param in zip(expect, output):
+        assert np.allclose(output_param, expect_param, rtol=1e-2, atol=1e-3)
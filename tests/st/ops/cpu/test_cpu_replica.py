@@ -0,0 +1,67 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.nn import TrainOneStepCell, WithLossCell
+from mindspore.nn.optim import Momentum
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+
+class Net(nn.Cell):
+    def __init__(self):
+        super(Net, self).__init__()
+        self.fc1 = nn.Dense(16, 32, weight_init=Tensor(np.ones([32, 16]).astype(np.float32) * 0.01))
+        self.relu = nn.ReLU()
+        self.fc2 = nn.Dense(32, 10, weight_init=Tensor(np.arange(320).reshape(10, 32).astype(np.float32) * 0.001))
+
+    def construct(self, x):
+        return self.fc2(self.relu(self.fc1(x)))
+
+
+def train(replica_num, data, label, steps):
+    context.set_context(cpu_replica_num=replica_num)
+    net = Net()
+    optimizer = Momentum(net.trainable_params(), learning_rate=0.1, momentum=0.9)
+    criterion = nn.SoftmaxCrossEntropyWithLogits(sparse=True, reduction='mean')
+    train_network = TrainOneStepCell(WithLossCell(net, criterion), optimizer)
+    train_network.set_train()
+    for _ in range(steps):
+        train_network(Tensor(data), Tensor(label))
+    return [param.asnumpy() for param in net.trainable_params()]
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize('replica_num', [2, 4])
+def test_cpu_replica_train(replica_num):
+    """
+    The replicas average the gradients of their slices of the batch, with a mean loss they train the same weights as
+    a single graph on the whole batch.
+    """
+    np.random.seed(1)
+    data = np.random.randn(32, 16).astype(np.float32)
+    label = np.random.randint(0, 10, 32).astype(np.int32)
+    expect = train(1, data, label, 5)
+    output = train(replica_num, data, label, 5)
+    context.set_context(cpu_replica_num=1)
+    for expect_param, output_param in zip(expect, output):
+        assert np.allclose(output_param, expect_param, rtol=1e-4, atol=1e-5)
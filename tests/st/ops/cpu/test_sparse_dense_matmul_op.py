@@ -0,0 +1,109 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.ops import composite as C
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+
+class CooNet(nn.Cell):
+    def __init__(self, sparse_shape, adjoint_st=False):
+        super(CooNet, self).__init__()
+        self.matmul = P.SparseTensorDenseMatmul(adjoint_st)
+        self.sparse_shape = sparse_shape
+
+    def construct(self, indices, values, dense):
+        return self.matmul(indices, values, self.sparse_shape, dense)
+
+
+class CsrNet(nn.Cell):
+    def __init__(self, sparse_shape, adjoint_st=False):
+        super(CsrNet, self).__init__()
+        self.matmul = P.CSRSparseDenseMatmul(adjoint_st)
+        self.sparse_shape = sparse_shape
+
+    def construct(self, indptr, indices, values, dense):
+        return self.matmul(indptr, indices, values, self.sparse_shape, dense)
+
+
+class GradNet(nn.Cell):
+    def __init__(self, network):
+        super(GradNet, self).__init__()
+        self.grad = C.GradOperation(get_all=True, sens_param=True)
+        self.network = network
+
+    def construct(self, *inputs):
+        return self.grad(self.network)(*inputs)
+
+
+def random_sparse(rows, cols, nnz):
+    np.random.seed(1)
+    positions = np.random.choice(rows * cols, nnz, replace=False)
+    indices = np.stack([positions // cols, positions % cols], axis=1).astype(np.int32)
+    values = np.random.randn(nnz).astype(np.float32)
+    matrix = np.zeros((rows, cols), np.float32)
+    matrix[indices[:, 0], indices[:, 1]] = values
+    return indices, values, matrix
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize('adjoint_st', [False, True])
+def test_sparse_tensor_dense_matmul(adjoint_st):
+    indices, values, matrix = random_sparse(40, 30, 150)
+    sparse = matrix.T if adjoint_st else matrix
+    dense = np.random.randn(sparse.shape[1], 17).astype(np.float32)
+    sens = np.random.randn(sparse.shape[0], 17).astype(np.float32)
+    net = CooNet((40, 30), adjoint_st)
+    output = net(Tensor(indices), Tensor(values), Tensor(dense))
+    assert np.allclose(output.asnumpy(), sparse.dot(dense), rtol=1e-4, atol=1e-4)
+
+    grads = GradNet(net)(Tensor(indices), Tensor(values), Tensor(dense), Tensor(sens))
+    dsparse = sens.dot(dense.T)
+    dsparse = dsparse.T if adjoint_st else dsparse
+    assert np.allclose(grads[1].asnumpy(), dsparse[indices[:, 0], indices[:, 1]], rtol=1e-4, atol=1e-4)
+    assert np.allclose(grads[2].asnumpy(), sparse.T.dot(sens), rtol=1e-4, atol=1e-4)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize('adjoint_st', [False, True])
+def test_csr_sparse_dense_matmul(adjoint_st):
+    indices, values, matrix = random_sparse(25, 33, 120)
+    order = np.lexsort((indices[:, 1], indices[:, 0]))
+    indices, values = indices[order], values[order]
+    indptr = np.searchsorted(indices[:, 0], np.arange(26)).astype(np.int32)
+    sparse = matrix.T if adjoint_st else matrix
+    dense = np.random.randn(sparse.shape[1], 8).astype(np.float32)
+    sens = np.random.randn(sparse.shape[0], 8).astype(np.float32)
+    net = CsrNet((25, 33), adjoint_st)
+    col_indices = Tensor(indices[:, 1].copy())
+    output = net(Tensor(indptr), col_indices, Tensor(values), Tensor(dense))
+    assert np.allclose(output.asnumpy(), sparse.dot(dense), rtol=1e-4, atol=1e-4)
+
+    grads = GradNet(net)(Tensor(indptr), col_indices, Tensor(values), Tensor(dense), Tensor(sens))
+    dsparse = sens.dot(dense.T)
+    dsparse = dsparse.T if adjoint_st else dsparse
+    assert np.allclose(grads[2].asnumpy(), dsparse[indices[:, 0], indices[:, 1]], rtol=1e-4, atol=1e-4)
+    assert np.allclose(grads[3].asnumpy(), sparse.T.dot(sens), rtol=1e-4, atol=1e-4)
@@ -0,0 +1,55 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/heap_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<bool> g_counting{false};
+std::atomic<size_t> g_alloc_num{0};
+
+void *CountedAlloc(size_t size) {
+  if (g_counting.load(std::memory_order_relaxed)) {
+    (void)g_alloc_num.fetch_add(1, std::memory_order_relaxed);
+  }
+  void *ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+}  // namespace
+
+namespace UT {
+void HeapCounter::Start() {
+  g_alloc_num.store(0);
+  g_counting.store(true);
+}
+
+size_t HeapCounter::Stop() {
+  g_counting.store(false);
+  return g_alloc_num.load();
+}
+}  // namespace UT
+
+// The nothrow and the sized variants forward to these ones, the aligned variants are left to the library.
+void *operator new(size_t size) { return CountedAlloc(size); }
+void *operator new[](size_t size) { return CountedAlloc(size); }
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { std::free(ptr); }
@@ -0,0 +1,31 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESTS_UT_COMMON_HEAP_COUNTER_H_
+#define TESTS_UT_COMMON_HEAP_COUNTER_H_
+
+#include <cstddef>
+
+namespace UT {
+// Counts the calls of the global operator new made by all the threads between Start and Stop, the test binary
+// replaces the global operator new to count them.
+class HeapCounter {
+ public:
+  static void Start();
+  // Returns the number of allocations since Start.
+  static size_t Stop();
+};
+}  // namespace UT
+#endif  // TESTS_UT_COMMON_HEAP_COUNTER_H_
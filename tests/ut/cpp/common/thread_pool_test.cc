@@ -0,0 +1,178 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "common/heap_counter.h"
+#include "common/thread_pool.h"
+
+namespace mindspore {
+namespace common {
+class ThreadPoolTest : public UT::Common {
+ public:
+  ThreadPoolTest() = default;
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(ThreadPoolTest, parallel_for_cover_all) {
+  std::vector<int> data(100003, 0);
+  for (size_t grain : {1, 7, 128, 100003}) {
+    ThreadPool::GetInstance().ParallelFor(
+      [&data](size_t start, size_t end) {
+        for (size_t i = start; i < end; ++i) {
+          data[i]++;
+        }
+      },
+      data.size(), grain);
+  }
+  for (auto value : data) {
+    EXPECT_EQ(value, 4);
+  }
+}
+
+TEST_F(ThreadPoolTest, nested_parallel_for) {
+  std::atomic<size_t> total{0};
+  auto &thread_pool = ThreadPool::GetInstance();
+  thread_pool.ParallelFor(
+    [&](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        thread_pool.ParallelFor([&total](size_t inner_start, size_t inner_end) { total += inner_end - inner_start; },
+                                1000, 10);
+      }
+    },
+    64, 1);
+  EXPECT_EQ(total, 64000);
+}
+
+TEST_F(ThreadPoolTest, parallel_for_rethrow_exception) {
+  auto task = [](size_t start, size_t end) {
+    if (start == 0) {
+      throw std::runtime_error("task failed");
+    }
+  };
+  EXPECT_THROW(ThreadPool::GetInstance().ParallelFor(task, 100, 1), std::runtime_error);
+}
+
+// The job of a finished call is reused by the next one, the steady calls do not create any job.
+TEST_F(ThreadPoolTest, parallel_for_reuse_job) {
+  std::vector<int> data(4096, 0);
+  auto task = [&data](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      data[i]++;
+    }
+  };
+  auto &thread_pool = ThreadPool::GetInstance();
+  thread_pool.ParallelFor(task, data.size(), 1);
+  size_t job_num = thread_pool.GetJobNum();
+  // The task is wrapped by reference, so the calls allocate nothing at all, on the caller as on the workers.
+  UT::HeapCounter::Start();
+  for (size_t n = 0; n < 100; ++n) {
+    thread_pool.ParallelFor(std::ref(task), data.size(), 1);
+  }
+  EXPECT_EQ(UT::HeapCounter::Stop(), 0);
+  EXPECT_EQ(thread_pool.GetJobNum(), job_num);
+  for (auto value : data) {
+    EXPECT_EQ(value, 101);
+  }
+}
+
+// A pool set as the current pool of a thread runs the parallel calls of that thread and of its own tasks.
+TEST_F(ThreadPoolTest, current_thread_pool) {
+  auto &process_pool = ThreadPool::GetInstance();
+  ThreadPool pool(std::vector<int>{0, 0, 0});
+  EXPECT_EQ(pool.GetSyncRunThreadNum(), 3);
+  std::atomic<size_t> total{0};
+  std::atomic<size_t> other_pool_num{0};
+  std::thread thread([&]() {
+    ThreadPool::SetCurrentThreadPool(&pool);
+    auto &thread_pool = ThreadPool::GetInstance();
+    thread_pool.ParallelFor(
+      [&](size_t start, size_t end) {
+        for (size_t i = start; i < end; ++i) {
+          auto &inner_pool = ThreadPool::GetInstance();
+          other_pool_num += &inner_pool == &pool ? 0 : 1;
+          inner_pool.ParallelFor([&total](size_t inner_start, size_t inner_end) { total += inner_end - inner_start; },
+                                 100, 10);
+        }
+      },
+      64, 1);
+    other_pool_num += &thread_pool == &pool ? 0 : 1;
+    ThreadPool::SetCurrentThreadPool(nullptr);
+    other_pool_num += &ThreadPool::GetInstance() == &process_pool ? 0 : 1;
+  });
+  thread.join();
+  EXPECT_EQ(total, 6400);
+  EXPECT_EQ(other_pool_num, 0);
+  EXPECT_EQ(&ThreadPool::GetInstance(), &process_pool);
+}
+
+TEST_F(ThreadPoolTest, sync_run) {
+  std::atomic<int> count{0};
+  std::vector<Task> tasks;
+  for (int i = 0; i < 10; ++i) {
+    tasks.emplace_back([&count]() {
+      count++;
+      return SUCCESS;
+    });
+  }
+  EXPECT_TRUE(ThreadPool::GetInstance().SyncRun(tasks));
+  EXPECT_EQ(count, 10);
+}
+
+// Compare the per launch overhead of the thread pool with creating threads on every launch.
+TEST_F(ThreadPoolTest, launch_overhead_benchmark) {
+  const size_t launch_num = 1000;
+  const size_t count = 4096;
+  auto &thread_pool = ThreadPool::GetInstance();
+  size_t thread_num = thread_pool.GetSyncRunThreadNum();
+  std::vector<float> data(count, 1.0);
+  auto task = [&data](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      data[i] = data[i] * 0.5f + 1.0f;
+    }
+  };
+
+  auto spawn_start = std::chrono::steady_clock::now();
+  for (size_t n = 0; n < launch_num; ++n) {
+    std::vector<std::thread> threads;
+    size_t once_compute_size = (count + thread_num - 1) / thread_num;
+    for (size_t start = 0; start < count; start += once_compute_size) {
+      threads.emplace_back(std::thread(task, start, std::min(start + once_compute_size, count)));
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+  auto spawn_end = std::chrono::steady_clock::now();
+
+  for (size_t n = 0; n < launch_num; ++n) {
+    thread_pool.ParallelFor(task, count, count / thread_num + 1);
+  }
+  auto pool_end = std::chrono::steady_clock::now();
+
+  double spawn_cost = std::chrono::duration<double, std::micro>(spawn_end - spawn_start).count() / launch_num;
+  double pool_cost = std::chrono::duration<double, std::micro>(pool_end - spawn_end).count() / launch_num;
+  MS_LOG(INFO) << "Thread num " << thread_num << ", per launch cost: spawn threads " << spawn_cost
+               << " us, thread pool " << pool_cost << " us";
+}
+}  // namespace common
+}  // namespace mindspore
@@ -0,0 +1,176 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/device/cpu/mpi/gradient_compressor.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestGradientCompressor : public UT::Common {
+ public:
+  TestGradientCompressor() {}
+
+  // Compresses the gradients of rank_num ranks and returns their decompressed sum, as the collectives would.
+  std::vector<float> Exchange(const std::vector<std::unique_ptr<GradientCompressor>> &compressors,
+                              const std::vector<std::vector<float>> &grads) {
+    size_t count = grads[0].size();
+    size_t compressed_size = compressors[0]->CompressedSize();
+    std::vector<uint8_t> compressed(compressed_size * grads.size());
+    for (size_t r = 0; r < grads.size(); ++r) {
+      compressors[r]->Compress(grads[r].data(), compressed.data() + r * compressed_size);
+    }
+    std::vector<float> output(count);
+    compressors[0]->Decompress(compressed.data(), grads.size(), output.data());
+    return output;
+  }
+};
+
+TEST_F(TestGradientCompressor, test_create) {
+  EXPECT_EQ(GradientCompressor::Create(kGradCompressionNone, 8, 0.1), nullptr);
+  EXPECT_EQ(GradientCompressor::Create(kGradCompressionFp16, 8, 0.1)->CompressedSize(), 16);
+  EXPECT_EQ(GradientCompressor::Create(kGradCompressionTopK, 100, 0.1)->CompressedSize(), 80);
+  EXPECT_EQ(GradientCompressor::Create(kGradCompressionSign, 100, 0.1)->CompressedSize(), 17);
+  EXPECT_THROW(GradientCompressor::Create("int4", 8, 0.1), std::invalid_argument);
+}
+
+TEST_F(TestGradientCompressor, test_half) {
+  const size_t count = 1000;
+  std::vector<std::vector<float>> grads(2, std::vector<float>(count));
+  for (size_t i = 0; i < count; ++i) {
+    grads[0][i] = static_cast<float>(i) * 0.001f - 0.5f;
+    grads[1][i] = static_cast<float>(i % 17) * 0.25f;
+  }
+  for (auto type : {kGradCompressionFp16, kGradCompressionBf16}) {
+    std::vector<std::unique_ptr<GradientCompressor>> compressors;
+    compressors.push_back(GradientCompressor::Create(type, count, 0));
+    compressors.push_back(GradientCompressor::Create(type, count, 0));
+    auto output = Exchange(compressors, grads);
+    float tolerance = type == kGradCompressionFp16 ? 1e-3 : 1e-2;
+    for (size_t i = 0; i < count; ++i) {
+      float sum = grads[0][i] + grads[1][i];
+      ASSERT_NEAR(output[i], sum, tolerance * (std::fabs(sum) + 1)) << type << " " << i;
+    }
+  }
+}
+
+TEST_F(TestGradientCompressor, test_half_float32_sum) {
+  // 256 + 1 is not a bfloat16, a sum in 16 bits would round back to 256 after every rank.
+  std::vector<std::vector<float>> grads = {{256.0f}, {1.0f}, {1.0f}, {1.0f}};
+  std::vector<std::unique_ptr<GradientCompressor>> compressors;
+  for (size_t r = 0; r < grads.size(); ++r) {
+    compressors.push_back(GradientCompressor::Create(kGradCompressionBf16, 1, 0));
+  }
+  EXPECT_EQ(Exchange(compressors, grads), std::vector<float>{259.0f});
+}
+
+// The reduce-scatter then all-gather of the ranks, with the chunks moved between the ranks as MPI would.
+TEST_F(TestGradientCompressor, test_half_reduce_scatter) {
+  const size_t count = 37;
+  const size_t rank_num = 4;
+  std::vector<std::vector<float>> grads(rank_num, std::vector<float>(count));
+  for (size_t r = 0; r < rank_num; ++r) {
+    for (size_t i = 0; i < count; ++i) {
+      grads[r][i] = static_cast<float>((i * 7 + r * 5) % 13) - 6.0f;
+    }
+  }
+  // 256 + 1 + 1 + 2 is a bfloat16, but a sum in 16 bits rounds 256 + 1 back to 256 and ends at 258.
+  grads[0][count - 1] = 256.0f;
+  grads[1][count - 1] = 1.0f;
+  grads[2][count - 1] = 1.0f;
+  grads[3][count - 1] = 2.0f;
+  HalfCompressor compressor(count, true);
+  size_t chunk_count = compressor.ChunkCount(rank_num);
+  ASSERT_EQ(chunk_count, 10);
+  std::vector<std::vector<uint16_t>> chunks(rank_num, std::vector<uint16_t>(chunk_count * rank_num));
+  for (size_t r = 0; r < rank_num; ++r) {
+    compressor.CompressChunks(grads[r].data(), rank_num, chunks[r].data());
+  }
+  std::vector<uint16_t> reduced(chunk_count * rank_num);
+  for (size_t r = 0; r < rank_num; ++r) {
+    std::vector<uint16_t> received;
+    for (size_t peer = 0; peer < rank_num; ++peer) {
+      received.insert(received.end(), chunks[peer].begin() + r * chunk_count,
+                      chunks[peer].begin() + (r + 1) * chunk_count);
+    }
+    compressor.ReduceChunk(received.data(), rank_num, reduced.data() + r * chunk_count);
+  }
+  std::vector<float> output(count);
+  compressor.DecompressReduced(reduced.data(), output.data());
+  for (size_t i = 0; i < count; ++i) {
+    float sum = 0;
+    for (size_t r = 0; r < rank_num; ++r) {
+      sum += grads[r][i];
+    }
+    ASSERT_EQ(output[i], sum) << i;
+  }
+}
+
+TEST_F(TestGradientCompressor, test_topk_error_feedback) {
+  const size_t count = 50;
+  std::vector<std::vector<float>> grads(2, std::vector<float>(count));
+  for (size_t i = 0; i < count; ++i) {
+    grads[0][i] = static_cast<float>(i);
+    grads[1][i] = -0.5f * static_cast<float>(count - i);
+  }
+  std::vector<std::unique_ptr<GradientCompressor>> compressors;
+  compressors.push_back(GradientCompressor::Create(kGradCompressionTopK, count, 0.1));
+  compressors.push_back(GradientCompressor::Create(kGradCompressionTopK, count, 0.1));
+  // The first step sends the 5 largest magnitudes of each rank.
+  auto output = Exchange(compressors, grads);
+  for (size_t i = 0; i < count; ++i) {
+    float expect = (i >= 45 ? grads[0][i] : 0) + (i < 5 ? grads[1][i] : 0);
+    ASSERT_EQ(output[i], expect) << i;
+  }
+  // What is not sent is kept, after enough steps the total sent lags behind the total by the residuals only.
+  std::vector<float> total = output;
+  const size_t steps = 200;
+  for (size_t step = 1; step < steps; ++step) {
+    output = Exchange(compressors, grads);
+    for (size_t i = 0; i < count; ++i) {
+      total[i] += output[i];
+    }
+  }
+  float error = 0;
+  float norm = 0;
+  for (size_t i = 0; i < count; ++i) {
+    float expect = steps * (grads[0][i] + grads[1][i]);
+    error += std::fabs(total[i] - expect);
+    norm += std::fabs(expect);
+  }
+  EXPECT_LT(error / norm, 0.05);
+}
+
+TEST_F(TestGradientCompressor, test_sign) {
+  const size_t count = 13;
+  std::vector<std::vector<float>> grads(1, std::vector<float>(count));
+  for (size_t i = 0; i < count; ++i) {
+    grads[0][i] = i % 2 == 0 ? 1.0f : -3.0f;
+  }
+  std::vector<std::unique_ptr<GradientCompressor>> compressors;
+  compressors.push_back(GradientCompressor::Create(kGradCompressionSign, count, 0));
+  // The signs are scaled by the mean magnitude, (7 * 1 + 6 * 3) / 13.
+  auto output = Exchange(compressors, grads);
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_FLOAT_EQ(output[i], (i % 2 == 0 ? 1.0f : -1.0f) * 25.0f / 13);
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,202 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "common/heap_counter.h"
+#include "abstract/abstract_value.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "backend/session/kernel_graph.h"
+#include "common/thread_pool.h"
+#include "runtime/device/cpu/cpu_device_address.h"
+#define private public
+#include "runtime/device/cpu/cpu_kernel_runtime.h"
+#undef private
+#include "runtime/device/kernel_info.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr size_t kBlockFloatNum = 16;
+constexpr size_t kBlockSize = kBlockFloatNum * sizeof(float);
+
+// Records when it was launched on a clock shared by all the kernels of the graph.
+class FakeKernelMod : public kernel::KernelMod {
+ public:
+  FakeKernelMod(std::atomic<size_t> *clock, size_t sleep_ms) : clock_(clock), sleep_ms_(sleep_ms) {}
+  ~FakeKernelMod() override = default;
+
+  const std::vector<size_t> &GetInputSizeList() const override { return size_list_; }
+  const std::vector<size_t> &GetOutputSizeList() const override { return size_list_; }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+  bool Launch(const std::vector<kernel::AddressPtr> &, const std::vector<kernel::AddressPtr> &,
+              const std::vector<kernel::AddressPtr> &, void *) override {
+    start_ = (*clock_)++;
+    std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms_));
+    end_ = (*clock_)++;
+    return true;
+  }
+
+  size_t start_{0};
+  size_t end_{0};
+
+ private:
+  std::atomic<size_t> *clock_;
+  size_t sleep_ms_;
+  std::vector<size_t> size_list_{kBlockSize};
+  std::vector<size_t> workspace_size_list_;
+};
+using FakeKernelModPtr = std::shared_ptr<FakeKernelMod>;
+}  // namespace
+
+class TestCPUKernelRuntime : public UT::Common {
+ public:
+  TestCPUKernelRuntime() {}
+
+  void SetUp() override {
+    auto context_ptr = MsContext::GetInstance();
+    inter_op_parallel_ = context_ptr->get_param<bool>(MS_CTX_ENABLE_INTER_OP_PARALLEL);
+    context_ptr->set_param<bool>(MS_CTX_ENABLE_INTER_OP_PARALLEL, true);
+    kernel_graph_ = std::make_shared<session::KernelGraph>();
+    memory_.assign(kBlockFloatNum * 8, 0);
+    input_ = kernel_graph_->add_parameter();
+    input_->set_abstract(NewAbstract());
+    input_->set_kernel_info(std::make_shared<KernelInfo>());
+    AnfAlgo::SetOutputAddr(std::make_shared<CPUDeviceAddress>(Block(7), kBlockSize), 0, input_.get());
+  }
+
+  void TearDown() override {
+    MsContext::GetInstance()->set_param<bool>(MS_CTX_ENABLE_INTER_OP_PARALLEL, inter_op_parallel_);
+  }
+
+  static abstract::AbstractBasePtr NewAbstract() {
+    return std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{kBlockFloatNum});
+  }
+
+  void *Block(size_t index) { return memory_.data() + index * kBlockFloatNum; }
+
+  // A kernel writing the block of memory given by block_index, blocks shared by several kernels emulate memory reuse.
+  CNodePtr NewKernel(const std::vector<AnfNodePtr> &inputs, size_t block_index, size_t sleep_ms) {
+    std::vector<AnfNodePtr> node_inputs{NewValueNode(std::make_shared<Primitive>("FakeKernel"))};
+    node_inputs.insert(node_inputs.end(), inputs.begin(), inputs.end());
+    auto kernel = kernel_graph_->NewCNode(node_inputs);
+    kernel->set_abstract(NewAbstract());
+    kernel->set_kernel_info(std::make_shared<KernelInfo>());
+    auto kernel_mod = std::make_shared<FakeKernelMod>(&clock_, sleep_ms);
+    AnfAlgo::SetKernelMod(kernel_mod, kernel.get());
+    AnfAlgo::SetOutputAddr(std::make_shared<CPUDeviceAddress>(Block(block_index), kBlockSize), 0, kernel.get());
+    kernel_mods_.push_back(kernel_mod);
+    kernels_.push_back(kernel);
+    return kernel;
+  }
+
+  void BuildGraph() {
+    kernel_graph_->set_output(kernels_.back());
+    kernel_graph_->set_execution_order(kernels_);
+  }
+
+  const FakeKernelMod &Mod(size_t index) { return *kernel_mods_[index]; }
+
+  std::shared_ptr<session::KernelGraph> kernel_graph_;
+  ParameterPtr input_;
+  std::vector<float> memory_;
+  std::atomic<size_t> clock_{0};
+  std::vector<CNodePtr> kernels_;
+  std::vector<FakeKernelModPtr> kernel_mods_;
+  bool inter_op_parallel_{false};
+};
+
+TEST_F(TestCPUKernelRuntime, test_parallel_kernel_dag) {
+  auto x = NewKernel({input_}, 0, 50);
+  auto y = NewKernel({x}, 1, 50);
+  // z reuses the memory of x, so it waits for y reading x (WAR) after x writing it (WAW).
+  auto z = NewKernel({input_}, 0, 0);
+  // v overwrites w which nobody reads, the write after write is its only dependency.
+  (void)NewKernel({input_}, 2, 50);
+  auto v = NewKernel({input_}, 2, 0);
+  (void)NewKernel({y, z, v}, 3, 0);
+  BuildGraph();
+
+  CPUKernelRuntime runtime;
+  ASSERT_TRUE(runtime.Init());
+  // The second step runs on the dag kept from the first one.
+  for (size_t step = 0; step < 2; ++step) {
+    ASSERT_TRUE(runtime.Run(kernel_graph_.get(), false));
+    // read after write
+    EXPECT_LT(Mod(0).end_, Mod(1).start_);
+    // write after read
+    EXPECT_LT(Mod(1).end_, Mod(2).start_);
+    // write after write
+    EXPECT_LT(Mod(0).end_, Mod(2).start_);
+    EXPECT_LT(Mod(3).end_, Mod(4).start_);
+    for (size_t i = 0; i + 1 < kernel_mods_.size(); ++i) {
+      EXPECT_LT(Mod(i).end_, Mod(5).start_);
+    }
+  }
+}
+
+TEST_F(TestCPUKernelRuntime, test_parallel_step_without_allocation) {
+  auto x = NewKernel({input_}, 0, 0);
+  auto y = NewKernel({input_}, 1, 0);
+  (void)NewKernel({x, y}, 2, 0);
+  BuildGraph();
+
+  CPUKernelRuntime runtime;
+  ASSERT_TRUE(runtime.Init());
+  // The first step builds the launch tape and the dag, the following ones reuse them and the job of the thread pool.
+  ASSERT_TRUE(runtime.Run(kernel_graph_.get(), false));
+  EXPECT_GT(runtime.step_address_alloc_num(), 0);
+  auto &thread_pool = common::ThreadPool::GetInstance();
+  size_t job_num = thread_pool.GetJobNum();
+  size_t ok_num = 0;
+  size_t address_alloc_num = 0;
+  UT::HeapCounter::Start();
+  for (size_t step = 0; step < 10; ++step) {
+    ok_num += runtime.Run(kernel_graph_.get(), false) ? 1 : 0;
+    address_alloc_num += runtime.step_address_alloc_num();
+  }
+  size_t alloc_num = UT::HeapCounter::Stop();
+  EXPECT_EQ(ok_num, 10);
+  EXPECT_EQ(address_alloc_num, 0);
+  EXPECT_EQ(alloc_num, 0);
+  EXPECT_EQ(thread_pool.GetJobNum(), job_num);
+}
+
+TEST_F(TestCPUKernelRuntime, test_clear_graph_runtime_resource) {
+  auto x = NewKernel({input_}, 0, 0);
+  (void)NewKernel({x}, 1, 0);
+  BuildGraph();
+
+  CPUKernelRuntime runtime;
+  ASSERT_TRUE(runtime.Init());
+  ASSERT_TRUE(runtime.Run(kernel_graph_.get(), false));
+  auto graph_id = kernel_graph_->graph_id();
+  EXPECT_EQ(runtime.launch_tapes_.count(graph_id), 1);
+  EXPECT_EQ(runtime.kernel_dags_.count(graph_id), 1);
+  // The dag and the tape hold the kernels and their addresses, they go with the graph.
+  runtime.ClearGraphRuntimeResource(graph_id, kernel_graph_->inputs(), kernel_graph_->graph_value_nodes(),
+                                    kernel_graph_->execution_order());
+  EXPECT_EQ(runtime.launch_tapes_.count(graph_id), 0);
+  EXPECT_EQ(runtime.kernel_dags_.count(graph_id), 0);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,119 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#include "profiler/device/cpu/cpu_profiling.h"
+#undef private
+
+namespace mindspore {
+namespace profiler {
+namespace cpu {
+class TestCPUProfiling : public UT::Common {
+ public:
+  TestCPUProfiling() {}
+};
+
+TEST_F(TestCPUProfiling, test_event_ring_drop_and_drain) {
+  KernelEventRing ring(0, 5);
+  KernelEvent event;
+  size_t pushed = 0;
+  for (size_t i = 0; i < 10; ++i) {
+    event.start_time_stamp = i;
+    pushed += ring.Push(event) ? 1 : 0;
+  }
+  // The capacity is rounded up to a power of two.
+  EXPECT_EQ(pushed, 8);
+  EXPECT_EQ(ring.dropped_num(), 2);
+  std::vector<KernelEvent> events;
+  EXPECT_EQ(ring.Drain(&events), 8);
+  ASSERT_EQ(events.size(), 8);
+  EXPECT_EQ(events[7].start_time_stamp, 7);
+  EXPECT_TRUE(ring.Push(event));
+  EXPECT_EQ(ring.Drain(&events), 1);
+  EXPECT_EQ(events.back().start_time_stamp, 9);
+}
+
+TEST_F(TestCPUProfiling, test_event_ring_concurrent_drain) {
+  const size_t event_num = 20000;
+  KernelEventRing ring(0, 64);
+  std::thread producer([&ring, event_num]() {
+    KernelEvent event;
+    for (size_t i = 0; i < event_num; ++i) {
+      event.start_time_stamp = i;
+      while (!ring.Push(event)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  std::vector<KernelEvent> events;
+  while (events.size() < event_num) {
+    if (ring.Drain(&events) == 0) {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  for (size_t i = 0; i < event_num; ++i) {
+    ASSERT_EQ(events[i].start_time_stamp, i);
+  }
+}
+
+TEST_F(TestCPUProfiling, test_reuse_ring_of_exited_thread) {
+  auto profiler = CPUProfiler::GetInstance();
+  // One ring per thread recording at the same time, the threads started step after step take the same ring.
+  std::thread([&profiler]() { profiler->RecordKernel(nullptr, CPUProfiler::GetHostTimeStamp(), 0); }).join();
+  size_t ring_num = profiler->rings_.size();
+  for (size_t step = 0; step < 3; ++step) {
+    // The two threads of a step hold their rings at the same time.
+    std::atomic<size_t> recorded_num{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 2; ++i) {
+      threads.emplace_back([&profiler, &recorded_num]() {
+        profiler->RecordKernel(nullptr, CPUProfiler::GetHostTimeStamp(), 0);
+        (void)recorded_num.fetch_add(1);
+        while (recorded_num.load() < 2) {
+          std::this_thread::yield();
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+  EXPECT_EQ(profiler->rings_.size(), std::max<size_t>(ring_num, 2));
+  EXPECT_EQ(profiler->free_rings_.size(), profiler->rings_.size());
+  // The events of the exited threads stay in their rings, 1 + 3 * 2 of them.
+  std::vector<KernelEvent> events;
+  for (auto &ring : profiler->rings_) {
+    (void)ring->Drain(&events);
+  }
+  EXPECT_EQ(events.size(), 7);
+}
+
+TEST_F(TestCPUProfiling, test_estimate_flops) {
+  EXPECT_EQ(CPUProfiler::EstimateFlops("MatMul", {{16, 32}, {32, 8}}, {{16, 8}}, false), 2 * 16 * 8 * 32);
+  EXPECT_EQ(CPUProfiler::EstimateFlops("MatMul", {{32, 16}, {32, 8}}, {{16, 8}}, true), 2 * 16 * 8 * 32);
+  EXPECT_EQ(CPUProfiler::EstimateFlops("Conv2D", {{1, 3, 8, 8}, {4, 3, 3, 3}}, {{1, 4, 6, 6}}, false),
+            2 * 4 * 6 * 6 * 3 * 3 * 3);
+  EXPECT_EQ(CPUProfiler::EstimateFlops("ReduceSum", {{4, 100}}, {{4}}, false), 400);
+  EXPECT_EQ(CPUProfiler::EstimateFlops("TensorAdd", {{4, 100}, {100}}, {{4, 100}}, false), 400);
+}
+}  // namespace cpu
+}  // namespace profiler
+}  // namespace mindspore
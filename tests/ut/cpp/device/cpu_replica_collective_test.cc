@@ -0,0 +1,128 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <set>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/device/cpu/replica_collective.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestCPUReplicaCollective : public UT::Common {
+ public:
+  TestCPUReplicaCollective() {}
+
+  // Runs replica_num threads, the replica i runs func(i).
+  void RunReplicas(size_t replica_num, const std::function<void(size_t)> &func) {
+    ReplicaCollective::GetInstance().Reset(replica_num);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < replica_num; ++i) {
+      threads.emplace_back(func, i);
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+};
+
+TEST_F(TestCPUReplicaCollective, test_all_reduce) {
+  const size_t replica_num = 3;
+  for (size_t count : {1, 37, 100000}) {
+    std::vector<std::vector<float>> inputs(replica_num, std::vector<float>(count));
+    std::vector<std::vector<float>> sum_outputs(replica_num, std::vector<float>(count, -1));
+    std::vector<std::vector<float>> mean_outputs(replica_num, std::vector<float>(count, -1));
+    for (size_t r = 0; r < replica_num; ++r) {
+      for (size_t i = 0; i < count; ++i) {
+        inputs[r][i] = static_cast<float>((i * 7 + r * 5) % 13);
+      }
+    }
+    RunReplicas(replica_num, [&](size_t r) {
+      auto &collective = ReplicaCollective::GetInstance();
+      collective.AllReduce(r, inputs[r].data(), sum_outputs[r].data(), count, false);
+      collective.AllReduce(r, inputs[r].data(), mean_outputs[r].data(), count, true);
+    });
+    for (size_t r = 0; r < replica_num; ++r) {
+      for (size_t i = 0; i < count; ++i) {
+        float sum = inputs[0][i] + inputs[1][i] + inputs[2][i];
+        ASSERT_EQ(sum_outputs[r][i], sum);
+        ASSERT_EQ(mean_outputs[r][i], mean_outputs[0][i]);
+        ASSERT_FLOAT_EQ(mean_outputs[r][i], sum / replica_num);
+      }
+    }
+  }
+}
+
+TEST_F(TestCPUReplicaCollective, test_count_mismatch) {
+  const size_t replica_num = 2;
+  std::vector<float> input(8, 1);
+  std::vector<std::vector<float>> outputs(replica_num, std::vector<float>(8));
+  std::atomic<size_t> failed_num{0};
+  RunReplicas(replica_num, [&](size_t r) {
+    try {
+      ReplicaCollective::GetInstance().AllReduce(r, input.data(), outputs[r].data(), 4 + r, false);
+    } catch (std::exception &) {
+      ++failed_num;
+    }
+  });
+  EXPECT_EQ(failed_num, replica_num);
+}
+
+TEST_F(TestCPUReplicaCollective, test_abort) {
+  const size_t replica_num = 3;
+  std::vector<float> input(8, 1);
+  std::vector<std::vector<float>> outputs(replica_num, std::vector<float>(8));
+  std::atomic<size_t> failed_num{0};
+  // The last replica fails before the collective, the others must not wait forever.
+  RunReplicas(replica_num, [&](size_t r) {
+    auto &collective = ReplicaCollective::GetInstance();
+    if (r == replica_num - 1) {
+      collective.Abort();
+      return;
+    }
+    try {
+      collective.AllReduce(r, input.data(), outputs[r].data(), input.size(), false);
+    } catch (std::exception &) {
+      ++failed_num;
+    }
+  });
+  EXPECT_EQ(failed_num, replica_num - 1);
+}
+
+TEST_F(TestCPUReplicaCollective, test_replica_cores) {
+  size_t core_num = std::max(std::thread::hardware_concurrency(), 1U);
+  for (size_t replica_num : {1, 2, 3, 5}) {
+    std::set<int> used_cores;
+    size_t used_num = 0;
+    for (size_t r = 0; r < replica_num; ++r) {
+      auto cores = GetReplicaCores(r, replica_num);
+      ASSERT_FALSE(cores.empty());
+      used_num += cores.size();
+      used_cores.insert(cores.begin(), cores.end());
+    }
+    // Two replicas go to two nodes, or split the cores of a single one.
+    if (replica_num == 2 && core_num >= 2) {
+      EXPECT_EQ(used_cores.size(), used_num);
+    }
+  }
+  EXPECT_ANY_THROW(GetReplicaCores(2, 2));
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
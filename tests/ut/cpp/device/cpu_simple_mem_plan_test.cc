@@ -0,0 +1,74 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/device/cpu/cpu_simple_mem_plan.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestCPUSimpleMemPlan : public UT::Common {
+ public:
+  TestCPUSimpleMemPlan() {}
+
+  static CPUMemBlock MakeBlock(size_t size, size_t first_use, size_t last_use) {
+    CPUMemBlock mem_block;
+    mem_block.size_ = size;
+    mem_block.first_use_ = first_use;
+    mem_block.last_use_ = last_use;
+    return mem_block;
+  }
+};
+
+TEST_F(TestCPUSimpleMemPlan, test_pack_disjoint_lifetimes) {
+  // The lifetimes never overlap, every block reuses the offset 0 and the total is the biggest aligned block.
+  std::vector<CPUMemBlock> mem_blocks = {MakeBlock(100, 0, 1), MakeBlock(256, 2, 3), MakeBlock(10, 4, 5)};
+  EXPECT_EQ(CPUSimpleMemPlan::PackMemBlocks(&mem_blocks), 256);
+  for (const auto &mem_block : mem_blocks) {
+    EXPECT_EQ(mem_block.offset_, 0);
+  }
+}
+
+TEST_F(TestCPUSimpleMemPlan, test_pack_overlapped_lifetimes) {
+  // All the blocks are alive at kernel 2, they are laid out one after another, biggest first, 64 bytes aligned.
+  std::vector<CPUMemBlock> mem_blocks = {MakeBlock(100, 0, 2), MakeBlock(256, 1, 3), MakeBlock(10, 2, 2)};
+  EXPECT_EQ(CPUSimpleMemPlan::PackMemBlocks(&mem_blocks), 256 + 128 + 64);
+  EXPECT_EQ(mem_blocks[1].offset_, 0);
+  EXPECT_EQ(mem_blocks[0].offset_, 256);
+  EXPECT_EQ(mem_blocks[2].offset_, 256 + 128);
+}
+
+TEST_F(TestCPUSimpleMemPlan, test_pack_fills_gap) {
+  // The block 2 dies together with the block 1 but is not alive with the block 0, so it fills the gap below the block 1.
+  std::vector<CPUMemBlock> mem_blocks = {MakeBlock(512, 0, 1), MakeBlock(256, 0, 3), MakeBlock(128, 2, 3)};
+  EXPECT_EQ(CPUSimpleMemPlan::PackMemBlocks(&mem_blocks), 512 + 256);
+  EXPECT_EQ(mem_blocks[0].offset_, 0);
+  EXPECT_EQ(mem_blocks[1].offset_, 512);
+  EXPECT_EQ(mem_blocks[2].offset_, 0);
+  // No two blocks alive at the same time overlap in memory.
+  for (size_t i = 0; i < mem_blocks.size(); ++i) {
+    for (size_t j = i + 1; j < mem_blocks.size(); ++j) {
+      const auto &lhs = mem_blocks[i];
+      const auto &rhs = mem_blocks[j];
+      if (lhs.first_use_ <= rhs.last_use_ && rhs.first_use_ <= lhs.last_use_) {
+        EXPECT_TRUE(lhs.offset_ + lhs.size_ <= rhs.offset_ || rhs.offset_ + rhs.size_ <= lhs.offset_);
+      }
+    }
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,239 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "common/heap_counter.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/arithmetic_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+class ArithmeticCpuKernelTest : public UT::Common {
+ public:
+  ArithmeticCpuKernelTest() : arithmetic_(std::make_shared<ArithmeticCPUKernel>()) {}
+
+  void SetUp() override {
+    inputs_.clear();
+    workspace_.clear();
+    outputs_.clear();
+  }
+
+  AddressPtr CreateKernelAddress(void *addr, size_t size) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = addr;
+    kernel_addr->size = size;
+    return kernel_addr;
+  }
+
+  void InitKernel(OperateType operate_type, TypeId dtype, TypeId target_dtype, const std::vector<size_t> &shape0,
+                  const std::vector<size_t> &shape1, const std::vector<size_t> &output_shape) {
+    arithmetic_->operate_type_ = operate_type;
+    arithmetic_->dtype_ = dtype;
+    arithmetic_->target_dtype_ = target_dtype;
+    arithmetic_->input_shape0_ = shape0;
+    arithmetic_->input_shape1_ = shape1;
+    arithmetic_->output_shape_ = output_shape;
+    arithmetic_->base_iter_ = std::make_shared<BroadcastIterator>(shape0, shape1, output_shape);
+  }
+
+  // Reference result computed with plain row-major index arithmetic.
+  template <typename T, typename Op>
+  std::vector<T> Reference(const std::vector<T> &x, const std::vector<size_t> &shape0, const std::vector<T> &y,
+                           const std::vector<size_t> &shape1, const std::vector<size_t> &output_shape, Op op) {
+    size_t rank = output_shape.size();
+    std::vector<size_t> s0(rank - shape0.size(), 1);
+    s0.insert(s0.end(), shape0.begin(), shape0.end());
+    std::vector<size_t> s1(rank - shape1.size(), 1);
+    s1.insert(s1.end(), shape1.begin(), shape1.end());
+    size_t total = 1;
+    for (auto dim : output_shape) {
+      total *= dim;
+    }
+    std::vector<T> result(total);
+    for (size_t pos = 0; pos < total; ++pos) {
+      size_t rest = pos;
+      size_t idx0 = 0;
+      size_t idx1 = 0;
+      size_t stride_out = total;
+      size_t stride0 = x.size();
+      size_t stride1 = y.size();
+      for (size_t i = 0; i < rank; ++i) {
+        stride_out /= output_shape[i];
+        stride0 /= s0[i];
+        stride1 /= s1[i];
+        size_t coord = rest / stride_out;
+        rest %= stride_out;
+        idx0 += (s0[i] == 1 ? 0 : coord) * stride0;
+        idx1 += (s1[i] == 1 ? 0 : coord) * stride1;
+      }
+      result[pos] = op(x[idx0], y[idx1]);
+    }
+    return result;
+  }
+
+  std::vector<AddressPtr> inputs_;
+  std::vector<AddressPtr> workspace_;
+  std::vector<AddressPtr> outputs_;
+  std::shared_ptr<ArithmeticCPUKernel> arithmetic_;
+};
+
+TEST_F(ArithmeticCpuKernelTest, broadcast_iterator_test) {
+  BroadcastIterator iter({3, 1}, {4}, {2, 3, 4});
+  std::vector<size_t> pos_a;
+  std::vector<size_t> pos_b;
+  iter.SetPos(0);
+  for (size_t i = 0; i < 24; ++i) {
+    pos_a.push_back(iter.GetInputPosA());
+    pos_b.push_back(iter.GetInputPosB());
+    iter.GenNextPos();
+  }
+  for (size_t i = 0; i < 24; ++i) {
+    EXPECT_EQ(pos_a[i], (i / 4) % 3);
+    EXPECT_EQ(pos_b[i], i % 4);
+  }
+  for (size_t start = 0; start < 24; ++start) {
+    iter.SetPos(start);
+    EXPECT_EQ(iter.GetInputPosA(), pos_a[start]);
+    EXPECT_EQ(iter.GetInputPosB(), pos_b[start]);
+  }
+}
+
+TEST_F(ArithmeticCpuKernelTest, add_float_broadcast_test) {
+  std::vector<std::vector<std::vector<size_t>>> cases = {{{8, 1031}, {8, 1031}, {8, 1031}},
+                                                         {{8, 1031}, {1}, {8, 1031}},
+                                                         {{1}, {8, 1031}, {8, 1031}},
+                                                         {{8, 1031}, {1031}, {8, 1031}},
+                                                         {{8, 1031}, {8, 1}, {8, 1031}},
+                                                         {{4, 1, 37, 5}, {3, 1, 5}, {4, 3, 37, 5}}};
+  for (auto &shapes : cases) {
+    SetUp();
+    size_t num0 = 1;
+    size_t num1 = 1;
+    size_t num_out = 1;
+    for (auto dim : shapes[0]) num0 *= dim;
+    for (auto dim : shapes[1]) num1 *= dim;
+    for (auto dim : shapes[2]) num_out *= dim;
+    std::vector<float> x(num0);
+    std::vector<float> y(num1);
+    std::vector<float> out(num_out);
+    for (size_t i = 0; i < num0; ++i) x[i] = 0.5f * i;
+    for (size_t i = 0; i < num1; ++i) y[i] = 1.0f - 0.25f * i;
+    InitKernel(ADD, kNumberTypeFloat32, kNumberTypeFloat32, shapes[0], shapes[1], shapes[2]);
+    inputs_.push_back(CreateKernelAddress(x.data(), num0 * sizeof(float)));
+    inputs_.push_back(CreateKernelAddress(y.data(), num1 * sizeof(float)));
+    outputs_.push_back(CreateKernelAddress(out.data(), num_out * sizeof(float)));
+    arithmetic_->Launch(inputs_, workspace_, outputs_);
+    auto expect = Reference(x, shapes[0], y, shapes[1], shapes[2], [](float a, float b) { return a + b; });
+    for (size_t i = 0; i < num_out; ++i) {
+      EXPECT_FLOAT_EQ(out[i], expect[i]);
+    }
+  }
+}
+
+TEST_F(ArithmeticCpuKernelTest, sub_int32_row_broadcast_test) {
+  std::vector<size_t> shape0 = {33, 77};
+  std::vector<size_t> shape1 = {77};
+  std::vector<int32_t> x(33 * 77);
+  std::vector<int32_t> y(77);
+  std::vector<int32_t> out(33 * 77);
+  for (size_t i = 0; i < x.size(); ++i) x[i] = static_cast<int32_t>(i * 3);
+  for (size_t i = 0; i < y.size(); ++i) y[i] = static_cast<int32_t>(i * i);
+  InitKernel(SUB, kNumberTypeInt32, kNumberTypeInt32, shape0, shape1, shape0);
+  inputs_.push_back(CreateKernelAddress(x.data(), x.size() * sizeof(int32_t)));
+  inputs_.push_back(CreateKernelAddress(y.data(), y.size() * sizeof(int32_t)));
+  outputs_.push_back(CreateKernelAddress(out.data(), out.size() * sizeof(int32_t)));
+  arithmetic_->Launch(inputs_, workspace_, outputs_);
+  auto expect = Reference(x, shape0, y, shape1, shape0, [](int32_t a, int32_t b) { return a - b; });
+  EXPECT_EQ(out, expect);
+}
+
+TEST_F(ArithmeticCpuKernelTest, squared_difference_float16_test) {
+  std::vector<size_t> shape0 = {5, 43};
+  std::vector<size_t> shape1 = {1};
+  std::vector<float16> x(5 * 43);
+  std::vector<float16> y = {float16(1.5)};
+  std::vector<float16> out(5 * 43);
+  for (size_t i = 0; i < x.size(); ++i) x[i] = float16(0.125 * (i % 17));
+  InitKernel(SQUAREDDIFFERENCE, kNumberTypeFloat16, kNumberTypeFloat16, shape0, shape1, shape0);
+  inputs_.push_back(CreateKernelAddress(x.data(), x.size() * sizeof(float16)));
+  inputs_.push_back(CreateKernelAddress(y.data(), y.size() * sizeof(float16)));
+  outputs_.push_back(CreateKernelAddress(out.data(), out.size() * sizeof(float16)));
+  arithmetic_->Launch(inputs_, workspace_, outputs_);
+  for (size_t i = 0; i < out.size(); ++i) {
+    float diff = static_cast<float>(x[i]) - 1.5f;
+    EXPECT_NEAR(static_cast<float>(out[i]), diff * diff, 1e-3);
+  }
+}
+
+TEST_F(ArithmeticCpuKernelTest, less_broadcast_test) {
+  std::vector<size_t> shape0 = {6, 1, 9};
+  std::vector<size_t> shape1 = {7, 1};
+  std::vector<size_t> output_shape = {6, 7, 9};
+  std::vector<float> x(6 * 9);
+  std::vector<float> y(7);
+  bool out[6 * 7 * 9];
+  for (size_t i = 0; i < x.size(); ++i) x[i] = static_cast<float>(i % 11);
+  for (size_t i = 0; i < y.size(); ++i) y[i] = static_cast<float>(i + 2);
+  InitKernel(LESS, kNumberTypeFloat32, kNumberTypeBool, shape0, shape1, output_shape);
+  inputs_.push_back(CreateKernelAddress(x.data(), x.size() * sizeof(float)));
+  inputs_.push_back(CreateKernelAddress(y.data(), y.size() * sizeof(float)));
+  outputs_.push_back(CreateKernelAddress(out, sizeof(out)));
+  arithmetic_->Launch(inputs_, workspace_, outputs_);
+  auto expect = Reference(x, shape0, y, shape1, output_shape, [](float a, float b) { return a < b ? 1.0f : 0.0f; });
+  for (size_t i = 0; i < expect.size(); ++i) {
+    EXPECT_EQ(out[i], expect[i] == 1.0f);
+  }
+}
+
+TEST_F(ArithmeticCpuKernelTest, steady_launch_without_allocation_test) {
+  std::vector<size_t> shape0 = {4, 1, 37, 5};
+  std::vector<size_t> shape1 = {3, 1, 5};
+  std::vector<size_t> output_shape = {4, 3, 37, 5};
+  std::vector<float> x(4 * 37 * 5, 0.5f);
+  std::vector<float> y(3 * 5, 1.5f);
+  std::vector<float> out(4 * 3 * 37 * 5);
+  bool less_out[4 * 3 * 37 * 5];
+  inputs_.push_back(CreateKernelAddress(x.data(), x.size() * sizeof(float)));
+  inputs_.push_back(CreateKernelAddress(y.data(), y.size() * sizeof(float)));
+  outputs_.push_back(CreateKernelAddress(out.data(), out.size() * sizeof(float)));
+  std::vector<AddressPtr> less_outputs = {CreateKernelAddress(less_out, sizeof(less_out))};
+  auto less = std::make_shared<ArithmeticCPUKernel>();
+  less->operate_type_ = LESS;
+  less->dtype_ = kNumberTypeFloat32;
+  less->target_dtype_ = kNumberTypeBool;
+  less->base_iter_ = std::make_shared<BroadcastIterator>(shape0, shape1, output_shape);
+  InitKernel(MUL, kNumberTypeFloat32, kNumberTypeFloat32, shape0, shape1, output_shape);
+  // The first launches warm up the thread pool, the steady launches after them must not touch the heap.
+  arithmetic_->Launch(inputs_, workspace_, outputs_);
+  less->Launch(inputs_, workspace_, less_outputs);
+  UT::HeapCounter::Start();
+  for (size_t step = 0; step < 10; ++step) {
+    arithmetic_->Launch(inputs_, workspace_, outputs_);
+    less->Launch(inputs_, workspace_, less_outputs);
+  }
+  size_t alloc_num = UT::HeapCounter::Stop();
+  EXPECT_EQ(alloc_num, 0);
+  for (size_t i = 0; i < out.size(); ++i) {
+    EXPECT_FLOAT_EQ(out[i], 0.75f);
+    EXPECT_TRUE(less_out[i]);
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,147 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/dropout_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/dropout_grad_kernel.h"
+#undef private
+#undef protected
+#include "backend/kernel_compiler/cpu/philox_random.h"
+
+namespace mindspore {
+namespace kernel {
+class DropoutCpuKernelTest : public UT::Common {
+ public:
+  DropoutCpuKernelTest() = default;
+
+  void SetUp() override {
+    x_.resize(kSize);
+    for (size_t i = 0; i < kSize; ++i) {
+      x_[i] = static_cast<float>(i % 7) + 1.0f;
+    }
+    dy_.assign(kSize, 3.0f);
+    output_.resize(kSize);
+    dx_.resize(kSize);
+  }
+
+  AddressPtr CreateKernelAddress(void *data, size_t size) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = data;
+    kernel_addr->size = size;
+    return kernel_addr;
+  }
+
+  void InitDropout(DropoutCPUKernel *dropout, bool regenerate_mask) {
+    dropout->dtype_ = kNumberTypeFloat32;
+    dropout->keep_prob_ = kKeepProb;
+    dropout->tensor_size_ = kSize;
+    dropout->regenerate_mask_ = regenerate_mask;
+    dropout->seed_ = kSeed;
+  }
+
+  void InitDropoutGrad(DropoutGradCpuBwdKernel *dropout_grad, bool regenerate_mask) {
+    dropout_grad->dtype_ = kNumberTypeFloat32;
+    dropout_grad->keep_prob_ = kKeepProb;
+    dropout_grad->num_count_ = kSize;
+    dropout_grad->regenerate_mask_ = regenerate_mask;
+  }
+
+  // Launches the dropout and its grad, mask is either the float32 mask or the PhiloxState.
+  void Launch(DropoutCPUKernel *dropout, DropoutGradCpuBwdKernel *dropout_grad, void *mask, size_t mask_size) {
+    std::vector<AddressPtr> workspace;
+    std::vector<AddressPtr> inputs{CreateKernelAddress(x_.data(), kSize * sizeof(float))};
+    std::vector<AddressPtr> outputs{CreateKernelAddress(output_.data(), kSize * sizeof(float)),
+                                    CreateKernelAddress(mask, mask_size)};
+    ASSERT_TRUE(dropout->Launch(inputs, workspace, outputs));
+    inputs = {CreateKernelAddress(dy_.data(), kSize * sizeof(float)), CreateKernelAddress(mask, mask_size)};
+    outputs = {CreateKernelAddress(dx_.data(), kSize * sizeof(float))};
+    ASSERT_TRUE(dropout_grad->Launch(inputs, workspace, outputs));
+  }
+
+  // The kept elements of the output, checking the output and dx are scaled by 1 / keep_prob where kept.
+  std::vector<bool> GetMask() {
+    std::vector<bool> mask(kSize);
+    for (size_t i = 0; i < kSize; ++i) {
+      mask[i] = output_[i] != 0;
+      EXPECT_FLOAT_EQ(output_[i], mask[i] ? x_[i] / kKeepProb : 0);
+      EXPECT_FLOAT_EQ(dx_[i], mask[i] ? dy_[i] / kKeepProb : 0);
+    }
+    return mask;
+  }
+
+  static constexpr size_t kSize = 1000;
+  static constexpr float kKeepProb = 0.8f;
+  static constexpr uint64_t kSeed = 12345;
+  std::vector<float> x_;
+  std::vector<float> dy_;
+  std::vector<float> output_;
+  std::vector<float> dx_;
+};
+
+// The mask regenerated from the seed and the counter is the one the dropout stores.
+TEST_F(DropoutCpuKernelTest, regenerated_mask_test) {
+  DropoutCPUKernel dropout;
+  DropoutGradCpuBwdKernel dropout_grad;
+  InitDropout(&dropout, false);
+  InitDropoutGrad(&dropout_grad, false);
+  std::vector<float> mask(kSize);
+  Launch(&dropout, &dropout_grad, mask.data(), kSize * sizeof(float));
+  auto expect = GetMask();
+  for (size_t i = 0; i < kSize; ++i) {
+    EXPECT_EQ(mask[i], expect[i] ? 1.0f : 0.0f);
+  }
+
+  DropoutCPUKernel regenerating_dropout;
+  DropoutGradCpuBwdKernel regenerating_dropout_grad;
+  InitDropout(&regenerating_dropout, true);
+  InitDropoutGrad(&regenerating_dropout_grad, true);
+  PhiloxState state;
+  Launch(&regenerating_dropout, &regenerating_dropout_grad, &state, sizeof(state));
+  EXPECT_EQ(state.seed, kSeed);
+  EXPECT_EQ(state.counter, 0UL);
+  EXPECT_EQ(GetMask(), expect);
+}
+
+// Each launch draws a new mask from the next counters, its grad follows it.
+TEST_F(DropoutCpuKernelTest, counter_advance_test) {
+  DropoutCPUKernel dropout;
+  DropoutGradCpuBwdKernel dropout_grad;
+  InitDropout(&dropout, true);
+  InitDropoutGrad(&dropout_grad, true);
+  PhiloxState state;
+  Launch(&dropout, &dropout_grad, &state, sizeof(state));
+  auto first_mask = GetMask();
+  Launch(&dropout, &dropout_grad, &state, sizeof(state));
+  EXPECT_EQ(state.counter, (kSize + kPhiloxResultSize - 1) / kPhiloxResultSize);
+  auto second_mask = GetMask();
+  EXPECT_NE(first_mask, second_mask);
+
+  // A grad fed the state of the first launch regenerates its mask after the dropout has moved on.
+  state.counter = 0;
+  std::vector<AddressPtr> workspace;
+  std::vector<AddressPtr> inputs{CreateKernelAddress(dy_.data(), kSize * sizeof(float)),
+                                 CreateKernelAddress(&state, sizeof(state))};
+  std::vector<AddressPtr> outputs{CreateKernelAddress(dx_.data(), kSize * sizeof(float))};
+  ASSERT_TRUE(dropout_grad.Launch(inputs, workspace, outputs));
+  for (size_t i = 0; i < kSize; ++i) {
+    EXPECT_FLOAT_EQ(dx_[i], first_mask[i] ? dy_[i] / kKeepProb : 0);
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/embedding_look_up_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+class EmbeddingLookUpCpuKernelTest : public UT::Common {
+ public:
+  EmbeddingLookUpCpuKernelTest() : embedding_look_up_(std::make_shared<EmbeddingLookUpCPUKernel>()) {}
+
+  AddressPtr CreateKernelAddress(void *addr, size_t size) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = addr;
+    kernel_addr->size = size;
+    return kernel_addr;
+  }
+
+  // Looks up the indices in a table of first_dim rows, the index i - offset of the table holding the value i * 1000.
+  void LookUp(size_t first_dim, size_t row_size, const std::vector<int> &indices, bool dedup) {
+    table_.resize(first_dim * row_size);
+    for (size_t i = 0; i < table_.size(); ++i) {
+      table_[i] = (i / row_size + embedding_look_up_->offset_) * 1000.0f + i % row_size;
+    }
+    output_.assign(indices.size() * row_size, -1.0f);
+    embedding_look_up_->first_dim_size_ = first_dim;
+    embedding_look_up_->outer_dim_size_ = row_size;
+    embedding_look_up_->indices_lens_ = indices.size();
+    embedding_look_up_->dedup_ = dedup;
+    std::vector<AddressPtr> inputs = {CreateKernelAddress(table_.data(), table_.size() * sizeof(float)),
+                                      CreateKernelAddress(const_cast<int *>(indices.data()), indices.size() * 4)};
+    std::vector<AddressPtr> workspace;
+    for (size_t i = 0; dedup && i < 6; ++i) {
+      workspace_.emplace_back(indices.size());
+    }
+    for (auto &buffer : workspace_) {
+      workspace.push_back(CreateKernelAddress(buffer.data(), buffer.size() * sizeof(int64_t)));
+    }
+    std::vector<AddressPtr> outputs = {CreateKernelAddress(output_.data(), output_.size() * sizeof(float))};
+    embedding_look_up_->Launch(inputs, workspace, outputs);
+  }
+
+  void CheckOutput(size_t first_dim, size_t row_size, const std::vector<int> &indices) {
+    auto offset = embedding_look_up_->offset_;
+    for (size_t i = 0; i < indices.size(); ++i) {
+      bool valid = indices[i] >= offset && indices[i] < offset + static_cast<int64_t>(first_dim);
+      for (size_t j = 0; j < row_size; ++j) {
+        float expect = valid ? indices[i] * 1000.0f + j : 0.0f;
+        ASSERT_EQ(output_[i * row_size + j], expect);
+      }
+    }
+  }
+
+  std::vector<float> table_;
+  std::vector<float> output_;
+  std::vector<std::vector<int64_t>> workspace_;
+  std::shared_ptr<EmbeddingLookUpCPUKernel> embedding_look_up_;
+};
+
+TEST_F(EmbeddingLookUpCpuKernelTest, dedup_look_up_test) {
+  // Heavy tail ids, with some of them out of the range of the table.
+  std::vector<int> indices(5000);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    indices[i] = i % 3 == 0 ? static_cast<int>(i % 7) : static_cast<int>((i * 7919) % 130) - 10;
+  }
+  embedding_look_up_->offset_ = 5;
+  LookUp(100, 32, indices, true);
+  CheckOutput(100, 32, indices);
+}
+
+TEST_F(EmbeddingLookUpCpuKernelTest, look_up_odd_row_size_test) {
+  std::vector<int> indices = {3, 0, 9, 3, -1, 12, 7, 7, 1, 2, 5, 6};
+  LookUp(10, 13, indices, false);
+  CheckOutput(10, 13, indices);
+}
+}  // namespace kernel
+}  // namespace mindspore
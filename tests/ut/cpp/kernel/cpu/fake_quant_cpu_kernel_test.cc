@@ -0,0 +1,81 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/fake_quant_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+class FakeQuantCpuKernelTest : public UT::Common {
+ public:
+  FakeQuantCpuKernelTest() : fake_quant_(std::make_shared<FakeQuantCPUKernel>()) {}
+
+  AddressPtr CreateKernelAddress(std::vector<float> *data) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = data->data();
+    kernel_addr->size = data->size() * sizeof(float);
+    return kernel_addr;
+  }
+
+  std::vector<AddressPtr> inputs_;
+  std::vector<AddressPtr> workspace_;
+  std::vector<AddressPtr> outputs_;
+  std::shared_ptr<FakeQuantCPUKernel> fake_quant_;
+};
+
+TEST_F(FakeQuantCpuKernelTest, nudge_range_test) {
+  // The zero point of [-1, 2] is 255 / 3 = 85, the range keeps its scale and moves to the levels around it.
+  auto range = FakeQuantCPUKernel::NudgeRange(-1.0f, 2.0f, 0, 255, false);
+  EXPECT_FLOAT_EQ(range.scale, 3.0f / 255);
+  EXPECT_FLOAT_EQ(range.min, -85 * range.scale);
+  EXPECT_FLOAT_EQ(range.max, 170 * range.scale);
+  // A symmetric range of narrow levels has the zero in the middle.
+  range = FakeQuantCPUKernel::NudgeRange(-0.5f, 2.0f, 1, 255, true);
+  EXPECT_FLOAT_EQ(range.scale, 4.0f / 254);
+  EXPECT_FLOAT_EQ(range.min, -2.0f);
+  EXPECT_FLOAT_EQ(range.max, 2.0f);
+  // A positive range starts at the zero.
+  range = FakeQuantCPUKernel::NudgeRange(0.5f, 6.0f, 0, 255, false);
+  EXPECT_FLOAT_EQ(range.min, 0);
+  EXPECT_FLOAT_EQ(range.max, 5.5f);
+}
+
+// Two channels on the axis 0 of a [2, 3] input, each quantized to 4 levels.
+TEST_F(FakeQuantCpuKernelTest, per_channel_test) {
+  fake_quant_->quant_min_ = 0;
+  fake_quant_->quant_max_ = 3;
+  fake_quant_->data_size_ = 6;
+  fake_quant_->channel_num_ = 2;
+  fake_quant_->inner_size_ = 3;
+  std::vector<float> input = {-1.0f, 0.4f, 5.0f, 0.1f, 0.7f, 0.35f};
+  std::vector<float> input_min = {0, 0};
+  std::vector<float> input_max = {3, 0.3f};
+  std::vector<float> output(6);
+  inputs_ = {CreateKernelAddress(&input), CreateKernelAddress(&input_min), CreateKernelAddress(&input_max)};
+  outputs_ = {CreateKernelAddress(&output)};
+  fake_quant_->Launch(inputs_, workspace_, outputs_);
+  std::vector<float> expect = {0, 0, 3, 0.1f, 0.3f, 0.3f};
+  for (size_t i = 0; i < output.size(); ++i) {
+    EXPECT_FLOAT_EQ(output[i], expect[i]);
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,110 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/fused_elemwise_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+class FusedElemwiseCpuKernelTest : public UT::Common {
+ public:
+  FusedElemwiseCpuKernelTest() : fused_(std::make_shared<FusedElemwiseCPUKernel>()) {}
+
+  AddressPtr CreateKernelAddress(void *addr, size_t size) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = addr;
+    kernel_addr->size = size;
+    return kernel_addr;
+  }
+
+  void InitKernel(const std::vector<std::vector<size_t>> &input_shapes, const std::vector<std::string> &op_names,
+                  const std::vector<int64_t> &op_inputs, const std::vector<size_t> &output_regs,
+                  size_t reduce_axis_num = 0) {
+    fused_->input_num_ = input_shapes.size();
+    fused_->InitProgram(op_names, op_inputs);
+    fused_->output_regs_ = output_regs;
+    fused_->InitInputStrides(input_shapes);
+    if (fused_->has_reduce_) {
+      for (size_t i = fused_->shape_.size() - reduce_axis_num; i < fused_->shape_.size(); ++i) {
+        fused_->reduce_inner_ *= fused_->shape_[i];
+      }
+      fused_->reduce_outer_ = fused_->element_num_ / fused_->reduce_inner_;
+    }
+  }
+
+  std::vector<AddressPtr> inputs_;
+  std::vector<AddressPtr> workspace_;
+  std::vector<AddressPtr> outputs_;
+  std::shared_ptr<FusedElemwiseCPUKernel> fused_;
+};
+
+// relu(x * y + z), y broadcast along the rows and z a scalar, with the intermediate sum as a second output.
+TEST_F(FusedElemwiseCpuKernelTest, mul_add_relu_broadcast_test) {
+  size_t rows = 7;
+  size_t cols = 301;
+  std::vector<float> x(rows * cols);
+  std::vector<float> y(cols);
+  std::vector<float> z = {-3.0f};
+  for (size_t i = 0; i < x.size(); ++i) x[i] = 0.01f * (i % 97);
+  for (size_t i = 0; i < y.size(); ++i) y[i] = 0.5f * (i % 13);
+  InitKernel({{rows, cols}, {cols}, {1}}, {"Mul", "TensorAdd", "ReLU"}, {0, 1, 3, 2, 4, -1}, {5, 4});
+  std::vector<float> out(rows * cols);
+  std::vector<float> sum(rows * cols);
+  inputs_.push_back(CreateKernelAddress(x.data(), x.size() * sizeof(float)));
+  inputs_.push_back(CreateKernelAddress(y.data(), y.size() * sizeof(float)));
+  inputs_.push_back(CreateKernelAddress(z.data(), z.size() * sizeof(float)));
+  outputs_.push_back(CreateKernelAddress(out.data(), out.size() * sizeof(float)));
+  outputs_.push_back(CreateKernelAddress(sum.data(), sum.size() * sizeof(float)));
+  fused_->Launch(inputs_, workspace_, outputs_);
+  for (size_t i = 0; i < rows * cols; ++i) {
+    float expect_sum = x[i] * y[i % cols] + z[0];
+    EXPECT_FLOAT_EQ(sum[i], expect_sum);
+    EXPECT_FLOAT_EQ(out[i], expect_sum > 0 ? expect_sum : 0);
+  }
+}
+
+// mean((x - y)^2) over the last axis, y broadcast along the columns.
+TEST_F(FusedElemwiseCpuKernelTest, squared_difference_mean_test) {
+  size_t rows = 5;
+  size_t cols = 700;
+  std::vector<float> x(rows * cols);
+  std::vector<float> y(rows);
+  for (size_t i = 0; i < x.size(); ++i) x[i] = std::sin(0.1f * i);
+  for (size_t i = 0; i < y.size(); ++i) y[i] = 0.1f * i;
+  InitKernel({{rows, cols}, {rows, 1}}, {"Sub", "Square", "ReduceMean"}, {0, 1, 2, -1, 3, -1}, {4}, 1);
+  std::vector<float> out(rows);
+  inputs_.push_back(CreateKernelAddress(x.data(), x.size() * sizeof(float)));
+  inputs_.push_back(CreateKernelAddress(y.data(), y.size() * sizeof(float)));
+  outputs_.push_back(CreateKernelAddress(out.data(), out.size() * sizeof(float)));
+  fused_->Launch(inputs_, workspace_, outputs_);
+  for (size_t r = 0; r < rows; ++r) {
+    double expect = 0;
+    for (size_t c = 0; c < cols; ++c) {
+      double diff = x[r * cols + c] - y[r];
+      expect += diff * diff;
+    }
+    EXPECT_NEAR(out[r], expect / cols, 1e-4);
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
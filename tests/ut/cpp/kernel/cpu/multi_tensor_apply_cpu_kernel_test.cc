@@ -0,0 +1,143 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/multi_tensor_apply_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+class MultiTensorApplyCpuKernelTest : public UT::Common {
+ public:
+  MultiTensorApplyCpuKernelTest() : apply_(std::make_shared<MultiTensorApplyCPUKernel>()) {}
+
+  AddressPtr CreateKernelAddress(std::vector<float> *data) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = data->data();
+    kernel_addr->size = data->size() * sizeof(float);
+    return kernel_addr;
+  }
+
+  void InitKernel(MultiTensorApplyCPUKernel::OptimizerType optimizer_type, size_t input_num_per_tensor,
+                  const std::vector<size_t> &elem_nums, const std::vector<int64_t> &output_used) {
+    apply_->optimizer_type_ = optimizer_type;
+    apply_->input_num_per_tensor_ = input_num_per_tensor;
+    apply_->elem_nums_ = elem_nums;
+    apply_->output_used_ = output_used;
+    apply_->InitChunks();
+  }
+
+  std::vector<float> Fill(size_t size, float scale) {
+    std::vector<float> data(size);
+    for (size_t i = 0; i < size; ++i) {
+      data[i] = scale * std::sin(0.37f * i + scale);
+    }
+    return data;
+  }
+
+  std::vector<AddressPtr> inputs_;
+  std::vector<AddressPtr> workspace_;
+  std::vector<AddressPtr> outputs_;
+  std::shared_ptr<MultiTensorApplyCPUKernel> apply_;
+};
+
+// Two Adam parameters, the first one spans several chunks.
+TEST_F(MultiTensorApplyCpuKernelTest, adam_test) {
+  std::vector<size_t> elem_nums = {3 * MultiTensorApplyCPUKernel::kChunkSize + 5, 37};
+  InitKernel(MultiTensorApplyCPUKernel::kAdam, 10, elem_nums, {0, 0});
+  std::vector<std::vector<float>> vars, ms, vs, grads, outputs;
+  std::vector<float> beta1_power = {0.9f}, beta2_power = {0.999f}, lr = {0.01f};
+  std::vector<float> beta1 = {0.9f}, beta2 = {0.999f}, epsilon = {1e-8f};
+  for (size_t tensor = 0; tensor < elem_nums.size(); ++tensor) {
+    vars.push_back(Fill(elem_nums[tensor], 1.0f));
+    ms.push_back(Fill(elem_nums[tensor], 0.1f));
+    vs.push_back(std::vector<float>(elem_nums[tensor], 0.01f));
+    grads.push_back(Fill(elem_nums[tensor], 0.5f));
+    outputs.push_back(std::vector<float>(elem_nums[tensor]));
+  }
+  auto expect_vars = vars;
+  auto expect_ms = ms;
+  auto expect_vs = vs;
+  for (size_t tensor = 0; tensor < elem_nums.size(); ++tensor) {
+    for (auto data : {&vars[tensor], &ms[tensor], &vs[tensor], &beta1_power, &beta2_power, &lr, &beta1, &beta2,
+                      &epsilon, &grads[tensor]}) {
+      inputs_.push_back(CreateKernelAddress(data));
+    }
+    outputs_.push_back(CreateKernelAddress(&outputs[tensor]));
+  }
+  apply_->Launch(inputs_, workspace_, outputs_);
+
+  float new_lr = lr[0] * std::sqrt(1.0 - beta2_power[0]) / (1 - beta1_power[0]);
+  for (size_t tensor = 0; tensor < elem_nums.size(); ++tensor) {
+    for (size_t i = 0; i < elem_nums[tensor]; ++i) {
+      float g = grads[tensor][i];
+      float m = expect_ms[tensor][i] + (g - expect_ms[tensor][i]) * (1 - beta1[0]);
+      float v = expect_vs[tensor][i] + (g * g - expect_vs[tensor][i]) * (1 - beta2[0]);
+      float var = expect_vars[tensor][i] - new_lr * m / (std::sqrt(v) + epsilon[0]);
+      EXPECT_FLOAT_EQ(ms[tensor][i], m);
+      EXPECT_FLOAT_EQ(vs[tensor][i], v);
+      EXPECT_FLOAT_EQ(vars[tensor][i], var);
+    }
+  }
+}
+
+// FusedAdamWeightDecay with the updated parameter of the second tensor used as a value.
+TEST_F(MultiTensorApplyCpuKernelTest, fused_adam_weight_decay_test) {
+  std::vector<size_t> elem_nums = {100, MultiTensorApplyCPUKernel::kChunkSize + 1};
+  InitKernel(MultiTensorApplyCPUKernel::kFusedAdamWeightDecay, 11, elem_nums, {0, 1});
+  std::vector<std::vector<float>> params, ms, vs, grads, outputs;
+  std::vector<float> beta1 = {0.9f}, one_sub_beta1 = {0.1f}, beta2 = {0.999f}, one_sub_beta2 = {0.001f};
+  std::vector<float> epsilon = {1e-6f}, lr = {0.001f}, weight_decay = {0.01f};
+  for (size_t tensor = 0; tensor < elem_nums.size(); ++tensor) {
+    params.push_back(Fill(elem_nums[tensor], 2.0f));
+    ms.push_back(Fill(elem_nums[tensor], 0.2f));
+    vs.push_back(std::vector<float>(elem_nums[tensor], 0.04f));
+    grads.push_back(Fill(elem_nums[tensor], 0.3f));
+    outputs.push_back(std::vector<float>(elem_nums[tensor], -1.0f));
+  }
+  auto expect_params = params;
+  auto expect_ms = ms;
+  auto expect_vs = vs;
+  for (size_t tensor = 0; tensor < elem_nums.size(); ++tensor) {
+    for (auto data : {&beta1, &one_sub_beta1, &beta2, &one_sub_beta2, &epsilon, &lr, &params[tensor], &ms[tensor],
+                      &vs[tensor], &grads[tensor], &weight_decay}) {
+      inputs_.push_back(CreateKernelAddress(data));
+    }
+    outputs_.push_back(CreateKernelAddress(&outputs[tensor]));
+  }
+  apply_->Launch(inputs_, workspace_, outputs_);
+
+  for (size_t tensor = 0; tensor < elem_nums.size(); ++tensor) {
+    for (size_t i = 0; i < elem_nums[tensor]; ++i) {
+      float g = grads[tensor][i];
+      float m = beta1[0] * expect_ms[tensor][i] + one_sub_beta1[0] * g;
+      float v = beta2[0] * expect_vs[tensor][i] + one_sub_beta2[0] * g * g;
+      float update = m / (std::sqrt(v) + epsilon[0]) + weight_decay[0] * expect_params[tensor][i];
+      float param = expect_params[tensor][i] - lr[0] * update;
+      EXPECT_FLOAT_EQ(ms[tensor][i], m);
+      EXPECT_FLOAT_EQ(vs[tensor][i], v);
+      EXPECT_FLOAT_EQ(params[tensor][i], param);
+      EXPECT_FLOAT_EQ(outputs[tensor][i], tensor == 1 ? param : -1.0f);
+    }
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
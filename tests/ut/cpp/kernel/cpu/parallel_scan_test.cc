@@ -0,0 +1,88 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/parallel_scan.h"
+
+namespace mindspore {
+namespace kernel {
+class ParallelScanTest : public UT::Common {
+ public:
+  ParallelScanTest() = default;
+
+  // Compares the scan of a [outer, axis, inner] tensor of small integers with the serial scan of every column.
+  template <typename T, typename Op>
+  void CheckScan(size_t outer, size_t axis, size_t inner, bool exclusive, bool reverse) {
+    std::vector<T> input(outer * axis * inner);
+    for (size_t i = 0; i < input.size(); ++i) {
+      input[i] = static_cast<T>(i % 3 + 1);
+    }
+    std::vector<T> expect(input.size());
+    for (size_t i = 0; i < outer; ++i) {
+      for (size_t k = 0; k < inner; ++k) {
+        T total = Op::Identity();
+        for (size_t step = 0; step < axis; ++step) {
+          size_t index = (i * axis + (reverse ? axis - 1 - step : step)) * inner + k;
+          T next = Op::Apply(total, input[index]);
+          expect[index] = exclusive ? total : next;
+          total = next;
+        }
+      }
+    }
+    std::vector<T> output(input.size());
+    ParallelScan<T, Op>(outer, axis, inner, exclusive, reverse).Run(input.data(), output.data());
+    EXPECT_EQ(output, expect);
+  }
+};
+
+TEST_F(ParallelScanTest, sum_test) {
+  for (bool exclusive : {false, true}) {
+    for (bool reverse : {false, true}) {
+      CheckScan<float, ScanSumOp<float>>(1, 100000, 1, exclusive, reverse);
+      CheckScan<float, ScanSumOp<float>>(2, 3000, 17, exclusive, reverse);
+      CheckScan<float, ScanSumOp<float>>(3, 5, 600, exclusive, reverse);
+      CheckScan<int32_t, ScanSumOp<int32_t>>(1, 70000, 3, exclusive, reverse);
+      CheckScan<int32_t, ScanSumOp<int32_t>>(4, 1, 9, exclusive, reverse);
+    }
+  }
+}
+
+TEST_F(ParallelScanTest, prod_test) {
+  // The products stay exact: the inputs of a long axis are mostly ones.
+  for (bool exclusive : {false, true}) {
+    for (bool reverse : {false, true}) {
+      CheckScan<float, ScanProdOp<float>>(2, 10, 300, exclusive, reverse);
+      CheckScan<int32_t, ScanProdOp<int32_t>>(3, 12, 20, exclusive, reverse);
+    }
+  }
+  std::vector<float> input(50000, 1.0f);
+  input[7] = 2.0f;
+  input[30000] = 3.0f;
+  std::vector<float> output(input.size());
+  ParallelScan<float, ScanProdOp<float>>(1, input.size(), 1, false, false).Run(input.data(), output.data());
+  EXPECT_EQ(output[6], 1.0f);
+  EXPECT_EQ(output[7], 2.0f);
+  EXPECT_EQ(output[29999], 2.0f);
+  EXPECT_EQ(output[49999], 6.0f);
+  ParallelScan<float, ScanProdOp<float>>(1, input.size(), 1, true, true).Run(input.data(), output.data());
+  EXPECT_EQ(output[49999], 1.0f);
+  EXPECT_EQ(output[30000], 1.0f);
+  EXPECT_EQ(output[7], 3.0f);
+  EXPECT_EQ(output[0], 6.0f);
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/parallel_scatter.h"
+
+namespace mindspore {
+namespace kernel {
+class ParallelScatterTest : public UT::Common {
+ public:
+  ParallelScatterTest() = default;
+
+  // Segment sums of rows of row_size elements, the segment ids of every fourth row are out of range.
+  void CheckSegmentSum(size_t row_num, size_t row_size, size_t segment_num) {
+    std::vector<float> input(row_num * row_size);
+    std::vector<int> segment_ids(row_num);
+    for (size_t i = 0; i < input.size(); ++i) {
+      input[i] = static_cast<float>(i % 7);
+    }
+    for (size_t i = 0; i < row_num; ++i) {
+      segment_ids[i] = i % 4 == 3 ? -1 : static_cast<int>((i * 13) % segment_num);
+    }
+    std::vector<float> expect(segment_num * row_size, 0);
+    for (size_t i = 0; i < row_num; ++i) {
+      if (segment_ids[i] < 0) {
+        continue;
+      }
+      for (size_t j = 0; j < row_size; ++j) {
+        expect[segment_ids[i] * row_size + j] += input[i * row_size + j];
+      }
+    }
+    std::vector<float> output(segment_num * row_size, 0);
+    auto get_segment = [&segment_ids](size_t row) -> int64_t { return segment_ids[row]; };
+    auto add_row = [&](size_t row, int64_t segment, size_t start, size_t end) {
+      ScatterAddRow(input.data() + row * row_size + start, output.data() + segment * row_size + start, end - start);
+    };
+    ParallelScatterRows(row_num, row_size, segment_num, get_segment, add_row);
+    EXPECT_EQ(output, expect);
+  }
+};
+
+TEST_F(ParallelScatterTest, strategy_test) {
+  EXPECT_EQ(GetScatterStrategy(1000, 1000, 1000, 1), ScatterStrategy::kSerial);
+  EXPECT_EQ(GetScatterStrategy(10, 10, 10, 8), ScatterStrategy::kSerial);
+  EXPECT_EQ(GetScatterStrategy(100, 1024, 1000, 8), ScatterStrategy::kDirect);
+  EXPECT_EQ(GetScatterStrategy(100000, 4, 4, 8), ScatterStrategy::kDirect);
+  EXPECT_EQ(GetScatterStrategy(100000, 4, 1000, 8), ScatterStrategy::kBucketed);
+}
+
+TEST_F(ParallelScatterTest, segment_sum_test) {
+  CheckSegmentSum(10, 3, 5);
+  CheckSegmentSum(200, 2048, 17);
+  CheckSegmentSum(50000, 4, 3);
+  CheckSegmentSum(50000, 4, 1000);
+}
+
+// The buckets keep the order of the rows, so the last update of a target wins.
+TEST_F(ParallelScatterTest, bucketed_update_test) {
+  size_t row_num = 1000;
+  size_t row_size = 3;
+  size_t target_num = 10;
+  std::vector<int> output(target_num * row_size, -1);
+  auto get_target = [](size_t row) -> int64_t { return row % 5 == 0 ? -1 : static_cast<int64_t>(row % 10); };
+  auto update_row = [&](size_t row, int64_t target, size_t start, size_t end) {
+    for (size_t j = start; j < end; ++j) {
+      output[target * row_size + j] = static_cast<int>(row);
+    }
+  };
+  BucketedScatterRows(row_num, row_size, 4, 3, get_target, update_row);
+  for (size_t i = 0; i < target_num; ++i) {
+    int expect = i % 5 == 0 ? -1 : static_cast<int>(990 + i);
+    for (size_t j = 0; j < row_size; ++j) {
+      EXPECT_EQ(output[i * row_size + j], expect);
+    }
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/parallel_transpose.h"
+
+namespace mindspore {
+namespace kernel {
+class ParallelTransposeTest : public UT::Common {
+ public:
+  ParallelTransposeTest() = default;
+
+  // Compares the planned transpose with the element by element one.
+  template <typename T>
+  void CheckTranspose(const std::vector<size_t> &shape, const std::vector<size_t> &perm) {
+    size_t rank = shape.size();
+    size_t size = 1;
+    for (auto dim : shape) {
+      size *= dim;
+    }
+    std::vector<T> input(size);
+    for (size_t i = 0; i < size; ++i) {
+      input[i] = static_cast<T>(i % 251);
+    }
+    std::vector<size_t> in_strides(rank, 1);
+    for (size_t i = rank; i > 1; --i) {
+      in_strides[i - 2] = in_strides[i - 1] * shape[i - 1];
+    }
+    std::vector<T> expect(size);
+    std::vector<size_t> position(rank, 0);
+    for (size_t out = 0; out < size; ++out) {
+      size_t in = 0;
+      for (size_t i = 0; i < rank; ++i) {
+        in += position[i] * in_strides[perm[i]];
+      }
+      expect[out] = input[in];
+      for (size_t i = rank; i > 0; --i) {
+        if (++position[i - 1] < shape[perm[i - 1]]) {
+          break;
+        }
+        position[i - 1] = 0;
+      }
+    }
+    std::vector<T> output(size);
+    TransposePlan(shape, perm).Run(input.data(), output.data());
+    EXPECT_EQ(output, expect);
+  }
+};
+
+TEST_F(ParallelTransposeTest, collapse_test) {
+  std::vector<size_t> shape;
+  std::vector<size_t> perm;
+  // NCHW to NHWC.
+  CollapseTransposeDims({2, 3, 4, 5}, {0, 2, 3, 1}, &shape, &perm);
+  EXPECT_EQ(shape, std::vector<size_t>({2, 3, 20}));
+  EXPECT_EQ(perm, std::vector<size_t>({0, 2, 1}));
+  // The head split of the attention, the axes of size 1 are dropped.
+  CollapseTransposeDims({2, 1, 7, 4, 8}, {0, 1, 3, 2, 4}, &shape, &perm);
+  EXPECT_EQ(shape, std::vector<size_t>({2, 7, 4, 8}));
+  EXPECT_EQ(perm, std::vector<size_t>({0, 2, 1, 3}));
+  CollapseTransposeDims({2, 3, 4}, {0, 1, 2}, &shape, &perm);
+  EXPECT_EQ(shape, std::vector<size_t>({24}));
+  EXPECT_EQ(perm, std::vector<size_t>({0}));
+  CollapseTransposeDims({1, 1}, {1, 0}, &shape, &perm);
+  EXPECT_TRUE(shape.empty());
+}
+
+TEST_F(ParallelTransposeTest, transpose_test) {
+  CheckTranspose<float>({67, 45}, {1, 0});
+  CheckTranspose<float>({256, 320}, {1, 0});
+  CheckTranspose<float>({2, 16, 9, 11}, {0, 2, 3, 1});
+  CheckTranspose<float>({2, 9, 11, 16}, {0, 3, 1, 2});
+  CheckTranspose<float>({4, 64, 8, 32}, {0, 2, 1, 3});
+  CheckTranspose<int32_t>({3, 5, 7, 2, 4}, {4, 2, 0, 3, 1});
+  CheckTranspose<int8_t>({33, 70, 3}, {2, 1, 0});
+  CheckTranspose<int64_t>({5, 1, 6}, {2, 1, 0});
+  CheckTranspose<uint16_t>({4, 4}, {0, 1});
+  CheckTranspose<float>({1, 1}, {1, 0});
+  CheckTranspose<float>({3, 0, 2}, {2, 0, 1});
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,88 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/philox_random.h"
+
+namespace mindspore {
+namespace kernel {
+class PhiloxRandomTest : public UT::Common {
+ public:
+  PhiloxRandomTest() = default;
+};
+
+// The known answers of philox4x32_10 in the Random123 library.
+TEST_F(PhiloxRandomTest, known_answer_test) {
+  std::vector<uint32_t> out(kPhiloxResultSize);
+  PhiloxRandom zero(0, 0, 0);
+  zero.Generate(out.data(), 1);
+  EXPECT_EQ(out, std::vector<uint32_t>({0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+  PhiloxRandom ones(~0ULL, ~0ULL, ~0ULL);
+  ones.Generate(out.data(), 1);
+  EXPECT_EQ(out, std::vector<uint32_t>({0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+  PhiloxRandom pi(0x299f31d0a4093822ULL, 0x85a308d3243f6a88ULL, 0x0370734413198a2eULL);
+  pi.Generate(out.data(), 1);
+  EXPECT_EQ(out, std::vector<uint32_t>({0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+// A stream generated in parallel blocks is the one generated in one piece.
+TEST_F(PhiloxRandomTest, parallel_stream_test) {
+  size_t count = 3 * kPhiloxParallelBlockSize + 5;
+  std::vector<uint32_t> expect(count * kPhiloxResultSize);
+  PhiloxRandom random(42, 7);
+  random.Generate(expect.data(), count);
+  std::vector<uint32_t> output(count * kPhiloxResultSize);
+  PhiloxParallelFor(42, 7, count, [&output](size_t index, const uint32_t *numbers) {
+    std::copy(numbers, numbers + kPhiloxResultSize, output.begin() + index * kPhiloxResultSize);
+  });
+  EXPECT_EQ(output, expect);
+}
+
+TEST_F(PhiloxRandomTest, bernoulli_test) {
+  size_t count = 100003;
+  std::vector<int> keep(count, -1);
+  PhiloxBernoulliParallelFor(1, 0, count, 0.75f, [&keep](size_t i, bool value) { keep[i] = value; });
+  size_t keep_num = 0;
+  for (auto value : keep) {
+    ASSERT_NE(value, -1);
+    keep_num += value;
+  }
+  EXPECT_NEAR(static_cast<double>(keep_num) / count, 0.75, 0.01);
+  // The same seed and counter give the same mask, a keep_prob of 1 keeps everything.
+  PhiloxBernoulliParallelFor(1, 0, count, 0.75f, [&keep](size_t i, bool value) { EXPECT_EQ(keep[i], value); });
+  PhiloxBernoulliParallelFor(1, 0, count, 1.0f, [](size_t, bool value) { EXPECT_TRUE(value); });
+}
+
+TEST_F(PhiloxRandomTest, normal_test) {
+  size_t count = 50000;
+  std::vector<uint32_t> numbers(count * kPhiloxResultSize);
+  PhiloxRandom random(3, 0);
+  random.Generate(numbers.data(), count);
+  double sum = 0;
+  double square_sum = 0;
+  for (size_t i = 0; i < numbers.size(); i += 2) {
+    float normal[2];
+    PhiloxNormal(numbers[i], numbers[i + 1], &normal[0], &normal[1]);
+    sum += normal[0] + normal[1];
+    square_sum += normal[0] * normal[0] + normal[1] * normal[1];
+  }
+  double mean = sum / numbers.size();
+  EXPECT_NEAR(mean, 0, 0.01);
+  EXPECT_NEAR(square_sum / numbers.size() - mean * mean, 1, 0.02);
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,68 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/mkldnn/primitive_cache.h"
+
+namespace mindspore {
+namespace kernel {
+class PrimitiveCacheTest : public UT::Common {
+ public:
+  PrimitiveCacheTest() = default;
+
+  std::shared_ptr<int> Get(PrimitiveCache<int> *cache, const std::string &key, int value) {
+    return cache->Get(key, [this, value]() {
+      ++create_num_;
+      return std::make_shared<int>(value);
+    });
+  }
+
+  size_t create_num_{0};
+};
+
+TEST_F(PrimitiveCacheTest, lru_test) {
+  PrimitiveCache<int> cache(2);
+  auto a = Get(&cache, "a", 1);
+  auto b = Get(&cache, "b", 2);
+  EXPECT_EQ(Get(&cache, "a", 3), a);
+  // b is the least recently used entry and is evicted by c.
+  (void)Get(&cache, "c", 4);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(*Get(&cache, "b", 5), 5);
+  EXPECT_EQ(create_num_, 4);
+  EXPECT_EQ(cache.hit_num(), 1);
+  EXPECT_EQ(cache.miss_num(), 4);
+
+  cache.SetCapacity(1);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(*Get(&cache, "b", 6), 5);
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.hit_num(), 0);
+  EXPECT_EQ(cache.miss_num(), 0);
+}
+
+TEST_F(PrimitiveCacheTest, disabled_test) {
+  PrimitiveCache<int> cache(0);
+  EXPECT_NE(Get(&cache, "a", 1), Get(&cache, "a", 1));
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.hit_num(), 0);
+  EXPECT_EQ(cache.miss_num(), 2);
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,97 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/sparse_matmul.h"
+
+namespace mindspore {
+namespace kernel {
+class SparseMatmulTest : public UT::Common {
+ public:
+  SparseMatmulTest() = default;
+
+  // A sparse matrix of row_num x col_num with the entries in a scrambled order, the rows have different degrees.
+  void MakeEntries(size_t row_num, size_t col_num, size_t nnz) {
+    rows_.resize(nnz);
+    cols_.resize(nnz);
+    values_.resize(nnz);
+    for (size_t e = 0; e < nnz; ++e) {
+      rows_[e] = (e * 7) % row_num * (e % 3 == 0 ? 0 : 1);
+      cols_[e] = (e * 13 + 5) % col_num;
+      values_[e] = static_cast<float>(e % 5) - 2;
+    }
+  }
+
+  std::vector<size_t> rows_;
+  std::vector<size_t> cols_;
+  std::vector<float> values_;
+};
+
+TEST_F(SparseMatmulTest, group_rows_test) {
+  SparseRowIndex index;
+  GroupSparseRows({2, 0, 2, 1, 0}, 4, &index);
+  EXPECT_EQ(index.indptr, std::vector<size_t>({0, 2, 3, 5, 5}));
+  EXPECT_EQ(index.order, std::vector<size_t>({1, 4, 3, 0, 2}));
+}
+
+TEST_F(SparseMatmulTest, matmul_test) {
+  const size_t row_num = 37;
+  const size_t col_num = 23;
+  const size_t n = 19;
+  MakeEntries(row_num, col_num, 300);
+  std::vector<float> dense(col_num * n);
+  for (size_t i = 0; i < dense.size(); ++i) {
+    dense[i] = static_cast<float>(i % 11) - 5;
+  }
+  std::vector<float> expect(row_num * n, 0);
+  for (size_t e = 0; e < rows_.size(); ++e) {
+    for (size_t j = 0; j < n; ++j) {
+      expect[rows_[e] * n + j] += values_[e] * dense[cols_[e] * n + j];
+    }
+  }
+  SparseRowIndex index;
+  GroupSparseRows(rows_, row_num, &index);
+  std::vector<float> output(row_num * n, 1);
+  SparseRowsMatmul(index, cols_, values_.data(), dense.data(), n, output.data());
+  EXPECT_EQ(output, expect);
+}
+
+TEST_F(SparseMatmulTest, values_grad_test) {
+  const size_t row_num = 9;
+  const size_t col_num = 12;
+  const size_t n = 21;
+  MakeEntries(row_num, col_num, 40);
+  std::vector<float> dout(row_num * n);
+  std::vector<float> dense(col_num * n);
+  for (size_t i = 0; i < dout.size(); ++i) {
+    dout[i] = static_cast<float>(i % 7) - 3;
+  }
+  for (size_t i = 0; i < dense.size(); ++i) {
+    dense[i] = static_cast<float>(i % 5) - 1;
+  }
+  std::vector<float> grad(rows_.size());
+  SparseValuesGrad(rows_, cols_, dout.data(), dense.data(), n, grad.data());
+  for (size_t e = 0; e < rows_.size(); ++e) {
+    float expect = 0;
+    for (size_t j = 0; j < n; ++j) {
+      expect += dout[rows_[e] * n + j] * dense[cols_[e] * n + j];
+    }
+    EXPECT_EQ(grad[e], expect);
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
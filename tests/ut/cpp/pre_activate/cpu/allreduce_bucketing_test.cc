@@ -0,0 +1,101 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "abstract/abstract_value.h"
+#include "ir/func_graph.h"
+#include "utils/utils.h"
+#define private public
+#define protected public
+#include "backend/optimizer/cpu/allreduce_bucketing.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace opt {
+class TestAllReduceBucketing : public UT::Common {
+ public:
+  TestAllReduceBucketing() {}
+
+  void SetUp() override {
+    graph_ = std::make_shared<FuncGraph>();
+    input_ = graph_->add_parameter();
+  }
+
+  // An AllReduce of a float32 gradient of element_num elements, averaged when mean is set.
+  CNodePtr NewAllReduce(int64_t element_num, bool mean = false) {
+    auto prim = std::make_shared<Primitive>(kAllReduceOpName);
+    if (mean) {
+      prim->AddAttr(kAttrMean, MakeValue(true));
+    }
+    auto all_reduce = graph_->NewCNode({NewValueNode(prim), input_});
+    all_reduce->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{element_num}));
+    all_reduces_.push_back(all_reduce);
+    return all_reduce;
+  }
+
+  // The buckets as the indexes of their AllReduce in all_reduces_.
+  std::vector<std::vector<size_t>> GetBuckets(size_t bucket_size, size_t bucket_num) {
+    AllReduceBucketing pass(bucket_size, bucket_num);
+    std::vector<std::vector<size_t>> buckets;
+    for (auto &bucket : pass.GetBuckets(all_reduces_)) {
+      buckets.emplace_back();
+      for (auto &all_reduce : bucket) {
+        auto iter = std::find(all_reduces_.begin(), all_reduces_.end(), all_reduce);
+        buckets.back().push_back(static_cast<size_t>(iter - all_reduces_.begin()));
+      }
+    }
+    return buckets;
+  }
+
+  FuncGraphPtr graph_;
+  AnfNodePtr input_;
+  std::vector<CNodePtr> all_reduces_;
+};
+
+TEST_F(TestAllReduceBucketing, test_fill_by_size) {
+  // 512, 256, 512 and 128 bytes, the third gradient does not fit in a bucket of 1024 bytes with the first two.
+  (void)NewAllReduce(128);
+  (void)NewAllReduce(64);
+  (void)NewAllReduce(128);
+  (void)NewAllReduce(32);
+  EXPECT_EQ(GetBuckets(1024, 0), std::vector<std::vector<size_t>>({{0, 1}, {2, 3}}));
+  // A gradient bigger than the bucket size gets a bucket of its own.
+  EXPECT_EQ(GetBuckets(256, 0), std::vector<std::vector<size_t>>({{0}, {1}, {2}, {3}}));
+}
+
+TEST_F(TestAllReduceBucketing, test_split_mean) {
+  // A bucket is reduced either by the sum or by the mean, never both.
+  (void)NewAllReduce(128);
+  (void)NewAllReduce(64);
+  (void)NewAllReduce(128, true);
+  (void)NewAllReduce(32);
+  EXPECT_EQ(GetBuckets(4096, 0), std::vector<std::vector<size_t>>({{0, 1}, {2}, {3}}));
+}
+
+TEST_F(TestAllReduceBucketing, test_bucket_num) {
+  // The 1280 bytes in 2 buckets make the bucket size 640 bytes, the greedy filling gives 512, 512 and 256 bytes and
+  // the smallest neighbours are merged.
+  for (size_t i = 0; i < 5; ++i) {
+    (void)NewAllReduce(64);
+  }
+  EXPECT_EQ(GetBuckets(256, 2), std::vector<std::vector<size_t>>({{0, 1}, {2, 3, 4}}));
+  EXPECT_EQ(GetBuckets(256, 1), std::vector<std::vector<size_t>>({{0, 1, 2, 3, 4}}));
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,141 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/backend_common_test.h"
+#include "common/py_func_graph_fetcher.h"
+#include "backend/kernel_compiler/cpu/mkldnn/matmul_cpu_kernel.h"
+#include "backend/optimizer/cpu/bf16_mixed_precision.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+using KernelBuildInfoBuilder = kernel::KernelBuildInfo::KernelBuildInfoBuilder;
+
+class TestHWBf16MixedPrecision : public BackendCommon {
+ public:
+  TestHWBf16MixedPrecision() : get_py_fun_("gtest_input.pre_activate.bf16_mixed_precision_test", true) {}
+  ~TestHWBf16MixedPrecision() override = default;
+
+  static void SetKernelBuildInfo(const AnfNodePtr &node, size_t input_num, TypeId type_id) {
+    KernelBuildInfoBuilder builder;
+    builder.SetInputsFormat(std::vector<std::string>(input_num, kOpFormat_DEFAULT));
+    builder.SetInputsDeviceType(std::vector<TypeId>(input_num, type_id));
+    builder.SetOutputsFormat({kOpFormat_DEFAULT});
+    builder.SetOutputsDeviceType({type_id});
+    AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), node.get());
+  }
+
+  // Builds matmul(x[4, 16], w[16, 8]) + b with the parameters and kernels selected in the given data type.
+  std::shared_ptr<session::KernelGraph> GetMatMulGraph(TypeId type_id) {
+    FuncGraphPtr g = get_py_fun_.CallAndParseRet("test_bf16_mixed_precision", "before");
+    auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{4, 16});
+    auto w_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{16, 8});
+    auto b_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{4, 8});
+    AbstractBasePtrList args_spec_list{x_abstract, w_abstract, b_abstract};
+    auto kg = GetKernelGraph(g, args_spec_list);
+    for (auto &parameter : kg->parameters()) {
+      SetKernelBuildInfo(parameter, 0, type_id);
+    }
+    for (auto &node : kg->execution_order()) {
+      SetKernelBuildInfo(node, AnfAlgo::GetInputTensorNum(node), type_id);
+    }
+    return kg;
+  }
+
+  static CNodePtr FindKernel(const std::shared_ptr<session::KernelGraph> &kg, const std::string &name) {
+    for (auto &node : kg->execution_order()) {
+      if (AnfAlgo::GetCNodeName(node) == name) {
+        return node;
+      }
+    }
+    return nullptr;
+  }
+
+  static bool HasBf16Attr(const CNodePtr &node) {
+    return AnfAlgo::HasNodeAttr(kAttrComputeDtype, node) &&
+           AnfAlgo::GetNodeAttr<std::string>(node, kAttrComputeDtype) == kValueBFloat16;
+  }
+
+  UT::PyFuncGraphFetcher get_py_fun_;
+};
+
+TEST_F(TestHWBf16MixedPrecision, test_mark_float32_matmul) {
+  auto kg = GetMatMulGraph(kNumberTypeFloat32);
+  auto exec_order = kg->execution_order();
+  auto pass = std::make_shared<Bf16MixedPrecision>();
+  bool bf16_supported = kernel::MKLCPUKernel::IsBf16Supported();
+  EXPECT_EQ(pass->Run(kg), bf16_supported);
+  // Only the matmul is marked, the conversion to bfloat16 happens inside its kernel, the pass inserts no Cast.
+  EXPECT_EQ(kg->execution_order(), exec_order);
+  auto matmul = FindKernel(kg, kMatMulOpName);
+  ASSERT_NE(matmul, nullptr);
+  EXPECT_EQ(HasBf16Attr(matmul), bf16_supported);
+  EXPECT_FALSE(HasBf16Attr(FindKernel(kg, kTensorAddOpName)));
+  // The inputs and the output keep float32 in the graph, the add reads the float32 output of the matmul.
+  EXPECT_EQ(AnfAlgo::GetInputDeviceDataType(matmul, 0), kNumberTypeFloat32);
+  EXPECT_EQ(AnfAlgo::GetInputDeviceDataType(matmul, 1), kNumberTypeFloat32);
+  EXPECT_EQ(AnfAlgo::GetOutputDeviceDataType(matmul, 0), kNumberTypeFloat32);
+}
+
+TEST_F(TestHWBf16MixedPrecision, test_keep_float16_matmul) {
+  auto kg = GetMatMulGraph(kNumberTypeFloat16);
+  auto pass = std::make_shared<Bf16MixedPrecision>();
+  EXPECT_FALSE(pass->Run(kg));
+  EXPECT_FALSE(HasBf16Attr(FindKernel(kg, kMatMulOpName)));
+}
+
+TEST_F(TestHWBf16MixedPrecision, test_launch_marked_matmul) {
+  auto kg = GetMatMulGraph(kNumberTypeFloat32);
+  auto pass = std::make_shared<Bf16MixedPrecision>();
+  (void)pass->Run(kg);
+  auto matmul = FindKernel(kg, kMatMulOpName);
+  ASSERT_NE(matmul, nullptr);
+  kernel::MatMulCPUKernel kernel_mod;
+  kernel_mod.Init(matmul);
+
+  // Halves of small integers are exact in bfloat16 and their products sum exactly in float32, so the bfloat16 matmul
+  // has to give the float32 result bit for bit if the inputs are converted before the primitive and the output is not.
+  std::vector<float> x(4 * 16);
+  std::vector<float> w(16 * 8);
+  std::vector<float> output(4 * 8);
+  for (size_t i = 0; i < x.size(); ++i) {
+    x[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.5f;
+  }
+  for (size_t i = 0; i < w.size(); ++i) {
+    w[i] = static_cast<float>(static_cast<int>(i % 5) - 2) * 0.5f;
+  }
+  auto make_address = [](std::vector<float> *data) {
+    auto address = std::make_shared<kernel::Address>();
+    address->addr = data->data();
+    address->size = data->size() * sizeof(float);
+    return address;
+  };
+  std::vector<kernel::AddressPtr> inputs{make_address(&x), make_address(&w)};
+  std::vector<kernel::AddressPtr> workspace;
+  std::vector<kernel::AddressPtr> outputs{make_address(&output)};
+  ASSERT_TRUE(kernel_mod.Launch(inputs, workspace, outputs));
+  for (size_t m = 0; m < 4; ++m) {
+    for (size_t n = 0; n < 8; ++n) {
+      float expect = 0;
+      for (size_t k = 0; k < 16; ++k) {
+        expect += x[m * 16 + k] * w[k * 8 + n];
+      }
+      EXPECT_EQ(output[m * 8 + n], expect);
+    }
+  }
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,154 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/backend_common_test.h"
+#include "common/py_func_graph_fetcher.h"
+#include "backend/kernel_compiler/cpu/dropout_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/dropout_grad_kernel.h"
+#include "backend/kernel_compiler/cpu/philox_random.h"
+#include "backend/optimizer/cpu/dropout_mask_regeneration.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+using KernelBuildInfoBuilder = kernel::KernelBuildInfo::KernelBuildInfoBuilder;
+
+class TestHWDropoutMaskRegeneration : public BackendCommon {
+ public:
+  TestHWDropoutMaskRegeneration() : get_py_fun_("gtest_input.pre_activate.dropout_mask_regeneration_test", true) {}
+  ~TestHWDropoutMaskRegeneration() override = default;
+
+  static void SetKernelBuildInfo(const AnfNodePtr &node, size_t input_num, size_t output_num) {
+    KernelBuildInfoBuilder builder;
+    builder.SetInputsFormat(std::vector<std::string>(input_num, kOpFormat_DEFAULT));
+    builder.SetInputsDeviceType(std::vector<TypeId>(input_num, kNumberTypeFloat32));
+    builder.SetOutputsFormat(std::vector<std::string>(output_num, kOpFormat_DEFAULT));
+    builder.SetOutputsDeviceType(std::vector<TypeId>(output_num, kNumberTypeFloat32));
+    AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), node.get());
+  }
+
+  // Builds dropout(x[4, 64]) and its grad with the float32 kernels selected.
+  std::shared_ptr<session::KernelGraph> GetGraph(const std::string &tag) {
+    FuncGraphPtr g = get_py_fun_.CallAndParseRet("test_dropout_mask_regeneration", tag);
+    auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{4, 64});
+    AbstractBasePtrList args_spec_list{x_abstract, x_abstract};
+    auto kg = GetKernelGraph(g, args_spec_list);
+    for (auto &parameter : kg->parameters()) {
+      SetKernelBuildInfo(parameter, 0, 1);
+    }
+    for (auto &node : kg->execution_order()) {
+      SetKernelBuildInfo(node, AnfAlgo::GetInputTensorNum(node), AnfAlgo::GetOutputTensorNum(node));
+    }
+    return kg;
+  }
+
+  static CNodePtr FindKernel(const std::shared_ptr<session::KernelGraph> &kg, const std::string &name) {
+    for (auto &node : kg->execution_order()) {
+      if (AnfAlgo::GetCNodeName(node) == name) {
+        return node;
+      }
+    }
+    return nullptr;
+  }
+
+  UT::PyFuncGraphFetcher get_py_fun_;
+};
+
+TEST_F(TestHWDropoutMaskRegeneration, test_regenerate_mask) {
+  auto kg = GetGraph("before");
+  auto pass = std::make_shared<DropoutMaskRegeneration>();
+  EXPECT_TRUE(pass->Run(kg));
+  auto dropout = FindKernel(kg, kDropoutOpName);
+  auto dropout_grad = FindKernel(kg, kDropoutGradOpName);
+  ASSERT_NE(dropout, nullptr);
+  ASSERT_NE(dropout_grad, nullptr);
+  // The mask becomes the seed and the counter of the launch, the output of the dropout is kept.
+  EXPECT_EQ(AnfAlgo::GetOutputDeviceDataType(dropout, 0), kNumberTypeFloat32);
+  EXPECT_EQ(AnfAlgo::GetOutputInferShape(dropout, 0), (std::vector<size_t>{4, 64}));
+  EXPECT_EQ(AnfAlgo::GetOutputDeviceDataType(dropout, 1), kNumberTypeUInt64);
+  EXPECT_EQ(AnfAlgo::GetOutputInferShape(dropout, 1), (std::vector<size_t>{kernel::kPhiloxStateSize}));
+  EXPECT_EQ(AnfAlgo::GetInputDeviceDataType(dropout_grad, 0), kNumberTypeFloat32);
+  EXPECT_EQ(AnfAlgo::GetInputDeviceDataType(dropout_grad, 1), kNumberTypeUInt64);
+  EXPECT_EQ(AnfAlgo::GetPrevNodeOutputInferShape(dropout_grad, 1), (std::vector<size_t>{kernel::kPhiloxStateSize}));
+}
+
+TEST_F(TestHWDropoutMaskRegeneration, test_keep_mask_of_other_user) {
+  // The mask is also an output of the graph, it has to be materialized.
+  auto kg = GetGraph("mask_returned");
+  auto pass = std::make_shared<DropoutMaskRegeneration>();
+  EXPECT_FALSE(pass->Run(kg));
+  auto dropout = FindKernel(kg, kDropoutOpName);
+  auto dropout_grad = FindKernel(kg, kDropoutGradOpName);
+  ASSERT_NE(dropout, nullptr);
+  ASSERT_NE(dropout_grad, nullptr);
+  EXPECT_EQ(AnfAlgo::GetOutputDeviceDataType(dropout, 1), kNumberTypeFloat32);
+  EXPECT_EQ(AnfAlgo::GetOutputInferShape(dropout, 1), (std::vector<size_t>{4, 64}));
+  EXPECT_EQ(AnfAlgo::GetInputDeviceDataType(dropout_grad, 1), kNumberTypeFloat32);
+}
+
+TEST_F(TestHWDropoutMaskRegeneration, test_launch_regenerated_mask) {
+  auto kg = GetGraph("before");
+  auto pass = std::make_shared<DropoutMaskRegeneration>();
+  ASSERT_TRUE(pass->Run(kg));
+  kernel::DropoutCPUKernel dropout_mod;
+  dropout_mod.Init(FindKernel(kg, kDropoutOpName));
+  kernel::DropoutGradCpuBwdKernel dropout_grad_mod;
+  dropout_grad_mod.Init(FindKernel(kg, kDropoutGradOpName));
+
+  size_t size = 4 * 64;
+  std::vector<float> x(size);
+  for (size_t i = 0; i < size; ++i) {
+    x[i] = static_cast<float>(i + 1);
+  }
+  std::vector<float> dy(size, 1.0f);
+  std::vector<float> output(size);
+  std::vector<float> dx(size);
+  kernel::PhiloxState state;
+  auto make_address = [](void *data, size_t data_size) {
+    auto address = std::make_shared<kernel::Address>();
+    address->addr = data;
+    address->size = data_size;
+    return address;
+  };
+  std::vector<kernel::AddressPtr> workspace;
+  std::vector<kernel::AddressPtr> dropout_inputs{make_address(x.data(), size * sizeof(float))};
+  std::vector<kernel::AddressPtr> dropout_outputs{make_address(output.data(), size * sizeof(float)),
+                                                  make_address(&state, sizeof(state))};
+  std::vector<kernel::AddressPtr> grad_inputs{make_address(dy.data(), size * sizeof(float)),
+                                              make_address(&state, sizeof(state))};
+  std::vector<kernel::AddressPtr> grad_outputs{make_address(dx.data(), size * sizeof(float))};
+
+  // Each launch draws a new mask, its grad regenerates it from the state of the launch.
+  std::vector<std::vector<bool>> masks;
+  std::vector<uint64_t> counters;
+  for (size_t launch = 0; launch < 2; ++launch) {
+    ASSERT_TRUE(dropout_mod.Launch(dropout_inputs, workspace, dropout_outputs));
+    ASSERT_TRUE(dropout_grad_mod.Launch(grad_inputs, workspace, grad_outputs));
+    EXPECT_EQ(state.seed, (1ULL << 32) | 2);
+    counters.push_back(state.counter);
+    std::vector<bool> mask(size);
+    for (size_t i = 0; i < size; ++i) {
+      mask[i] = output[i] != 0;
+      EXPECT_FLOAT_EQ(output[i], mask[i] ? 2 * x[i] : 0);
+      EXPECT_FLOAT_EQ(dx[i], mask[i] ? 2 : 0);
+    }
+    masks.push_back(mask);
+  }
+  EXPECT_EQ(counters[1], counters[0] + (size + kernel::kPhiloxResultSize - 1) / kernel::kPhiloxResultSize);
+  EXPECT_NE(masks[0], masks[1]);
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/backend_common_test.h"
+#include "common/py_func_graph_fetcher.h"
+#include "backend/optimizer/cpu/elemwise_fusion.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "ir/manager.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+using KernelBuildInfoBuilder = kernel::KernelBuildInfo::KernelBuildInfoBuilder;
+
+class TestHWElemwiseFusion : public BackendCommon {
+ public:
+  TestHWElemwiseFusion() : get_py_fun_("gtest_input.pre_activate.elemwise_fusion_test", true) {}
+  ~TestHWElemwiseFusion() override = default;
+
+  // Builds the mul, add and relu chain with the kernels selected in the given data type.
+  std::shared_ptr<session::KernelGraph> GetChainGraph(TypeId type_id) {
+    FuncGraphPtr g = get_py_fun_.CallAndParseRet("test_elemwise_fusion", "before");
+    std::vector<int64_t> shp{2, 32, 8};
+    auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp);
+    AbstractBasePtrList args_spec_list{x_abstract, x_abstract};
+    auto kg = GetKernelGraph(g, args_spec_list);
+    for (auto &node : kg->execution_order()) {
+      size_t input_num = AnfAlgo::GetInputTensorNum(node);
+      KernelBuildInfoBuilder builder;
+      builder.SetInputsFormat(std::vector<std::string>(input_num, kOpFormat_DEFAULT));
+      builder.SetInputsDeviceType(std::vector<TypeId>(input_num, type_id));
+      builder.SetOutputsFormat({kOpFormat_DEFAULT});
+      builder.SetOutputsDeviceType({type_id});
+      AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), node.get());
+    }
+    (void)Manage(kg, true);
+    return kg;
+  }
+
+  static std::vector<std::string> GetKernelNames(const FuncGraphPtr &graph) {
+    std::vector<std::string> names;
+    for (auto &node : TopoSort(graph->get_return())) {
+      if (node->isa<CNode>() && AnfAlgo::IsRealKernel(node)) {
+        names.push_back(AnfAlgo::GetCNodeName(node));
+      }
+    }
+    return names;
+  }
+
+  UT::PyFuncGraphFetcher get_py_fun_;
+};
+
+TEST_F(TestHWElemwiseFusion, test_fuse_float32_chain) {
+  auto kg = GetChainGraph(kNumberTypeFloat32);
+  auto pass = std::make_shared<ElemwiseFusion>();
+  EXPECT_TRUE(pass->Run(kg));
+  EXPECT_EQ(GetKernelNames(kg), std::vector<std::string>{kFusedElemwiseOpName});
+  // The graph output is make_tuple(relu), the fused node takes the place of the relu.
+  auto fused_node = kg->output()->cast<CNodePtr>()->input(1)->cast<CNodePtr>();
+  ASSERT_NE(fused_node, nullptr);
+  EXPECT_EQ(AnfAlgo::GetCNodeName(fused_node), kFusedElemwiseOpName);
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::vector<std::string>>(fused_node, kAttrFusedOps),
+            std::vector<std::string>({kMulOpName, kTensorAddOpName, "ReLU"}));
+}
+
+TEST_F(TestHWElemwiseFusion, test_keep_float16_chain) {
+  auto kg = GetChainGraph(kNumberTypeFloat16);
+  auto pass = std::make_shared<ElemwiseFusion>();
+  // Nothing is fused, so the pass must not report a change.
+  EXPECT_FALSE(pass->Run(kg));
+  EXPECT_EQ(GetKernelNames(kg), std::vector<std::string>({kMulOpName, kTensorAddOpName, "ReLU"}));
+}
+}  // namespace opt
+}  // namespace mindspore
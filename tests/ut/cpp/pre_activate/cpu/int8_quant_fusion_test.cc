@@ -0,0 +1,382 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include "common/backend_common_test.h"
+#include "common/py_func_graph_fetcher.h"
+#include "backend/kernel_compiler/cpu/fake_quant_cpu_kernel.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/mkldnn/int8_conv2d_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/mkldnn/int8_matmul_cpu_kernel.h"
+#undef private
+#undef protected
+#include "backend/optimizer/cpu/int8_quant_fusion.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+using KernelBuildInfoBuilder = kernel::KernelBuildInfo::KernelBuildInfoBuilder;
+using ShapeVector = std::vector<int64_t>;
+
+class TestHWInt8QuantFusion : public BackendCommon {
+ public:
+  TestHWInt8QuantFusion() : get_py_fun_("gtest_input.pre_activate.int8_quant_fusion_test", true) {}
+  ~TestHWInt8QuantFusion() override = default;
+
+  static void SetKernelBuildInfo(const AnfNodePtr &node, size_t input_num) {
+    KernelBuildInfoBuilder builder;
+    builder.SetInputsFormat(std::vector<std::string>(input_num, kOpFormat_DEFAULT));
+    builder.SetInputsDeviceType(std::vector<TypeId>(input_num, kNumberTypeFloat32));
+    builder.SetOutputsFormat({kOpFormat_DEFAULT});
+    builder.SetOutputsDeviceType({kNumberTypeFloat32});
+    AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), node.get());
+  }
+
+  // Builds the graph of the tag with float32 parameters of the given shapes and float32 kernels selected.
+  std::shared_ptr<session::KernelGraph> GetGraph(const std::string &tag, const std::vector<ShapeVector> &shapes) {
+    FuncGraphPtr g = get_py_fun_.CallAndParseRet("test_int8_quant_fusion", tag);
+    AbstractBasePtrList args_spec_list;
+    for (auto &shape : shapes) {
+      args_spec_list.push_back(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+    }
+    auto kg = GetKernelGraph(g, args_spec_list);
+    for (auto &parameter : kg->parameters()) {
+      SetKernelBuildInfo(parameter, 0);
+    }
+    for (auto &node : kg->execution_order()) {
+      SetKernelBuildInfo(node, AnfAlgo::GetInputTensorNum(node));
+    }
+    return kg;
+  }
+
+  // The execution order is not updated by the pass, the nodes are looked up in the graph.
+  static CNodePtr FindNode(const std::shared_ptr<session::KernelGraph> &kg, const std::string &name) {
+    for (auto &node : TopoSort(kg->get_return())) {
+      if (node->isa<CNode>() && AnfAlgo::GetCNodeName(node) == name) {
+        return node->cast<CNodePtr>();
+      }
+    }
+    return nullptr;
+  }
+
+  // Runs the pass and returns the int8 node it created, checking its inputs are the ones of the FakeQuant.
+  static CNodePtr FoldFakeQuant(const std::shared_ptr<session::KernelGraph> &kg, const std::string &int8_name,
+                                size_t input_num) {
+    auto params = kg->parameters();
+    auto pass = std::make_shared<Int8QuantFusion>();
+    EXPECT_TRUE(pass->Run(kg));
+    auto int8_node = FindNode(kg, int8_name);
+    EXPECT_NE(int8_node, nullptr);
+    if (int8_node == nullptr) {
+      return nullptr;
+    }
+    EXPECT_EQ(AnfAlgo::GetInputTensorNum(int8_node), input_num);
+    for (size_t i = 0; i < input_num; ++i) {
+      EXPECT_EQ(AnfAlgo::GetInputNode(int8_node, i), params[i]);
+    }
+    EXPECT_EQ(FindNode(kg, kFakeQuantPerLayerOpName), nullptr);
+    EXPECT_EQ(FindNode(kg, kFakeQuantPerChannelOpName), nullptr);
+    EXPECT_EQ(AnfAlgo::GetOutputDeviceDataType(int8_node, 0), kNumberTypeFloat32);
+    return int8_node;
+  }
+
+  static void ExpectUnchanged(const std::shared_ptr<session::KernelGraph> &kg) {
+    auto pass = std::make_shared<Int8QuantFusion>();
+    EXPECT_FALSE(pass->Run(kg));
+    EXPECT_EQ(FindNode(kg, kInt8MatMulOpName), nullptr);
+    EXPECT_EQ(FindNode(kg, kInt8Conv2DOpName), nullptr);
+  }
+
+  UT::PyFuncGraphFetcher get_py_fun_;
+};
+
+TEST_F(TestHWInt8QuantFusion, test_fold_matmul_bias) {
+  auto kg = GetGraph("matmul_bias", {{4, 16}, {16, 8}, {1}, {1}, {1}, {1}, {8}});
+  auto int8_node = FoldFakeQuant(kg, kInt8MatMulOpName, 7);
+  ASSERT_NE(int8_node, nullptr);
+  EXPECT_EQ(FindNode(kg, kBiasAddOpName), nullptr);
+  EXPECT_EQ(FindNode(kg, kMatMulOpName), nullptr);
+  EXPECT_FALSE(AnfAlgo::GetNodeAttr<bool>(int8_node, kAttrSrcNarrowRange));
+  EXPECT_FALSE(AnfAlgo::GetNodeAttr<bool>(int8_node, kAttrSrcSymmetric));
+  EXPECT_TRUE(AnfAlgo::GetNodeAttr<bool>(int8_node, kAttrWeightNarrowRange));
+  EXPECT_TRUE(AnfAlgo::GetNodeAttr<bool>(int8_node, kAttrWeightSymmetric));
+  EXPECT_FALSE(AnfAlgo::GetNodeAttr<bool>(int8_node, "transpose_b"));
+}
+
+TEST_F(TestHWInt8QuantFusion, test_fold_matmul_of_shared_output) {
+  // The matmul is folded, the BiasAdd is not since the add also reads the output of the matmul.
+  auto kg = GetGraph("matmul_bias_shared_output", {{4, 16}, {16, 8}, {1}, {1}, {1}, {1}, {8}});
+  auto int8_node = FoldFakeQuant(kg, kInt8MatMulOpName, 6);
+  ASSERT_NE(int8_node, nullptr);
+  auto bias_add = FindNode(kg, kBiasAddOpName);
+  ASSERT_NE(bias_add, nullptr);
+  EXPECT_EQ(AnfAlgo::GetInputNode(bias_add, 0), int8_node);
+}
+
+TEST_F(TestHWInt8QuantFusion, test_fold_per_output_channel_weight) {
+  // The output channels of the weight are its axis 1, or its axis 0 when it is transposed.
+  auto kg = GetGraph("matmul_per_channel", {{4, 16}, {16, 8}, {1}, {1}, {8}, {8}});
+  EXPECT_NE(FoldFakeQuant(kg, kInt8MatMulOpName, 6), nullptr);
+  kg = GetGraph("matmul_transpose_b_per_channel", {{4, 16}, {8, 16}, {1}, {1}, {8}, {8}});
+  auto int8_node = FoldFakeQuant(kg, kInt8MatMulOpName, 6);
+  ASSERT_NE(int8_node, nullptr);
+  EXPECT_TRUE(AnfAlgo::GetNodeAttr<bool>(int8_node, "transpose_b"));
+}
+
+TEST_F(TestHWInt8QuantFusion, test_keep_unfoldable_fake_quant) {
+  // A weight quantized along its input channels.
+  ExpectUnchanged(GetGraph("matmul_per_input_channel", {{4, 16}, {16, 8}, {1}, {1}, {16}, {16}}));
+  // A src quantized per channel.
+  ExpectUnchanged(GetGraph("matmul_per_channel_src", {{4, 16}, {16, 8}, {16}, {16}, {1}, {1}}));
+  // The ranges are still trained.
+  ExpectUnchanged(GetGraph("matmul_training", {{4, 16}, {16, 8}, {1}, {1}, {1}, {1}}));
+  // Less than 8 bits.
+  ExpectUnchanged(GetGraph("matmul_4_bits", {{4, 16}, {16, 8}, {1}, {1}, {1}, {1}}));
+  // The output of the FakeQuant of the src is also returned.
+  ExpectUnchanged(GetGraph("matmul_shared_fake_quant", {{4, 16}, {16, 8}, {1}, {1}, {1}, {1}}));
+  // Only the weight is quantized.
+  ExpectUnchanged(GetGraph("matmul_without_src_fake_quant", {{4, 16}, {16, 8}, {1}, {1}}));
+}
+
+TEST_F(TestHWInt8QuantFusion, test_fold_conv_bias) {
+  auto kg = GetGraph("conv_bias", {{1, 4, 6, 6}, {8, 4, 3, 3}, {1}, {1}, {8}, {8}, {8}});
+  auto int8_node = FoldFakeQuant(kg, kInt8Conv2DOpName, 7);
+  ASSERT_NE(int8_node, nullptr);
+  EXPECT_EQ(FindNode(kg, kBiasAddOpName), nullptr);
+  EXPECT_EQ(FindNode(kg, kConv2DOpName), nullptr);
+  EXPECT_EQ(AnfAlgo::GetOutputInferShape(int8_node, 0), (std::vector<size_t>{1, 8, 4, 4}));
+}
+
+class TestHWInt8Kernel : public TestHWInt8QuantFusion {
+ public:
+  // The FakeQuant of data with one range per channel, a channel being inner_size consecutive values.
+  static std::vector<float> FakeQuant(const std::vector<float> &data, const std::vector<float> &min,
+                                      const std::vector<float> &max, bool narrow_range, bool symmetric,
+                                      size_t inner_size) {
+    std::vector<float> output(data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+      size_t channel = (i / inner_size) % min.size();
+      auto range =
+        kernel::FakeQuantCPUKernel::NudgeRange(min[channel], max[channel], narrow_range ? 1 : 0, 255, symmetric);
+      float value = std::min(std::max(data[i], range.min), range.max);
+      output[i] = std::round((value - range.min) / range.scale) * range.scale + range.min;
+    }
+    return output;
+  }
+
+  // Values between the levels min_level and max_level of the range, 0.3 of a level above them so that no value is
+  // halfway between two levels and the rounding of the kernel can't differ from the one of the FakeQuant.
+  static std::vector<float> GetData(size_t size, float min, float max, bool narrow_range, bool symmetric,
+                                    size_t min_level, size_t max_level) {
+    auto range = kernel::FakeQuantCPUKernel::NudgeRange(min, max, narrow_range ? 1 : 0, 255, symmetric);
+    std::vector<float> data(size);
+    for (size_t i = 0; i < size; ++i) {
+      size_t level = min_level + i * 37 % (max_level - min_level);
+      data[i] = range.min + (static_cast<float>(level) + 0.3f) * range.scale;
+    }
+    return data;
+  }
+
+  static kernel::AddressPtr MakeAddress(std::vector<float> *data) {
+    auto address = std::make_shared<kernel::Address>();
+    address->addr = data->data();
+    address->size = data->size() * sizeof(float);
+    return address;
+  }
+
+  static void Launch(kernel::MKLInt8CPUKernel *kernel_mod, const std::vector<std::vector<float> *> &inputs,
+                     std::vector<float> *output) {
+    std::vector<kernel::AddressPtr> input_addresses;
+    for (auto input : inputs) {
+      input_addresses.push_back(MakeAddress(input));
+    }
+    std::vector<kernel::AddressPtr> workspace;
+    std::vector<kernel::AddressPtr> outputs{MakeAddress(output)};
+    ASSERT_TRUE(kernel_mod->Launch(input_addresses, workspace, outputs));
+  }
+
+  // The int8 kernel has to give the float32 op of the fake quantized src and weight within one step of the product
+  // of their grids for each accumulated term.
+  static void ExpectNear(const std::vector<float> &output, const std::vector<float> &expect, float tolerance) {
+    ASSERT_EQ(output.size(), expect.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+      EXPECT_NEAR(output[i], expect[i], tolerance);
+    }
+  }
+
+  // matmul(x[4, 16], w[16, 8]) + b, w is transposed in the per channel case.
+  static std::vector<float> MatMul(const std::vector<float> &x, const std::vector<float> &w,
+                                   const std::vector<float> &b, bool transpose_b) {
+    std::vector<float> output(4 * 8);
+    for (size_t m = 0; m < 4; ++m) {
+      for (size_t n = 0; n < 8; ++n) {
+        float sum = b.empty() ? 0 : b[n];
+        for (size_t k = 0; k < 16; ++k) {
+          sum += x[m * 16 + k] * (transpose_b ? w[n * 16 + k] : w[k * 8 + n]);
+        }
+        output[m * 8 + n] = sum;
+      }
+    }
+    return output;
+  }
+
+  static float GetScale(float min, float max, bool narrow_range, bool symmetric) {
+    return kernel::FakeQuantCPUKernel::NudgeRange(min, max, narrow_range ? 1 : 0, 255, symmetric).scale;
+  }
+};
+
+TEST_F(TestHWInt8Kernel, test_launch_int8_matmul_u8_src) {
+  auto kg = GetGraph("matmul_bias", {{4, 16}, {16, 8}, {1}, {1}, {1}, {1}, {8}});
+  auto int8_node = FoldFakeQuant(kg, kInt8MatMulOpName, 7);
+  ASSERT_NE(int8_node, nullptr);
+  kernel::Int8MatMulCPUKernel kernel_mod;
+  kernel_mod.Init(int8_node);
+
+  std::vector<float> x_min = {0};
+  std::vector<float> x_max = {6};
+  std::vector<float> w_min = {-1};
+  std::vector<float> w_max = {1};
+  auto x = GetData(4 * 16, x_min[0], x_max[0], false, false, 0, 250);
+  auto w = GetData(16 * 8, w_min[0], w_max[0], true, true, 10, 245);
+  std::vector<float> b = {0.5f, -1.5f, 2.0f, 0.25f, -0.75f, 1.0f, 3.0f, -2.0f};
+  std::vector<float> output(4 * 8);
+  Launch(&kernel_mod, {&x, &w, &x_min, &x_max, &w_min, &w_max, &b}, &output);
+
+  // A src range starting at the zero is quantized to u8 on the levels of the FakeQuant.
+  EXPECT_TRUE(kernel_mod.src_unsigned_);
+  float x_scale = GetScale(x_min[0], x_max[0], false, false);
+  EXPECT_FLOAT_EQ(kernel_mod.src_multiplier_, 1.0f / x_scale);
+  // The bias is added to the accumulator, in the scale of the quantized src and weight.
+  auto quantized_bias = reinterpret_cast<float *>(kernel_mod.arguments_[DNNL_ARG_BIAS].get_data_handle());
+  for (size_t i = 0; i < b.size(); ++i) {
+    EXPECT_FLOAT_EQ(quantized_bias[i], b[i] * kernel_mod.src_multiplier_ * kernel_mod.weight_multipliers_[i]);
+  }
+  auto expect = MatMul(FakeQuant(x, x_min, x_max, false, false, 1), FakeQuant(w, w_min, w_max, true, true, 1), b,
+                       false);
+  ExpectNear(output, expect, 16 * x_scale * GetScale(w_min[0], w_max[0], true, true));
+}
+
+TEST_F(TestHWInt8Kernel, test_launch_int8_matmul_s8_src) {
+  auto kg = GetGraph("matmul_transpose_b_per_channel", {{4, 16}, {8, 16}, {1}, {1}, {8}, {8}});
+  auto int8_node = FoldFakeQuant(kg, kInt8MatMulOpName, 6);
+  ASSERT_NE(int8_node, nullptr);
+  kernel::Int8MatMulCPUKernel kernel_mod;
+  kernel_mod.Init(int8_node);
+
+  // The zero point of [-2, 2] is the level 128, the middle level of s8.
+  std::vector<float> x_min = {-2};
+  std::vector<float> x_max = {2};
+  std::vector<float> w_min(8);
+  std::vector<float> w_max(8);
+  for (size_t i = 0; i < 8; ++i) {
+    w_max[i] = 0.5f + 0.25f * static_cast<float>(i);
+    w_min[i] = -w_max[i];
+  }
+  auto x = GetData(4 * 16, x_min[0], x_max[0], false, false, 20, 230);
+  auto w = GetData(8 * 16, -0.5f, 0.5f, true, true, 10, 245);
+  std::vector<float> output(4 * 8);
+  Launch(&kernel_mod, {&x, &w, &x_min, &x_max, &w_min, &w_max}, &output);
+
+  EXPECT_FALSE(kernel_mod.src_unsigned_);
+  float x_scale = GetScale(x_min[0], x_max[0], false, false);
+  EXPECT_FLOAT_EQ(kernel_mod.src_multiplier_, 1.0f / x_scale);
+  ASSERT_EQ(kernel_mod.weight_multipliers_.size(), w_max.size());
+  for (size_t i = 0; i < 8; ++i) {
+    EXPECT_FLOAT_EQ(kernel_mod.weight_multipliers_[i], 1.0f / GetScale(w_min[i], w_max[i], true, true));
+  }
+  auto expect = MatMul(FakeQuant(x, x_min, x_max, false, false, 1), FakeQuant(w, w_min, w_max, true, true, 16), {},
+                       true);
+  ExpectNear(output, expect, 16 * x_scale * GetScale(w_min[7], w_max[7], true, true));
+}
+
+TEST_F(TestHWInt8Kernel, test_requantize_weight_on_range_change) {
+  auto kg = GetGraph("matmul_bias", {{4, 16}, {16, 8}, {1}, {1}, {1}, {1}, {8}});
+  auto int8_node = FoldFakeQuant(kg, kInt8MatMulOpName, 7);
+  ASSERT_NE(int8_node, nullptr);
+  kernel::Int8MatMulCPUKernel kernel_mod;
+  kernel_mod.Init(int8_node);
+
+  std::vector<float> x_min = {0};
+  std::vector<float> x_max = {6};
+  std::vector<float> w_min = {-2};
+  std::vector<float> w_max = {2};
+  auto x = GetData(4 * 16, x_min[0], x_max[0], false, false, 0, 250);
+  // Inside the narrower range launched after, away from the halves of its levels too.
+  auto w = GetData(16 * 8, w_min[0], w_max[0], true, true, 70, 185);
+  std::vector<float> b(8, 1.0f);
+  std::vector<float> output(4 * 8);
+  Launch(&kernel_mod, {&x, &w, &x_min, &x_max, &w_min, &w_max, &b}, &output);
+  EXPECT_EQ(kernel_mod.quantized_weights_addr_, w.data());
+  auto weight_multipliers = kernel_mod.weight_multipliers_;
+
+  // The weight keeps its address, a new range has to quantize it again.
+  w_min[0] = -1;
+  w_max[0] = 1;
+  Launch(&kernel_mod, {&x, &w, &x_min, &x_max, &w_min, &w_max, &b}, &output);
+  EXPECT_NE(kernel_mod.weight_multipliers_, weight_multipliers);
+  EXPECT_EQ(kernel_mod.quantized_weights_addr_, w.data());
+  auto expect = MatMul(FakeQuant(x, x_min, x_max, false, false, 1), FakeQuant(w, w_min, w_max, true, true, 1), b,
+                       false);
+  ExpectNear(output, expect, 16 * GetScale(x_min[0], x_max[0], false, false) * GetScale(-1, 1, true, true));
+}
+
+TEST_F(TestHWInt8Kernel, test_launch_int8_conv2d) {
+  auto kg = GetGraph("conv_bias", {{1, 4, 6, 6}, {8, 4, 3, 3}, {1}, {1}, {8}, {8}, {8}});
+  auto int8_node = FoldFakeQuant(kg, kInt8Conv2DOpName, 7);
+  ASSERT_NE(int8_node, nullptr);
+  kernel::Int8Conv2dCPUKernel kernel_mod;
+  kernel_mod.Init(int8_node);
+
+  std::vector<float> x_min = {0};
+  std::vector<float> x_max = {6};
+  std::vector<float> w_min(8);
+  std::vector<float> w_max(8);
+  for (size_t i = 0; i < 8; ++i) {
+    w_max[i] = 0.5f + 0.25f * static_cast<float>(i);
+    w_min[i] = -w_max[i];
+  }
+  auto x = GetData(4 * 6 * 6, x_min[0], x_max[0], false, false, 0, 250);
+  auto w = GetData(8 * 4 * 3 * 3, -0.5f, 0.5f, true, true, 10, 245);
+  std::vector<float> b = {0.5f, -1.5f, 2.0f, 0.25f, -0.75f, 1.0f, 3.0f, -2.0f};
+  std::vector<float> output(8 * 4 * 4);
+  Launch(&kernel_mod, {&x, &w, &x_min, &x_max, &w_min, &w_max, &b}, &output);
+  EXPECT_TRUE(kernel_mod.src_unsigned_);
+
+  auto quantized_x = FakeQuant(x, x_min, x_max, false, false, 1);
+  auto quantized_w = FakeQuant(w, w_min, w_max, true, true, 4 * 3 * 3);
+  std::vector<float> expect(8 * 4 * 4);
+  for (size_t oc = 0; oc < 8; ++oc) {
+    for (size_t oh = 0; oh < 4; ++oh) {
+      for (size_t ow = 0; ow < 4; ++ow) {
+        float sum = b[oc];
+        for (size_t ic = 0; ic < 4; ++ic) {
+          for (size_t kh = 0; kh < 3; ++kh) {
+            for (size_t kw = 0; kw < 3; ++kw) {
+              sum += quantized_x[(ic * 6 + oh + kh) * 6 + ow + kw] * quantized_w[((oc * 4 + ic) * 3 + kh) * 3 + kw];
+            }
+          }
+        }
+        expect[(oc * 4 + oh) * 4 + ow] = sum;
+      }
+    }
+  }
+  float tolerance = 4 * 3 * 3 * GetScale(x_min[0], x_max[0], false, false) * GetScale(w_min[7], w_max[7], true, true);
+  ExpectNear(output, expect, tolerance);
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,76 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include "common/backend_common_test.h"
+#include "common/py_func_graph_fetcher.h"
+#include "backend/optimizer/common/optimizer.h"
+#include "backend/optimizer/common/pass_manager.h"
+#include "backend/optimizer/cpu/multi_tensor_apply_fusion.h"
+#include "backend/optimizer/gpu/adam_fusion.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+class TestHWMultiTensorApplyAdamFusion : public BackendCommon {
+ public:
+  TestHWMultiTensorApplyAdamFusion() : get_py_fun_("gtest_input.pre_activate.multi_tensor_apply_fusion_test", true) {}
+  ~TestHWMultiTensorApplyAdamFusion() override = default;
+
+  // Runs the guarded AdamFusion on the Adam update of the given arguments, returns whether a FusedAdam was created.
+  bool RunAdamFusion(const abstract::AbstractBasePtr &arg_abstract, const abstract::AbstractBasePtr &kernel_abstract) {
+    FuncGraphPtr g = get_py_fun_.CallAndParseRet("test_multi_tensor_apply_adam_fusion", "before");
+    AbstractBasePtrList args_spec_list(10, arg_abstract);
+    auto kg = GetKernelGraph(g, args_spec_list);
+    if (kernel_abstract != nullptr) {
+      for (auto &parameter : kg->parameters()) {
+        parameter->set_abstract(kernel_abstract);
+      }
+    }
+    auto optimizer = std::make_shared<opt::GraphOptimizer>();
+    auto pm = std::make_shared<opt::PassManager>();
+    pm->AddPass(std::make_shared<opt::MultiTensorApplyAdamFusion<opt::AdamFusion>>());
+    optimizer->AddPassManager(pm);
+    FuncGraphPtr new_graph = optimizer->Optimize(kg);
+    auto nodes = TopoSort(new_graph->get_return());
+    return std::any_of(nodes.begin(), nodes.end(), [](const AnfNodePtr &node) {
+      return node->isa<CNode>() && AnfAlgo::GetCNodeName(node) == kFusedAdamName;
+    });
+  }
+
+  UT::PyFuncGraphFetcher get_py_fun_;
+};
+
+TEST_F(TestHWMultiTensorApplyAdamFusion, test_fuse_float32_adam) {
+  std::vector<int64_t> shp{2, 32};
+  EXPECT_TRUE(RunAdamFusion(std::make_shared<abstract::AbstractTensor>(kFloat32, shp), nullptr));
+}
+
+TEST_F(TestHWMultiTensorApplyAdamFusion, test_keep_float16_adam) {
+  // The MultiTensorApply kernel only updates float32 parameters, a FusedAdam in float16 would have no kernel.
+  std::vector<int64_t> shp{2, 32};
+  EXPECT_FALSE(RunAdamFusion(std::make_shared<abstract::AbstractTensor>(kFloat16, shp), nullptr));
+}
+
+TEST_F(TestHWMultiTensorApplyAdamFusion, test_keep_dynamic_shape_adam) {
+  std::vector<int64_t> shp{2, 32};
+  auto dynamic_shape = std::make_shared<abstract::Shape>(std::vector<int64_t>{-1, 32}, std::vector<int64_t>{1, 32},
+                                                         std::vector<int64_t>{2, 32});
+  EXPECT_FALSE(RunAdamFusion(std::make_shared<abstract::AbstractTensor>(kFloat32, shp),
+                             std::make_shared<abstract::AbstractTensor>(kFloat32, dynamic_shape)));
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,46 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+from mindspore.ops import operations as P
+from mindspore.ops.operations import _grad_ops as G
+
+dropout = P.Dropout(keep_prob=0.5, Seed0=1, Seed1=2)
+dropout_grad = G.DropoutGrad(keep_prob=0.5)
+
+
+class FnDict:
+    def __init__(self):
+        self.fnDict = {}
+
+    def __call__(self, fn):
+        self.fnDict[fn.__name__] = fn
+
+    def __getitem__(self, name):
+        return self.fnDict[name]
+
+
+def test_dropout_mask_regeneration(tag):
+    fns = FnDict()
+
+    @fns
+    def before(x, dy):
+        output, mask = dropout(x)
+        return output, dropout_grad(dy, mask)
+
+    @fns
+    def mask_returned(x, dy):
+        output, mask = dropout(x)
+        return output, dropout_grad(dy, mask), mask
+
+    return fns[tag]
@@ -0,0 +1,95 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+from mindspore.ops import operations as P
+from mindspore.ops.operations import _quant_ops as Q
+
+bias_add = P.BiasAdd()
+add = P.TensorAdd()
+matmul = P.MatMul()
+matmul_transpose_b = P.MatMul(transpose_b=True)
+conv = P.Conv2D(out_channel=8, kernel_size=3)
+fake_quant_src = Q.FakeQuantPerLayer(num_bits=8, training=False)
+fake_quant_weight = Q.FakeQuantPerLayer(num_bits=8, symmetric=True, narrow_range=True, training=False)
+fake_quant_weight_axis_0 = Q.FakeQuantPerChannel(num_bits=8, symmetric=True, narrow_range=True, training=False,
+                                                 channel_axis=0)
+fake_quant_weight_axis_1 = Q.FakeQuantPerChannel(num_bits=8, symmetric=True, narrow_range=True, training=False,
+                                                 channel_axis=1)
+fake_quant_training = Q.FakeQuantPerLayer(num_bits=8, training=True)
+fake_quant_4_bits = Q.FakeQuantPerLayer(num_bits=4, training=False)
+
+
+class FnDict:
+    def __init__(self):
+        self.fnDict = {}
+
+    def __call__(self, fn):
+        self.fnDict[fn.__name__] = fn
+
+    def __getitem__(self, name):
+        return self.fnDict[name]
+
+
+def test_int8_quant_fusion(tag):
+    fns = FnDict()
+
+    @fns
+    def matmul_bias(x, w, x_min, x_max, w_min, w_max, b):
+        res = matmul(fake_quant_src(x, x_min, x_max), fake_quant_weight(w, w_min, w_max))
+        return bias_add(res, b)
+
+    @fns
+    def matmul_per_channel(x, w, x_min, x_max, w_min, w_max):
+        return matmul(fake_quant_src(x, x_min, x_max), fake_quant_weight_axis_1(w, w_min, w_max))
+
+    @fns
+    def matmul_transpose_b_per_channel(x, w, x_min, x_max, w_min, w_max):
+        return matmul_transpose_b(fake_quant_src(x, x_min, x_max), fake_quant_weight_axis_0(w, w_min, w_max))
+
+    @fns
+    def matmul_per_input_channel(x, w, x_min, x_max, w_min, w_max):
+        return matmul(fake_quant_src(x, x_min, x_max), fake_quant_weight_axis_0(w, w_min, w_max))
+
+    @fns
+    def matmul_per_channel_src(x, w, x_min, x_max, w_min, w_max):
+        return matmul(fake_quant_weight_axis_1(x, x_min, x_max), fake_quant_weight(w, w_min, w_max))
+
+    @fns
+    def matmul_training(x, w, x_min, x_max, w_min, w_max):
+        return matmul(fake_quant_training(x, x_min, x_max), fake_quant_weight(w, w_min, w_max))
+
+    @fns
+    def matmul_4_bits(x, w, x_min, x_max, w_min, w_max):
+        return matmul(fake_quant_4_bits(x, x_min, x_max), fake_quant_weight(w, w_min, w_max))
+
+    @fns
+    def matmul_shared_fake_quant(x, w, x_min, x_max, w_min, w_max):
+        src = fake_quant_src(x, x_min, x_max)
+        return matmul(src, fake_quant_weight(w, w_min, w_max)), src
+
+    @fns
+    def matmul_without_src_fake_quant(x, w, w_min, w_max):
+        return matmul(x, fake_quant_weight(w, w_min, w_max))
+
+    @fns
+    def matmul_bias_shared_output(x, w, x_min, x_max, w_min, w_max, b):
+        res = matmul(fake_quant_src(x, x_min, x_max), fake_quant_weight(w, w_min, w_max))
+        return add(bias_add(res, b), res)
+
+    @fns
+    def conv_bias(x, w, x_min, x_max, w_min, w_max, b):
+        res = conv(fake_quant_src(x, x_min, x_max), fake_quant_weight_axis_0(w, w_min, w_max))
+        return bias_add(res, b)
+
+    return fns[tag]
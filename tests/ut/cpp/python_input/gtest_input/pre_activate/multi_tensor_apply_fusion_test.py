@@ -0,0 +1,52 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+from mindspore.ops import operations as P
+from mindspore.ops import functional as F
+
+Add = P.TensorAdd()
+Sub = P.Sub()
+Mul = P.Mul()
+RealDiv = P.RealDiv()
+Sqrt = P.Sqrt()
+Square = P.Square()
+Assign = P.Assign()
+
+
+class FnDict:
+    def __init__(self):
+        self.fnDict = {}
+
+    def __call__(self, fn):
+        self.fnDict[fn.__name__] = fn
+
+    def __getitem__(self, name):
+        return self.fnDict[name]
+
+
+def test_multi_tensor_apply_adam_fusion(tag):
+    fns = FnDict()
+
+    @fns
+    def before(beta1, one_sub_beta1, beta2, one_sub_beta2, eps, lr, param, m, v, gradient):
+        next_m = Add(Mul(beta1, m), Mul(one_sub_beta1, gradient))
+        next_v = Add(Mul(beta2, v), Mul(one_sub_beta2, Square(gradient)))
+        update = RealDiv(next_m, Add(eps, Sqrt(next_v)))
+        next_param = Sub(param, Mul(lr, update))
+        next_param = F.depend(next_param, Assign(param, next_param))
+        next_param = F.depend(next_param, Assign(m, next_m))
+        next_param = F.depend(next_param, Assign(v, next_v))
+        return next_param
+
+    return fns[tag]